@@ -66,6 +66,7 @@ else ifeq ($(findstring MINGW, $(UNAME)), MINGW)
                   -lm
     LFLAGS_LIB += -L/local/lib \
                   -lusb0 \
+                  -lpthread \
                   -shared
 
 # Linux configuration
@@ -74,11 +75,20 @@ else
     LIBBASENAME = libseabreeze
     LFLAGS_APP += -L/usr/lib \
                   -lstdc++ \
-                  -lusb \
+                  -lpthread \
                   -lm
     LFLAGS_LIB += -L/usr/lib \
                   -shared \
-                  -lusb
+                  -lpthread
+
+    # "make usb=libusb1" selects the asynchronous libusb-1.0 backend
+    ifeq ($(usb),libusb1)
+        LFLAGS_APP += -lusb-1.0
+        LFLAGS_LIB += -lusb-1.0
+    else
+        LFLAGS_APP += -lusb
+        LFLAGS_LIB += -lusb
+    endif
 endif
 
 # enable Logger
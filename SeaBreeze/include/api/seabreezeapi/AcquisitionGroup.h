@@ -0,0 +1,128 @@
+/***************************************************//**
+ * @file    AcquisitionGroup.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * A group of spectrometers on different devices that are made to
+ * acquire at the same moment.  Every member is sent its request
+ * before any of them is read, and the responses are then read in
+ * parallel, one thread per member.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#ifndef SEABREEZE_ACQUISITIONGROUP_H
+#define SEABREEZE_ACQUISITIONGROUP_H
+
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "api/seabreezeapi/DeviceAdapter.h"
+#include "api/seabreezeapi/Retainable.h"
+#include "api/seabreezeapi/SpectrometerSession.h"
+#include "native/system/Thread.h"
+#include "native/system/Mutex.h"
+#include "native/system/ConditionVariable.h"
+#include <vector>
+
+namespace seabreeze {
+    namespace api {
+
+        class AcquisitionGroup : public Retainable {
+        public:
+            AcquisitionGroup();
+            ~AcquisitionGroup();
+
+            /* The caller must have retained the device.  That reference
+             * belongs to the group from then on, and must be released once
+             * the group has been deleted.  Returns false, with the error
+             * code set, if the feature cannot be bound or the device is
+             * already in the group; the device is then not added.
+             */
+            bool addMember(DeviceAdapter *device, long featureID,
+                    int *errorCode);
+
+            std::vector<DeviceAdapter *> getDevices();
+
+            /* Fills one row of pixelsPerSpectrum values in the buffer and
+             * one result for each member, in the order the members were
+             * added.  The devices' locks are held for the whole cycle, so
+             * it waits for any other call to those devices.  Returns the
+             * number of members; the error code is that of the first
+             * member that failed, if any did.
+             */
+            int getFormattedSpectra(int *errorCode, double *buffer,
+                    int pixelsPerSpectrum, sbapi_group_spectrum_t *results,
+                    int maxResults);
+
+        private:
+            AcquisitionGroup(const AcquisitionGroup &that);
+            AcquisitionGroup &operator=(const AcquisitionGroup &that);
+
+            /* The thread is only used to read the response, and only
+             * started the first time that is needed.
+             */
+            class Member : public Thread {
+            public:
+                Member(DeviceAdapter *device, long featureID);
+                virtual ~Member();
+
+                DeviceAdapter *getDevice();
+                bool prepare(int *errorCode);
+
+                /* The group holds the device's lock around all of these */
+                void request(sbapi_group_spectrum_t *result);
+                void read(double *buffer, int bufferLength,
+                        sbapi_group_spectrum_t *result);
+                void startRead(double *buffer, int bufferLength,
+                        sbapi_group_spectrum_t *result);
+                void finishRead();
+
+            protected:
+                virtual void run();
+
+            private:
+                DeviceAdapter *device;
+                SpectrometerSession session;
+                bool requested;
+
+                Mutex lock;
+                ConditionVariable changed;
+                bool readPending;
+                bool stopRequested;
+                double *buffer;
+                int bufferLength;
+                sbapi_group_spectrum_t *result;
+            };
+
+            /* In the order they were added */
+            std::vector<Member *> members;
+            /* Sorted by device ID, which is the order their locks are
+             * taken in so that two groups cannot deadlock.
+             */
+            std::vector<Member *> lockOrder;
+            Mutex lock;
+        };
+
+    }
+}
+
+#endif /* SEABREEZE_ACQUISITIONGROUP_H */
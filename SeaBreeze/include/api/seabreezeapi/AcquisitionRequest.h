@@ -0,0 +1,106 @@
+/***************************************************//**
+ * @file    AcquisitionRequest.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * A spectrum acquisition that has been handed to a
+ * device's AcquisitionWorker, and the means to wait for it.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#ifndef SEABREEZE_ACQUISITIONREQUEST_H
+#define SEABREEZE_ACQUISITIONREQUEST_H
+
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "api/seabreezeapi/Retainable.h"
+#include "native/system/Mutex.h"
+#include "native/system/ConditionVariable.h"
+
+namespace seabreeze {
+    namespace api {
+
+        class SpectrometerSession;
+
+        class AcquisitionRequest : public Retainable {
+        public:
+            /* The buffer belongs to the caller and must stay valid until the
+             * request has completed.  If a callback is given, the worker
+             * calls it on completion and then deletes the request itself.
+             * Otherwise the API keeps it until its result is collected, and
+             * any thread still waiting on it then holds a reference.
+             */
+            AcquisitionRequest(long requestID, long featureID,
+                    double *buffer, int bufferLength,
+                    sbapi_acquisition_callback callback, void *userData);
+            AcquisitionRequest(long requestID, long featureID,
+                    unsigned char *buffer, int bufferLength,
+                    sbapi_acquisition_callback callback, void *userData);
+            ~AcquisitionRequest();
+
+            long getID();
+            long getFeatureID();
+            bool hasCallback();
+
+            /* Called by the worker on its own thread */
+            void execute(SpectrometerSession *session);
+            void fail(int errorCode);
+
+            /* Returns true once the request has completed.  A timeout of
+             * zero only polls and a negative one waits indefinitely.
+             */
+            bool wait(int timeoutMillis);
+
+            /* Waits for the request, then returns its length and sets the
+             * error code to the outcome of the acquisition.
+             */
+            int getResult(int *errorCode);
+
+        private:
+            AcquisitionRequest(const AcquisitionRequest &that);
+            AcquisitionRequest &operator=(const AcquisitionRequest &that);
+
+            /* Nothing may touch the request after this unless it has a
+             * callback, since a waiting thread is then free to delete it.
+             */
+            void complete(int length, int errorCode);
+
+            long requestID;
+            long featureID;
+            double *formattedBuffer;
+            unsigned char *unformattedBuffer;
+            int bufferLength;
+            sbapi_acquisition_callback callback;
+            void *userData;
+
+            Mutex lock;
+            ConditionVariable completion;
+            bool completed;
+            int resultLength;
+            int resultError;
+        };
+
+    }
+}
+
+#endif /* SEABREEZE_ACQUISITIONREQUEST_H */
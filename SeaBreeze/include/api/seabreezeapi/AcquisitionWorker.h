@@ -0,0 +1,85 @@
+/***************************************************//**
+ * @file    AcquisitionWorker.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Each device has one of these to carry out acquisitions that
+ * were submitted without waiting for them.  The thread is only
+ * started once the first request arrives.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#ifndef SEABREEZE_ACQUISITIONWORKER_H
+#define SEABREEZE_ACQUISITIONWORKER_H
+
+#include "api/seabreezeapi/AcquisitionRequest.h"
+#include "native/system/Thread.h"
+#include "native/system/Mutex.h"
+#include "native/system/ConditionVariable.h"
+#include <deque>
+#include <map>
+
+namespace seabreeze {
+    namespace api {
+
+        class DeviceAdapter;
+
+        class AcquisitionWorker : public Thread {
+        public:
+            AcquisitionWorker(DeviceAdapter *device);
+            virtual ~AcquisitionWorker();
+
+            /* Requests are carried out one at a time in the order in which
+             * they were submitted.  Returns false if the worker has been
+             * shut down or its thread could not be started, in which case
+             * the request still belongs to the caller.
+             */
+            bool submit(AcquisitionRequest *request);
+
+            /* Lets the request that is in progress finish, then fails the
+             * rest with ERROR_NO_DEVICE.  Nothing can be submitted after
+             * this.  The device's fast buffer streams must be stopped
+             * first, since a stream holds the lock the worker needs.
+             */
+            void shutdown();
+
+        protected:
+            virtual void run();
+
+        private:
+            /* Only used from the worker's own thread */
+            SpectrometerSession *getSession(long featureID);
+
+            DeviceAdapter *device;
+            std::deque<AcquisitionRequest *> queue;
+            std::map<long, SpectrometerSession *> sessions;
+            Mutex lock;
+            ConditionVariable queued;
+            bool stopRequested;
+        };
+
+    }
+}
+
+#endif /* SEABREEZE_ACQUISITIONWORKER_H */
@@ -34,6 +34,7 @@
 
 /* Includes */
 #include "common/devices/Device.h"
+#include "common/devices/DeviceDescriptorCache.h"
 #include "common/buses/DeviceLocatorInterface.h"
 #include "api/seabreezeapi/EEPROMFeatureAdapter.h"
 #include "api/seabreezeapi/IrradCalFeatureAdapter.h"
@@ -64,19 +65,55 @@
 #include "api/seabreezeapi/AcquisitionDelayFeatureAdapter.h"
 #include "api/seabreezeapi/gpioFeatureAdapter.h"
 #include "api/seabreezeapi/I2CMasterFeatureAdapter.h"
+#include "api/seabreezeapi/Retainable.h"
+#include "api/seabreezeapi/AcquisitionWorker.h"
+#include "native/system/Mutex.h"
 #include <vector>
 
 namespace seabreeze {
     namespace api {
 
-        class DeviceAdapter {
+        class DeviceAdapter : public Retainable {
         public:
             DeviceAdapter(Device *dev, unsigned long id);
             ~DeviceAdapter();
 
             int open(int *errorCode);
+            /* As above, but calibration data is taken from the cache when it
+             * holds an entry for this device, and stored into it otherwise.
+             * The cache may be NULL.
+             */
+            int open(int *errorCode, DeviceDescriptorCache *cache);
             void close();
 
+            /* Settings that are written through the feature adapters are
+             * remembered so that writing the same value again costs no
+             * transfer.  This forgets them all, for when the device may
+             * have changed them itself, e.g. after a reset.
+             */
+            void forgetSettings();
+
+            /* Everything that uses the bus or the state of this device's
+             * features must be called with this lock held, except for the
+             * fast buffer stream calls, which take it themselves when they
+             * need it.  A running stream holds it until it is stopped.
+             */
+            Mutex &getLock();
+
+            /* Serializes the fast buffer stream calls.  Anything that needs
+             * both locks, such as open() and close(), must take this one
+             * first, and must stop any stream with stopFastBufferStreams()
+             * before waiting for getLock().
+             */
+            Mutex &getStreamLock();
+            void stopFastBufferStreams();
+
+            /* Hands the request to this device's worker thread, which takes
+             * the lock itself.  Returns false if the request could not be
+             * queued, in which case it still belongs to the caller.
+             */
+            bool submitAcquisition(AcquisitionRequest *request);
+
             DeviceLocatorInterface *getLocation();
 
             /* An for weak association to this object */
@@ -108,10 +145,19 @@ namespace seabreeze {
             int getNumberOfSpectrometerFeatures();
             int getSpectrometerFeatures(long *buffer, int maxFeatures);
             void spectrometerSetTriggerMode(long spectrometerFeatureID, int *errorCode, int mode);
+            void spectrometerSetPrefetchEnabled(long spectrometerFeatureID, int *errorCode, bool enable);
             void spectrometerSetIntegrationTimeMicros(long spectrometerFeatureID, int *errorCode, unsigned long integrationTimeMicros);
             unsigned long spectrometerGetMinimumIntegrationTimeMicros(long spectrometerFeatureID, int *errorCode);
             unsigned long spectrometerGetMaximumIntegrationTimeMicros(long spectrometerFeatureID, int *errorCode);
             double spectrometerGetMaximumIntensity(long spectrometerFeatureID, int *errorCode);
+            int spectrometerStartFastBufferStream(long spectrometerFeatureID, int *errorCode, int capacity);
+            int spectrometerReadFastBufferStream(long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength);
+            void spectrometerStopFastBufferStream(long spectrometerFeatureID, int *errorCode);
+            unsigned int spectrometerGetFastBufferStreamOverruns(long spectrometerFeatureID, int *errorCode);
+            int spectrometerGetFastBufferSpectrumLength(long spectrometerFeatureID, int *errorCode);
+            int spectrometerDecodeFastBufferSpectra(long spectrometerFeatureID, int *errorCode,
+                    const unsigned char *buffer, int bufferLength,
+                    sbapi_spectrum_metadata_t *metadata, unsigned char *valid, int maxSpectra);
             int spectrometerGetUnformattedSpectrumLength(long spectrometerFeatureID, int *errorCode);
             int spectrometerGetUnformattedSpectrum(long spectrometerFeatureID,int *errorCode, unsigned char *buffer, int bufferLength);
 			int spectrometerGetFastBufferSpectrum(long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength, unsigned int numberOfSamplesToRetrieve);
@@ -119,9 +165,16 @@ namespace seabreeze {
 			int spectrometerFastBufferSpectrumResponse(long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength, unsigned int numberOfSamplesToRetrieve);
 			int spectrometerGetFormattedSpectrumLength(long spectrometerFeatureID, int *errorCode);
             int spectrometerGetFormattedSpectrum(long spectrometerFeatureID, int *errorCode,double *buffer, int bufferLength);
+            int spectrometerGetFormattedSpectrum(long spectrometerFeatureID, int *errorCode, float *buffer, int bufferLength);
+            int spectrometerGetFormattedSpectrum(long spectrometerFeatureID, int *errorCode, unsigned short *buffer, int bufferLength);
+            int spectrometerGetFormattedSpectrum(long spectrometerFeatureID, int *errorCode, unsigned int *buffer, int bufferLength);
+            int spectrometerGetFormattedSpectrumWithMetadata(long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength, sbapi_spectrum_metadata_t *metadata);
+            void spectrometerGetFormattedSpectrumMetadata(long spectrometerFeatureID, int *errorCode, sbapi_spectrum_metadata_t *metadata);
             int spectrometerGetWavelengths(long spectrometerFeatureID, int *errorCode,double *wavelengths, int length);
             int spectrometerGetElectricDarkPixelCount(long spectrometerFeatureID, int *errorCode);
             int spectrometerGetElectricDarkPixelIndices(long spectrometerFeatureID, int *errorCode, int *indices, int length);
+            /* Gathers the items asked for in the frame in one go */
+            int spectrometerAcquireFrame(long spectrometerFeatureID, int *errorCode, sbapi_frame_t *frame);
 
 
             /* Get one or more pixel binning features */
@@ -357,9 +410,20 @@ namespace seabreeze {
 			unsigned short i2cMasterWriteBus(long featureID, int *errorCode, unsigned char busIndex, unsigned char slaveAddress, const unsigned char *writeData, unsigned short numberOfBytes);
 
 
+        friend class SpectrometerSession;
+
         protected:
             unsigned long instanceID;
             seabreeze::Device *device;
+            Mutex lock;
+            Mutex streamLock;
+            /* Changed by every open() and close() so that anything resolved
+             * against one connection can tell when it has gone stale.
+             */
+            unsigned long connection;
+            /* Set by open() when a descriptor cache is in use */
+            std::string descriptorKey;
+            AcquisitionWorker *acquisitionWorker;
             std::vector<RawUSBBusAccessFeatureAdapter *> rawUSBBusAccessFeatures;
             std::vector<SerialNumberFeatureAdapter *> serialNumberFeatures;
             std::vector<SpectrometerFeatureAdapter *> spectrometerFeatures;
@@ -389,6 +453,18 @@ namespace seabreeze {
             std::vector<AcquisitionDelayFeatureAdapter *> acquisitionDelayFeatures;
 			std::vector<gpioFeatureAdapter *> gpioFeatures;
 			std::vector<I2CMasterFeatureAdapter *> i2cMasterFeatures;
+
+            std::string getDescriptorKey(Bus *bus);
+            bool loadDescriptor(const DeviceDescriptor &descriptor, Bus *bus);
+            void saveDescriptor(DeviceDescriptor &descriptor, Bus *bus);
+            bool readCalibrationFingerprint(Bus *bus, std::vector<double> &fingerprint);
+            /* Called after writing a calibration to the device */
+            void forgetDescriptor();
+
+            /* Reads any spectrum that was requested ahead of time, so that
+             * the bus is free for another command.
+             */
+            void cancelSpectrumPrefetches();
             
             RawUSBBusAccessFeatureAdapter *getRawUSBBusAccessFeatureByID(long featureID);
             SerialNumberFeatureAdapter *getSerialNumberFeatureByID(long featureID);
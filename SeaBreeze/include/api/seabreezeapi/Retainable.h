@@ -0,0 +1,67 @@
+/***************************************************//**
+ * @file    Retainable.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Reference counting for objects that the API hands out by ID and
+ * that calls keep using after the lock on their list is released.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#ifndef SEABREEZE_RETAINABLE_H
+#define SEABREEZE_RETAINABLE_H
+
+#include "native/system/Mutex.h"
+
+namespace seabreeze {
+    namespace api {
+
+        class Retainable {
+        public:
+            Retainable();
+            virtual ~Retainable();
+
+            /* Callers that use the object after releasing whatever lock
+             * guards the list it is kept in must hold a reference.  Once it
+             * has been taken off that list, retire() is called.  If retire()
+             * or release() returns true, the object is no longer in use and
+             * the caller must delete it.
+             */
+            void retain();
+            bool release();
+            bool retire();
+
+        private:
+            Retainable(const Retainable &that);
+            Retainable &operator=(const Retainable &that);
+
+            Mutex referenceLock;
+            unsigned int references;
+            bool retired;
+        };
+
+    }
+}
+
+#endif /* SEABREEZE_RETAINABLE_H */
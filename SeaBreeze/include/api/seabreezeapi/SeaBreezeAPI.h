@@ -39,8 +39,82 @@
 #include "api/DllDecl.h"
 #include "api/USBEndpointTypes.h"
 
+/**
+ * Signature of the function that is called when hot-plug events are enabled
+ * and a device arrives or leaves.  The event is SBAPI_DEVICE_ADDED or
+ * SBAPI_DEVICE_REMOVED from SeaBreezeAPIConstants.h.
+ */
+typedef void (*sbapi_hot_plug_callback)(long deviceID, int event, void *userData);
+
+/**
+ * Signature of the function that is called when a submitted acquisition
+ * completes.  The length is the number of pixels or bytes written into the
+ * buffer that was submitted.  It is called on the device's worker thread.
+ */
+typedef void (*sbapi_acquisition_callback)(long requestID, int errorCode,
+        int length, void *userData);
+
+/**
+ * Metadata that some spectrometers (e.g. the QE Pro) send along with each
+ * spectrum.  Successive spectra have successive spectrum counts, so a gap
+ * means that spectra were dropped.  The tick count is the device clock when
+ * the spectrum was acquired, in microseconds.
+ */
+typedef struct {
+    unsigned int spectrum_count;
+    unsigned long long tick_count_micros;
+    unsigned int integration_time_micros;
+    unsigned char trigger_mode;
+} sbapi_spectrum_metadata_t;
+
+/**
+ * What one member of an acquisition group got in one acquisition.  The
+ * times are from the host's monotonic clock, in microseconds: when the
+ * request was sent to the device, and when its spectrum had been read.
+ * The metadata is only filled in if the spectrometer provides it.
+ */
+typedef struct {
+    long device_id;
+    int error_code;
+    int pixels;
+    unsigned long long request_time_micros;
+    unsigned long long complete_time_micros;
+    unsigned char has_metadata;
+    sbapi_spectrum_metadata_t metadata;
+} sbapi_group_spectrum_t;
+
+/**
+ * Everything that sbapi_spectrometer_acquire_frame() gathers for one frame.
+ * The caller sets items to the SBAPI_FRAME_* flags from
+ * SeaBreezeAPIConstants.h for what it wants, and provides buffers for the
+ * items that need one.  Of the rest, only what items_read says was filled
+ * in is meaningful.  The metadata comes with the spectrum, so it is filled
+ * in whenever the spectrometer provides it.
+ */
+typedef struct {
+    unsigned int items;
+    double *spectrum;
+    int spectrum_length;
+    double *wavelengths;
+    int wavelengths_length;
+    double *temperatures;
+    int temperatures_length;
+
+    unsigned int items_read;
+    int pixels;
+    int wavelength_count;
+    int temperature_count;
+    unsigned long integration_time_micros;
+    double tec_temperature_degrees_c;
+    sbapi_spectrum_metadata_t metadata;
+} sbapi_frame_t;
+
 #ifdef __cplusplus
 
+namespace seabreeze {
+    class USBHotPlugEventSource;
+}
+
 /*!
     @brief  This is an interface to SeaBreeze that allows
             the user to connect to devices over USB and
@@ -86,6 +160,27 @@ public:
      */
     virtual int addRS232DeviceLocation(char *deviceTypeName, char *deviceBusPath, unsigned int baud) = 0;
 
+    /**
+     * Use enableHotPlug() to have the list of probed devices kept up to date
+     * as USB devices arrive and leave, rather than calling probeDevices()
+     * repeatedly.  The callback is invoked from a background thread.  The
+     * second form listens to the given event source instead of the operating
+     * system, which allows this to be exercised without hardware; the API
+     * takes ownership of the source.
+     */
+    virtual int enableHotPlug(sbapi_hot_plug_callback callback, void *userData,
+            int *errorCode) = 0;
+    virtual int enableHotPlug(seabreeze::USBHotPlugEventSource *source,
+            sbapi_hot_plug_callback callback, void *userData, int *errorCode) = 0;
+    virtual void disableHotPlug(int *errorCode) = 0;
+
+    /**
+     * Use setDescriptorCacheFile() to keep each device's calibrations in a
+     * file so that later calls to openDevice() need not read them back from
+     * the hardware.  A NULL or empty path stops using the file.
+     */
+    virtual int setDescriptorCacheFile(const char *path, int *errorCode) = 0;
+
     /**
      * This provides the number of devices that have either been probed or
      * manually specified.  Devices are not opened automatically, but this can
@@ -115,6 +210,13 @@ public:
      */
     virtual void closeDevice(long id, int *errorCode) = 0;
 
+    /**
+     * Settings are only written to a device when they differ from what was
+     * last written.  This makes the next write of each one go to the device
+     * again, for when the device may have lost or changed them itself.
+     */
+    virtual void resyncDeviceSettings(long id, int *errorCode) = 0;
+
     /* Get a string that describes the type of device */
     virtual int getDeviceType(long id, int *errorCode, char *buffer, unsigned int length) = 0;
     
@@ -137,10 +239,17 @@ public:
     virtual int getNumberOfSpectrometerFeatures(long id, int *errorCode) = 0;
     virtual int getSpectrometerFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength) = 0;
     virtual void spectrometerSetTriggerMode(long deviceID, long spectrometerFeatureID, int *errorCode, int mode) = 0;
+    virtual void spectrometerSetPrefetchEnable(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char prefetchEnable) = 0;
     virtual void spectrometerSetIntegrationTimeMicros(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned long integrationTimeMicros) = 0;
     virtual unsigned long spectrometerGetMinimumIntegrationTimeMicros(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
     virtual unsigned long spectrometerGetMaximumIntegrationTimeMicros(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
     virtual double spectrometerGetMaximumIntensity(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual int spectrometerStartFastBufferStream(long deviceID, long spectrometerFeatureID, int *errorCode, int capacity) = 0;
+    virtual int spectrometerReadFastBufferStream(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength) = 0;
+    virtual void spectrometerStopFastBufferStream(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual unsigned int spectrometerGetFastBufferStreamOverruns(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual int spectrometerGetFastBufferSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual int spectrometerDecodeFastBufferSpectra(long deviceID, long spectrometerFeatureID, int *errorCode, const unsigned char *buffer, int bufferLength, sbapi_spectrum_metadata_t *metadata, unsigned char *valid, int maxSpectra) = 0;
     virtual int spectrometerGetUnformattedSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
     virtual int spectrometerGetUnformattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength) = 0;
 	virtual int spectrometerGetFastBufferSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *dataBuffer, int dataMaxLength, unsigned int numberOfSampleToRetrieve) = 0; // currently 15 max
@@ -148,9 +257,35 @@ public:
 	virtual int spectrometerFastBufferSpectrumResponse(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *dataBuffer, int dataMaxLength, unsigned int numberOfSampleToRetrieve) = 0; // currently 15 max
 	virtual int spectrometerGetFormattedSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
     virtual int spectrometerGetFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength) = 0;
+    virtual int spectrometerGetFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, float *buffer, int bufferLength) = 0;
+    virtual int spectrometerGetFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned short *buffer, int bufferLength) = 0;
+    virtual int spectrometerGetFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned int *buffer, int bufferLength) = 0;
+    virtual int spectrometerGetFormattedSpectrumWithMetadata(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength, sbapi_spectrum_metadata_t *metadata) = 0;
+    virtual void spectrometerGetFormattedSpectrumMetadata(long deviceID, long spectrometerFeatureID, int *errorCode, sbapi_spectrum_metadata_t *metadata) = 0;
     virtual int spectrometerGetWavelengths(long deviceID, long spectrometerFeatureID, int *errorCode, double *wavelengths, int length) = 0;
     virtual int spectrometerGetElectricDarkPixelCount(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
     virtual int spectrometerGetElectricDarkPixelIndices(long deviceID, long spectrometerFeatureID, int *errorCode, int *indices, int length) = 0;
+    virtual int spectrometerAcquireFrame(long deviceID, long spectrometerFeatureID, int *errorCode, sbapi_frame_t *frame) = 0;
+
+    /* Spectrometer sessions */
+    virtual long spectrometerOpenSession(long deviceID, long spectrometerFeatureID, int *errorCode) = 0;
+    virtual void spectrometerCloseSession(long sessionID, int *errorCode) = 0;
+    virtual int spectrometerSessionGetUnformattedSpectrum(long sessionID, int *errorCode, unsigned char *buffer, int bufferLength) = 0;
+    virtual int spectrometerSessionGetFormattedSpectrum(long sessionID, int *errorCode, double *buffer, int bufferLength) = 0;
+    virtual int spectrometerSessionGetFormattedSpectrum(long sessionID, int *errorCode, float *buffer, int bufferLength) = 0;
+    virtual int spectrometerSessionGetFormattedSpectrum(long sessionID, int *errorCode, unsigned short *buffer, int bufferLength) = 0;
+    virtual int spectrometerSessionGetFormattedSpectrum(long sessionID, int *errorCode, unsigned int *buffer, int bufferLength) = 0;
+
+    /* Acquisitions that do not wait for the spectrum */
+    virtual long spectrometerSubmitFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength, sbapi_acquisition_callback callback, void *userData) = 0;
+    virtual long spectrometerSubmitUnformattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength, sbapi_acquisition_callback callback, void *userData) = 0;
+    virtual int spectrometerWaitAcquisition(long requestID, int *errorCode, int timeoutMillis) = 0;
+    virtual int spectrometerGetAcquisitionResult(long requestID, int *errorCode) = 0;
+
+    /* Groups of spectrometers that acquire together */
+    virtual long createAcquisitionGroup(const long *deviceIDs, const long *spectrometerFeatureIDs, int count, int *errorCode) = 0;
+    virtual void destroyAcquisitionGroup(long groupID, int *errorCode) = 0;
+    virtual int acquisitionGroupGetFormattedSpectra(long groupID, int *errorCode, double *buffer, int pixelsPerSpectrum, sbapi_group_spectrum_t *results, int maxResults) = 0;
 
     /* Pixel binning capabilities */
     virtual int getNumberOfPixelBinningFeatures(long id, int *errorCode) = 0;
@@ -383,6 +518,12 @@ extern "C" {
 
     /* All of these C functions start with sbapi_ to prevent namespace
      * collisions.
+     *
+     * Apart from sbapi_initialize() and sbapi_shutdown(), these may be
+     * called from any number of threads.  Each device has its own lock, so
+     * calls to different devices run at the same time while calls to the
+     * same device are carried out one after another.  Probing only briefly
+     * holds up calls that are looking up a device ID.
      */
 
     /**
@@ -446,12 +587,9 @@ extern "C" {
     /**
      * This causes a search for known devices on all buses that support
      * autodetection.  This does NOT automatically open any device -- that must
-     * still be done with the sbapi_open_device() function.  Note that this
-     * should only be done by one thread at a time, and it is recommended that
-     * other threads avoid calling sbapi_get_number_of_device_ids() or
-     * sbapi_get_device_ids() while this is executing.  Ideally, a single thread
-     * should be designated for all device discovery/get actions, and
-     * separate worker threads can be used for each device discovered.
+     * still be done with the sbapi_open_device() function.  This may be
+     * called while other threads are using devices.  A device that has gone
+     * away is only freed once any call that is using it has returned.
      *
      * @return the total number of devices that have been found
      *      automatically.  If called repeatedly, this will always return the
@@ -461,6 +599,76 @@ extern "C" {
     DLL_DECL int
     sbapi_probe_devices();
 
+    /**
+     * This starts listening for USB devices arriving and leaving.  Each time
+     * one of the supported devices does either, the set of probed devices is
+     * updated just as sbapi_probe_devices() would, and the callback is invoked
+     * once for each device ID that was added or removed.  This makes it
+     * unnecessary to poll sbapi_probe_devices().  Devices are probed once
+     * immediately, without callbacks, so that the device list is current.
+     *
+     * The callback runs on a background thread owned by the driver.  It may
+     * call other sbapi_ functions, but it must not call
+     * sbapi_disable_hot_plug().  A device ID reported as removed no longer
+     * refers to anything by the time the callback runs.
+     *
+     * This is currently only available on Linux, where it relies on udev.
+     *
+     * @param callback (Input) Function to invoke for each device ID that is
+     *      added or removed.  The event argument is SBAPI_DEVICE_ADDED or
+     *      SBAPI_DEVICE_REMOVED.
+     * @param userData (Input) Passed back to the callback unchanged.
+     * @param error_code (Output) A pointer to an integer that can be used for
+     *      storing error codes.  This will be ERROR_NOT_IMPLEMENTED if
+     *      hot-plug events are not available on this system.
+     *
+     * @return zero on success, non-zero on error
+     */
+    DLL_DECL int
+    sbapi_enable_hot_plug(sbapi_hot_plug_callback callback, void *userData,
+                int *error_code);
+
+    /**
+     * This stops listening for device arrival and removal.  No more callbacks
+     * will be made once this returns.  Enabling and disabling hot-plug may
+     * race with each other from different threads; the calls are serialized.
+     *
+     * @param error_code (Output) A pointer to an integer that can be used for
+     *      storing error codes.
+     */
+    DLL_DECL void
+    sbapi_disable_hot_plug(int *error_code);
+
+    /**
+     * This names a file in which the driver keeps what it learns about each
+     * device when it is first opened: the wavelength, nonlinearity, stray
+     * light and irradiance calibrations, and the pixel layout on devices that
+     * report it.  Later calls to sbapi_open_device() on the same unit reuse
+     * those values instead of reading them from the hardware again.
+     *
+     * Entries are keyed by device type, serial number and firmware revision,
+     * so a different unit or a firmware update is never matched to stale
+     * data.  Each open also rereads a few cheap values (the wavelength,
+     * nonlinearity and stray light coefficients and the irradiance
+     * collection area) and rebuilds the entry if they have changed.  Writing
+     * a calibration through SeaBreeze drops the device's entry.  An
+     * irradiance table rewritten by another program is only noticed if the
+     * collection area changed with it, so delete the file in that case.
+     *
+     * The file is created if it does not exist, and several processes may
+     * share it.
+     *
+     * @param path (Input) The file to use, or NULL or an empty string to
+     *      stop using one.  This only affects devices opened afterward.
+     * @param error_code (Output) A pointer to an integer that can be used for
+     *      storing error codes.  This will be ERROR_TRANSFER_ERROR if the file
+     *      exists but could not be read.
+     *
+     * @return zero on success, non-zero on error
+     */
+    DLL_DECL int
+    sbapi_set_descriptor_cache_file(const char *path, int *error_code);
+
     /**
      * This returns the total number of devices that are known either because
      * they have been specified with sbapi_add_RS232_device_location or
@@ -522,6 +730,26 @@ extern "C" {
     DLL_DECL void
     sbapi_close_device(long id, int *error_code);
 
+    /**
+     * The integration time, trigger mode, boxcar width, scans to average,
+     * TEC setpoint and TEC enable are remembered for each open device as
+     * they are written, and writing the value a device already has returns
+     * at once without a transfer.  A write whose transfer fails forgets its
+     * value, since the device may or may not have applied it, while a value
+     * refused before anything is sent leaves the remembered one in place.
+     * A device that is reset, power cycled or configured by other software
+     * may no longer have those values, so this function forgets them; the
+     * next write of each goes to the device again.  Opening a device also
+     * starts afresh.
+     *
+     * @param id (Input) The location ID of a device previously opened with
+     *      sbapi_open_device().
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     */
+    DLL_DECL void
+    sbapi_resync_device_settings(long id, int *error_code);
+
     /**
      * This function returns a description of the error denoted by
      * error_code.
@@ -836,6 +1064,32 @@ extern "C" {
     sbapi_spectrometer_set_trigger_mode(long deviceID, long featureID,
         int *error_code, int mode);
 
+    /**
+     * This function turns free-running acquisition on or off.  While it is
+     *     on, the next spectrum is requested as soon as one has been read,
+     *     so the device integrates while the caller is working on the last
+     *     spectrum.  For short integration times this nearly doubles the
+     *     rate at which spectra can be acquired.  The trade-off is that a
+     *     spectrum may have been started before it was asked for.
+     *
+     *     Prefetching only takes place in the normal trigger mode.  Changing
+     *     the integration time or trigger mode, or using any other feature
+     *     of the device, first reads and drops the spectrum in flight.  It
+     *     is turned off again when the device is closed.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     * @param prefetch_enable (Input) 1 to prefetch spectra, 0 to stop
+     */
+    DLL_DECL void
+    sbapi_spectrometer_set_prefetch_enable(long deviceID, long featureID,
+        int *error_code, unsigned char prefetch_enable);
+
     /**
      * This function sets the integration time for the specified device.
      * This function should not be responsible for performing stability
@@ -930,6 +1184,130 @@ extern "C" {
             long featureID, int *error_code,
             double* buffer, int buffer_length);
 
+    /**
+     * This acquires a spectrum and returns the answer as single precision
+     *     floats.  This is otherwise identical to
+     *     sbapi_spectrometer_get_formatted_spectrum() but needs half of the
+     *     memory.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     * @param buffer (Output) A buffer (with memory already allocated) to
+     *      hold the spectral data
+     * @param buffer_length (Input) The length of the buffer
+     *
+     * @return the number of floats read into the buffer
+     */
+    DLL_DECL int
+    sbapi_spectrometer_get_formatted_spectrum_float(long deviceID,
+            long featureID, int *error_code,
+            float *buffer, int buffer_length);
+
+    /**
+     * This acquires a spectrum and returns the answer as 16-bit counts.
+     *     Byte ordering and any device-specific encoding of the pixels
+     *     (e.g. the QE Pro sign bit) have already been resolved.  Values
+     *     are rounded to the nearest count and clamped to 0..65535, so
+     *     sbapi_spectrometer_get_formatted_spectrum_uint32() should be
+     *     used for devices whose maximum intensity (as reported by
+     *     sbapi_spectrometer_get_maximum_intensity()) exceeds 65535.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     * @param buffer (Output) A buffer (with memory already allocated) to
+     *      hold the spectral data
+     * @param buffer_length (Input) The length of the buffer
+     *
+     * @return the number of pixels read into the buffer
+     */
+    DLL_DECL int
+    sbapi_spectrometer_get_formatted_spectrum_uint16(long deviceID,
+            long featureID, int *error_code,
+            unsigned short *buffer, int buffer_length);
+
+    /**
+     * This acquires a spectrum and returns the answer as 32-bit counts.
+     *     Byte ordering and any device-specific encoding of the pixels
+     *     have already been resolved, and values are rounded to the
+     *     nearest count.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     * @param buffer (Output) A buffer (with memory already allocated) to
+     *      hold the spectral data
+     * @param buffer_length (Input) The length of the buffer
+     *
+     * @return the number of pixels read into the buffer
+     */
+    DLL_DECL int
+    sbapi_spectrometer_get_formatted_spectrum_uint32(long deviceID,
+            long featureID, int *error_code,
+            unsigned int *buffer, int buffer_length);
+
+    /**
+     * This acquires a spectrum and returns the answer in formatted
+     *     floats, along with the metadata that the device sent with it.
+     *     This is otherwise identical to
+     *     sbapi_spectrometer_get_formatted_spectrum().  Devices that do not
+     *     send metadata with their spectra (e.g. the FlameX outside of fast
+     *     buffering) report ERROR_NOT_IMPLEMENTED.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     * @param buffer (Output) A buffer (with memory already allocated) to
+     *      hold the spectral data
+     * @param buffer_length (Input) The length of the buffer
+     * @param metadata (Output) Filled in with the metadata of the spectrum
+     *
+     * @return the number of floats read into the buffer
+     */
+    DLL_DECL int
+    sbapi_spectrometer_get_formatted_spectrum_with_metadata(long deviceID,
+            long featureID, int *error_code,
+            double *buffer, int buffer_length,
+            sbapi_spectrum_metadata_t *metadata);
+
+    /**
+     * This returns the metadata of the spectrum that was most recently
+     *     returned by any of the sbapi_spectrometer_get_formatted_spectrum
+     *     functions for this feature.  It does not communicate with the
+     *     device.  ERROR_NOT_IMPLEMENTED is reported if that spectrum came
+     *     without metadata or no spectrum has been read yet.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     * @param metadata (Output) Filled in with the metadata of the spectrum
+     */
+    DLL_DECL void
+    sbapi_spectrometer_get_formatted_spectrum_metadata(long deviceID,
+            long featureID, int *error_code,
+            sbapi_spectrum_metadata_t *metadata);
+
     /**
      * This returns an integer denoting the length of a raw spectrum
      * (as returned by get_unformatted_spectrum(...)).
@@ -1031,6 +1409,385 @@ extern "C" {
                                                 long spectrometerFeatureID, int *error_code,
                                                 unsigned char *buffer, int buffer_length, unsigned int numberOfSamplesToRetrieve);
 
+    /**
+     * This starts a library thread that keeps fast buffer requests in
+     *     flight and queues every spectrum that the device returns, so that
+     *     the application does not have to pair up
+     *     sbapi_spectrometer_fast_buffer_spectrum_request() and
+     *     sbapi_spectrometer_fast_buffer_spectrum_response() itself.  Fast
+     *     buffering is enabled on the device if it has a fast buffer
+     *     feature.  The stream takes the device's lock for each round of
+     *     requests and their responses and lets it go in between, so other
+     *     calls to the device wait for at most one round while it runs.
+     *     Spectrum prefetching is suspended until the stream stops.  Calling
+     *     this while a stream is already running has no effect.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     * @param capacity (Input) How many spectra to queue before new ones
+     *      are dropped.  This is rounded up to a power of two.
+     *
+     * @return the number of bytes that each queued spectrum occupies, in the
+     *      same layout as sbapi_spectrometer_get_fast_buffer_spectrum()
+     *      uses for each spectrum, or 0 on error
+     */
+    DLL_DECL int
+    sbapi_spectrometer_start_fast_buffer_stream(long deviceID,
+            long featureID, int *error_code, int capacity);
+
+    /**
+     * This takes as many whole spectra from the front of the stream's queue
+     *     as fit in the buffer.  It never waits for the device, so it
+     *     returns 0 if nothing is queued yet.  Spectra that were queued
+     *     before the stream stopped can still be read.  If the stream
+     *     stopped because of an error, ERROR_TRANSFER_ERROR is reported
+     *     once the queue is empty.  This must not be called from more than
+     *     one thread at a time.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     * @param buffer (Output) A buffer (with memory already allocated) to
+     *      hold the spectra
+     * @param buffer_length (Input) The length of the buffer in bytes
+     *
+     * @return the number of bytes copied into the buffer
+     */
+    DLL_DECL int
+    sbapi_spectrometer_read_fast_buffer_stream(long deviceID,
+            long featureID, int *error_code,
+            unsigned char *buffer, int buffer_length);
+
+    /**
+     * This stops the stream's thread once the requests that are still in
+     *     flight have been answered, leaving the device ready for other
+     *     commands.  Closing the device also stops the stream.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     */
+    DLL_DECL void
+    sbapi_spectrometer_stop_fast_buffer_stream(long deviceID,
+            long featureID, int *error_code);
+
+    /**
+     * This returns how many spectra the stream has dropped because its
+     *     queue was full.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     *
+     * @return the number of spectra dropped since the stream was started
+     */
+    DLL_DECL unsigned int
+    sbapi_spectrometer_get_fast_buffer_stream_overruns(long deviceID,
+            long featureID, int *error_code);
+
+    /**
+     * This returns the number of bytes that each spectrum occupies in the
+     *     data returned by sbapi_spectrometer_get_fast_buffer_spectrum() and
+     *     sbapi_spectrometer_read_fast_buffer_stream().  Each such record
+     *     starts with 64 bytes of metadata, followed by the pixels and a
+     *     4-byte checksum.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     *
+     * @return the length of one record in bytes, or 0 if the device has no
+     *      fast buffer
+     */
+    DLL_DECL int
+    sbapi_spectrometer_get_fast_buffer_spectrum_length(long deviceID,
+            long featureID, int *error_code);
+
+    /**
+     * This checks and decodes the spectra returned by
+     *     sbapi_spectrometer_get_fast_buffer_spectrum() or
+     *     sbapi_spectrometer_read_fast_buffer_stream() without moving them.
+     *     Record i starts at offset i times the length reported by
+     *     sbapi_spectrometer_get_fast_buffer_spectrum_length(), and its
+     *     pixels start 64 bytes after that.  Records whose checksum does not
+     *     match are still decoded, but are flagged as corrupt.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     * @param buffer (Input) The spectra as returned by the device
+     * @param buffer_length (Input) The number of bytes in the buffer
+     * @param metadata (Output) An array with room for max_spectra entries
+     *      that will receive the metadata of each spectrum
+     * @param valid (Output) An array with room for max_spectra entries, each
+     *      set to 1 if that spectrum's checksum matched and 0 if not
+     * @param max_spectra (Input) The number of entries in both arrays
+     *
+     * @return the number of spectra decoded
+     */
+    DLL_DECL int
+    sbapi_spectrometer_decode_fast_buffer_spectra(long deviceID,
+            long featureID, int *error_code,
+            const unsigned char *buffer, int buffer_length,
+            sbapi_spectrum_metadata_t *metadata, unsigned char *valid,
+            int max_spectra);
+
+    /**
+     * This binds a spectrometer feature of an open device to a session, so
+     *     that spectra acquired through the session go straight to the bus
+     *     without looking up the device, feature, protocol and transfer
+     *     helpers on every call.  This is worthwhile when spectra are read
+     *     thousands of times a second.  A session stays valid if the device
+     *     is closed and opened again, but it keeps the device's ID in use
+     *     until it is closed with sbapi_spectrometer_close_session().
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     *
+     * @return a session ID greater than zero, or 0 on error
+     */
+    DLL_DECL long
+    sbapi_spectrometer_open_session(long deviceID, long featureID,
+            int *error_code);
+
+    /**
+     * This releases a session made by sbapi_spectrometer_open_session().
+     *     A call that is already using the session is not interrupted; the
+     *     session is freed once that call returns.  The session ID is not
+     *     reused.
+     *
+     * @param sessionID (Input) The session to close
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     */
+    DLL_DECL void
+    sbapi_spectrometer_close_session(long sessionID, int *error_code);
+
+    /**
+     * This acquires a spectrum through a session exactly as
+     *     sbapi_spectrometer_get_formatted_spectrum() would.
+     *
+     * @param sessionID (Input) A session from
+     *      sbapi_spectrometer_open_session()
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     * @param buffer (Output) A buffer (with memory already allocated) to hold
+     *      the spectral data
+     * @param buffer_length (Input) The length of the buffer
+     *
+     * @return the number of pixels written into the buffer
+     */
+    DLL_DECL int
+    sbapi_spectrometer_session_get_formatted_spectrum(long sessionID,
+            int *error_code, double *buffer, int buffer_length);
+
+    /**
+     * As sbapi_spectrometer_session_get_formatted_spectrum(), but into
+     *     the narrower types of sbapi_spectrometer_get_formatted_spectrum_float(),
+     *     sbapi_spectrometer_get_formatted_spectrum_uint16() and
+     *     sbapi_spectrometer_get_formatted_spectrum_uint32().
+     */
+    DLL_DECL int
+    sbapi_spectrometer_session_get_formatted_spectrum_float(long sessionID,
+            int *error_code, float *buffer, int buffer_length);
+    DLL_DECL int
+    sbapi_spectrometer_session_get_formatted_spectrum_uint16(long sessionID,
+            int *error_code, unsigned short *buffer, int buffer_length);
+    DLL_DECL int
+    sbapi_spectrometer_session_get_formatted_spectrum_uint32(long sessionID,
+            int *error_code, unsigned int *buffer, int buffer_length);
+
+    /**
+     * This acquires a spectrum through a session exactly as
+     *     sbapi_spectrometer_get_unformatted_spectrum() would.
+     *
+     * @param sessionID (Input) A session from
+     *      sbapi_spectrometer_open_session()
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     * @param buffer (Output) A buffer (with memory already allocated) to hold
+     *      the spectral data
+     * @param buffer_length (Input) The length of the buffer in bytes
+     *
+     * @return the number of bytes read into the buffer
+     */
+    DLL_DECL int
+    sbapi_spectrometer_session_get_unformatted_spectrum(long sessionID,
+            int *error_code, unsigned char *buffer, int buffer_length);
+
+    /**
+     * This queues an acquisition as sbapi_spectrometer_get_formatted_spectrum()
+     *     would do it, and returns without waiting for the spectrum.  Each
+     *     device has a thread of its own that carries out its acquisitions
+     *     in the order in which they were submitted, so several devices
+     *     can be acquiring at once.  Synchronous calls to the same device
+     *     are kept in sequence with the queued acquisitions.
+     *
+     *     If a callback is given, it is called on that thread once the
+     *     acquisition completes, and the request ID is only passed to it
+     *     for reference.  Otherwise the outcome must be collected with
+     *     sbapi_spectrometer_get_acquisition_result(), after checking on it
+     *     with sbapi_spectrometer_wait_acquisition() if desired.  Pending
+     *     acquisitions fail with ERROR_NO_DEVICE if the device goes away.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.  This only tells whether the acquisition
+     *      could be queued.
+     * @param buffer (Output) A buffer (with memory already allocated) to hold
+     *      the spectral data.  It must remain valid until the acquisition
+     *      has completed.
+     * @param buffer_length (Input) The length of the buffer
+     * @param callback (Input) The function to call on completion, or NULL
+     * @param user_data (Input) Passed to the callback unchanged
+     *
+     * @return a request ID greater than zero, or 0 on error
+     */
+    DLL_DECL long
+    sbapi_spectrometer_submit_formatted_spectrum(long deviceID,
+            long featureID, int *error_code, double *buffer,
+            int buffer_length, sbapi_acquisition_callback callback,
+            void *user_data);
+
+    /**
+     * As sbapi_spectrometer_submit_formatted_spectrum(), but for the raw
+     *     bytes of sbapi_spectrometer_get_unformatted_spectrum().
+     */
+    DLL_DECL long
+    sbapi_spectrometer_submit_unformatted_spectrum(long deviceID,
+            long featureID, int *error_code, unsigned char *buffer,
+            int buffer_length, sbapi_acquisition_callback callback,
+            void *user_data);
+
+    /**
+     * This checks on or waits for an acquisition that was submitted
+     *     without a callback.  The request remains valid afterwards.
+     *
+     * @param requestID (Input) A request ID returned by one of the
+     *      sbapi_spectrometer_submit_*() functions
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     * @param timeout_millis (Input) How long to wait.  Zero only polls, and
+     *      a negative value waits until the acquisition completes.
+     *
+     * @return 1 if the acquisition has completed, or 0 if not
+     */
+    DLL_DECL int
+    sbapi_spectrometer_wait_acquisition(long requestID, int *error_code,
+            int timeout_millis);
+
+    /**
+     * This waits for an acquisition that was submitted without a callback
+     *     to complete and then releases its request ID.  Each request must
+     *     be collected exactly once.  Other threads may still be waiting on
+     *     it with sbapi_spectrometer_wait_acquisition(); they return once it
+     *     completes.
+     *
+     * @param requestID (Input) A request ID returned by one of the
+     *      sbapi_spectrometer_submit_*() functions
+     * @param error_code (Output) pointer to an integer that receives the
+     *      error code of the acquisition itself
+     *
+     * @return the number of pixels or bytes written into the buffer
+     */
+    DLL_DECL int
+    sbapi_spectrometer_get_acquisition_result(long requestID,
+            int *error_code);
+
+    /**
+     * This makes a group of spectrometers, each on a different device,
+     *     that acquire together.  Every member is sent its request before
+     *     any of them is read, so their integrations start within a bus
+     *     transfer of each other instead of one after the other, and the
+     *     responses are then read in parallel.  Membership is fixed when
+     *     the group is made.  The devices must stay open while the group
+     *     is in use, but the group keeps them from being destroyed.
+     *
+     * @param deviceIDs (Input) The devices, each previously opened with
+     *      sbapi_open_device().  No device may appear twice.
+     * @param featureIDs (Input) The spectrometer feature to use on each
+     *      device, in the same order as the devices
+     * @param count (Input) The number of members
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     *
+     * @return a group ID greater than zero, or 0 on error
+     */
+    DLL_DECL long
+    sbapi_create_acquisition_group(const long *deviceIDs,
+            const long *featureIDs, int count, int *error_code);
+
+    /**
+     * This releases a group made by sbapi_create_acquisition_group().  An
+     *     acquisition already in progress on the group is not interrupted;
+     *     the group is freed once it finishes.  The group ID is not reused.
+     *
+     * @param groupID (Input) The group to destroy
+     * @param error_code (Output) pointer to an integer that can be used for
+     *      storing error codes.
+     */
+    DLL_DECL void
+    sbapi_destroy_acquisition_group(long groupID, int *error_code);
+
+    /**
+     * This acquires one formatted spectrum from every member of a group.
+     *     The devices are held for the whole acquisition, so it waits for
+     *     any other call to them to return first.  The request and
+     *     completion times of each member show how closely they were
+     *     aligned.
+     *
+     * @param groupID (Input) A group from sbapi_create_acquisition_group()
+     * @param error_code (Output) pointer to an integer that receives the
+     *      error code of the first member that failed, if any did
+     * @param buffer (Output) A buffer with room for one row of
+     *      pixels_per_spectrum values for each member, in the order the
+     *      members were given
+     * @param pixels_per_spectrum (Input) The length of each row
+     * @param results (Output) One entry for each member, in the same order
+     * @param max_results (Input) The number of entries in results.  This
+     *      must be at least the number of members.
+     *
+     * @return the number of members, or 0 on error
+     */
+    DLL_DECL int
+    sbapi_acquisition_group_get_formatted_spectra(long groupID,
+            int *error_code, double *buffer, int pixels_per_spectrum,
+            sbapi_group_spectrum_t *results, int max_results);
+
 
     /**
      * This computes the wavelengths for the spectrometer and fills in the
@@ -1101,6 +1858,39 @@ extern "C" {
     sbapi_spectrometer_get_electric_dark_pixel_indices(long deviceID,
             long featureID, int *error_code, int *indices, int length);
 
+    /**
+     * This gathers everything that one frame needs in a single call: the
+     *     spectrum, the wavelengths, the integration time used, and the
+     *     board and TEC temperatures, as selected by frame->items.  The
+     *     device is only looked up and locked once, the wavelengths come
+     *     from the cached calibration, and the integration time needs no
+     *     transfer at all.  With prefetching enabled, the spectrum that was
+     *     already in flight is read first and the next one is requested
+     *     after the temperatures, so they do not disturb it.  The
+     *     temperatures are those of the device's first temperature and TEC
+     *     features.  On a device that allows it, the temperature queries
+     *     are pipelined together rather than sent one after another.
+     *
+     *     Every item that was asked for is attempted even if an earlier one
+     *     fails.  The integration time is what the spectrum's metadata
+     *     reports if there is any, and otherwise what was last set; it is
+     *     ERROR_VALUE_NOT_FOUND if neither is known.
+     *
+     * @param deviceID (Input) The index of a device previously opened with
+     *      sbapi_open_device().
+     * @param featureID (Input) The ID of a particular instance of a
+     *      spectrometer feature.  Valid IDs can be found with the
+     *      sbapi_get_spectrometer_features() function.
+     * @param error_code (Output) pointer to an integer that receives the
+     *      error code of the first item that could not be gathered
+     * @param frame (Input/Output) What to gather, and where to put it
+     *
+     * @return the SBAPI_FRAME_* flags of the items that were filled in
+     */
+    DLL_DECL int
+    sbapi_spectrometer_acquire_frame(long deviceID, long featureID,
+            int *error_code, sbapi_frame_t *frame);
+
     /**
      * This function returns the total number of pixel binning instances available
      * in the indicated device.
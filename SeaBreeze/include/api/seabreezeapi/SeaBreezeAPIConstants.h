@@ -54,4 +54,16 @@
 #define ERROR_VALUE_NOT_EXPECTED		11
 #define ERROR_INVALID_TRIGGER_MODE		12
 
+/* Events passed to an sbapi_hot_plug_callback */
+#define SBAPI_DEVICE_ADDED              1
+#define SBAPI_DEVICE_REMOVED            2
+
+/* Items that sbapi_spectrometer_acquire_frame() can gather */
+#define SBAPI_FRAME_SPECTRUM            0x01
+#define SBAPI_FRAME_METADATA            0x02
+#define SBAPI_FRAME_WAVELENGTHS         0x04
+#define SBAPI_FRAME_INTEGRATION_TIME    0x08
+#define SBAPI_FRAME_TEMPERATURES        0x10
+#define SBAPI_FRAME_TEC_TEMPERATURE     0x20
+
 #endif /* SEABREEZEAPICONSTANTS_H */
@@ -40,8 +40,16 @@
 
 #include "api/seabreezeapi/SeaBreezeAPI.h"
 #include "api/seabreezeapi/DeviceAdapter.h"
-
-class SeaBreezeAPI_Impl : SeaBreezeAPI {
+#include "api/seabreezeapi/SpectrometerSession.h"
+#include "api/seabreezeapi/AcquisitionRequest.h"
+#include "api/seabreezeapi/AcquisitionGroup.h"
+#include "native/usb/NativeUSB.h"
+#include "native/usb/USBHotPlugMonitor.h"
+#include "native/system/Mutex.h"
+#include "native/system/ReadWriteLock.h"
+#include <map>
+
+class SeaBreezeAPI_Impl : SeaBreezeAPI, public seabreeze::USBHotPlugListener {
 public:
     virtual ~SeaBreezeAPI_Impl();
     
@@ -50,10 +58,23 @@ public:
     virtual int addRS232DeviceLocation(char *deviceTypeName, char *deviceBusPath,
         unsigned int baud);
 
+    /* Hot-plug support */
+    virtual int enableHotPlug(sbapi_hot_plug_callback callback, void *userData,
+        int *errorCode);
+    virtual int enableHotPlug(seabreeze::USBHotPlugEventSource *source,
+        sbapi_hot_plug_callback callback, void *userData, int *errorCode);
+    virtual void disableHotPlug(int *errorCode);
+
+    virtual int setDescriptorCacheFile(const char *path, int *errorCode);
+
+    /* Inherited from USBHotPlugListener */
+    virtual void usbHotPlugEvent(const seabreeze::USBHotPlugEvent &event);
+
     virtual int getNumberOfDeviceIDs();
     virtual int getDeviceIDs(long *ids, unsigned long maxLength);
     virtual int openDevice(long id, int *errorCode);
     virtual void closeDevice(long id, int *errorCode);
+    virtual void resyncDeviceSettings(long id, int *errorCode);
 
     virtual int getDeviceType(long id, int *errorCode, char *buffer, unsigned int length);
     
@@ -75,10 +96,17 @@ public:
     virtual int getNumberOfSpectrometerFeatures(long id, int *errorCode);
     virtual int getSpectrometerFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength);
     virtual void spectrometerSetTriggerMode(long deviceID, long spectrometerFeatureID, int *errorCode, int mode);
+    virtual void spectrometerSetPrefetchEnable(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char prefetchEnable);
     virtual void spectrometerSetIntegrationTimeMicros(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned long integrationTimeMicros);
     virtual unsigned long spectrometerGetMinimumIntegrationTimeMicros(long deviceID, long spectrometerFeatureID, int *errorCode);
     virtual unsigned long spectrometerGetMaximumIntegrationTimeMicros(long deviceID, long spectrometerFeatureID, int *errorCode);
     virtual double spectrometerGetMaximumIntensity(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual int spectrometerStartFastBufferStream(long deviceID, long spectrometerFeatureID, int *errorCode, int capacity);
+    virtual int spectrometerReadFastBufferStream(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength);
+    virtual void spectrometerStopFastBufferStream(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual unsigned int spectrometerGetFastBufferStreamOverruns(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual int spectrometerGetFastBufferSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual int spectrometerDecodeFastBufferSpectra(long deviceID, long spectrometerFeatureID, int *errorCode, const unsigned char *buffer, int bufferLength, sbapi_spectrum_metadata_t *metadata, unsigned char *valid, int maxSpectra);
     virtual int spectrometerGetUnformattedSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode);
     virtual int spectrometerGetUnformattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength);
 	virtual int spectrometerGetFastBufferSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength, unsigned int numberOfSamplesToRetrieve);
@@ -86,9 +114,35 @@ public:
 	virtual int spectrometerFastBufferSpectrumResponse(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength, unsigned int numberOfSamplesToRetrieve);
 	virtual int spectrometerGetFormattedSpectrumLength(long deviceID, long spectrometerFeatureID, int *errorCode);
     virtual int spectrometerGetFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength);
+    virtual int spectrometerGetFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, float *buffer, int bufferLength);
+    virtual int spectrometerGetFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned short *buffer, int bufferLength);
+    virtual int spectrometerGetFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned int *buffer, int bufferLength);
+    virtual int spectrometerGetFormattedSpectrumWithMetadata(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength, sbapi_spectrum_metadata_t *metadata);
+    virtual void spectrometerGetFormattedSpectrumMetadata(long deviceID, long spectrometerFeatureID, int *errorCode, sbapi_spectrum_metadata_t *metadata);
     virtual int spectrometerGetWavelengths(long deviceID, long spectrometerFeatureID, int *errorCode, double *wavelengths, int length);
     virtual int spectrometerGetElectricDarkPixelCount(long deviceID, long spectrometerFeatureID, int *errorCode);
     virtual int spectrometerGetElectricDarkPixelIndices(long deviceID, long spectrometerFeatureID, int *errorCode, int *indices, int length);
+    virtual int spectrometerAcquireFrame(long deviceID, long spectrometerFeatureID, int *errorCode, sbapi_frame_t *frame);
+
+    /* Spectrometer sessions */
+    virtual long spectrometerOpenSession(long deviceID, long spectrometerFeatureID, int *errorCode);
+    virtual void spectrometerCloseSession(long sessionID, int *errorCode);
+    virtual int spectrometerSessionGetUnformattedSpectrum(long sessionID, int *errorCode, unsigned char *buffer, int bufferLength);
+    virtual int spectrometerSessionGetFormattedSpectrum(long sessionID, int *errorCode, double *buffer, int bufferLength);
+    virtual int spectrometerSessionGetFormattedSpectrum(long sessionID, int *errorCode, float *buffer, int bufferLength);
+    virtual int spectrometerSessionGetFormattedSpectrum(long sessionID, int *errorCode, unsigned short *buffer, int bufferLength);
+    virtual int spectrometerSessionGetFormattedSpectrum(long sessionID, int *errorCode, unsigned int *buffer, int bufferLength);
+
+    /* Acquisitions that do not wait for the spectrum */
+    virtual long spectrometerSubmitFormattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, double *buffer, int bufferLength, sbapi_acquisition_callback callback, void *userData);
+    virtual long spectrometerSubmitUnformattedSpectrum(long deviceID, long spectrometerFeatureID, int *errorCode, unsigned char *buffer, int bufferLength, sbapi_acquisition_callback callback, void *userData);
+    virtual int spectrometerWaitAcquisition(long requestID, int *errorCode, int timeoutMillis);
+    virtual int spectrometerGetAcquisitionResult(long requestID, int *errorCode);
+
+    /* Groups of spectrometers that acquire together */
+    virtual long createAcquisitionGroup(const long *deviceIDs, const long *spectrometerFeatureIDs, int count, int *errorCode);
+    virtual void destroyAcquisitionGroup(long groupID, int *errorCode);
+    virtual int acquisitionGroupGetFormattedSpectra(long groupID, int *errorCode, double *buffer, int pixelsPerSpectrum, sbapi_group_spectrum_t *results, int maxResults);
 
     /* Pixel binning capabilities */
     virtual int getNumberOfPixelBinningFeatures(long id, int *errorCode);
@@ -333,12 +387,124 @@ public:
 private:
     SeaBreezeAPI_Impl();
 
-    seabreeze::api::DeviceAdapter *getDeviceByID(unsigned long id);
+    /* Looks up a device and holds a reference to it for as long as the
+     * guard exists, so that a hot-plug removal cannot delete the adapter
+     * part way through a call.  Unless told otherwise, the device's own
+     * lock is held for the same time, which keeps calls to one device in
+     * sequence while calls to different devices run side by side.
+     */
+    class DeviceGuard {
+    public:
+        DeviceGuard(SeaBreezeAPI_Impl *api, unsigned long id,
+                bool lockDevice = true);
+        ~DeviceGuard();
+
+        operator seabreeze::api::DeviceAdapter *() const;
+        seabreeze::api::DeviceAdapter *operator->() const;
+
+    private:
+        DeviceGuard(const DeviceGuard &that);
+        DeviceGuard &operator=(const DeviceGuard &that);
+
+        SeaBreezeAPI_Impl *api;
+        seabreeze::api::DeviceAdapter *adapter;
+        bool locked;
+    };
+
+    /* Returns the adapter with a reference already taken, or NULL */
+    seabreeze::api::DeviceAdapter *retainDeviceByID(unsigned long id);
+    void releaseDevice(seabreeze::api::DeviceAdapter *adapter);
+    void retireDevice(seabreeze::api::DeviceAdapter *adapter);
+
+    /* Returns the session with a reference already taken, or NULL */
+    seabreeze::api::SpectrometerSession *retainSessionByID(long id);
+    void releaseSession(seabreeze::api::SpectrometerSession *session);
+    /* Deletes the session and then releases the device it held */
+    void deleteSession(seabreeze::api::SpectrometerSession *session);
+    /* Returns the group with a reference already taken, or NULL */
+    seabreeze::api::AcquisitionGroup *retainGroupByID(long id);
+    void releaseGroup(seabreeze::api::AcquisitionGroup *group);
+    /* Deletes the group and then releases the devices it held */
+    void deleteGroup(seabreeze::api::AcquisitionGroup *group);
+
+    long allocateAcquisitionID();
+    /* Returns the request with a reference already taken, or NULL */
+    seabreeze::api::AcquisitionRequest *retainAcquisitionByID(long id);
+    void releaseAcquisition(seabreeze::api::AcquisitionRequest *request);
+    /* Queues the request on the device's worker.  The request is deleted
+     * here if that fails.
+     */
+    long submitAcquisition(long deviceID,
+            seabreeze::api::AcquisitionRequest *request, int *errorCode);
+
+    /* Discovery support for probeDevices().  The caller must hold
+     * deviceListLock for writing when calling probeDevicesLocked().
+     */
+    int probeDevicesLocked();
+    void buildProbeTables();
+    void trackProbedLocation(int deviceTypeIndex,
+            seabreeze::DeviceLocatorInterface &location,
+            std::vector<seabreeze::api::DeviceAdapter *> &validDevices);
 
     std::vector<seabreeze::api::DeviceAdapter *> probedDevices;
     std::vector<seabreeze::api::DeviceAdapter *> specifiedDevices;
+
+    /* Every USB VID/PID that a DeviceFactory type can be found at, with the
+     * index of that type alongside.  These are gathered once so that probing
+     * does not have to create an exemplar of every device type each time.
+     */
+    bool probeTablesBuilt;
+    std::vector<USBDeviceFilter> usbProbeFilters;
+    std::vector<int> usbProbeDeviceTypes;
+    /* Device types with some other kind of prober that must still be asked */
+    std::vector<int> otherProberDeviceTypes;
+
+    /* Guards the device lists, since the hot-plug thread may change
+     * probedDevices at any time.  Looking up a device only needs it for
+     * reading.  It is also held for reading while a device is opened or
+     * closed, because the native USB layer keeps its own table of devices
+     * that a probe rewrites.
+     */
+    seabreeze::ReadWriteLock deviceListLock;
+
+    /* Held by enableHotPlug() and disableHotPlug() so that two threads
+     * cannot both replace the monitor.  The monitor thread never takes it.
+     */
+    seabreeze::Mutex hotPlugLock;
+    /* The caller must hold hotPlugLock */
+    void stopHotPlugMonitorLocked();
+    seabreeze::USBHotPlugMonitor *hotPlugMonitor;
+    sbapi_hot_plug_callback hotPlugCallback;
+    void *hotPlugUserData;
+
+    /* Open sessions by ID.  IDs count up from 1 and are never reused.
+     * Calls only hold the lock while they look up and retain a session, so
+     * closing one does not wait for an acquisition in progress; the last
+     * call to finish with a closed session deletes it.
+     */
+    std::map<long, seabreeze::api::SpectrometerSession *> sessions;
+    long nextSessionID;
+    seabreeze::ReadWriteLock sessionListLock;
+
+    /* Acquisition groups are numbered and retained the same way as sessions */
+    std::map<long, seabreeze::api::AcquisitionGroup *> groups;
+    long nextGroupID;
+    seabreeze::ReadWriteLock groupListLock;
+
+    /* Submitted acquisitions that have no callback, until their result is
+     * collected.  Those with a callback are deleted by the worker instead.
+     * Waiting on a request retains it, so collecting the result from
+     * another thread only retires it.
+     */
+    std::map<long, seabreeze::api::AcquisitionRequest *> acquisitions;
+    long nextAcquisitionID;
+    seabreeze::Mutex acquisitionLock;
+
+    /* NULL unless setDescriptorCacheFile() has named a file */
+    seabreeze::DeviceDescriptorCache *descriptorCache;
     
 friend class SeaBreezeAPI;
+friend class DeviceGuard;
 
 };
 
@@ -0,0 +1,71 @@
+/***************************************************//**
+ * @file    ShadowSetting.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Remembers the last value of a setting that was written to a device,
+ * so that writing the same value again can be skipped.  A setting is
+ * unknown until it has been written or read back, and again once it
+ * has been forgotten.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#ifndef SEABREEZE_SHADOWSETTING_H
+#define SEABREEZE_SHADOWSETTING_H
+
+namespace seabreeze {
+    namespace api {
+
+        template <class T> class ShadowSetting {
+        public:
+            ShadowSetting() : known(false), value() { }
+
+            /* True if the device is known to hold this value already */
+            bool matches(const T &v) const {
+                return (true == this->known) && (this->value == v);
+            }
+
+            bool isKnown() const { return this->known; }
+            const T &get() const { return this->value; }
+
+            /* Call once the device has accepted or reported the value */
+            void update(const T &v) {
+                this->value = v;
+                this->known = true;
+            }
+
+            /* Call whenever the device may no longer hold the value, such
+             * as after a failed transfer or a reset.
+             */
+            void forget() { this->known = false; }
+
+        private:
+            bool known;
+            T value;
+        };
+
+    }
+}
+
+#endif /* SEABREEZE_SHADOWSETTING_H */
@@ -34,9 +34,12 @@
 #define SEABREEZE_SPECTROMETER_FEATURE_ADAPTER_H
 
 #include "api/seabreezeapi/FeatureAdapterTemplate.h"
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "api/seabreezeapi/ShadowSetting.h"
 #include "common/buses/Bus.h"
 #include "common/protocols/Protocol.h"
 #include "vendors/OceanOptics/features/spectrometer/OOISpectrometerFeatureInterface.h"
+#include "vendors/OceanOptics/features/spectrometer/FastBufferSpectrumStream.h"
 
 namespace seabreeze {
     namespace api {
@@ -55,9 +58,67 @@ namespace seabreeze {
 			void fastBufferSpectrumRequest(int *errorCode, unsigned int numberOfSamplesToRetrieve);
 			int fastBufferSpectrumResponse(int *errorCode, unsigned char *buffer, int bufferLength, unsigned int numberOfSamplesToRetrieve);
 			int getFormattedSpectrum(int *errorCode,double* buffer, int bufferLength);
+            int getFormattedSpectrum(int *errorCode, float *buffer, int bufferLength);
+            int getFormattedSpectrum(int *errorCode, unsigned short *buffer, int bufferLength);
+            int getFormattedSpectrum(int *errorCode, unsigned int *buffer, int bufferLength);
+            int getFormattedSpectrumWithMetadata(int *errorCode, double *buffer,
+                    int bufferLength, sbapi_spectrum_metadata_t *metadata);
+            void getFormattedSpectrumMetadata(int *errorCode,
+                    sbapi_spectrum_metadata_t *metadata);
             int getUnformattedSpectrumLength(int *errorCode);
             int getFormattedSpectrumLength(int *errorCode);
+
+            /* Acquisition through a binding from bindSpectrumAcquisition(),
+             * which skips looking up the protocol and the bus helpers on
+             * every call.  The binding must be deleted when the device is
+             * closed.
+             */
+            SpectrometerProtocolBinding *bindSpectrumAcquisition(int *errorCode);
+            int getUnformattedSpectrum(int *errorCode,
+                    SpectrometerProtocolBinding &binding,
+                    unsigned char *buffer, int bufferLength);
+            int getFormattedSpectrum(int *errorCode,
+                    SpectrometerProtocolBinding &binding,
+                    double *buffer, int bufferLength);
+            int getFormattedSpectrum(int *errorCode,
+                    SpectrometerProtocolBinding &binding,
+                    float *buffer, int bufferLength);
+            int getFormattedSpectrum(int *errorCode,
+                    SpectrometerProtocolBinding &binding,
+                    unsigned short *buffer, int bufferLength);
+            int getFormattedSpectrum(int *errorCode,
+                    SpectrometerProtocolBinding &binding,
+                    unsigned int *buffer, int bufferLength);
+
+            /* The two halves of getFormattedSpectrum(), for callers that
+             * want to request spectra from several devices before reading
+             * any of them.  Every request must be followed by a read.
+             */
+            void requestFormattedSpectrum(int *errorCode,
+                    SpectrometerProtocolBinding &binding);
+            int readFormattedSpectrum(int *errorCode,
+                    SpectrometerProtocolBinding &binding,
+                    double *buffer, int bufferLength);
             void setTriggerMode(int *errorCode, int mode);
+
+            /* While prefetching is enabled, the next spectrum is requested
+             * as soon as one has been read, so that the device integrates
+             * while the caller is busy with the last one.  This only happens
+             * in the normal trigger mode.  The device answers one request at
+             * a time, so anything else that uses the bus must call
+             * cancelPrefetch() first; that reads and drops the spectrum in
+             * flight, which may not reflect new settings anyway.
+             */
+            void setPrefetchEnabled(int *errorCode, bool enable);
+            void cancelPrefetch();
+
+            /* For callers with more to do on the bus once the spectrum has
+             * been read: while held, reading a spectrum does not request the
+             * next one, and resumePrefetch() requests it instead.
+             */
+            void holdPrefetch();
+            void resumePrefetch();
+
             int getWavelengths(int *errorCode, double *wavelengths, int length);
             int getElectricDarkPixelCount(int *errorCode);
             int getElectricDarkPixelIndices(int *errorCode, int *indices, int length);
@@ -68,9 +129,54 @@ namespace seabreeze {
 			unsigned short getNumberOfPixels(int *errorCode);
             void setIntegrationTimeMicros(int *errorCode,
             unsigned long integrationTimeMicros);
+            /* The integration time last set through this adapter.  This is
+             * ERROR_VALUE_NOT_FOUND if none has been set since the device
+             * was opened or its settings were forgotten.
+             */
+            unsigned long getIntegrationTimeMicros(int *errorCode);
+
+            /* The integration time and trigger mode are only written when
+             * they differ from what was last written.  This forgets both,
+             * so that the next write of each goes to the device.
+             */
+            void forgetSettings();
             long getMinimumIntegrationTimeMicros(int *errorCode);
             long getMaximumIntegrationTimeMicros(int *errorCode);
             double getMaximumIntensity(int *errorCode);
+
+            /* Fast buffer streaming.  The stream calls must not overlap
+             * each other.  While the stream runs its thread holds busLock,
+             * which may be NULL, so that nothing else talks to the device
+             * until it is stopped.
+             */
+            int startFastBufferStream(int *errorCode, int capacity,
+                    seabreeze::Mutex *busLock);
+            bool isFastBufferStreaming();
+            int readFastBufferStream(int *errorCode, unsigned char *buffer, int bufferLength);
+            void stopFastBufferStream(int *errorCode);
+            unsigned int getFastBufferStreamOverruns(int *errorCode);
+            int getFastBufferSpectrumLength(int *errorCode);
+            int decodeFastBufferSpectra(int *errorCode,
+                    const unsigned char *buffer, int bufferLength,
+                    sbapi_spectrum_metadata_t *metadata, unsigned char *valid,
+                    int maxSpectra);
+
+        private:
+            template <class T> int getPrefetchedFormattedSpectrum(
+                    int *errorCode, T *buffer, int bufferLength);
+
+            FastBufferSpectrumStream *stream;
+
+            /* NULL unless prefetching is enabled */
+            SpectrometerProtocolBinding *prefetchBinding;
+            bool prefetchPending;
+            bool prefetchHeld;
+            /* The mode prefetching assumes, which is the device's default
+             * until one has been set.
+             */
+            int triggerMode;
+            ShadowSetting<int> triggerModeSetting;
+            ShadowSetting<unsigned long> integrationTimeSetting;
         };
 
     }
@@ -0,0 +1,108 @@
+/***************************************************//**
+ * @file    SpectrometerSession.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * A session binds one spectrometer feature of one device so that
+ * repeated acquisitions go straight to the bus, without looking up
+ * the device, the feature, the protocol or the transfer helpers on
+ * every call.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#ifndef SEABREEZE_SPECTROMETERSESSION_H
+#define SEABREEZE_SPECTROMETERSESSION_H
+
+#include "api/seabreezeapi/DeviceAdapter.h"
+#include "api/seabreezeapi/Retainable.h"
+#include "api/seabreezeapi/SpectrometerFeatureAdapter.h"
+#include "vendors/OceanOptics/protocols/interfaces/SpectrometerProtocolBinding.h"
+
+namespace seabreeze {
+    namespace api {
+
+        class SpectrometerSession : public Retainable {
+        public:
+            /* The device must outlive the session.  Sessions made through
+             * the API are given a reference to it that is released once the
+             * session has been deleted; a device's own worker needs none.
+             */
+            SpectrometerSession(DeviceAdapter *device, long featureID);
+            ~SpectrometerSession();
+
+            DeviceAdapter *getDevice();
+
+            /* Resolves everything up front so that the first acquisition is
+             * no slower than the rest.  Returns false, with the error code
+             * set, if the feature does not exist or cannot be bound.
+             */
+            bool prepare(int *errorCode);
+
+            /* These take the device's lock for the duration of the call */
+            int getUnformattedSpectrum(int *errorCode, unsigned char *buffer,
+                    int bufferLength);
+            int getFormattedSpectrum(int *errorCode, double *buffer,
+                    int bufferLength);
+            int getFormattedSpectrum(int *errorCode, float *buffer,
+                    int bufferLength);
+            int getFormattedSpectrum(int *errorCode, unsigned short *buffer,
+                    int bufferLength);
+            int getFormattedSpectrum(int *errorCode, unsigned int *buffer,
+                    int bufferLength);
+
+            /* These are for callers that work with several devices at once,
+             * and must be called with the device's lock already held.  A
+             * successful request must be followed by a read, and the
+             * metadata then describes the spectrum that was read.
+             */
+            bool requestFormattedSpectrum(int *errorCode);
+            int readFormattedSpectrum(int *errorCode, double *buffer,
+                    int bufferLength);
+            bool getFormattedSpectrumMetadata(int *errorCode,
+                    sbapi_spectrum_metadata_t *metadata);
+
+        private:
+            SpectrometerSession(const SpectrometerSession &that);
+            SpectrometerSession &operator=(const SpectrometerSession &that);
+
+            template <class T> int getFormattedSpectrumInto(int *errorCode,
+                    T *buffer, int bufferLength);
+
+            /* Must be called with the device's lock held.  This resolves
+             * the feature and binding again if the device has been opened
+             * or closed since they were last resolved.
+             */
+            bool bind(int *errorCode);
+
+            DeviceAdapter *device;
+            long featureID;
+            unsigned long connection;
+            SpectrometerFeatureAdapter *feature;
+            SpectrometerProtocolBinding *binding;
+        };
+
+    }
+}
+
+#endif /* SEABREEZE_SPECTROMETERSESSION_H */
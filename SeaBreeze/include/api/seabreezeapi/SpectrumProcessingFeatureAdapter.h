@@ -34,6 +34,7 @@
 #define SEABREEZE_SPECTRUMPROCESSINGFEATUREADAPTER_H
 
 #include "api/seabreezeapi/FeatureAdapterTemplate.h"
+#include "api/seabreezeapi/ShadowSetting.h"
 #include "vendors/OceanOptics/features/spectrum_processing/SpectrumProcessingFeatureInterface.h"
 
 namespace seabreeze {
@@ -52,6 +53,15 @@ namespace seabreeze {
             void writeSpectrumProcessingBoxcarWidth(int *errorCode, unsigned char boxcarWidth);
             void writeSpectrumProcessingScansToAverage(int *errorCode, unsigned short int scansToAverage);
 
+            /* Values are only written when they differ from what was last
+             * written or read back.  This forgets them, so that the next
+             * write of each goes to the device.
+             */
+            void forgetSettings();
+
+        private:
+            ShadowSetting<unsigned char> boxcarWidthSetting;
+            ShadowSetting<unsigned short int> scansToAverageSetting;
         };
 
     }
@@ -50,6 +50,11 @@ namespace seabreeze {
 			unsigned char readTemperatureCount(int *errorCode);
             double readTemperature(int *errorCode, int index);
             int readAllTemperatures(int *errorCode, double *buffer, int bufferLength);
+            /* The TEC temperature rides along with the others; tecRead
+             * says whether the device answered it.
+             */
+            int readAllTemperaturesWithTEC(int *errorCode, double *buffer,
+                    int bufferLength, double *tecTemperature, bool *tecRead);
         };
 
     }
@@ -34,6 +34,7 @@
 #define SEABREEZE_THERMO_ELECTRIC_COOLER_FEATURE_ADAPTER_H
 
 #include "api/seabreezeapi/FeatureAdapterTemplate.h"
+#include "api/seabreezeapi/ShadowSetting.h"
 #include "vendors/OceanOptics/features/thermoelectric/ThermoElectricFeatureInterface.h"
 
 namespace seabreeze {
@@ -53,6 +54,16 @@ namespace seabreeze {
                     double temperature_degrees_celsius);
             void setTECEnable(int *errorCode, bool tecEnable);
             void setTECFanEnable(int *errorCode, bool tecFanEnable);
+
+            /* The setpoint and enable are only written when they differ
+             * from what was last written.  This forgets them, so that the
+             * next write of each goes to the device.
+             */
+            void forgetSettings();
+
+        private:
+            ShadowSetting<double> setpointSetting;
+            ShadowSetting<bool> enableSetting;
         };
 
     }
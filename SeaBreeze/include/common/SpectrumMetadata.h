@@ -0,0 +1,64 @@
+/***************************************************//**
+ * @file    SpectrumMetadata.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This holds the metadata that some devices send along
+ * with each spectrum, decoded from whatever layout the
+ * device uses.  The device clock and spectrum count allow
+ * a caller to detect dropped spectra and to line up
+ * spectra from a fast acquisition without asking the
+ * device for the time separately.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SPECTRUMMETADATA_H
+#define SPECTRUMMETADATA_H
+
+namespace seabreeze {
+
+    class SpectrumMetadata {
+    public:
+        SpectrumMetadata() : spectrumCount(0), tickCountMicros(0),
+                integrationTimeMicros(0), triggerMode(0) { }
+
+        /* Incremented by the device for every spectrum it acquires, so a
+         * gap between successive spectra means that some were not read.
+         */
+        unsigned int spectrumCount;
+
+        /* The device clock when the spectrum was acquired, in microseconds */
+        unsigned long long tickCountMicros;
+
+        /* The integration time that was actually used for the spectrum */
+        unsigned int integrationTimeMicros;
+
+        /* The trigger mode that the spectrum was acquired in */
+        unsigned char triggerMode;
+    };
+
+}
+
+#endif /* SPECTRUMMETADATA_H */
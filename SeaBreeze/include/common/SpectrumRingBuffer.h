@@ -0,0 +1,88 @@
+/***************************************************//**
+ * @file    SpectrumRingBuffer.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This is a fixed-size queue of spectra that one thread
+ * fills while another empties it.  Neither side ever
+ * blocks or takes a lock, so a thread that is draining a
+ * device is never held up by a slow consumer; if the
+ * consumer falls behind, new spectra are dropped and
+ * counted instead.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SPECTRUMRINGBUFFER_H
+#define SPECTRUMRINGBUFFER_H
+
+#include <vector>
+#include "common/SeaBreeze.h"
+
+namespace seabreeze {
+
+    class SpectrumRingBuffer {
+    public:
+        /* Every record is recordLength bytes.  The capacity is rounded up
+         * to a power of two.
+         */
+        SpectrumRingBuffer(unsigned int recordLength, unsigned int capacity);
+        virtual ~SpectrumRingBuffer();
+
+        /* Only one thread may push.  Returns false, and counts an overrun,
+         * if the buffer is full.
+         */
+        bool push(const byte *record);
+
+        /* Only one thread may pop.  Copies the oldest record into the given
+         * buffer, which must hold getRecordLength() bytes.  Returns false if
+         * the buffer is empty.
+         */
+        bool pop(byte *record);
+
+        unsigned int getRecordLength() const;
+        unsigned int getCapacity() const;
+
+        /* The number of records that push() had to drop */
+        unsigned int getOverrunCount();
+
+    private:
+        SpectrumRingBuffer(const SpectrumRingBuffer &that);
+        SpectrumRingBuffer &operator=(const SpectrumRingBuffer &that);
+
+        std::vector<byte> storage;
+        unsigned int recordLength;
+        unsigned int capacity;
+
+        /* These count every record ever pushed and popped.  Each one is
+         * only written by one side, and they are allowed to wrap.
+         */
+        volatile unsigned int pushed;
+        volatile unsigned int popped;
+        volatile unsigned int overruns;
+    };
+
+}
+
+#endif /* SPECTRUMRINGBUFFER_H */
@@ -43,6 +43,12 @@
 
 namespace seabreeze {
 
+    /* One destination in a scatter list given to receiveSegments() */
+    struct TransferSegment {
+        byte *data;
+        unsigned int length;
+    };
+
     class TransferHelper {
     public:
         TransferHelper();
@@ -51,6 +57,40 @@ namespace seabreeze {
             throw (BusTransferException) = 0;
         virtual int send(const std::vector<byte> &buffer, unsigned int length) const
             throw (BusTransferException) = 0;
+
+        /* Receives length bytes into the given buffer starting at offset,
+         * which lets a caller assemble a message in its final location.  The
+         * buffer must already hold at least offset + length bytes.  Helpers
+         * that can read straight into the middle of a buffer override this;
+         * the default goes through receive() and a temporary.
+         */
+        virtual int receiveInto(std::vector<byte> &buffer, unsigned int offset,
+                unsigned int length) throw (BusTransferException);
+
+        /* Receives one message that is spread across count destinations,
+         * filling each segment in order, so that headers, payloads and
+         * padding can each land where they are needed.  This returns the
+         * total number of bytes received, which is short if the bus ran out
+         * of data early.  Helpers that can read into raw memory override
+         * this; the default makes one receive() of the total length into a
+         * temporary and copies it out.
+         */
+        virtual int receiveSegments(const TransferSegment *segments,
+                unsigned int count) throw (BusTransferException);
+
+        /* Bounds how long each later receive may wait for data, until this
+         * is called again with zero to wait as long as the bus does.  A
+         * receive that runs out of time throws BusTransferException.  The
+         * default does nothing, for buses that cannot bound a read.
+         */
+        virtual void setReceiveTimeoutMillis(unsigned int timeoutMillis);
+        virtual unsigned int getReceiveTimeoutMillis();
+
+        /* Whether receives really give up once the timeout runs out.  A
+         * caller that needs the bound, rather than just wanting it, must
+         * check this.  The default says no.
+         */
+        virtual bool isReceiveTimeoutEnforced();
     };
 
 }
@@ -43,6 +43,13 @@ namespace seabreeze {
             throw (BusTransferException);
         virtual int send(const std::vector<byte> &buffer, unsigned int length) const
             throw (BusTransferException);
+        virtual int receiveInto(std::vector<byte> &buffer, unsigned int offset,
+                unsigned int length) throw (BusTransferException);
+        virtual int receiveSegments(const TransferSegment *segments,
+                unsigned int count) throw (BusTransferException);
+        virtual void setReceiveTimeoutMillis(unsigned int timeoutMillis);
+        virtual unsigned int getReceiveTimeoutMillis();
+        virtual bool isReceiveTimeoutEnforced();
         
     protected:
         Socket *socket;
@@ -55,6 +55,10 @@ namespace seabreeze {
             throw (BusTransferException);
         virtual int send(const std::vector<byte> &buffer, unsigned int length) const
             throw (BusTransferException);
+        virtual int receiveInto(std::vector<byte> &buffer, unsigned int offset,
+                unsigned int length) throw (BusTransferException);
+        virtual int receiveSegments(const TransferSegment *segments,
+                unsigned int count) throw (BusTransferException);
 
     protected:
         RS232 *rs232;
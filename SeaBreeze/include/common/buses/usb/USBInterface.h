@@ -54,6 +54,10 @@ namespace seabreeze {
         virtual bool open() = 0;
         virtual void close() = 0;
 
+        /* The USB IDs of the type of device that this bus can talk to */
+        virtual int getVendorID() = 0;
+        virtual int getProductID() = 0;
+
     protected:
         USB *usb;
         DeviceLocatorInterface *deviceLocator;
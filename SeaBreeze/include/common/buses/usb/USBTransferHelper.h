@@ -54,11 +54,40 @@ namespace seabreeze {
             throw (BusTransferException);
         virtual int send(const std::vector<byte> &buffer, unsigned int length) const
             throw (BusTransferException);
+        virtual int receiveInto(std::vector<byte> &buffer, unsigned int offset,
+                unsigned int length) throw (BusTransferException);
+        /* Bulk reads cannot be split without changing what the device
+         * sees, so several segments cost one copy out of the scratch buffer.
+         */
+        virtual int receiveSegments(const TransferSegment *segments,
+                unsigned int count) throw (BusTransferException);
+
+        /* This relies on queued reads, so it has no effect on a platform
+         * that does not support them.
+         */
+        virtual void setReceiveTimeoutMillis(unsigned int timeoutMillis);
+        virtual unsigned int getReceiveTimeoutMillis();
+        /* Only known for certain once a read has been made with a timeout */
+        virtual bool isReceiveTimeoutEnforced();
 
     protected:
+        /* One bulk read that honors the receive timeout */
+        int read(void *data, unsigned int length) throw (BusTransferException);
+
+        /* One bulk read of length bytes, spread across the segments in
+         * order.  A lone segment that covers the whole read is filled in
+         * place; otherwise the read lands in the scratch buffer first.  Any
+         * bytes past the last segment are dropped.  This returns the number
+         * of bytes that reached the segments.
+         */
+        int readSegments(const TransferSegment *segments, unsigned int count,
+                unsigned int length) throw (BusTransferException);
+
         USB *usb;
         int sendEndpoint;
         int receiveEndpoint;
+        unsigned int receiveTimeoutMillis;
+        std::vector<byte> scratch;
     };
 
 }
@@ -0,0 +1,67 @@
+/***************************************************//**
+ * @file    DeviceDescriptor.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This holds the values that describe one particular
+ * device (e.g. its pixel layout and calibrations) by name
+ * so that they can be stored and given back to the
+ * features later without asking the hardware again.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef DEVICEDESCRIPTOR_H
+#define DEVICEDESCRIPTOR_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace seabreeze {
+
+    class DeviceDescriptor {
+    public:
+        DeviceDescriptor();
+        virtual ~DeviceDescriptor();
+
+        /* Replaces any values already stored under the given name.  An empty
+         * set of values is allowed and records that the device has none.
+         */
+        void setValues(const std::string &name, const std::vector<double> &values);
+
+        /* Returns NULL if nothing is stored under the given name */
+        const std::vector<double> *getValues(const std::string &name) const;
+
+        std::vector<std::string> getNames() const;
+        bool isEmpty() const;
+        void clear();
+
+    protected:
+        std::map<std::string, std::vector<double> > entries;
+    };
+
+}
+
+#endif /* DEVICEDESCRIPTOR_H */
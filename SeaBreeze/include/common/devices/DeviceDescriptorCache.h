@@ -0,0 +1,104 @@
+/***************************************************//**
+ * @file    DeviceDescriptorCache.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This keeps DeviceDescriptors in a file so that they
+ * survive from one run to the next.  Each descriptor is
+ * filed under a key made from the device model, serial
+ * number and firmware revision, so a different unit or a
+ * firmware update never matches an old entry.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef DEVICEDESCRIPTORCACHE_H
+#define DEVICEDESCRIPTORCACHE_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "common/devices/DeviceDescriptor.h"
+#include "native/system/Mutex.h"
+
+namespace seabreeze {
+
+    class DeviceDescriptorCache {
+    public:
+        DeviceDescriptorCache(const std::string &path);
+        virtual ~DeviceDescriptorCache();
+
+        /* Reads the file, replacing anything held in memory.  A file that
+         * does not exist yet is treated as empty.  Entries that cannot be
+         * parsed are skipped.  Returns false if the file could not be read.
+         */
+        bool load();
+
+        /* Writes the entries stored or removed here since the last load()
+         * or save() into the file, keeping whatever other processes have
+         * written to it meanwhile.  Returns false on failure.
+         */
+        bool save();
+
+        /* Copies out the descriptor for the key, returning false if there
+         * is none.  A copy is made because other devices may be storing
+         * into the cache from other threads at the same time.
+         */
+        bool find(const std::string &key, DeviceDescriptor &descriptor) const;
+        void store(const std::string &key, const DeviceDescriptor &descriptor);
+        void remove(const std::string &key);
+
+        const std::string &getPath() const;
+
+        /* Any of the parts may be empty if the device cannot report it */
+        static std::string makeKey(const std::string &model,
+                const std::string &serialNumber, const std::string &firmwareRevision);
+
+        /* Removes the key from every cache in this process and saves each
+         * one.  This is for calibrations written to a device, which may be
+         * opened through a different cache than the one doing the writing.
+         */
+        static void forgetEverywhere(const std::string &key);
+
+    protected:
+        /* The caller must hold the file lock */
+        bool readFile(std::map<std::string, DeviceDescriptor> &entries) const;
+        bool writeFile(const std::map<std::string, DeviceDescriptor> &entries) const;
+
+        std::string path;
+        std::map<std::string, DeviceDescriptor> descriptors;
+        /* Keys stored or removed since the file was last read or written */
+        std::set<std::string> changedKeys;
+        /* Every method holds this, since devices may be opened concurrently */
+        mutable Mutex lock;
+
+        /* Every cache that exists, for forgetEverywhere() */
+        static std::vector<DeviceDescriptorCache *> instances;
+        static Mutex instancesLock;
+    };
+
+}
+
+#endif /* DEVICEDESCRIPTORCACHE_H */
@@ -0,0 +1,82 @@
+/***************************************************//**
+ * @file    CalibrationCacheInterface.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This is implemented by features that keep a copy of
+ * calibration data (e.g. wavelengths or coefficients)
+ * after first reading it from the device.  Anything that
+ * changes that data on the device, such as writing an
+ * EEPROM slot, should invalidate the copy through this.
+ * The copy can also be saved into a DeviceDescriptor and
+ * restored from one on a later run.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef CALIBRATIONCACHEINTERFACE_H
+#define CALIBRATIONCACHEINTERFACE_H
+
+#include <vector>
+#include "common/buses/Bus.h"
+#include "common/devices/DeviceDescriptor.h"
+#include "common/exceptions/FeatureException.h"
+#include "common/protocols/Protocol.h"
+
+namespace seabreeze {
+
+    class CalibrationCacheInterface {
+    public:
+        virtual ~CalibrationCacheInterface() = 0;
+
+        /* Discard any cached calibration so the next read goes to the device */
+        virtual void invalidateCalibration() = 0;
+
+        /* Copy the calibration into the descriptor, reading it from the
+         * device first if it is not already cached.
+         */
+        virtual void saveCalibration(const Protocol &protocol, const Bus &bus,
+                DeviceDescriptor &descriptor) throw (FeatureException) = 0;
+
+        /* Take the calibration from the descriptor so that the device does
+         * not have to be asked for it.  Anything the descriptor lacks is read
+         * from the device when it is needed.  This returns false, and leaves
+         * the cache empty, if the stored values do not fit the device.
+         */
+        virtual bool loadCalibration(const DeviceDescriptor &descriptor) = 0;
+
+        /* Append a few values, read from the device rather than the cache,
+         * that change whenever the calibration stored on it does.  This is
+         * checked against the descriptor each time it is used, so it must
+         * cost much less than reading the whole calibration.
+         */
+        virtual void fingerprintCalibration(const Protocol &protocol, const Bus &bus,
+                std::vector<double> &fingerprint) throw (FeatureException) = 0;
+    };
+
+    /* Default implementation for (otherwise) pure virtual destructor */
+    inline CalibrationCacheInterface::~CalibrationCacheInterface() {}
+}
+
+#endif /* CALIBRATIONCACHEINTERFACE_H */
@@ -0,0 +1,100 @@
+/***************************************************//**
+ * @file    SpectrumReceiverInterface.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This is implemented by spectrum exchanges that can
+ * decode pixels straight out of their receive buffer
+ * into an array owned by the caller, so that reading a
+ * spectrum does not need to allocate anything.  The
+ * array may hold doubles, floats, or 16- or 32-bit
+ * counts.  Any metadata that arrived with the spectrum
+ * can be retrieved afterwards.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#ifndef SPECTRUMRECEIVERINTERFACE_H
+#define SPECTRUMRECEIVERINTERFACE_H
+
+#include "common/buses/TransferHelper.h"
+#include "common/exceptions/ProtocolException.h"
+#include "common/SpectrumMetadata.h"
+
+namespace seabreeze {
+
+    class SpectrumReceiverInterface {
+    public:
+        virtual ~SpectrumReceiverInterface() = 0;
+
+        /* Receive one spectrum and write up to bufferLength pixels of it,
+         * formatted the same way as transfer() would format them, into the
+         * given array.  Returns the number of pixels written.
+         */
+        virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                double *buffer, unsigned int bufferLength)
+                throw (ProtocolException) = 0;
+
+        /* As above, but into narrower types.  Integer outputs are rounded
+         * and clamped to the range of the type.
+         */
+        virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                float *buffer, unsigned int bufferLength)
+                throw (ProtocolException) = 0;
+        virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                unsigned short *buffer, unsigned int bufferLength)
+                throw (ProtocolException) = 0;
+        virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                unsigned int *buffer, unsigned int bufferLength)
+                throw (ProtocolException) = 0;
+
+        /* Copies the metadata that came with the most recently received
+         * spectrum.  Returns false if no spectrum has been received or if
+         * the message does not carry any metadata.
+         */
+        virtual bool getSpectrumMetadata(SpectrumMetadata &metadata) = 0;
+
+        /* Store one pixel into any of the above types.  These are for the
+         * use of implementations so that they convert consistently.
+         */
+        static void storePixel(double *pixel, double value) {
+            *pixel = value;
+        }
+        static void storePixel(float *pixel, double value) {
+            *pixel = (float)value;
+        }
+        static void storePixel(unsigned short *pixel, double value) {
+            *pixel = (value <= 0) ? 0
+                    : (value >= 65535) ? 65535 : (unsigned short)(value + 0.5);
+        }
+        static void storePixel(unsigned int *pixel, double value) {
+            *pixel = (value <= 0) ? 0
+                    : (value >= 4294967295.0) ? 4294967295U : (unsigned int)(value + 0.5);
+        }
+    };
+
+    /* Default implementation for (otherwise) pure virtual destructor */
+    inline SpectrumReceiverInterface::~SpectrumReceiverInterface() {}
+}
+
+#endif /* SPECTRUMRECEIVERINTERFACE_H */
@@ -91,6 +91,13 @@ namespace seabreeze {
         Transfer();
         void checkBufferSize();
 
+        /* Moves the data in this object's buffer across the bus like
+         * transfer() does, but without handing back a copy.  Subclasses
+         * that decode the buffer themselves can use this to save the
+         * allocation.
+         */
+        void transferBuffer(TransferHelper *helper) throw (ProtocolException);
+
         unsigned int length;
         std::vector<byte> *buffer;
         direction_t direction;
@@ -43,6 +43,46 @@ void sleepMilliseconds(unsigned int msecs);
 int systemInitialize();
 void systemShutdown();
 
+/* Threads, mutexes, and condition variables.  The handles are opaque so
+ * that platform types do not leak out of the native layer.  Creation
+ * functions return NULL on failure.
+ */
+void *threadCreate(void *(*function)(void *), void *argument);
+void threadJoin(void *thread);
+
+void *mutexCreate();
+void mutexLock(void *mutex);
+void mutexUnlock(void *mutex);
+void mutexDestroy(void *mutex);
+
+void *conditionCreate();
+/* Returns 0 if signalled or nonzero if timeoutMillis elapsed first.  A
+ * negative timeout waits indefinitely.  The mutex must be held.
+ */
+int conditionWait(void *condition, void *mutex, int timeoutMillis);
+void conditionSignal(void *condition);
+void conditionBroadcast(void *condition);
+void conditionDestroy(void *condition);
+
+/* Reads and writes of a value that is shared between threads without a
+ * mutex.  Everything that a thread wrote before atomicStore() is visible to
+ * another thread once atomicLoad() returns the stored value.
+ */
+unsigned int atomicLoad(volatile unsigned int *value);
+void atomicStore(volatile unsigned int *value, unsigned int newValue);
+
+/* Microseconds since some fixed point, from a clock that never steps
+ * backwards.  Only differences between two readings are meaningful.
+ */
+unsigned long long monotonicMicros();
+
+/* An advisory lock on a file that is shared with other processes.  The
+ * file is created if necessary.  This waits until the lock is free and
+ * returns NULL if the file cannot be opened.
+ */
+void *fileLockAcquire(const char *path);
+void fileLockRelease(void *lock);
+
 /* End of C prototypes */
 
 
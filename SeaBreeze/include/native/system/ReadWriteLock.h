@@ -0,0 +1,93 @@
+/***************************************************//**
+ * @file    ReadWriteLock.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * The ReadWriteLock class lets any number of readers share
+ * a resource while writers get exclusive access to it.
+ * ReadLock and WriteLock hold it for the lifetime of a scope.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SEABREEZE_READWRITELOCK_H
+#define SEABREEZE_READWRITELOCK_H
+
+#include "native/system/Mutex.h"
+#include "native/system/ConditionVariable.h"
+
+namespace seabreeze {
+
+    /* Built from a Mutex and a ConditionVariable so that it is available on
+     * every platform.  A waiting writer holds off new readers so that it
+     * cannot be starved.  Neither side may be taken recursively.
+     */
+    class ReadWriteLock {
+    public:
+        ReadWriteLock();
+        virtual ~ReadWriteLock();
+
+        void lockRead();
+        void unlockRead();
+        void lockWrite();
+        void unlockWrite();
+
+    private:
+        ReadWriteLock(const ReadWriteLock &that);
+        ReadWriteLock &operator=(const ReadWriteLock &that);
+
+        Mutex mutex;
+        ConditionVariable changed;
+        unsigned int readers;
+        unsigned int writersWaiting;
+        bool writing;
+    };
+
+    class ReadLock {
+    public:
+        ReadLock(ReadWriteLock &lock);
+        ~ReadLock();
+
+    private:
+        ReadLock(const ReadLock &that);
+        ReadLock &operator=(const ReadLock &that);
+
+        ReadWriteLock &lock;
+    };
+
+    class WriteLock {
+    public:
+        WriteLock(ReadWriteLock &lock);
+        ~WriteLock();
+
+    private:
+        WriteLock(const WriteLock &that);
+        WriteLock &operator=(const WriteLock &that);
+
+        ReadWriteLock &lock;
+    };
+
+}
+
+#endif /* SEABREEZE_READWRITELOCK_H */
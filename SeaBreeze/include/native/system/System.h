@@ -41,6 +41,7 @@ namespace seabreeze {
         virtual ~System();
 
         static void sleepMilliseconds(unsigned int millis);
+        static unsigned long long getMonotonicMicros();
         static bool initialize();
         static void shutdown();
 
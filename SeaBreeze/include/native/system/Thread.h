@@ -0,0 +1,70 @@
+/***************************************************//**
+ * @file    Thread.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * The Thread class wraps the native thread primitive.  A
+ * subclass provides run(), which is executed on a new
+ * thread by start().
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SEABREEZE_THREAD_H
+#define SEABREEZE_THREAD_H
+
+namespace seabreeze {
+
+    class Thread {
+    public:
+        Thread();
+        virtual ~Thread();
+
+        /* Returns false if the thread could not be started or is
+         * already running.
+         */
+        bool start();
+
+        /* Waits for run() to return.  This does nothing if the thread
+         * was never started.
+         */
+        void join();
+
+        bool isStarted();
+
+    protected:
+        virtual void run() = 0;
+
+    private:
+        Thread(const Thread &that);
+        Thread &operator=(const Thread &that);
+
+        static void *entryPoint(void *self);
+
+        void *handle;
+    };
+
+}
+
+#endif /* SEABREEZE_THREAD_H */
@@ -53,6 +53,9 @@ extern "C" {
 #define ABORT_FAILED    		-1
 #define RESET_OK         		0
 #define RESET_FAILED    		-1
+#define SUBMIT_FAILED   		-1
+#define SUBMIT_UNSUPPORTED		-2
+#define READ_PENDING    		-2
 
 struct USBConfigurationDescriptor {
     unsigned char bLength;
@@ -94,6 +97,21 @@ struct USBInterfaceDescriptor {
     unsigned char iInterface;
 };
 
+/* One entry in the table of devices that USBProbeAllDevices() looks for */
+struct USBDeviceFilter {
+    unsigned short vendorID;
+    unsigned short productID;
+};
+
+/* A device found by USBProbeAllDevices().  The VID and PID identify which
+ * filter it matched.
+ */
+struct USBProbedDevice {
+    unsigned long deviceID;
+    unsigned short vendorID;
+    unsigned short productID;
+};
+
 struct USBEndpointDescriptor {
     unsigned char bLength;
     unsigned char bDescriptorType;
@@ -121,6 +139,27 @@ int
 USBProbeDevices(int vendorID, int productID, unsigned long *output,
         int max_devices);
 
+//------------------------------------------------------------------------------
+// This function discovers all devices that match any of the given VID/PID
+// pairs.  Where the platform allows it, the bus is only walked once no matter
+// how many filters are given.  IDs of devices that were already known are
+// preserved, and any device of a filtered type that has gone away is
+// forgotten, so successive calls only reflect what changed.
+//
+// PARAMETERS:
+// filters:   An array of VID/PID pairs to match against devices on the bus
+// numberOfFilters: The number of entries in the filters array
+// output:    A buffer that will be populated with one entry for each device
+//            found, including the VID and PID that it matched
+// max_devices: A limit on how many entries can be put into the output buffer
+//
+// RETURN VALUE:
+// The number of devices successfully found, or -1 if there was an error.
+//------------------------------------------------------------------------------
+int
+USBProbeAllDevices(const struct USBDeviceFilter *filters, int numberOfFilters,
+        struct USBProbedDevice *output, int max_devices);
+
 //------------------------------------------------------------------------------
 // This function attempts to open a device with the given product and vendor
 // ID's at the specified index.
@@ -193,6 +232,63 @@ USBWrite(void *handle, unsigned char endpoint, char * data, int numberOfBytes);
 int
 USBRead(void *handle, unsigned char endpoint, char * data, int numberOfBytes);
 
+//------------------------------------------------------------------------------
+// This function queues a bulk read from the device attached to the given handle
+// without waiting for it to finish.  Several reads may be queued on the same
+// endpoint; they complete in the order in which they were submitted.  The
+// buffer must remain valid until USBCompleteRead() or USBCancelRead() has been
+// called with the returned ticket.
+//
+// PARAMETERS:
+// handle: The device handle obtained via the open() function.
+// endpoint: The endpoint on the device to read the data from.
+// data: A pointer to the dynamically allocated byte array to store the data.
+// size: The number of bytes to be read.
+//
+// RETURN VALUE:
+// Returns an integer which will be equal to either:
+//  - A non-negative ticket identifying the queued read
+//  - SUBMIT_FAILED if the read could not be queued
+//  - SUBMIT_UNSUPPORTED if this platform only provides blocking reads, in
+//        which case the caller should fall back to USBRead()
+//------------------------------------------------------------------------------
+int
+USBSubmitRead(void *handle, unsigned char endpoint, char *data, int numberOfBytes);
+
+//------------------------------------------------------------------------------
+// This function waits for a read queued by USBSubmitRead() to finish.
+//
+// PARAMETERS:
+// handle: The device handle obtained via the open() function.
+// ticket: The value returned by USBSubmitRead().
+// timeoutMillis: How long to wait for the read, or a negative value to
+//            wait indefinitely.  Zero polls without blocking.
+//
+// RETURN VALUE:
+// Returns an integer which will be equal to either:
+//  - The number of bytes read from the endpoint if the read was successful
+//  - READ_PENDING if the read has not finished yet; the ticket remains valid
+//  - READ_FAILED if the data was not successfully read from the device
+//------------------------------------------------------------------------------
+int
+USBCompleteRead(void *handle, int ticket, int timeoutMillis);
+
+//------------------------------------------------------------------------------
+// This function cancels a read queued by USBSubmitRead() and releases the
+// ticket.  Any data already received for that read is discarded.
+//
+// PARAMETERS:
+// handle: The device handle obtained via the open() function.
+// ticket: The value returned by USBSubmitRead().
+//
+// RETURN VALUE:
+// Returns an integer which will be equal to either:
+//  - ABORT_OK if the read was cancelled or had already finished
+//  - ABORT_FAILED if the ticket was not valid
+//------------------------------------------------------------------------------
+int
+USBCancelRead(void *handle, int ticket);
+
 //------------------------------------------------------------------------------
 // This function attempts to clear any stall on the given endpoint.
 //
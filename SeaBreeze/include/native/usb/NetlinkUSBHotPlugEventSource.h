@@ -0,0 +1,59 @@
+/***************************************************//**
+ * @file    NetlinkUSBHotPlugEventSource.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Listens for USB add and remove events from udev over a
+ * netlink socket.  On platforms other than Linux, open()
+ * always fails.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef NETLINKUSBHOTPLUGEVENTSOURCE_H
+#define NETLINKUSBHOTPLUGEVENTSOURCE_H
+
+#include "native/usb/USBHotPlugEventSource.h"
+
+namespace seabreeze {
+
+    class NetlinkUSBHotPlugEventSource : public USBHotPlugEventSource {
+    public:
+        NetlinkUSBHotPlugEventSource();
+        virtual ~NetlinkUSBHotPlugEventSource();
+
+        /* Inherited from USBHotPlugEventSource */
+        virtual bool open();
+        virtual void close();
+        virtual bool waitForEvent(USBHotPlugEvent &event, unsigned int timeoutMillis);
+
+    private:
+        bool parseEvent(const char *message, int length, USBHotPlugEvent &event);
+
+        int sock;
+    };
+
+}
+
+#endif /* NETLINKUSBHOTPLUGEVENTSOURCE_H */
@@ -0,0 +1,67 @@
+/***************************************************//**
+ * @file    SyntheticUSBHotPlugEventSource.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * A USBHotPlugEventSource that only delivers events that
+ * are injected into it.  This allows hot-plug handling to be
+ * exercised without any hardware attached, either with bare
+ * events that trigger a rescan or with events that attach and
+ * detach an emulated device directly.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SYNTHETICUSBHOTPLUGEVENTSOURCE_H
+#define SYNTHETICUSBHOTPLUGEVENTSOURCE_H
+
+#include "native/usb/USBHotPlugEventSource.h"
+#include "native/system/Mutex.h"
+#include "native/system/ConditionVariable.h"
+#include <deque>
+
+namespace seabreeze {
+
+    class SyntheticUSBHotPlugEventSource : public USBHotPlugEventSource {
+    public:
+        SyntheticUSBHotPlugEventSource();
+        virtual ~SyntheticUSBHotPlugEventSource();
+
+        /* Queue an event for delivery.  This may be called from any thread. */
+        void inject(const USBHotPlugEvent &event);
+
+        /* Inherited from USBHotPlugEventSource */
+        virtual bool open();
+        virtual void close();
+        virtual bool waitForEvent(USBHotPlugEvent &event, unsigned int timeoutMillis);
+
+    private:
+        std::deque<USBHotPlugEvent> events;
+        Mutex lock;
+        ConditionVariable eventReady;
+    };
+
+}
+
+#endif /* SYNTHETICUSBHOTPLUGEVENTSOURCE_H */
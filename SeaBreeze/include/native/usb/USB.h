@@ -33,6 +33,7 @@
 #include "native/usb/USBDiscovery.h"
 #include "native/usb/NativeUSB.h"
 #include <string>
+#include <map>
 
 namespace seabreeze {
 
@@ -47,6 +48,22 @@ namespace seabreeze {
         bool close();
         int write(int endpoint, void *data, unsigned int length_bytes);
         int read(int endpoint, void *data, unsigned int length_bytes);
+
+        /* Non-blocking reads.  submitRead() queues a read into the given
+         * buffer and returns a ticket (or -1 on error); the buffer must stay
+         * valid until completeRead() returns something other than
+         * READ_PENDING, or until cancelRead() is called.  A negative timeout
+         * waits indefinitely.  Platforms without native support fall back
+         * to performing the read inside submitRead().
+         */
+        int submitRead(int endpoint, void *data, unsigned int length_bytes);
+        int completeRead(int ticket, int timeoutMillis = -1);
+        void cancelRead(int ticket);
+        /* False once the platform has turned down a queued read, after
+         * which submitRead() blocks and completeRead() timeouts have no
+         * effect.  This is optimistic until the first submitRead().
+         */
+        bool hasQueuedReads();
         void clearStall(int endpoint);
 
         static void setVerbose(bool v);
@@ -77,6 +94,17 @@ namespace seabreeze {
         bool opened;
         static bool verbose;
         unsigned long deviceID;
+
+    private:
+        struct PendingRead {
+            int endpoint;
+            void *data;
+            int result;     /* Only used when the read was done synchronously */
+        };
+
+        std::map<int, PendingRead> pendingReads;
+        bool queuedReadsUnsupported;
+        int nextDeferredTicket;
     };
 
 }
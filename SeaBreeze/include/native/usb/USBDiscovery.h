@@ -52,6 +52,15 @@ namespace seabreeze {
          */
         std::vector<unsigned long> *probeDevices(int vendorID, int productID);
 
+        /**
+         * Probes the bus once for devices matching any of the given VID/PID
+         * pairs and returns one entry for each device found, tagged with the
+         * VID and PID that it matched.  The IDs behave exactly as for the
+         * single VID/PID form of probeDevices() above.
+         */
+        std::vector<struct USBProbedDevice> *probeDevices(
+                const std::vector<struct USBDeviceFilter> &filters);
+
         /**
          * Given an identifier from probeDevices(), create a USB interface to
          * the device that can be used to open/write/read/close the device.
@@ -0,0 +1,78 @@
+/***************************************************//**
+ * @file    USBHotPlugEventSource.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * A USBHotPlugEventSource reports USB devices arriving
+ * and leaving.  The platform implementation listens to the
+ * operating system; a synthetic implementation allows the
+ * hot-plug logic to be driven without any hardware.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef USBHOTPLUGEVENTSOURCE_H
+#define USBHOTPLUGEVENTSOURCE_H
+
+namespace seabreeze {
+
+    class USBHotPlugEvent {
+    public:
+        enum Action {
+            DEVICE_ADDED,
+            DEVICE_REMOVED
+        };
+
+        USBHotPlugEvent() : action(DEVICE_ADDED), vendorID(0), productID(0) {}
+
+        Action action;
+        /* These are zero if the platform could not say which device
+         * was involved.
+         */
+        unsigned short vendorID;
+        unsigned short productID;
+    };
+
+    class USBHotPlugEventSource {
+    public:
+        virtual ~USBHotPlugEventSource() = 0;
+
+        /* Start listening.  Returns false if events are not available. */
+        virtual bool open() = 0;
+        virtual void close() = 0;
+
+        /**
+         * Wait up to timeoutMillis for the next event.  Returns false if
+         * no event was delivered.  This may return false before the timeout
+         * has elapsed, so callers should simply try again.
+         */
+        virtual bool waitForEvent(USBHotPlugEvent &event, unsigned int timeoutMillis) = 0;
+    };
+
+    /* Default implementation for (otherwise) pure virtual destructor */
+    inline USBHotPlugEventSource::~USBHotPlugEventSource() {}
+
+}
+
+#endif /* USBHOTPLUGEVENTSOURCE_H */
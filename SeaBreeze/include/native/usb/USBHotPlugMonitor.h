@@ -0,0 +1,83 @@
+/***************************************************//**
+ * @file    USBHotPlugMonitor.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * The USBHotPlugMonitor runs a thread that waits on a
+ * USBHotPlugEventSource and hands each event to a listener.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef USBHOTPLUGMONITOR_H
+#define USBHOTPLUGMONITOR_H
+
+#include "native/usb/USBHotPlugEventSource.h"
+#include "native/system/Thread.h"
+#include "native/system/Mutex.h"
+
+namespace seabreeze {
+
+    class USBHotPlugListener {
+    public:
+        virtual ~USBHotPlugListener() = 0;
+
+        /* Called on the monitor thread for every event */
+        virtual void usbHotPlugEvent(const USBHotPlugEvent &event) = 0;
+    };
+
+    /* Default implementation for (otherwise) pure virtual destructor */
+    inline USBHotPlugListener::~USBHotPlugListener() {}
+
+    class USBHotPlugMonitor : public Thread {
+    public:
+        /* The monitor takes ownership of the event source. */
+        USBHotPlugMonitor(USBHotPlugEventSource *source, USBHotPlugListener *listener);
+        virtual ~USBHotPlugMonitor();
+
+        /* Opens the event source and starts the monitor thread.  Returns
+         * false if either could not be done.
+         */
+        bool startMonitoring();
+
+        /* Stops the thread and closes the event source.  This must not be
+         * called from within the listener.
+         */
+        void stopMonitoring();
+
+    protected:
+        virtual void run();
+
+    private:
+        bool isStopRequested();
+
+        USBHotPlugEventSource *source;
+        USBHotPlugListener *listener;
+        Mutex lock;
+        bool stopRequested;
+    };
+
+}
+
+#endif /* USBHOTPLUGMONITOR_H */
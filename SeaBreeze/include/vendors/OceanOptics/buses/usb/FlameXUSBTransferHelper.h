@@ -51,6 +51,10 @@ namespace seabreeze {
             throw (BusTransferException);
         virtual int send(const std::vector<byte> &buffer, unsigned int length) const
             throw (BusTransferException);
+        virtual int receiveInto(std::vector<byte> &buffer, unsigned int offset,
+                unsigned int length) throw (BusTransferException);
+        virtual int receiveSegments(const TransferSegment *segments,
+                unsigned int count) throw (BusTransferException);
         
     private:
         static const int WORD_SIZE_BYTES;
@@ -49,11 +49,13 @@ namespace seabreeze {
         /* Inherited */
         virtual int receive(std::vector<byte> &buffer, unsigned int length)
             throw (BusTransferException);
+        virtual int receiveInto(std::vector<byte> &buffer, unsigned int offset,
+                unsigned int length) throw (BusTransferException);
+        virtual int receiveSegments(const TransferSegment *segments,
+                unsigned int count) throw (BusTransferException);
 
     private:
         int secondaryHighSpeedEP;
-        std::vector<byte> primaryReadBuffer;
-        std::vector<byte> secondaryReadBuffer;
     };
 
 }
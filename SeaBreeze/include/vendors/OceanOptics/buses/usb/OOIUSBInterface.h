@@ -44,8 +44,9 @@ namespace seabreeze {
         OOIUSBInterface();
         virtual ~OOIUSBInterface();
 
-        int getProductID();
-        int getVendorID();
+        /* Inherited from USBInterface */
+        virtual int getProductID();
+        virtual int getVendorID();
 
         /* Inherited from Bus */
         virtual TransferHelper *getHelper(const std::vector<ProtocolHint *> &hints) const;
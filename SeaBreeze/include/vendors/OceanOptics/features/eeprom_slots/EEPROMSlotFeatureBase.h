@@ -53,6 +53,12 @@ namespace seabreeze {
         virtual ~EEPROMSlotFeatureBase();
         virtual std::vector<byte> *readEEPROMSlot(const Protocol &protocol,
                 const Bus &bus, unsigned int slot) throw (FeatureException, IllegalArgumentException);
+        /* Reads count consecutive slots starting at firstSlot in one pass.
+         * The caller must delete each slot as well as the returned vector.
+         */
+        virtual std::vector<std::vector<byte> *> *readEEPROMSlots(
+                const Protocol &protocol, const Bus &bus, unsigned int firstSlot,
+                unsigned int count) throw (FeatureException);
         virtual int writeEEPROMSlot(const Protocol &protocol,
                 const Bus &bus, unsigned int slot, const std::vector<byte> &data)
                 throw (FeatureException, IllegalArgumentException);
@@ -64,10 +70,21 @@ namespace seabreeze {
         double readDouble(const Protocol &protocol, const Bus &bus,
                 unsigned int slot) throw (FeatureException, NumberFormatException);
 
+        /* As with readDouble(), but reads count consecutive slots at once.
+         * The caller must delete the returned vector.
+         */
+        std::vector<double> *readDoubles(const Protocol &protocol, const Bus &bus,
+                unsigned int firstSlot, unsigned int count)
+                throw (FeatureException, NumberFormatException);
+
         /* As with readDouble(), this will read a slot and parse into an integer */
         long readLong(const Protocol &protocol, const Bus &bus,
                 unsigned int slot) throw (FeatureException, NumberFormatException);
 
+    private:
+        double parseDouble(const std::vector<byte> &slot)
+                throw (NumberFormatException);
+
     };
 
 }
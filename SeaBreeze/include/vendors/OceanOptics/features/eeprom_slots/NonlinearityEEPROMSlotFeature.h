@@ -34,20 +34,45 @@
 #include "vendors/OceanOptics/features/nonlinearity/NonlinearityCoeffsFeatureInterface.h"
 #include "common/protocols/Protocol.h"
 #include "common/buses/Bus.h"
+#include "common/features/CalibrationCacheInterface.h"
 #include <vector>
 
 namespace seabreeze {
 
     class NonlinearityEEPROMSlotFeature
-        : public NonlinearityCoeffsFeatureInterface, public EEPROMSlotFeatureBase {
+        : public NonlinearityCoeffsFeatureInterface, public EEPROMSlotFeatureBase,
+        public CalibrationCacheInterface {
     public:
         NonlinearityEEPROMSlotFeature();
         virtual ~NonlinearityEEPROMSlotFeature();
         std::vector<double> *readNonlinearityCoefficients(const Protocol &protocol, const Bus &bus)
                 throw (FeatureException);
 
+        /* Overriding from CalibrationCacheInterface */
+        virtual void invalidateCalibration();
+        virtual void saveCalibration(const Protocol &protocol, const Bus &bus,
+                DeviceDescriptor &descriptor) throw (FeatureException);
+        virtual bool loadCalibration(const DeviceDescriptor &descriptor);
+        virtual void fingerprintCalibration(const Protocol &protocol, const Bus &bus,
+                std::vector<double> &fingerprint) throw (FeatureException);
+
         /* Overriding from Feature */
         virtual FeatureFamily getFeatureFamily();
+
+    protected:
+        /* Always goes to the device, bypassing the cache.  If the slots
+         * cannot be parsed this returns a polynomial that leaves counts
+         * alone and sets usedDefaults.
+         */
+        std::vector<double> *readCoefficientsFromDevice(const Protocol &protocol,
+                const Bus &bus, bool &usedDefaults) throw (FeatureException);
+
+        /* Goes through the cache, which never holds defaults */
+        std::vector<double> *readCoefficients(const Protocol &protocol,
+                const Bus &bus, bool &usedDefaults) throw (FeatureException);
+
+        /* Coefficients as of the last read from the device, or NULL */
+        std::vector<double> *cachedCoefficients;
     };
 
 }
@@ -34,20 +34,44 @@
 #include "vendors/OceanOptics/features/stray_light/StrayLightCoeffsFeatureInterface.h"
 #include "common/protocols/Protocol.h"
 #include "common/buses/Bus.h"
+#include "common/features/CalibrationCacheInterface.h"
 #include <vector>
 
 namespace seabreeze {
 
     class StrayLightEEPROMSlotFeature
-        : public StrayLightCoeffsFeatureInterface, public EEPROMSlotFeatureBase {
+        : public StrayLightCoeffsFeatureInterface, public EEPROMSlotFeatureBase,
+        public CalibrationCacheInterface {
     public:
         StrayLightEEPROMSlotFeature();
         virtual ~StrayLightEEPROMSlotFeature();
         std::vector<double> *readStrayLightCoefficients(const Protocol &protocol, const Bus &bus)
                 throw (FeatureException);
 
+        /* Overriding from CalibrationCacheInterface */
+        virtual void invalidateCalibration();
+        virtual void saveCalibration(const Protocol &protocol, const Bus &bus,
+                DeviceDescriptor &descriptor) throw (FeatureException);
+        virtual bool loadCalibration(const DeviceDescriptor &descriptor);
+        virtual void fingerprintCalibration(const Protocol &protocol, const Bus &bus,
+                std::vector<double> &fingerprint) throw (FeatureException);
+
         /* Overriding from Feature */
         virtual FeatureFamily getFeatureFamily();
+
+    protected:
+        /* Always goes to the device, bypassing the cache.  usedDefaults is
+         * set when the slot did not parse and zero was put in its place.
+         */
+        std::vector<double> *readCoefficientsFromDevice(const Protocol &protocol,
+                const Bus &bus, bool &usedDefaults) throw (FeatureException);
+
+        /* Goes through the cache, which never holds defaults */
+        std::vector<double> *readCoefficients(const Protocol &protocol,
+                const Bus &bus, bool &usedDefaults) throw (FeatureException);
+
+        /* Coefficients as of the last read from the device, or NULL */
+        std::vector<double> *cachedCoefficients;
     };
 
 }
@@ -46,6 +46,11 @@ namespace seabreeze {
         std::vector<double> *readWavelengths(const Protocol &protocol, const Bus &bus)
                 throw (FeatureException);
 
+        /* True if the last readWavelengths() could not parse the EEPROM and
+         * returned the pixel index instead.
+         */
+        bool usedDefaultCalibration();
+
         /* Overriding from Feature */
         virtual FeatureFamily getFeatureFamily();
 
@@ -53,6 +58,7 @@ namespace seabreeze {
         virtual std::vector<double> *computeWavelengths(
                 double polynomial[], int length);
         unsigned int numberOfPixels;
+        bool usedDefaults;
     };
 
 }
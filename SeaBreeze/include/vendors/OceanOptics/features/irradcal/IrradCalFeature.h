@@ -37,13 +37,15 @@
 #include "common/buses/Bus.h"
 #include "common/protocols/Protocol.h"
 #include "common/features/FeatureImpl.h"
+#include "common/features/CalibrationCacheInterface.h"
 #include "common/exceptions/FeatureException.h"
 #include "common/FloatVector.h"
 #include "vendors/OceanOptics/features/irradcal/IrradCalFeatureInterface.h"
 
 namespace seabreeze {
 
-    class IrradCalFeature : public FeatureImpl, public IrradCalFeatureInterface {
+    class IrradCalFeature : public FeatureImpl, public IrradCalFeatureInterface,
+            public CalibrationCacheInterface {
     public:
         IrradCalFeature(std::vector<ProtocolHelper *> helpers, int numPixels);
         virtual ~IrradCalFeature();
@@ -60,11 +62,22 @@ namespace seabreeze {
         virtual void writeCollectionArea(const Protocol &protocol,
             const Bus &bus, double area) throw (FeatureException);
 
+        /* Overriding from CalibrationCacheInterface */
+        virtual void invalidateCalibration();
+        virtual void saveCalibration(const Protocol &protocol, const Bus &bus,
+                DeviceDescriptor &descriptor) throw (FeatureException);
+        virtual bool loadCalibration(const DeviceDescriptor &descriptor);
+        virtual void fingerprintCalibration(const Protocol &protocol, const Bus &bus,
+                std::vector<double> &fingerprint) throw (FeatureException);
+
         /* Overriding from Feature */
         virtual FeatureFamily getFeatureFamily();
 
     private:
         int numberOfPixels;
+
+        /* Calibration as of the last read from the device, or NULL */
+        std::vector<float> *cachedCalibration;
     };
 
 }
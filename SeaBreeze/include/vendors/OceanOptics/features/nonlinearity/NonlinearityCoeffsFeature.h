@@ -36,20 +36,38 @@
 #include "common/protocols/Protocol.h"
 #include "common/features/FeatureImpl.h"
 #include "common/buses/Bus.h"
+#include "common/features/CalibrationCacheInterface.h"
 #include "common/exceptions/FeatureException.h"
 
 namespace seabreeze {
 
     class NonlinearityCoeffsFeature : public FeatureImpl,
-            public NonlinearityCoeffsFeatureInterface {
+            public NonlinearityCoeffsFeatureInterface,
+            public CalibrationCacheInterface {
     public:
         NonlinearityCoeffsFeature(std::vector<ProtocolHelper *> helpers);
         virtual ~NonlinearityCoeffsFeature();
         virtual std::vector<double> *readNonlinearityCoefficients(const Protocol &protocol,
                 const Bus &bus) throw (FeatureException);
 
+        /* Overriding from CalibrationCacheInterface */
+        virtual void invalidateCalibration();
+        virtual void saveCalibration(const Protocol &protocol, const Bus &bus,
+                DeviceDescriptor &descriptor) throw (FeatureException);
+        virtual bool loadCalibration(const DeviceDescriptor &descriptor);
+        virtual void fingerprintCalibration(const Protocol &protocol, const Bus &bus,
+                std::vector<double> &fingerprint) throw (FeatureException);
+
         /* Overriding from Feature */
         virtual FeatureFamily getFeatureFamily();
+
+    protected:
+        /* Always goes to the device, bypassing the cache */
+        std::vector<double> *readCoefficientsFromDevice(const Protocol &protocol,
+                const Bus &bus) throw (FeatureException);
+
+        /* Coefficients as of the last read from the device, or NULL */
+        std::vector<double> *cachedCoefficients;
     };
 
 }
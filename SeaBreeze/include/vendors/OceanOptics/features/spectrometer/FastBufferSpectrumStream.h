@@ -0,0 +1,113 @@
+/***************************************************//**
+ * @file    FastBufferSpectrumStream.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This keeps a spectrometer's fast buffer draining on a
+ * thread of its own.  Requests for batches of buffered
+ * spectra are kept in flight so that the device always
+ * has one to answer, and each batch is split into single
+ * spectra that are queued for the application to collect
+ * whenever it likes.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef FASTBUFFERSPECTRUMSTREAM_H
+#define FASTBUFFERSPECTRUMSTREAM_H
+
+#include "common/SeaBreeze.h"
+#include "common/SpectrumRingBuffer.h"
+#include "common/buses/Bus.h"
+#include "common/protocols/Protocol.h"
+#include "native/system/Thread.h"
+#include "native/system/Mutex.h"
+#include "vendors/OceanOptics/features/spectrometer/OOISpectrometerFeatureInterface.h"
+
+namespace seabreeze {
+
+    class FastBufferSpectrumStream : public Thread {
+    public:
+        /* Each spectrum delivered by the feature's fast buffer responses is
+         * recordLength bytes long, including its metadata.  Up to capacity
+         * spectra are held until they are read.  Nothing else can use the
+         * bus while requests are outstanding, so if busLock is not NULL the
+         * thread holds it for each round of requests and their responses,
+         * and other commands get through between rounds.
+         */
+        FastBufferSpectrumStream(OOISpectrometerFeatureInterface *feature,
+                const Protocol *protocol, const Bus *bus, Mutex *busLock,
+                unsigned int recordLength, unsigned int capacity);
+        virtual ~FastBufferSpectrumStream();
+
+        /* Returns false if the thread could not be started */
+        bool startStreaming();
+
+        /* Waits for the requests that are still in flight to be answered,
+         * so that the device is left ready for other commands.
+         */
+        void stopStreaming();
+
+        /* Copies up to maxSpectra whole spectra into the given buffer and
+         * returns how many were copied.  This never blocks, and must only
+         * be called from one thread at a time.
+         */
+        unsigned int readSpectra(byte *buffer, unsigned int maxSpectra);
+
+        unsigned int getRecordLength() const;
+
+        /* Spectra that were dropped because they were not read in time */
+        unsigned int getOverrunCount();
+
+        /* True once the device stopped answering as expected.  The stream
+         * stops by itself when that happens.
+         */
+        bool hasFailed();
+
+    protected:
+        virtual void run();
+
+    private:
+        bool isStopRequested();
+
+        /* Sends a round of requests and collects all of their responses,
+         * adding each one to batches as it arrives.
+         */
+        void exchangeRound(std::vector<std::vector<byte> *> &batches)
+                throw (FeatureException);
+        void publish(const std::vector<byte> &batch);
+
+        OOISpectrometerFeatureInterface *feature;
+        const Protocol *protocol;
+        const Bus *bus;
+        Mutex *busLock;
+        SpectrumRingBuffer spectra;
+        Mutex lock;
+        bool stopRequested;
+        bool failed;
+    };
+
+}
+
+#endif /* FASTBUFFERSPECTRUMSTREAM_H */
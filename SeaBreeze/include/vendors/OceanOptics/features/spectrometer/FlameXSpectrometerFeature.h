@@ -40,10 +40,32 @@ namespace seabreeze {
         virtual ~FlameXSpectrometerFeature();
 
         /* Using OBP wavelength coefficient commands */
-        virtual std::vector<double> *getWavelengths(const Protocol &protocol, const Bus &bus) throw (FeatureException);
+        virtual std::vector<double> *readWavelengths(const Protocol &protocol, const Bus &bus) throw (FeatureException);
 		virtual bool initialize(const Protocol &protocol, const Bus &bus) throw (FeatureException);
 
+        /* The pixel layout is kept alongside the wavelengths so that a
+         * cached descriptor spares the introspection queries as well.
+         */
+        virtual void invalidateCalibration();
+        virtual void saveCalibration(const Protocol &protocol, const Bus &bus,
+                DeviceDescriptor &descriptor) throw (FeatureException);
+        virtual bool loadCalibration(const DeviceDescriptor &descriptor);
+
+        /* Each buffered spectrum is sent with 64 bytes of metadata before
+         * the pixels and a checksum after them.
+         */
+        virtual unsigned int getFastBufferSpectrumLength() const;
+        virtual unsigned int decodeFastBufferSpectra(const byte *buffer,
+                unsigned int length, SpectrumMetadata *metadata, byte *valid,
+                unsigned int maxSpectra) const;
+
 	private:
+        static bool loadIndices(const DeviceDescriptor &descriptor,
+                const std::string &name, std::vector<unsigned int> &indices);
+
+        bool introspectionLoaded;
+
+
         static const long INTEGRATION_TIME_MINIMUM;
         static const long INTEGRATION_TIME_MAXIMUM;
         static const long INTEGRATION_TIME_INCREMENT;
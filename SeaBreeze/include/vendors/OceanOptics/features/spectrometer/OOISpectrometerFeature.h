@@ -32,6 +32,7 @@
 
 #include <vector>
 #include "common/features/FeatureImpl.h"
+#include "common/features/CalibrationCacheInterface.h"
 #include "common/protocols/Protocol.h"
 #include "common/buses/Bus.h"
 #include "common/exceptions/FeatureException.h"
@@ -46,13 +47,28 @@
 namespace seabreeze {
 
     class OOISpectrometerFeature : public FeatureImpl,
-            public OOISpectrometerFeatureInterface {
+            public OOISpectrometerFeatureInterface,
+            public CalibrationCacheInterface {
     public:
         OOISpectrometerFeature();
         virtual ~OOISpectrometerFeature();
         /* Request and read out a spectrum formatted into intensity (A/D counts) */
         virtual std::vector<double> *getFormattedSpectrum(const Protocol &protocol,
                 const Bus &bus) throw (FeatureException);
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, double *buffer, unsigned int bufferLength)
+                throw (FeatureException);
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, float *buffer, unsigned int bufferLength)
+                throw (FeatureException);
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, unsigned short *buffer, unsigned int bufferLength)
+                throw (FeatureException);
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, unsigned int *buffer, unsigned int bufferLength)
+                throw (FeatureException);
+        virtual bool getFormattedSpectrumMetadata(const Protocol &protocol,
+                SpectrumMetadata &metadata) throw (FeatureException);
 		
         /* Request and read out the raw spectrum data stream */
         virtual std::vector<byte> *getUnformattedSpectrum(const Protocol &protocol,
@@ -67,10 +83,30 @@ namespace seabreeze {
 		virtual std::vector<byte> *fastBufferSpectrumResponse(const Protocol &protocol,
 														 const Bus &bus, unsigned int numberOfSamplesToRetrieve) throw (FeatureException);
 
-        /* Request and read out the wavelengths in nanometers as a vector of doubles */
+        virtual SpectrometerProtocolBinding *bindSpectrumAcquisition(
+                const Protocol &protocol, const Bus &bus) throw (FeatureException);
+
+        /* Request and read out the wavelengths in nanometers as a vector of doubles.
+         * These are only read from the device the first time; afterwards a
+         * copy of the cached values is returned.
+         */
         virtual std::vector<double> *getWavelengths(const Protocol &protocol,
                 const Bus &bus) throw (FeatureException);
 
+        /* Read the wavelengths from the device, bypassing the cache.  Devices
+         * that store their wavelength calibration differently override this.
+         */
+        virtual std::vector<double> *readWavelengths(const Protocol &protocol,
+                const Bus &bus) throw (FeatureException);
+
+        /* Overriding from CalibrationCacheInterface */
+        virtual void invalidateCalibration();
+        virtual void saveCalibration(const Protocol &protocol, const Bus &bus,
+                DeviceDescriptor &descriptor) throw (FeatureException);
+        virtual bool loadCalibration(const DeviceDescriptor &descriptor);
+        virtual void fingerprintCalibration(const Protocol &protocol, const Bus &bus,
+                std::vector<double> &fingerprint) throw (FeatureException);
+
         /* Read the raw spectrum data stream.  No request is made first. */
         virtual std::vector<byte> *readUnformattedSpectrum(const Protocol &protocol,
                 const Bus &bus) throw (FeatureException);
@@ -111,6 +147,10 @@ namespace seabreeze {
 
         virtual unsigned short getNumberOfPixels() const;
         virtual int getMaximumIntensity() const;
+        virtual unsigned int getFastBufferSpectrumLength() const;
+        virtual unsigned int decodeFastBufferSpectra(const byte *buffer,
+                unsigned int length, SpectrumMetadata *metadata, byte *valid,
+                unsigned int maxSpectra) const;
 
         /* Overriding from Feature */
         virtual FeatureFamily getFeatureFamily();
@@ -136,6 +176,19 @@ namespace seabreeze {
         std::vector<unsigned int> electricDarkPixelIndices;
 		std::vector<unsigned int> opticalDarkPixelIndices;
 		std::vector<unsigned int> activePixelIndices;
+
+        /* Wavelengths as of the last read from the device, or NULL */
+        std::vector<double> *cachedWavelengths;
+
+        /* Set by readWavelengths() when the EEPROM could not be parsed and
+         * the pixel index was substituted; such a result is never cached.
+         */
+        bool wavelengthsAreDefaults;
+
+    private:
+        template <class T> unsigned int getFormattedSpectrumInto(
+                const Protocol &protocol, const Bus &bus, T *buffer,
+                unsigned int bufferLength) throw (FeatureException);
     };
 
 }
@@ -33,9 +33,11 @@
 #include <vector>
 #include "common/protocols/Protocol.h"
 #include "common/buses/Bus.h"
+#include "common/SpectrumMetadata.h"
 #include "common/exceptions/FeatureException.h"
 #include "common/exceptions/IllegalArgumentException.h"
 #include "vendors/OceanOptics/features/spectrometer/SpectrometerTriggerMode.h"
+#include "vendors/OceanOptics/protocols/interfaces/SpectrometerProtocolBinding.h"
 
 namespace seabreeze {
 
@@ -47,6 +49,30 @@ namespace seabreeze {
         virtual std::vector<double> *getFormattedSpectrum(const Protocol &protocol,
                 const Bus &bus) throw (FeatureException) = 0;
 
+        /* As above, but the pixels are written into the given array instead
+         * of a new vector.  Returns the number of pixels written.  Integer
+         * outputs are rounded and clamped to the range of the type.
+         */
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, double *buffer, unsigned int bufferLength)
+                throw (FeatureException) = 0;
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, float *buffer, unsigned int bufferLength)
+                throw (FeatureException) = 0;
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, unsigned short *buffer, unsigned int bufferLength)
+                throw (FeatureException) = 0;
+        virtual unsigned int getFormattedSpectrum(const Protocol &protocol,
+                const Bus &bus, unsigned int *buffer, unsigned int bufferLength)
+                throw (FeatureException) = 0;
+
+        /* Copies the metadata (device clock, spectrum count, etc.) that came
+         * with the most recent formatted spectrum.  Returns false if the
+         * device did not send any with it.
+         */
+        virtual bool getFormattedSpectrumMetadata(const Protocol &protocol,
+                SpectrumMetadata &metadata) throw (FeatureException) = 0;
+
         /* Request and read out the raw spectrum data stream */
         virtual std::vector<byte> *getUnformattedSpectrum(const Protocol &protocol,
                 const Bus &bus) throw (FeatureException) = 0;
@@ -60,6 +86,15 @@ namespace seabreeze {
         virtual std::vector<byte> *fastBufferSpectrumResponse(const Protocol &protocol,
                                                          const Bus &bus, unsigned int numberOfSamplesToRetrieve) throw (FeatureException) = 0;
 
+        /* Resolves the protocol implementation and the transfer helpers used
+         * to acquire spectra once, so that the result can be used for any
+         * number of acquisitions without looking them up again.  The caller
+         * owns the returned binding and must discard it when the device is
+         * closed.
+         */
+        virtual SpectrometerProtocolBinding *bindSpectrumAcquisition(
+                const Protocol &protocol, const Bus &bus) throw (FeatureException) = 0;
+
 
         /* Request and read out the wavelengths in nanometers as a vector of doubles */
         virtual std::vector<double> *getWavelengths(const Protocol &protocol,
@@ -106,6 +141,21 @@ namespace seabreeze {
         virtual unsigned short getNumberOfPixels() const = 0;
         virtual int getMaximumIntensity() const = 0;
 
+        /* The number of bytes that each spectrum occupies in a fast buffer
+         * response, including its metadata, or zero if the device has no
+         * fast buffer.
+         */
+        virtual unsigned int getFastBufferSpectrumLength() const = 0;
+
+        /* Splits spectra returned by the fast buffer into records without
+         * copying them, decoding the metadata of up to maxSpectra of them.
+         * Each entry of valid is set to 1 if that record's checksum matches
+         * and 0 if it was corrupted.  Returns the number of records decoded.
+         */
+        virtual unsigned int decodeFastBufferSpectra(const byte *buffer,
+                unsigned int length, SpectrumMetadata *metadata, byte *valid,
+                unsigned int maxSpectra) const = 0;
+
     };
 
     /* Default implementation for (otherwise) pure virtual destructor */
@@ -42,7 +42,7 @@ namespace seabreeze {
         /* Overridden from OOISpectrometerFeature because the QE65000
          * wavelength calibration is done differently than in most others
          */
-        virtual std::vector<double> *getWavelengths(const Protocol &protocol,
+        virtual std::vector<double> *readWavelengths(const Protocol &protocol,
                 const Bus &bus) throw (FeatureException);
 
     private:
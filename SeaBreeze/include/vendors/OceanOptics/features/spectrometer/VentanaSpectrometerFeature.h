@@ -40,7 +40,7 @@ namespace seabreeze {
         virtual ~VentanaSpectrometerFeature();
 
 		/* Using OBP wavelength coefficient commands */
-		virtual std::vector<double> *getWavelengths(const Protocol &protocol,
+		virtual std::vector<double> *readWavelengths(const Protocol &protocol,
             const Bus &bus) throw (FeatureException);
 
     private:
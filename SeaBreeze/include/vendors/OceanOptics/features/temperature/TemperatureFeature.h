@@ -55,6 +55,11 @@ namespace seabreeze {
         virtual std::vector<double> *readAllTemperatures(
                 const Protocol &protocol, const Bus &bus)
                 throw (FeatureException);
+
+        virtual std::vector<double> *readAllTemperaturesWithTEC(
+                const Protocol &protocol, const Bus &bus,
+                double *tecTemperature, bool *tecRead)
+                throw (FeatureException);
                 
         /* Overriding from Feature */
         virtual FeatureFamily getFeatureFamily();
@@ -45,6 +45,13 @@ namespace seabreeze {
                 const Bus &bus, int index) throw (FeatureException) = 0;
         virtual std::vector<double> *readAllTemperatures(const Protocol &protocol,
                 const Bus &bus) throw (FeatureException) = 0;
+        /* Also reads the TEC temperature, in the same exchange if the
+         * protocol can manage it.  tecRead says whether it was read.
+         */
+        virtual std::vector<double> *readAllTemperaturesWithTEC(
+                const Protocol &protocol, const Bus &bus,
+                double *tecTemperature, bool *tecRead)
+                throw (FeatureException) = 0;
     };
 
     /* Default implementation for (otherwise) pure virtual destructor */
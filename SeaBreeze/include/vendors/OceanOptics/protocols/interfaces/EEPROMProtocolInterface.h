@@ -54,6 +54,11 @@ namespace seabreeze {
         virtual ~EEPROMProtocolInterface();
         virtual std::vector<byte> *readEEPROMSlot(const Bus &bus, int slot)
                 throw (ProtocolException) = 0;
+        /* Reads count consecutive slots starting at firstSlot.  The caller
+         * must delete each slot as well as the returned vector.
+         */
+        virtual std::vector<std::vector<byte> *> *readEEPROMSlots(const Bus &bus,
+                int firstSlot, int count) throw (ProtocolException) = 0;
         virtual int writeEEPROMSlot(const Bus &bus, int slot,
                 const std::vector<byte> &data) throw (ProtocolException) = 0;
     };
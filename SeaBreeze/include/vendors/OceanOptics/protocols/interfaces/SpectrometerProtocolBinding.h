@@ -0,0 +1,109 @@
+/***************************************************//**
+ * @file    SpectrometerProtocolBinding.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This holds the exchanges and transfer helpers that a
+ * SpectrometerProtocolInterface uses to acquire spectra on one
+ * bus, looked up once so that repeated acquisitions do not have
+ * to search for them each time.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#ifndef SPECTROMETERPROTOCOLBINDING_H
+#define SPECTROMETERPROTOCOLBINDING_H
+
+#include "common/SeaBreeze.h"
+#include "common/buses/Bus.h"
+#include "common/buses/TransferHelper.h"
+#include "common/exceptions/ProtocolException.h"
+#include "common/protocols/SpectrumReceiverInterface.h"
+#include "common/protocols/Transfer.h"
+
+namespace seabreeze {
+
+    class SpectrometerProtocolInterface;
+
+    /* The helpers are only valid while the bus stays open and the protocol
+     * keeps the same exchanges, so a binding must be discarded when the
+     * device is closed or reinitialized.
+     */
+    class SpectrometerProtocolBinding {
+    public:
+        SpectrometerProtocolBinding(SpectrometerProtocolInterface *protocol,
+                const Bus &bus,
+                Transfer *requestFormattedSpectrum,
+                Transfer *readFormattedSpectrum,
+                Transfer *requestUnformattedSpectrum,
+                Transfer *readUnformattedSpectrum) throw (ProtocolException);
+        virtual ~SpectrometerProtocolBinding();
+
+        void requestFormattedSpectrum() throw (ProtocolException);
+
+        /* Writes up to bufferLength pixels and returns how many were written */
+        unsigned int readFormattedSpectrum(double *buffer,
+                unsigned int bufferLength) throw (ProtocolException);
+        unsigned int readFormattedSpectrum(float *buffer,
+                unsigned int bufferLength) throw (ProtocolException);
+        unsigned int readFormattedSpectrum(unsigned short *buffer,
+                unsigned int bufferLength) throw (ProtocolException);
+        unsigned int readFormattedSpectrum(unsigned int *buffer,
+                unsigned int bufferLength) throw (ProtocolException);
+
+        void requestUnformattedSpectrum() throw (ProtocolException);
+
+        /* Copies up to bufferLength bytes and returns how many were copied */
+        unsigned int readUnformattedSpectrum(byte *buffer,
+                unsigned int bufferLength) throw (ProtocolException);
+
+    private:
+        SpectrometerProtocolBinding(const SpectrometerProtocolBinding &that);
+        SpectrometerProtocolBinding &operator=(const SpectrometerProtocolBinding &that);
+
+        template <class T> unsigned int readFormattedSpectrumInto(T *buffer,
+                unsigned int bufferLength) throw (ProtocolException);
+
+        static TransferHelper *findHelper(const Bus &bus, Transfer *exchange)
+                throw (ProtocolException);
+
+        SpectrometerProtocolInterface *protocol;
+        const Bus *bus;
+
+        Transfer *requestFormattedSpectrumExchange;
+        Transfer *readFormattedSpectrumExchange;
+        Transfer *requestUnformattedSpectrumExchange;
+        Transfer *readUnformattedSpectrumExchange;
+
+        TransferHelper *requestFormattedSpectrumHelper;
+        TransferHelper *readFormattedSpectrumHelper;
+        TransferHelper *requestUnformattedSpectrumHelper;
+        TransferHelper *readUnformattedSpectrumHelper;
+
+        /* NULL if the formatted spectrum exchange can only make a new vector */
+        SpectrumReceiverInterface *receiver;
+    };
+
+}
+
+#endif /* SPECTROMETERPROTOCOLBINDING_H */
@@ -36,9 +36,11 @@
 #define SPECTROMETERPROTOCOLINTERFACE_H
 
 #include "common/SeaBreeze.h"
+#include "common/SpectrumMetadata.h"
 #include "common/buses/Bus.h"
 #include "common/exceptions/ProtocolException.h"
 #include "common/protocols/ProtocolHelper.h"
+#include "vendors/OceanOptics/protocols/interfaces/SpectrometerProtocolBinding.h"
 #include "vendors/OceanOptics/features/spectrometer/SpectrometerTriggerMode.h"
 #include <vector>
 
@@ -50,12 +52,34 @@ namespace seabreeze {
         virtual ~SpectrometerProtocolInterface();
 		virtual void requestFormattedSpectrum(const Bus &bus) throw (ProtocolException) = 0;
         virtual std::vector<double> *readFormattedSpectrum(const Bus &bus) throw (ProtocolException) = 0;
+        /* As above, but writes up to bufferLength pixels into the caller's
+         * array and returns how many were written.  Integer outputs are
+         * rounded and clamped to the range of the type.
+         */
+        virtual unsigned int readFormattedSpectrum(const Bus &bus, double *buffer,
+                unsigned int bufferLength) throw (ProtocolException) = 0;
+        virtual unsigned int readFormattedSpectrum(const Bus &bus, float *buffer,
+                unsigned int bufferLength) throw (ProtocolException) = 0;
+        virtual unsigned int readFormattedSpectrum(const Bus &bus, unsigned short *buffer,
+                unsigned int bufferLength) throw (ProtocolException) = 0;
+        virtual unsigned int readFormattedSpectrum(const Bus &bus, unsigned int *buffer,
+                unsigned int bufferLength) throw (ProtocolException) = 0;
+        /* Copies the metadata that came with the spectrum most recently
+         * read by readFormattedSpectrum().  Returns false if there was none.
+         */
+        virtual bool getFormattedSpectrumMetadata(SpectrumMetadata &metadata) = 0;
 		virtual void requestUnformattedSpectrum(const Bus &bus) throw (ProtocolException) = 0;
 		virtual std::vector<byte> *readUnformattedSpectrum(const Bus &bus) throw (ProtocolException) = 0;
 		virtual void requestFastBufferSpectrum(const Bus &bus, unsigned int numberOfSamplesToRetrieve) throw (ProtocolException) = 0;
 		virtual std::vector<byte> *readFastBufferSpectrum(const Bus &bus, unsigned int numberOfSamplesToRetrieve) throw (ProtocolException) = 0;
         virtual void setIntegrationTimeMicros(const Bus &bus, unsigned long time_usec) throw (ProtocolException) = 0;
         virtual void setTriggerMode(const Bus &bus,SpectrometerTriggerMode &mode) throw (ProtocolException) = 0;
+        /* Looks up everything that the spectrum requests above need on the
+         * given bus once, so that a caller acquiring many spectra can skip
+         * doing so each time.  The caller owns the returned binding.
+         */
+        virtual SpectrometerProtocolBinding *bindSpectrumAcquisition(const Bus &bus)
+                throw (ProtocolException) = 0;
     };
 
 }
@@ -56,8 +56,21 @@ namespace seabreeze {
                 throw (ProtocolException) = 0;
         virtual double readTemperature(const Bus &bus, int index)
                 throw (ProtocolException) = 0;
+        /* Reads several temperatures at once.  Where the protocol allows,
+         * all of the requests go out in a single burst.
+         */
+        virtual std::vector<double> *readTemperatures(const Bus &bus,
+                const std::vector<int> &indices) throw (ProtocolException) = 0;
         virtual std::vector<double> *readAllTemperatures(const Bus &bus)
                 throw (ProtocolException) = 0;
+        /* As readAllTemperatures(), but also asks for the thermoelectric
+         * cooler's temperature in the same burst.  If the device does not
+         * answer that, tecRead is set false and the temperatures are still
+         * returned.
+         */
+        virtual std::vector<double> *readAllTemperaturesWithTEC(const Bus &bus,
+                double *tecTemperature, bool *tecRead)
+                throw (ProtocolException) = 0;
     };
 
 }
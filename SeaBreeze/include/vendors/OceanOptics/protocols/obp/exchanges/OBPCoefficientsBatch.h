@@ -0,0 +1,76 @@
+/***************************************************//**
+ * @file    OBPCoefficientsBatch.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This reads a whole family of calibration coefficients
+ * (e.g. wavelength or nonlinearity) from an OBP device
+ * as a single pipelined batch rather than one query
+ * per coefficient.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef OBPCOEFFICIENTSBATCH_H
+#define OBPCOEFFICIENTSBATCH_H
+
+#include <vector>
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPQueryBatch.h"
+
+namespace seabreeze {
+    namespace oceanBinaryProtocol {
+        class OBPCoefficientsBatch : public OBPQueryBatch {
+        public:
+            /* The coefficient message type takes a one-byte index as its
+             * payload and answers with a little-endian float.  The count
+             * message type answers with a single byte.
+             */
+            OBPCoefficientsBatch(unsigned int coefficientMessageType,
+                    unsigned int countMessageType);
+            virtual ~OBPCoefficientsBatch();
+
+            /* Asks the device how many coefficients it has, then reads all
+             * of them in one burst.  Returns NULL if the device cannot
+             * report a usable count.  The caller must delete the result.
+             */
+            std::vector<double> *readCoefficients(TransferHelper *helper)
+                    throw (ProtocolException);
+
+            /* Reads the given number of coefficients in one burst without
+             * asking the device for the count.
+             */
+            std::vector<double> *readCoefficients(TransferHelper *helper,
+                    unsigned int count) throw (ProtocolException);
+
+            /* Devices report at most this many coefficients in a family */
+            static const unsigned int MAXIMUM_COEFFICIENTS = 16;
+
+        protected:
+            unsigned int coefficientMessageType;
+            unsigned int countMessageType;
+        };
+    }
+}
+
+#endif /* OBPCOEFFICIENTSBATCH_H */
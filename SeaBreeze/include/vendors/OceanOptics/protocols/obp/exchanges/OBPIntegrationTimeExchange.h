@@ -30,7 +30,6 @@
 #ifndef OBPINTEGRATIONTIMEEXCHANGE_H
 #define OBPINTEGRATIONTIMEEXCHANGE_H
 
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessage.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPCommand.h"
 
 namespace seabreeze {
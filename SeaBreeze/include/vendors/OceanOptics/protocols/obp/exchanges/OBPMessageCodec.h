@@ -0,0 +1,204 @@
+/***************************************************//**
+ * @file    OBPMessageCodec.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This encodes OBP messages straight into a caller-provided
+ * buffer and decodes them by viewing a received buffer in
+ * place.  Unlike OBPMessage, neither direction allocates any
+ * memory; header fields are read from their fixed offsets
+ * and the payload is exposed as a pointer and length into
+ * the original buffer.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef OBPMESSAGECODEC_H
+#define OBPMESSAGECODEC_H
+
+#include <vector>
+#include "common/SeaBreeze.h"
+#include "common/SpectrumMetadata.h"
+#include "common/exceptions/IllegalArgumentException.h"
+
+namespace seabreeze {
+  namespace oceanBinaryProtocol {
+    class OBPMessageCodec {
+    public:
+        /* Offset of the first payload byte; everything before this is header */
+        static const unsigned int HEADER_LENGTH = 44;
+        static const unsigned int IMMEDIATE_DATA_LENGTH = 16;
+        static const unsigned int CHECKSUM_LENGTH = 16;
+        static const unsigned int FOOTER_LENGTH = 4;
+        /* The smallest message: a header with no payload, checksum and footer */
+        static const unsigned int MINIMUM_MESSAGE_LENGTH = 64;
+        /* The QE Pro sends 32 bytes of metadata with each buffered spectrum
+         * and the FlameX 64, but both start with the same decoded fields.
+         */
+        static const unsigned int SPECTRUM_METADATA_LENGTH = 17;
+
+        static const unsigned short FLAG_RESPONSE = 1 << 0;
+        static const unsigned short FLAG_ACK = 1 << 1;
+        static const unsigned short FLAG_ACK_REQUESTED = 1 << 2;
+        static const unsigned short FLAG_NACK = 1 << 3;
+        static const unsigned short FLAG_EXCEPTION = 1 << 4;
+
+        /* Number of bytes that encode() will produce for the given amount
+         * of data.  Up to 16 bytes travel as immediate data.
+         */
+        static unsigned int getEncodedLength(unsigned int dataLength);
+
+        /* Writes a complete message into the given buffer, which must hold at
+         * least getEncodedLength(dataLength) bytes.  Returns the number of
+         * bytes written.
+         */
+        static unsigned int encode(byte *buffer, unsigned int bufferLength,
+                unsigned int messageType, unsigned short flags,
+                const byte *data, unsigned int dataLength,
+                unsigned int regarding = 0) throw (IllegalArgumentException);
+
+        /* As above, but sizes the vector to fit.  A vector that is reused
+         * across calls keeps its capacity, so this only allocates when a
+         * message is larger than any encoded into it before.
+         */
+        static unsigned int encode(std::vector<byte> &buffer,
+                unsigned int messageType, unsigned short flags,
+                const byte *data, unsigned int dataLength,
+                unsigned int regarding = 0);
+
+        /* True if the given bytes hold the four-byte message footer */
+        static bool isFooter(const byte *buffer);
+
+        static unsigned short readUShort(const byte *buffer);
+        static unsigned int readUInt(const byte *buffer);
+        static void writeUShort(byte *buffer, unsigned short value);
+        static void writeUInt(byte *buffer, unsigned int value);
+
+        /* Decodes the metadata block that precedes the pixels of buffered
+         * spectra.  The buffer must hold SPECTRUM_METADATA_LENGTH bytes.
+         */
+        static void readSpectrumMetadata(const byte *buffer,
+                SpectrumMetadata &metadata);
+    };
+
+    /* A read-only view over a message that has been received into some
+     * buffer.  The view does not own or copy the buffer, so it is only valid
+     * for as long as the buffer is.  The header accessors need only the first
+     * HEADER_LENGTH bytes; the payload accessors need the whole message.
+     */
+    class OBPMessageView {
+    public:
+        OBPMessageView(const byte *buffer, unsigned int length);
+        OBPMessageView(const std::vector<byte> &buffer);
+
+        /* True if the start bytes are present and the bytes remaining
+         * field is large enough to hold a checksum and footer.
+         */
+        bool isValidHeader() const;
+
+        /* True if the header is valid, the buffer holds the entire message,
+         * and the footer is where the header says it should be.
+         */
+        bool isComplete() const;
+
+        unsigned short getProtocolVersion() const;
+        unsigned short getFlags() const;
+        unsigned short getErrno() const;
+        unsigned int getMessageType() const;
+        unsigned int getRegarding() const;
+        byte getChecksumType() const;
+        byte getImmediateDataLength() const;
+        const byte *getImmediateData() const;
+        unsigned int getBytesRemaining() const;
+
+        /* Total length of the message on the wire (header included) */
+        unsigned int getMessageLength() const;
+
+        const byte *getPayload() const;
+        unsigned int getPayloadLength() const;
+
+        /* The immediate data if there is any, otherwise the payload.  This
+         * matches OBPMessage::getData().
+         */
+        const byte *getData() const;
+        unsigned int getDataLength() const;
+
+        bool isAckFlagSet() const;
+        bool isNackFlagSet() const;
+
+    protected:
+        const byte *buffer;
+        unsigned int length;
+    };
+
+    /* A read-only view over a batch of buffered spectra, such as the payload
+     * of a FlameX fast buffer response.  Each record holds 64 bytes of
+     * metadata, the pixels, and a 32-bit sum of every preceding byte of the
+     * record.  Records are checked and decoded where they lie in the buffer,
+     * so the view is only valid for as long as the buffer is.
+     */
+    class OBPSpectrumBatchView {
+    public:
+        static const unsigned int RECORD_METADATA_LENGTH = 64;
+        static const unsigned int RECORD_CHECKSUM_LENGTH = 4;
+
+        OBPSpectrumBatchView(const byte *buffer, unsigned int length,
+                unsigned int recordLength);
+
+        /* Number of whole records in the buffer; any trailing partial record
+         * is ignored.
+         */
+        unsigned int getRecordCount() const;
+        unsigned int getRecordLength() const;
+
+        const byte *getRecord(unsigned int index) const;
+        const byte *getPixels(unsigned int index) const;
+        unsigned int getPixelLength() const;
+
+        /* True if the record's stored checksum matches its contents */
+        bool isRecordValid(unsigned int index) const;
+
+        void getMetadata(unsigned int index, SpectrumMetadata &metadata) const;
+
+        /* The 32-bit sum of the given bytes, as stored at the end of each
+         * record.  This uses SSE2 where the compiler targets it.
+         */
+        static unsigned int computeChecksum(const byte *buffer,
+                unsigned int length);
+
+        /* The same sum in plain C++, which computeChecksum() falls back to
+         * on other targets and for the bytes after the last whole block.
+         */
+        static unsigned int computeChecksumPortable(const byte *buffer,
+                unsigned int length);
+
+    protected:
+        const byte *buffer;
+        unsigned int length;
+        unsigned int recordLength;
+    };
+  }
+}
+
+#endif /* OBPMESSAGECODEC_H */
@@ -0,0 +1,102 @@
+/***************************************************//**
+ * @file    OBPQueryBatch.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This sends a batch of OBP queries back-to-back and then
+ * collects the replies, using the regarding field of each
+ * message to match replies to requests.  This replaces one
+ * bus turnaround per query with a single turnaround for the
+ * whole batch.  Devices that do not echo the regarding
+ * field, or that refuse queries while one is outstanding,
+ * are detected automatically and the affected queries are
+ * run one at a time instead.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef OBPQUERYBATCH_H
+#define OBPQUERYBATCH_H
+
+#include <vector>
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPTransaction.h"
+
+namespace seabreeze {
+    namespace oceanBinaryProtocol {
+        class OBPQueryBatch : public OBPTransaction {
+        public:
+            OBPQueryBatch();
+            virtual ~OBPQueryBatch();
+
+            /* Adds a query to the batch and returns its index, which is
+             * used to retrieve the result.
+             */
+            unsigned int addQuery(unsigned int messageType);
+            unsigned int addQuery(unsigned int messageType,
+                    const std::vector<byte> &data);
+            unsigned int getNumberOfQueries() const;
+
+            /* Discards all queries and results so the batch can be reused */
+            void clear();
+
+            /* Sends every query in the batch and waits for all of the
+             * replies.  A query that the device answers with a NACK, or
+             * with no valid data, has a NULL result; this does not throw
+             * for individual queries.  Queries are only pipelined over a
+             * helper that enforces its receive timeout; if a pipelined reply
+             * does not come within that time, the rest are asked for one at
+             * a time.  The helper's own timeout is restored afterwards.
+             */
+            void queryDevice(TransferHelper *helper) throw (ProtocolException);
+
+            /* The data returned for the query at the given index, or NULL.
+             * The batch retains ownership of the result.
+             */
+            const std::vector<byte> *getResult(unsigned int index) const;
+
+            /* Pipelining is enabled by default.  It is turned off
+             * automatically if the device or bus turns out not to support
+             * it.  A batch only lives for one request, so callers that make
+             * many keep isPipelined() per device and hand it to each new
+             * batch; otherwise every batch has to find out again.
+             */
+            void setPipelined(bool enable);
+            bool isPipelined() const;
+
+        protected:
+            bool queryPipelined(TransferHelper *helper) throw (ProtocolException);
+            void querySerially(TransferHelper *helper, unsigned int index)
+                    throw (ProtocolException);
+            void setResult(unsigned int index, std::vector<byte> *result);
+
+            std::vector<unsigned int> messageTypes;
+            std::vector<std::vector<byte> > requestData;
+            std::vector<std::vector<byte> *> results;
+            std::vector<bool> answered;
+            bool pipelined;
+        };
+    }
+}
+
+#endif /* OBPQUERYBATCH_H */
@@ -35,6 +35,8 @@
 #define OBPREADRAWSPECTRUM32ANDMETADATAEXCHANGE_H
 
 #include "common/protocols/Transfer.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
+#include "common/SpectrumMetadata.h"
 
 namespace seabreeze {
     namespace oceanBinaryProtocol {
@@ -49,9 +51,23 @@ namespace seabreeze {
             virtual Data *transfer(TransferHelper *helper) throw (ProtocolException);
 
         protected:
+            /* Receives a message into this->buffer and checks that it holds
+             * the metadata and a whole spectrum.  The metadata is decoded
+             * into lastMetadata.  The view is only valid until the next
+             * transfer.
+             */
+            OBPMessageView receiveSpectrumMessage(TransferHelper *helper)
+                    throw (ProtocolException);
+
             unsigned int isLegalMessageType(unsigned int t);
             unsigned int numberOfPixels;
             unsigned int metadataLength;
+
+            /* Decoded from the last message that receiveSpectrumMessage()
+             * accepted
+             */
+            SpectrumMetadata lastMetadata;
+            bool metadataReceived;
         };
     }
 }
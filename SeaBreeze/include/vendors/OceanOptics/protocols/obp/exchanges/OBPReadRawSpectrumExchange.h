@@ -31,6 +31,7 @@
 #define OBPREADRAWSPECTRUMEXCHANGE_H
 
 #include "common/protocols/Transfer.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
 
 namespace seabreeze {
   namespace oceanBinaryProtocol {
@@ -46,6 +47,12 @@ namespace seabreeze {
         virtual Data *transfer(TransferHelper *helper) throw (ProtocolException);
 
     protected:
+        /* Receives a message into this->buffer and checks that it holds a
+         * whole spectrum.  The view is only valid until the next transfer.
+         */
+        OBPMessageView receiveSpectrumMessage(TransferHelper *helper)
+                throw (ProtocolException);
+
         unsigned int isLegalMessageType(unsigned int t);
         unsigned int numberOfPixels;
     };
@@ -35,11 +35,13 @@
 #define OBPREADSPECTRUM32ANDMETADATAEXCHANGE_H
 
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadRawSpectrum32AndMetadataExchange.h"
+#include "common/protocols/SpectrumReceiverInterface.h"
 
 namespace seabreeze {
     namespace oceanBinaryProtocol {
         class OBPReadSpectrum32AndMetadataExchange
-                : public OBPReadRawSpectrum32AndMetadataExchange {
+                : public OBPReadRawSpectrum32AndMetadataExchange,
+                public SpectrumReceiverInterface {
 
         public:
             OBPReadSpectrum32AndMetadataExchange(unsigned int numberOfPixels);
@@ -47,6 +49,25 @@ namespace seabreeze {
 
             /* Inherited */
             virtual Data *transfer(TransferHelper *helper) throw (ProtocolException);
+
+            /* Inherited from SpectrumReceiverInterface */
+            virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                    double *buffer, unsigned int bufferLength)
+                    throw (ProtocolException);
+            virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                    float *buffer, unsigned int bufferLength)
+                    throw (ProtocolException);
+            virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                    unsigned short *buffer, unsigned int bufferLength)
+                    throw (ProtocolException);
+            virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                    unsigned int *buffer, unsigned int bufferLength)
+                    throw (ProtocolException);
+            virtual bool getSpectrumMetadata(SpectrumMetadata &metadata);
+
+        private:
+            template <class T> unsigned int receivePixels(TransferHelper *helper,
+                    T *buffer, unsigned int bufferLength) throw (ProtocolException);
         };
     }
 }
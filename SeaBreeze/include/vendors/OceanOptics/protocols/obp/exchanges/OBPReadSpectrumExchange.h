@@ -31,16 +31,37 @@
 #define OBPREADSPECTRUMEXCHANGE_H
 
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadRawSpectrumExchange.h"
+#include "common/protocols/SpectrumReceiverInterface.h"
 
 namespace seabreeze {
   namespace oceanBinaryProtocol {
-    class OBPReadSpectrumExchange : public OBPReadRawSpectrumExchange {
+    class OBPReadSpectrumExchange : public OBPReadRawSpectrumExchange,
+            public SpectrumReceiverInterface {
     public:
         OBPReadSpectrumExchange(unsigned int readoutLength, unsigned int numberOfPixels);
         virtual ~OBPReadSpectrumExchange();
 
         /* Inherited */
         virtual Data *transfer(TransferHelper *helper) throw (ProtocolException);
+
+        /* Inherited from SpectrumReceiverInterface */
+        virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                double *buffer, unsigned int bufferLength)
+                throw (ProtocolException);
+        virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                float *buffer, unsigned int bufferLength)
+                throw (ProtocolException);
+        virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                unsigned short *buffer, unsigned int bufferLength)
+                throw (ProtocolException);
+        virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                unsigned int *buffer, unsigned int bufferLength)
+                throw (ProtocolException);
+        virtual bool getSpectrumMetadata(SpectrumMetadata &metadata);
+
+    private:
+        template <class T> unsigned int receivePixels(TransferHelper *helper,
+                T *buffer, unsigned int bufferLength) throw (ProtocolException);
     };
   }
 }
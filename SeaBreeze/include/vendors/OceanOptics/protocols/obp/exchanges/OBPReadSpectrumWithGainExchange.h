@@ -43,8 +43,23 @@ namespace seabreeze {
 
         /* Inherited */
         virtual Data *transfer(TransferHelper *helper) throw (ProtocolException);
+        virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                double *buffer, unsigned int bufferLength)
+                throw (ProtocolException);
+        virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                float *buffer, unsigned int bufferLength)
+                throw (ProtocolException);
+        virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                unsigned short *buffer, unsigned int bufferLength)
+                throw (ProtocolException);
+        virtual unsigned int receiveFormattedSpectrum(TransferHelper *helper,
+                unsigned int *buffer, unsigned int bufferLength)
+                throw (ProtocolException);
         
     private:
+        template <class T> unsigned int receiveAdjustedPixels(TransferHelper *helper,
+                T *buffer, unsigned int bufferLength) throw (ProtocolException);
+
         GainAdjustedSpectrometerFeature *spectrometerFeature;
     };
   }
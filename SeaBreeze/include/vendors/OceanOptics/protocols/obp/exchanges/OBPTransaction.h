@@ -44,7 +44,7 @@
 #include "common/buses/TransferHelper.h"
 #include "common/protocols/ProtocolHint.h"
 #include "common/exceptions/ProtocolException.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessage.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
 
 namespace seabreeze {
     namespace oceanBinaryProtocol {
@@ -76,6 +76,22 @@ namespace seabreeze {
                     unsigned int messageType,
                     std::vector<byte> &data) throw (ProtocolException);
 
+            /* Encodes a message into the given buffer and sends it.  The
+             * regarding value is echoed back by the device in its reply.
+             */
+            void sendMessage(TransferHelper *helper, unsigned int messageType,
+                    unsigned short flags, unsigned int regarding,
+                    const std::vector<byte> &data, std::vector<byte> &buffer)
+                    throw (ProtocolException);
+
+            /* Reads one complete reply.  The fixed header is left in the
+             * given buffer for inspection with OBPMessageView, and the
+             * reply's data is returned.  NULL is returned if no valid header
+             * could be found.  No check is made of the message type or flags.
+             */
+            std::vector<byte> *receiveReply(TransferHelper *helper,
+                    std::vector<byte> &header) throw (ProtocolException);
+
             std::vector<ProtocolHint *> *hints;
         };
     }
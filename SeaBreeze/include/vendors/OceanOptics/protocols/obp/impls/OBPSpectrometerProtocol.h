@@ -68,14 +68,28 @@ namespace seabreeze {
          */
 		virtual void requestFormattedSpectrum(const Bus &bus) throw (ProtocolException);
 		virtual std::vector<double> *readFormattedSpectrum(const Bus &bus) throw (ProtocolException);
+		virtual unsigned int readFormattedSpectrum(const Bus &bus, double *buffer,
+		        unsigned int bufferLength) throw (ProtocolException);
+		virtual unsigned int readFormattedSpectrum(const Bus &bus, float *buffer,
+		        unsigned int bufferLength) throw (ProtocolException);
+		virtual unsigned int readFormattedSpectrum(const Bus &bus, unsigned short *buffer,
+		        unsigned int bufferLength) throw (ProtocolException);
+		virtual unsigned int readFormattedSpectrum(const Bus &bus, unsigned int *buffer,
+		        unsigned int bufferLength) throw (ProtocolException);
+		virtual bool getFormattedSpectrumMetadata(SpectrumMetadata &metadata);
 		virtual void requestUnformattedSpectrum(const Bus &bus) throw (ProtocolException);
         virtual std::vector<byte> *readUnformattedSpectrum(const Bus &bus) throw (ProtocolException);
 		virtual void requestFastBufferSpectrum(const Bus &bus, unsigned int numberOfSamplesToRetrieve) throw (ProtocolException);
 		virtual std::vector<byte> *readFastBufferSpectrum(const Bus &bus, unsigned int numberOfSamplesToRetrieve) throw (ProtocolException);
         virtual void setIntegrationTimeMicros(const Bus &bus, unsigned long time_usec) throw (ProtocolException);
         virtual void setTriggerMode(const Bus &bus, SpectrometerTriggerMode &mode) throw (ProtocolException);
+        virtual SpectrometerProtocolBinding *bindSpectrumAcquisition(const Bus &bus)
+                throw (ProtocolException);
 
     private:
+        template <class T> unsigned int readFormattedSpectrumInto(const Bus &bus,
+                T *buffer, unsigned int bufferLength) throw (ProtocolException);
+
         OBPIntegrationTimeExchange *integrationTimeExchange;
 
         /* These are Transfers instead of Exchanges so that we can call getHints() on them.
@@ -44,6 +44,10 @@ namespace seabreeze {
 
         virtual std::vector<double> *readStrayLightCoeffs(const Bus &bus)
                 throw (ProtocolException);
+
+    private:
+        /* Whether the last batch left pipelining on for this device */
+        bool pipelined;
     };
   }
 }
@@ -46,8 +46,19 @@ namespace seabreeze {
                 throw (ProtocolException);
         virtual double readTemperature(const Bus &bus, int index)
                 throw (ProtocolException);               
+        virtual std::vector<double> *readTemperatures(const Bus &bus,
+                const std::vector<int> &indices) throw (ProtocolException);
         virtual std::vector<double> *readAllTemperatures(const Bus &bus)
                 throw (ProtocolException);
+        virtual std::vector<double> *readAllTemperaturesWithTEC(const Bus &bus,
+                double *tecTemperature, bool *tecRead)
+                throw (ProtocolException);
+
+    private:
+        /* Whether this device has taken pipelined queries so far, carried
+         * from one batch to the next
+         */
+        bool pipelined;
     };
   }
 }
@@ -44,6 +44,12 @@ namespace seabreeze {
 
         virtual std::vector<double> *readWavelengthCoeffs(const Bus &bus)
                 throw (ProtocolException);
+
+    private:
+        /* Carried between batches so that a device that cannot take
+         * pipelined queries is only found out once
+         */
+        bool pipelined;
     };
   }
 }
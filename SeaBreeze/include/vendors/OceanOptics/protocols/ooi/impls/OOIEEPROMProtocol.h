@@ -44,8 +44,14 @@ namespace seabreeze {
         virtual ~OOIEEPROMProtocol();
         virtual std::vector<byte> *readEEPROMSlot(const Bus &bus, int slot)
                 throw (ProtocolException);
+        virtual std::vector<std::vector<byte> *> *readEEPROMSlots(const Bus &bus,
+                int firstSlot, int count) throw (ProtocolException);
         virtual int writeEEPROMSlot(const Bus &bus, int slot,
                 const std::vector<byte> &data) throw (ProtocolException);
+
+    protected:
+        std::vector<byte> *readEEPROMSlot(TransferHelper *helper, int slot)
+                throw (ProtocolException);
     };
   }
 }
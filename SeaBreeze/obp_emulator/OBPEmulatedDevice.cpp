@@ -0,0 +1,619 @@
+/***************************************************//**
+ * @file    OBPEmulatedDevice.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * One emulated OBP spectrometer.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <string.h>
+#include <time.h>
+#include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
+#include "OBPEmulatedDevice.h"
+
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+using namespace seabreeze::oceanBinaryProtocol;
+using namespace std;
+
+#define OBP_HEADER_LENGTH           64
+#define OBP_PAYLOAD_OFFSET          44
+#define OBP_IMMEDIATE_OFFSET        24
+#define OBP_IMMEDIATE_MAX_LENGTH    16
+#define OBP_CHECKSUM_LENGTH         16
+#define OBP_FOOTER_LENGTH           4
+#define OBP_PROTOCOL_VERSION        0x1100
+
+#define OBP_MESSAGE_FLAGS_RESPONSE      (1 << 0)
+#define OBP_MESSAGE_FLAGS_ACK           (1 << 1)
+#define OBP_MESSAGE_FLAGS_ACK_REQUESTED (1 << 2)
+#define OBP_MESSAGE_FLAGS_NACK          (1 << 3)
+
+/* Error number reported for message types the emulator does not implement */
+#define OBP_ERROR_UNKNOWN_MESSAGE   2
+/* Error number reported for messages that the listener refused */
+#define OBP_ERROR_REFUSED           1
+
+/* Fast buffer records (FlameX) and buffered 32-bit spectra (QE Pro) */
+#define FLAMEX_METADATA_LENGTH      64
+#define FLAMEX_RECORD_CHECKSUM      4
+#define QEPRO_METADATA_LENGTH       32
+
+/* Pixels read out without light on the FlameX detector */
+#define FIRST_ELECTRIC_DARK_PIXEL   14
+#define LAST_ELECTRIC_DARK_PIXEL    29
+
+#define HARDWARE_REVISION           0x01
+#define FIRMWARE_REVISION           0x0100
+#define TEMPERATURE_COUNT           3
+
+static inline void putU16(byte *p, unsigned short value) {
+    p[0] = (byte)(value & 0x00FF);
+    p[1] = (byte)((value >> 8) & 0x00FF);
+}
+
+static inline void putU32(byte *p, unsigned int value) {
+    p[0] = (byte)(value & 0x00FF);
+    p[1] = (byte)((value >> 8) & 0x00FF);
+    p[2] = (byte)((value >> 16) & 0x00FF);
+    p[3] = (byte)((value >> 24) & 0x00FF);
+}
+
+static inline void putU64(byte *p, unsigned long long value) {
+    putU32(p, (unsigned int)(value & 0xFFFFFFFFUL));
+    putU32(p + 4, (unsigned int)(value >> 32));
+}
+
+static inline unsigned int getU32(const byte *p) {
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8)
+            | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+OBPEmulatedDevice::OBPEmulatedDevice(const OBPEmulatorOptions &opts)
+        : options(opts) {
+    unsigned int firstDark = FIRST_ELECTRIC_DARK_PIXEL;
+    unsigned int lastDark = LAST_ELECTRIC_DARK_PIXEL;
+
+    if(OBPEmulatorOptions::FLAME_X != this->options.model
+            || this->options.numberOfPixels <= LAST_ELECTRIC_DARK_PIXEL) {
+        /* No dark pixels */
+        firstDark = 1;
+        lastDark = 0;
+    }
+
+    this->generator = new SyntheticSpectrumGenerator(this->options.numberOfPixels,
+            this->options.maxIntensity, firstDark, lastDark);
+
+    this->integrationTimeMicros = this->options.integrationTimeMicros;
+    this->triggerMode = 0;
+    this->bufferingEnabled = 0;
+    this->backToBackCount = 1;
+    this->bufferCapacity = this->options.bufferCapacity;
+    this->periodMicros = 0;
+    this->startMicros = now();
+    this->epochMicros = this->startMicros;
+    this->epochIndex = 0;
+    this->nextBuffered = 0;
+    restartAcquisition();
+}
+
+OBPEmulatedDevice::~OBPEmulatedDevice() {
+    delete this->generator;
+}
+
+unsigned int OBPEmulatedDevice::getBytesRemaining(const byte *prefix) {
+    if(0xC1 != prefix[0] || 0xC0 != prefix[1]) {
+        return 0;
+    }
+    return getU32(&prefix[OBP_PAYLOAD_OFFSET - 4]);
+}
+
+unsigned long long OBPEmulatedDevice::now() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+void OBPEmulatedDevice::sleepUntil(unsigned long long micros) {
+    unsigned long long current = now();
+    struct timespec ts;
+
+    if(micros <= current) {
+        return;
+    }
+    ts.tv_sec = (time_t)((micros - current) / 1000000ULL);
+    ts.tv_nsec = (long)(((micros - current) % 1000000ULL) * 1000ULL);
+    nanosleep(&ts, NULL);
+}
+
+void OBPEmulatedDevice::restartAcquisition() {
+    /* Anything acquired with the old settings is discarded, as on a real
+     * detector, but the spectrum count keeps increasing.
+     */
+    unsigned long long acquired = getAcquiredCount();
+
+    if(this->options.spectraPerSecond > 0) {
+        this->periodMicros = (unsigned long long)(1000000.0 / this->options.spectraPerSecond);
+    } else {
+        this->periodMicros = this->integrationTimeMicros;
+    }
+    if(0 == this->periodMicros) {
+        this->periodMicros = 1;
+    }
+
+    this->epochMicros = now();
+    this->epochIndex = acquired;
+    this->nextBuffered = acquired;
+}
+
+unsigned long long OBPEmulatedDevice::getAcquiredCount() {
+    if(0 == this->periodMicros) {
+        return this->epochIndex;
+    }
+    return this->epochIndex + (now() - this->epochMicros) / this->periodMicros;
+}
+
+unsigned long long OBPEmulatedDevice::getCompletionTime(unsigned long long index) {
+    return this->epochMicros + (index - this->epochIndex + 1) * this->periodMicros;
+}
+
+unsigned long long OBPEmulatedDevice::getBufferedCount() {
+    unsigned long long acquired = getAcquiredCount();
+
+    /* The oldest spectra are lost once the buffer is full */
+    if(acquired - this->nextBuffered > this->bufferCapacity) {
+        this->nextBuffered = acquired - this->bufferCapacity;
+    }
+    return acquired - this->nextBuffered;
+}
+
+unsigned long long OBPEmulatedDevice::waitForBufferedSpectra() {
+    unsigned long long count;
+
+    while(0 == (count = getBufferedCount())) {
+        sleepUntil(getCompletionTime(this->nextBuffered));
+    }
+    return count;
+}
+
+byte *OBPEmulatedDevice::beginReply(vector<byte> &reply, unsigned int messageType,
+        unsigned int regarding, unsigned short flags, unsigned short errorNumber,
+        unsigned int dataLength) {
+    unsigned int payloadLength = (dataLength > OBP_IMMEDIATE_MAX_LENGTH) ? dataLength : 0;
+    unsigned int offset = (unsigned int)reply.size();
+    byte *message;
+
+    reply.resize(offset + OBP_HEADER_LENGTH + payloadLength);
+    message = &reply[offset];
+    memset(message, 0, OBP_PAYLOAD_OFFSET);
+
+    message[0] = 0xC1;
+    message[1] = 0xC0;
+    putU16(&message[2], OBP_PROTOCOL_VERSION);
+    putU16(&message[4], flags);
+    putU16(&message[6], errorNumber);
+    putU32(&message[8], messageType);
+    putU32(&message[12], regarding);
+    putU32(&message[40], payloadLength + OBP_CHECKSUM_LENGTH + OBP_FOOTER_LENGTH);
+
+    /* No checksum is sent (checksum type 0) */
+    memset(&message[OBP_PAYLOAD_OFFSET + payloadLength], 0, OBP_CHECKSUM_LENGTH);
+    message[OBP_HEADER_LENGTH + payloadLength - 4] = 0xC5;
+    message[OBP_HEADER_LENGTH + payloadLength - 3] = 0xC4;
+    message[OBP_HEADER_LENGTH + payloadLength - 2] = 0xC3;
+    message[OBP_HEADER_LENGTH + payloadLength - 1] = 0xC2;
+
+    if(0 == payloadLength) {
+        message[23] = (byte)dataLength;
+        return &message[OBP_IMMEDIATE_OFFSET];
+    }
+    return &message[OBP_PAYLOAD_OFFSET];
+}
+
+void OBPEmulatedDevice::appendReply(vector<byte> &reply, unsigned int messageType,
+        unsigned int regarding, unsigned short flags, const void *data,
+        unsigned int dataLength) {
+    byte *out = beginReply(reply, messageType, regarding, flags, 0, dataLength);
+    if(dataLength > 0) {
+        memcpy(out, data, dataLength);
+    }
+}
+
+void OBPEmulatedDevice::appendU32Reply(vector<byte> &reply, unsigned int messageType,
+        unsigned int regarding, unsigned int value) {
+    putU32(beginReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+            0, sizeof(unsigned int)), value);
+}
+
+void OBPEmulatedDevice::appendFloatReply(vector<byte> &reply, unsigned int messageType,
+        unsigned int regarding, float value) {
+    /* OBP floats are little-endian IEEE 754, like every host SeaBreeze runs on */
+    appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+            &value, sizeof(float));
+}
+
+void OBPEmulatedDevice::appendSpectrum(vector<byte> &reply, unsigned int messageType,
+        unsigned int regarding) {
+    if(NULL != this->options.listener) {
+        this->options.listener->spectrumRequested();
+    }
+
+    /* An immediate request starts a fresh acquisition, so it waits for the
+     * integration in progress to finish.
+     */
+    sleepUntil(getCompletionTime(getAcquiredCount()));
+
+    byte *out = beginReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+            0, this->options.numberOfPixels * sizeof(unsigned short));
+    this->generator->generate(out, sizeof(unsigned short), this->integrationTimeMicros);
+}
+
+/* Each FlameX fast buffer record is 64 bytes of metadata, the 16-bit pixels,
+ * and a 32-bit sum of all of the preceding bytes of the record.  The metadata
+ * starts with the spectrum count, the completion time in microseconds, the
+ * integration time, and the trigger mode; the rest is reserved.
+ */
+void OBPEmulatedDevice::appendBufferedSpectra(vector<byte> &reply,
+        unsigned int messageType, unsigned int regarding, unsigned int requested) {
+    unsigned int recordLength = FLAMEX_METADATA_LENGTH
+            + this->options.numberOfPixels * sizeof(unsigned short)
+            + FLAMEX_RECORD_CHECKSUM;
+    unsigned long long available;
+    unsigned int count;
+    unsigned int i;
+    unsigned int j;
+    byte *record;
+
+    /* The device returns one spectrum even if none were requested */
+    if(0 == requested) {
+        requested = 1;
+    }
+
+    available = waitForBufferedSpectra();
+    count = (available < requested) ? (unsigned int)available : requested;
+
+    record = beginReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+            0, count * recordLength);
+    for(i = 0; i < count; i++, record += recordLength) {
+        unsigned long long index = this->nextBuffered + i;
+        unsigned int sum = 0;
+
+        memset(record, 0, FLAMEX_METADATA_LENGTH);
+        putU32(&record[0], (unsigned int)index);
+        putU64(&record[4], getCompletionTime(index) - this->startMicros);
+        putU32(&record[12], this->integrationTimeMicros);
+        record[16] = this->triggerMode;
+        this->generator->generate(&record[FLAMEX_METADATA_LENGTH],
+                sizeof(unsigned short), this->integrationTimeMicros);
+
+        for(j = 0; j < recordLength - FLAMEX_RECORD_CHECKSUM; j++) {
+            sum += record[j];
+        }
+        putU32(&record[recordLength - FLAMEX_RECORD_CHECKSUM], sum);
+    }
+    this->nextBuffered += count;
+}
+
+/* QE Pro buffered spectra carry 32 bytes of metadata laid out like the start
+ * of the FlameX metadata, followed by 32-bit pixels.
+ */
+void OBPEmulatedDevice::appendBufferedSpectrum32(vector<byte> &reply,
+        unsigned int messageType, unsigned int regarding) {
+    unsigned long long index;
+    byte *out;
+
+    waitForBufferedSpectra();
+    index = this->nextBuffered++;
+
+    out = beginReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+            0, QEPRO_METADATA_LENGTH + this->options.numberOfPixels * sizeof(unsigned int));
+    memset(out, 0, QEPRO_METADATA_LENGTH);
+    putU32(&out[0], (unsigned int)index);
+    putU64(&out[4], getCompletionTime(index) - this->startMicros);
+    putU32(&out[12], this->integrationTimeMicros);
+    out[16] = this->triggerMode;
+    this->generator->generate(&out[QEPRO_METADATA_LENGTH], sizeof(unsigned int),
+            this->integrationTimeMicros);
+}
+
+bool OBPEmulatedDevice::handleMessage(const byte *request, unsigned int length,
+        vector<byte> &reply) {
+    static const float wavelengthCoefficients[] = { 200.0f, 0.0f, -1.0e-6f, 0.0f };
+    unsigned short flags;
+    unsigned int messageType;
+    unsigned int regarding;
+    unsigned int bytesRemaining;
+    unsigned int immediateLength;
+    const byte *data;
+    unsigned int dataLength;
+    unsigned int value;
+    unsigned int pixels = this->options.numberOfPixels;
+    bool command = false;
+    size_t start = reply.size();
+
+    if(length < OBP_HEADER_LENGTH) {
+        return false;
+    }
+
+    bytesRemaining = getBytesRemaining(request);
+    immediateLength = request[23];
+    if(bytesRemaining < OBP_CHECKSUM_LENGTH + OBP_FOOTER_LENGTH
+            || OBP_PAYLOAD_OFFSET + bytesRemaining > length
+            || immediateLength > OBP_IMMEDIATE_MAX_LENGTH) {
+        return false;
+    }
+
+    flags = (unsigned short)(request[4] | (request[5] << 8));
+    messageType = getU32(&request[8]);
+    regarding = getU32(&request[12]);
+    if(immediateLength > 0) {
+        data = &request[OBP_IMMEDIATE_OFFSET];
+        dataLength = immediateLength;
+    } else {
+        data = &request[OBP_PAYLOAD_OFFSET];
+        dataLength = bytesRemaining - OBP_CHECKSUM_LENGTH - OBP_FOOTER_LENGTH;
+    }
+    value = (dataLength >= 4) ? getU32(data) : ((dataLength > 0) ? data[0] : 0);
+
+    if(NULL != this->options.listener
+            && false == this->options.listener->messageReceived(messageType)) {
+        beginReply(reply, messageType, regarding,
+                OBP_MESSAGE_FLAGS_RESPONSE | OBP_MESSAGE_FLAGS_NACK,
+                OBP_ERROR_REFUSED, 0);
+        return true;
+    }
+
+    switch(messageType) {
+    case OBPMessageTypes::OBP_GET_SERIAL_NUMBER:
+        appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+                this->options.serialNumber.c_str(),
+                (unsigned int)this->options.serialNumber.size());
+        break;
+    case OBPMessageTypes::OBP_GET_SERIAL_NUMBER_LENGTH:
+        {
+            byte maxLength = OBP_IMMEDIATE_MAX_LENGTH;
+            appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+                    &maxLength, 1);
+        }
+        break;
+    case OBPMessageTypes::OBP_GET_HARDWARE_REVISION:
+        {
+            byte revision = HARDWARE_REVISION;
+            appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+                    &revision, 1);
+        }
+        break;
+    case OBPMessageTypes::OBP_GET_FIRMWARE_REVISION:
+        {
+            byte revision[2];
+            putU16(revision, FIRMWARE_REVISION);
+            appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+                    revision, sizeof(revision));
+        }
+        break;
+
+    /* Introspection */
+    case OBPMessageTypes::OBP_GET_NUMBER_OF_PIXELS:
+        appendU32Reply(reply, messageType, regarding, pixels);
+        break;
+    case OBPMessageTypes::OBP_GET_ACTIVE_PIXEL_RANGES:
+        {
+            byte range[8];
+            bool hasDark = (OBPEmulatorOptions::FLAME_X == this->options.model
+                    && pixels > LAST_ELECTRIC_DARK_PIXEL);
+            putU32(&range[0], hasDark ? LAST_ELECTRIC_DARK_PIXEL + 1 : 0);
+            putU32(&range[4], pixels - 1);
+            appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+                    range, sizeof(range));
+        }
+        break;
+    case OBPMessageTypes::OBP_GET_ELECTRIC_DARK_PIXEL_RANGES:
+        if(OBPEmulatorOptions::FLAME_X == this->options.model
+                && pixels > LAST_ELECTRIC_DARK_PIXEL) {
+            byte range[8];
+            putU32(&range[0], FIRST_ELECTRIC_DARK_PIXEL);
+            putU32(&range[4], LAST_ELECTRIC_DARK_PIXEL);
+            appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+                    range, sizeof(range));
+        } else {
+            appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE, NULL, 0);
+        }
+        break;
+    case OBPMessageTypes::OBP_GET_OPTICAL_DARK_PIXEL_RANGES:
+        appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE, NULL, 0);
+        break;
+
+    /* Acquisition settings */
+    case OBPMessageTypes::OBP_GET_INTEGRATION_TIME_US:
+        appendU32Reply(reply, messageType, regarding, this->integrationTimeMicros);
+        break;
+    case OBPMessageTypes::OBP_GET_MINIMUM_INTEGRATION_TIME_US:
+        appendU32Reply(reply, messageType, regarding, 10);
+        break;
+    case OBPMessageTypes::OBP_GET_MAXIMUM_INTEGRATION_TIME_US:
+        appendU32Reply(reply, messageType, regarding, 60000000);
+        break;
+    case OBPMessageTypes::OBP_GET_INTEGRATION_TIME_STEP_SIZE_US:
+        appendU32Reply(reply, messageType, regarding, 1);
+        break;
+    case OBPMessageTypes::OBP_SET_ITIME_USEC:
+        if(value > 0) {
+            this->integrationTimeMicros = value;
+            restartAcquisition();
+        }
+        command = true;
+        break;
+    case OBPMessageTypes::OBP_GET_TRIGGER_MODE:
+        appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+                &this->triggerMode, 1);
+        break;
+    case OBPMessageTypes::OBP_SET_TRIG_MODE:
+        this->triggerMode = (unsigned char)value;
+        restartAcquisition();
+        command = true;
+        break;
+
+    /* Calibration */
+    case OBPMessageTypes::OBP_GET_WL_COEFF_COUNT:
+        {
+            byte count = sizeof(wavelengthCoefficients) / sizeof(wavelengthCoefficients[0]);
+            appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE, &count, 1);
+        }
+        break;
+    case OBPMessageTypes::OBP_GET_WL_COEFF:
+        if(value >= sizeof(wavelengthCoefficients) / sizeof(wavelengthCoefficients[0])) {
+            beginReply(reply, messageType, regarding,
+                    OBP_MESSAGE_FLAGS_RESPONSE | OBP_MESSAGE_FLAGS_NACK, 0, 0);
+        } else if(0 == value) {
+            appendFloatReply(reply, messageType, regarding,
+                    (float)this->options.firstWavelength);
+        } else if(1 == value) {
+            /* Spread 800 nm over the detector */
+            appendFloatReply(reply, messageType, regarding, 800.0f / pixels);
+        } else {
+            appendFloatReply(reply, messageType, regarding, wavelengthCoefficients[value]);
+        }
+        break;
+    case OBPMessageTypes::OBP_GET_NL_COEFF_COUNT:
+        {
+            byte count = 8;
+            appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE, &count, 1);
+        }
+        break;
+    case OBPMessageTypes::OBP_GET_NL_COEFF:
+        appendFloatReply(reply, messageType, regarding, (0 == value) ? 1.0f : 0.0f);
+        break;
+    case OBPMessageTypes::OBP_GET_STRAY_COEFF_COUNT:
+        {
+            byte count = 1;
+            appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE, &count, 1);
+        }
+        break;
+    case OBPMessageTypes::OBP_GET_STRAY_COEFF:
+        appendFloatReply(reply, messageType, regarding, 0.0f);
+        break;
+
+    /* Temperatures */
+    case OBPMessageTypes::OBP_GET_TEMPERATURE_COUNT:
+        {
+            byte count = TEMPERATURE_COUNT;
+            appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE, &count, 1);
+        }
+        break;
+    case OBPMessageTypes::OBP_GET_TEMPERATURE:
+        appendFloatReply(reply, messageType, regarding, 25.0f + (float)value);
+        break;
+    case OBPMessageTypes::OBP_GET_TEMPERATURE_ALL:
+        {
+            float temperatures[TEMPERATURE_COUNT];
+            for(unsigned int i = 0; i < TEMPERATURE_COUNT; i++) {
+                temperatures[i] = 25.0f + (float)i;
+            }
+            appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+                    temperatures, sizeof(temperatures));
+        }
+        break;
+
+    /* Buffering */
+    case OBPMessageTypes::OBP_GET_BUFFERING_ENABLED:
+        appendReply(reply, messageType, regarding, OBP_MESSAGE_FLAGS_RESPONSE,
+                &this->bufferingEnabled, 1);
+        break;
+    case OBPMessageTypes::OBP_SET_BUFFERING_ENABLED:
+        this->bufferingEnabled = (unsigned char)(value & 0x00FF);
+        command = true;
+        break;
+    case OBPMessageTypes::OBP_GET_BACK_TO_BACK_SAMPLE_COUNT:
+        appendU32Reply(reply, messageType, regarding, this->backToBackCount);
+        break;
+    case OBPMessageTypes::OBP_SET_BACK_TO_BACK_SAMPLE_COUNT:
+        this->backToBackCount = value;
+        command = true;
+        break;
+    case OBPMessageTypes::OBP_GET_BUFFER_SIZE_MAX:
+        appendU32Reply(reply, messageType, regarding, this->options.maximumBufferCapacity);
+        break;
+    case OBPMessageTypes::OBP_GET_BUFFER_SIZE_ACTIVE:
+        appendU32Reply(reply, messageType, regarding, this->bufferCapacity);
+        break;
+    case OBPMessageTypes::OBP_SET_BUFFER_SIZE_ACTIVE:
+        if(value >= 1 && value <= this->options.maximumBufferCapacity) {
+            this->bufferCapacity = value;
+        }
+        command = true;
+        break;
+    case OBPMessageTypes::OBP_GET_BUFFERED_SPEC_COUNT:
+        appendU32Reply(reply, messageType, regarding, (unsigned int)getBufferedCount());
+        break;
+    case OBPMessageTypes::OBP_CLEAR_BUFFER_ALL:
+        this->nextBuffered = getAcquiredCount();
+        command = true;
+        break;
+    case OBPMessageTypes::OBP_REMOVE_OLDEST_SPECTRA:
+        {
+            unsigned long long buffered = getBufferedCount();
+            this->nextBuffered += (value < buffered) ? value : buffered;
+        }
+        command = true;
+        break;
+    case OBPMessageTypes::OBP_ABORT_ACQUISITION:
+    case OBPMessageTypes::OBP_ACQUIRE_SPECTRA_INTO_BUFFER:
+        /* The emulated detector always runs, so there is nothing to do */
+        command = true;
+        break;
+
+    /* Spectra */
+    case OBPMessageTypes::OBP_GET_RAW_SPECTRUM_NOW:
+    case OBPMessageTypes::OBP_GET_CORRECTED_SPECTRUM_NOW:
+        appendSpectrum(reply, messageType, regarding);
+        break;
+    case OBPMessageTypes::OBP_GET_N_BUF_RAW_SPECTRA_META:
+        appendBufferedSpectra(reply, messageType, regarding, value);
+        break;
+    case OBPMessageTypes::OBP_GET_BUF_SPEC32_META:
+        appendBufferedSpectrum32(reply, messageType, regarding);
+        break;
+
+    default:
+        beginReply(reply, messageType, regarding,
+                OBP_MESSAGE_FLAGS_RESPONSE | OBP_MESSAGE_FLAGS_NACK,
+                OBP_ERROR_UNKNOWN_MESSAGE, 0);
+        break;
+    }
+
+    if(true == command && 0 != (flags & OBP_MESSAGE_FLAGS_ACK_REQUESTED)) {
+        appendReply(reply, messageType, regarding,
+                OBP_MESSAGE_FLAGS_RESPONSE | OBP_MESSAGE_FLAGS_ACK, NULL, 0);
+    }
+
+    if(reply.size() > start && this->options.latencyMicros > 0) {
+        sleepUntil(now() + this->options.latencyMicros);
+    }
+
+    return true;
+}
@@ -0,0 +1,119 @@
+/***************************************************//**
+ * @file    OBPEmulatedDevice.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * One emulated OBP spectrometer.  It decodes complete OBP
+ * requests, keeps the device state that they change, and
+ * encodes the responses a real FlameX or QE Pro would send.
+ * The detector runs on a virtual clock so that buffered
+ * spectra accumulate at the configured rate whether or not
+ * anyone is reading them.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef OBPEMULATEDDEVICE_H
+#define OBPEMULATEDDEVICE_H
+
+#include <vector>
+#include "common/SeaBreeze.h"
+#include "OBPEmulatorOptions.h"
+#include "SyntheticSpectrumGenerator.h"
+
+namespace seabreeze {
+  namespace emulator {
+
+    class OBPEmulatedDevice {
+    public:
+        OBPEmulatedDevice(const OBPEmulatorOptions &options);
+        ~OBPEmulatedDevice();
+
+        /* Number of bytes in the fixed part of an OBP message that must be
+         * read before the length of the rest is known.
+         */
+        static const unsigned int HEADER_PREFIX_LENGTH = 44;
+
+        /* Returns the number of bytes that follow the prefix, or zero if
+         * the prefix is not the start of an OBP message.
+         */
+        static unsigned int getBytesRemaining(const byte *prefix);
+
+        /* Handles one complete request and appends any response to reply.
+         * This blocks for as long as the emulated detector would need to
+         * produce the requested spectra.  Returns false if the request is
+         * malformed, in which case the connection should be dropped.
+         */
+        bool handleMessage(const byte *request, unsigned int length,
+                std::vector<byte> &reply);
+
+    private:
+        byte *beginReply(std::vector<byte> &reply, unsigned int messageType,
+                unsigned int regarding, unsigned short flags,
+                unsigned short errorNumber, unsigned int dataLength);
+        void appendReply(std::vector<byte> &reply, unsigned int messageType,
+                unsigned int regarding, unsigned short flags,
+                const void *data, unsigned int dataLength);
+        void appendU32Reply(std::vector<byte> &reply, unsigned int messageType,
+                unsigned int regarding, unsigned int value);
+        void appendFloatReply(std::vector<byte> &reply, unsigned int messageType,
+                unsigned int regarding, float value);
+
+        void appendSpectrum(std::vector<byte> &reply, unsigned int messageType,
+                unsigned int regarding);
+        void appendBufferedSpectra(std::vector<byte> &reply,
+                unsigned int messageType, unsigned int regarding,
+                unsigned int requested);
+        void appendBufferedSpectrum32(std::vector<byte> &reply,
+                unsigned int messageType, unsigned int regarding);
+
+        /* Virtual detector clock */
+        unsigned long long now();
+        void sleepUntil(unsigned long long micros);
+        void restartAcquisition();
+        unsigned long long getAcquiredCount();
+        unsigned long long getCompletionTime(unsigned long long index);
+        unsigned long long getBufferedCount();
+        unsigned long long waitForBufferedSpectra();
+
+        OBPEmulatorOptions options;
+        SyntheticSpectrumGenerator *generator;
+
+        unsigned int integrationTimeMicros;
+        unsigned char triggerMode;
+        unsigned char bufferingEnabled;
+        unsigned int backToBackCount;
+        unsigned int bufferCapacity;
+
+        unsigned long long startMicros;     /* Zero of the metadata tick count */
+        unsigned long long periodMicros;
+        unsigned long long epochMicros;
+        unsigned long long epochIndex;      /* Spectra acquired before epoch */
+        unsigned long long nextBuffered;    /* Oldest spectrum still buffered */
+    };
+
+  }
+}
+
+#endif /* OBPEMULATEDDEVICE_H */
@@ -0,0 +1,66 @@
+/***************************************************//**
+ * @file    OBPEmulatorOptions.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Settings for the OBP device emulator.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "OBPEmulatorOptions.h"
+
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+/* The Ocean FX listens on this port for OBP over TCP */
+#define DEFAULT_PORT                57357
+#define DEFAULT_BUFFER_CAPACITY     50000
+
+OBPEmulatorOptions::OBPEmulatorOptions() {
+    this->port = DEFAULT_PORT;
+    this->integrationTimeMicros = 1000;
+    this->spectraPerSecond = 0;
+    this->latencyMicros = 0;
+    this->bufferCapacity = DEFAULT_BUFFER_CAPACITY;
+    this->maximumBufferCapacity = DEFAULT_BUFFER_CAPACITY;
+    this->dropOverlappedMillis = 0;
+    this->firstWavelength = 200.0;
+    this->listener = NULL;
+    setModel(FLAME_X);
+}
+
+void OBPEmulatorOptions::setModel(Model m) {
+    this->model = m;
+    if(QE_PRO == m) {
+        this->numberOfPixels = 1044;
+        this->maxIntensity = 200000;
+        this->serialNumber = "QEPE0000";
+    } else {
+        this->numberOfPixels = 2136;
+        this->maxIntensity = 65535;
+        this->serialNumber = "OFX00000";
+    }
+}
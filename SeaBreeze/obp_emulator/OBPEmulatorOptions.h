@@ -0,0 +1,104 @@
+/***************************************************//**
+ * @file    OBPEmulatorOptions.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Settings for the OBP device emulator.  These describe
+ * which spectrometer is being impersonated and how fast and
+ * how promptly it produces data.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef OBPEMULATOROPTIONS_H
+#define OBPEMULATOROPTIONS_H
+
+#include <string>
+
+namespace seabreeze {
+  namespace emulator {
+
+    /* Told about requests as the emulator serves them.  Calls come from the
+     * emulator's session threads, and may block to hold a request back.
+     */
+    class OBPEmulatorListener {
+    public:
+        virtual ~OBPEmulatorListener() { }
+
+        /* A well-formed message arrived.  Returning false makes the
+         * emulator refuse it with a NACK instead of acting on it.
+         */
+        virtual bool messageReceived(unsigned int messageType) { return true; }
+
+        /* An immediate spectrum was requested, and the emulator has not
+         * started on it yet.
+         */
+        virtual void spectrumRequested() { }
+    };
+
+    class OBPEmulatorOptions {
+    public:
+        enum Model {
+            FLAME_X,
+            QE_PRO
+        };
+
+        OBPEmulatorOptions();
+
+        /* Sets the model and resets the pixel count, saturation level,
+         * and serial number to that model's defaults.
+         */
+        void setModel(Model model);
+
+        Model model;
+        std::string serialNumber;
+        unsigned short port;
+        unsigned int numberOfPixels;
+        unsigned int maxIntensity;
+        unsigned int integrationTimeMicros;
+        /* Rate at which the emulated detector completes spectra.  When this
+         * is zero the rate follows the integration time as on a real device;
+         * otherwise it overrides it so that clients can be load-tested at
+         * rates no detector could reach.
+         */
+        double spectraPerSecond;
+        /* Extra delay added before each response leaves the emulator */
+        unsigned long latencyMicros;
+        unsigned int bufferCapacity;
+        unsigned int maximumBufferCapacity;
+        /* When nonzero, a request that is followed by another within this
+         * many milliseconds gets no reply, as on firmware that cannot take
+         * overlapped queries.
+         */
+        unsigned int dropOverlappedMillis;
+        /* Wavelength of the first pixel in the reported calibration */
+        double firstWavelength;
+        /* Not owned, and may be NULL.  It must outlive every session. */
+        OBPEmulatorListener *listener;
+    };
+
+  }
+}
+
+#endif /* OBPEMULATOROPTIONS_H */
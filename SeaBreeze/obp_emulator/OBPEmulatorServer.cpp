@@ -0,0 +1,252 @@
+/***************************************************//**
+ * @file    OBPEmulatorServer.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Accepts TCP connections for the OBP device emulator.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "native/system/NativeSystem.h"
+#include "OBPEmulatorServer.h"
+
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+using namespace std;
+
+/* Requests are small; anything this large means the stream is corrupt */
+#define MAXIMUM_REQUEST_LENGTH  (1 << 20)
+#define ACCEPT_POLL_MILLIS      200
+
+OBPEmulatorSession::OBPEmulatorSession(int sock, const OBPEmulatorOptions &options)
+        : device(options) {
+    this->socket = sock;
+    this->finished = 0;
+    this->dropOverlappedMillis = options.dropOverlappedMillis;
+}
+
+OBPEmulatorSession::~OBPEmulatorSession() {
+    ::close(this->socket);
+}
+
+bool OBPEmulatorSession::isFinished() {
+    return 0 != atomicLoad(&this->finished);
+}
+
+void OBPEmulatorSession::disconnect() {
+    shutdown(this->socket, SHUT_RDWR);
+}
+
+bool OBPEmulatorSession::readFully(byte *buffer, unsigned int length) {
+    unsigned int total = 0;
+
+    while(total < length) {
+        ssize_t result = recv(this->socket, buffer + total, length - total, 0);
+        if(result <= 0) {
+            return false;
+        }
+        total += (unsigned int)result;
+    }
+    return true;
+}
+
+bool OBPEmulatorSession::isOverlapped() {
+    struct pollfd pfd;
+
+    if(0 == this->dropOverlappedMillis) {
+        return false;
+    }
+    pfd.fd = this->socket;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return poll(&pfd, 1, (int)this->dropOverlappedMillis) > 0
+            && 0 != (pfd.revents & POLLIN);
+}
+
+bool OBPEmulatorSession::writeFully(const byte *buffer, unsigned int length) {
+    unsigned int total = 0;
+
+    while(total < length) {
+        ssize_t result = send(this->socket, buffer + total, length - total, MSG_NOSIGNAL);
+        if(result <= 0) {
+            return false;
+        }
+        total += (unsigned int)result;
+    }
+    return true;
+}
+
+void OBPEmulatorSession::run() {
+    /* Both buffers are reused so that steady-state streaming does not
+     * allocate.
+     */
+    vector<byte> request(OBPEmulatedDevice::HEADER_PREFIX_LENGTH);
+    vector<byte> reply;
+    unsigned int remaining;
+
+    for(;;) {
+        if(false == readFully(&request[0], OBPEmulatedDevice::HEADER_PREFIX_LENGTH)) {
+            break;
+        }
+        remaining = OBPEmulatedDevice::getBytesRemaining(&request[0]);
+        if(0 == remaining || remaining > MAXIMUM_REQUEST_LENGTH) {
+            fprintf(stderr, "Dropping client that sent a malformed OBP message\n");
+            break;
+        }
+        request.resize(OBPEmulatedDevice::HEADER_PREFIX_LENGTH + remaining);
+        if(false == readFully(&request[OBPEmulatedDevice::HEADER_PREFIX_LENGTH], remaining)) {
+            break;
+        }
+
+        if(true == isOverlapped()) {
+            request.resize(OBPEmulatedDevice::HEADER_PREFIX_LENGTH);
+            continue;
+        }
+
+        reply.clear();
+        if(false == this->device.handleMessage(&request[0],
+                (unsigned int)request.size(), reply)) {
+            fprintf(stderr, "Dropping client that sent a malformed OBP message\n");
+            break;
+        }
+        if(false == reply.empty()
+                && false == writeFully(&reply[0], (unsigned int)reply.size())) {
+            break;
+        }
+        request.resize(OBPEmulatedDevice::HEADER_PREFIX_LENGTH);
+    }
+
+    atomicStore(&this->finished, 1);
+}
+
+OBPEmulatorServer::OBPEmulatorServer(const OBPEmulatorOptions &opts)
+        : options(opts) {
+    this->listener = -1;
+    this->stopping = 0;
+}
+
+OBPEmulatorServer::~OBPEmulatorServer() {
+    reapSessions(true);
+    if(this->listener >= 0) {
+        ::close(this->listener);
+    }
+}
+
+bool OBPEmulatorServer::open() {
+    struct sockaddr_in address;
+    int reuse = 1;
+
+    this->listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    if(this->listener < 0) {
+        perror("socket");
+        return false;
+    }
+    setsockopt(this->listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(this->options.port);
+
+    if(bind(this->listener, (struct sockaddr *)&address, sizeof(address)) < 0
+            || listen(this->listener, 16) < 0) {
+        perror("bind");
+        ::close(this->listener);
+        this->listener = -1;
+        return false;
+    }
+    return true;
+}
+
+unsigned short OBPEmulatorServer::getPort() {
+    struct sockaddr_in address;
+    socklen_t length = sizeof(address);
+
+    if(this->listener < 0 || getsockname(this->listener,
+            (struct sockaddr *)&address, &length) < 0) {
+        return 0;
+    }
+    return ntohs(address.sin_port);
+}
+
+void OBPEmulatorServer::stop() {
+    atomicStore(&this->stopping, 1);
+}
+
+void OBPEmulatorServer::reapSessions(bool all) {
+    vector<OBPEmulatorSession *>::iterator iter = this->sessions.begin();
+
+    while(iter != this->sessions.end()) {
+        if(true == all || true == (*iter)->isFinished()) {
+            (*iter)->disconnect();
+            (*iter)->join();
+            delete *iter;
+            iter = this->sessions.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+}
+
+void OBPEmulatorServer::run() {
+    struct pollfd pfd;
+    int client;
+    int noDelay = 1;
+
+    while(0 == atomicLoad(&this->stopping)) {
+        pfd.fd = this->listener;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if(poll(&pfd, 1, ACCEPT_POLL_MILLIS) <= 0) {
+            reapSessions(false);
+            continue;
+        }
+
+        client = accept(this->listener, NULL, NULL);
+        if(client < 0) {
+            continue;
+        }
+        /* Responses are written whole, so Nagle would only add latency */
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        OBPEmulatorSession *session = new OBPEmulatorSession(client, this->options);
+        if(false == session->start()) {
+            delete session;
+            continue;
+        }
+        this->sessions.push_back(session);
+        reapSessions(false);
+    }
+
+    reapSessions(true);
+}
@@ -0,0 +1,105 @@
+/***************************************************//**
+ * @file    OBPEmulatorServer.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Accepts TCP connections for the OBP device emulator.
+ * Each connection is served on its own thread by its own
+ * emulated device, so several clients can be load-tested in
+ * parallel without contending for one detector.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef OBPEMULATORSERVER_H
+#define OBPEMULATORSERVER_H
+
+#include <vector>
+#include "native/system/Thread.h"
+#include "OBPEmulatorOptions.h"
+#include "OBPEmulatedDevice.h"
+
+namespace seabreeze {
+  namespace emulator {
+
+    class OBPEmulatorSession : public Thread {
+    public:
+        OBPEmulatorSession(int socket, const OBPEmulatorOptions &options);
+        virtual ~OBPEmulatorSession();
+
+        bool isFinished();
+
+        /* Makes run() return soon by closing the connection */
+        void disconnect();
+
+    protected:
+        virtual void run();
+
+    private:
+        bool readFully(byte *buffer, unsigned int length);
+        bool writeFully(const byte *buffer, unsigned int length);
+        bool isOverlapped();
+
+        int socket;
+        unsigned int dropOverlappedMillis;
+        OBPEmulatedDevice device;
+        /* Nonzero once run() has returned; read by the server's thread */
+        volatile unsigned int finished;
+    };
+
+    class OBPEmulatorServer {
+    public:
+        OBPEmulatorServer(const OBPEmulatorOptions &options);
+        ~OBPEmulatorServer();
+
+        /* Binds the listening socket.  Returns false on failure. */
+        bool open();
+
+        /* The port that open() bound, which is chosen by the system when
+         * the options ask for port 0.
+         */
+        unsigned short getPort();
+
+        /* Serves clients until stop() is called */
+        void run();
+
+        /* Safe to call from a signal handler */
+        void stop();
+
+    private:
+        void reapSessions(bool all);
+
+        OBPEmulatorOptions options;
+        int listener;
+        /* Set by stop(), which may run in a signal handler, so this is
+         * only touched through atomicLoad() and atomicStore().
+         */
+        volatile unsigned int stopping;
+        std::vector<OBPEmulatorSession *> sessions;
+    };
+
+  }
+}
+
+#endif /* OBPEMULATORSERVER_H */
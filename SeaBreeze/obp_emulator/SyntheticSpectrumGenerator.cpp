@@ -0,0 +1,114 @@
+/***************************************************//**
+ * @file    SyntheticSpectrumGenerator.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Produces plausible looking spectra for the OBP device
+ * emulator.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <math.h>
+#include "SyntheticSpectrumGenerator.h"
+
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+using namespace std;
+
+#define DARK_LEVEL      1500
+#define NOISE_MASK      0x3F    /* Noise spans 64 counts */
+
+SyntheticSpectrumGenerator::SyntheticSpectrumGenerator(unsigned int numberOfPixels,
+        unsigned int maxIntensity, unsigned int firstDarkPixel,
+        unsigned int lastDarkPixel) {
+    /* A few emission lines of different widths spread across the detector */
+    static const float centers[] = { 0.18f, 0.35f, 0.52f, 0.61f, 0.83f };
+    static const float widths[] = { 4.0f, 9.0f, 3.0f, 15.0f, 6.0f };
+    static const float heights[] = { 30.0f, 12.0f, 45.0f, 8.0f, 20.0f };
+    unsigned int i;
+    unsigned int line;
+
+    this->maxIntensity = maxIntensity;
+    this->noiseState = 2463534242U;
+    this->profile.resize(numberOfPixels, 0.0f);
+
+    for(i = 0; i < numberOfPixels; i++) {
+        if(i >= firstDarkPixel && i <= lastDarkPixel) {
+            /* Electrically dark pixels never see light */
+            continue;
+        }
+        /* A broad continuum under the lines */
+        float x = (float)i / (float)numberOfPixels;
+        float value = 2.0f * (float)exp(-(x - 0.5f) * (x - 0.5f) / 0.08f);
+        for(line = 0; line < sizeof(centers) / sizeof(centers[0]); line++) {
+            float d = ((float)i - centers[line] * numberOfPixels) / widths[line];
+            value += heights[line] * (float)exp(-0.5f * d * d);
+        }
+        this->profile[i] = value;
+    }
+}
+
+SyntheticSpectrumGenerator::~SyntheticSpectrumGenerator() {
+
+}
+
+unsigned int SyntheticSpectrumGenerator::getNumberOfPixels() {
+    return (unsigned int)this->profile.size();
+}
+
+unsigned int SyntheticSpectrumGenerator::nextNoise() {
+    /* xorshift32; cheap enough to run for every pixel at full rate */
+    this->noiseState ^= this->noiseState << 13;
+    this->noiseState ^= this->noiseState >> 17;
+    this->noiseState ^= this->noiseState << 5;
+    return this->noiseState;
+}
+
+unsigned int SyntheticSpectrumGenerator::generate(unsigned char *out,
+        unsigned int bytesPerPixel, unsigned long integrationTimeMicros) {
+    float scale = (float)integrationTimeMicros / 1000.0f;
+    unsigned int pixels = (unsigned int)this->profile.size();
+    unsigned int i;
+    unsigned int b;
+
+    for(i = 0; i < pixels; i++) {
+        float signal = this->profile[i] * scale;
+        unsigned long counts = DARK_LEVEL + (nextNoise() & NOISE_MASK);
+        if(signal > this->maxIntensity) {
+            counts = this->maxIntensity;
+        } else {
+            counts += (unsigned long)signal;
+            if(counts > this->maxIntensity) {
+                counts = this->maxIntensity;
+            }
+        }
+        for(b = 0; b < bytesPerPixel; b++) {
+            *out++ = (unsigned char)((counts >> (8 * b)) & 0x00FF);
+        }
+    }
+
+    return pixels * bytesPerPixel;
+}
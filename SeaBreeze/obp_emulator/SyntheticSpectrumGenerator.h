@@ -0,0 +1,69 @@
+/***************************************************//**
+ * @file    SyntheticSpectrumGenerator.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Produces plausible looking spectra for the OBP device
+ * emulator.  Each spectrum is a fixed set of emission lines on
+ * a dark baseline, scaled by the integration time, with fresh
+ * noise so that consecutive spectra differ.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef SYNTHETICSPECTRUMGENERATOR_H
+#define SYNTHETICSPECTRUMGENERATOR_H
+
+#include <vector>
+
+namespace seabreeze {
+  namespace emulator {
+
+    class SyntheticSpectrumGenerator {
+    public:
+        SyntheticSpectrumGenerator(unsigned int numberOfPixels,
+                unsigned int maxIntensity,
+                unsigned int firstDarkPixel, unsigned int lastDarkPixel);
+        ~SyntheticSpectrumGenerator();
+
+        unsigned int getNumberOfPixels();
+
+        /* Writes one spectrum as little-endian pixels of the given width
+         * (2 or 4 bytes) and returns the number of bytes written.
+         */
+        unsigned int generate(unsigned char *out, unsigned int bytesPerPixel,
+                unsigned long integrationTimeMicros);
+
+    private:
+        unsigned int nextNoise();
+
+        std::vector<float> profile;     /* Light reaching each pixel per ms */
+        unsigned int maxIntensity;
+        unsigned int noiseState;
+    };
+
+  }
+}
+
+#endif /* SYNTHETICSPECTRUMGENERATOR_H */
@@ -0,0 +1,150 @@
+/***************************************************//**
+ * @file    obp_emulator.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Command line front end for the OBP device emulator.  This
+ * listens for OBP over TCP the way an Ocean FX does, so that
+ * SeaBreeze clients can be pointed at it with
+ * sbapi_add_TCPIPv4_device_location("FlameX", host, port).
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "OBPEmulatorServer.h"
+
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+static OBPEmulatorServer *server = NULL;
+
+static void handleSignal(int signum) {
+    if(NULL != server) {
+        server->stop();
+    }
+}
+
+static void usage(const char *name) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --model flamex|qepro     Spectrometer to emulate (default flamex)\n"
+            "  --port N                 TCP port to listen on (default 57357)\n"
+            "  --pixels N               Number of pixels (default depends on model)\n"
+            "  --serial S               Serial number to report\n"
+            "  --integration-time-us N  Initial integration time (default 1000)\n"
+            "  --rate N                 Spectra per second, overriding the\n"
+            "                           integration time (default 0: follow it)\n"
+            "  --latency-us N           Delay added before each response\n"
+            "  --buffer N               Fast buffer capacity in spectra\n"
+            "  --drop-overlapped-ms N   Ignore a request that is followed by\n"
+            "                           another within N ms (default 0: never)\n"
+            "  --first-wavelength NM    Calibrated wavelength of pixel 0\n"
+            "                           (default 200)\n",
+            name);
+}
+
+int main(int argc, char *argv[]) {
+    OBPEmulatorOptions options;
+    int i;
+
+    for(i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if(0 == strcmp(arg, "--help") || 0 == strcmp(arg, "-h")) {
+            usage(argv[0]);
+            return 0;
+        }
+        if(NULL == value) {
+            usage(argv[0]);
+            return 1;
+        }
+        i++;
+
+        if(0 == strcmp(arg, "--model")) {
+            if(0 == strcmp(value, "qepro")) {
+                options.setModel(OBPEmulatorOptions::QE_PRO);
+            } else if(0 == strcmp(value, "flamex")) {
+                options.setModel(OBPEmulatorOptions::FLAME_X);
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        } else if(0 == strcmp(arg, "--port")) {
+            options.port = (unsigned short)atoi(value);
+        } else if(0 == strcmp(arg, "--pixels")) {
+            options.numberOfPixels = (unsigned int)atoi(value);
+        } else if(0 == strcmp(arg, "--serial")) {
+            options.serialNumber = value;
+        } else if(0 == strcmp(arg, "--integration-time-us")) {
+            options.integrationTimeMicros = (unsigned int)atoi(value);
+        } else if(0 == strcmp(arg, "--rate")) {
+            options.spectraPerSecond = atof(value);
+        } else if(0 == strcmp(arg, "--latency-us")) {
+            options.latencyMicros = (unsigned long)atol(value);
+        } else if(0 == strcmp(arg, "--buffer")) {
+            options.bufferCapacity = (unsigned int)atoi(value);
+            if(options.bufferCapacity > options.maximumBufferCapacity) {
+                options.maximumBufferCapacity = options.bufferCapacity;
+            }
+        } else if(0 == strcmp(arg, "--first-wavelength")) {
+            options.firstWavelength = atof(value);
+        } else if(0 == strcmp(arg, "--drop-overlapped-ms")) {
+            options.dropOverlappedMillis = (unsigned int)atoi(value);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if(0 == options.numberOfPixels || 0 == options.bufferCapacity) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    server = new OBPEmulatorServer(options);
+    if(false == server->open()) {
+        delete server;
+        return 1;
+    }
+
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+
+    printf("Emulating %s %s with %u pixels on port %u\n",
+            (OBPEmulatorOptions::QE_PRO == options.model) ? "QE Pro" : "FlameX",
+            options.serialNumber.c_str(), options.numberOfPixels, server->getPort());
+    fflush(stdout);
+
+    server->run();
+
+    delete server;
+    server = NULL;
+    return 0;
+}
@@ -40,6 +40,8 @@
 
 #include "common/globals.h"
 #include "common/Log.h"
+#include "common/features/CalibrationCacheInterface.h"
+#include "common/devices/DeviceDescriptorCache.h"
 #include "api/SeaBreezeWrapper.h"
 #include "api/DeviceFactory.h"
 #include "common/buses/rs232/RS232DeviceLocator.h"
@@ -54,6 +56,7 @@
 #include "vendors/OceanOptics/features/light_source/LightSourceFeatureInterface.h"
 #include "vendors/OceanOptics/features/continuous_strobe/ContinuousStrobeFeatureInterface.h"
 #include "vendors/OceanOptics/features/serial_number/SerialNumberFeatureInterface.h"
+#include "vendors/OceanOptics/features/revision/RevisionFeatureInterface.h"
 #include "vendors/OceanOptics/features/thermoelectric/ThermoElectricFeatureInterface.h"
 #include "vendors/OceanOptics/features/irradcal/IrradCalFeatureInterface.h"
 #include "vendors/OceanOptics/features/acquisition_delay/AcquisitionDelayFeatureInterface.h"
@@ -71,6 +74,7 @@ using namespace seabreeze;
 using namespace std;
 
 #include <ctype.h>
+#include <sstream>
 #include <vector>
 #include <string.h>
 
@@ -294,6 +298,61 @@ T *__seabreeze_getFeature(Device *dev) {
     return NULL;
 }
 
+/* Anything that writes to the device's calibration storage must call this so
+ * that features holding an old copy of it will read it again.
+ */
+void __seabreeze_invalidateCalibration(Device *dev) {
+    vector<Feature *>::iterator iter;
+    vector<Feature *> features = dev->getFeatures();
+    for(iter = features.begin(); iter != features.end(); iter++) {
+        CalibrationCacheInterface *cache = dynamic_cast<CalibrationCacheInterface *>(*iter);
+        if(NULL != cache) {
+            cache->invalidateCalibration();
+        }
+    }
+}
+
+/* The newer API may be keeping the calibration in a descriptor cache, which
+ * has to be told about a write from here as well.  The key is built the same
+ * way as there.
+ */
+void __seabreeze_forgetDescriptor(Device *dev) {
+    SerialNumberFeatureInterface *serial =
+            __seabreeze_getFeature<SerialNumberFeatureInterface>(dev);
+    RevisionFeatureInterface *revision =
+            __seabreeze_getFeature<RevisionFeatureInterface>(dev);
+    string *serialNumber = NULL;
+    string firmwareRevision;
+
+    if(NULL == serial) {
+        return;
+    }
+    try {
+        serialNumber = serial->readSerialNumber(*__seabreeze_getProtocol(dev),
+                *__seabreeze_getBus(dev));
+    } catch (FeatureException &fe) {
+        return;
+    }
+    if(NULL == serialNumber) {
+        return;
+    }
+
+    if(NULL != revision) {
+        try {
+            stringstream ss;
+            ss << revision->readFirmwareRevision(*__seabreeze_getProtocol(dev),
+                    *__seabreeze_getBus(dev));
+            firmwareRevision = ss.str();
+        } catch (FeatureException &fe) {
+            firmwareRevision.clear();
+        }
+    }
+
+    DeviceDescriptorCache::forgetEverywhere(DeviceDescriptorCache::makeKey(
+            dev->getName(), *serialNumber, firmwareRevision));
+    delete serialNumber;
+}
+
 /* This should set up default TEC parameters if available and gain adjustment
  * if necessary.  A no-argument initialize() function might be useful in
  * Device but this allows more explicit initialization around a particular
@@ -792,7 +851,6 @@ int SeaBreezeWrapper::getFormattedSpectrum(int index, int *errorCode,
 
 	LOG(__FUNCTION__);
 
-	vector<double> *spectrum;
 	int doublesCopied = 0;
 
 	if (NULL == this->devices[index]) {
@@ -800,7 +858,7 @@ int SeaBreezeWrapper::getFormattedSpectrum(int index, int *errorCode,
 		return 0;
 	}
 
-	if (NULL == buffer) {
+	if (NULL == buffer || buffer_length < 0) {
 		SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
 		return 0;
 	}
@@ -811,13 +869,10 @@ int SeaBreezeWrapper::getFormattedSpectrum(int index, int *errorCode,
 		__seabreeze_getFeature<OOISpectrometerFeatureInterface>(this->devices[index]);
 	if (NULL != spec) {
 		try {
-			spectrum = spec->getFormattedSpectrum(
+			doublesCopied = (int)spec->getFormattedSpectrum(
 				*__seabreeze_getProtocol(this->devices[index]),
-				*__seabreeze_getBus(this->devices[index]));
-			int pixels = (int)spectrum->size();
-			doublesCopied = (pixels < buffer_length) ? pixels : buffer_length;
-			memcpy(buffer, &((*spectrum)[0]), doublesCopied * sizeof(double));
-			delete spectrum;
+				*__seabreeze_getBus(this->devices[index]),
+				buffer, (unsigned int)buffer_length);
 			SET_ERROR_CODE(ERROR_SUCCESS);
 		}
 		catch (FeatureException &fe) {
@@ -1548,6 +1603,8 @@ int SeaBreezeWrapper::writeEEPROMSlot(int index, int *errorCode,
         } catch (FeatureException &fe) {
             SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
         }
+        __seabreeze_invalidateCalibration(this->devices[index]);
+        __seabreeze_forgetDescriptor(this->devices[index]);
     }
 
     return bytesWritten;
@@ -1613,13 +1670,14 @@ int SeaBreezeWrapper::writeIrradCalibration(int index, int *errorCode,
                 *__seabreeze_getProtocol(this->devices[index]),
                 *__seabreeze_getBus(this->devices[index]),
                 *floatVector);
-            delete floatVector;
             SET_ERROR_CODE(ERROR_SUCCESS);
         } catch (FeatureException &fe) {
             SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
-            delete floatVector;
-            return 0;
+            floatsCopied = 0;
         }
+        delete floatVector;
+        /* Even a failed write may have changed part of the calibration */
+        __seabreeze_forgetDescriptor(this->devices[index]);
     }
     return floatsCopied;
 }
@@ -1690,6 +1748,7 @@ void SeaBreezeWrapper::writeIrradCollectionArea(int index, int *errorCode,
         } catch (FeatureException &fe) {
             SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
         }
+        __seabreeze_forgetDescriptor(this->devices[index]);
     }
 }
 
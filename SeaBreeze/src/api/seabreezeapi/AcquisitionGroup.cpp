@@ -0,0 +1,267 @@
+/***************************************************//**
+ * @file    AcquisitionGroup.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Makes the members of a group acquire together.  The requests all
+ * go out before any response is read, and every member but the first
+ * has a thread of its own to read its response so that the reads
+ * overlap.  The first member is read on the calling thread.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include "api/seabreezeapi/AcquisitionGroup.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "native/system/System.h"
+
+using namespace seabreeze;
+using namespace seabreeze::api;
+using namespace std;
+
+static bool __lockOrderLess(DeviceAdapter *a, DeviceAdapter *b) {
+    return a->getID() < b->getID();
+}
+
+AcquisitionGroup::Member::Member(DeviceAdapter *dev, long featureID)
+        : session(dev, featureID) {
+    this->device = dev;
+    this->requested = false;
+    this->readPending = false;
+    this->stopRequested = false;
+    this->buffer = NULL;
+    this->bufferLength = 0;
+    this->result = NULL;
+}
+
+AcquisitionGroup::Member::~Member() {
+    this->lock.lock();
+    this->stopRequested = true;
+    this->changed.broadcast();
+    this->lock.unlock();
+
+    join();
+}
+
+DeviceAdapter *AcquisitionGroup::Member::getDevice() {
+    return this->device;
+}
+
+bool AcquisitionGroup::Member::prepare(int *errorCode) {
+    return this->session.prepare(errorCode);
+}
+
+void AcquisitionGroup::Member::request(sbapi_group_spectrum_t *result) {
+    result->device_id = (long) this->device->getID();
+    result->error_code = ERROR_SUCCESS;
+    result->pixels = 0;
+    result->has_metadata = 0;
+    result->request_time_micros = System::getMonotonicMicros();
+
+    this->requested = this->session.requestFormattedSpectrum(
+            &result->error_code);
+    if(false == this->requested) {
+        result->complete_time_micros = result->request_time_micros;
+    }
+}
+
+void AcquisitionGroup::Member::read(double *buffer, int bufferLength,
+        sbapi_group_spectrum_t *result) {
+    if(false == this->requested) {
+        return;
+    }
+    this->requested = false;
+
+    result->pixels = this->session.readFormattedSpectrum(&result->error_code,
+            buffer, bufferLength);
+    result->complete_time_micros = System::getMonotonicMicros();
+
+    if(ERROR_SUCCESS == result->error_code) {
+        int metadataError;
+        if(true == this->session.getFormattedSpectrumMetadata(&metadataError,
+                &result->metadata)) {
+            result->has_metadata = 1;
+        }
+    }
+}
+
+void AcquisitionGroup::Member::startRead(double *buffer, int bufferLength,
+        sbapi_group_spectrum_t *result) {
+    this->lock.lock();
+    if(false == isStarted() && false == start()) {
+        /* Still get the spectrum, just not in parallel */
+        this->lock.unlock();
+        read(buffer, bufferLength, result);
+        return;
+    }
+    this->buffer = buffer;
+    this->bufferLength = bufferLength;
+    this->result = result;
+    this->readPending = true;
+    this->changed.broadcast();
+    this->lock.unlock();
+}
+
+void AcquisitionGroup::Member::finishRead() {
+    MutexLock guard(this->lock);
+    while(true == this->readPending) {
+        this->changed.wait(this->lock);
+    }
+}
+
+void AcquisitionGroup::Member::run() {
+    for(;;) {
+        this->lock.lock();
+        while(false == this->readPending && false == this->stopRequested) {
+            this->changed.wait(this->lock);
+        }
+        if(true == this->stopRequested) {
+            this->lock.unlock();
+            break;
+        }
+        this->lock.unlock();
+
+        /* The group waits in finishRead() until this is done, so nothing
+         * else touches the member meanwhile.
+         */
+        read(this->buffer, this->bufferLength, this->result);
+
+        this->lock.lock();
+        this->readPending = false;
+        this->changed.broadcast();
+        this->lock.unlock();
+    }
+}
+
+AcquisitionGroup::AcquisitionGroup() {
+
+}
+
+AcquisitionGroup::~AcquisitionGroup() {
+    /* Wait for an acquisition in progress */
+    MutexLock guard(this->lock);
+
+    vector<Member *>::iterator iter;
+    for(iter = this->members.begin(); iter != this->members.end(); iter++) {
+        delete *iter;
+    }
+    this->members.clear();
+    this->lockOrder.clear();
+}
+
+bool AcquisitionGroup::addMember(DeviceAdapter *device, long featureID,
+        int *errorCode) {
+    MutexLock guard(this->lock);
+
+    /* A device's lock cannot be taken twice in one acquisition */
+    vector<Member *>::iterator iter;
+    for(iter = this->members.begin(); iter != this->members.end(); iter++) {
+        if((*iter)->getDevice() == device) {
+            SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+            return false;
+        }
+    }
+
+    Member *member = new Member(device, featureID);
+    if(false == member->prepare(errorCode)) {
+        delete member;
+        return false;
+    }
+
+    this->members.push_back(member);
+
+    for(iter = this->lockOrder.begin(); iter != this->lockOrder.end(); iter++) {
+        if(true == __lockOrderLess(device, (*iter)->getDevice())) {
+            break;
+        }
+    }
+    this->lockOrder.insert(iter, member);
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return true;
+}
+
+vector<DeviceAdapter *> AcquisitionGroup::getDevices() {
+    MutexLock guard(this->lock);
+    vector<DeviceAdapter *> devices;
+
+    vector<Member *>::iterator iter;
+    for(iter = this->members.begin(); iter != this->members.end(); iter++) {
+        devices.push_back((*iter)->getDevice());
+    }
+    return devices;
+}
+
+int AcquisitionGroup::getFormattedSpectra(int *errorCode, double *buffer,
+        int pixelsPerSpectrum, sbapi_group_spectrum_t *results,
+        int maxResults) {
+    MutexLock guard(this->lock);
+    int count = (int) this->members.size();
+    int i;
+
+    if(0 == count) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return 0;
+    }
+
+    if(NULL == buffer || pixelsPerSpectrum <= 0 || NULL == results
+            || maxResults < count) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    /* Always in the same order, so that groups sharing devices (or any
+     * other caller that holds more than one) cannot deadlock.
+     */
+    for(i = 0; i < count; i++) {
+        this->lockOrder[i]->getDevice()->getLock().lock();
+    }
+
+    for(i = 0; i < count; i++) {
+        this->members[i]->request(&results[i]);
+    }
+
+    for(i = 1; i < count; i++) {
+        this->members[i]->startRead(buffer + i * pixelsPerSpectrum,
+                pixelsPerSpectrum, &results[i]);
+    }
+    this->members[0]->read(buffer, pixelsPerSpectrum, &results[0]);
+    for(i = 1; i < count; i++) {
+        this->members[i]->finishRead();
+    }
+
+    for(i = count - 1; i >= 0; i--) {
+        this->lockOrder[i]->getDevice()->getLock().unlock();
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    for(i = 0; i < count; i++) {
+        if(ERROR_SUCCESS != results[i].error_code) {
+            SET_ERROR_CODE(results[i].error_code);
+            break;
+        }
+    }
+
+    return count;
+}
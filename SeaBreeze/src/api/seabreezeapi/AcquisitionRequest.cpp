@@ -0,0 +1,141 @@
+/***************************************************//**
+ * @file    AcquisitionRequest.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include "api/seabreezeapi/AcquisitionRequest.h"
+#include "api/seabreezeapi/SpectrometerSession.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+
+using namespace seabreeze;
+using namespace seabreeze::api;
+
+AcquisitionRequest::AcquisitionRequest(long id, long feature, double *buffer,
+        int length, sbapi_acquisition_callback cb, void *data) {
+    this->requestID = id;
+    this->featureID = feature;
+    this->formattedBuffer = buffer;
+    this->unformattedBuffer = NULL;
+    this->bufferLength = length;
+    this->callback = cb;
+    this->userData = data;
+    this->completed = false;
+    this->resultLength = 0;
+    this->resultError = ERROR_SUCCESS;
+}
+
+AcquisitionRequest::AcquisitionRequest(long id, long feature,
+        unsigned char *buffer, int length, sbapi_acquisition_callback cb,
+        void *data) {
+    this->requestID = id;
+    this->featureID = feature;
+    this->formattedBuffer = NULL;
+    this->unformattedBuffer = buffer;
+    this->bufferLength = length;
+    this->callback = cb;
+    this->userData = data;
+    this->completed = false;
+    this->resultLength = 0;
+    this->resultError = ERROR_SUCCESS;
+}
+
+AcquisitionRequest::~AcquisitionRequest() {
+
+}
+
+long AcquisitionRequest::getID() {
+    return this->requestID;
+}
+
+long AcquisitionRequest::getFeatureID() {
+    return this->featureID;
+}
+
+bool AcquisitionRequest::hasCallback() {
+    return NULL != this->callback;
+}
+
+void AcquisitionRequest::execute(SpectrometerSession *session) {
+    int error = ERROR_SUCCESS;
+    int length;
+
+    if(NULL != this->formattedBuffer) {
+        length = session->getFormattedSpectrum(&error, this->formattedBuffer,
+                this->bufferLength);
+    } else {
+        length = session->getUnformattedSpectrum(&error,
+                this->unformattedBuffer, this->bufferLength);
+    }
+
+    complete(length, error);
+}
+
+void AcquisitionRequest::fail(int errorCode) {
+    complete(0, errorCode);
+}
+
+void AcquisitionRequest::complete(int length, int errorCode) {
+    if(NULL != this->callback) {
+        /* Nobody else holds a request that has a callback, so nothing has
+         * to be locked, and the callback is free to submit more work.
+         */
+        this->resultLength = length;
+        this->resultError = errorCode;
+        this->completed = true;
+        this->callback(this->requestID, errorCode, length, this->userData);
+        return;
+    }
+
+    MutexLock guard(this->lock);
+    this->resultLength = length;
+    this->resultError = errorCode;
+    this->completed = true;
+    this->completion.broadcast();
+}
+
+bool AcquisitionRequest::wait(int timeoutMillis) {
+    MutexLock guard(this->lock);
+
+    if(0 == timeoutMillis) {
+        return this->completed;
+    }
+
+    while(false == this->completed) {
+        if(false == this->completion.wait(this->lock, timeoutMillis)) {
+            break;
+        }
+    }
+    return this->completed;
+}
+
+int AcquisitionRequest::getResult(int *errorCode) {
+    wait(-1);
+
+    MutexLock guard(this->lock);
+    SET_ERROR_CODE(this->resultError);
+    return this->resultLength;
+}
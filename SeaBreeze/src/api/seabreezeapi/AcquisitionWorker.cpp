@@ -0,0 +1,127 @@
+/***************************************************//**
+ * @file    AcquisitionWorker.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include "api/seabreezeapi/AcquisitionWorker.h"
+#include "api/seabreezeapi/SpectrometerSession.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+
+using namespace seabreeze;
+using namespace seabreeze::api;
+using namespace std;
+
+AcquisitionWorker::AcquisitionWorker(DeviceAdapter *dev) {
+    this->device = dev;
+    this->stopRequested = false;
+}
+
+AcquisitionWorker::~AcquisitionWorker() {
+    shutdown();
+}
+
+bool AcquisitionWorker::submit(AcquisitionRequest *request) {
+    MutexLock guard(this->lock);
+
+    if(true == this->stopRequested) {
+        return false;
+    }
+
+    if(false == isStarted() && false == start()) {
+        return false;
+    }
+
+    this->queue.push_back(request);
+    this->queued.signal();
+    return true;
+}
+
+void AcquisitionWorker::shutdown() {
+    this->lock.lock();
+    this->stopRequested = true;
+    this->queued.signal();
+    this->lock.unlock();
+
+    join();
+
+    /* The thread is gone, so nothing else can touch the queue now */
+    while(false == this->queue.empty()) {
+        AcquisitionRequest *request = this->queue.front();
+        bool owned = request->hasCallback();
+        this->queue.pop_front();
+        request->fail(ERROR_NO_DEVICE);
+        if(true == owned) {
+            delete request;
+        }
+    }
+}
+
+SpectrometerSession *AcquisitionWorker::getSession(long featureID) {
+    map<long, SpectrometerSession *>::iterator iter
+            = this->sessions.find(featureID);
+    if(this->sessions.end() != iter) {
+        return iter->second;
+    }
+
+    SpectrometerSession *session
+            = new SpectrometerSession(this->device, featureID);
+    this->sessions[featureID] = session;
+    return session;
+}
+
+void AcquisitionWorker::run() {
+    for(;;) {
+        AcquisitionRequest *request;
+
+        this->lock.lock();
+        while(true == this->queue.empty() && false == this->stopRequested) {
+            this->queued.wait(this->lock);
+        }
+        if(true == this->stopRequested) {
+            this->lock.unlock();
+            break;
+        }
+        request = this->queue.front();
+        this->queue.pop_front();
+        this->lock.unlock();
+
+        /* Once it has executed, a request without a callback may already
+         * have been deleted by the thread that was waiting for it.
+         */
+        bool owned = request->hasCallback();
+        request->execute(getSession(request->getFeatureID()));
+        if(true == owned) {
+            delete request;
+        }
+    }
+
+    map<long, SpectrometerSession *>::iterator iter;
+    for(iter = this->sessions.begin(); iter != this->sessions.end(); iter++) {
+        delete iter->second;
+    }
+    this->sessions.clear();
+}
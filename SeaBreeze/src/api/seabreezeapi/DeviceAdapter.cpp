@@ -34,8 +34,10 @@
 #include "api/seabreezeapi/DeviceAdapter.h"  // references device.h
 #include "api/seabreezeapi/FeatureFamilies.h"
 #include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "common/features/CalibrationCacheInterface.h"
 #include <string>
 #include <string.h>
+#include <sstream>
 
 using namespace seabreeze;
 using namespace seabreeze::api;
@@ -63,11 +65,14 @@ vector<T *> *__sbapi_getFeatures(Device *dev) {
 DeviceAdapter::DeviceAdapter(Device *dev, unsigned long id) {
     this->device = dev;
     this->instanceID = id;
+    this->connection = 0;
 
     if(NULL == this->device) {
         std::string error("Null device is not allowed.");
         throw IllegalArgumentException(error);
     }
+
+    this->acquisitionWorker = new AcquisitionWorker(this);
 }
 
 template <class T> void __delete_feature_adapters(vector<T *> &features) {
@@ -79,6 +84,10 @@ template <class T> void __delete_feature_adapters(vector<T *> &features) {
 }
 
 DeviceAdapter::~DeviceAdapter() {
+    /* The worker may be waiting for the lock that a stream is holding */
+    stopFastBufferStreams();
+    delete this->acquisitionWorker;
+
     __delete_feature_adapters<RawUSBBusAccessFeatureAdapter>(rawUSBBusAccessFeatures);
     __delete_feature_adapters<SerialNumberFeatureAdapter>(serialNumberFeatures);
     __delete_feature_adapters<SpectrometerFeatureAdapter>(spectrometerFeatures);
@@ -112,6 +121,17 @@ DeviceAdapter::~DeviceAdapter() {
     delete this->device;
 }
 
+/* Returns NULL if the feature cannot be reached over the given bus */
+Protocol *__sbapi_getFeatureProtocol(Device *device, Feature *feature, Bus *bus) {
+    ProtocolFamily protocolFamily = device->getSupportedProtocol(
+            feature->getFeatureFamily(), bus->getBusFamily());
+    vector<Protocol *> protocols = device->getProtocolsByFamily(protocolFamily);
+    if(protocols.size() < 1) {
+        return NULL;
+    }
+    return protocols[0];
+}
+
 template <class T, class U> void __create_feature_adapters(Device *device, vector<U *> &adapters, Bus *bus, const FeatureFamily &family) 
 {
 
@@ -146,11 +166,19 @@ template <class T, class U> void __create_feature_adapters(Device *device, vecto
 
 
 int DeviceAdapter::open(int *errorCode) {
+    return open(errorCode, NULL);
+}
+
+int DeviceAdapter::open(int *errorCode, DeviceDescriptorCache *cache) {
     Bus *bus;
     vector<Protocol *> protocols;
     FeatureFamilies featureFamilies;
+    bool descriptorLoaded = false;
     int flag;
 
+    this->connection++;
+    this->descriptorKey.clear();
+
     flag = this->device->open();
     if(0 != flag || NULL == this->device->getOpenedBus()) {
         /* Failed to open the device. */
@@ -160,10 +188,29 @@ int DeviceAdapter::open(int *errorCode) {
 
     bus = this->device->getOpenedBus();
 
+    /* A cached descriptor lets the features skip reading their calibrations
+     * (and any probing that they depend on) back from the hardware.
+     */
+    if(NULL != cache) {
+        DeviceDescriptor descriptor;
+        this->descriptorKey = getDescriptorKey(bus);
+        if(!this->descriptorKey.empty()
+                && true == cache->find(this->descriptorKey, descriptor)) {
+            descriptorLoaded = loadDescriptor(descriptor, bus);
+        }
+    }
+
     /* This gives the device a chance to probe the hardware and update its
      * set of Feature instances based on what is detected.
      */
     this->device->initialize(*bus);
+
+    if(NULL != cache && !this->descriptorKey.empty() && false == descriptorLoaded) {
+        DeviceDescriptor descriptor;
+        saveDescriptor(descriptor, bus);
+        cache->store(this->descriptorKey, descriptor);
+        cache->save();
+    }
     
     /* Create raw usb access feature list */
     __create_feature_adapters<RawUSBBusAccessFeatureInterface,
@@ -316,9 +363,203 @@ int DeviceAdapter::open(int *errorCode) {
 }
 
 void DeviceAdapter::close() {
+    /* Leave the device with no request outstanding */
+    for(unsigned int i = 0; i < this->spectrometerFeatures.size(); i++) {
+        this->spectrometerFeatures[i]->setPrefetchEnabled(NULL, false);
+    }
+
+    this->connection++;
     this->device->close();
 }
 
+void DeviceAdapter::forgetSettings() {
+    unsigned int i;
+
+    for(i = 0; i < this->spectrometerFeatures.size(); i++) {
+        this->spectrometerFeatures[i]->forgetSettings();
+    }
+    for(i = 0; i < this->spectrumProcessingFeatures.size(); i++) {
+        this->spectrumProcessingFeatures[i]->forgetSettings();
+    }
+    for(i = 0; i < this->tecFeatures.size(); i++) {
+        this->tecFeatures[i]->forgetSettings();
+    }
+}
+
+Mutex &DeviceAdapter::getLock() {
+    return this->lock;
+}
+
+Mutex &DeviceAdapter::getStreamLock() {
+    return this->streamLock;
+}
+
+void DeviceAdapter::cancelSpectrumPrefetches() {
+    for(unsigned int i = 0; i < this->spectrometerFeatures.size(); i++) {
+        this->spectrometerFeatures[i]->cancelPrefetch();
+    }
+}
+
+void DeviceAdapter::stopFastBufferStreams() {
+    /* A streaming thread must not outlive the connection it is using */
+    for(unsigned int i = 0; i < this->spectrometerFeatures.size(); i++) {
+        this->spectrometerFeatures[i]->stopFastBufferStream(NULL);
+    }
+}
+
+bool DeviceAdapter::submitAcquisition(AcquisitionRequest *request) {
+    return this->acquisitionWorker->submit(request);
+}
+
+string DeviceAdapter::getDescriptorKey(Bus *bus) {
+    string *serialNumber = NULL;
+    string firmwareRevision;
+
+    /* The serial number is required so that a descriptor is never applied
+     * to the wrong unit.  The firmware revision is included where the device
+     * can report it so that a reflash forces the calibrations to be reread.
+     */
+    vector<SerialNumberFeatureInterface *> *serials
+            = __sbapi_getFeatures<SerialNumberFeatureInterface>(this->device);
+    if(serials->size() > 0) {
+        Feature *f = dynamic_cast<Feature *>((*serials)[0]);
+        Protocol *protocol = (NULL != f)
+                ? __sbapi_getFeatureProtocol(this->device, f, bus) : NULL;
+        if(NULL != protocol) {
+            try {
+                serialNumber = (*serials)[0]->readSerialNumber(*protocol, *bus);
+            } catch (FeatureException &fe) {
+                serialNumber = NULL;
+            }
+        }
+    }
+    delete serials;
+
+    if(NULL == serialNumber) {
+        return string();
+    }
+
+    vector<RevisionFeatureInterface *> *revisions
+            = __sbapi_getFeatures<RevisionFeatureInterface>(this->device);
+    if(revisions->size() > 0) {
+        Feature *f = dynamic_cast<Feature *>((*revisions)[0]);
+        Protocol *protocol = (NULL != f)
+                ? __sbapi_getFeatureProtocol(this->device, f, bus) : NULL;
+        if(NULL != protocol) {
+            try {
+                stringstream ss;
+                ss << (*revisions)[0]->readFirmwareRevision(*protocol, *bus);
+                firmwareRevision = ss.str();
+            } catch (FeatureException &fe) {
+                firmwareRevision.clear();
+            }
+        }
+    }
+    delete revisions;
+
+    string key = DeviceDescriptorCache::makeKey(this->device->getName(),
+            *serialNumber, firmwareRevision);
+    delete serialNumber;
+    return key;
+}
+
+bool DeviceAdapter::loadDescriptor(const DeviceDescriptor &descriptor, Bus *bus) {
+    vector<CalibrationCacheInterface *> *caches
+            = __sbapi_getFeatures<CalibrationCacheInterface>(this->device);
+    bool retval = true;
+    unsigned int i;
+
+    for(i = 0; i < caches->size() && true == retval; i++) {
+        retval = (*caches)[i]->loadCalibration(descriptor);
+    }
+
+    if(true == retval) {
+        /* The key does not change when a calibration is rewritten, perhaps
+         * by another program, so check that the device still holds what
+         * was cached.
+         */
+        const vector<double> *expected = descriptor.getValues("fingerprint");
+        vector<double> fingerprint;
+        retval = NULL != expected
+                && true == readCalibrationFingerprint(bus, fingerprint)
+                && fingerprint == *expected;
+    }
+
+    if(false == retval) {
+        /* All or nothing, so that a stale entry is replaced as a whole */
+        for(i = 0; i < caches->size(); i++) {
+            (*caches)[i]->invalidateCalibration();
+        }
+    }
+
+    delete caches;
+    return retval;
+}
+
+void DeviceAdapter::saveDescriptor(DeviceDescriptor &descriptor, Bus *bus) {
+    vector<CalibrationCacheInterface *> *caches
+            = __sbapi_getFeatures<CalibrationCacheInterface>(this->device);
+
+    for(unsigned int i = 0; i < caches->size(); i++) {
+        Feature *f = dynamic_cast<Feature *>((*caches)[i]);
+        Protocol *protocol = (NULL != f)
+                ? __sbapi_getFeatureProtocol(this->device, f, bus) : NULL;
+        if(NULL == protocol) {
+            continue;
+        }
+        try {
+            (*caches)[i]->saveCalibration(*protocol, *bus, descriptor);
+        } catch (FeatureException &fe) {
+            /* Leave this one out; it will be read from the device each time */
+        }
+    }
+
+    delete caches;
+
+    /* Without a fingerprint the descriptor is never trusted, so it will
+     * just be rebuilt on every open.
+     */
+    vector<double> fingerprint;
+    if(true == readCalibrationFingerprint(bus, fingerprint)) {
+        descriptor.setValues("fingerprint", fingerprint);
+    }
+}
+
+bool DeviceAdapter::readCalibrationFingerprint(Bus *bus, vector<double> &fingerprint) {
+    vector<CalibrationCacheInterface *> *caches
+            = __sbapi_getFeatures<CalibrationCacheInterface>(this->device);
+    bool retval = true;
+
+    for(unsigned int i = 0; i < caches->size() && true == retval; i++) {
+        Feature *f = dynamic_cast<Feature *>((*caches)[i]);
+        Protocol *protocol = (NULL != f)
+                ? __sbapi_getFeatureProtocol(this->device, f, bus) : NULL;
+        if(NULL == protocol) {
+            continue;
+        }
+        try {
+            (*caches)[i]->fingerprintCalibration(*protocol, *bus, fingerprint);
+        } catch (FeatureException &fe) {
+            retval = false;
+        }
+    }
+
+    delete caches;
+    return retval;
+}
+
+void DeviceAdapter::forgetDescriptor() {
+    Bus *bus = this->device->getOpenedBus();
+
+    /* The key is only known already if a cache was in use at open() */
+    if(this->descriptorKey.empty() && NULL != bus) {
+        this->descriptorKey = getDescriptorKey(bus);
+    }
+    if(false == this->descriptorKey.empty()) {
+        DeviceDescriptorCache::forgetEverywhere(this->descriptorKey);
+    }
+}
+
 DeviceLocatorInterface *DeviceAdapter::getLocation() {
     return this->device->getLocation();
 }
@@ -367,7 +608,11 @@ template <class T> int __getFeatureIDs(vector<T *> features, long *buffer, unsig
     return i;
 }
 
-template <class T> T *__getFeatureByID(vector<T *> features, long id) {
+/* Apart from getSpectrometerFeatureByID(), the lookups below are only
+ * made just before the feature is used, so they free the bus of any
+ * prefetched spectrum first.
+ */
+template <class T> T *__getFeatureByID(const vector<T *> &features, long id) {
     unsigned int i;
 
     for(i = 0; i < features.size(); i++) {
@@ -398,6 +643,7 @@ int DeviceAdapter::getRawUSBBusAccessFeatures(long *buffer, int maxFeatures) {
 }
 
 RawUSBBusAccessFeatureAdapter *DeviceAdapter::getRawUSBBusAccessFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<RawUSBBusAccessFeatureAdapter>(
                 rawUSBBusAccessFeatures, featureID);
 }
@@ -437,6 +683,7 @@ int DeviceAdapter::getSerialNumberFeatures(long *buffer, int maxFeatures) {
 }
 
 SerialNumberFeatureAdapter *DeviceAdapter::getSerialNumberFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<SerialNumberFeatureAdapter>(
                 serialNumberFeatures, featureID);
 }
@@ -488,6 +735,17 @@ void DeviceAdapter::spectrometerSetTriggerMode(long featureID,
     feature->setTriggerMode(errorCode, mode);
 }
 
+void DeviceAdapter::spectrometerSetPrefetchEnabled(long featureID,
+            int *errorCode, bool enable) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    feature->setPrefetchEnabled(errorCode, enable);
+}
+
 void DeviceAdapter::spectrometerSetIntegrationTimeMicros(
             long featureID, int *errorCode, unsigned long integrationTimeMicros) {
     SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
@@ -532,6 +790,107 @@ double DeviceAdapter::spectrometerGetMaximumIntensity(
     return feature->getMaximumIntensity(errorCode);
 }
 
+int DeviceAdapter::spectrometerStartFastBufferStream(long featureID,
+        int *errorCode, int capacity) {
+    MutexLock streams(this->streamLock);
+
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    if(true == feature->isFastBufferStreaming()) {
+        /* Nothing to set up again, so do not wait for the device */
+        return feature->startFastBufferStream(errorCode, capacity, &this->lock);
+    }
+
+    MutexLock device(this->lock);
+
+    cancelSpectrumPrefetches();
+
+    /* The device only holds on to spectra while buffering is enabled */
+    if(this->fastBufferFeatures.size() > 0) {
+        int error = ERROR_SUCCESS;
+        this->fastBufferFeatures[0]->setBufferingEnable(&error, 1);
+        if(ERROR_SUCCESS != error) {
+            SET_ERROR_CODE(error);
+            return 0;
+        }
+    }
+
+    /* The stream's thread waits for the device until this returns */
+    return feature->startFastBufferStream(errorCode, capacity, &this->lock);
+}
+
+int DeviceAdapter::spectrometerReadFastBufferStream(long featureID,
+        int *errorCode, unsigned char *buffer, int bufferLength) {
+    MutexLock streams(this->streamLock);
+
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->readFastBufferStream(errorCode, buffer, bufferLength);
+}
+
+void DeviceAdapter::spectrometerStopFastBufferStream(long featureID,
+        int *errorCode) {
+    MutexLock streams(this->streamLock);
+
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    feature->stopFastBufferStream(errorCode);
+}
+
+unsigned int DeviceAdapter::spectrometerGetFastBufferStreamOverruns(
+        long featureID, int *errorCode) {
+    MutexLock streams(this->streamLock);
+
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getFastBufferStreamOverruns(errorCode);
+}
+
+int DeviceAdapter::spectrometerGetFastBufferSpectrumLength(long featureID,
+        int *errorCode) {
+    MutexLock streams(this->streamLock);
+
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getFastBufferSpectrumLength(errorCode);
+}
+
+int DeviceAdapter::spectrometerDecodeFastBufferSpectra(long featureID,
+        int *errorCode, const unsigned char *buffer, int bufferLength,
+        sbapi_spectrum_metadata_t *metadata, unsigned char *valid,
+        int maxSpectra) {
+    MutexLock streams(this->streamLock);
+
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->decodeFastBufferSpectra(errorCode, buffer, bufferLength,
+            metadata, valid, maxSpectra);
+}
+
 int DeviceAdapter::spectrometerGetUnformattedSpectrumLength(
         long featureID, int *errorCode) {
     SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
@@ -610,6 +969,63 @@ int DeviceAdapter::spectrometerGetFormattedSpectrum(long featureID, int *errorCo
     return feature->getFormattedSpectrum(errorCode, buffer, bufferLength);
 }
 
+int DeviceAdapter::spectrometerGetFormattedSpectrum(long featureID, int *errorCode,
+        float *buffer, int bufferLength) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getFormattedSpectrum(errorCode, buffer, bufferLength);
+}
+
+int DeviceAdapter::spectrometerGetFormattedSpectrum(long featureID, int *errorCode,
+        unsigned short *buffer, int bufferLength) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getFormattedSpectrum(errorCode, buffer, bufferLength);
+}
+
+int DeviceAdapter::spectrometerGetFormattedSpectrum(long featureID, int *errorCode,
+        unsigned int *buffer, int bufferLength) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getFormattedSpectrum(errorCode, buffer, bufferLength);
+}
+
+int DeviceAdapter::spectrometerGetFormattedSpectrumWithMetadata(long featureID,
+        int *errorCode, double *buffer, int bufferLength,
+        sbapi_spectrum_metadata_t *metadata) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    return feature->getFormattedSpectrumWithMetadata(errorCode, buffer,
+            bufferLength, metadata);
+}
+
+void DeviceAdapter::spectrometerGetFormattedSpectrumMetadata(long featureID,
+        int *errorCode, sbapi_spectrum_metadata_t *metadata) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    feature->getFormattedSpectrumMetadata(errorCode, metadata);
+}
+
 int DeviceAdapter::spectrometerGetWavelengths(long featureID, int *errorCode,
         double *wavelengths, int length) {
     SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
@@ -643,6 +1059,144 @@ int DeviceAdapter::spectrometerGetElectricDarkPixelIndices(
     return feature->getElectricDarkPixelIndices(errorCode, indices, length);
 }
 
+/* Keeps the first error of several, but still lets the rest be tried */
+static void __noteFrameError(int *first, int error) {
+    if(ERROR_SUCCESS == *first) {
+        *first = error;
+    }
+}
+
+int DeviceAdapter::spectrometerAcquireFrame(long featureID, int *errorCode,
+        sbapi_frame_t *frame) {
+    SpectrometerFeatureAdapter *feature = getSpectrometerFeatureByID(featureID);
+    if(NULL == feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    if(NULL == frame) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    int firstError = ERROR_SUCCESS;
+    int error;
+    frame->items_read = 0;
+
+    /* A spectrum that was prefetched is read first, and the next one is
+     * only requested once everything else has been read, so that the
+     * other items do not have to throw it away.
+     */
+    feature->holdPrefetch();
+
+    if(0 != (frame->items & SBAPI_FRAME_SPECTRUM)) {
+        frame->pixels = feature->getFormattedSpectrum(&error, frame->spectrum,
+                frame->spectrum_length);
+        if(ERROR_SUCCESS == error) {
+            frame->items_read |= SBAPI_FRAME_SPECTRUM;
+            /* This decodes what came with the spectrum; it is not a transfer */
+            feature->getFormattedSpectrumMetadata(&error, &frame->metadata);
+            if(ERROR_SUCCESS == error) {
+                frame->items_read |= SBAPI_FRAME_METADATA;
+            } else if(0 != (frame->items & SBAPI_FRAME_METADATA)) {
+                __noteFrameError(&firstError, error);
+            }
+        } else {
+            __noteFrameError(&firstError, error);
+        }
+    }
+
+    if(0 != (frame->items & SBAPI_FRAME_WAVELENGTHS)) {
+        if(NULL == frame->wavelengths) {
+            __noteFrameError(&firstError, ERROR_BAD_USER_BUFFER);
+        } else {
+            /* Only the first of these reads the calibration from the device */
+            frame->wavelength_count = feature->getWavelengths(&error,
+                    frame->wavelengths, frame->wavelengths_length);
+            if(ERROR_SUCCESS == error) {
+                frame->items_read |= SBAPI_FRAME_WAVELENGTHS;
+            } else {
+                __noteFrameError(&firstError, error);
+            }
+        }
+    }
+
+    if(0 != (frame->items & SBAPI_FRAME_INTEGRATION_TIME)) {
+        /* What the device reports having used is better than what it was
+         * last told to use.
+         */
+        if(0 != (frame->items_read & SBAPI_FRAME_METADATA)) {
+            frame->integration_time_micros
+                    = frame->metadata.integration_time_micros;
+            frame->items_read |= SBAPI_FRAME_INTEGRATION_TIME;
+        } else {
+            frame->integration_time_micros
+                    = feature->getIntegrationTimeMicros(&error);
+            if(ERROR_SUCCESS == error) {
+                frame->items_read |= SBAPI_FRAME_INTEGRATION_TIME;
+            } else {
+                __noteFrameError(&firstError, error);
+            }
+        }
+    }
+
+    if(0 != (frame->items & (SBAPI_FRAME_TEMPERATURES | SBAPI_FRAME_TEC_TEMPERATURE))) {
+        /* Other spectrometers on the device may still have one in flight */
+        cancelSpectrumPrefetches();
+    }
+
+    bool tecRead = false;
+    if(0 != (frame->items & SBAPI_FRAME_TEMPERATURES)) {
+        if(true == this->temperatureFeatures.empty()) {
+            __noteFrameError(&firstError, ERROR_FEATURE_NOT_FOUND);
+        } else if(NULL == frame->temperatures) {
+            __noteFrameError(&firstError, ERROR_BAD_USER_BUFFER);
+        } else if(0 != (frame->items & SBAPI_FRAME_TEC_TEMPERATURE)
+                && false == this->tecFeatures.empty()) {
+            /* Both go out in one pipelined batch where the device allows */
+            frame->temperature_count
+                    = this->temperatureFeatures[0]->readAllTemperaturesWithTEC(
+                    &error, frame->temperatures, frame->temperatures_length,
+                    &frame->tec_temperature_degrees_c, &tecRead);
+            if(ERROR_SUCCESS == error) {
+                frame->items_read |= SBAPI_FRAME_TEMPERATURES;
+            } else {
+                __noteFrameError(&firstError, error);
+            }
+        } else {
+            frame->temperature_count = this->temperatureFeatures[0]->readAllTemperatures(
+                    &error, frame->temperatures, frame->temperatures_length);
+            if(ERROR_SUCCESS == error) {
+                frame->items_read |= SBAPI_FRAME_TEMPERATURES;
+            } else {
+                __noteFrameError(&firstError, error);
+            }
+        }
+    }
+
+    if(0 != (frame->items & SBAPI_FRAME_TEC_TEMPERATURE)) {
+        if(true == this->tecFeatures.empty()) {
+            __noteFrameError(&firstError, ERROR_FEATURE_NOT_FOUND);
+        } else if(true == tecRead) {
+            frame->items_read |= SBAPI_FRAME_TEC_TEMPERATURE;
+        } else {
+            /* Not answered with the temperatures, so ask the TEC feature */
+            frame->tec_temperature_degrees_c
+                    = this->tecFeatures[0]->readTECTemperature(&error);
+            if(ERROR_SUCCESS == error) {
+                frame->items_read |= SBAPI_FRAME_TEC_TEMPERATURE;
+            } else {
+                __noteFrameError(&firstError, error);
+            }
+        }
+    }
+
+    feature->resumePrefetch();
+
+    SET_ERROR_CODE(firstError);
+    return (int) frame->items_read;
+}
+
 
 
 /* Pixel binning feature wrappers */
@@ -726,6 +1280,7 @@ int DeviceAdapter::getThermoElectricFeatures(long *buffer, int maxFeatures) {
 }
 
 ThermoElectricCoolerFeatureAdapter *DeviceAdapter::getTECFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<ThermoElectricCoolerFeatureAdapter>(
                 tecFeatures, featureID);
 }
@@ -772,6 +1327,7 @@ int DeviceAdapter::getIrradCalFeatures(long *buffer, int maxFeatures) {
 }
 
 IrradCalFeatureAdapter *DeviceAdapter::getIrradCalFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<IrradCalFeatureAdapter>(
                 irradCalFeatures, featureID);
 }
@@ -795,7 +1351,10 @@ int DeviceAdapter::irradCalibrationWrite(long featureID,
         return 0;
     }
 
-    return feature->writeIrradCalibration(errorCode, buffer, bufferLength);
+    int retval = feature->writeIrradCalibration(errorCode, buffer, bufferLength);
+    /* Even a failed write may have changed part of the calibration */
+    forgetDescriptor();
+    return retval;
 }
 
 int DeviceAdapter::irradCalibrationHasCollectionArea(long featureID, int *errorCode) {
@@ -826,7 +1385,8 @@ void DeviceAdapter::irradCalibrationWriteCollectionArea(long featureID,
         return;
     }
 
-    return feature->writeIrradCollectionArea(errorCode, area);
+    feature->writeIrradCollectionArea(errorCode, area);
+    forgetDescriptor();
 }
 
 /* Ethernet Configuration feature wrappers */
@@ -842,6 +1402,7 @@ int DeviceAdapter::getEthernetConfigurationFeatures(long *buffer, int maxFeature
 
 EthernetConfigurationFeatureAdapter *DeviceAdapter::getEthernetConfigurationFeatureByID(long featureID) 
 {
+	cancelSpectrumPrefetches();
 	return __getFeatureByID<EthernetConfigurationFeatureAdapter>(ethernetConfigurationFeatures, featureID);
 }
 
@@ -908,6 +1469,7 @@ int DeviceAdapter::getGPIOFeatures(long *buffer, int maxFeatures)
 
 gpioFeatureAdapter *DeviceAdapter::getGPIOFeatureByID(long featureID)
 {
+	cancelSpectrumPrefetches();
 	return __getFeatureByID<gpioFeatureAdapter>(gpioFeatures, featureID);
 }
 
@@ -1073,6 +1635,7 @@ int DeviceAdapter::getMulticastFeatures(long *buffer, int maxFeatures)
 
 MulticastFeatureAdapter *DeviceAdapter::getMulticastFeatureByID(long featureID)
 {
+	cancelSpectrumPrefetches();
 	return __getFeatureByID<MulticastFeatureAdapter>(multicastFeatures, featureID);
 }
 
@@ -1142,6 +1705,7 @@ int DeviceAdapter::getIPv4Features(long *buffer, int maxFeatures)
 
 IPv4FeatureAdapter *DeviceAdapter::getIPv4FeatureByID(long featureID)
 {
+	cancelSpectrumPrefetches();
 	return __getFeatureByID<IPv4FeatureAdapter>(IPv4Features, featureID);
 }
 
@@ -1258,6 +1822,7 @@ int DeviceAdapter::getWifiConfigurationFeatures(long *buffer, int maxFeatures)
 
 WifiConfigurationFeatureAdapter *DeviceAdapter::getWifiConfigurationFeatureByID(long featureID)
 {
+	cancelSpectrumPrefetches();
 	return __getFeatureByID<WifiConfigurationFeatureAdapter>(wifiConfigurationFeatures, featureID);
 }
 
@@ -1351,6 +1916,7 @@ int DeviceAdapter::getDHCPServerFeatures(long *buffer, int maxFeatures)
 
 DHCPServerFeatureAdapter *DeviceAdapter::getDHCPServerFeatureByID(long featureID)
 {
+	cancelSpectrumPrefetches();
 	return __getFeatureByID<DHCPServerFeatureAdapter>(dhcpServerFeatures, featureID);
 }
 
@@ -1417,6 +1983,7 @@ int DeviceAdapter::getNetworkConfigurationFeatures(long *buffer, int maxFeatures
 
 NetworkConfigurationFeatureAdapter *DeviceAdapter::getNetworkConfigurationFeatureByID(long featureID)
 {
+	cancelSpectrumPrefetches();
 	return __getFeatureByID<NetworkConfigurationFeatureAdapter>(networkConfigurationFeatures, featureID);
 }
 
@@ -1498,6 +2065,7 @@ int DeviceAdapter::getEEPROMFeatures(long *buffer, int maxFeatures) {
 }
 
 EEPROMFeatureAdapter *DeviceAdapter::getEEPROMFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<EEPROMFeatureAdapter>(
                 eepromFeatures, featureID);
 }
@@ -1524,6 +2092,7 @@ int DeviceAdapter::getLightSourceFeatures(long *buffer, int maxFeatures) {
 }
 
 LightSourceFeatureAdapter *DeviceAdapter::getLightSourceFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<LightSourceFeatureAdapter>(
                 lightSourceFeatures, featureID);
 }
@@ -1622,6 +2191,7 @@ int DeviceAdapter::getStrobeLampFeatures(long *buffer, int maxFeatures) {
 }
 
 StrobeLampFeatureAdapter *DeviceAdapter::getStrobeLampFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<StrobeLampFeatureAdapter>(
                 strobeLampFeatures, featureID);
 }
@@ -1648,6 +2218,7 @@ int DeviceAdapter::getContinuousStrobeFeatures(long *buffer, int maxFeatures) {
 }
 
 ContinuousStrobeFeatureAdapter *DeviceAdapter::getContinuousStrobeFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<ContinuousStrobeFeatureAdapter>(
                 continuousStrobeFeatures, featureID);
 }
@@ -1685,6 +2256,7 @@ int DeviceAdapter::getShutterFeatures(long *buffer, int maxFeatures) {
 }
 
 ShutterFeatureAdapter *DeviceAdapter::getShutterFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<ShutterFeatureAdapter>(
                 shutterFeatures, featureID);
 }
@@ -1712,6 +2284,7 @@ int DeviceAdapter::getNonlinearityCoeffsFeatures(long *buffer, int maxFeatures)
 }
 
 NonlinearityCoeffsFeatureAdapter *DeviceAdapter::getNonlinearityCoeffsFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<NonlinearityCoeffsFeatureAdapter>(
                 nonlinearityFeatures, featureID);
 }
@@ -1738,6 +2311,7 @@ int DeviceAdapter::getTemperatureFeatures(long *buffer, int maxFeatures) {
 }
 
 TemperatureFeatureAdapter *DeviceAdapter::getTemperatureFeatureByID(long temperatureFeatureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<TemperatureFeatureAdapter>(
                 temperatureFeatures, temperatureFeatureID);
 }
@@ -1784,6 +2358,7 @@ int DeviceAdapter::getIntrospectionFeatures(long *buffer, int maxFeatures) {
 }
 
 IntrospectionFeatureAdapter *DeviceAdapter::getIntrospectionFeatureByID(long featureID) {
+	cancelSpectrumPrefetches();
 	return __getFeatureByID<IntrospectionFeatureAdapter>(
 		introspectionFeatures, featureID);
 }
@@ -1845,6 +2420,7 @@ int DeviceAdapter::getRevisionFeatures(long *buffer, int maxFeatures) {
 }
 
 RevisionFeatureAdapter *DeviceAdapter::getRevisionFeatureByID(long revisionFeatureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<RevisionFeatureAdapter>(
                 revisionFeatures, revisionFeatureID);
 }
@@ -1880,6 +2456,7 @@ int DeviceAdapter::getOpticalBenchFeatures(long *buffer, int maxFeatures) {
 }
 
 OpticalBenchFeatureAdapter *DeviceAdapter::getOpticalBenchFeatureByID(long opticalBenchFeatureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<OpticalBenchFeatureAdapter>(
                opticalBenchFeatures, opticalBenchFeatureID);
 }
@@ -1969,6 +2546,7 @@ int DeviceAdapter::getSpectrumProcessingFeatures(long *buffer, int maxFeatures)
 }
 
 SpectrumProcessingFeatureAdapter *DeviceAdapter::getSpectrumProcessingFeatureByID(long spectrumProcessingFeatureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<SpectrumProcessingFeatureAdapter>(
                spectrumProcessingFeatures, spectrumProcessingFeatureID);
 }
@@ -2029,6 +2607,7 @@ int DeviceAdapter::getStrayLightCoeffsFeatures(long *buffer, int maxFeatures) {
 
 
 StrayLightCoeffsFeatureAdapter *DeviceAdapter::getStrayLightCoeffsFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<StrayLightCoeffsFeatureAdapter>(
                 strayLightFeatures, featureID);
 }
@@ -2045,6 +2624,7 @@ int DeviceAdapter::strayLightCoeffsGet(long featureID, int *errorCode,
 }
 
 PixelBinningFeatureAdapter *DeviceAdapter::getPixelBinningFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<PixelBinningFeatureAdapter>(pixelBinningFeatures, featureID);
 }
 
@@ -2060,6 +2640,7 @@ int DeviceAdapter::getDataBufferFeatures(long *buffer, int maxFeatures) {
 }
 
 DataBufferFeatureAdapter *DeviceAdapter::getDataBufferFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<DataBufferFeatureAdapter>(
                 dataBufferFeatures, featureID);
 }
@@ -2148,6 +2729,7 @@ int DeviceAdapter::getFastBufferFeatures(long *buffer, int maxFeatures) {
 }
 
 FastBufferFeatureAdapter *DeviceAdapter::getFastBufferFeatureByID(long featureID) {
+	cancelSpectrumPrefetches();
 	return __getFeatureByID<FastBufferFeatureAdapter>(
 		fastBufferFeatures, featureID);
 }
@@ -2204,6 +2786,7 @@ int DeviceAdapter::getAcquisitionDelayFeatures(long *buffer, int maxFeatures) {
 }
 
 AcquisitionDelayFeatureAdapter *DeviceAdapter::getAcquisitionDelayFeatureByID(long featureID) {
+    cancelSpectrumPrefetches();
     return __getFeatureByID<AcquisitionDelayFeatureAdapter>(
                 acquisitionDelayFeatures, featureID);
 }
@@ -2273,6 +2856,7 @@ int DeviceAdapter::getI2CMasterFeatures(long *buffer, int maxFeatures)
 
 I2CMasterFeatureAdapter *DeviceAdapter::getI2CMasterFeatureByID(long featureID)
 {
+	cancelSpectrumPrefetches();
 	return __getFeatureByID<I2CMasterFeatureAdapter>(i2cMasterFeatures, featureID);
 }
 
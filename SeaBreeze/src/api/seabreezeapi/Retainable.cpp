@@ -0,0 +1,61 @@
+/***************************************************//**
+ * @file    Retainable.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Reference counting for objects that the API hands out by ID.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include "api/seabreezeapi/Retainable.h"
+
+using namespace seabreeze;
+using namespace seabreeze::api;
+
+Retainable::Retainable() {
+    this->references = 0;
+    this->retired = false;
+}
+
+Retainable::~Retainable() {
+
+}
+
+void Retainable::retain() {
+    MutexLock guard(this->referenceLock);
+    this->references++;
+}
+
+bool Retainable::release() {
+    MutexLock guard(this->referenceLock);
+    this->references--;
+    return true == this->retired && 0 == this->references;
+}
+
+bool Retainable::retire() {
+    MutexLock guard(this->referenceLock);
+    this->retired = true;
+    return 0 == this->references;
+}
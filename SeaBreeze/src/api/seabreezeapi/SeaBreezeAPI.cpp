@@ -43,6 +43,8 @@
 #include "api/seabreezeapi/SeaBreezeAPI_Impl.h"
 #include "api/seabreezeapi/SeaBreezeAPIConstants.h"
 #include "api/DeviceFactory.h"
+#include "native/system/Mutex.h"
+#include "native/system/NativeSystem.h"
 
 #include <ctype.h>
 #include <vector>
@@ -76,14 +78,37 @@ static char __messageBuffer[MESSAGE_BUFFER_SIZE];
 
 SeaBreezeAPI *SeaBreezeAPI::instance = NULL;
 
+/* Keeps two threads that make their first calls at the same time from
+ * creating two instances.
+ */
+static Mutex __instanceLock;
+/* Set once the instance exists, so that every call after the first can
+ * skip the lock.
+ */
+static volatile unsigned int __instanceReady = 0;
+
 SeaBreezeAPI *SeaBreezeAPI::getInstance() {
+    if(0 != atomicLoad(&__instanceReady)) {
+        return instance;
+    }
+
+    MutexLock guard(__instanceLock);
+
     if(NULL == instance) {
+        /* The device factory is a singleton of its own that the instance
+         * relies on, so it is created under the same lock.
+         */
+        DeviceFactory::getInstance();
         instance = new SeaBreezeAPI_Impl();
     }
+    atomicStore(&__instanceReady, 1);
     return instance;
 }
 
 void SeaBreezeAPI::shutdown() {
+    MutexLock guard(__instanceLock);
+
+    atomicStore(&__instanceReady, 0);
     if(NULL != instance) {
         delete instance;
         instance = NULL;
@@ -138,6 +163,28 @@ sbapi_probe_devices() {
     return wrapper->probeDevices();
 }
 
+int
+sbapi_enable_hot_plug(sbapi_hot_plug_callback callback, void *userData,
+            int *error_code) {
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->enableHotPlug(callback, userData, error_code);
+}
+
+void
+sbapi_disable_hot_plug(int *error_code) {
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    wrapper->disableHotPlug(error_code);
+}
+
+int
+sbapi_set_descriptor_cache_file(const char *path, int *error_code) {
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->setDescriptorCacheFile(path, error_code);
+}
+
 int
 sbapi_get_number_of_device_ids() {
     SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
@@ -166,6 +213,13 @@ sbapi_close_device(long index, int *error_code) {
     wrapper->closeDevice(index, error_code);
 }
 
+void
+sbapi_resync_device_settings(long deviceID, int *error_code) {
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    wrapper->resyncDeviceSettings(deviceID, error_code);
+}
+
 const char *
 sbapi_get_error_string(int error_code) {
 	const char *returnMessage;
@@ -354,6 +408,17 @@ sbapi_spectrometer_set_trigger_mode(long deviceID, long spectrometerFeatureID,
     wrapper->spectrometerSetTriggerMode(deviceID, spectrometerFeatureID, error_code, mode);
 }
 
+void
+sbapi_spectrometer_set_prefetch_enable(long deviceID,
+        long spectrometerFeatureID, int *error_code,
+        unsigned char prefetch_enable) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    wrapper->spectrometerSetPrefetchEnable(deviceID, spectrometerFeatureID,
+            error_code, prefetch_enable);
+}
+
 void
 sbapi_spectrometer_set_integration_time_micros(long deviceID, long spectrometerFeatureID,
         int *error_code, unsigned long integration_time_micros) {
@@ -384,6 +449,208 @@ sbapi_spectrometer_get_maximum_intensity(long deviceID,
             error_code);
 }
 
+int
+sbapi_spectrometer_start_fast_buffer_stream(long deviceID,
+        long spectrometerFeatureID, int *error_code, int capacity) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerStartFastBufferStream(deviceID,
+            spectrometerFeatureID, error_code, capacity);
+}
+
+int
+sbapi_spectrometer_read_fast_buffer_stream(long deviceID,
+        long spectrometerFeatureID, int *error_code,
+        unsigned char *buffer, int buffer_length) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerReadFastBufferStream(deviceID,
+            spectrometerFeatureID, error_code, buffer, buffer_length);
+}
+
+void
+sbapi_spectrometer_stop_fast_buffer_stream(long deviceID,
+        long spectrometerFeatureID, int *error_code) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    wrapper->spectrometerStopFastBufferStream(deviceID,
+            spectrometerFeatureID, error_code);
+}
+
+unsigned int
+sbapi_spectrometer_get_fast_buffer_stream_overruns(long deviceID,
+        long spectrometerFeatureID, int *error_code) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerGetFastBufferStreamOverruns(deviceID,
+            spectrometerFeatureID, error_code);
+}
+
+int
+sbapi_spectrometer_get_fast_buffer_spectrum_length(long deviceID,
+        long spectrometerFeatureID, int *error_code) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerGetFastBufferSpectrumLength(deviceID,
+            spectrometerFeatureID, error_code);
+}
+
+int
+sbapi_spectrometer_decode_fast_buffer_spectra(long deviceID,
+        long spectrometerFeatureID, int *error_code,
+        const unsigned char *buffer, int buffer_length,
+        sbapi_spectrum_metadata_t *metadata, unsigned char *valid,
+        int max_spectra) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerDecodeFastBufferSpectra(deviceID,
+            spectrometerFeatureID, error_code, buffer, buffer_length,
+            metadata, valid, max_spectra);
+}
+
+long
+sbapi_spectrometer_open_session(long deviceID, long spectrometerFeatureID,
+        int *error_code) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerOpenSession(deviceID, spectrometerFeatureID,
+            error_code);
+}
+
+void
+sbapi_spectrometer_close_session(long sessionID, int *error_code) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    wrapper->spectrometerCloseSession(sessionID, error_code);
+}
+
+int
+sbapi_spectrometer_session_get_formatted_spectrum(long sessionID,
+        int *error_code, double *buffer, int buffer_length) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerSessionGetFormattedSpectrum(sessionID,
+            error_code, buffer, buffer_length);
+}
+
+int
+sbapi_spectrometer_session_get_formatted_spectrum_float(long sessionID,
+        int *error_code, float *buffer, int buffer_length) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerSessionGetFormattedSpectrum(sessionID,
+            error_code, buffer, buffer_length);
+}
+
+int
+sbapi_spectrometer_session_get_formatted_spectrum_uint16(long sessionID,
+        int *error_code, unsigned short *buffer, int buffer_length) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerSessionGetFormattedSpectrum(sessionID,
+            error_code, buffer, buffer_length);
+}
+
+int
+sbapi_spectrometer_session_get_formatted_spectrum_uint32(long sessionID,
+        int *error_code, unsigned int *buffer, int buffer_length) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerSessionGetFormattedSpectrum(sessionID,
+            error_code, buffer, buffer_length);
+}
+
+int
+sbapi_spectrometer_session_get_unformatted_spectrum(long sessionID,
+        int *error_code, unsigned char *buffer, int buffer_length) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerSessionGetUnformattedSpectrum(sessionID,
+            error_code, buffer, buffer_length);
+}
+
+long
+sbapi_spectrometer_submit_formatted_spectrum(long deviceID, long featureID,
+        int *error_code, double *buffer, int buffer_length,
+        sbapi_acquisition_callback callback, void *user_data) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerSubmitFormattedSpectrum(deviceID, featureID,
+            error_code, buffer, buffer_length, callback, user_data);
+}
+
+long
+sbapi_spectrometer_submit_unformatted_spectrum(long deviceID, long featureID,
+        int *error_code, unsigned char *buffer, int buffer_length,
+        sbapi_acquisition_callback callback, void *user_data) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerSubmitUnformattedSpectrum(deviceID, featureID,
+            error_code, buffer, buffer_length, callback, user_data);
+}
+
+int
+sbapi_spectrometer_wait_acquisition(long requestID, int *error_code,
+        int timeout_millis) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerWaitAcquisition(requestID, error_code,
+            timeout_millis);
+}
+
+int
+sbapi_spectrometer_get_acquisition_result(long requestID, int *error_code) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerGetAcquisitionResult(requestID, error_code);
+}
+
+long
+sbapi_create_acquisition_group(const long *deviceIDs, const long *featureIDs,
+        int count, int *error_code) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->createAcquisitionGroup(deviceIDs, featureIDs, count,
+            error_code);
+}
+
+void
+sbapi_destroy_acquisition_group(long groupID, int *error_code) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    wrapper->destroyAcquisitionGroup(groupID, error_code);
+}
+
+int
+sbapi_acquisition_group_get_formatted_spectra(long groupID, int *error_code,
+        double *buffer, int pixels_per_spectrum,
+        sbapi_group_spectrum_t *results, int max_results) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->acquisitionGroupGetFormattedSpectra(groupID, error_code,
+            buffer, pixels_per_spectrum, results, max_results);
+}
+
 int sbapi_spectrometer_get_fast_buffer_spectrum(long deviceID,
 	long spectrometerFeatureID, int *error_code,
 	unsigned char *buffer, int buffer_length, unsigned int numberOfSamplesToRetrieve)
@@ -435,6 +702,62 @@ sbapi_spectrometer_get_formatted_spectrum(long deviceID,
             error_code, buffer, buffer_length);
 }
 
+int
+sbapi_spectrometer_get_formatted_spectrum_float(long deviceID,
+        long spectrometerFeatureID, int *error_code,
+        float *buffer, int buffer_length) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerGetFormattedSpectrum(deviceID, spectrometerFeatureID,
+            error_code, buffer, buffer_length);
+}
+
+int
+sbapi_spectrometer_get_formatted_spectrum_uint16(long deviceID,
+        long spectrometerFeatureID, int *error_code,
+        unsigned short *buffer, int buffer_length) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerGetFormattedSpectrum(deviceID, spectrometerFeatureID,
+            error_code, buffer, buffer_length);
+}
+
+int
+sbapi_spectrometer_get_formatted_spectrum_uint32(long deviceID,
+        long spectrometerFeatureID, int *error_code,
+        unsigned int *buffer, int buffer_length) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerGetFormattedSpectrum(deviceID, spectrometerFeatureID,
+            error_code, buffer, buffer_length);
+}
+
+int
+sbapi_spectrometer_get_formatted_spectrum_with_metadata(long deviceID,
+        long spectrometerFeatureID, int *error_code,
+        double *buffer, int buffer_length,
+        sbapi_spectrum_metadata_t *metadata) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerGetFormattedSpectrumWithMetadata(deviceID,
+            spectrometerFeatureID, error_code, buffer, buffer_length, metadata);
+}
+
+void
+sbapi_spectrometer_get_formatted_spectrum_metadata(long deviceID,
+        long spectrometerFeatureID, int *error_code,
+        sbapi_spectrum_metadata_t *metadata) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    wrapper->spectrometerGetFormattedSpectrumMetadata(deviceID,
+            spectrometerFeatureID, error_code, metadata);
+}
+
 int
 sbapi_spectrometer_get_unformatted_spectrum_length(long deviceID,
         long spectrometerFeatureID, int *error_code) {
@@ -486,6 +809,16 @@ sbapi_spectrometer_get_electric_dark_pixel_indices(long deviceID,
             error_code, indices, length);
 }
 
+int
+sbapi_spectrometer_acquire_frame(long deviceID, long spectrometerFeatureID,
+        int *error_code, sbapi_frame_t *frame) {
+
+    SeaBreezeAPI *wrapper = SeaBreezeAPI::getInstance();
+
+    return wrapper->spectrometerAcquireFrame(deviceID, spectrometerFeatureID,
+            error_code, frame);
+}
+
 /**************************************************************************************/
 //  C language wrapper for pixel binning features
 /**************************************************************************************/
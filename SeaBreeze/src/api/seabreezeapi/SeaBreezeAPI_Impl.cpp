@@ -45,10 +45,15 @@
 #include "common/buses/network/IPv4NetworkProtocol.h"
 #include "common/buses/rs232/RS232DeviceLocator.h"
 #include "common/buses/DeviceLocationProberInterface.h"
+#include "common/buses/usb/USBInterface.h"
+#include "common/buses/usb/USBDeviceLocator.h"
+#include "native/usb/USBDiscovery.h"
+#include "native/usb/NetlinkUSBHotPlugEventSource.h"
 #include "native/system/System.h"
 
 #include <ctype.h>
 #include <vector>
+#include <algorithm>
 #include <string.h>
 #include <stdio.h>
 
@@ -60,108 +65,214 @@ static int __deviceID = 1;
 
 SeaBreezeAPI_Impl::SeaBreezeAPI_Impl() {
     System::initialize();
+    this->probeTablesBuilt = false;
+    this->hotPlugMonitor = NULL;
+    this->hotPlugCallback = NULL;
+    this->hotPlugUserData = NULL;
+    this->descriptorCache = NULL;
+    this->nextSessionID = 1;
+    this->nextGroupID = 1;
+    this->nextAcquisitionID = 1;
 }
 
 SeaBreezeAPI_Impl::~SeaBreezeAPI_Impl() {
     vector<DeviceAdapter *>::iterator dIter;
 
+    /* Make sure nothing is still changing the device lists */
+    disableHotPlug(NULL);
+
+    /* Sessions hold references to their devices */
+    map<long, SpectrometerSession *>::iterator sIter;
+    for(sIter = this->sessions.begin(); sIter != this->sessions.end(); sIter++) {
+        if(true == sIter->second->retire()) {
+            deleteSession(sIter->second);
+        }
+    }
+    this->sessions.clear();
+
+    map<long, AcquisitionGroup *>::iterator gIter;
+    for(gIter = this->groups.begin(); gIter != this->groups.end(); gIter++) {
+        if(true == gIter->second->retire()) {
+            deleteGroup(gIter->second);
+        }
+    }
+    this->groups.clear();
+
     for(dIter = this->specifiedDevices.begin(); dIter != this->specifiedDevices.end(); dIter++) {
-        delete *dIter;
+        retireDevice(*dIter);
     }
 
     for(dIter = this->probedDevices.begin(); dIter != this->probedDevices.end(); dIter++) {
-        delete *dIter;
+        retireDevice(*dIter);
     }
+
+    /* The workers have failed anything that was still queued by now */
+    map<long, AcquisitionRequest *>::iterator aIter;
+    for(aIter = this->acquisitions.begin(); aIter != this->acquisitions.end(); aIter++) {
+        if(true == aIter->second->retire()) {
+            delete aIter->second;
+        }
+    }
+    this->acquisitions.clear();
+
+    delete this->descriptorCache;
     
     System::shutdown();
 }
 
+void SeaBreezeAPI_Impl::buildProbeTables() {
+    /* Create an exemplar of each device type once and note how it can be
+     * found.  USB buses just contribute their VID/PID to a table so that the
+     * bus can be scanned once for all of them.
+     */
+    Device *dev;
+    USBDeviceFilter filter;
+    int i;
+
+    DeviceFactory* deviceFactory = DeviceFactory::getInstance();
+
+    for(i = 0; i < deviceFactory->getNumberOfDeviceTypes(); i++) {
+        bool otherProber = false;
+        dev = deviceFactory->create(i);
+
+        vector<Bus *>::iterator iter;
+        vector<Bus *> buses = dev->getBuses();
+
+        for(iter = buses.begin(); iter != buses.end(); iter++) {
+            if(NULL == dynamic_cast<DeviceLocationProberInterface *>(*iter)) {
+                continue;
+            }
+            USBInterface *usb = dynamic_cast<USBInterface *>(*iter);
+            if(NULL != usb) {
+                filter.vendorID = (unsigned short)usb->getVendorID();
+                filter.productID = (unsigned short)usb->getProductID();
+                this->usbProbeFilters.push_back(filter);
+                this->usbProbeDeviceTypes.push_back(i);
+            } else {
+                otherProber = true;
+            }
+        }
+
+        if(true == otherProber) {
+            this->otherProberDeviceTypes.push_back(i);
+        }
+
+        delete dev;
+    }
+
+    this->probeTablesBuilt = true;
+}
+
+void SeaBreezeAPI_Impl::trackProbedLocation(int deviceTypeIndex,
+        DeviceLocatorInterface &location, vector<DeviceAdapter *> &validDevices) {
+    vector<DeviceAdapter *>::iterator devIter;
+
+    /* Check whether this location is already known.  If so, just note that
+     * it has been seen again.
+     */
+    for(    devIter = this->probedDevices.begin();
+            devIter != this->probedDevices.end();
+            devIter++) {
+        DeviceLocatorInterface *knownLoc = (*devIter)->getLocation();
+        if(true == location.equals(*knownLoc)) {
+            validDevices.push_back(*devIter);
+            return;
+        }
+    }
+
+    /* The location is not already known.  Create a new instance of the type
+     * of device in question and assign the new instance to this location.
+     * This also effectively marks the new instance as being valid.
+     */
+    Device *newdev = DeviceFactory::getInstance()->create(deviceTypeIndex);
+    newdev->setLocation(location);
+    /* Note that this pre-increments the device ID to
+     * mitigate any race conditions
+     */
+    try {
+        DeviceAdapter *da = new DeviceAdapter(newdev, ++__deviceID);
+        this->probedDevices.push_back(da);
+        validDevices.push_back(da);
+    } catch (IllegalArgumentException &iae) {
+        return;
+    }
+}
+
+int SeaBreezeAPI_Impl::probeDevices() {
+    WriteLock guard(this->deviceListLock);
+
+    return probeDevicesLocked();
+}
+
 #ifdef _WINDOWS
 #pragma warning (disable: 4101) // unreferenced local variable
 #endif
-int SeaBreezeAPI_Impl::probeDevices() {
-    /* This function is a little ugly because it tries to find hardware
-     * associated with every device type, but without allowing multiple
-     * Device instances to be created for a particular Bus location.
-     * This requires a bit of searching which translates to nested loops.
-     * Fortunately, none of these loops has to iterate very long.
+int SeaBreezeAPI_Impl::probeDevicesLocked() {
+    /* All USB device types are found with a single scan of the bus using
+     * the VID/PID table from buildProbeTables().  Any other kind of prober
+     * is still asked directly via an exemplar of its device type.  Known
+     * locations keep their existing DeviceAdapter, so only devices that
+     * arrived or left since the last probe cause any work here.
      */
     Device *dev;
     vector<DeviceAdapter *>::iterator devIter;
     vector<DeviceAdapter *>::iterator validIter;
-    int i;
+    vector<int>::iterator typeIter;
+    unsigned int i;
+    unsigned int j;
     vector<DeviceAdapter *> validDevices;
 
     DeviceFactory* deviceFactory = DeviceFactory::getInstance();
 
-    for(i = 0; i < deviceFactory->getNumberOfDeviceTypes(); i++) {
-        /* Try to create a device by its type index.  This does not require
-         * knowing what type of device is actually being created.  This instance
-         * will be an exemplar and will not actually be tied to real hardware.
-         */
-        dev = deviceFactory->create(i);
+    if(false == this->probeTablesBuilt) {
+        buildProbeTables();
+    }
+
+    if(false == this->usbProbeFilters.empty()) {
+        USBDiscovery discovery;
+        vector<USBProbedDevice> *found = discovery.probeDevices(this->usbProbeFilters);
+
+        for(i = 0; i < found->size(); i++) {
+            /* Map the VID/PID back to the first device type that claims it */
+            for(j = 0; j < this->usbProbeFilters.size(); j++) {
+                if(this->usbProbeFilters[j].vendorID == (*found)[i].vendorID
+                        && this->usbProbeFilters[j].productID == (*found)[i].productID) {
+                    USBDeviceLocator location((*found)[i].deviceID);
+                    trackProbedLocation(this->usbProbeDeviceTypes[j], location,
+                            validDevices);
+                    break;
+                }
+            }
+        }
+
+        delete found;
+    }
+
+    for(    typeIter = this->otherProberDeviceTypes.begin();
+            typeIter != this->otherProberDeviceTypes.end();
+            typeIter++) {
+        dev = deviceFactory->create(*typeIter);
 
         vector<Bus *>::iterator iter;
         vector<Bus *> buses = dev->getBuses();
 
         for(iter = buses.begin(); iter != buses.end(); iter++) {
             DeviceLocationProberInterface *prober = dynamic_cast<DeviceLocationProberInterface *>(*iter);
-            if(NULL != prober) {
-                /* Found a type of Bus that can probe for
-                 * real hardware to associate with this Device
-                 */
-                vector<DeviceLocatorInterface *> *locations;
-                locations = prober->probeDevices();
-                vector<DeviceLocatorInterface *>::iterator locIter;
-                for(    locIter = locations->begin();
-                        locIter != locations->end();
-                        locIter++) {
-                    /* For each device location, check whether it is already
-                     * known.  If not, add it.  If so, skip over it.
-                     */
-                    bool locationKnown = false;
-                    for(    devIter = this->probedDevices.begin();
-                            devIter != this->probedDevices.end();
-                            devIter++) {
-                        /* For each known device, compare to the newly probed
-                         * location and see if they match.
-                         */
-                        DeviceLocatorInterface *knownLoc = (*devIter)->getLocation();
-                        if(true == (*locIter)->equals(*knownLoc)) {
-                            /* This device location is already tracked. */
-                            locationKnown = true;
-                            /* Note that it has just been seen */
-                            validDevices.push_back(*devIter);
-                            break;
-                        }
-                    }
-                    if(false == locationKnown) {
-                        /* The location is not already known.  Create a new
-                         * instance of the type of device in question and
-                         * assign the new instance to this location.  This also
-                         * effectively marks the new instance as being valid.
-                         */
-                        Device *newdev = deviceFactory->create(i);
-                        newdev->setLocation(**locIter);
-                        /* Note that this pre-increments the device ID to
-                         * mitigate any race conditions
-                         */
-                        try {
-                            DeviceAdapter *da = new DeviceAdapter(newdev, ++__deviceID);
-                            this->probedDevices.push_back(da);
-                            validDevices.push_back(da);
-                        } catch (IllegalArgumentException &iae) {
-                            continue;
-                        }
-                    }
-                }
-                for(vector<DeviceLocatorInterface *>::iterator iter = locations->begin();
-                        iter != locations->end(); iter++) {
-                    delete *iter;
-                }
-                locations->clear();
-                delete locations;
+            if(NULL == prober || NULL != dynamic_cast<USBInterface *>(*iter)) {
+                /* USB was already covered by the scan above */
+                continue;
+            }
+            vector<DeviceLocatorInterface *> *locations;
+            locations = prober->probeDevices();
+            vector<DeviceLocatorInterface *>::iterator locIter;
+            for(    locIter = locations->begin();
+                    locIter != locations->end();
+                    locIter++) {
+                trackProbedLocation(*typeIter, **locIter, validDevices);
+                delete *locIter;
             }
+            locations->clear();
+            delete locations;
         }
 
         delete dev;
@@ -186,9 +297,9 @@ int SeaBreezeAPI_Impl::probeDevices() {
         }
         if(false == verified) {
             /* The device has disappeared since it was first probed.  Get rid
-             * of the instance that was tracking it.
+             * of the instance that was tracking it once nothing is using it.
              */
-            delete *devIter;
+            retireDevice(*devIter);
             devIter = this->probedDevices.erase(devIter);
         } else {
             devIter++;
@@ -198,6 +309,154 @@ int SeaBreezeAPI_Impl::probeDevices() {
     return (int) probedDevices.size();
 }
 
+int SeaBreezeAPI_Impl::enableHotPlug(sbapi_hot_plug_callback callback,
+        void *userData, int *errorCode) {
+    return enableHotPlug(new NetlinkUSBHotPlugEventSource(), callback,
+            userData, errorCode);
+}
+
+int SeaBreezeAPI_Impl::enableHotPlug(USBHotPlugEventSource *source,
+        sbapi_hot_plug_callback callback, void *userData, int *errorCode) {
+
+    if(NULL == source) {
+        SET_ERROR_CODE(ERROR_INVALID_ERROR);
+        return -1;
+    }
+
+    MutexLock guard(this->hotPlugLock);
+
+    /* Replace any monitor that is already running */
+    stopHotPlugMonitorLocked();
+
+    this->hotPlugCallback = callback;
+    this->hotPlugUserData = userData;
+
+    /* Bring the device list up to date so that later events only need to
+     * report what changed.
+     */
+    probeDevices();
+
+    this->hotPlugMonitor = new USBHotPlugMonitor(source, this);
+    if(false == this->hotPlugMonitor->startMonitoring()) {
+        delete this->hotPlugMonitor;
+        this->hotPlugMonitor = NULL;
+        SET_ERROR_CODE(ERROR_NOT_IMPLEMENTED);
+        return -1;
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return 0;
+}
+
+void SeaBreezeAPI_Impl::disableHotPlug(int *errorCode) {
+    MutexLock guard(this->hotPlugLock);
+
+    stopHotPlugMonitorLocked();
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+void SeaBreezeAPI_Impl::stopHotPlugMonitorLocked() {
+    if(NULL != this->hotPlugMonitor) {
+        /* This joins the monitor thread, so no callback can be running
+         * once it returns.
+         */
+        delete this->hotPlugMonitor;
+        this->hotPlugMonitor = NULL;
+    }
+    this->hotPlugCallback = NULL;
+    this->hotPlugUserData = NULL;
+}
+
+int SeaBreezeAPI_Impl::setDescriptorCacheFile(const char *path, int *errorCode) {
+    /* Devices use the cache while holding the list lock for reading */
+    WriteLock guard(this->deviceListLock);
+
+    delete this->descriptorCache;
+    this->descriptorCache = NULL;
+
+    if(NULL == path || '\0' == path[0]) {
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return 0;
+    }
+
+    DeviceDescriptorCache *cache = new DeviceDescriptorCache(path);
+    if(false == cache->load()) {
+        delete cache;
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return -1;
+    }
+
+    this->descriptorCache = cache;
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return 0;
+}
+
+void SeaBreezeAPI_Impl::usbHotPlugEvent(const USBHotPlugEvent &event) {
+    vector<long> before;
+    vector<long> after;
+    vector<DeviceAdapter *>::iterator iter;
+    unsigned int i;
+
+    /* Events for unrelated hardware can be ignored.  An event that does not
+     * say which device it was for is always assumed to be relevant.
+     */
+    if(0 != event.vendorID || 0 != event.productID) {
+        bool supported = false;
+        for(i = 0; i < this->usbProbeFilters.size(); i++) {
+            if(this->usbProbeFilters[i].vendorID == event.vendorID
+                    && this->usbProbeFilters[i].productID == event.productID) {
+                supported = true;
+                break;
+            }
+        }
+        if(false == supported) {
+            return;
+        }
+    }
+
+    {
+        WriteLock guard(this->deviceListLock);
+
+        for(iter = this->probedDevices.begin(); iter != this->probedDevices.end(); iter++) {
+            before.push_back((*iter)->getID());
+        }
+        for(iter = this->specifiedDevices.begin(); iter != this->specifiedDevices.end(); iter++) {
+            before.push_back((*iter)->getID());
+        }
+
+        /* The rescan only creates or destroys adapters for devices that
+         * actually changed.
+         */
+        probeDevicesLocked();
+
+        for(iter = this->probedDevices.begin(); iter != this->probedDevices.end(); iter++) {
+            after.push_back((*iter)->getID());
+        }
+        for(iter = this->specifiedDevices.begin(); iter != this->specifiedDevices.end(); iter++) {
+            after.push_back((*iter)->getID());
+        }
+    }
+
+    /* The callback is made without holding the lock so that it is free to
+     * use the rest of the API.
+     */
+    if(NULL == this->hotPlugCallback) {
+        return;
+    }
+
+    for(i = 0; i < before.size(); i++) {
+        if(find(after.begin(), after.end(), before[i]) == after.end()) {
+            this->hotPlugCallback(before[i], SBAPI_DEVICE_REMOVED, this->hotPlugUserData);
+        }
+    }
+
+    for(i = 0; i < after.size(); i++) {
+        if(find(before.begin(), before.end(), after[i]) == before.end()) {
+            this->hotPlugCallback(after[i], SBAPI_DEVICE_ADDED, this->hotPlugUserData);
+        }
+    }
+}
+
 int SeaBreezeAPI_Impl::addTCPIPv4DeviceLocation(char *deviceTypeName, char *ipAddr,
         int port) {
     string address(ipAddr);
@@ -214,6 +473,7 @@ int SeaBreezeAPI_Impl::addTCPIPv4DeviceLocation(char *deviceTypeName, char *ipAd
     dev->setLocation(locator);
 
     try {
+        WriteLock guard(this->deviceListLock);
         /* Note that this pre-increments the device ID to mitigate any race conditions */
         this->specifiedDevices.push_back(new DeviceAdapter(dev, ++__deviceID));
     } catch (IllegalArgumentException &iae) {
@@ -238,6 +498,7 @@ int SeaBreezeAPI_Impl::addRS232DeviceLocation(char *deviceTypeName,
     dev->setLocation(locator);
 
     try {
+        WriteLock guard(this->deviceListLock);
         /* Note that this pre-increments the device ID to mitigate any race conditions */
         this->specifiedDevices.push_back(new DeviceAdapter(dev, ++__deviceID));
     } catch (IllegalArgumentException &iae) {
@@ -250,6 +511,8 @@ int SeaBreezeAPI_Impl::addRS232DeviceLocation(char *deviceTypeName,
 
 
 int SeaBreezeAPI_Impl::getNumberOfDeviceIDs() {
+    ReadLock guard(this->deviceListLock);
+
     return (int) (this->specifiedDevices.size() + this->probedDevices.size());
 }
 
@@ -259,6 +522,8 @@ int SeaBreezeAPI_Impl::getDeviceIDs(long *ids, unsigned long maxLength) {
     vector<DeviceAdapter *>::iterator iter;
     unsigned int i = 0;
 
+    ReadLock guard(this->deviceListLock);
+
     for(    iter = specifiedDevices.begin();
             iter != specifiedDevices.end() && i < maxLength;
             iter++, i++) {
@@ -276,20 +541,24 @@ int SeaBreezeAPI_Impl::getDeviceIDs(long *ids, unsigned long maxLength) {
     return i;
 }
 
-DeviceAdapter *SeaBreezeAPI_Impl::getDeviceByID(unsigned long id) {
+DeviceAdapter *SeaBreezeAPI_Impl::retainDeviceByID(unsigned long id) {
     vector<DeviceAdapter *>::iterator iter;
 
+    ReadLock guard(this->deviceListLock);
+
     /* This gives priority to specified devices since they require more specific
      * information to set up.
      */
     for(iter = specifiedDevices.begin(); iter != specifiedDevices.end(); iter++) {
         if((*iter)->getID() == id) {
+            (*iter)->retain();
             return *iter;
         }
     }
 
     for(iter = probedDevices.begin(); iter != probedDevices.end(); iter++) {
         if((*iter)->getID() == id) {
+            (*iter)->retain();
             return *iter;
         }
     }
@@ -297,34 +566,102 @@ DeviceAdapter *SeaBreezeAPI_Impl::getDeviceByID(unsigned long id) {
     return NULL;
 }
 
+void SeaBreezeAPI_Impl::releaseDevice(DeviceAdapter *adapter) {
+    if(true == adapter->release()) {
+        /* The device was removed from the lists while this was using it.
+         * Deleting it also stops any stream that was left running.
+         */
+        delete adapter;
+    }
+}
+
+void SeaBreezeAPI_Impl::retireDevice(DeviceAdapter *adapter) {
+    if(true == adapter->retire()) {
+        delete adapter;
+    }
+}
+
+SeaBreezeAPI_Impl::DeviceGuard::DeviceGuard(SeaBreezeAPI_Impl *api,
+        unsigned long id, bool lockDevice) {
+    this->api = api;
+    this->locked = false;
+    this->adapter = api->retainDeviceByID(id);
+    if(NULL != this->adapter && true == lockDevice) {
+        this->adapter->getLock().lock();
+        this->locked = true;
+    }
+}
+
+SeaBreezeAPI_Impl::DeviceGuard::~DeviceGuard() {
+    if(NULL == this->adapter) {
+        return;
+    }
+    if(true == this->locked) {
+        this->adapter->getLock().unlock();
+    }
+    this->api->releaseDevice(this->adapter);
+}
+
+SeaBreezeAPI_Impl::DeviceGuard::operator DeviceAdapter *() const {
+    return this->adapter;
+}
+
+DeviceAdapter *SeaBreezeAPI_Impl::DeviceGuard::operator->() const {
+    return this->adapter;
+}
+
 /**************************************************************************************/
 //  Device Control  for the SeaBreeze API class
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::openDevice(long id, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(id);
+    DeviceGuard adapter(this, id, false);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return -1;
     }
 
-    return adapter->open(errorCode);
+    /* A stream left running would keep the device lock forever */
+    MutexLock streams(adapter->getStreamLock());
+    adapter->stopFastBufferStreams();
+
+    MutexLock device(adapter->getLock());
+    ReadLock list(this->deviceListLock);
+
+    return adapter->open(errorCode, this->descriptorCache);
 }
 
 void SeaBreezeAPI_Impl::closeDevice(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID, false);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
     }
 
+    MutexLock streams(adapter->getStreamLock());
+    adapter->stopFastBufferStreams();
+
+    MutexLock device(adapter->getLock());
+    ReadLock list(this->deviceListLock);
+
     adapter->close();
     SET_ERROR_CODE(ERROR_SUCCESS);
 }
 
+void SeaBreezeAPI_Impl::resyncDeviceSettings(long id, int *errorCode) {
+    DeviceGuard adapter(this, id);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->forgetSettings();
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
 int SeaBreezeAPI_Impl::getDeviceType(long id, int *errorCode,
             char *buffer, unsigned int length) {
-    DeviceAdapter *adapter = getDeviceByID(id);
+    DeviceGuard adapter(this, id);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -340,7 +677,7 @@ int SeaBreezeAPI_Impl::getDeviceType(long id, int *errorCode,
 
 unsigned char SeaBreezeAPI_Impl::getDeviceEndpoint(long id, int *errorCode, usbEndpointType endpoint) 
 {
-    DeviceAdapter *adapter = getDeviceByID(id);
+    DeviceGuard adapter(this, id);
     if(NULL == adapter) 
     {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -355,7 +692,7 @@ unsigned char SeaBreezeAPI_Impl::getDeviceEndpoint(long id, int *errorCode, usbE
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfRawUSBBusAccessFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -367,7 +704,7 @@ int SeaBreezeAPI_Impl::getNumberOfRawUSBBusAccessFeatures(long deviceID, int *er
 
 int SeaBreezeAPI_Impl::getRawUSBBusAccessFeatures(long deviceID, int *errorCode,
             long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -379,7 +716,7 @@ int SeaBreezeAPI_Impl::getRawUSBBusAccessFeatures(long deviceID, int *errorCode,
 
 int SeaBreezeAPI_Impl::rawUSBBusAccessRead(long deviceID, long featureID,
         int *errorCode, unsigned char *buffer, unsigned int bufferLength, unsigned char endpoint) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -390,7 +727,7 @@ int SeaBreezeAPI_Impl::rawUSBBusAccessRead(long deviceID, long featureID,
 
 int SeaBreezeAPI_Impl::rawUSBBusAccessWrite(long deviceID, long featureID,
         int *errorCode, unsigned char *buffer, unsigned int bufferLength, unsigned char endpoint) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -407,7 +744,7 @@ int SeaBreezeAPI_Impl::rawUSBBusAccessWrite(long deviceID, long featureID,
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfSerialNumberFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -419,7 +756,7 @@ int SeaBreezeAPI_Impl::getNumberOfSerialNumberFeatures(long deviceID, int *error
 
 int SeaBreezeAPI_Impl::getSerialNumberFeatures(long deviceID, int *errorCode,
             long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -431,7 +768,7 @@ int SeaBreezeAPI_Impl::getSerialNumberFeatures(long deviceID, int *errorCode,
 
 int SeaBreezeAPI_Impl::getSerialNumber(long deviceID, long featureID, int *errorCode,
             char *buffer, int bufferLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -441,7 +778,7 @@ int SeaBreezeAPI_Impl::getSerialNumber(long deviceID, long featureID, int *error
 }
 
 unsigned char SeaBreezeAPI_Impl::getSerialNumberMaximumLength(long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -455,7 +792,7 @@ unsigned char SeaBreezeAPI_Impl::getSerialNumberMaximumLength(long deviceID, lon
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfSpectrometerFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -467,7 +804,7 @@ int SeaBreezeAPI_Impl::getNumberOfSpectrometerFeatures(long deviceID, int *error
 
 int SeaBreezeAPI_Impl::getSpectrometerFeatures(long deviceID, int *errorCode,
             long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -484,7 +821,7 @@ void SeaBreezeAPI_Impl::spectrometerSetTriggerMode(long deviceID, long featureID
 
     SpectrometerTriggerMode triggerMode(mode);
 
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -493,11 +830,24 @@ void SeaBreezeAPI_Impl::spectrometerSetTriggerMode(long deviceID, long featureID
     adapter->spectrometerSetTriggerMode(featureID, errorCode, mode);
 }
 
+void SeaBreezeAPI_Impl::spectrometerSetPrefetchEnable(long deviceID,
+            long featureID, int *errorCode, unsigned char prefetchEnable) {
+
+    DeviceGuard adapter(this, deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerSetPrefetchEnabled(featureID, errorCode,
+            0 != prefetchEnable);
+}
+
 
 void SeaBreezeAPI_Impl::spectrometerSetIntegrationTimeMicros(long deviceID,
         long featureID, int *errorCode,
         unsigned long integrationTimeMicros) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -509,7 +859,7 @@ void SeaBreezeAPI_Impl::spectrometerSetIntegrationTimeMicros(long deviceID,
 
 unsigned long SeaBreezeAPI_Impl::spectrometerGetMinimumIntegrationTimeMicros(
         long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -520,7 +870,7 @@ unsigned long SeaBreezeAPI_Impl::spectrometerGetMinimumIntegrationTimeMicros(
 
 unsigned long SeaBreezeAPI_Impl::spectrometerGetMaximumIntegrationTimeMicros(
         long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -531,7 +881,7 @@ unsigned long SeaBreezeAPI_Impl::spectrometerGetMaximumIntegrationTimeMicros(
 
 double SeaBreezeAPI_Impl::spectrometerGetMaximumIntensity(
         long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -540,9 +890,80 @@ double SeaBreezeAPI_Impl::spectrometerGetMaximumIntensity(
     return adapter->spectrometerGetMaximumIntensity(featureID, errorCode);
 }
 
+int SeaBreezeAPI_Impl::spectrometerStartFastBufferStream(long deviceID,
+        long featureID, int *errorCode, int capacity) {
+    DeviceGuard adapter(this, deviceID, false);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerStartFastBufferStream(featureID, errorCode,
+            capacity);
+}
+
+int SeaBreezeAPI_Impl::spectrometerReadFastBufferStream(long deviceID,
+        long featureID, int *errorCode, unsigned char *buffer, int bufferLength) {
+    DeviceGuard adapter(this, deviceID, false);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerReadFastBufferStream(featureID, errorCode,
+            buffer, bufferLength);
+}
+
+void SeaBreezeAPI_Impl::spectrometerStopFastBufferStream(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceGuard adapter(this, deviceID, false);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerStopFastBufferStream(featureID, errorCode);
+}
+
+unsigned int SeaBreezeAPI_Impl::spectrometerGetFastBufferStreamOverruns(
+        long deviceID, long featureID, int *errorCode) {
+    DeviceGuard adapter(this, deviceID, false);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetFastBufferStreamOverruns(featureID, errorCode);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetFastBufferSpectrumLength(long deviceID,
+        long featureID, int *errorCode) {
+    DeviceGuard adapter(this, deviceID, false);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetFastBufferSpectrumLength(featureID, errorCode);
+}
+
+int SeaBreezeAPI_Impl::spectrometerDecodeFastBufferSpectra(long deviceID,
+        long featureID, int *errorCode, const unsigned char *buffer,
+        int bufferLength, sbapi_spectrum_metadata_t *metadata,
+        unsigned char *valid, int maxSpectra) {
+    DeviceGuard adapter(this, deviceID, false);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerDecodeFastBufferSpectra(featureID, errorCode,
+            buffer, bufferLength, metadata, valid, maxSpectra);
+}
+
 int SeaBreezeAPI_Impl::spectrometerGetFastBufferSpectrum(long deviceID,
 	long featureID, int *errorCode, unsigned char *buffer, int bufferLength, unsigned int numberOfSamplesToRetrieve) {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -555,7 +976,7 @@ int SeaBreezeAPI_Impl::spectrometerGetFastBufferSpectrum(long deviceID,
 void SeaBreezeAPI_Impl::spectrometerFastBufferSpectrumRequest(long deviceID,
                                                          long featureID, int *errorCode, unsigned int numberOfSamplesToRetrieve)
 {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if (NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -567,7 +988,7 @@ void SeaBreezeAPI_Impl::spectrometerFastBufferSpectrumRequest(long deviceID,
 int SeaBreezeAPI_Impl::spectrometerFastBufferSpectrumResponse(long deviceID,
                                                          long featureID, int *errorCode, unsigned char *buffer, int bufferLength, unsigned int numberOfSamplesToRetrieve)
 {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if (NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -578,7 +999,7 @@ int SeaBreezeAPI_Impl::spectrometerFastBufferSpectrumResponse(long deviceID,
 
 int SeaBreezeAPI_Impl::spectrometerGetUnformattedSpectrum(long deviceID,
         long featureID, int *errorCode, unsigned char *buffer, int bufferLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -590,7 +1011,7 @@ int SeaBreezeAPI_Impl::spectrometerGetUnformattedSpectrum(long deviceID,
 
 int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrum(long deviceID,
         long featureID, int *errorCode, double *buffer, int bufferLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -600,9 +1021,70 @@ int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrum(long deviceID,
             buffer, bufferLength);
 }
 
+int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrum(long deviceID,
+        long featureID, int *errorCode, float *buffer, int bufferLength) {
+    DeviceGuard adapter(this, deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetFormattedSpectrum(featureID, errorCode,
+            buffer, bufferLength);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrum(long deviceID,
+        long featureID, int *errorCode, unsigned short *buffer, int bufferLength) {
+    DeviceGuard adapter(this, deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetFormattedSpectrum(featureID, errorCode,
+            buffer, bufferLength);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrum(long deviceID,
+        long featureID, int *errorCode, unsigned int *buffer, int bufferLength) {
+    DeviceGuard adapter(this, deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetFormattedSpectrum(featureID, errorCode,
+            buffer, bufferLength);
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrumWithMetadata(long deviceID,
+        long featureID, int *errorCode, double *buffer, int bufferLength,
+        sbapi_spectrum_metadata_t *metadata) {
+    DeviceGuard adapter(this, deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerGetFormattedSpectrumWithMetadata(featureID,
+            errorCode, buffer, bufferLength, metadata);
+}
+
+void SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrumMetadata(long deviceID,
+        long featureID, int *errorCode, sbapi_spectrum_metadata_t *metadata) {
+    DeviceGuard adapter(this, deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return;
+    }
+
+    adapter->spectrometerGetFormattedSpectrumMetadata(featureID, errorCode,
+            metadata);
+}
+
 int SeaBreezeAPI_Impl::spectrometerGetUnformattedSpectrumLength(long deviceID,
         long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -613,7 +1095,7 @@ int SeaBreezeAPI_Impl::spectrometerGetUnformattedSpectrumLength(long deviceID,
 
 int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrumLength(long deviceID,
         long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -624,7 +1106,7 @@ int SeaBreezeAPI_Impl::spectrometerGetFormattedSpectrumLength(long deviceID,
 
 int SeaBreezeAPI_Impl::spectrometerGetWavelengths(long deviceID,
         long featureID, int *errorCode, double *wavelengths, int length) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -636,7 +1118,7 @@ int SeaBreezeAPI_Impl::spectrometerGetWavelengths(long deviceID,
 
 int SeaBreezeAPI_Impl::spectrometerGetElectricDarkPixelCount(long deviceID,
         long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -647,7 +1129,7 @@ int SeaBreezeAPI_Impl::spectrometerGetElectricDarkPixelCount(long deviceID,
 
 int SeaBreezeAPI_Impl::spectrometerGetElectricDarkPixelIndices(long deviceID,
         long featureID, int *errorCode, int *indices, int length) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -657,12 +1139,362 @@ int SeaBreezeAPI_Impl::spectrometerGetElectricDarkPixelIndices(long deviceID,
                 indices, length);
 }
 
+int SeaBreezeAPI_Impl::spectrometerAcquireFrame(long deviceID, long featureID,
+        int *errorCode, sbapi_frame_t *frame) {
+    DeviceGuard adapter(this, deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    return adapter->spectrometerAcquireFrame(featureID, errorCode, frame);
+}
+
+SpectrometerSession *SeaBreezeAPI_Impl::retainSessionByID(long id) {
+    ReadLock guard(this->sessionListLock);
+
+    map<long, SpectrometerSession *>::iterator iter = this->sessions.find(id);
+    if(iter == this->sessions.end()) {
+        return NULL;
+    }
+    iter->second->retain();
+    return iter->second;
+}
+
+void SeaBreezeAPI_Impl::releaseSession(SpectrometerSession *session) {
+    if(true == session->release()) {
+        /* The session was closed while this was using it */
+        deleteSession(session);
+    }
+}
+
+void SeaBreezeAPI_Impl::deleteSession(SpectrometerSession *session) {
+    DeviceAdapter *adapter = session->getDevice();
+    delete session;
+    releaseDevice(adapter);
+}
+
+long SeaBreezeAPI_Impl::spectrometerOpenSession(long deviceID, long featureID,
+        int *errorCode) {
+    DeviceAdapter *adapter = retainDeviceByID(deviceID);
+    if(NULL == adapter) {
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    /* The session keeps the reference taken above */
+    SpectrometerSession *session = new SpectrometerSession(adapter, featureID);
+    if(false == session->prepare(errorCode)) {
+        deleteSession(session);
+        return 0;
+    }
+
+    WriteLock guard(this->sessionListLock);
+    long sessionID = this->nextSessionID++;
+    this->sessions[sessionID] = session;
+    return sessionID;
+}
+
+void SeaBreezeAPI_Impl::spectrometerCloseSession(long sessionID, int *errorCode) {
+    SpectrometerSession *session;
+
+    {
+        WriteLock guard(this->sessionListLock);
+        map<long, SpectrometerSession *>::iterator iter = this->sessions.find(sessionID);
+        if(iter == this->sessions.end()) {
+            SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+            return;
+        }
+        session = iter->second;
+        this->sessions.erase(iter);
+    }
+
+    if(true == session->retire()) {
+        deleteSession(session);
+    }
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+int SeaBreezeAPI_Impl::spectrometerSessionGetUnformattedSpectrum(long sessionID,
+        int *errorCode, unsigned char *buffer, int bufferLength) {
+    SpectrometerSession *session = retainSessionByID(sessionID);
+    if(NULL == session) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return 0;
+    }
+
+    int length = session->getUnformattedSpectrum(errorCode, buffer, bufferLength);
+    releaseSession(session);
+    return length;
+}
+
+int SeaBreezeAPI_Impl::spectrometerSessionGetFormattedSpectrum(long sessionID,
+        int *errorCode, double *buffer, int bufferLength) {
+    SpectrometerSession *session = retainSessionByID(sessionID);
+    if(NULL == session) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return 0;
+    }
+
+    int length = session->getFormattedSpectrum(errorCode, buffer, bufferLength);
+    releaseSession(session);
+    return length;
+}
+
+int SeaBreezeAPI_Impl::spectrometerSessionGetFormattedSpectrum(long sessionID,
+        int *errorCode, float *buffer, int bufferLength) {
+    SpectrometerSession *session = retainSessionByID(sessionID);
+    if(NULL == session) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return 0;
+    }
+
+    int length = session->getFormattedSpectrum(errorCode, buffer, bufferLength);
+    releaseSession(session);
+    return length;
+}
+
+int SeaBreezeAPI_Impl::spectrometerSessionGetFormattedSpectrum(long sessionID,
+        int *errorCode, unsigned short *buffer, int bufferLength) {
+    SpectrometerSession *session = retainSessionByID(sessionID);
+    if(NULL == session) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return 0;
+    }
+
+    int length = session->getFormattedSpectrum(errorCode, buffer, bufferLength);
+    releaseSession(session);
+    return length;
+}
+
+int SeaBreezeAPI_Impl::spectrometerSessionGetFormattedSpectrum(long sessionID,
+        int *errorCode, unsigned int *buffer, int bufferLength) {
+    SpectrometerSession *session = retainSessionByID(sessionID);
+    if(NULL == session) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return 0;
+    }
+
+    int length = session->getFormattedSpectrum(errorCode, buffer, bufferLength);
+    releaseSession(session);
+    return length;
+}
+
+long SeaBreezeAPI_Impl::allocateAcquisitionID() {
+    MutexLock guard(this->acquisitionLock);
+    return this->nextAcquisitionID++;
+}
+
+long SeaBreezeAPI_Impl::submitAcquisition(long deviceID,
+        AcquisitionRequest *request, int *errorCode) {
+    /* The worker takes the device's lock itself, so this never has to
+     * wait for an acquisition that is already in progress.
+     */
+    DeviceGuard adapter(this, deviceID, false);
+    if(NULL == adapter) {
+        delete request;
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    /* A request with a callback may be gone as soon as it is submitted */
+    long requestID = request->getID();
+    bool tracked = !request->hasCallback();
+
+    if(true == tracked) {
+        MutexLock guard(this->acquisitionLock);
+        this->acquisitions[requestID] = request;
+    }
+
+    if(false == adapter->submitAcquisition(request)) {
+        if(true == tracked) {
+            MutexLock guard(this->acquisitionLock);
+            this->acquisitions.erase(requestID);
+        }
+        delete request;
+        SET_ERROR_CODE(ERROR_NO_DEVICE);
+        return 0;
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return requestID;
+}
+
+long SeaBreezeAPI_Impl::spectrometerSubmitFormattedSpectrum(long deviceID,
+        long featureID, int *errorCode, double *buffer, int bufferLength,
+        sbapi_acquisition_callback callback, void *userData) {
+    AcquisitionRequest *request = new AcquisitionRequest(
+            allocateAcquisitionID(), featureID, buffer, bufferLength,
+            callback, userData);
+
+    return submitAcquisition(deviceID, request, errorCode);
+}
+
+long SeaBreezeAPI_Impl::spectrometerSubmitUnformattedSpectrum(long deviceID,
+        long featureID, int *errorCode, unsigned char *buffer,
+        int bufferLength, sbapi_acquisition_callback callback,
+        void *userData) {
+    AcquisitionRequest *request = new AcquisitionRequest(
+            allocateAcquisitionID(), featureID, buffer, bufferLength,
+            callback, userData);
+
+    return submitAcquisition(deviceID, request, errorCode);
+}
+
+AcquisitionRequest *SeaBreezeAPI_Impl::retainAcquisitionByID(long id) {
+    MutexLock guard(this->acquisitionLock);
+
+    map<long, AcquisitionRequest *>::iterator iter = this->acquisitions.find(id);
+    if(this->acquisitions.end() == iter) {
+        return NULL;
+    }
+    iter->second->retain();
+    return iter->second;
+}
+
+void SeaBreezeAPI_Impl::releaseAcquisition(AcquisitionRequest *request) {
+    if(true == request->release()) {
+        /* The result was collected while this was waiting */
+        delete request;
+    }
+}
+
+int SeaBreezeAPI_Impl::spectrometerWaitAcquisition(long requestID,
+        int *errorCode, int timeoutMillis) {
+    AcquisitionRequest *request = retainAcquisitionByID(requestID);
+    if(NULL == request) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return 0;
+    }
+
+    bool completed = request->wait(timeoutMillis);
+    releaseAcquisition(request);
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (true == completed) ? 1 : 0;
+}
+
+int SeaBreezeAPI_Impl::spectrometerGetAcquisitionResult(long requestID,
+        int *errorCode) {
+    AcquisitionRequest *request;
+
+    {
+        MutexLock guard(this->acquisitionLock);
+        map<long, AcquisitionRequest *>::iterator iter
+                = this->acquisitions.find(requestID);
+        if(this->acquisitions.end() == iter) {
+            SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+            return 0;
+        }
+        request = iter->second;
+        this->acquisitions.erase(iter);
+    }
+
+    int length = request->getResult(errorCode);
+    if(true == request->retire()) {
+        delete request;
+    }
+    return length;
+}
+
+AcquisitionGroup *SeaBreezeAPI_Impl::retainGroupByID(long id) {
+    ReadLock guard(this->groupListLock);
+
+    map<long, AcquisitionGroup *>::iterator iter = this->groups.find(id);
+    if(iter == this->groups.end()) {
+        return NULL;
+    }
+    iter->second->retain();
+    return iter->second;
+}
+
+void SeaBreezeAPI_Impl::releaseGroup(AcquisitionGroup *group) {
+    if(true == group->release()) {
+        /* The group was destroyed while this was using it */
+        deleteGroup(group);
+    }
+}
+
+void SeaBreezeAPI_Impl::deleteGroup(AcquisitionGroup *group) {
+    vector<DeviceAdapter *> devices = group->getDevices();
+    delete group;
+
+    vector<DeviceAdapter *>::iterator iter;
+    for(iter = devices.begin(); iter != devices.end(); iter++) {
+        releaseDevice(*iter);
+    }
+}
+
+long SeaBreezeAPI_Impl::createAcquisitionGroup(const long *deviceIDs,
+        const long *featureIDs, int count, int *errorCode) {
+    if(NULL == deviceIDs || NULL == featureIDs || count <= 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    AcquisitionGroup *group = new AcquisitionGroup();
+    for(int i = 0; i < count; i++) {
+        DeviceAdapter *adapter = retainDeviceByID(deviceIDs[i]);
+        if(NULL == adapter) {
+            deleteGroup(group);
+            SET_ERROR_CODE(ERROR_NO_DEVICE);
+            return 0;
+        }
+
+        /* The group keeps the reference taken above once it is a member */
+        if(false == group->addMember(adapter, featureIDs[i], errorCode)) {
+            releaseDevice(adapter);
+            deleteGroup(group);
+            return 0;
+        }
+    }
+
+    WriteLock guard(this->groupListLock);
+    long groupID = this->nextGroupID++;
+    this->groups[groupID] = group;
+    return groupID;
+}
+
+void SeaBreezeAPI_Impl::destroyAcquisitionGroup(long groupID, int *errorCode) {
+    AcquisitionGroup *group;
+
+    {
+        WriteLock guard(this->groupListLock);
+        map<long, AcquisitionGroup *>::iterator iter = this->groups.find(groupID);
+        if(iter == this->groups.end()) {
+            SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+            return;
+        }
+        group = iter->second;
+        this->groups.erase(iter);
+    }
+
+    if(true == group->retire()) {
+        deleteGroup(group);
+    }
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+int SeaBreezeAPI_Impl::acquisitionGroupGetFormattedSpectra(long groupID,
+        int *errorCode, double *buffer, int pixelsPerSpectrum,
+        sbapi_group_spectrum_t *results, int maxResults) {
+    AcquisitionGroup *group = retainGroupByID(groupID);
+    if(NULL == group) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return 0;
+    }
+
+    int count = group->getFormattedSpectra(errorCode, buffer, pixelsPerSpectrum,
+            results, maxResults);
+    releaseGroup(group);
+    return count;
+}
+
 /**************************************************************************************/
 //  Pixel binning features for the SeaBreeze API class
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfPixelBinningFeatures(long id, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(id);
+    DeviceGuard adapter(this, id);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -673,7 +1505,7 @@ int SeaBreezeAPI_Impl::getNumberOfPixelBinningFeatures(long id, int *errorCode)
 }
 
 int SeaBreezeAPI_Impl::getPixelBinningFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -684,7 +1516,7 @@ int SeaBreezeAPI_Impl::getPixelBinningFeatures(long deviceID, int *errorCode, lo
 }
 
 void SeaBreezeAPI_Impl::binningSetPixelBinningFactor(long deviceID, long featureID, int *errorCode, const unsigned char binningFactor) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
     }
@@ -693,7 +1525,7 @@ void SeaBreezeAPI_Impl::binningSetPixelBinningFactor(long deviceID, long feature
 }
 
 unsigned char SeaBreezeAPI_Impl::binningGetPixelBinningFactor(long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -703,7 +1535,7 @@ unsigned char SeaBreezeAPI_Impl::binningGetPixelBinningFactor(long deviceID, lon
 }
 
 void SeaBreezeAPI_Impl::binningSetDefaultPixelBinningFactor(long deviceID, long featureID, int *errorCode, const unsigned char binningFactor) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
     }
@@ -712,7 +1544,7 @@ void SeaBreezeAPI_Impl::binningSetDefaultPixelBinningFactor(long deviceID, long
 }
 
 void SeaBreezeAPI_Impl::binningSetDefaultPixelBinningFactor(long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
     }
@@ -721,7 +1553,7 @@ void SeaBreezeAPI_Impl::binningSetDefaultPixelBinningFactor(long deviceID, long
 }
 
 unsigned char SeaBreezeAPI_Impl::binningGetDefaultPixelBinningFactor(long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -731,7 +1563,7 @@ unsigned char SeaBreezeAPI_Impl::binningGetDefaultPixelBinningFactor(long device
 }
 
 unsigned char SeaBreezeAPI_Impl::binningGetMaxPixelBinningFactor(long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -745,7 +1577,7 @@ unsigned char SeaBreezeAPI_Impl::binningGetMaxPixelBinningFactor(long deviceID,
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfThermoElectricFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -757,7 +1589,7 @@ int SeaBreezeAPI_Impl::getNumberOfThermoElectricFeatures(long deviceID, int *err
 
 int SeaBreezeAPI_Impl::getThermoElectricFeatures(long deviceID, int *errorCode,
             long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -770,7 +1602,7 @@ int SeaBreezeAPI_Impl::getThermoElectricFeatures(long deviceID, int *errorCode,
 
 double SeaBreezeAPI_Impl::tecReadTemperatureDegreesC(long deviceID,
         long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -781,7 +1613,7 @@ double SeaBreezeAPI_Impl::tecReadTemperatureDegreesC(long deviceID,
 
 void SeaBreezeAPI_Impl::tecSetTemperatureSetpointDegreesC(long deviceID, long featureID,
         int *errorCode, double temperatureDegreesCelsius) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -793,7 +1625,7 @@ void SeaBreezeAPI_Impl::tecSetTemperatureSetpointDegreesC(long deviceID, long fe
 
 void SeaBreezeAPI_Impl::tecSetEnable(long deviceID, long featureID, int *errorCode,
         unsigned char tecEnable) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -808,7 +1640,7 @@ void SeaBreezeAPI_Impl::tecSetEnable(long deviceID, long featureID, int *errorCo
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfIrradCalFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -820,7 +1652,7 @@ int SeaBreezeAPI_Impl::getNumberOfIrradCalFeatures(long deviceID, int *errorCode
 
 int SeaBreezeAPI_Impl::getIrradCalFeatures(long deviceID, int *errorCode,
             long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -832,7 +1664,7 @@ int SeaBreezeAPI_Impl::getIrradCalFeatures(long deviceID, int *errorCode,
 
 int SeaBreezeAPI_Impl::irradCalibrationRead(long deviceID, long featureID,
         int *errorCode, float *buffer, int bufferLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -843,7 +1675,7 @@ int SeaBreezeAPI_Impl::irradCalibrationRead(long deviceID, long featureID,
 
 int SeaBreezeAPI_Impl::irradCalibrationWrite(long deviceID, long featureID,
         int *errorCode, float *buffer, int bufferLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -854,7 +1686,7 @@ int SeaBreezeAPI_Impl::irradCalibrationWrite(long deviceID, long featureID,
 
 int SeaBreezeAPI_Impl::irradCalibrationHasCollectionArea(long deviceID,
         long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -865,7 +1697,7 @@ int SeaBreezeAPI_Impl::irradCalibrationHasCollectionArea(long deviceID,
 
 float SeaBreezeAPI_Impl::irradCalibrationReadCollectionArea(long deviceID,
         long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -876,7 +1708,7 @@ float SeaBreezeAPI_Impl::irradCalibrationReadCollectionArea(long deviceID,
 
 void SeaBreezeAPI_Impl::irradCalibrationWriteCollectionArea(long deviceID, long featureID,
         int *errorCode, float area) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -892,7 +1724,7 @@ void SeaBreezeAPI_Impl::irradCalibrationWriteCollectionArea(long deviceID, long
 
 int SeaBreezeAPI_Impl::getNumberOfEthernetConfigurationFeatures(long deviceID, int *errorCode) 
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) 
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -905,7 +1737,7 @@ int SeaBreezeAPI_Impl::getNumberOfEthernetConfigurationFeatures(long deviceID, i
 
 int SeaBreezeAPI_Impl::getEthernetConfigurationFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength) 
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) 
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -918,7 +1750,7 @@ int SeaBreezeAPI_Impl::getEthernetConfigurationFeatures(long deviceID, int *erro
 
 void SeaBreezeAPI_Impl::ethernetConfiguration_Get_MAC_Address(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char (*macAddress)[6]) 
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->ethernetConfiguration_Get_MAC_Address(featureID, errorCode, interfaceIndex, macAddress);
@@ -932,7 +1764,7 @@ void SeaBreezeAPI_Impl::ethernetConfiguration_Get_MAC_Address(long deviceID, lon
 
 void SeaBreezeAPI_Impl::ethernetConfiguration_Set_MAC_Address(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, const unsigned char macAddress[6]) 
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->ethernetConfiguration_Set_MAC_Address(featureID, errorCode, interfaceIndex, macAddress);
@@ -945,7 +1777,7 @@ void SeaBreezeAPI_Impl::ethernetConfiguration_Set_MAC_Address(long deviceID, lon
 
 unsigned char SeaBreezeAPI_Impl::ethernetConfiguration_Get_GbE_Enable_Status(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -956,7 +1788,7 @@ unsigned char SeaBreezeAPI_Impl::ethernetConfiguration_Get_GbE_Enable_Status(lon
 
 void SeaBreezeAPI_Impl::ethernetConfiguration_Set_GbE_Enable_Status(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char enableState) 
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) 
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -978,7 +1810,7 @@ void SeaBreezeAPI_Impl::ethernetConfiguration_Set_GbE_Enable_Status(long deviceI
 
 int SeaBreezeAPI_Impl::getNumberOfGPIOFeatures(long deviceID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -991,7 +1823,7 @@ int SeaBreezeAPI_Impl::getNumberOfGPIOFeatures(long deviceID, int *errorCode)
 
 int SeaBreezeAPI_Impl::getGPIOFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1005,7 +1837,7 @@ int SeaBreezeAPI_Impl::getGPIOFeatures(long deviceID, int *errorCode, long *buff
 
 unsigned char SeaBreezeAPI_Impl::getGPIO_NumberOfPins(long deviceID, long featureID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1016,7 +1848,7 @@ unsigned char SeaBreezeAPI_Impl::getGPIO_NumberOfPins(long deviceID, long featur
 
 unsigned int SeaBreezeAPI_Impl::getGPIO_OutputEnableVector(long deviceID, long featureID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1028,7 +1860,7 @@ unsigned int SeaBreezeAPI_Impl::getGPIO_OutputEnableVector(long deviceID, long f
 
 void SeaBreezeAPI_Impl::setGPIO_OutputEnableVector(long deviceID, long featureID, int *errorCode, unsigned int outputEnableVector, unsigned int bitMask)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1040,7 +1872,7 @@ void SeaBreezeAPI_Impl::setGPIO_OutputEnableVector(long deviceID, long featureID
 
 unsigned int SeaBreezeAPI_Impl::getGPIO_ValueVector(long deviceID, long featureID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1052,7 +1884,7 @@ unsigned int SeaBreezeAPI_Impl::getGPIO_ValueVector(long deviceID, long featureI
 
 void SeaBreezeAPI_Impl::setGPIO_ValueVector(long deviceID, long featureID, int *errorCode, unsigned int valueVector, unsigned int bitMask)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1065,7 +1897,7 @@ void SeaBreezeAPI_Impl::setGPIO_ValueVector(long deviceID, long featureID, int *
 
 unsigned char SeaBreezeAPI_Impl::getEGPIO_NumberOfPins(long deviceID, long featureID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1079,7 +1911,7 @@ unsigned char SeaBreezeAPI_Impl::getEGPIO_AvailableModes(long deviceID, long fea
 {
 	unsigned char arraySize = 0;
 
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		arraySize = adapter->gpioExtensionGetAvailableModes(featureID, errorCode, pinNumber, availableModes, maximumModeCount);
@@ -1094,7 +1926,7 @@ unsigned char SeaBreezeAPI_Impl::getEGPIO_AvailableModes(long deviceID, long fea
 
 unsigned char SeaBreezeAPI_Impl::getEGPIO_CurrentMode(long deviceID, long featureID, int *errorCode, unsigned char pinNumber)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1105,7 +1937,7 @@ unsigned char SeaBreezeAPI_Impl::getEGPIO_CurrentMode(long deviceID, long featur
 
 void SeaBreezeAPI_Impl::setEGPIO_Mode(long deviceID, long featureID, int *errorCode, unsigned char pinNumber, unsigned char mode, float value)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1117,7 +1949,7 @@ void SeaBreezeAPI_Impl::setEGPIO_Mode(long deviceID, long featureID, int *errorC
 
 unsigned int SeaBreezeAPI_Impl::getEGPIO_OutputVector(long deviceID, long featureID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1128,7 +1960,7 @@ unsigned int SeaBreezeAPI_Impl::getEGPIO_OutputVector(long deviceID, long featur
 
 void SeaBreezeAPI_Impl::setEGPIO_OutputVector(long deviceID, long featureID, int *errorCode, unsigned int outputVector, unsigned int bitMask)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1140,7 +1972,7 @@ void SeaBreezeAPI_Impl::setEGPIO_OutputVector(long deviceID, long featureID, int
 
 float SeaBreezeAPI_Impl::getEGPIO_Value(long deviceID, long featureID, int *errorCode, unsigned char pinNumber)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1151,7 +1983,7 @@ float SeaBreezeAPI_Impl::getEGPIO_Value(long deviceID, long featureID, int *erro
 
 void SeaBreezeAPI_Impl::setEGPIO_Value(long deviceID, long featureID, int *errorCode, unsigned char pinNumber, float value)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1178,7 +2010,7 @@ void SeaBreezeAPI_Impl::setEGPIO_Value(long deviceID, long featureID, int *error
 
 int SeaBreezeAPI_Impl::getNumberOfMulticastFeatures(long deviceID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1191,7 +2023,7 @@ int SeaBreezeAPI_Impl::getNumberOfMulticastFeatures(long deviceID, int *errorCod
 
 int SeaBreezeAPI_Impl::getMulticastFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1205,7 +2037,7 @@ int SeaBreezeAPI_Impl::getMulticastFeatures(long deviceID, int *errorCode, long
 #if(false) // not yet implemented
 void SeaBreezeAPI_Impl::getMulticastGroupAddress(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char(&groupAddress)[4])
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->getMulticastGroupAddress(featureID, errorCode, interfaceIndex, groupAddress);
@@ -1219,7 +2051,7 @@ void SeaBreezeAPI_Impl::getMulticastGroupAddress(long deviceID, long featureID,
 
 void SeaBreezeAPI_Impl::setMulticastGroupAddress(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, const unsigned char groupAddress[4])
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->setMulticastGroupAddress(featureID, errorCode, interfaceIndex, groupAddress);
@@ -1233,7 +2065,7 @@ void SeaBreezeAPI_Impl::setMulticastGroupAddress(long deviceID, long featureID,
 
 unsigned char SeaBreezeAPI_Impl::getMulticastEnableState(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1244,7 +2076,7 @@ unsigned char SeaBreezeAPI_Impl::getMulticastEnableState(long deviceID, long fea
 
 void SeaBreezeAPI_Impl::setMulticastEnableState(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char enableState)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1265,7 +2097,7 @@ void SeaBreezeAPI_Impl::setMulticastEnableState(long deviceID, long featureID, i
 
 int SeaBreezeAPI_Impl::getNumberOfIPv4Features(long deviceID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1278,7 +2110,7 @@ int SeaBreezeAPI_Impl::getNumberOfIPv4Features(long deviceID, int *errorCode)
 
 int SeaBreezeAPI_Impl::getIPv4Features(long deviceID, int *errorCode, long *buffer,  int maxLength)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1291,7 +2123,7 @@ int SeaBreezeAPI_Impl::getIPv4Features(long deviceID, int *errorCode, long *buff
 
 unsigned char SeaBreezeAPI_Impl::get_IPv4_DHCP_Enable_State(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1302,7 +2134,7 @@ unsigned char SeaBreezeAPI_Impl::get_IPv4_DHCP_Enable_State(long deviceID, long
 
 void SeaBreezeAPI_Impl::set_IPv4_DHCP_Enable_State(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char enableState)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1314,7 +2146,7 @@ void SeaBreezeAPI_Impl::set_IPv4_DHCP_Enable_State(long deviceID, long featureID
 
 unsigned char SeaBreezeAPI_Impl::get_Number_Of_IPv4_Addresses(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1325,7 +2157,7 @@ unsigned char SeaBreezeAPI_Impl::get_Number_Of_IPv4_Addresses(long deviceID, lon
 
 void SeaBreezeAPI_Impl::get_IPv4_Default_Gateway(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char(*defaultGatewayAddress)[4])
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->get_IPv4_Default_Gateway(featureID, errorCode, interfaceIndex, defaultGatewayAddress);
@@ -1339,7 +2171,7 @@ void SeaBreezeAPI_Impl::get_IPv4_Default_Gateway(long deviceID, long featureID,
 
 void SeaBreezeAPI_Impl::set_IPv4_Default_Gateway(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, const unsigned char defaultGatewayAddress[4])
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->set_IPv4_Default_Gateway(featureID, errorCode, interfaceIndex, defaultGatewayAddress);
@@ -1352,7 +2184,7 @@ void SeaBreezeAPI_Impl::set_IPv4_Default_Gateway(long deviceID, long featureID,
 
 void SeaBreezeAPI_Impl::get_IPv4_Address(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char addressIndex, unsigned char(*IPv4_Address)[4], unsigned char *netMask)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->get_IPv4_Address(featureID, errorCode, interfaceIndex, addressIndex, IPv4_Address, netMask);
@@ -1366,7 +2198,7 @@ void SeaBreezeAPI_Impl::get_IPv4_Address(long deviceID, long featureID, int *err
 
 void SeaBreezeAPI_Impl::add_IPv4_Address(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, const unsigned char IPv4_Address[4], unsigned char netMask)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->add_IPv4_Address(featureID, errorCode, interfaceIndex, IPv4_Address, netMask);
@@ -1379,7 +2211,7 @@ void SeaBreezeAPI_Impl::add_IPv4_Address(long deviceID, long featureID, int *err
 
 void SeaBreezeAPI_Impl::delete_IPv4_Address(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char addressIndex)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->delete_IPv4_Address(featureID, errorCode, interfaceIndex, addressIndex);
@@ -1398,7 +2230,7 @@ void SeaBreezeAPI_Impl::delete_IPv4_Address(long deviceID, long featureID, int *
 
 int SeaBreezeAPI_Impl::getNumberOfWifiConfigurationFeatures(long deviceID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1411,7 +2243,7 @@ int SeaBreezeAPI_Impl::getNumberOfWifiConfigurationFeatures(long deviceID, int *
 
 int SeaBreezeAPI_Impl::getWifiConfigurationFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1424,7 +2256,7 @@ int SeaBreezeAPI_Impl::getWifiConfigurationFeatures(long deviceID, int *errorCod
 
 unsigned char SeaBreezeAPI_Impl::getWifiConfigurationMode(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1435,7 +2267,7 @@ unsigned char SeaBreezeAPI_Impl::getWifiConfigurationMode(long deviceID, long fe
 
 void SeaBreezeAPI_Impl::setWifiConfigurationMode(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char mode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1447,7 +2279,7 @@ void SeaBreezeAPI_Impl::setWifiConfigurationMode(long deviceID, long featureID,
 
 unsigned char SeaBreezeAPI_Impl::getWifiConfigurationSecurityType(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1458,7 +2290,7 @@ unsigned char SeaBreezeAPI_Impl::getWifiConfigurationSecurityType(long deviceID,
 
 void SeaBreezeAPI_Impl::setWifiConfigurationSecurityType(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char securityType)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1471,7 +2303,7 @@ void SeaBreezeAPI_Impl::setWifiConfigurationSecurityType(long deviceID, long fea
 
 unsigned char SeaBreezeAPI_Impl::getWifiConfigurationSSID(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char(*ssid)[32])
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		return adapter->wifiConfigurationGetSSID(featureID, errorCode, interfaceIndex, ssid);
@@ -1486,7 +2318,7 @@ unsigned char SeaBreezeAPI_Impl::getWifiConfigurationSSID(long deviceID, long fe
 
 void SeaBreezeAPI_Impl::setWifiConfigurationSSID(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, const unsigned char ssid[32], unsigned char length)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->wifiConfigurationSetSSID(featureID, errorCode, interfaceIndex, ssid, length);
@@ -1499,7 +2331,7 @@ void SeaBreezeAPI_Impl::setWifiConfigurationSSID(long deviceID, long featureID,
 
 void SeaBreezeAPI_Impl::setWifiConfigurationPassPhrase(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, const unsigned char *passPhrase, unsigned char passPhraseLength)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->wifiConfigurationSetPassPhrase(featureID, errorCode, interfaceIndex, passPhrase, passPhraseLength);
@@ -1517,7 +2349,7 @@ void SeaBreezeAPI_Impl::setWifiConfigurationPassPhrase(long deviceID, long featu
 
 int SeaBreezeAPI_Impl::getNumberOfDHCPServerFeatures(long deviceID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1530,7 +2362,7 @@ int SeaBreezeAPI_Impl::getNumberOfDHCPServerFeatures(long deviceID, int *errorCo
 
 int SeaBreezeAPI_Impl::getDHCPServerFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1543,7 +2375,7 @@ int SeaBreezeAPI_Impl::getDHCPServerFeatures(long deviceID, int *errorCode, long
 
 void SeaBreezeAPI_Impl::dhcpServerGetAddress(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char(*serverAddress)[4], unsigned char *netMask)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->dhcpServerGetAddress(featureID, errorCode, interfaceIndex, serverAddress, netMask);
@@ -1557,7 +2389,7 @@ void SeaBreezeAPI_Impl::dhcpServerGetAddress(long deviceID, long featureID, int
 
 void SeaBreezeAPI_Impl::dhcpServerSetAddress(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, const unsigned char serverAddress[4], unsigned char netMask)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		adapter->dhcpServerSetAddress(featureID, errorCode, interfaceIndex, serverAddress, netMask);
@@ -1570,7 +2402,7 @@ void SeaBreezeAPI_Impl::dhcpServerSetAddress(long deviceID, long featureID, int
 
 unsigned char SeaBreezeAPI_Impl::dhcpServerGetEnableState(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1581,7 +2413,7 @@ unsigned char SeaBreezeAPI_Impl::dhcpServerGetEnableState(long deviceID, long fe
 
 void SeaBreezeAPI_Impl::dhcpServerSetEnableState(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char enableState)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1618,7 +2450,7 @@ void SeaBreezeAPI_Impl::dhcpServerSetEnableState(long deviceID, long featureID,
 
 int SeaBreezeAPI_Impl::getNumberOfNetworkConfigurationFeatures(long deviceID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1631,7 +2463,7 @@ int SeaBreezeAPI_Impl::getNumberOfNetworkConfigurationFeatures(long deviceID, in
 
 int SeaBreezeAPI_Impl::getNetworkConfigurationFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1644,7 +2476,7 @@ int SeaBreezeAPI_Impl::getNetworkConfigurationFeatures(long deviceID, int *error
 
 unsigned char SeaBreezeAPI_Impl::getNumberOfNetworkInterfaces(long deviceID, long featureID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1655,7 +2487,7 @@ unsigned char SeaBreezeAPI_Impl::getNumberOfNetworkInterfaces(long deviceID, lon
 
 unsigned char SeaBreezeAPI_Impl::getNetworkInterfaceConnectionType(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1666,7 +2498,7 @@ unsigned char SeaBreezeAPI_Impl::getNetworkInterfaceConnectionType(long deviceID
 
 unsigned char SeaBreezeAPI_Impl::runNetworkInterfaceSelfTest(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1677,7 +2509,7 @@ unsigned char SeaBreezeAPI_Impl::runNetworkInterfaceSelfTest(long deviceID, long
 
 unsigned char SeaBreezeAPI_Impl::getNetworkInterfaceEnableState(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -1688,7 +2520,7 @@ unsigned char SeaBreezeAPI_Impl::getNetworkInterfaceEnableState(long deviceID, l
 
 void SeaBreezeAPI_Impl::setNetworkInterfaceEnableState(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex, unsigned char enableState)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1700,7 +2532,7 @@ void SeaBreezeAPI_Impl::setNetworkInterfaceEnableState(long deviceID, long featu
 
 void SeaBreezeAPI_Impl::saveNetworkInterfaceConnectionSettings(long deviceID, long featureID, int *errorCode, unsigned char interfaceIndex)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -1716,7 +2548,7 @@ void SeaBreezeAPI_Impl::saveNetworkInterfaceConnectionSettings(long deviceID, lo
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfEEPROMFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1728,7 +2560,7 @@ int SeaBreezeAPI_Impl::getNumberOfEEPROMFeatures(long deviceID, int *errorCode)
 
 int SeaBreezeAPI_Impl::getEEPROMFeatures(long deviceID, int *errorCode,
             long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1741,7 +2573,7 @@ int SeaBreezeAPI_Impl::getEEPROMFeatures(long deviceID, int *errorCode,
 
 int SeaBreezeAPI_Impl::eepromReadSlot(long deviceID, long featureID, int *errorCode,
         int slotNumber, unsigned char *buffer, int bufferLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1758,7 +2590,7 @@ int SeaBreezeAPI_Impl::eepromReadSlot(long deviceID, long featureID, int *errorC
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfLampFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1770,7 +2602,7 @@ int SeaBreezeAPI_Impl::getNumberOfLampFeatures(long deviceID, int *errorCode) {
 
 int SeaBreezeAPI_Impl::getLampFeatures(long deviceID, int *errorCode,
             long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1782,7 +2614,7 @@ int SeaBreezeAPI_Impl::getLampFeatures(long deviceID, int *errorCode,
 
 void SeaBreezeAPI_Impl::lampSetLampEnable(long deviceID, long featureID,
         int *errorCode, bool strobeEnable) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -1797,7 +2629,7 @@ void SeaBreezeAPI_Impl::lampSetLampEnable(long deviceID, long featureID,
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfShutterFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1809,7 +2641,7 @@ int SeaBreezeAPI_Impl::getNumberOfShutterFeatures(long deviceID, int *errorCode)
 
 int SeaBreezeAPI_Impl::getShutterFeatures(long deviceID, int *errorCode,
             long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1821,7 +2653,7 @@ int SeaBreezeAPI_Impl::getShutterFeatures(long deviceID, int *errorCode,
 
 void SeaBreezeAPI_Impl::shutterSetShutterOpen(long deviceID, long featureID,
         int *errorCode, bool opened) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -1835,7 +2667,7 @@ void SeaBreezeAPI_Impl::shutterSetShutterOpen(long deviceID, long featureID,
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfLightSourceFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1847,7 +2679,7 @@ int SeaBreezeAPI_Impl::getNumberOfLightSourceFeatures(long deviceID, int *errorC
 
 int SeaBreezeAPI_Impl::getLightSourceFeatures(long deviceID, int *errorCode,
             long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1858,7 +2690,7 @@ int SeaBreezeAPI_Impl::getLightSourceFeatures(long deviceID, int *errorCode,
 }
 
 int SeaBreezeAPI_Impl::lightSourceGetCount(long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1869,7 +2701,7 @@ int SeaBreezeAPI_Impl::lightSourceGetCount(long deviceID, long featureID, int *e
 
 bool SeaBreezeAPI_Impl::lightSourceHasEnable(long deviceID, long featureID, int *errorCode,
         int lightSourceIndex) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return false;
@@ -1880,7 +2712,7 @@ bool SeaBreezeAPI_Impl::lightSourceHasEnable(long deviceID, long featureID, int
 
 bool SeaBreezeAPI_Impl::lightSourceIsEnabled(long deviceID, long featureID, int *errorCode,
         int lightSourceIndex) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return false;
@@ -1892,7 +2724,7 @@ bool SeaBreezeAPI_Impl::lightSourceIsEnabled(long deviceID, long featureID, int
 void SeaBreezeAPI_Impl::lightSourceSetEnable(long deviceID, long featureID, int *errorCode,
         int lightSourceIndex, bool enable) {
 
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -1903,7 +2735,7 @@ void SeaBreezeAPI_Impl::lightSourceSetEnable(long deviceID, long featureID, int
 
 bool SeaBreezeAPI_Impl::lightSourceHasVariableIntensity(long deviceID, long featureID,
         int *errorCode, int lightSourceIndex) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return false;
@@ -1915,7 +2747,7 @@ bool SeaBreezeAPI_Impl::lightSourceHasVariableIntensity(long deviceID, long feat
 
 double SeaBreezeAPI_Impl::lightSourceGetIntensity(long deviceID, long featureID, int *errorCode,
         int lightSourceIndex) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return false;
@@ -1927,7 +2759,7 @@ double SeaBreezeAPI_Impl::lightSourceGetIntensity(long deviceID, long featureID,
 void SeaBreezeAPI_Impl::lightSourceSetIntensity(long deviceID, long featureID, int *errorCode,
         int lightSourceIndex, double intensity) {
 
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -1943,7 +2775,7 @@ void SeaBreezeAPI_Impl::lightSourceSetIntensity(long deviceID, long featureID, i
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfNonlinearityCoeffsFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1956,7 +2788,7 @@ int SeaBreezeAPI_Impl::getNumberOfNonlinearityCoeffsFeatures(long deviceID, int
 
 int SeaBreezeAPI_Impl::getNonlinearityCoeffsFeatures(long deviceID, int *errorCode,
         long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1969,7 +2801,7 @@ int SeaBreezeAPI_Impl::getNonlinearityCoeffsFeatures(long deviceID, int *errorCo
 
 int SeaBreezeAPI_Impl::nonlinearityCoeffsGet(long deviceID, long featureID,
         int *errorCode, double *buffer, int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1984,7 +2816,7 @@ int SeaBreezeAPI_Impl::nonlinearityCoeffsGet(long deviceID, long featureID,
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfContinuousStrobeFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -1996,7 +2828,7 @@ int SeaBreezeAPI_Impl::getNumberOfContinuousStrobeFeatures(long deviceID, int *e
 
 int SeaBreezeAPI_Impl::getContinuousStrobeFeatures(long deviceID, int *errorCode, long *buffer,
         unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2008,7 +2840,7 @@ int SeaBreezeAPI_Impl::getContinuousStrobeFeatures(long deviceID, int *errorCode
 
 void SeaBreezeAPI_Impl::continuousStrobeSetContinuousStrobeEnable(long deviceID, long featureID,
         int *errorCode, bool strobeEnable) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -2020,7 +2852,7 @@ void SeaBreezeAPI_Impl::continuousStrobeSetContinuousStrobeEnable(long deviceID,
 
 void SeaBreezeAPI_Impl::continuousStrobeSetContinuousStrobePeriodMicroseconds(long deviceID,
         long featureID, int *errorCode, unsigned long strobePeriodMicroseconds) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -2035,7 +2867,7 @@ void SeaBreezeAPI_Impl::continuousStrobeSetContinuousStrobePeriodMicroseconds(lo
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfTemperatureFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2046,7 +2878,7 @@ int SeaBreezeAPI_Impl::getNumberOfTemperatureFeatures(long deviceID, int *errorC
 }
 
 int SeaBreezeAPI_Impl::getTemperatureFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2058,7 +2890,7 @@ int SeaBreezeAPI_Impl::getTemperatureFeatures(long deviceID, int *errorCode, lon
 
 unsigned char SeaBreezeAPI_Impl::temperatureCountGet(long deviceID, long temperatureFeatureID,
         int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2069,7 +2901,7 @@ unsigned char SeaBreezeAPI_Impl::temperatureCountGet(long deviceID, long tempera
 
 double SeaBreezeAPI_Impl::temperatureGet(long deviceID, long temperatureFeatureID,
         int *errorCode, int index) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2080,7 +2912,7 @@ double SeaBreezeAPI_Impl::temperatureGet(long deviceID, long temperatureFeatureI
 
 int SeaBreezeAPI_Impl::temperatureGetAll(long deviceID, long temperatureFeatureID,
         int *errorCode, double *buffer, int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2095,7 +2927,7 @@ int SeaBreezeAPI_Impl::temperatureGetAll(long deviceID, long temperatureFeatureI
 
 int SeaBreezeAPI_Impl::getNumberOfIntrospectionFeatures(long deviceID, int *errorCode) 
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) 
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -2108,7 +2940,7 @@ int SeaBreezeAPI_Impl::getNumberOfIntrospectionFeatures(long deviceID, int *erro
 
 int SeaBreezeAPI_Impl::getIntrospectionFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength) 
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) 
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -2121,7 +2953,7 @@ int SeaBreezeAPI_Impl::getIntrospectionFeatures(long deviceID, int *errorCode, l
 
 unsigned short int SeaBreezeAPI_Impl::introspectionNumberOfPixelsGet(long deviceID, long introspectionFeatureID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -2132,7 +2964,7 @@ unsigned short int SeaBreezeAPI_Impl::introspectionNumberOfPixelsGet(long device
 
 int SeaBreezeAPI_Impl::introspectionActivePixelRangesGet(long deviceID, long introspectionFeatureID, int *errorCode, unsigned int *buffer, int maxLength) 
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -2143,7 +2975,7 @@ int SeaBreezeAPI_Impl::introspectionActivePixelRangesGet(long deviceID, long int
 
 int SeaBreezeAPI_Impl::introspectionElectricDarkPixelRangesGet(long deviceID, long introspectionFeatureID, int *errorCode, unsigned int *buffer, int maxLength) 
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -2154,7 +2986,7 @@ int SeaBreezeAPI_Impl::introspectionElectricDarkPixelRangesGet(long deviceID, lo
 
 int SeaBreezeAPI_Impl::introspectionOpticalDarkPixelRangesGet(long deviceID, long introspectionFeatureID, int *errorCode, unsigned int *buffer, int maxLength) 
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -2168,7 +3000,7 @@ int SeaBreezeAPI_Impl::introspectionOpticalDarkPixelRangesGet(long deviceID, lon
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfRevisionFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2180,7 +3012,7 @@ int SeaBreezeAPI_Impl::getNumberOfRevisionFeatures(long deviceID, int *errorCode
 
 int SeaBreezeAPI_Impl::getRevisionFeatures(long deviceID, int *errorCode,
         long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2192,7 +3024,7 @@ int SeaBreezeAPI_Impl::getRevisionFeatures(long deviceID, int *errorCode,
 
 unsigned char SeaBreezeAPI_Impl::revisionHardwareGet(long deviceID, long revisionFeatureID,
         int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2203,7 +3035,7 @@ unsigned char SeaBreezeAPI_Impl::revisionHardwareGet(long deviceID, long revisio
 
 unsigned short int SeaBreezeAPI_Impl::revisionFirmwareGet(long deviceID, long revisionFeatureID,
         int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2217,7 +3049,7 @@ unsigned short int SeaBreezeAPI_Impl::revisionFirmwareGet(long deviceID, long re
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfOpticalBenchFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2229,7 +3061,7 @@ int SeaBreezeAPI_Impl::getNumberOfOpticalBenchFeatures(long deviceID, int *error
 
 int SeaBreezeAPI_Impl::getOpticalBenchFeatures(long deviceID, int *errorCode,
         long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2240,7 +3072,7 @@ int SeaBreezeAPI_Impl::getOpticalBenchFeatures(long deviceID, int *errorCode,
 }
 
 unsigned short int SeaBreezeAPI_Impl::opticalBenchGetFiberDiameterMicrons(long deviceID, long opticalBenchFeatureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2250,7 +3082,7 @@ unsigned short int SeaBreezeAPI_Impl::opticalBenchGetFiberDiameterMicrons(long d
 }
 
 unsigned short int SeaBreezeAPI_Impl::opticalBenchGetSlitWidthMicrons(long deviceID, long opticalBenchFeatureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2261,7 +3093,7 @@ unsigned short int SeaBreezeAPI_Impl::opticalBenchGetSlitWidthMicrons(long devic
 
 int SeaBreezeAPI_Impl::opticalBenchGetID(long deviceID, long featureID, int *errorCode,
             char *buffer, int bufferLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2272,7 +3104,7 @@ int SeaBreezeAPI_Impl::opticalBenchGetID(long deviceID, long featureID, int *err
 
 int SeaBreezeAPI_Impl::opticalBenchGetSerialNumber(long deviceID, long featureID, int *errorCode,
             char *buffer, int bufferLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2283,7 +3115,7 @@ int SeaBreezeAPI_Impl::opticalBenchGetSerialNumber(long deviceID, long featureID
 
 int SeaBreezeAPI_Impl::opticalBenchGetCoating(long deviceID, long featureID, int *errorCode,
             char *buffer, int bufferLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2294,7 +3126,7 @@ int SeaBreezeAPI_Impl::opticalBenchGetCoating(long deviceID, long featureID, int
 
 int SeaBreezeAPI_Impl::opticalBenchGetFilter(long deviceID, long featureID, int *errorCode,
             char *buffer, int bufferLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2305,7 +3137,7 @@ int SeaBreezeAPI_Impl::opticalBenchGetFilter(long deviceID, long featureID, int
 
 int SeaBreezeAPI_Impl::opticalBenchGetGrating(long deviceID, long featureID, int *errorCode,
             char *buffer, int bufferLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2319,7 +3151,7 @@ int SeaBreezeAPI_Impl::opticalBenchGetGrating(long deviceID, long featureID, int
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfSpectrumProcessingFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2331,7 +3163,7 @@ int SeaBreezeAPI_Impl::getNumberOfSpectrumProcessingFeatures(long deviceID, int
 
 int SeaBreezeAPI_Impl::getSpectrumProcessingFeatures(long deviceID, int *errorCode,
         long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2342,7 +3174,7 @@ int SeaBreezeAPI_Impl::getSpectrumProcessingFeatures(long deviceID, int *errorCo
 }
 
 unsigned short int SeaBreezeAPI_Impl::spectrumProcessingScansToAverageGet(long deviceID, long spectrumProcessingFeatureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2352,7 +3184,7 @@ unsigned short int SeaBreezeAPI_Impl::spectrumProcessingScansToAverageGet(long d
 }
 
 unsigned char SeaBreezeAPI_Impl::spectrumProcessingBoxcarWidthGet(long deviceID, long spectrumProcessingFeatureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2363,7 +3195,7 @@ unsigned char SeaBreezeAPI_Impl::spectrumProcessingBoxcarWidthGet(long deviceID,
 
 void SeaBreezeAPI_Impl::spectrumProcessingScansToAverageSet(long deviceID, long featureID,
         int *errorCode, unsigned short int scansToAverage) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -2375,7 +3207,7 @@ void SeaBreezeAPI_Impl::spectrumProcessingScansToAverageSet(long deviceID, long
 
 void SeaBreezeAPI_Impl::spectrumProcessingBoxcarWidthSet(long deviceID, long featureID,
     int *errorCode, unsigned char boxcarWidth) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -2390,7 +3222,7 @@ void SeaBreezeAPI_Impl::spectrumProcessingBoxcarWidthSet(long deviceID, long fea
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfStrayLightCoeffsFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2403,7 +3235,7 @@ int SeaBreezeAPI_Impl::getNumberOfStrayLightCoeffsFeatures(long deviceID, int *e
 
 int SeaBreezeAPI_Impl::getStrayLightCoeffsFeatures(long deviceID, int *errorCode,
         long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2414,7 +3246,7 @@ int SeaBreezeAPI_Impl::getStrayLightCoeffsFeatures(long deviceID, int *errorCode
 }
 int SeaBreezeAPI_Impl::strayLightCoeffsGet(long deviceID, long featureID,
         int *errorCode, double *buffer, int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2429,7 +3261,7 @@ int SeaBreezeAPI_Impl::strayLightCoeffsGet(long deviceID, long featureID,
 /**************************************************************************************/
 
 int SeaBreezeAPI_Impl::getNumberOfDataBufferFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2441,7 +3273,7 @@ int SeaBreezeAPI_Impl::getNumberOfDataBufferFeatures(long deviceID, int *errorCo
 
 int SeaBreezeAPI_Impl::getDataBufferFeatures(long deviceID, int *errorCode, long *buffer,
         unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2452,7 +3284,7 @@ int SeaBreezeAPI_Impl::getDataBufferFeatures(long deviceID, int *errorCode, long
 }
 
 void SeaBreezeAPI_Impl::dataBufferClear(long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -2462,7 +3294,7 @@ void SeaBreezeAPI_Impl::dataBufferClear(long deviceID, long featureID, int *erro
 }
 
 void SeaBreezeAPI_Impl::dataBufferRemoveOldestSpectra(long deviceID, long featureID, int *errorCode, unsigned int numberOfSpectra) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -2472,7 +3304,7 @@ void SeaBreezeAPI_Impl::dataBufferRemoveOldestSpectra(long deviceID, long featur
 }
 
 unsigned long SeaBreezeAPI_Impl::dataBufferGetNumberOfElements(long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2483,7 +3315,7 @@ unsigned long SeaBreezeAPI_Impl::dataBufferGetNumberOfElements(long deviceID, lo
 
 unsigned long SeaBreezeAPI_Impl::dataBufferGetBufferCapacity(long deviceID, long featureID, int *errorCode) 
 {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) 
     {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -2495,7 +3327,7 @@ unsigned long SeaBreezeAPI_Impl::dataBufferGetBufferCapacity(long deviceID, long
 
 
 unsigned long SeaBreezeAPI_Impl::dataBufferGetBufferCapacityMaximum(long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2505,7 +3337,7 @@ unsigned long SeaBreezeAPI_Impl::dataBufferGetBufferCapacityMaximum(long deviceI
 }
 
 unsigned long SeaBreezeAPI_Impl::dataBufferGetBufferCapacityMinimum(long deviceID, long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2516,7 +3348,7 @@ unsigned long SeaBreezeAPI_Impl::dataBufferGetBufferCapacityMinimum(long deviceI
 
 void SeaBreezeAPI_Impl::dataBufferSetBufferCapacity(long deviceID, long featureID, int *errorCode, unsigned long capacity) 
 {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) 
     {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -2534,7 +3366,7 @@ void SeaBreezeAPI_Impl::dataBufferSetBufferCapacity(long deviceID, long featureI
 
 
 int SeaBreezeAPI_Impl::getNumberOfFastBufferFeatures(long deviceID, int *errorCode) {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -2546,7 +3378,7 @@ int SeaBreezeAPI_Impl::getNumberOfFastBufferFeatures(long deviceID, int *errorCo
 
 int SeaBreezeAPI_Impl::getFastBufferFeatures(long deviceID, int *errorCode, long *buffer,
 	unsigned int maxLength) {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -2558,7 +3390,7 @@ int SeaBreezeAPI_Impl::getFastBufferFeatures(long deviceID, int *errorCode, long
 
 unsigned char SeaBreezeAPI_Impl::fastBufferGetBufferingEnable(long deviceID, long featureID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -2570,7 +3402,7 @@ unsigned char SeaBreezeAPI_Impl::fastBufferGetBufferingEnable(long deviceID, lon
 
 void SeaBreezeAPI_Impl::fastBufferSetBufferingEnable(long deviceID, long featureID, int *errorCode, unsigned char isEnabled)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -2582,7 +3414,7 @@ void SeaBreezeAPI_Impl::fastBufferSetBufferingEnable(long deviceID, long feature
 
 unsigned int SeaBreezeAPI_Impl::fastBufferGetConsecutiveSampleCount(long deviceID, long featureID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -2594,7 +3426,7 @@ unsigned int SeaBreezeAPI_Impl::fastBufferGetConsecutiveSampleCount(long deviceI
 
 void SeaBreezeAPI_Impl::fastBufferSetConsecutiveSampleCount(long deviceID, long featureID, int *errorCode, unsigned int consecutiveSampleCount)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -2608,7 +3440,7 @@ void SeaBreezeAPI_Impl::fastBufferSetConsecutiveSampleCount(long deviceID, long
 //  Acquisition delay Features for the SeaBreeze API class
 /**************************************************************************************/
 int SeaBreezeAPI_Impl::getNumberOfAcquisitionDelayFeatures(long deviceID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2620,7 +3452,7 @@ int SeaBreezeAPI_Impl::getNumberOfAcquisitionDelayFeatures(long deviceID, int *e
 
 int SeaBreezeAPI_Impl::getAcquisitionDelayFeatures(long deviceID,
         int *errorCode, long *buffer, unsigned int maxLength) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2632,7 +3464,7 @@ int SeaBreezeAPI_Impl::getAcquisitionDelayFeatures(long deviceID,
 
 void SeaBreezeAPI_Impl::acquisitionDelaySetDelayMicroseconds(long deviceID, long featureID,
         int *errorCode, unsigned long delay_usec) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return;
@@ -2643,7 +3475,7 @@ void SeaBreezeAPI_Impl::acquisitionDelaySetDelayMicroseconds(long deviceID, long
 
 unsigned long SeaBreezeAPI_Impl::acquisitionDelayGetDelayMicroseconds(long deviceID,
         long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2654,7 +3486,7 @@ unsigned long SeaBreezeAPI_Impl::acquisitionDelayGetDelayMicroseconds(long devic
 
 unsigned long SeaBreezeAPI_Impl::acquisitionDelayGetDelayIncrementMicroseconds(long deviceID,
         long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2665,7 +3497,7 @@ unsigned long SeaBreezeAPI_Impl::acquisitionDelayGetDelayIncrementMicroseconds(l
 
 unsigned long SeaBreezeAPI_Impl::acquisitionDelayGetDelayMaximumMicroseconds(long deviceID,
         long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2676,7 +3508,7 @@ unsigned long SeaBreezeAPI_Impl::acquisitionDelayGetDelayMaximumMicroseconds(lon
 
 unsigned long SeaBreezeAPI_Impl::acquisitionDelayGetDelayMinimumMicroseconds(long deviceID,
         long featureID, int *errorCode) {
-    DeviceAdapter *adapter = getDeviceByID(deviceID);
+    DeviceGuard adapter(this, deviceID);
     if(NULL == adapter) {
         SET_ERROR_CODE(ERROR_NO_DEVICE);
         return 0;
@@ -2692,7 +3524,7 @@ unsigned long SeaBreezeAPI_Impl::acquisitionDelayGetDelayMinimumMicroseconds(lon
 
 int SeaBreezeAPI_Impl::getNumberOfI2CMasterFeatures(long deviceID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -2705,7 +3537,7 @@ int SeaBreezeAPI_Impl::getNumberOfI2CMasterFeatures(long deviceID, int *errorCod
 
 int SeaBreezeAPI_Impl::getI2CMasterFeatures(long deviceID, int *errorCode, long *buffer, unsigned int maxLength)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter)
 	{
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
@@ -2718,7 +3550,7 @@ int SeaBreezeAPI_Impl::getI2CMasterFeatures(long deviceID, int *errorCode, long
 
 unsigned char SeaBreezeAPI_Impl::i2cMasterGetNumberOfBuses(long deviceID, long featureID, int *errorCode)
 {
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL == adapter) {
 		SET_ERROR_CODE(ERROR_NO_DEVICE);
 		return 0;
@@ -2731,7 +3563,7 @@ unsigned short SeaBreezeAPI_Impl::i2cMasterReadBus(long deviceID, long featureID
 {
 	unsigned short dataLength = 0;
 
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		dataLength = adapter->i2cMasterReadBus(featureID, errorCode, busIndex, slaveAddress, readData, numberOfBytes);
@@ -2747,7 +3579,7 @@ unsigned short SeaBreezeAPI_Impl::i2cMasterWriteBus(long deviceID, long featureI
 {
 	unsigned short dataLength = 0;
 
-	DeviceAdapter *adapter = getDeviceByID(deviceID);
+	DeviceGuard adapter(this, deviceID);
 	if (NULL != adapter)
 	{
 		dataLength = adapter->i2cMasterWriteBus(featureID, errorCode, busIndex, slaveAddress, writeData, numberOfBytes);
@@ -35,24 +35,37 @@
 #include <string.h>     /* for memcpy() */
 #include "api/seabreezeapi/SeaBreezeAPIConstants.h"
 #include "api/seabreezeapi/SpectrometerFeatureAdapter.h"
+#include "common/exceptions/FeatureControlException.h"
 #include "common/exceptions/IllegalArgumentException.h"
+#include "vendors/OceanOptics/features/spectrometer/SpectrometerTriggerMode.h"
 
 using namespace seabreeze;
 using namespace seabreeze::api;
 using namespace std;
 
+/* Limits the memory that one stream can hold on to */
+#define MAX_FAST_BUFFER_STREAM_CAPACITY     65536
+
 SpectrometerFeatureAdapter::SpectrometerFeatureAdapter(
         OOISpectrometerFeatureInterface *spec, const FeatureFamily &f,
         seabreeze::Protocol *p, seabreeze::Bus *b, unsigned short instanceID)
             : FeatureAdapterTemplate<OOISpectrometerFeatureInterface>(spec,
                 f, p, b, instanceID) {
 
+    this->stream = NULL;
+    this->prefetchBinding = NULL;
+    this->prefetchPending = false;
+    this->prefetchHeld = false;
+    this->triggerMode = SPECTROMETER_TRIGGER_MODE_NORMAL;
 }
 
 SpectrometerFeatureAdapter::~SpectrometerFeatureAdapter() {
-    /* This is just a wrapper around pointers to instances.  This is not
-     * responsible for destroying anything.
+    /* This is just a wrapper around pointers to instances.  The stream and
+     * the prefetch binding are the only things it owns; deleting the stream
+     * stops the thread.
      */
+    delete this->stream;
+    delete this->prefetchBinding;
 }
 
 #ifdef _WINDOWS
@@ -68,6 +81,8 @@ int SpectrometerFeatureAdapter::getUnformattedSpectrum(int *errorCode,
         return 0;
     }
 
+    cancelPrefetch();
+
     try {
         spectrum = this->feature->getUnformattedSpectrum(*this->protocol,
             *this->bus);
@@ -94,6 +109,8 @@ int SpectrometerFeatureAdapter::getFastBufferSpectrum(int *errorCode,
 		return 0;
 	}
 
+	cancelPrefetch();
+
 	try {
 
 		spectrum = this->feature->getFastBufferSpectrum(*this->protocol, *this->bus, numberOfSamplesToRetrieve);
@@ -116,6 +133,7 @@ int SpectrometerFeatureAdapter::getFastBufferSpectrum(int *errorCode,
 
 void SpectrometerFeatureAdapter::fastBufferSpectrumRequest(int *errorCode, unsigned int numberOfSamplesToRetrieve)
 {
+    cancelPrefetch();
 
     try {
 
@@ -161,22 +179,23 @@ int SpectrometerFeatureAdapter::fastBufferSpectrumResponse(int *errorCode,
 }
 
 
-int SpectrometerFeatureAdapter::getFormattedSpectrum(int *errorCode,
-                    double* buffer, int bufferLength) {
-    vector<double> *spectrum;
-    int doublesCopied = 0;
+/* All of the formatted spectrum types share the same checks and error
+ * handling; only the element type of the caller's buffer differs.
+ */
+template <class T> int __getFormattedSpectrum(
+        OOISpectrometerFeatureInterface *feature, Protocol *protocol,
+        Bus *bus, int *errorCode, T *buffer, int bufferLength) {
+    int pixelsCopied = 0;
 
-    if(NULL == buffer) {
+    if(NULL == buffer || bufferLength < 0) {
         SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
         return 0;
     }
 
     try {
-        spectrum = this->feature->getFormattedSpectrum(*this->protocol, *this->bus);
-        int pixels = (int) spectrum->size();
-        doublesCopied = (pixels < bufferLength) ? pixels : bufferLength;
-        memcpy(buffer, &((*spectrum)[0]), doublesCopied * sizeof (double));
-        delete spectrum;
+        /* The spectrum is decoded directly into the caller's buffer */
+        pixelsCopied = (int) feature->getFormattedSpectrum(
+                *protocol, *bus, buffer, (unsigned int) bufferLength);
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (FeatureException &fe) {
 		
@@ -184,9 +203,234 @@ int SpectrometerFeatureAdapter::getFormattedSpectrum(int *errorCode,
         SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
         return 0;
     }
+    return pixelsCopied;
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectrum(int *errorCode,
+                    double* buffer, int bufferLength) {
+    if(NULL != this->prefetchBinding) {
+        return getPrefetchedFormattedSpectrum(errorCode, buffer, bufferLength);
+    }
+    return __getFormattedSpectrum(this->feature, this->protocol, this->bus,
+            errorCode, buffer, bufferLength);
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectrum(int *errorCode,
+                    float *buffer, int bufferLength) {
+    if(NULL != this->prefetchBinding) {
+        return getPrefetchedFormattedSpectrum(errorCode, buffer, bufferLength);
+    }
+    return __getFormattedSpectrum(this->feature, this->protocol, this->bus,
+            errorCode, buffer, bufferLength);
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectrum(int *errorCode,
+                    unsigned short *buffer, int bufferLength) {
+    if(NULL != this->prefetchBinding) {
+        return getPrefetchedFormattedSpectrum(errorCode, buffer, bufferLength);
+    }
+    return __getFormattedSpectrum(this->feature, this->protocol, this->bus,
+            errorCode, buffer, bufferLength);
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectrum(int *errorCode,
+                    unsigned int *buffer, int bufferLength) {
+    if(NULL != this->prefetchBinding) {
+        return getPrefetchedFormattedSpectrum(errorCode, buffer, bufferLength);
+    }
+    return __getFormattedSpectrum(this->feature, this->protocol, this->bus,
+            errorCode, buffer, bufferLength);
+}
+
+SpectrometerProtocolBinding *SpectrometerFeatureAdapter::bindSpectrumAcquisition(
+        int *errorCode) {
+    SpectrometerProtocolBinding *binding;
+
+    try {
+        binding = this->feature->bindSpectrumAcquisition(*this->protocol,
+                *this->bus);
+        SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (FeatureException &fe) {
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return NULL;
+    }
+    return binding;
+}
+
+int SpectrometerFeatureAdapter::getUnformattedSpectrum(int *errorCode,
+        SpectrometerProtocolBinding &binding, unsigned char *buffer,
+        int bufferLength) {
+    int bytesCopied = 0;
+
+    if(NULL == buffer || bufferLength < 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    cancelPrefetch();
+
+    try {
+        binding.requestUnformattedSpectrum();
+        bytesCopied = (int) binding.readUnformattedSpectrum(buffer,
+                (unsigned int) bufferLength);
+        SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (ProtocolException &pe) {
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return 0;
+    }
+
+    return bytesCopied;
+}
+
+template <class T> int __getBoundFormattedSpectrum(
+        SpectrometerProtocolBinding &binding, int *errorCode, T *buffer,
+        int bufferLength) {
+    int pixelsCopied = 0;
+
+    if(NULL == buffer || bufferLength < 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    try {
+        binding.requestFormattedSpectrum();
+        pixelsCopied = (int) binding.readFormattedSpectrum(buffer,
+                (unsigned int) bufferLength);
+        SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (ProtocolException &pe) {
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return 0;
+    }
+    return pixelsCopied;
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectrum(int *errorCode,
+        SpectrometerProtocolBinding &binding, double *buffer, int bufferLength) {
+    if(NULL != this->prefetchBinding) {
+        return getPrefetchedFormattedSpectrum(errorCode, buffer, bufferLength);
+    }
+    return __getBoundFormattedSpectrum(binding, errorCode, buffer, bufferLength);
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectrum(int *errorCode,
+        SpectrometerProtocolBinding &binding, float *buffer, int bufferLength) {
+    if(NULL != this->prefetchBinding) {
+        return getPrefetchedFormattedSpectrum(errorCode, buffer, bufferLength);
+    }
+    return __getBoundFormattedSpectrum(binding, errorCode, buffer, bufferLength);
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectrum(int *errorCode,
+        SpectrometerProtocolBinding &binding, unsigned short *buffer,
+        int bufferLength) {
+    if(NULL != this->prefetchBinding) {
+        return getPrefetchedFormattedSpectrum(errorCode, buffer, bufferLength);
+    }
+    return __getBoundFormattedSpectrum(binding, errorCode, buffer, bufferLength);
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectrum(int *errorCode,
+        SpectrometerProtocolBinding &binding, unsigned int *buffer,
+        int bufferLength) {
+    if(NULL != this->prefetchBinding) {
+        return getPrefetchedFormattedSpectrum(errorCode, buffer, bufferLength);
+    }
+    return __getBoundFormattedSpectrum(binding, errorCode, buffer, bufferLength);
+}
+
+void SpectrometerFeatureAdapter::requestFormattedSpectrum(int *errorCode,
+        SpectrometerProtocolBinding &binding) {
+    cancelPrefetch();
+
+    try {
+        binding.requestFormattedSpectrum();
+        SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (ProtocolException &pe) {
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+    }
+}
+
+int SpectrometerFeatureAdapter::readFormattedSpectrum(int *errorCode,
+        SpectrometerProtocolBinding &binding, double *buffer,
+        int bufferLength) {
+    int pixelsCopied = 0;
+
+    try {
+        /* The response must be read even if it has nowhere to go */
+        if(NULL == buffer || bufferLength < 0) {
+            vector<double> discarded(this->feature->getNumberOfPixels());
+            binding.readFormattedSpectrum(&discarded[0],
+                    (unsigned int) discarded.size());
+            SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+            return 0;
+        }
+        pixelsCopied = (int) binding.readFormattedSpectrum(buffer,
+                (unsigned int) bufferLength);
+        SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (ProtocolException &pe) {
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return 0;
+    }
+    return pixelsCopied;
+}
+
+int SpectrometerFeatureAdapter::getFormattedSpectrumWithMetadata(int *errorCode,
+                    double *buffer, int bufferLength,
+                    sbapi_spectrum_metadata_t *metadata) {
+    int doublesCopied;
+    int error = ERROR_SUCCESS;
+
+    if(NULL == metadata) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    doublesCopied = getFormattedSpectrum(&error, buffer, bufferLength);
+    if(ERROR_SUCCESS == error) {
+        /* The metadata is only worth having alongside the pixels */
+        getFormattedSpectrumMetadata(&error, metadata);
+    }
+    if(ERROR_SUCCESS != error) {
+        SET_ERROR_CODE(error);
+        return 0;
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
     return doublesCopied;
 }
 
+static void __copySpectrumMetadata(const SpectrumMetadata &decoded,
+        sbapi_spectrum_metadata_t *metadata) {
+    metadata->spectrum_count = decoded.spectrumCount;
+    metadata->tick_count_micros = decoded.tickCountMicros;
+    metadata->integration_time_micros = decoded.integrationTimeMicros;
+    metadata->trigger_mode = decoded.triggerMode;
+}
+
+void SpectrometerFeatureAdapter::getFormattedSpectrumMetadata(int *errorCode,
+                    sbapi_spectrum_metadata_t *metadata) {
+    SpectrumMetadata decoded;
+
+    if(NULL == metadata) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return;
+    }
+
+    try {
+        if(false == this->feature->getFormattedSpectrumMetadata(
+                *this->protocol, decoded)) {
+            SET_ERROR_CODE(ERROR_NOT_IMPLEMENTED);
+            return;
+        }
+    } catch (FeatureException &fe) {
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return;
+    }
+
+    __copySpectrumMetadata(decoded, metadata);
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
 int SpectrometerFeatureAdapter::getUnformattedSpectrumLength(int *errorCode) {
     /* This is, unfortunately, very hard to implement directly.
      * The readout length from the device is buried inside a particular
@@ -203,6 +447,8 @@ int SpectrometerFeatureAdapter::getUnformattedSpectrumLength(int *errorCode) {
      */
     vector<byte> *spectrum;
 
+    cancelPrefetch();
+
     try {
         spectrum = this->feature->getUnformattedSpectrum(
             *this->protocol, *this->bus);
@@ -234,15 +480,125 @@ int SpectrometerFeatureAdapter::getFormattedSpectrumLength(int *errorCode) {
 void SpectrometerFeatureAdapter::setTriggerMode(int *errorCode, int mode) {
     SpectrometerTriggerMode triggerMode(mode);
 
+    if(true == this->triggerModeSetting.matches(mode)) {
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return;
+    }
+
+    cancelPrefetch();
+
     try {
         this->feature->setTriggerMode(*this->protocol, *this->bus, triggerMode);
+        this->triggerMode = mode;
+        this->triggerModeSetting.update(mode);
         SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (FeatureControlException &fce) {
+        /* The transfer failed, so the device may or may not have the mode */
+        this->triggerModeSetting.forget();
+        SET_ERROR_CODE(ERROR_INVALID_TRIGGER_MODE);
+        return;
     } catch (FeatureException &fe) {
+        /* Refused before anything was sent, so the old mode still holds */
         SET_ERROR_CODE(ERROR_INVALID_TRIGGER_MODE);
         return;
     }
 }
 
+void SpectrometerFeatureAdapter::setPrefetchEnabled(int *errorCode,
+        bool enable) {
+    if(false == enable) {
+        cancelPrefetch();
+        delete this->prefetchBinding;
+        this->prefetchBinding = NULL;
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return;
+    }
+
+    if(NULL == this->prefetchBinding) {
+        /* The binding is what lets the request and the read be split */
+        this->prefetchBinding = bindSpectrumAcquisition(errorCode);
+        return;
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+void SpectrometerFeatureAdapter::cancelPrefetch() {
+    if(false == this->prefetchPending) {
+        return;
+    }
+
+    this->prefetchPending = false;
+
+    try {
+        vector<double> discarded(this->feature->getNumberOfPixels());
+        this->prefetchBinding->readFormattedSpectrum(&discarded[0],
+                (unsigned int) discarded.size());
+    } catch (ProtocolException &pe) {
+        /* Whatever went wrong will be reported by the next command */
+    }
+}
+
+template <class T> int SpectrometerFeatureAdapter::getPrefetchedFormattedSpectrum(
+        int *errorCode, T *buffer, int bufferLength) {
+    int pixelsCopied = 0;
+
+    if(NULL == buffer || bufferLength < 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    try {
+        if(false == this->prefetchPending) {
+            this->prefetchBinding->requestFormattedSpectrum();
+        }
+        this->prefetchPending = false;
+        pixelsCopied = (int) this->prefetchBinding->readFormattedSpectrum(
+                buffer, (unsigned int) bufferLength);
+    } catch (ProtocolException &pe) {
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return 0;
+    }
+
+    if(false == this->prefetchHeld) {
+        resumePrefetch();
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return pixelsCopied;
+}
+
+void SpectrometerFeatureAdapter::holdPrefetch() {
+    this->prefetchHeld = true;
+}
+
+void SpectrometerFeatureAdapter::resumePrefetch() {
+    this->prefetchHeld = false;
+
+    if(NULL == this->prefetchBinding || true == this->prefetchPending) {
+        return;
+    }
+
+    /* A request left outstanding between the stream's rounds would put
+     * the replies out of step.
+     */
+    if(true == isFastBufferStreaming()) {
+        return;
+    }
+
+    /* Anything else would wait for a trigger that may never come, and hold
+     * up every other command in the meantime.
+     */
+    if(SPECTROMETER_TRIGGER_MODE_NORMAL == this->triggerMode) {
+        try {
+            this->prefetchBinding->requestFormattedSpectrum();
+            this->prefetchPending = true;
+        } catch (ProtocolException &pe) {
+            /* The next acquisition will make its own request */
+        }
+    }
+}
+
 
 int SpectrometerFeatureAdapter::getWavelengths(int *errorCode,
         double *wavelengths, int length) {
@@ -251,6 +607,9 @@ int SpectrometerFeatureAdapter::getWavelengths(int *errorCode,
     vector<double> *wlVector;
     vector<double>::iterator iter;
 
+    /* The first call reads the calibration from the device */
+    cancelPrefetch();
+
     try {
         wlVector = this->feature->getWavelengths(*this->protocol, *this->bus);
         /* It might be possible to do a memcpy() of the underlying vector into
@@ -390,11 +749,23 @@ int SpectrometerFeatureAdapter::getActivePixelIndices(int *errorCode,
 
 void SpectrometerFeatureAdapter::setIntegrationTimeMicros(int *errorCode,
                     unsigned long integrationTimeMicros) {
+    /* This also leaves a prefetched spectrum alone, since it is still
+     * taken with the right integration time.
+     */
+    if(true == this->integrationTimeSetting.matches(integrationTimeMicros)) {
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return;
+    }
+
+    cancelPrefetch();
+
     try {
         this->feature->setIntegrationTimeMicros(*this->protocol, *this->bus,
                     integrationTimeMicros);
+        this->integrationTimeSetting.update(integrationTimeMicros);
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (FeatureException &fe) {
+        this->integrationTimeSetting.forget();
         SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
         return;
     } catch (IllegalArgumentException &iae) {
@@ -403,6 +774,22 @@ void SpectrometerFeatureAdapter::setIntegrationTimeMicros(int *errorCode,
     }
 }
 
+unsigned long SpectrometerFeatureAdapter::getIntegrationTimeMicros(
+        int *errorCode) {
+    if(false == this->integrationTimeSetting.isKnown()) {
+        SET_ERROR_CODE(ERROR_VALUE_NOT_FOUND);
+        return 0;
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return this->integrationTimeSetting.get();
+}
+
+void SpectrometerFeatureAdapter::forgetSettings() {
+    this->triggerModeSetting.forget();
+    this->integrationTimeSetting.forget();
+}
+
 long SpectrometerFeatureAdapter::getMinimumIntegrationTimeMicros(int *errorCode) {
     long retval = -1;
 
@@ -443,3 +830,132 @@ double SpectrometerFeatureAdapter::getMaximumIntensity(int *errorCode) {
     }
     return retval;
 }
+
+bool SpectrometerFeatureAdapter::isFastBufferStreaming() {
+    return NULL != this->stream && true == this->stream->isStarted()
+            && false == this->stream->hasFailed();
+}
+
+int SpectrometerFeatureAdapter::startFastBufferStream(int *errorCode,
+        int capacity, Mutex *busLock) {
+    unsigned int recordLength = this->feature->getFastBufferSpectrumLength();
+
+    if(0 == recordLength) {
+        SET_ERROR_CODE(ERROR_NOT_IMPLEMENTED);
+        return 0;
+    }
+
+    if(capacity <= 0 || capacity > MAX_FAST_BUFFER_STREAM_CAPACITY) {
+        SET_ERROR_CODE(ERROR_INPUT_OUT_OF_BOUNDS);
+        return 0;
+    }
+
+    if(true == isFastBufferStreaming()) {
+        /* Already streaming */
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return (int)this->stream->getRecordLength();
+    }
+
+    /* Anything left over from an earlier stream is discarded */
+    delete this->stream;
+    this->stream = new FastBufferSpectrumStream(this->feature, this->protocol,
+            this->bus, busLock, recordLength, (unsigned int)capacity);
+    if(false == this->stream->startStreaming()) {
+        delete this->stream;
+        this->stream = NULL;
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return 0;
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (int)recordLength;
+}
+
+int SpectrometerFeatureAdapter::readFastBufferStream(int *errorCode,
+        unsigned char *buffer, int bufferLength) {
+    unsigned int recordLength;
+    unsigned int count;
+
+    if(NULL == this->stream) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    recordLength = this->stream->getRecordLength();
+    if(NULL == buffer || bufferLength < (int)recordLength) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    count = this->stream->readSpectra(buffer, (unsigned int)bufferLength / recordLength);
+    if(0 == count && true == this->stream->hasFailed()) {
+        /* Everything that arrived before the failure has been read */
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return 0;
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (int)(count * recordLength);
+}
+
+void SpectrometerFeatureAdapter::stopFastBufferStream(int *errorCode) {
+    if(NULL == this->stream) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return;
+    }
+
+    /* Spectra that were already queued can still be read */
+    this->stream->stopStreaming();
+    SET_ERROR_CODE(ERROR_SUCCESS);
+}
+
+unsigned int SpectrometerFeatureAdapter::getFastBufferStreamOverruns(int *errorCode) {
+    if(NULL == this->stream) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return 0;
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return this->stream->getOverrunCount();
+}
+
+int SpectrometerFeatureAdapter::getFastBufferSpectrumLength(int *errorCode) {
+    unsigned int recordLength = this->feature->getFastBufferSpectrumLength();
+
+    if(0 == recordLength) {
+        SET_ERROR_CODE(ERROR_NOT_IMPLEMENTED);
+        return 0;
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (int)recordLength;
+}
+
+int SpectrometerFeatureAdapter::decodeFastBufferSpectra(int *errorCode,
+        const unsigned char *buffer, int bufferLength,
+        sbapi_spectrum_metadata_t *metadata, unsigned char *valid,
+        int maxSpectra) {
+
+    if(NULL == buffer || bufferLength < 0 || NULL == metadata
+            || NULL == valid || maxSpectra < 0) {
+        SET_ERROR_CODE(ERROR_BAD_USER_BUFFER);
+        return 0;
+    }
+
+    if(0 == this->feature->getFastBufferSpectrumLength()) {
+        SET_ERROR_CODE(ERROR_NOT_IMPLEMENTED);
+        return 0;
+    }
+
+    /* Only the metadata is converted; the pixels stay where they are */
+    vector<SpectrumMetadata> decoded(maxSpectra);
+    unsigned int count = this->feature->decodeFastBufferSpectra(buffer,
+            (unsigned int)bufferLength, decoded.empty() ? NULL : &decoded[0],
+            valid, (unsigned int)maxSpectra);
+    for(unsigned int i = 0; i < count; i++) {
+        __copySpectrumMetadata(decoded[i], &metadata[i]);
+    }
+
+    SET_ERROR_CODE(ERROR_SUCCESS);
+    return (int)count;
+}
@@ -0,0 +1,159 @@
+/***************************************************//**
+ * @file    SpectrometerSession.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include "api/seabreezeapi/SpectrometerSession.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+
+using namespace seabreeze;
+using namespace seabreeze::api;
+
+SpectrometerSession::SpectrometerSession(DeviceAdapter *device, long featureID) {
+    this->device = device;
+    this->featureID = featureID;
+    this->connection = 0;
+    this->feature = NULL;
+    this->binding = NULL;
+}
+
+SpectrometerSession::~SpectrometerSession() {
+    /* The binding only refers to things that the device owns */
+    delete this->binding;
+}
+
+DeviceAdapter *SpectrometerSession::getDevice() {
+    return this->device;
+}
+
+bool SpectrometerSession::prepare(int *errorCode) {
+    MutexLock guard(this->device->getLock());
+
+    return bind(errorCode);
+}
+
+bool SpectrometerSession::bind(int *errorCode) {
+    if(NULL != this->binding && this->device->connection == this->connection) {
+        return true;
+    }
+
+    /* Anything resolved against an earlier connection is no longer valid */
+    delete this->binding;
+    this->binding = NULL;
+
+    this->feature = this->device->getSpectrometerFeatureByID(this->featureID);
+    if(NULL == this->feature) {
+        SET_ERROR_CODE(ERROR_FEATURE_NOT_FOUND);
+        return false;
+    }
+
+    this->binding = this->feature->bindSpectrumAcquisition(errorCode);
+    if(NULL == this->binding) {
+        return false;
+    }
+
+    this->connection = this->device->connection;
+    return true;
+}
+
+int SpectrometerSession::getUnformattedSpectrum(int *errorCode,
+        unsigned char *buffer, int bufferLength) {
+    MutexLock guard(this->device->getLock());
+
+    if(false == bind(errorCode)) {
+        return 0;
+    }
+
+    return this->feature->getUnformattedSpectrum(errorCode, *this->binding,
+            buffer, bufferLength);
+}
+
+template <class T> int SpectrometerSession::getFormattedSpectrumInto(
+        int *errorCode, T *buffer, int bufferLength) {
+    MutexLock guard(this->device->getLock());
+
+    if(false == bind(errorCode)) {
+        return 0;
+    }
+
+    return this->feature->getFormattedSpectrum(errorCode, *this->binding,
+            buffer, bufferLength);
+}
+
+int SpectrometerSession::getFormattedSpectrum(int *errorCode, double *buffer,
+        int bufferLength) {
+    return getFormattedSpectrumInto(errorCode, buffer, bufferLength);
+}
+
+int SpectrometerSession::getFormattedSpectrum(int *errorCode, float *buffer,
+        int bufferLength) {
+    return getFormattedSpectrumInto(errorCode, buffer, bufferLength);
+}
+
+int SpectrometerSession::getFormattedSpectrum(int *errorCode,
+        unsigned short *buffer, int bufferLength) {
+    return getFormattedSpectrumInto(errorCode, buffer, bufferLength);
+}
+
+int SpectrometerSession::getFormattedSpectrum(int *errorCode,
+        unsigned int *buffer, int bufferLength) {
+    return getFormattedSpectrumInto(errorCode, buffer, bufferLength);
+}
+
+bool SpectrometerSession::requestFormattedSpectrum(int *errorCode) {
+    int error = ERROR_SUCCESS;
+
+    if(false == bind(errorCode)) {
+        return false;
+    }
+
+    this->feature->requestFormattedSpectrum(&error, *this->binding);
+    SET_ERROR_CODE(error);
+    return ERROR_SUCCESS == error;
+}
+
+int SpectrometerSession::readFormattedSpectrum(int *errorCode, double *buffer,
+        int bufferLength) {
+    /* The request bound the session, and nothing can have rebound it
+     * while the caller held the lock.
+     */
+    return this->feature->readFormattedSpectrum(errorCode, *this->binding,
+            buffer, bufferLength);
+}
+
+bool SpectrometerSession::getFormattedSpectrumMetadata(int *errorCode,
+        sbapi_spectrum_metadata_t *metadata) {
+    int error = ERROR_SUCCESS;
+
+    if(false == bind(errorCode)) {
+        return false;
+    }
+
+    this->feature->getFormattedSpectrumMetadata(&error, metadata);
+    SET_ERROR_CODE(error);
+    return ERROR_SUCCESS == error;
+}
@@ -63,6 +63,7 @@ unsigned char SpectrumProcessingFeatureAdapter::readSpectrumProcessingBoxcarWidt
     // no memory allocated, just pass it through
     try {
         returnValue=this->feature->readSpectrumProcessingBoxcarWidth(*this->protocol, *this->bus);
+        this->boxcarWidthSetting.update(returnValue);
         SET_ERROR_CODE(ERROR_SUCCESS);
     }
     catch (FeatureException &fe) {
@@ -78,6 +79,7 @@ unsigned short int SpectrumProcessingFeatureAdapter::readSpectrumProcessingScans
     // no memory allocated, just pass it through
     try {
         returnValue=this->feature->readSpectrumProcessingScansToAverage(*this->protocol, *this->bus);
+        this->scansToAverageSetting.update(returnValue);
         SET_ERROR_CODE(ERROR_SUCCESS);
     }
     catch (FeatureException &fe) {
@@ -88,10 +90,17 @@ unsigned short int SpectrumProcessingFeatureAdapter::readSpectrumProcessingScans
 
 void SpectrumProcessingFeatureAdapter::writeSpectrumProcessingScansToAverage(int *errorCode, unsigned short int scansToAverage) {
 
+    if(true == this->scansToAverageSetting.matches(scansToAverage)) {
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return;
+    }
+
     try {
         this->feature->writeSpectrumProcessingScansToAverage(*this->protocol, *this->bus, scansToAverage);
+        this->scansToAverageSetting.update(scansToAverage);
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (FeatureException &fe) {
+        this->scansToAverageSetting.forget();
         SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
         return;
     } catch (IllegalArgumentException &iae) {
@@ -104,10 +113,17 @@ void SpectrumProcessingFeatureAdapter::writeSpectrumProcessingScansToAverage(int
 
 void SpectrumProcessingFeatureAdapter::writeSpectrumProcessingBoxcarWidth(int *errorCode, unsigned char boxcarWidth) {
 
+    if(true == this->boxcarWidthSetting.matches(boxcarWidth)) {
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return;
+    }
+
     try {
         this->feature->writeSpectrumProcessingBoxcarWidth(*this->protocol, *this->bus, boxcarWidth);
+        this->boxcarWidthSetting.update(boxcarWidth);
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (FeatureException &fe) {
+        this->boxcarWidthSetting.forget();
         SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
         return;
     } catch (IllegalArgumentException &iae) {
@@ -118,3 +134,7 @@ void SpectrumProcessingFeatureAdapter::writeSpectrumProcessingBoxcarWidth(int *e
     return;
 }
 
+void SpectrumProcessingFeatureAdapter::forgetSettings() {
+    this->boxcarWidthSetting.forget();
+    this->scansToAverageSetting.forget();
+}
@@ -113,4 +113,31 @@ int TemperatureFeatureAdapter::readAllTemperatures(int *errorCode, double *buffe
         return 0;
     }
     return doublesCopied;
+}
+
+int TemperatureFeatureAdapter::readAllTemperaturesWithTEC(int *errorCode,
+        double *buffer, int bufferLength, double *tecTemperature, bool *tecRead) {
+    int doublesCopied = 0;
+
+    vector<double> *cal;
+
+    try {
+        cal = this->feature->readAllTemperaturesWithTEC(*this->protocol,
+                *this->bus, tecTemperature, tecRead);
+        if(NULL == cal) {
+            /* The TEC may still have answered even though this did not */
+            SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+            return 0;
+        }
+        int doubles = (int) cal->size();
+        doublesCopied = (doubles < bufferLength) ? doubles : bufferLength;
+        memcpy(buffer, &((*cal)[0]), doublesCopied * sizeof(double));
+
+        delete cal;
+        SET_ERROR_CODE(ERROR_SUCCESS);
+    } catch (FeatureException &fe) {
+        SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
+        return 0;
+    }
+    return doublesCopied;
 }
\ No newline at end of file
@@ -70,11 +70,18 @@ double ThermoElectricCoolerFeatureAdapter::readTECTemperature(int *errorCode) {
 void ThermoElectricCoolerFeatureAdapter::setTECTemperature(int *errorCode,
         double temperature_degrees_celsius) {
 
+    if(true == this->setpointSetting.matches(temperature_degrees_celsius)) {
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return;
+    }
+
     try {
         this->feature->setTemperatureSetPointCelsius(*this->protocol, *this->bus,
                 temperature_degrees_celsius);
+        this->setpointSetting.update(temperature_degrees_celsius);
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (FeatureException &fe) {
+        this->setpointSetting.forget();
         SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
         return;
     } catch (IllegalArgumentException &iae) {
@@ -87,10 +94,17 @@ void ThermoElectricCoolerFeatureAdapter::setTECTemperature(int *errorCode,
 
 void ThermoElectricCoolerFeatureAdapter::setTECEnable(int *errorCode,
         bool tec_enable) {
+    if(true == this->enableSetting.matches(tec_enable)) {
+        SET_ERROR_CODE(ERROR_SUCCESS);
+        return;
+    }
+
     try {
         this->feature->setThermoElectricEnable(*this->protocol, *this->bus, tec_enable);
+        this->enableSetting.update(tec_enable);
         SET_ERROR_CODE(ERROR_SUCCESS);
     } catch (FeatureException &fe) {
+        this->enableSetting.forget();
         SET_ERROR_CODE(ERROR_TRANSFER_ERROR);
         return;
     }
@@ -105,3 +119,8 @@ void ThermoElectricCoolerFeatureAdapter::setTECFanEnable(int *errorCode,
     /* FIXME: MISSING_IMPL */
     return;
 }
+
+void ThermoElectricCoolerFeatureAdapter::forgetSettings() {
+    this->setpointSetting.forget();
+    this->enableSetting.forget();
+}
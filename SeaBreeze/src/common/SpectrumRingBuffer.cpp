@@ -0,0 +1,104 @@
+/***************************************************//**
+ * @file    SpectrumRingBuffer.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Implementation of the single producer, single consumer
+ * ring buffer of spectra.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "common/SpectrumRingBuffer.h"
+#include "native/system/NativeSystem.h"
+#include <string.h>
+
+using namespace seabreeze;
+
+SpectrumRingBuffer::SpectrumRingBuffer(unsigned int length,
+        unsigned int minimumCapacity) {
+    /* A power of two keeps the slot index correct when the counters wrap */
+    this->capacity = 1;
+    while(this->capacity < minimumCapacity) {
+        this->capacity <<= 1;
+    }
+
+    this->recordLength = length;
+    this->storage.resize(this->capacity * this->recordLength);
+    this->pushed = 0;
+    this->popped = 0;
+    this->overruns = 0;
+}
+
+SpectrumRingBuffer::~SpectrumRingBuffer() {
+
+}
+
+bool SpectrumRingBuffer::push(const byte *record) {
+    unsigned int head = this->pushed;
+
+    if(head - atomicLoad(&this->popped) >= this->capacity) {
+        atomicStore(&this->overruns, this->overruns + 1);
+        return false;
+    }
+
+    if(this->recordLength > 0) {
+        memcpy(&this->storage[(head & (this->capacity - 1)) * this->recordLength],
+                record, this->recordLength);
+    }
+
+    /* The consumer may take the record as soon as this is seen */
+    atomicStore(&this->pushed, head + 1);
+    return true;
+}
+
+bool SpectrumRingBuffer::pop(byte *record) {
+    unsigned int tail = this->popped;
+
+    if(atomicLoad(&this->pushed) == tail) {
+        return false;
+    }
+
+    if(this->recordLength > 0) {
+        memcpy(record, &this->storage[(tail & (this->capacity - 1)) * this->recordLength],
+                this->recordLength);
+    }
+
+    /* The producer may reuse the slot as soon as this is seen */
+    atomicStore(&this->popped, tail + 1);
+    return true;
+}
+
+unsigned int SpectrumRingBuffer::getRecordLength() const {
+    return this->recordLength;
+}
+
+unsigned int SpectrumRingBuffer::getCapacity() const {
+    return this->capacity;
+}
+
+unsigned int SpectrumRingBuffer::getOverrunCount() {
+    return atomicLoad(&this->overruns);
+}
@@ -31,6 +31,7 @@
 #include "common/buses/TransferHelper.h"
 
 using namespace seabreeze;
+using namespace std;
 
 TransferHelper::TransferHelper() {
 
@@ -39,3 +40,71 @@ TransferHelper::TransferHelper() {
 TransferHelper::~TransferHelper() {
 
 }
+
+int TransferHelper::receiveInto(vector<byte> &buffer, unsigned int offset,
+        unsigned int length) throw (BusTransferException) {
+    int retval;
+
+    if(buffer.size() < offset + length) {
+        string error("Receive buffer is too small for the requested transfer.");
+        throw BusTransferException(error);
+    }
+
+    if(0 == offset) {
+        return receive(buffer, length);
+    }
+
+    vector<byte> temp(length);
+    retval = receive(temp, length);
+    if(retval > 0) {
+        copy(temp.begin(), temp.begin() + retval, buffer.begin() + offset);
+    }
+    return retval;
+}
+
+void TransferHelper::setReceiveTimeoutMillis(unsigned int timeoutMillis) {
+
+}
+
+unsigned int TransferHelper::getReceiveTimeoutMillis() {
+    return 0;
+}
+
+bool TransferHelper::isReceiveTimeoutEnforced() {
+    return false;
+}
+
+int TransferHelper::receiveSegments(const TransferSegment *segments,
+        unsigned int count) throw (BusTransferException) {
+    unsigned int total = 0;
+    unsigned int copied = 0;
+    unsigned int i;
+    int retval;
+
+    for(i = 0; i < count; i++) {
+        total += segments[i].length;
+    }
+    if(0 == total) {
+        return 0;
+    }
+
+    /* A receive() may be one transfer on the bus that cannot be split at
+     * a segment boundary, so the whole message is taken at once and then
+     * spread across the segments.
+     */
+    vector<byte> temp(total);
+    retval = receive(temp, total);
+    if(retval <= 0) {
+        return 0;
+    }
+
+    for(i = 0; i < count && copied < (unsigned int)retval; i++) {
+        unsigned int n = segments[i].length;
+        if(n > (unsigned int)retval - copied) {
+            n = (unsigned int)retval - copied;
+        }
+        copy(temp.begin() + copied, temp.begin() + copied + n, segments[i].data);
+        copied += n;
+    }
+    return (int)copied;
+}
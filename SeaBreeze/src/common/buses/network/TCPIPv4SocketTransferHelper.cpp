@@ -44,8 +44,26 @@ TCPIPv4SocketTransferHelper::~TCPIPv4SocketTransferHelper() {
 
 int TCPIPv4SocketTransferHelper::receive(vector<byte> &buffer,
         unsigned int length) throw (BusTransferException) {
-    
-    unsigned char *rawBuffer = (unsigned char *)&buffer[0];
+    return TCPIPv4SocketTransferHelper::receiveInto(buffer, 0, length);
+}
+
+int TCPIPv4SocketTransferHelper::receiveInto(vector<byte> &buffer,
+        unsigned int offset, unsigned int length) throw (BusTransferException) {
+    TransferSegment segment;
+
+    if(buffer.size() < offset + length) {
+        string error("Receive buffer is too small for the requested transfer.");
+        throw BusTransferException(error);
+    }
+
+    segment.data = &buffer[0] + offset;
+    segment.length = length;
+    return TCPIPv4SocketTransferHelper::receiveSegments(&segment, 1);
+}
+
+int TCPIPv4SocketTransferHelper::receiveSegments(
+        const TransferSegment *segments, unsigned int count)
+        throw (BusTransferException) {
     unsigned int bytesRead = 0;
     
     /* TODO: There should be a couple alternatives for this.  One should
@@ -54,16 +72,21 @@ int TCPIPv4SocketTransferHelper::receive(vector<byte> &buffer,
      * to do next.
      */
     try {
-        while(bytesRead < length) {
-            int result = this->socket->read(&rawBuffer[bytesRead],
-                    length - bytesRead);
-            if(result > 0) {
-                bytesRead += result;
-            } else {
-                /* This should only be possible if a timeout was set for the
-                 * socket.
-                 */
-                break;
+        for(unsigned int i = 0; i < count; i++) {
+            unsigned char *rawBuffer = (unsigned char *)segments[i].data;
+            unsigned int segmentRead = 0;
+            while(segmentRead < segments[i].length) {
+                int result = this->socket->read(&rawBuffer[segmentRead],
+                        segments[i].length - segmentRead);
+                if(result > 0) {
+                    segmentRead += result;
+                    bytesRead += result;
+                } else {
+                    /* This should only be possible if a timeout was set for
+                     * the socket.
+                     */
+                    return bytesRead;
+                }
             }
         }
     } catch (BusTransferException &bte) {
@@ -74,6 +97,28 @@ int TCPIPv4SocketTransferHelper::receive(vector<byte> &buffer,
     return bytesRead;
 }
 
+void TCPIPv4SocketTransferHelper::setReceiveTimeoutMillis(
+        unsigned int timeoutMillis) {
+    /* The buses open the socket with no timeout, which zero restores */
+    try {
+        this->socket->setReadTimeoutMillis(timeoutMillis);
+    } catch (SocketException &se) {
+        /* Reads just stay unbounded */
+    }
+}
+
+unsigned int TCPIPv4SocketTransferHelper::getReceiveTimeoutMillis() {
+    try {
+        return (unsigned int)this->socket->getReadTimeoutMillis();
+    } catch (SocketException &se) {
+        return 0;
+    }
+}
+
+bool TCPIPv4SocketTransferHelper::isReceiveTimeoutEnforced() {
+    return true;
+}
+
 int TCPIPv4SocketTransferHelper::send(const vector<byte> &buffer,
         unsigned int length) const throw (BusTransferException) {
     
@@ -45,25 +45,49 @@ RS232TransferHelper::~RS232TransferHelper() {
 
 int RS232TransferHelper::receive(vector<byte> &buffer, unsigned int length)
         throw (BusTransferException) {
+    return RS232TransferHelper::receiveInto(buffer, 0, length);
+}
+
+int RS232TransferHelper::receiveInto(vector<byte> &buffer, unsigned int offset,
+        unsigned int length) throw (BusTransferException) {
+    TransferSegment segment;
+
+    if(buffer.size() < offset + length) {
+        string error("Receive buffer is too small for the requested transfer.");
+        throw BusTransferException(error);
+    }
+
+    segment.data = &(buffer[0]) + offset;
+    segment.length = length;
+    return RS232TransferHelper::receiveSegments(&segment, 1);
+}
+
+int RS232TransferHelper::receiveSegments(const TransferSegment *segments,
+        unsigned int count) throw (BusTransferException) {
     int retval = 0;
-    unsigned int bytesRead = 0;
+    unsigned int total = 0;
 
-    while(bytesRead < length) {
-        retval = this->rs232->read((void *)&(buffer[bytesRead]), length - bytesRead);
-        if(retval < 0) {
-            string error("Failed to read any data from RS232.");
-            throw BusTransferException(error);
-        } else if(retval != 0) {
-            bytesRead += retval;
-        } else {
-            /* Not enough data available to satisfy the request.  Wait for more
-             * data to arrive.
-             */
-            System::sleepMilliseconds(10);
+    for(unsigned int i = 0; i < count; i++) {
+        unsigned int bytesRead = 0;
+        while(bytesRead < segments[i].length) {
+            retval = this->rs232->read((void *)(segments[i].data + bytesRead),
+                    segments[i].length - bytesRead);
+            if(retval < 0) {
+                string error("Failed to read any data from RS232.");
+                throw BusTransferException(error);
+            } else if(retval != 0) {
+                bytesRead += retval;
+            } else {
+                /* Not enough data available to satisfy the request.  Wait for more
+                 * data to arrive.
+                 */
+                System::sleepMilliseconds(10);
+            }
         }
+        total += bytesRead;
     }
 
-    return bytesRead;
+    return total;
 }
 
 int RS232TransferHelper::send(const vector<byte> &buffer, unsigned int length) const
@@ -30,6 +30,7 @@
 #include "common/globals.h"
 #include "common/buses/usb/USBTransferHelper.h"
 #include <string>
+#include <algorithm>
 
 using namespace seabreeze;
 using namespace std;
@@ -39,10 +40,12 @@ USBTransferHelper::USBTransferHelper(USB *usbDescriptor, int sendEndpoint,
     this->usb = usbDescriptor;
     this->sendEndpoint = sendEndpoint;
     this->receiveEndpoint = receiveEndpoint;
+    this->receiveTimeoutMillis = 0;
 }
 
 USBTransferHelper::USBTransferHelper(USB *usbDescriptor) : TransferHelper() {
     this->usb = usbDescriptor;
+    this->receiveTimeoutMillis = 0;
 }
 
 USBTransferHelper::~USBTransferHelper() {
@@ -51,18 +54,118 @@ USBTransferHelper::~USBTransferHelper() {
 
 int USBTransferHelper::receive(vector<byte> &buffer, unsigned int length)
         throw (BusTransferException) {
-    int retval = 0;
+    return USBTransferHelper::receiveInto(buffer, 0, length);
+}
 
-    retval = this->usb->read(this->receiveEndpoint, (void *)&(buffer[0]), length);
+int USBTransferHelper::receiveInto(vector<byte> &buffer, unsigned int offset,
+        unsigned int length) throw (BusTransferException) {
+    TransferSegment segment;
 
-    if((0 == retval && length > 0) || (retval < 0)) {
-        string error("Failed to read any data from USB.");
+    if(buffer.size() < offset + length) {
+        string error("Receive buffer is too small for the requested transfer.");
         throw BusTransferException(error);
     }
 
+    segment.data = &(buffer[0]) + offset;
+    segment.length = length;
+    return USBTransferHelper::receiveSegments(&segment, 1);
+}
+
+int USBTransferHelper::receiveSegments(const TransferSegment *segments,
+        unsigned int count) throw (BusTransferException) {
+    unsigned int total = 0;
+
+    for(unsigned int i = 0; i < count; i++) {
+        total += segments[i].length;
+    }
+
+    return readSegments(segments, count, total);
+}
+
+void USBTransferHelper::setReceiveTimeoutMillis(unsigned int timeoutMillis) {
+    this->receiveTimeoutMillis = timeoutMillis;
+}
+
+unsigned int USBTransferHelper::getReceiveTimeoutMillis() {
+    return this->receiveTimeoutMillis;
+}
+
+bool USBTransferHelper::isReceiveTimeoutEnforced() {
+    return this->usb->hasQueuedReads();
+}
+
+int USBTransferHelper::read(void *data, unsigned int length)
+        throw (BusTransferException) {
+    int ticket;
+    int retval;
+
+    if(0 == this->receiveTimeoutMillis) {
+        return this->usb->read(this->receiveEndpoint, data, length);
+    }
+
+    ticket = this->usb->submitRead(this->receiveEndpoint, data, length);
+    if(ticket < 0) {
+        return -1;
+    }
+    retval = this->usb->completeRead(ticket, (int)this->receiveTimeoutMillis);
+    if(READ_PENDING == retval) {
+        this->usb->cancelRead(ticket);
+        string error("Timed out waiting for data from USB.");
+        throw BusTransferException(error);
+    }
     return retval;
 }
 
+int USBTransferHelper::readSegments(const TransferSegment *segments,
+        unsigned int count, unsigned int length) throw (BusTransferException) {
+    unsigned int first = 0;
+    unsigned int last = count;
+    int retval;
+
+    if(0 == length) {
+        return 0;
+    }
+
+    /* Empty segments take no part in the read */
+    while(first < last && 0 == segments[first].length) {
+        first++;
+    }
+    while(last > first && 0 == segments[last - 1].length) {
+        last--;
+    }
+
+    if(last - first == 1 && segments[first].length == length) {
+        retval = read((void *)segments[first].data, length);
+        if(retval <= 0) {
+            string error("Failed to read any data from USB.");
+            throw BusTransferException(error);
+        }
+        return retval;
+    }
+
+    if(this->scratch.size() < length) {
+        this->scratch.resize(length);
+    }
+    retval = read((void *)&(this->scratch[0]), length);
+    if(retval <= 0) {
+        string error("Failed to read any data from USB.");
+        throw BusTransferException(error);
+    }
+
+    /* A short packet may end the transfer before every segment is full */
+    unsigned int copied = 0;
+    for(unsigned int i = first; i < last && copied < (unsigned int)retval; i++) {
+        unsigned int n = segments[i].length;
+        if(n > (unsigned int)retval - copied) {
+            n = (unsigned int)retval - copied;
+        }
+        copy(this->scratch.begin() + copied,
+                this->scratch.begin() + copied + n, segments[i].data);
+        copied += n;
+    }
+    return (int)copied;
+}
+
 int USBTransferHelper::send(const vector<byte> &buffer, unsigned int length) const
         throw (BusTransferException) {
     int retval = 0;
@@ -29,6 +29,7 @@
 
 #include "common/globals.h"
 #include "common/devices/Device.h"
+#include "common/features/CalibrationCacheInterface.h"
 #include "api/seabreezeapi/SeaBreezeAPIConstants.h"
 
 #ifdef _WINDOWS
@@ -189,6 +190,17 @@ void Device::close() {
     this->openedBus->close();
 
     this->openedBus = NULL;
+
+    /* Whatever is opened at this location next might not be the same unit,
+     * so any calibration read from this one cannot be trusted any longer.
+     */
+    vector<Feature *>::iterator fIter;
+    for(fIter = this->features.begin(); fIter != this->features.end(); fIter++) {
+        CalibrationCacheInterface *cache = dynamic_cast<CalibrationCacheInterface *>(*fIter);
+        if(NULL != cache) {
+            cache->invalidateCalibration();
+        }
+    }
 }
 
 Bus *Device::getOpenedBus() {
@@ -0,0 +1,77 @@
+/***************************************************//**
+ * @file    DeviceDescriptor.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This holds the values that describe one particular
+ * device (e.g. its pixel layout and calibrations) by name
+ * so that they can be stored and given back to the
+ * features later without asking the hardware again.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "common/devices/DeviceDescriptor.h"
+
+using namespace seabreeze;
+using namespace std;
+
+DeviceDescriptor::DeviceDescriptor() {
+
+}
+
+DeviceDescriptor::~DeviceDescriptor() {
+
+}
+
+void DeviceDescriptor::setValues(const string &name, const vector<double> &values) {
+    this->entries[name] = values;
+}
+
+const vector<double> *DeviceDescriptor::getValues(const string &name) const {
+    map<string, vector<double> >::const_iterator iter = this->entries.find(name);
+    if(this->entries.end() == iter) {
+        return NULL;
+    }
+    return &(iter->second);
+}
+
+vector<string> DeviceDescriptor::getNames() const {
+    vector<string> retval;
+    map<string, vector<double> >::const_iterator iter;
+
+    for(iter = this->entries.begin(); iter != this->entries.end(); iter++) {
+        retval.push_back(iter->first);
+    }
+    return retval;
+}
+
+bool DeviceDescriptor::isEmpty() const {
+    return this->entries.empty();
+}
+
+void DeviceDescriptor::clear() {
+    this->entries.clear();
+}
@@ -0,0 +1,315 @@
+/***************************************************//**
+ * @file    DeviceDescriptorCache.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This keeps DeviceDescriptors in a file so that they
+ * survive from one run to the next.  Each descriptor is
+ * filed under a key made from the device model, serial
+ * number and firmware revision, so a different unit or a
+ * firmware update never matches an old entry.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "common/devices/DeviceDescriptorCache.h"
+#include "native/system/NativeSystem.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+
+using namespace seabreeze;
+using namespace std;
+
+/* The file is plain text, one entry per line:
+ *
+ *   device <key>
+ *   <name> <count> <value> <value> ...
+ *   end
+ */
+#define DESCRIPTOR_CACHE_HEADER "# SeaBreeze device descriptor cache, version 1"
+
+/* Held while the file is read or replaced.  The cache file itself cannot
+ * be locked because it is replaced by renaming.
+ */
+#define DESCRIPTOR_CACHE_LOCK_SUFFIX ".lock"
+
+vector<DeviceDescriptorCache *> DeviceDescriptorCache::instances;
+Mutex DeviceDescriptorCache::instancesLock;
+
+namespace {
+    /* Holds the lock file for as long as it is in scope */
+    class FileLock {
+    public:
+        FileLock(const string &path) {
+            this->handle = fileLockAcquire(path.c_str());
+        }
+        ~FileLock() {
+            if(NULL != this->handle) {
+                fileLockRelease(this->handle);
+            }
+        }
+        bool isLocked() const {
+            return NULL != this->handle;
+        }
+    private:
+        FileLock(const FileLock &that);
+        FileLock &operator=(const FileLock &that);
+
+        void *handle;
+    };
+}
+
+DeviceDescriptorCache::DeviceDescriptorCache(const string &path) {
+    this->path = path;
+
+    MutexLock guard(instancesLock);
+    instances.push_back(this);
+}
+
+DeviceDescriptorCache::~DeviceDescriptorCache() {
+    /* Waits out any forgetEverywhere() that is using this one */
+    MutexLock guard(instancesLock);
+    instances.erase(std::remove(instances.begin(), instances.end(), this),
+            instances.end());
+}
+
+const string &DeviceDescriptorCache::getPath() const {
+    return this->path;
+}
+
+string DeviceDescriptorCache::makeKey(const string &model,
+        const string &serialNumber, const string &firmwareRevision) {
+    string parts[3];
+    string retval;
+    unsigned int i;
+    unsigned int j;
+
+    parts[0] = model;
+    parts[1] = serialNumber;
+    parts[2] = firmwareRevision;
+
+    for(i = 0; i < 3; i++) {
+        if(i > 0) {
+            retval += '/';
+        }
+        /* The key has to be a single word in the file */
+        for(j = 0; j < parts[i].length(); j++) {
+            char c = parts[i][j];
+            if(c <= ' ' || '/' == c || 0x7F == c) {
+                c = '_';
+            }
+            retval += c;
+        }
+    }
+    return retval;
+}
+
+void DeviceDescriptorCache::forgetEverywhere(const string &key) {
+    vector<DeviceDescriptorCache *>::iterator iter;
+
+    MutexLock guard(instancesLock);
+    for(iter = instances.begin(); iter != instances.end(); iter++) {
+        (*iter)->remove(key);
+        (*iter)->save();
+    }
+}
+
+bool DeviceDescriptorCache::find(const string &key,
+        DeviceDescriptor &descriptor) const {
+    MutexLock guard(this->lock);
+
+    map<string, DeviceDescriptor>::const_iterator iter = this->descriptors.find(key);
+    if(this->descriptors.end() == iter) {
+        return false;
+    }
+    descriptor = iter->second;
+    return true;
+}
+
+void DeviceDescriptorCache::store(const string &key, const DeviceDescriptor &descriptor) {
+    MutexLock guard(this->lock);
+    this->descriptors[key] = descriptor;
+    this->changedKeys.insert(key);
+}
+
+void DeviceDescriptorCache::remove(const string &key) {
+    MutexLock guard(this->lock);
+    this->descriptors.erase(key);
+    this->changedKeys.insert(key);
+}
+
+bool DeviceDescriptorCache::load() {
+    MutexLock guard(this->lock);
+    FileLock fileLock(this->path + DESCRIPTOR_CACHE_LOCK_SUFFIX);
+
+    this->descriptors.clear();
+    this->changedKeys.clear();
+
+    if(false == fileLock.isLocked()) {
+        return false;
+    }
+    return readFile(this->descriptors);
+}
+
+bool DeviceDescriptorCache::save() {
+    map<string, DeviceDescriptor> merged;
+    set<string>::iterator key;
+
+    MutexLock guard(this->lock);
+    FileLock fileLock(this->path + DESCRIPTOR_CACHE_LOCK_SUFFIX);
+
+    if(false == fileLock.isLocked() || false == readFile(merged)) {
+        return false;
+    }
+
+    /* Only what changed here overrides the file; everything else in it may
+     * have been written by another process since this one last read it.
+     */
+    for(key = this->changedKeys.begin(); key != this->changedKeys.end(); key++) {
+        map<string, DeviceDescriptor>::iterator mine = this->descriptors.find(*key);
+        if(this->descriptors.end() == mine) {
+            merged.erase(*key);
+        } else {
+            merged[*key] = mine->second;
+        }
+    }
+
+    if(false == writeFile(merged)) {
+        return false;
+    }
+
+    this->descriptors = merged;
+    this->changedKeys.clear();
+    return true;
+}
+
+bool DeviceDescriptorCache::readFile(map<string, DeviceDescriptor> &entries) const {
+    string line;
+    string key;
+    DeviceDescriptor descriptor;
+    bool inDevice = false;
+    bool valid = false;
+
+    ifstream file(this->path.c_str());
+    if(!file.is_open()) {
+        /* Nothing has been cached yet */
+        return true;
+    }
+
+    while(getline(file, line)) {
+        istringstream istr(line);
+        string word;
+
+        if(!(istr >> word) || '#' == word[0]) {
+            continue;
+        }
+
+        if("device" == word) {
+            inDevice = (istr >> key) ? true : false;
+            valid = inDevice;
+            descriptor.clear();
+        } else if("end" == word) {
+            if(true == inDevice && true == valid) {
+                entries[key] = descriptor;
+            }
+            inDevice = false;
+        } else if(true == inDevice) {
+            unsigned int count = 0;
+            unsigned int i;
+            if(!(istr >> count)) {
+                valid = false;
+                continue;
+            }
+            vector<double> values(count);
+            for(i = 0; i < count; i++) {
+                if(!(istr >> values[i])) {
+                    break;
+                }
+            }
+            if(i < count) {
+                /* Truncated, so do not trust any of this device's entries */
+                valid = false;
+                continue;
+            }
+            descriptor.setValues(word, values);
+        }
+    }
+
+    return !file.bad();
+}
+
+bool DeviceDescriptorCache::writeFile(const map<string, DeviceDescriptor> &entries) const {
+    map<string, DeviceDescriptor>::const_iterator iter;
+    string temporaryPath = this->path + ".tmp";
+
+    {
+        ofstream file(temporaryPath.c_str());
+        if(!file.is_open()) {
+            return false;
+        }
+
+        /* Enough digits that every double reads back exactly */
+        file.precision(17);
+        file << DESCRIPTOR_CACHE_HEADER << "\n";
+
+        for(iter = entries.begin(); iter != entries.end(); iter++) {
+            vector<string> names = iter->second.getNames();
+            vector<string>::iterator name;
+
+            file << "device " << iter->first << "\n";
+            for(name = names.begin(); name != names.end(); name++) {
+                const vector<double> *values = iter->second.getValues(*name);
+                file << *name << " " << values->size();
+                for(unsigned int i = 0; i < values->size(); i++) {
+                    file << " " << (*values)[i];
+                }
+                file << "\n";
+            }
+            file << "end\n";
+        }
+
+        file.close();
+        if(file.fail()) {
+            ::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+
+    /* Replace the old file in one step so that a reader never sees it half
+     * written.  Windows cannot rename over a file, but readers hold the
+     * lock file too, so none of them can look in between.
+     */
+#ifdef _WINDOWS
+    ::remove(this->path.c_str());
+#endif
+    if(0 != rename(temporaryPath.c_str(), this->path.c_str())) {
+        ::remove(temporaryPath.c_str());
+        return false;
+    }
+
+    return true;
+}
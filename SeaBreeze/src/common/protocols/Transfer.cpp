@@ -68,6 +68,26 @@ Transfer::~Transfer() {
 }
 
 Data *Transfer::transfer(TransferHelper *helper) throw (ProtocolException) {
+
+    transferBuffer(helper);
+
+    if(Transfer::FROM_DEVICE == this->direction) {
+        /* A copy is made of the data before it is sent out for two
+         * reasons.  First, this provides safety from the recipient
+         * trying to delete it.  Second, it will make it easier for this
+         * to be thread-safe later (though anything that touches the
+         * buffer internal to this instance will need to be synchronized
+         * with other accesses, especially where a derived class calls this
+         * method then expects the buffer to be filled in with
+         * something useful).  Yes, this incurs overhead, but not much.
+         */
+        ByteVector *retval = new ByteVector(*(this->buffer));
+        return retval;
+    }
+    return NULL;
+}
+
+void Transfer::transferBuffer(TransferHelper *helper) throw (ProtocolException) {
     int flag = 0;
 
     /* Execute the actual movement of the data in this object's buffer
@@ -85,7 +105,6 @@ Data *Transfer::transfer(TransferHelper *helper) throw (ProtocolException) {
             /* FIXME: there is probably a more descriptive type for this than ProtocolException */
             throw ProtocolException(error);
         }
-        return NULL;
     } else if(Transfer::FROM_DEVICE == this->direction) {
         try {
             flag = helper->receive(*(this->buffer), this->length);
@@ -98,24 +117,11 @@ Data *Transfer::transfer(TransferHelper *helper) throw (ProtocolException) {
             /* FIXME: there is probably a more descriptive type for this than ProtocolException */
             throw ProtocolException(error);
         }
-
-        /* A copy is made of the data before it is sent out for two
-         * reasons.  First, this provides safety from the recipient
-         * trying to delete it.  Second, it will make it easier for this
-         * to be thread-safe later (though anything that touches the
-         * buffer internal to this instance will need to be synchronized
-         * with other accesses, especially where a derived class calls this
-         * method then expects the buffer to be filled in with
-         * something useful).  Yes, this incurs overhead, but not much.
-         */
-        ByteVector *retval = new ByteVector(*(this->buffer));
-        return retval;
     } else {
         string error("Invalid transfer direction specified.");
         /* FIXME: there is probably a more descriptive type for this than ProtocolException */
         throw ProtocolException(error);
     }
-    return NULL;
 }
 
 void Transfer::checkBufferSize() {
@@ -42,7 +42,7 @@
 #include <string.h>
 
 #include "native/network/posix/NativeSocketPOSIX.h"
-#include "native/network/SocketTimeoutException.h"
+#include "common/exceptions/BusTransferException.h"
 
 using namespace seabreeze;
 using namespace std;
@@ -238,9 +238,13 @@ int NativeSocketPOSIX::read(unsigned char *buf, unsigned long count)
     int result = ::read(this->sock, buf, count);
     
     if(result < 0) {
-        if(EAGAIN == errno) {
-            string error("No data available on non-blocking socket.");
-            throw SocketTimeoutException(error);
+        if(EAGAIN == errno || EWOULDBLOCK == errno) {
+            /* This is a BusTransferException rather than a
+             * SocketTimeoutException since that is all this is declared to
+             * throw; anything else would abort the program.
+             */
+            string error("Timed out waiting for data on socket.");
+            throw BusTransferException(error);
         } else {
             string error("Socket error on read: ");
             error += strerror(errno);
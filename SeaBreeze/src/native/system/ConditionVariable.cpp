@@ -0,0 +1,57 @@
+/***************************************************//**
+ * @file    ConditionVariable.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * The ConditionVariable class wraps the native condition
+ * variable primitive.  It is always used together with a Mutex.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "native/system/ConditionVariable.h"
+#include "native/system/NativeSystem.h"
+
+using namespace seabreeze;
+
+ConditionVariable::ConditionVariable() {
+    this->handle = conditionCreate();
+}
+
+ConditionVariable::~ConditionVariable() {
+    conditionDestroy(this->handle);
+}
+
+bool ConditionVariable::wait(Mutex &mutex, int timeoutMillis) {
+    return 0 == conditionWait(this->handle, mutex.handle, timeoutMillis);
+}
+
+void ConditionVariable::signal() {
+    conditionSignal(this->handle);
+}
+
+void ConditionVariable::broadcast() {
+    conditionBroadcast(this->handle);
+}
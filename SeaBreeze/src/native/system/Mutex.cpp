@@ -0,0 +1,61 @@
+/***************************************************//**
+ * @file    Mutex.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * The Mutex class wraps the native mutex primitive, and
+ * MutexLock holds a Mutex for the lifetime of a scope.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "native/system/Mutex.h"
+#include "native/system/NativeSystem.h"
+
+using namespace seabreeze;
+
+Mutex::Mutex() {
+    this->handle = mutexCreate();
+}
+
+Mutex::~Mutex() {
+    mutexDestroy(this->handle);
+}
+
+void Mutex::lock() {
+    mutexLock(this->handle);
+}
+
+void Mutex::unlock() {
+    mutexUnlock(this->handle);
+}
+
+MutexLock::MutexLock(Mutex &m) : mutex(m) {
+    this->mutex.lock();
+}
+
+MutexLock::~MutexLock() {
+    this->mutex.unlock();
+}
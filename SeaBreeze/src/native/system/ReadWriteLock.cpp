@@ -0,0 +1,99 @@
+/***************************************************//**
+ * @file    ReadWriteLock.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * The ReadWriteLock class lets any number of readers share
+ * a resource while writers get exclusive access to it.
+ * ReadLock and WriteLock hold it for the lifetime of a scope.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "native/system/ReadWriteLock.h"
+
+using namespace seabreeze;
+
+ReadWriteLock::ReadWriteLock() {
+    this->readers = 0;
+    this->writersWaiting = 0;
+    this->writing = false;
+}
+
+ReadWriteLock::~ReadWriteLock() {
+
+}
+
+void ReadWriteLock::lockRead() {
+    MutexLock guard(this->mutex);
+
+    while(true == this->writing || this->writersWaiting > 0) {
+        this->changed.wait(this->mutex);
+    }
+    this->readers++;
+}
+
+void ReadWriteLock::unlockRead() {
+    MutexLock guard(this->mutex);
+
+    this->readers--;
+    if(0 == this->readers) {
+        this->changed.broadcast();
+    }
+}
+
+void ReadWriteLock::lockWrite() {
+    MutexLock guard(this->mutex);
+
+    this->writersWaiting++;
+    while(true == this->writing || this->readers > 0) {
+        this->changed.wait(this->mutex);
+    }
+    this->writersWaiting--;
+    this->writing = true;
+}
+
+void ReadWriteLock::unlockWrite() {
+    MutexLock guard(this->mutex);
+
+    this->writing = false;
+    this->changed.broadcast();
+}
+
+ReadLock::ReadLock(ReadWriteLock &l) : lock(l) {
+    this->lock.lockRead();
+}
+
+ReadLock::~ReadLock() {
+    this->lock.unlockRead();
+}
+
+WriteLock::WriteLock(ReadWriteLock &l) : lock(l) {
+    this->lock.lockWrite();
+}
+
+WriteLock::~WriteLock() {
+    this->lock.unlockWrite();
+}
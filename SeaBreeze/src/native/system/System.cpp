@@ -53,6 +53,10 @@ void System::sleepMilliseconds(unsigned int millis) {
     ::sleepMilliseconds(millis);
 }
 
+unsigned long long System::getMonotonicMicros() {
+    return ::monotonicMicros();
+}
+
 bool System::initialize() {
     /* Delegate to the native C startup function. */
     int result = ::systemInitialize();
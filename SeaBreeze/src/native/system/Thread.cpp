@@ -0,0 +1,77 @@
+/***************************************************//**
+ * @file    Thread.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * The Thread class wraps the native thread primitive.  A
+ * subclass provides run(), which is executed on a new
+ * thread by start().
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "native/system/Thread.h"
+#include "native/system/NativeSystem.h"
+#include <stdlib.h>
+
+using namespace seabreeze;
+
+Thread::Thread() {
+    this->handle = NULL;
+}
+
+Thread::~Thread() {
+    /* Subclasses must join() before their own members are destroyed since
+     * run() may still be using them; this is just a last resort.
+     */
+    join();
+}
+
+bool Thread::start() {
+    if(NULL != this->handle) {
+        return false;
+    }
+
+    this->handle = threadCreate(Thread::entryPoint, this);
+    return NULL != this->handle;
+}
+
+void Thread::join() {
+    if(NULL == this->handle) {
+        return;
+    }
+
+    threadJoin(this->handle);
+    this->handle = NULL;
+}
+
+bool Thread::isStarted() {
+    return NULL != this->handle;
+}
+
+void *Thread::entryPoint(void *self) {
+    ((Thread *)self)->run();
+    return NULL;
+}
@@ -33,10 +33,15 @@
  *******************************************************/
 
 /* Definitions */
-#define _POSIX_C_SOURCE 199309  /* Needed for Linux to define POSIX level */
+#define _POSIX_C_SOURCE 200112L /* Needed for Linux to define POSIX level */
 
 #include "common/globals.h"
 #include <time.h>               /* For definition of nanosleep() */
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
 #include "native/system/NativeSystem.h"
 
 /* Function definitions */
@@ -49,8 +54,8 @@ void sleepMilliseconds(unsigned int msecs) {
      * resolution) with something that can report time left in case the
      * delay was interrupted.
      *
-     * If p-threads or some other mechanism is ever added to SeaBreeze then
-     * this may need to be replaced with something more thread-aware.
+     * nanosleep() only suspends the calling thread, so this is safe to
+     * use from any of the threads created below.
      */
     ts.tv_sec = msecs/1000;                 /* Whole seconds portion */
     ts.tv_nsec = (msecs % 1000) * 1000000;  /* Fraction in nanoseconds */
@@ -69,3 +74,175 @@ int systemInitialize() {
 void systemShutdown() {
     /* There are no system-wide services to shut down. */
 }
+
+void *threadCreate(void *(*function)(void *), void *argument) {
+    pthread_t *thread;
+
+    thread = (pthread_t *)malloc(sizeof(pthread_t));
+    if(NULL == thread) {
+        return NULL;
+    }
+
+    if(0 != pthread_create(thread, NULL, function, argument)) {
+        free(thread);
+        return NULL;
+    }
+
+    return thread;
+}
+
+void threadJoin(void *thread) {
+    if(NULL == thread) {
+        return;
+    }
+
+    pthread_join(*((pthread_t *)thread), NULL);
+    free(thread);
+}
+
+void *mutexCreate() {
+    pthread_mutex_t *mutex;
+
+    mutex = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
+    if(NULL == mutex) {
+        return NULL;
+    }
+
+    if(0 != pthread_mutex_init(mutex, NULL)) {
+        free(mutex);
+        return NULL;
+    }
+
+    return mutex;
+}
+
+void mutexLock(void *mutex) {
+    pthread_mutex_lock((pthread_mutex_t *)mutex);
+}
+
+void mutexUnlock(void *mutex) {
+    pthread_mutex_unlock((pthread_mutex_t *)mutex);
+}
+
+void mutexDestroy(void *mutex) {
+    if(NULL == mutex) {
+        return;
+    }
+
+    pthread_mutex_destroy((pthread_mutex_t *)mutex);
+    free(mutex);
+}
+
+void *conditionCreate() {
+    pthread_cond_t *condition;
+
+    condition = (pthread_cond_t *)malloc(sizeof(pthread_cond_t));
+    if(NULL == condition) {
+        return NULL;
+    }
+
+    if(0 != pthread_cond_init(condition, NULL)) {
+        free(condition);
+        return NULL;
+    }
+
+    return condition;
+}
+
+int conditionWait(void *condition, void *mutex, int timeoutMillis) {
+    struct timespec deadline;
+
+    if(timeoutMillis < 0) {
+        return pthread_cond_wait((pthread_cond_t *)condition,
+                (pthread_mutex_t *)mutex);
+    }
+
+    /* pthread_cond_timedwait() takes an absolute time on the realtime clock */
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeoutMillis / 1000;
+    deadline.tv_nsec += (timeoutMillis % 1000) * 1000000L;
+    if(deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    if(ETIMEDOUT == pthread_cond_timedwait((pthread_cond_t *)condition,
+            (pthread_mutex_t *)mutex, &deadline)) {
+        return 1;
+    }
+    return 0;
+}
+
+void conditionSignal(void *condition) {
+    pthread_cond_signal((pthread_cond_t *)condition);
+}
+
+void conditionBroadcast(void *condition) {
+    pthread_cond_broadcast((pthread_cond_t *)condition);
+}
+
+void conditionDestroy(void *condition) {
+    if(NULL == condition) {
+        return;
+    }
+
+    pthread_cond_destroy((pthread_cond_t *)condition);
+    free(condition);
+}
+
+unsigned int atomicLoad(volatile unsigned int *value) {
+    unsigned int result = *value;
+
+    /* Nothing that follows may be read before the value itself */
+    __sync_synchronize();
+    return result;
+}
+
+void atomicStore(volatile unsigned int *value, unsigned int newValue) {
+    /* Everything written so far must be visible before the new value */
+    __sync_synchronize();
+    *value = newValue;
+}
+
+unsigned long long monotonicMicros() {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long long)now.tv_sec * 1000000ULL
+            + (unsigned long long)(now.tv_nsec / 1000);
+}
+
+void *fileLockAcquire(const char *path) {
+    struct flock region;
+    int *fd;
+
+    fd = (int *)malloc(sizeof(int));
+    if(NULL == fd) {
+        return NULL;
+    }
+    *fd = open(path, O_RDWR | O_CREAT, 0666);
+    if(*fd < 0) {
+        free(fd);
+        return NULL;
+    }
+
+    /* The whole file, however long it gets */
+    region.l_type = F_WRLCK;
+    region.l_whence = SEEK_SET;
+    region.l_start = 0;
+    region.l_len = 0;
+    while(0 != fcntl(*fd, F_SETLKW, &region)) {
+        if(EINTR != errno) {
+            close(*fd);
+            free(fd);
+            return NULL;
+        }
+    }
+    return fd;
+}
+
+void fileLockRelease(void *lock) {
+    /* Closing the file drops the lock */
+    close(*(int *)lock);
+    free(lock);
+}
@@ -33,6 +33,8 @@
 #include "common/globals.h"
 #include <winsock2.h>              /* Must include winsock2.h before windows.h */
 #include <windows.h>               /* For definition of Sleep() */
+#include <stdlib.h>
+#include <string.h>
 #include "native/system/NativeSystem.h"
 
 /* Function definitions */
@@ -64,3 +66,176 @@ void systemShutdown() {
     /* Need to tell WinSock to shut down cleanly. */
     WSACleanup();
 }
+
+/* CreateThread() wants a different function signature than the one that
+ * the rest of SeaBreeze uses, so this trampoline carries the real function
+ * and argument across.
+ */
+typedef struct {
+    void *(*function)(void *);
+    void *argument;
+    HANDLE handle;
+} __thread_t;
+
+static DWORD WINAPI __thread_trampoline(LPVOID param) {
+    __thread_t *thread = (__thread_t *)param;
+    thread->function(thread->argument);
+    return 0;
+}
+
+void *threadCreate(void *(*function)(void *), void *argument) {
+    __thread_t *thread;
+
+    thread = (__thread_t *)calloc(1, sizeof(__thread_t));
+    if(NULL == thread) {
+        return NULL;
+    }
+
+    thread->function = function;
+    thread->argument = argument;
+    thread->handle = CreateThread(NULL, 0, __thread_trampoline, thread, 0, NULL);
+    if(NULL == thread->handle) {
+        free(thread);
+        return NULL;
+    }
+
+    return thread;
+}
+
+void threadJoin(void *thread) {
+    __thread_t *t = (__thread_t *)thread;
+
+    if(NULL == t) {
+        return;
+    }
+
+    WaitForSingleObject(t->handle, INFINITE);
+    CloseHandle(t->handle);
+    free(t);
+}
+
+void *mutexCreate() {
+    CRITICAL_SECTION *mutex;
+
+    mutex = (CRITICAL_SECTION *)malloc(sizeof(CRITICAL_SECTION));
+    if(NULL == mutex) {
+        return NULL;
+    }
+
+    InitializeCriticalSection(mutex);
+    return mutex;
+}
+
+void mutexLock(void *mutex) {
+    EnterCriticalSection((CRITICAL_SECTION *)mutex);
+}
+
+void mutexUnlock(void *mutex) {
+    LeaveCriticalSection((CRITICAL_SECTION *)mutex);
+}
+
+void mutexDestroy(void *mutex) {
+    if(NULL == mutex) {
+        return;
+    }
+
+    DeleteCriticalSection((CRITICAL_SECTION *)mutex);
+    free(mutex);
+}
+
+void *conditionCreate() {
+    CONDITION_VARIABLE *condition;
+
+    condition = (CONDITION_VARIABLE *)malloc(sizeof(CONDITION_VARIABLE));
+    if(NULL == condition) {
+        return NULL;
+    }
+
+    InitializeConditionVariable(condition);
+    return condition;
+}
+
+int conditionWait(void *condition, void *mutex, int timeoutMillis) {
+    DWORD timeout = (timeoutMillis < 0) ? INFINITE : (DWORD)timeoutMillis;
+
+    if(0 == SleepConditionVariableCS((CONDITION_VARIABLE *)condition,
+            (CRITICAL_SECTION *)mutex, timeout)) {
+        return 1;
+    }
+    return 0;
+}
+
+void conditionSignal(void *condition) {
+    WakeConditionVariable((CONDITION_VARIABLE *)condition);
+}
+
+void conditionBroadcast(void *condition) {
+    WakeAllConditionVariable((CONDITION_VARIABLE *)condition);
+}
+
+void conditionDestroy(void *condition) {
+    /* Windows condition variables do not need to be torn down */
+    free(condition);
+}
+
+unsigned int atomicLoad(volatile unsigned int *value) {
+    unsigned int result = *value;
+
+    /* Nothing that follows may be read before the value itself */
+    MemoryBarrier();
+    return result;
+}
+
+void atomicStore(volatile unsigned int *value, unsigned int newValue) {
+    /* Everything written so far must be visible before the new value */
+    MemoryBarrier();
+    *value = newValue;
+}
+
+unsigned long long monotonicMicros() {
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    /* Split up so that the multiplication cannot overflow */
+    return (unsigned long long)(counter.QuadPart / frequency.QuadPart) * 1000000ULL
+            + (unsigned long long)(counter.QuadPart % frequency.QuadPart)
+                * 1000000ULL / frequency.QuadPart;
+}
+
+void *fileLockAcquire(const char *path) {
+    OVERLAPPED region;
+    HANDLE *file;
+
+    file = (HANDLE *)malloc(sizeof(HANDLE));
+    if(NULL == file) {
+        return NULL;
+    }
+    *file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE,
+            FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+            OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(INVALID_HANDLE_VALUE == *file) {
+        free(file);
+        return NULL;
+    }
+
+    /* Without LOCKFILE_FAIL_IMMEDIATELY this waits for the lock */
+    memset(&region, 0, sizeof(region));
+    if(0 == LockFileEx(*file, LOCKFILE_EXCLUSIVE_LOCK, 0, MAXDWORD, MAXDWORD, &region)) {
+        CloseHandle(*file);
+        free(file);
+        return NULL;
+    }
+    return file;
+}
+
+void fileLockRelease(void *lock) {
+    OVERLAPPED region;
+
+    memset(&region, 0, sizeof(region));
+    UnlockFileEx(*(HANDLE *)lock, 0, MAXDWORD, MAXDWORD, &region);
+    CloseHandle(*(HANDLE *)lock);
+    free(lock);
+}
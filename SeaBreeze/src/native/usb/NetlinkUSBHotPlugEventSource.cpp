@@ -0,0 +1,208 @@
+/***************************************************//**
+ * @file    NetlinkUSBHotPlugEventSource.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Listens for USB add and remove events from udev over a
+ * netlink socket.  On platforms other than Linux, open()
+ * always fails.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "native/usb/NetlinkUSBHotPlugEventSource.h"
+#include <string.h>
+#include <stdlib.h>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+/* udev re-broadcasts kernel events on this multicast group once the device
+ * node has been created, which is the earliest point that the device can
+ * actually be opened.
+ */
+#define UDEV_MONITOR_GROUP      2
+#define UDEV_MESSAGE_PREFIX     "libudev"
+/* Offset of the properties_off field in udev's message header */
+#define UDEV_PROPERTIES_OFFSET  16
+#define MAX_MESSAGE_LENGTH      8192
+
+using namespace seabreeze;
+
+NetlinkUSBHotPlugEventSource::NetlinkUSBHotPlugEventSource() {
+    this->sock = -1;
+}
+
+NetlinkUSBHotPlugEventSource::~NetlinkUSBHotPlugEventSource() {
+    close();
+}
+
+#ifdef __linux__
+
+bool NetlinkUSBHotPlugEventSource::open() {
+    struct sockaddr_nl address;
+
+    if(this->sock >= 0) {
+        return true;
+    }
+
+    this->sock = socket(AF_NETLINK, SOCK_DGRAM, NETLINK_KOBJECT_UEVENT);
+    if(this->sock < 0) {
+        return false;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.nl_family = AF_NETLINK;
+    address.nl_pid = 0;     /* Let the kernel pick */
+    address.nl_groups = UDEV_MONITOR_GROUP;
+
+    if(0 != bind(this->sock, (struct sockaddr *)&address, sizeof(address))) {
+        ::close(this->sock);
+        this->sock = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void NetlinkUSBHotPlugEventSource::close() {
+    if(this->sock >= 0) {
+        ::close(this->sock);
+        this->sock = -1;
+    }
+}
+
+bool NetlinkUSBHotPlugEventSource::waitForEvent(USBHotPlugEvent &event,
+        unsigned int timeoutMillis) {
+    struct pollfd pfd;
+    char message[MAX_MESSAGE_LENGTH];
+    ssize_t length;
+
+    if(this->sock < 0) {
+        return false;
+    }
+
+    pfd.fd = this->sock;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if(poll(&pfd, 1, (int)timeoutMillis) <= 0) {
+        return false;
+    }
+
+    length = recv(this->sock, message, sizeof(message) - 1, 0);
+    if(length <= 0) {
+        return false;
+    }
+    message[length] = '\0';
+
+    return parseEvent(message, (int)length, event);
+}
+
+bool NetlinkUSBHotPlugEventSource::parseEvent(const char *message, int length,
+        USBHotPlugEvent &event) {
+    /* A udev message is a binary header followed by NUL-separated
+     * KEY=VALUE properties.  The header gives the offset of the properties.
+     */
+    const char *action = NULL;
+    const char *product = NULL;
+    bool isUSBDevice = false;
+    unsigned int offset;
+    int i;
+
+    if(length < UDEV_PROPERTIES_OFFSET + 4
+            || 0 != strcmp(message, UDEV_MESSAGE_PREFIX)) {
+        return false;
+    }
+
+    memcpy(&offset, message + UDEV_PROPERTIES_OFFSET, sizeof(offset));
+    if(offset >= (unsigned int)length) {
+        return false;
+    }
+
+    for(i = (int)offset; i < length; i += (int)strlen(message + i) + 1) {
+        const char *property = message + i;
+        if(0 == strncmp(property, "ACTION=", 7)) {
+            action = property + 7;
+        } else if(0 == strncmp(property, "PRODUCT=", 8)) {
+            product = property + 8;
+        } else if(0 == strcmp(property, "DEVTYPE=usb_device")) {
+            isUSBDevice = true;
+        }
+    }
+
+    /* Interfaces on the device generate their own events; only the device
+     * itself is of interest.
+     */
+    if(false == isUSBDevice || NULL == action) {
+        return false;
+    }
+
+    if(0 == strcmp(action, "add")) {
+        event.action = USBHotPlugEvent::DEVICE_ADDED;
+    } else if(0 == strcmp(action, "remove")) {
+        event.action = USBHotPlugEvent::DEVICE_REMOVED;
+    } else {
+        return false;
+    }
+
+    /* PRODUCT is "vid/pid/bcdDevice" in hex without leading zeros */
+    event.vendorID = 0;
+    event.productID = 0;
+    if(NULL != product) {
+        char *end;
+        event.vendorID = (unsigned short)strtoul(product, &end, 16);
+        if('/' == *end) {
+            event.productID = (unsigned short)strtoul(end + 1, NULL, 16);
+        }
+    }
+
+    return true;
+}
+
+#else /* __linux__ */
+
+bool NetlinkUSBHotPlugEventSource::open() {
+    return false;
+}
+
+void NetlinkUSBHotPlugEventSource::close() {
+
+}
+
+bool NetlinkUSBHotPlugEventSource::waitForEvent(USBHotPlugEvent &event,
+        unsigned int timeoutMillis) {
+    return false;
+}
+
+bool NetlinkUSBHotPlugEventSource::parseEvent(const char *message, int length,
+        USBHotPlugEvent &event) {
+    return false;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,77 @@
+/***************************************************//**
+ * @file    SyntheticUSBHotPlugEventSource.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * A USBHotPlugEventSource that only delivers events that
+ * are injected into it.  This allows hot-plug handling to be
+ * exercised without any hardware attached.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "native/usb/SyntheticUSBHotPlugEventSource.h"
+
+using namespace seabreeze;
+
+SyntheticUSBHotPlugEventSource::SyntheticUSBHotPlugEventSource() {
+
+}
+
+SyntheticUSBHotPlugEventSource::~SyntheticUSBHotPlugEventSource() {
+
+}
+
+void SyntheticUSBHotPlugEventSource::inject(const USBHotPlugEvent &event) {
+    MutexLock guard(this->lock);
+    this->events.push_back(event);
+    this->eventReady.signal();
+}
+
+bool SyntheticUSBHotPlugEventSource::open() {
+    return true;
+}
+
+void SyntheticUSBHotPlugEventSource::close() {
+    MutexLock guard(this->lock);
+    this->events.clear();
+}
+
+bool SyntheticUSBHotPlugEventSource::waitForEvent(USBHotPlugEvent &event,
+        unsigned int timeoutMillis) {
+    MutexLock guard(this->lock);
+
+    if(this->events.empty()) {
+        this->eventReady.wait(this->lock, (int)timeoutMillis);
+    }
+
+    if(this->events.empty()) {
+        return false;
+    }
+
+    event = this->events.front();
+    this->events.pop_front();
+    return true;
+}
@@ -42,6 +42,8 @@ USB::USB(unsigned long id) {
     this->opened = false;
     this->descriptor = NULL;
     this->deviceID = id;
+    this->queuedReadsUnsupported = false;
+    this->nextDeferredTicket = 0;
 }
 
 USB::~USB() {
@@ -97,6 +99,7 @@ bool USB::close() {
 
     this->descriptor = NULL;
     this->opened = false;
+    this->pendingReads.clear();
     return retval;
 }
 
@@ -168,6 +171,110 @@ int USB::read(int endpoint, void *data, unsigned int length_bytes) {
     return flag;
 }
 
+int USB::submitRead(int endpoint, void *data, unsigned int length_bytes) {
+    int ticket;
+    PendingRead pending;
+
+    if(true == this->verbose) {
+        this->describeTransfer("<<", length_bytes, data, endpoint, false);
+    }
+
+    if(NULL == this->descriptor || false == this->opened) {
+        if(true == this->verbose) {
+            fprintf(stderr, "ERROR: tried to read a USB device that is not opened.\n");
+        }
+        return -1;
+    }
+
+    pending.endpoint = endpoint;
+    pending.data = data;
+    pending.result = READ_FAILED;
+
+    if(false == this->queuedReadsUnsupported) {
+        ticket = USBSubmitRead(this->descriptor, (unsigned char)endpoint,
+                (char *)data, (int)length_bytes);
+        if(ticket >= 0) {
+            this->pendingReads[ticket] = pending;
+            return ticket;
+        }
+        if(SUBMIT_UNSUPPORTED != ticket) {
+            if(true == this->verbose) {
+                fprintf(stderr, "Warning: got error %d while trying to queue a %d byte read on USB endpoint %d\n",
+                        ticket, length_bytes, endpoint);
+            }
+            return -1;
+        }
+        /* Remember this so the native layer is not asked again */
+        this->queuedReadsUnsupported = true;
+    }
+
+    /* No native support, so do the read now and hand back the result when
+     * the caller asks for it.
+     */
+    pending.result = USBRead(this->descriptor, (unsigned char)endpoint,
+            (char *)data, (int)length_bytes);
+    ticket = this->nextDeferredTicket++;
+    this->pendingReads[ticket] = pending;
+    return ticket;
+}
+
+int USB::completeRead(int ticket, int timeoutMillis) {
+    int flag;
+    map<int, PendingRead>::iterator iter;
+
+    iter = this->pendingReads.find(ticket);
+    if(this->pendingReads.end() == iter
+            || NULL == this->descriptor || false == this->opened) {
+        if(true == this->verbose) {
+            fprintf(stderr, "ERROR: tried to complete an unknown USB read.\n");
+        }
+        return -1;
+    }
+
+    if(true == this->queuedReadsUnsupported) {
+        flag = iter->second.result;
+    } else {
+        flag = USBCompleteRead(this->descriptor, ticket, timeoutMillis);
+        if(READ_PENDING == flag) {
+            return READ_PENDING;
+        }
+    }
+
+    if(flag < 0) {
+        if(true == this->verbose) {
+            fprintf(stderr, "Warning: got error %d while completing a read on USB endpoint %d\n",
+                    flag, iter->second.endpoint);
+        }
+        this->pendingReads.erase(iter);
+        return -1;
+    }
+
+    if(true == this->verbose) {
+        this->usbHexDump(iter->second.data, flag, iter->second.endpoint);
+    }
+
+    this->pendingReads.erase(iter);
+    return flag;
+}
+
+void USB::cancelRead(int ticket) {
+    map<int, PendingRead>::iterator iter;
+
+    iter = this->pendingReads.find(ticket);
+    if(this->pendingReads.end() == iter) {
+        return;
+    }
+
+    if(false == this->queuedReadsUnsupported && NULL != this->descriptor) {
+        USBCancelRead(this->descriptor, ticket);
+    }
+    this->pendingReads.erase(iter);
+}
+
+bool USB::hasQueuedReads() {
+    return false == this->queuedReadsUnsupported;
+}
+
 void USB::clearStall(int endpoint) {
 
     if(NULL == this->descriptor || false == this->opened) {
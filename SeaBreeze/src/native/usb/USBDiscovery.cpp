@@ -72,6 +72,32 @@ vector<unsigned long> *USBDiscovery::probeDevices(int vendorID, int productID) {
     return retval;
 }
 
+vector<USBProbedDevice> *USBDiscovery::probeDevices(
+        const vector<USBDeviceFilter> &filters) {
+    int deviceCount;
+    USBProbedDevice *deviceList;
+    vector<USBProbedDevice> *retval;
+
+    retval = new vector<USBProbedDevice>();
+    if(filters.empty()) {
+        return retval;
+    }
+
+    deviceList = (USBProbedDevice *)calloc(__MAX_USB_DEVICES, sizeof(USBProbedDevice));
+
+    deviceCount = USBProbeAllDevices(&filters[0], (int)filters.size(),
+        deviceList, __MAX_USB_DEVICES);
+
+    if(deviceCount > 0) {
+        /* As above, an error just results in an empty vector */
+        retval->assign(deviceList, deviceList + deviceCount);
+    }
+
+    free(deviceList);
+
+    return retval;
+}
+
 USB *USBDiscovery::createUSBInterface(unsigned long deviceID) {
     /* Create a USB instance with the given deviceID.  This constructor for
      * USB is protected, so this class uses a friend relationship to get
@@ -0,0 +1,100 @@
+/***************************************************//**
+ * @file    USBHotPlugMonitor.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * The USBHotPlugMonitor runs a thread that waits on a
+ * USBHotPlugEventSource and hands each event to a listener.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "native/usb/USBHotPlugMonitor.h"
+#include <stdlib.h>
+
+/* How often the monitor thread checks whether it has been asked to stop */
+#define POLL_INTERVAL_MILLIS    100
+
+using namespace seabreeze;
+
+USBHotPlugMonitor::USBHotPlugMonitor(USBHotPlugEventSource *src,
+        USBHotPlugListener *l) {
+    this->source = src;
+    this->listener = l;
+    this->stopRequested = false;
+}
+
+USBHotPlugMonitor::~USBHotPlugMonitor() {
+    stopMonitoring();
+    delete this->source;
+}
+
+bool USBHotPlugMonitor::startMonitoring() {
+    if(true == isStarted()) {
+        return true;
+    }
+
+    if(false == this->source->open()) {
+        return false;
+    }
+
+    this->lock.lock();
+    this->stopRequested = false;
+    this->lock.unlock();
+
+    if(false == start()) {
+        this->source->close();
+        return false;
+    }
+    return true;
+}
+
+void USBHotPlugMonitor::stopMonitoring() {
+    if(false == isStarted()) {
+        return;
+    }
+
+    this->lock.lock();
+    this->stopRequested = true;
+    this->lock.unlock();
+
+    join();
+    this->source->close();
+}
+
+bool USBHotPlugMonitor::isStopRequested() {
+    MutexLock guard(this->lock);
+    return this->stopRequested;
+}
+
+void USBHotPlugMonitor::run() {
+    USBHotPlugEvent event;
+
+    while(false == isStopRequested()) {
+        if(true == this->source->waitForEvent(event, POLL_INTERVAL_MILLIS)) {
+            this->listener->usbHotPlugEvent(event);
+        }
+    }
+}
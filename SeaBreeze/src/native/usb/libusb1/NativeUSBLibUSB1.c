@@ -0,0 +1,813 @@
+/***************************************************//**
+ * @file    NativeUSBLibUSB1.c
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This is an implementation of the USB interface using
+ * the libusb-1.0 API.  Unlike the libusb-0.1 implementation
+ * in NativeUSBLinux.c, bulk IN transfers are submitted
+ * asynchronously so that several reads can be queued on
+ * an endpoint at once.  Completions are collected by running
+ * the libusb event loop from the calling thread, so no
+ * background thread is required.  This is selected at build
+ * time with "make usb=libusb1" or the SEABREEZE_USB_LIBUSB1
+ * CMake option.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <libusb-1.0/libusb.h>
+#include <errno.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>  // for fprintf()
+#include <time.h>   // for clock_gettime()
+#include "native/usb/NativeUSB.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+
+/* Definitions and macros */
+#define MAX_USB_DEVICES             127
+#define MAX_QUEUED_TRANSFERS        32  /* Per open device, across all endpoints */
+#define BULK_TIMEOUT                0   /* milliseconds; zero means wait forever */
+
+/* struct definitions */
+typedef struct {
+    struct libusb_transfer *transfer;   /* NULL when this slot is free */
+    int completed;  /* Set by the completion callback from the event loop */
+} __queued_transfer_t;
+
+typedef struct {
+    long deviceID;  /* Unique ID for device.  Assigned by this driver */
+    libusb_device_handle *dev;
+    int interface;  /* The interface that was claimed on open */
+    volatile int disconnected;  /* Set when a probe no longer finds the device */
+    __queued_transfer_t queue[MAX_QUEUED_TRANSFERS];
+} __usb_interface_t;
+
+typedef struct {
+    long deviceID;  /* Unique ID for device.  Assigned by this driver. */
+    __usb_interface_t *handle;    /* Pointer to USB interface instance */
+    unsigned char bus_number;      /* libusb bus number */
+    unsigned char device_address;  /* Address of the device on that bus */
+    unsigned short vendorID;
+    unsigned short productID;
+    unsigned char valid;    /* Whether this struct is valid */
+    unsigned char mark;     /* Used to determine if device is still present */
+} __device_instance_t;
+
+
+/* Global variables (mostly static lookup tables) */
+static __device_instance_t __enumerated_devices[MAX_USB_DEVICES] = { { 0 } };
+static int __enumerated_device_count = 0;   /* To keep linear searches short */
+static long __last_assigned_deviceID = 0;   /* To keep device IDs unique */
+
+/**
+ * The libusb context is created the first time devices are probed.  All
+ * event handling for queued transfers goes through this context.
+ */
+static libusb_context *__context = NULL;
+
+/* Function prototypes */
+static __device_instance_t *__lookup_device_instance_by_ID(long deviceID);
+static __device_instance_t *__lookup_device_instance_by_location(
+        unsigned char bus_number, unsigned char device_address);
+static __device_instance_t *__add_device_instance(unsigned char bus_number,
+        unsigned char device_address, int vendorID, int productID);
+static void __purge_unmarked_device_instances(const struct USBDeviceFilter *filters,
+        int numberOfFilters);
+static int __matches_filter(const struct USBDeviceFilter *filters,
+        int numberOfFilters, int vendorID, int productID);
+static void __close_and_dealloc_usb_interface(__usb_interface_t *usb);
+static libusb_device *__find_device(__device_instance_t *instance,
+        libusb_device **list);
+static int __wait_for_transfer(__queued_transfer_t *slot, int timeoutMillis);
+static void __release_transfer(__queued_transfer_t *slot);
+static void LIBUSB_CALL __transfer_callback(struct libusb_transfer *transfer);
+
+static __device_instance_t *__lookup_device_instance_by_ID(long deviceID) {
+    int i;
+    int valid;
+    /* The __enumerated_device_count is used to end the search once it is
+     * known that there are no more devices to be found.
+     */
+    for(    i = 0, valid = 0;
+            i < MAX_USB_DEVICES && valid < __enumerated_device_count;
+            i++) {
+        if(0 != __enumerated_devices[i].valid) {
+            if(__enumerated_devices[i].deviceID == deviceID) {
+                return &(__enumerated_devices[i]);
+            }
+            valid++;
+        }
+    }
+    return NULL;
+}
+
+static __device_instance_t *__lookup_device_instance_by_location(
+        unsigned char bus_number, unsigned char device_address) {
+    int i;
+    int valid;
+
+    for(    i = 0, valid = 0;
+            i < MAX_USB_DEVICES && valid < __enumerated_device_count;
+            i++) {
+        if(0 != __enumerated_devices[i].valid) {
+            if(        __enumerated_devices[i].bus_number == bus_number
+                    && __enumerated_devices[i].device_address == device_address) {
+                return &(__enumerated_devices[i]);
+            }
+            valid++;
+        }
+    }
+    return NULL;
+}
+
+static __device_instance_t *__add_device_instance(unsigned char bus_number,
+        unsigned char device_address, int vendorID, int productID) {
+    int i;
+
+    /* First need to find an empty slot to store this device descriptor */
+    for(i = 0; i < MAX_USB_DEVICES; i++) {
+        if(0 == __enumerated_devices[i].valid) {
+            /* Found an empty slot */
+            __enumerated_devices[i].valid = 1;
+            __enumerated_devices[i].bus_number = bus_number;
+            __enumerated_devices[i].device_address = device_address;
+            __enumerated_devices[i].deviceID = __last_assigned_deviceID++;
+            __enumerated_devices[i].vendorID = vendorID;
+            __enumerated_devices[i].productID = productID;
+            __enumerated_device_count++;
+            return &(__enumerated_devices[i]);
+        }
+    }
+    return NULL;
+}
+
+static int __matches_filter(const struct USBDeviceFilter *filters,
+        int numberOfFilters, int vendorID, int productID) {
+    int i;
+    for(i = 0; i < numberOfFilters; i++) {
+        if(filters[i].vendorID == vendorID && filters[i].productID == productID) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void __purge_unmarked_device_instances(const struct USBDeviceFilter *filters,
+        int numberOfFilters) {
+    int new_count = 0;
+    int valid = 0;
+    int i;
+    __device_instance_t *device;
+
+    for(i = 0; i < MAX_USB_DEVICES && valid < __enumerated_device_count; i++) {
+        device = &(__enumerated_devices[i]);
+        if(0 == device->valid) {
+            continue;
+        }
+        valid++;
+
+        /* Only devices of the types that were just probed may be discarded */
+        if(0 == device->mark
+                && __matches_filter(filters, numberOfFilters,
+                        device->vendorID, device->productID)) {
+            if(NULL != device->handle) {
+                /* The device seems to have been disconnected, but whoever
+                 * opened it still owns the handle and may be in the middle
+                 * of a transfer on another thread.  Only flag it here, so
+                 * that new transfers fail; USBClose() frees it.
+                 */
+                device->handle->disconnected = 1;
+            }
+            memset(&__enumerated_devices[i], (int)0, sizeof(__device_instance_t));
+        } else {
+            __enumerated_devices[i].mark = 0;
+            new_count++;
+        }
+    }
+    __enumerated_device_count = new_count;
+}
+
+/* This will cancel any reads that are still queued, release the interface,
+ * and close the device.  This also deallocates the provided pointer.
+ */
+static void __close_and_dealloc_usb_interface(__usb_interface_t *usb) {
+    int i;
+
+    if(NULL == usb) {
+        return;
+    }
+
+    for(i = 0; i < MAX_QUEUED_TRANSFERS; i++) {
+        __release_transfer(&(usb->queue[i]));
+    }
+
+    if(NULL != usb->dev) {
+        libusb_release_interface(usb->dev, usb->interface);
+
+        /* Same workaround as the libusb-0.1 implementation: without a reset,
+         * the device may need to be replugged before it can be opened again.
+         * A device that is gone has nothing to reset.
+         */
+        if(0 == usb->disconnected) {
+            libusb_reset_device(usb->dev);
+        }
+
+        libusb_close(usb->dev);
+    }
+
+    free(usb);
+}
+
+static libusb_device *__find_device(__device_instance_t *instance,
+        libusb_device **list) {
+    int i;
+    for(i = 0; NULL != list[i]; i++) {
+        if(libusb_get_bus_number(list[i]) == instance->bus_number
+                && libusb_get_device_address(list[i]) == instance->device_address) {
+            return list[i];
+        }
+    }
+    return NULL;
+}
+
+static void LIBUSB_CALL __transfer_callback(struct libusb_transfer *transfer) {
+    /* This runs inside libusb_handle_events*() on whichever thread is
+     * waiting on a transfer.  Just flag the slot; the waiter sorts out
+     * the status.
+     */
+    *((int *)transfer->user_data) = 1;
+}
+
+/* Runs the libusb event loop until the given transfer completes or the
+ * timeout elapses.  A negative timeout waits indefinitely.  Returns nonzero
+ * if the transfer has completed.
+ */
+static int __wait_for_transfer(__queued_transfer_t *slot, int timeoutMillis) {
+    struct timespec now;
+    struct timespec deadline;
+    struct timeval tv;
+    long remaining;
+
+    if(timeoutMillis < 0) {
+        while(0 == slot->completed) {
+            if(libusb_handle_events_completed(__context, &(slot->completed)) < 0
+                    && 0 == slot->completed) {
+                return 0;
+            }
+        }
+        return 1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeoutMillis / 1000;
+    deadline.tv_nsec += (timeoutMillis % 1000) * 1000000L;
+    if(deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    /* Always make at least one pass so that a zero timeout still
+     * collects anything that has already finished.
+     */
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        remaining = (deadline.tv_sec - now.tv_sec) * 1000000L
+                  + (deadline.tv_nsec - now.tv_nsec) / 1000L;
+        if(remaining < 0) {
+            remaining = 0;
+        }
+        tv.tv_sec = remaining / 1000000L;
+        tv.tv_usec = remaining % 1000000L;
+        if(libusb_handle_events_timeout_completed(__context, &tv,
+                &(slot->completed)) < 0) {
+            break;
+        }
+    } while(0 == slot->completed && remaining > 0);
+
+    return slot->completed;
+}
+
+/* Cancels the transfer in the given slot if it is still in flight, waits
+ * for libusb to hand it back, and frees it.
+ */
+static void __release_transfer(__queued_transfer_t *slot) {
+    if(NULL == slot->transfer) {
+        return;
+    }
+
+    if(0 == slot->completed) {
+        if(0 == libusb_cancel_transfer(slot->transfer)) {
+            __wait_for_transfer(slot, -1);
+        }
+    }
+
+    libusb_free_transfer(slot->transfer);
+    slot->transfer = NULL;
+    slot->completed = 0;
+}
+
+int
+USBProbeDevices(int vendorID, int productID, unsigned long *output,
+        int max_devices) {
+    struct USBDeviceFilter filter;
+    struct USBProbedDevice *found;
+    int count;
+    int i;
+
+    if(max_devices <= 0) {
+        return 0;
+    }
+
+    found = (struct USBProbedDevice *)calloc(max_devices, sizeof(struct USBProbedDevice));
+    if(NULL == found) {
+        return -1;
+    }
+
+    filter.vendorID = vendorID;
+    filter.productID = productID;
+    count = USBProbeAllDevices(&filter, 1, found, max_devices);
+
+    for(i = 0; i < count; i++) {
+        output[i] = found[i].deviceID;
+    }
+
+    free(found);
+    return count;
+}
+
+int
+USBProbeAllDevices(const struct USBDeviceFilter *filters, int numberOfFilters,
+        struct USBProbedDevice *output, int max_devices) {
+
+    /* Local variables */
+    libusb_device **list = NULL;
+    struct libusb_device_descriptor dd;
+    __device_instance_t *instance;
+    ssize_t count;
+    ssize_t d;
+    int i;
+    int matched = 0;
+    int valid = 0;
+
+    if(NULL == __context) {
+        if(0 != libusb_init(&__context)) {
+            __context = NULL;
+            return -1;
+        }
+    }
+
+    /* One walk of the bus serves every filter */
+    count = libusb_get_device_list(__context, &list);
+    if(count < 0) {
+        return -1;
+    }
+
+    for(d = 0; d < count; d++) {
+        if(0 != libusb_get_device_descriptor(list[d], &dd)) {
+            continue;
+        }
+        if(0 == __matches_filter(filters, numberOfFilters, dd.idVendor, dd.idProduct)) {
+            continue;
+        }
+
+        instance = __lookup_device_instance_by_location(
+                libusb_get_bus_number(list[d]),
+                libusb_get_device_address(list[d]));
+        if(NULL != instance) {
+            /* Device is already known, so mark it and keep going */
+            instance->mark = 1;
+            continue;
+        }
+
+        instance = __add_device_instance(libusb_get_bus_number(list[d]),
+                libusb_get_device_address(list[d]), dd.idVendor, dd.idProduct);
+        if(NULL == instance) {
+            libusb_free_device_list(list, 1);
+            return -1;
+        }
+        instance->mark = 1;
+    }
+
+    libusb_free_device_list(list, 1);
+
+    /* Purge any devices that are cached but that no longer exist. */
+    __purge_unmarked_device_instances(filters, numberOfFilters);
+
+    /* Report every known device that matches any of the filters */
+    for(    i = 0, matched = 0, valid = 0;
+            i < MAX_USB_DEVICES && valid < __enumerated_device_count
+                && matched < max_devices;
+            i++) {
+        if(0 == __enumerated_devices[i].valid) {
+            continue;
+        }
+        valid++;
+        if(0 != __matches_filter(filters, numberOfFilters,
+                    __enumerated_devices[i].vendorID,
+                    __enumerated_devices[i].productID)) {
+            output[matched].deviceID = __enumerated_devices[i].deviceID;
+            output[matched].vendorID = __enumerated_devices[i].vendorID;
+            output[matched].productID = __enumerated_devices[i].productID;
+            matched++;
+        }
+    }
+
+    return matched;
+}
+
+void *
+USBOpen(unsigned long deviceID, int *errorCode) {
+    // Local variables
+    libusb_device **list = NULL;
+    libusb_device *device;
+    libusb_device_handle *deviceHandle = NULL;
+    struct libusb_config_descriptor *config = NULL;
+    __usb_interface_t *retval;
+    __device_instance_t *instance;
+    int interface = 0;
+    int claim_err;
+
+    /* Set a default error code in case a premature return is required */
+    SET_ERROR_CODE(NO_DEVICE_FOUND);
+
+    instance = __lookup_device_instance_by_ID(deviceID);
+    if(NULL == instance || NULL == __context) {
+        /* The caller must only provide IDs from USBProbeDevices() */
+        return 0;
+    }
+
+    if(NULL != instance->handle) {
+        /* It is illegal to try to open a device twice without first closing it. */
+        return 0;
+    }
+
+    if(libusb_get_device_list(__context, &list) < 0) {
+        return 0;
+    }
+
+    device = __find_device(instance, list);
+    if(NULL == device || 0 != libusb_open(device, &deviceHandle)) {
+        libusb_free_device_list(list, 1);
+        return 0;
+    }
+
+    if(0 == libusb_get_active_config_descriptor(device, &config)) {
+        interface = config->interface->altsetting->bInterfaceNumber;
+        libusb_free_config_descriptor(config);
+    }
+    libusb_free_device_list(list, 1);
+
+    claim_err = libusb_claim_interface(deviceHandle, interface);
+    if(claim_err != 0) {
+        fprintf(stderr, "libusb_claim_interface() returned %d - did you copy "
+                        "os-support/linux/10-oceanoptics.rules to /etc/udev/rules.d?\n",
+                        claim_err);
+        libusb_close(deviceHandle);
+        return 0;
+    }
+
+    retval = (__usb_interface_t *)calloc(sizeof(__usb_interface_t), 1);
+    if(NULL == retval) {
+        libusb_release_interface(deviceHandle, interface);
+        libusb_close(deviceHandle);
+        SET_ERROR_CODE(CLAIM_INTERFACE_FAILED);
+        return 0;
+    }
+    retval->dev = deviceHandle;
+    retval->interface = interface;
+    retval->deviceID = instance->deviceID;
+    instance->handle = retval;
+
+    SET_ERROR_CODE(OPEN_OK);
+    return (void *)retval;
+}
+
+int
+USBWrite(void *deviceHandle, unsigned char endpoint, char *data, int numberOfBytes) {
+    int transferred = 0;
+    int flag;
+    __usb_interface_t *usb;
+
+    if(0 == deviceHandle) {
+        return WRITE_FAILED;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+    if(0 != usb->disconnected) {
+        return WRITE_FAILED;
+    }
+
+    /* Commands are small and the protocols wait for each one to be accepted
+     * before doing anything else, so there is nothing to gain by queuing
+     * writes.  This is blocking.
+     */
+    flag = libusb_bulk_transfer(usb->dev, endpoint, (unsigned char *)data,
+        numberOfBytes, &transferred, BULK_TIMEOUT);
+
+    if(flag < 0 || (0 == transferred && 0 != numberOfBytes)) {
+        return WRITE_FAILED;
+    }
+    return transferred;
+}
+
+int
+USBSubmitRead(void *deviceHandle, unsigned char endpoint, char *data,
+        int numberOfBytes) {
+    __usb_interface_t *usb;
+    __queued_transfer_t *slot = NULL;
+    int ticket;
+
+    if(0 == deviceHandle) {
+        return SUBMIT_FAILED;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+    if(0 != usb->disconnected) {
+        return SUBMIT_FAILED;
+    }
+
+    for(ticket = 0; ticket < MAX_QUEUED_TRANSFERS; ticket++) {
+        if(NULL == usb->queue[ticket].transfer) {
+            slot = &(usb->queue[ticket]);
+            break;
+        }
+    }
+    if(NULL == slot) {
+        /* Too many reads are already outstanding on this device */
+        return SUBMIT_FAILED;
+    }
+
+    slot->transfer = libusb_alloc_transfer(0);
+    if(NULL == slot->transfer) {
+        return SUBMIT_FAILED;
+    }
+    slot->completed = 0;
+
+    libusb_fill_bulk_transfer(slot->transfer, usb->dev, endpoint,
+        (unsigned char *)data, numberOfBytes, __transfer_callback,
+        &(slot->completed), BULK_TIMEOUT);
+
+    if(0 != libusb_submit_transfer(slot->transfer)) {
+        libusb_free_transfer(slot->transfer);
+        slot->transfer = NULL;
+        return SUBMIT_FAILED;
+    }
+
+    return ticket;
+}
+
+int
+USBCompleteRead(void *deviceHandle, int ticket, int timeoutMillis) {
+    __usb_interface_t *usb;
+    __queued_transfer_t *slot;
+    int retval;
+
+    if(0 == deviceHandle || ticket < 0 || ticket >= MAX_QUEUED_TRANSFERS) {
+        return READ_FAILED;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+    slot = &(usb->queue[ticket]);
+    if(NULL == slot->transfer) {
+        return READ_FAILED;
+    }
+
+    if(0 == __wait_for_transfer(slot, timeoutMillis)) {
+        return READ_PENDING;
+    }
+
+    if(LIBUSB_TRANSFER_COMPLETED != slot->transfer->status
+            || (0 == slot->transfer->actual_length && 0 != slot->transfer->length)) {
+        retval = READ_FAILED;
+    } else {
+        retval = slot->transfer->actual_length;
+    }
+
+    __release_transfer(slot);
+    return retval;
+}
+
+int
+USBCancelRead(void *deviceHandle, int ticket) {
+    __usb_interface_t *usb;
+
+    if(0 == deviceHandle || ticket < 0 || ticket >= MAX_QUEUED_TRANSFERS) {
+        return ABORT_FAILED;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+    if(NULL == usb->queue[ticket].transfer) {
+        return ABORT_FAILED;
+    }
+
+    __release_transfer(&(usb->queue[ticket]));
+    return ABORT_OK;
+}
+
+int
+USBRead(void *deviceHandle, unsigned char endpoint, char * data, int numberOfBytes) {
+    int ticket;
+
+    /* A blocking read is just a queued read that is waited on immediately.
+     * Going through the queue keeps it ordered behind any reads that the
+     * caller has already submitted to the same endpoint.
+     */
+    ticket = USBSubmitRead(deviceHandle, endpoint, data, numberOfBytes);
+    if(ticket < 0) {
+        return READ_FAILED;
+    }
+
+    return USBCompleteRead(deviceHandle, ticket, -1);
+}
+
+int
+USBClose(void *deviceHandle) {
+    __usb_interface_t *usb;
+    __device_instance_t *device;
+
+    if(NULL == deviceHandle) {
+        return CLOSE_ERROR;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    /* A handle whose device was purged no longer has an instance */
+    device = __lookup_device_instance_by_ID(usb->deviceID);
+    if(NULL != device && device->handle == usb) {
+        /* This had an extra reference to the handle so free it up */
+        device->handle = NULL;
+    }
+
+    __close_and_dealloc_usb_interface(usb);
+    return CLOSE_OK;
+}
+
+void USBClearStall(void *deviceHandle, unsigned char endpoint) {
+    __usb_interface_t *usb;
+
+    if(0 == deviceHandle) {
+        return;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    libusb_clear_halt(usb->dev, endpoint);
+}
+
+int
+USBGetDeviceDescriptor(void *deviceHandle, struct USBDeviceDescriptor *desc) {
+    struct libusb_device_descriptor dd;
+    __usb_interface_t *usb;
+
+    if(0 == desc) {
+        return -1;
+    }
+
+    if(0 == deviceHandle) {
+        return -2;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    if(0 != libusb_get_device_descriptor(libusb_get_device(usb->dev), &dd)) {
+        return -2;
+    }
+
+    desc->bLength = dd.bLength;
+    desc->bDescriptorType = dd.bDescriptorType;
+    desc->bcdUSB = dd.bcdUSB;
+    desc->bDeviceClass = dd.bDeviceClass;
+    desc->bDeviceSubClass = dd.bDeviceSubClass;
+    desc->bDeviceProtocol = dd.bDeviceProtocol;
+    desc->bMaxPacketSize0 = dd.bMaxPacketSize0;
+    desc->idVendor = dd.idVendor;
+    desc->idProduct = dd.idProduct;
+    desc->bcdDevice = dd.bcdDevice;
+    desc->iManufacturer = dd.iManufacturer;
+    desc->iProduct = dd.iProduct;
+    desc->iSerialNumber = dd.iSerialNumber;
+    desc->bNumConfigurations = dd.bNumConfigurations;
+
+    return 0;
+}
+
+int
+USBGetInterfaceDescriptor(void *deviceHandle, struct USBInterfaceDescriptor *desc) {
+    struct libusb_config_descriptor *config = NULL;
+    const struct libusb_interface_descriptor *id;
+    __usb_interface_t *usb;
+
+    if(0 == desc) {
+        return -1;
+    }
+
+    if(0 == deviceHandle) {
+        return -2;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    if(0 != libusb_get_active_config_descriptor(libusb_get_device(usb->dev), &config)) {
+        return -2;
+    }
+
+    /* FIXME: are there more than one altsetting that should be reachable? */
+    id = config->interface->altsetting;
+    desc->bLength = id->bLength;
+    desc->bDescriptorType = id->bDescriptorType;
+    desc->bInterfaceNumber = id->bInterfaceNumber;
+    desc->bAlternateSetting = id->bAlternateSetting;
+    desc->bNumEndpoints = id->bNumEndpoints;
+    desc->bInterfaceClass = id->bInterfaceClass;
+    desc->bInterfaceSubClass = id->bInterfaceSubClass;
+    desc->bInterfaceProtocol = id->bInterfaceProtocol;
+    desc->iInterface = id->iInterface;
+
+    libusb_free_config_descriptor(config);
+    return 0;
+}
+
+int
+USBGetEndpointDescriptor(void *deviceHandle, int endpoint_index,
+        struct USBEndpointDescriptor *desc) {
+    struct libusb_config_descriptor *config = NULL;
+    const struct libusb_endpoint_descriptor *ed;
+    __usb_interface_t *usb;
+
+    if(0 == desc) {
+        return -1;
+    }
+
+    if(0 == deviceHandle) {
+        return -2;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    if(0 != libusb_get_active_config_descriptor(libusb_get_device(usb->dev), &config)) {
+        return -2;
+    }
+
+    /* FIXME: Deal with alternate endpoints or interfaces? */
+    if(endpoint_index < 0
+            || endpoint_index >= config->interface->altsetting->bNumEndpoints) {
+        libusb_free_config_descriptor(config);
+        return -1;
+    }
+    ed = &(config->interface->altsetting->endpoint[endpoint_index]);
+
+    desc->bLength = ed->bLength;
+    desc->bDescriptorType = ed->bDescriptorType;
+    desc->bEndpointAddress = ed->bEndpointAddress;
+    desc->bmAttributes = ed->bmAttributes;
+    desc->wMaxPacketSize = ed->wMaxPacketSize;
+    desc->bInterval = ed->bInterval;
+
+    libusb_free_config_descriptor(config);
+    return 0;
+}
+
+int
+USBGetStringDescriptor(void *deviceHandle, unsigned int string_index,
+        char *buffer, int maxLength) {
+    int length = 0;
+    __usb_interface_t *usb;
+
+    if(0 == deviceHandle || 0 == buffer) {
+        return 0;
+    }
+
+    usb = (__usb_interface_t *)deviceHandle;
+
+    length = libusb_get_string_descriptor_ascii(usb->dev, (uint8_t)string_index,
+        (unsigned char *)buffer, maxLength);
+    if(length <= 0) {
+        buffer[0] = '\0';
+    }
+
+    return length;
+}
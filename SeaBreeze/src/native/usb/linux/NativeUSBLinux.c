@@ -88,7 +88,10 @@ static __device_instance_t *__lookup_device_instance_by_location(const char *bus
 static __device_instance_t *__add_device_instance(const char *bus_location,
                                            const char *device_location,
                                            int vendorID, int productID);
-static void __purge_unmarked_device_instances(int vendorID, int productID);
+static void __purge_unmarked_device_instances(const struct USBDeviceFilter *filters,
+                                              int numberOfFilters);
+static int __matches_filter(const struct USBDeviceFilter *filters,
+                            int numberOfFilters, int vendorID, int productID);
 static void __close_and_dealloc_usb_interface(__usb_interface_t *usb);
 static int __probe_devices();
 
@@ -164,7 +167,23 @@ static __device_instance_t *__add_device_instance(const char *bus_location,
     return NULL;
 }
 
-static void __purge_unmarked_device_instances(int vendorID, int productID) {
+/* Returns nonzero if the given VID and PID appear in the filter table.  The
+ * table only has one entry per supported device type, so a linear search
+ * is as quick as anything fancier.
+ */
+static int __matches_filter(const struct USBDeviceFilter *filters,
+        int numberOfFilters, int vendorID, int productID) {
+    int i;
+    for(i = 0; i < numberOfFilters; i++) {
+        if(filters[i].vendorID == vendorID && filters[i].productID == productID) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void __purge_unmarked_device_instances(const struct USBDeviceFilter *filters,
+        int numberOfFilters) {
     int new_count = 0;
     int valid = 0;
     int i;
@@ -179,14 +198,14 @@ static void __purge_unmarked_device_instances(int vendorID, int productID) {
         valid++;
 
         /* Now check whether it was marked as still being present.  Note that
-         * this search is limited just to the type of device that was being
+         * this search is limited just to the types of device that were being
          * probed when this call was made -- otherwise, any devices that were
          * not being probed for just now would be unmarked and would be
          * discarded.
          */
         if(0 == device->mark
-                && (vendorID == device->vendorID)
-                && (productID == device->productID)) {
+                && __matches_filter(filters, numberOfFilters,
+                        device->vendorID, device->productID)) {
             /* Not marked, so it needs to be purged */
             if(NULL != device->handle) {
                 /* Clean up the device since it seems to have been disconnected */
@@ -253,6 +272,35 @@ static int  __probe_devices() {
 int
 USBProbeDevices(int vendorID, int productID, unsigned long *output,
         int max_devices) {
+    struct USBDeviceFilter filter;
+    struct USBProbedDevice *found;
+    int count;
+    int i;
+
+    if(max_devices <= 0) {
+        return 0;
+    }
+
+    found = (struct USBProbedDevice *)calloc(max_devices, sizeof(struct USBProbedDevice));
+    if(NULL == found) {
+        return -1;
+    }
+
+    filter.vendorID = vendorID;
+    filter.productID = productID;
+    count = USBProbeAllDevices(&filter, 1, found, max_devices);
+
+    for(i = 0; i < count; i++) {
+        output[i] = found[i].deviceID;
+    }
+
+    free(found);
+    return count;
+}
+
+int
+USBProbeAllDevices(const struct USBDeviceFilter *filters, int numberOfFilters,
+        struct USBProbedDevice *output, int max_devices) {
 
     /* Local variables */
     struct usb_bus *bus = NULL;       /* Temp variable to iterate over buses */
@@ -272,81 +320,75 @@ USBProbeDevices(int vendorID, int productID, unsigned long *output,
         __init_called = 1;
     }
 
-    /* Update the tree of known devices.  This does not really care if the state
-     * has changed since the last call (i.e. the return value is ignored) since
-     * the change may not be relevant to the particular VID/PID that this is
-     * looking for this time, and there is a good chance that this function will
-     * be called again in just a moment for another VID/PID.  If this skipped
-     * the update because it detected no change, then probing for one VID/PID
-     * would cause a subsequent one to be skipped incorrectly.
+    /* Update the tree of known devices.  This is done exactly once per call
+     * regardless of how many device types are being looked for, since this
+     * rescan is by far the most expensive part of discovery.
      */
     __probe_devices();
 
     /* A side effect of __probe_devices is to update the tree that is
-     * under the global pointer usb_busses.  Traverse the tree and
-     * update the local cached device table as needed.
+     * under the global pointer usb_busses.  Traverse the tree once and
+     * classify every device against the filter table, updating the local
+     * cached device table as needed.
      */
     for(bus = usb_get_busses(); bus; bus = bus->next) {
         for(device = bus->devices; device; device = device->next) {
-            if(   (device->descriptor.idVendor == vendorID) &&
-                  (device->descriptor.idProduct == productID)) {
-                /* Got a matching device node.  Determine if this is
-                 * already in the cache.
-                 */
-                instance = __lookup_device_instance_by_location(
-                                bus->dirname, device->filename);
-                if(NULL != instance) {
-                     /* Device is already known, so mark it and keep going */
-                     instance->mark = 1;
-                     continue;
-                }
+            if(0 == __matches_filter(filters, numberOfFilters,
+                        device->descriptor.idVendor, device->descriptor.idProduct)) {
+                continue;
+            }
 
-                /* At this point, we must be dealing with a newly discovered USB
-                 * device that matches the given VID and PID.  It must now be
-                 * cached for use with the open function.  Note that instance was
-                 * checked above so it must be NULL here.
+            /* Got a matching device node.  Determine if this is
+             * already in the cache.
+             */
+            instance = __lookup_device_instance_by_location(
+                            bus->dirname, device->filename);
+            if(NULL != instance) {
+                 /* Device is already known, so mark it and keep going */
+                 instance->mark = 1;
+                 continue;
+            }
+
+            /* At this point, we must be dealing with a newly discovered USB
+             * device that matches one of the filters.  It must now be
+             * cached for use with the open function.  Note that instance was
+             * checked above so it must be NULL here.
+             */
+            instance = __add_device_instance(bus->dirname, device->filename,
+                            device->descriptor.idVendor, device->descriptor.idProduct);
+            if(NULL == instance) {
+                /* Could not add the device -- this should not be possible,
+                 * so bail out.
                  */
-                instance = __add_device_instance(bus->dirname, device->filename,
-                                vendorID, productID);
-                if(NULL == instance) {
-                    /* Could not add the device -- this should not be possible,
-                     * so bail out.
-                     */
-                    return -1;
-                }
-                instance->mark = 1;     /* Preserve this since it was just seen */
+                return -1;
             }
+            instance->mark = 1;     /* Preserve this since it was just seen */
         }
     }
 
     /* Purge any devices that are cached but that no longer exist. */
-    __purge_unmarked_device_instances(vendorID, productID);
+    __purge_unmarked_device_instances(filters, numberOfFilters);
 
-    /* Count up how many of this type of device are known */
+    /* Report every known device that matches any of the filters */
     for(    i = 0, matched = 0, valid = 0;
-            i < MAX_USB_DEVICES && valid < __enumerated_device_count;
+            i < MAX_USB_DEVICES && valid < __enumerated_device_count
+                && matched < max_devices;
             i++) {
-        if(0 != __enumerated_devices[i].valid) {
-            valid++;
-            if(__enumerated_devices[i].vendorID == vendorID
-                        && __enumerated_devices[i].productID == productID) {
-                matched++;
-            }
+        if(0 == __enumerated_devices[i].valid) {
+            continue;
         }
-    }
-
-    for(    i = 0, valid = 0;
-            i < MAX_USB_DEVICES && valid < matched && valid < max_devices;
-            i++) {
-        if(0 != __enumerated_devices[i].valid
-                && __enumerated_devices[i].vendorID == vendorID
-                && __enumerated_devices[i].productID == productID) {
-            output[valid] = __enumerated_devices[i].deviceID;
-            valid++;
+        valid++;
+        if(0 != __matches_filter(filters, numberOfFilters,
+                    __enumerated_devices[i].vendorID,
+                    __enumerated_devices[i].productID)) {
+            output[matched].deviceID = __enumerated_devices[i].deviceID;
+            output[matched].vendorID = __enumerated_devices[i].vendorID;
+            output[matched].productID = __enumerated_devices[i].productID;
+            matched++;
         }
     }
 
-    return valid;
+    return matched;
 }
 
 void *
@@ -477,6 +519,26 @@ USBRead(void *deviceHandle, unsigned char endpoint, char * data, int numberOfByt
     return retval;
 }
 
+/* The libusb-0.1 API only offers blocking bulk transfers.  Callers that
+ * want queued reads should build against the libusb-1.0 backend instead.
+ */
+int
+USBSubmitRead(void *UNUSED(deviceHandle), unsigned char UNUSED(endpoint),
+        char *UNUSED(data), int UNUSED(numberOfBytes)) {
+    return SUBMIT_UNSUPPORTED;
+}
+
+int
+USBCompleteRead(void *UNUSED(deviceHandle), int UNUSED(ticket),
+        int UNUSED(timeoutMillis)) {
+    return READ_FAILED;
+}
+
+int
+USBCancelRead(void *UNUSED(deviceHandle), int UNUSED(ticket)) {
+    return ABORT_FAILED;
+}
+
 int
 USBClose(void *deviceHandle) {
     /* Local variables */
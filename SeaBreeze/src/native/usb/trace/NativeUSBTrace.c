@@ -0,0 +1,887 @@
+/***************************************************//**
+ * @file    NativeUSBTrace.c
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This is a record/replay shim for the native USB interface.
+ * It is selected at build time with "make usb=trace" or the
+ * SEABREEZE_USB_TRACE CMake option, and its behavior is then
+ * chosen at run time with environment variables:
+ *
+ *   SEABREEZE_USB_TRACE=record   Pass every call through to the
+ *                                real USB backend and log it.
+ *   SEABREEZE_USB_TRACE=replay   Serve a previously recorded log
+ *                                without touching any hardware.
+ *   (unset)                      Pass through without logging.
+ *
+ *   SEABREEZE_USB_TRACE_FILE     Trace to write or read
+ *                                (default seabreeze-usb.trace).
+ *   SEABREEZE_USB_REPLAY_SPEEDUP Replay timing divisor; 1 keeps the
+ *                                recorded timing, 0 disables delays.
+ *   SEABREEZE_USB_REPLAY_STRICT  If nonzero, a write that does not
+ *                                match the recording fails.
+ *
+ * The trace is a line-oriented text file with payloads in hex, one
+ * line per device seen, open, close, write, read, or descriptor.
+ * Reads and writes are matched on replay by device and endpoint, so
+ * queued reads on different endpoints may complete in any order.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "native/usb/NativeUSB.h"
+
+/* The real backend is compiled into this file under different names so
+ * that record and pass-through modes can forward to it.
+ */
+#define USBProbeDevices             __native_USBProbeDevices
+#define USBProbeAllDevices          __native_USBProbeAllDevices
+#define USBOpen                     __native_USBOpen
+#define USBClose                    __native_USBClose
+#define USBWrite                    __native_USBWrite
+#define USBRead                     __native_USBRead
+#define USBSubmitRead               __native_USBSubmitRead
+#define USBCompleteRead             __native_USBCompleteRead
+#define USBCancelRead               __native_USBCancelRead
+#define USBClearStall               __native_USBClearStall
+#define USBGetDeviceDescriptor      __native_USBGetDeviceDescriptor
+#define USBGetInterfaceDescriptor   __native_USBGetInterfaceDescriptor
+#define USBGetEndpointDescriptor    __native_USBGetEndpointDescriptor
+#define USBGetStringDescriptor      __native_USBGetStringDescriptor
+
+int USBProbeDevices(int vendorID, int productID, unsigned long *output, int max_devices);
+int USBProbeAllDevices(const struct USBDeviceFilter *filters, int numberOfFilters,
+        struct USBProbedDevice *output, int max_devices);
+void *USBOpen(unsigned long deviceID, int *errorCode);
+int USBClose(void *handle);
+int USBWrite(void *handle, unsigned char endpoint, char *data, int numberOfBytes);
+int USBRead(void *handle, unsigned char endpoint, char *data, int numberOfBytes);
+int USBSubmitRead(void *handle, unsigned char endpoint, char *data, int numberOfBytes);
+int USBCompleteRead(void *handle, int ticket, int timeoutMillis);
+int USBCancelRead(void *handle, int ticket);
+void USBClearStall(void *handle, unsigned char endpoint);
+int USBGetDeviceDescriptor(void *handle, struct USBDeviceDescriptor *desc);
+int USBGetInterfaceDescriptor(void *handle, struct USBInterfaceDescriptor *desc);
+int USBGetEndpointDescriptor(void *handle, int endpoint_index, struct USBEndpointDescriptor *desc);
+int USBGetStringDescriptor(void *handle, unsigned int string_index, char *buffer, int maxLength);
+
+#ifdef SEABREEZE_USB_LIBUSB1
+#include "../libusb1/NativeUSBLibUSB1.c"
+#else
+#include "../linux/NativeUSBLinux.c"
+#endif
+
+#undef USBProbeDevices
+#undef USBProbeAllDevices
+#undef USBOpen
+#undef USBClose
+#undef USBWrite
+#undef USBRead
+#undef USBSubmitRead
+#undef USBCompleteRead
+#undef USBCancelRead
+#undef USBClearStall
+#undef USBGetDeviceDescriptor
+#undef USBGetInterfaceDescriptor
+#undef USBGetEndpointDescriptor
+#undef USBGetStringDescriptor
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Definitions and macros */
+#define TRACE_MODE_UNKNOWN      -1
+#define TRACE_MODE_OFF          0
+#define TRACE_MODE_RECORD       1
+#define TRACE_MODE_REPLAY       2
+#define TRACE_DEFAULT_FILE      "seabreeze-usb.trace"
+#define TRACE_MAX_TICKETS       64
+#define TRACE_MAX_DEVICES       127
+#define TRACE_MAX_LINE          (1 << 20)
+
+/* Record kinds, which are also the first word of each trace line */
+#define KIND_DEVICE             0
+#define KIND_OPEN               1
+#define KIND_CLOSE              2
+#define KIND_WRITE              3
+#define KIND_READ               4
+#define KIND_DESCRIPTOR         5
+
+static const char *__trace_kind_names[] = {
+    "device", "open", "close", "write", "read", "descriptor"
+};
+
+/* struct definitions */
+typedef struct {
+    int kind;
+    unsigned long deviceID;
+    unsigned long micros;       /* Time since the start of the session */
+    int endpoint;               /* Endpoint, or descriptor type for KIND_DESCRIPTOR */
+    int index;                  /* Descriptor index; VID for KIND_DEVICE */
+    int extra;                  /* PID for KIND_DEVICE */
+    int length;                 /* Transfer result; -1 if it failed */
+    unsigned char *data;
+    unsigned char consumed;
+} __trace_record_t;
+
+typedef struct {
+    int endpoint;
+    char *data;
+    int length;                 /* Used during replay only */
+    unsigned long micros;       /* Used during replay only */
+    unsigned char valid;
+} __trace_ticket_t;
+
+typedef struct {
+    unsigned long deviceID;
+    void *native;               /* NULL during replay */
+    __trace_ticket_t tickets[TRACE_MAX_TICKETS];
+} __trace_handle_t;
+
+/* Global variables.  __trace_lock guards all of them and the tickets in
+ * every handle; the mode is only read without it once __trace_init() has
+ * set it under the lock.
+ */
+static pthread_mutex_t __trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static int __trace_mode = TRACE_MODE_UNKNOWN;
+static FILE *__trace_file = NULL;
+static struct timespec __trace_start;
+static double __replay_speedup = 1.0;
+static int __replay_strict = 0;
+static __trace_record_t *__replay_records = NULL;
+static int __replay_record_count = 0;
+static unsigned long __recorded_devices[TRACE_MAX_DEVICES];
+static int __recorded_device_count = 0;
+
+/* Function prototypes */
+static void __trace_init();
+static unsigned long __trace_micros();
+static void __trace_log(int kind, unsigned long deviceID, int endpoint, int index,
+        int length, const void *data);
+static void __trace_log_device(unsigned long deviceID, int vendorID, int productID);
+static void __replay_load(const char *path);
+static __trace_record_t *__replay_find(int kind, unsigned long deviceID,
+        int endpoint, int index, int consume);
+static void __replay_wait(unsigned long micros);
+static int __hex_decode(const char *hex, int length, unsigned char **out);
+
+static void __trace_init() {
+    const char *mode;
+    const char *path;
+    const char *value;
+
+    pthread_mutex_lock(&__trace_lock);
+    if(TRACE_MODE_UNKNOWN != __trace_mode) {
+        pthread_mutex_unlock(&__trace_lock);
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &__trace_start);
+
+    path = getenv("SEABREEZE_USB_TRACE_FILE");
+    if(NULL == path || '\0' == path[0]) {
+        path = TRACE_DEFAULT_FILE;
+    }
+
+    value = getenv("SEABREEZE_USB_REPLAY_SPEEDUP");
+    if(NULL != value) {
+        __replay_speedup = atof(value);
+    }
+
+    value = getenv("SEABREEZE_USB_REPLAY_STRICT");
+    if(NULL != value) {
+        __replay_strict = atoi(value);
+    }
+
+    /* Every other thread waits on the lock until the mode is settled */
+    __trace_mode = TRACE_MODE_OFF;
+    mode = getenv("SEABREEZE_USB_TRACE");
+    if(NULL == mode) {
+        /* Pass-through */
+    } else if(0 == strcmp(mode, "record")) {
+        __trace_file = fopen(path, "w");
+        if(NULL == __trace_file) {
+            fprintf(stderr, "Could not open USB trace %s for writing\n", path);
+        } else {
+            fprintf(__trace_file, "# SeaBreeze USB trace\n");
+            fflush(__trace_file);
+            __trace_mode = TRACE_MODE_RECORD;
+        }
+    } else if(0 == strcmp(mode, "replay")) {
+        __replay_load(path);
+        __trace_mode = TRACE_MODE_REPLAY;
+    }
+    pthread_mutex_unlock(&__trace_lock);
+}
+
+static unsigned long __trace_micros() {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long)((now.tv_sec - __trace_start.tv_sec) * 1000000L
+            + (now.tv_nsec - __trace_start.tv_nsec) / 1000L);
+}
+
+/* Each record is formatted completely before it goes to the file in a
+ * single write, so that records from different threads never interleave.
+ */
+static void __trace_log(int kind, unsigned long deviceID, int endpoint, int index,
+        int length, const void *data) {
+    static const char digits[] = "0123456789ABCDEF";
+    char header[128];
+    char *line;
+    int headerLength;
+    int dataLength;
+    int i;
+
+    if(NULL == __trace_file) {
+        return;
+    }
+
+    dataLength = (NULL == data || length < 0) ? 0 : length;
+    line = (char *)malloc(sizeof(header) + 2 * dataLength + 1);
+    if(NULL == line) {
+        return;
+    }
+
+    pthread_mutex_lock(&__trace_lock);
+    headerLength = snprintf(header, sizeof(header), "%s %lu %lu %d %d %d ",
+            __trace_kind_names[kind], deviceID, __trace_micros(), endpoint,
+            index, length);
+    memcpy(line, header, headerLength);
+    for(i = 0; i < dataLength; i++) {
+        unsigned char value = ((const unsigned char *)data)[i];
+        line[headerLength + 2 * i] = digits[value >> 4];
+        line[headerLength + 2 * i + 1] = digits[value & 0x0F];
+    }
+    line[headerLength + 2 * dataLength] = '\n';
+    fwrite(line, 1, headerLength + 2 * dataLength + 1, __trace_file);
+    fflush(__trace_file);
+    pthread_mutex_unlock(&__trace_lock);
+
+    free(line);
+}
+
+static void __trace_log_device(unsigned long deviceID, int vendorID, int productID) {
+    int i;
+
+    pthread_mutex_lock(&__trace_lock);
+    for(i = 0; i < __recorded_device_count; i++) {
+        if(__recorded_devices[i] == deviceID) {
+            pthread_mutex_unlock(&__trace_lock);
+            return;
+        }
+    }
+    if(__recorded_device_count < TRACE_MAX_DEVICES) {
+        __recorded_devices[__recorded_device_count++] = deviceID;
+    }
+
+    fprintf(__trace_file, "%s %lu 0 0 %d %d\n", __trace_kind_names[KIND_DEVICE],
+            deviceID, vendorID, productID);
+    fflush(__trace_file);
+    pthread_mutex_unlock(&__trace_lock);
+}
+
+static int __hex_decode(const char *hex, int length, unsigned char **out) {
+    int i;
+    unsigned int value;
+
+    *out = NULL;
+    if(length <= 0) {
+        return 0;
+    }
+
+    *out = (unsigned char *)malloc(length);
+    if(NULL == *out) {
+        return -1;
+    }
+
+    for(i = 0; i < length; i++) {
+        if(1 != sscanf(hex + 2 * i, "%2x", &value)) {
+            return -1;
+        }
+        (*out)[i] = (unsigned char)value;
+    }
+    return 0;
+}
+
+static void __replay_load(const char *path) {
+    FILE *f;
+    char *line;
+    char kind[16];
+    int consumed;
+    int capacity = 0;
+    int k;
+    __trace_record_t record;
+    __trace_record_t *grown;
+
+    f = fopen(path, "r");
+    if(NULL == f) {
+        fprintf(stderr, "Could not open USB trace %s for replay\n", path);
+        return;
+    }
+
+    line = (char *)malloc(TRACE_MAX_LINE);
+    if(NULL == line) {
+        fclose(f);
+        return;
+    }
+
+    while(NULL != fgets(line, TRACE_MAX_LINE, f)) {
+        if('#' == line[0]) {
+            continue;
+        }
+
+        memset(&record, 0, sizeof(record));
+        consumed = 0;
+        if(sscanf(line, "%15s %lu %lu %d %d %d %n", kind, &record.deviceID,
+                &record.micros, &record.endpoint, &record.index, &record.length,
+                &consumed) < 6) {
+            continue;
+        }
+
+        record.kind = -1;
+        for(k = 0; k <= KIND_DESCRIPTOR; k++) {
+            if(0 == strcmp(kind, __trace_kind_names[k])) {
+                record.kind = k;
+            }
+        }
+        if(record.kind < 0) {
+            continue;
+        }
+
+        if(KIND_DEVICE == record.kind) {
+            /* The VID and PID are stored where the length would be */
+            record.extra = record.length;
+            record.length = 0;
+        } else if(0 != __hex_decode(line + consumed, record.length, &record.data)) {
+            free(record.data);
+            continue;
+        }
+
+        if(__replay_record_count == capacity) {
+            capacity = (0 == capacity) ? 1024 : capacity * 2;
+            grown = (__trace_record_t *)realloc(__replay_records,
+                    capacity * sizeof(__trace_record_t));
+            if(NULL == grown) {
+                /* Replay whatever was loaded before memory ran out */
+                fprintf(stderr, "USB trace %s is too large to replay in full\n", path);
+                free(record.data);
+                break;
+            }
+            __replay_records = grown;
+        }
+        __replay_records[__replay_record_count++] = record;
+    }
+
+    free(line);
+    fclose(f);
+}
+
+static __trace_record_t *__replay_find(int kind, unsigned long deviceID,
+        int endpoint, int index, int consume) {
+    __trace_record_t *found = NULL;
+    int i;
+
+    /* Records never change once loaded apart from the consumed flags, so
+     * only the search and the claim need the lock.
+     */
+    pthread_mutex_lock(&__trace_lock);
+    for(i = 0; i < __replay_record_count; i++) {
+        __trace_record_t *r = &(__replay_records[i]);
+        if(r->kind == kind && r->deviceID == deviceID && r->endpoint == endpoint
+                && r->index == index && 0 == r->consumed) {
+            if(0 != consume) {
+                r->consumed = 1;
+            }
+            found = r;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&__trace_lock);
+    return found;
+}
+
+static void __replay_wait(unsigned long micros) {
+    unsigned long target;
+    unsigned long now;
+
+    if(__replay_speedup <= 0.0) {
+        return;
+    }
+
+    target = (unsigned long)(micros / __replay_speedup);
+    now = __trace_micros();
+    if(target > now) {
+        struct timespec ts;
+        ts.tv_sec = (target - now) / 1000000L;
+        ts.tv_nsec = ((target - now) % 1000000L) * 1000L;
+        nanosleep(&ts, NULL);
+    }
+}
+
+int
+USBProbeDevices(int vendorID, int productID, unsigned long *output,
+        int max_devices) {
+    struct USBDeviceFilter filter;
+    struct USBProbedDevice found[TRACE_MAX_DEVICES];
+    int count;
+    int i;
+
+    filter.vendorID = vendorID;
+    filter.productID = productID;
+    count = USBProbeAllDevices(&filter, 1, found,
+            (max_devices < TRACE_MAX_DEVICES) ? max_devices : TRACE_MAX_DEVICES);
+
+    for(i = 0; i < count; i++) {
+        output[i] = found[i].deviceID;
+    }
+    return count;
+}
+
+int
+USBProbeAllDevices(const struct USBDeviceFilter *filters, int numberOfFilters,
+        struct USBProbedDevice *output, int max_devices) {
+    int count = 0;
+    int i;
+    int f;
+
+    __trace_init();
+
+    if(TRACE_MODE_REPLAY != __trace_mode) {
+        count = __native_USBProbeAllDevices(filters, numberOfFilters, output, max_devices);
+        if(TRACE_MODE_RECORD == __trace_mode) {
+            for(i = 0; i < count; i++) {
+                __trace_log_device(output[i].deviceID, output[i].vendorID,
+                        output[i].productID);
+            }
+        }
+        return count;
+    }
+
+    /* Every device that appeared during the recording is reported as
+     * present for the whole replay.
+     */
+    for(i = 0; i < __replay_record_count && count < max_devices; i++) {
+        __trace_record_t *r = &(__replay_records[i]);
+        if(KIND_DEVICE != r->kind) {
+            continue;
+        }
+        for(f = 0; f < numberOfFilters; f++) {
+            if(filters[f].vendorID == r->index && filters[f].productID == r->extra) {
+                output[count].deviceID = r->deviceID;
+                output[count].vendorID = (unsigned short)r->index;
+                output[count].productID = (unsigned short)r->extra;
+                count++;
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+void *
+USBOpen(unsigned long deviceID, int *errorCode) {
+    __trace_handle_t *handle;
+    void *native = NULL;
+    int i;
+
+    __trace_init();
+
+    SET_ERROR_CODE(NO_DEVICE_FOUND);
+
+    if(TRACE_MODE_REPLAY == __trace_mode) {
+        for(i = 0; i < __replay_record_count; i++) {
+            if(KIND_DEVICE == __replay_records[i].kind
+                    && deviceID == __replay_records[i].deviceID) {
+                break;
+            }
+        }
+        if(i == __replay_record_count) {
+            return NULL;
+        }
+    } else {
+        native = __native_USBOpen(deviceID, errorCode);
+        if(NULL == native) {
+            return NULL;
+        }
+    }
+
+    handle = (__trace_handle_t *)calloc(1, sizeof(__trace_handle_t));
+    if(NULL == handle) {
+        if(NULL != native) {
+            __native_USBClose(native);
+        }
+        SET_ERROR_CODE(CLAIM_INTERFACE_FAILED);
+        return NULL;
+    }
+    handle->deviceID = deviceID;
+    handle->native = native;
+
+    if(TRACE_MODE_RECORD == __trace_mode) {
+        __trace_log(KIND_OPEN, deviceID, 0, 0, 0, NULL);
+    }
+
+    SET_ERROR_CODE(OPEN_OK);
+    return handle;
+}
+
+int
+USBClose(void *deviceHandle) {
+    __trace_handle_t *handle = (__trace_handle_t *)deviceHandle;
+    int retval = CLOSE_OK;
+
+    if(NULL == handle) {
+        return CLOSE_ERROR;
+    }
+
+    if(NULL != handle->native) {
+        retval = __native_USBClose(handle->native);
+    }
+    if(TRACE_MODE_RECORD == __trace_mode) {
+        __trace_log(KIND_CLOSE, handle->deviceID, 0, 0, 0, NULL);
+    }
+
+    free(handle);
+    return retval;
+}
+
+int
+USBWrite(void *deviceHandle, unsigned char endpoint, char *data, int numberOfBytes) {
+    __trace_handle_t *handle = (__trace_handle_t *)deviceHandle;
+    __trace_record_t *r;
+    int retval;
+
+    if(NULL == handle) {
+        return WRITE_FAILED;
+    }
+
+    if(TRACE_MODE_REPLAY != __trace_mode) {
+        retval = __native_USBWrite(handle->native, endpoint, data, numberOfBytes);
+        if(TRACE_MODE_RECORD == __trace_mode) {
+            __trace_log(KIND_WRITE, handle->deviceID, endpoint, 0,
+                    (retval < 0) ? -1 : numberOfBytes, data);
+        }
+        return retval;
+    }
+
+    r = __replay_find(KIND_WRITE, handle->deviceID, endpoint, 0, 1);
+    if(NULL == r) {
+        return WRITE_FAILED;
+    }
+    __replay_wait(r->micros);
+
+    if(r->length != numberOfBytes
+            || (r->length > 0 && 0 != memcmp(r->data, data, r->length))) {
+        fprintf(stderr, "USB replay: write of %d bytes to endpoint 0x%02X does not match the trace\n",
+                numberOfBytes, endpoint);
+        if(0 != __replay_strict) {
+            return WRITE_FAILED;
+        }
+    }
+
+    return (r->length < 0) ? WRITE_FAILED : numberOfBytes;
+}
+
+/* Copies a recorded read into the caller's buffer */
+static int __replay_read(__trace_record_t *r, char *data, int numberOfBytes) {
+    int length;
+
+    if(r->length < 0) {
+        return READ_FAILED;
+    }
+    length = (r->length < numberOfBytes) ? r->length : numberOfBytes;
+    memcpy(data, r->data, length);
+    return length;
+}
+
+int
+USBRead(void *deviceHandle, unsigned char endpoint, char *data, int numberOfBytes) {
+    __trace_handle_t *handle = (__trace_handle_t *)deviceHandle;
+    __trace_record_t *r;
+    int retval;
+
+    if(NULL == handle) {
+        return READ_FAILED;
+    }
+
+    if(TRACE_MODE_REPLAY != __trace_mode) {
+        retval = __native_USBRead(handle->native, endpoint, data, numberOfBytes);
+        if(TRACE_MODE_RECORD == __trace_mode) {
+            __trace_log(KIND_READ, handle->deviceID, endpoint, 0,
+                    (retval < 0) ? -1 : retval, data);
+        }
+        return retval;
+    }
+
+    r = __replay_find(KIND_READ, handle->deviceID, endpoint, 0, 1);
+    if(NULL == r) {
+        return READ_FAILED;
+    }
+    __replay_wait(r->micros);
+    return __replay_read(r, data, numberOfBytes);
+}
+
+int
+USBSubmitRead(void *deviceHandle, unsigned char endpoint, char *data,
+        int numberOfBytes) {
+    __trace_handle_t *handle = (__trace_handle_t *)deviceHandle;
+    __trace_record_t *r;
+    int ticket;
+
+    if(NULL == handle) {
+        return SUBMIT_FAILED;
+    }
+
+    if(TRACE_MODE_REPLAY != __trace_mode) {
+        ticket = __native_USBSubmitRead(handle->native, endpoint, data, numberOfBytes);
+        if(ticket >= 0 && ticket < TRACE_MAX_TICKETS) {
+            pthread_mutex_lock(&__trace_lock);
+            handle->tickets[ticket].endpoint = endpoint;
+            handle->tickets[ticket].data = data;
+            handle->tickets[ticket].valid = 1;
+            pthread_mutex_unlock(&__trace_lock);
+        }
+        return ticket;
+    }
+
+    /* Claim the recorded read now so that reads queued on the same endpoint
+     * are served in the order they were submitted.
+     */
+    r = __replay_find(KIND_READ, handle->deviceID, endpoint, 0, 1);
+    if(NULL == r) {
+        return SUBMIT_FAILED;
+    }
+
+    pthread_mutex_lock(&__trace_lock);
+    for(ticket = 0; ticket < TRACE_MAX_TICKETS; ticket++) {
+        if(0 == handle->tickets[ticket].valid) {
+            break;
+        }
+    }
+    if(TRACE_MAX_TICKETS == ticket) {
+        /* Put the record back for whoever asks next */
+        r->consumed = 0;
+        pthread_mutex_unlock(&__trace_lock);
+        return SUBMIT_FAILED;
+    }
+
+    handle->tickets[ticket].endpoint = endpoint;
+    handle->tickets[ticket].data = data;
+    handle->tickets[ticket].valid = 1;
+    handle->tickets[ticket].micros = r->micros;
+    /* The recorded timing is applied when the read is completed */
+    handle->tickets[ticket].length = __replay_read(r, data, numberOfBytes);
+    pthread_mutex_unlock(&__trace_lock);
+    return ticket;
+}
+
+int
+USBCompleteRead(void *deviceHandle, int ticket, int timeoutMillis) {
+    __trace_handle_t *handle = (__trace_handle_t *)deviceHandle;
+    __trace_ticket_t t;
+    int retval;
+
+    if(NULL == handle || ticket < 0) {
+        return READ_FAILED;
+    }
+
+    if(TRACE_MODE_REPLAY != __trace_mode) {
+        retval = __native_USBCompleteRead(handle->native, ticket, timeoutMillis);
+        if(ticket < TRACE_MAX_TICKETS && READ_PENDING != retval) {
+            /* Release the slot before logging, which takes the lock itself */
+            pthread_mutex_lock(&__trace_lock);
+            t = handle->tickets[ticket];
+            handle->tickets[ticket].valid = 0;
+            pthread_mutex_unlock(&__trace_lock);
+            if(TRACE_MODE_RECORD == __trace_mode && 0 != t.valid) {
+                __trace_log(KIND_READ, handle->deviceID, t.endpoint, 0,
+                        (retval < 0) ? -1 : retval, t.data);
+            }
+        }
+        return retval;
+    }
+
+    if(ticket >= TRACE_MAX_TICKETS) {
+        return READ_FAILED;
+    }
+    pthread_mutex_lock(&__trace_lock);
+    t = handle->tickets[ticket];
+    handle->tickets[ticket].valid = 0;
+    pthread_mutex_unlock(&__trace_lock);
+    if(0 == t.valid) {
+        return READ_FAILED;
+    }
+    __replay_wait(t.micros);
+    return t.length;
+}
+
+int
+USBCancelRead(void *deviceHandle, int ticket) {
+    __trace_handle_t *handle = (__trace_handle_t *)deviceHandle;
+
+    if(NULL == handle || ticket < 0) {
+        return ABORT_FAILED;
+    }
+
+    if(ticket < TRACE_MAX_TICKETS) {
+        pthread_mutex_lock(&__trace_lock);
+        handle->tickets[ticket].valid = 0;
+        pthread_mutex_unlock(&__trace_lock);
+    }
+
+    if(TRACE_MODE_REPLAY != __trace_mode) {
+        return __native_USBCancelRead(handle->native, ticket);
+    }
+    return ABORT_OK;
+}
+
+void
+USBClearStall(void *deviceHandle, unsigned char endpoint) {
+    __trace_handle_t *handle = (__trace_handle_t *)deviceHandle;
+
+    if(NULL != handle && NULL != handle->native) {
+        __native_USBClearStall(handle->native, endpoint);
+    }
+}
+
+/* Descriptors are recorded as raw structures since they are only ever
+ * replayed on the same build that recorded them.
+ */
+static int __traced_descriptor(__trace_handle_t *handle, int type, int index,
+        void *desc, int size, int result) {
+    __trace_record_t *r;
+
+    if(TRACE_MODE_RECORD == __trace_mode) {
+        __trace_log(KIND_DESCRIPTOR, handle->deviceID, type, index,
+                (result < 0) ? -1 : size, desc);
+        return result;
+    }
+
+    r = __replay_find(KIND_DESCRIPTOR, handle->deviceID, type, index, 0);
+    if(NULL == r || r->length < 0) {
+        return -2;
+    }
+    memcpy(desc, r->data, (r->length < size) ? r->length : size);
+    return 0;
+}
+
+int
+USBGetDeviceDescriptor(void *deviceHandle, struct USBDeviceDescriptor *desc) {
+    __trace_handle_t *handle = (__trace_handle_t *)deviceHandle;
+    int result = 0;
+
+    if(0 == desc) {
+        return -1;
+    }
+    if(NULL == handle) {
+        return -2;
+    }
+
+    if(TRACE_MODE_REPLAY != __trace_mode) {
+        result = __native_USBGetDeviceDescriptor(handle->native, desc);
+        if(TRACE_MODE_OFF == __trace_mode) {
+            return result;
+        }
+    }
+    return __traced_descriptor(handle, 'd', 0, desc, sizeof(*desc), result);
+}
+
+int
+USBGetInterfaceDescriptor(void *deviceHandle, struct USBInterfaceDescriptor *desc) {
+    __trace_handle_t *handle = (__trace_handle_t *)deviceHandle;
+    int result = 0;
+
+    if(0 == desc) {
+        return -1;
+    }
+    if(NULL == handle) {
+        return -2;
+    }
+
+    if(TRACE_MODE_REPLAY != __trace_mode) {
+        result = __native_USBGetInterfaceDescriptor(handle->native, desc);
+        if(TRACE_MODE_OFF == __trace_mode) {
+            return result;
+        }
+    }
+    return __traced_descriptor(handle, 'i', 0, desc, sizeof(*desc), result);
+}
+
+int
+USBGetEndpointDescriptor(void *deviceHandle, int endpoint_index,
+        struct USBEndpointDescriptor *desc) {
+    __trace_handle_t *handle = (__trace_handle_t *)deviceHandle;
+    int result = 0;
+
+    if(0 == desc) {
+        return -1;
+    }
+    if(NULL == handle) {
+        return -2;
+    }
+
+    if(TRACE_MODE_REPLAY != __trace_mode) {
+        result = __native_USBGetEndpointDescriptor(handle->native, endpoint_index, desc);
+        if(TRACE_MODE_OFF == __trace_mode) {
+            return result;
+        }
+    }
+    return __traced_descriptor(handle, 'e', endpoint_index, desc, sizeof(*desc), result);
+}
+
+int
+USBGetStringDescriptor(void *deviceHandle, unsigned int string_index,
+        char *buffer, int maxLength) {
+    __trace_handle_t *handle = (__trace_handle_t *)deviceHandle;
+    __trace_record_t *r;
+    int length;
+
+    if(NULL == handle || 0 == buffer) {
+        return 0;
+    }
+
+    if(TRACE_MODE_REPLAY != __trace_mode) {
+        length = __native_USBGetStringDescriptor(handle->native, string_index,
+                buffer, maxLength);
+        if(TRACE_MODE_RECORD == __trace_mode) {
+            __trace_log(KIND_DESCRIPTOR, handle->deviceID, 's', string_index,
+                    (length < 0) ? 0 : length, buffer);
+        }
+        return length;
+    }
+
+    r = __replay_find(KIND_DESCRIPTOR, handle->deviceID, 's', string_index, 0);
+    if(NULL == r || r->length <= 0) {
+        buffer[0] = '\0';
+        return 0;
+    }
+    length = (r->length < maxLength) ? r->length : maxLength;
+    memcpy(buffer, r->data, length);
+    return length;
+}
@@ -251,6 +251,34 @@ USBProbeDevices(int vendorID, int productID, unsigned long *output,
     return valid;
 }
 
+/* This platform has no cheap way to classify every device in one pass, so
+ * this simply probes each VID/PID in turn.
+ */
+int
+USBProbeAllDevices(const struct USBDeviceFilter *filters, int numberOfFilters,
+        struct USBProbedDevice *output, int max_devices) {
+    unsigned long ids[MAX_USB_DEVICES];
+    int total = 0;
+    int count;
+    int f;
+    int i;
+
+    for(f = 0; f < numberOfFilters && total < max_devices; f++) {
+        count = USBProbeDevices(filters[f].vendorID, filters[f].productID,
+                ids, MAX_USB_DEVICES);
+        if(count < 0) {
+            return count;
+        }
+        for(i = 0; i < count && total < max_devices; i++, total++) {
+            output[total].deviceID = ids[i];
+            output[total].vendorID = filters[f].vendorID;
+            output[total].productID = filters[f].productID;
+        }
+    }
+
+    return total;
+}
+
 void *
 USBOpen(unsigned long deviceID, int *errorCode) {
     HANDLE dev = NULL;
@@ -391,6 +419,28 @@ USBRead(void *deviceHandle, unsigned char endpoint, char * data, int numberOfByt
     return (int)transferred;
 }
 
+/* Queued reads are not implemented on this platform yet, so callers
+ * are told to fall back to blocking reads via USBRead().
+ */
+int
+USBSubmitRead(void *deviceHandle, unsigned char endpoint, char *data,
+        int numberOfBytes) {
+    (void)deviceHandle; (void)endpoint; (void)data; (void)numberOfBytes;
+    return SUBMIT_UNSUPPORTED;
+}
+
+int
+USBCompleteRead(void *deviceHandle, int ticket, int timeoutMillis) {
+    (void)deviceHandle; (void)ticket; (void)timeoutMillis;
+    return READ_FAILED;
+}
+
+int
+USBCancelRead(void *deviceHandle, int ticket) {
+    (void)deviceHandle; (void)ticket;
+    return ABORT_FAILED;
+}
+
 void
 USBClearStall(void *deviceHandle, unsigned char endpoint) {
     /* Local variables */
@@ -48,27 +48,54 @@ FlameXUSBTransferHelper::~FlameXUSBTransferHelper() {
 
 int FlameXUSBTransferHelper::receive(vector<byte> &buffer,
         unsigned int length) throw (BusTransferException) {
+    return FlameXUSBTransferHelper::receiveInto(buffer, 0, length);
+}
+
+int FlameXUSBTransferHelper::receiveInto(vector<byte> &buffer,
+        unsigned int offset, unsigned int length) throw (BusTransferException) {
+    TransferSegment segment;
+
+    if(buffer.size() < offset + length) {
+        string error("Receive buffer is too small for the requested transfer.");
+        throw BusTransferException(error);
+    }
+
+    segment.data = &(buffer[0]) + offset;
+    segment.length = length;
+
     if(0 != (length % WORD_SIZE_BYTES)) {
-        vector<byte> *inBuffer;
-        int paddedLength;
-        
-        paddedLength = length + (WORD_SIZE_BYTES - (length % WORD_SIZE_BYTES));
-        inBuffer = new vector<byte>(paddedLength);
-        
-        int result = USBTransferHelper::receive(*inBuffer, paddedLength);
-        if(result != paddedLength) {
-            string error("Failed to read padded message length: ");
-            error += (char)result;
-            error += " != ";
-            error += (char)paddedLength;
-            throw BusTransferException(error);
+        unsigned int paddedLength = length
+                + (WORD_SIZE_BYTES - (length % WORD_SIZE_BYTES));
+        if(buffer.size() >= offset + paddedLength) {
+            /* The buffer extends past the requested range, so the padding
+             * can land there as part of one word-aligned read.  Those extra
+             * bytes are not part of the result.
+             */
+            segment.length = paddedLength;
+            int result = USBTransferHelper::receiveSegments(&segment, 1);
+            return (result > (int)length) ? (int)length : result;
         }
-        memcpy(&buffer[0], &inBuffer[0], length);
-        delete inBuffer;
-        return length;
-    } else {
-        return USBTransferHelper::receive(buffer, length);
     }
+
+    return FlameXUSBTransferHelper::receiveSegments(&segment, 1);
+}
+
+int FlameXUSBTransferHelper::receiveSegments(const TransferSegment *segments,
+        unsigned int count) throw (BusTransferException) {
+    unsigned int total = 0;
+
+    for(unsigned int i = 0; i < count; i++) {
+        total += segments[i].length;
+    }
+
+    /* The device only sends whole words, so the read is rounded up and the
+     * padding after the last segment is dropped.
+     */
+    if(0 != (total % WORD_SIZE_BYTES)) {
+        total += WORD_SIZE_BYTES - (total % WORD_SIZE_BYTES);
+    }
+
+    return readSegments(segments, count, total);
 }
 
 int FlameXUSBTransferHelper::send(const std::vector<byte> &buffer,
@@ -77,11 +104,10 @@ int FlameXUSBTransferHelper::send(const std::vector<byte> &buffer,
     if(0 != (length % WORD_SIZE_BYTES)) {
         /* Pad up to a multiple of the word size */
         int paddedLength = length + (WORD_SIZE_BYTES - (length % WORD_SIZE_BYTES));
-        vector<byte> *outBuffer = new vector<byte>(paddedLength);
+        vector<byte> outBuffer(paddedLength, 0);
         memcpy(&outBuffer[0], &buffer[0], length);
-        int result = USBTransferHelper::send(*outBuffer, paddedLength);
-        delete outBuffer;
-        return result;
+        int result = USBTransferHelper::send(outBuffer, paddedLength);
+        return (result > (int)length) ? (int)length : result;
     } else {
         return USBTransferHelper::send(buffer, length);
     }
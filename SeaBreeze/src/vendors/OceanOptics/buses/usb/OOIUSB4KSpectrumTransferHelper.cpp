@@ -29,7 +29,7 @@
 
 #include "common/globals.h"
 #include "vendors/OceanOptics/buses/usb/OOIUSB4KSpectrumTransferHelper.h"
-#include <string.h> /* for memcpy() */
+#include <string>
 
 /* Note that in this mode, the primary high speed endpoint will
  * generally read 5633 bytes, and the secondary will read
@@ -48,8 +48,6 @@ OOIUSB4KSpectrumTransferHelper::OOIUSB4KSpectrumTransferHelper(USB *usb,
     this->sendEndpoint = map.getLowSpeedOutEP();
     this->receiveEndpoint = map.getHighSpeedInEP();
     this->secondaryHighSpeedEP = map.getHighSpeedIn2EP();
-    this->secondaryReadBuffer.resize(SECONDARY_READ_LENGTH);
-    this->primaryReadBuffer.resize(0);
 }
 
 OOIUSB4KSpectrumTransferHelper::~OOIUSB4KSpectrumTransferHelper() {
@@ -58,59 +56,73 @@ OOIUSB4KSpectrumTransferHelper::~OOIUSB4KSpectrumTransferHelper() {
 
 int OOIUSB4KSpectrumTransferHelper::receive(vector<byte> &buffer,
         unsigned int length) throw (BusTransferException) {
-    size_t bytesRead = 0;
-    size_t bytesToCopy;
-    int flag;
-    int retval;
     int primaryReadLength;
+    int secondaryTicket;
+    int primaryTicket = -1;
+    int secondaryFlag;
+    int primaryFlag = 0;
 
     primaryReadLength = length - SECONDARY_READ_LENGTH;
     if(primaryReadLength < 0) {
         primaryReadLength = 0;
     }
-    if(((size_t)primaryReadLength) > this->primaryReadBuffer.size()) {
-        this->primaryReadBuffer.resize(primaryReadLength);
-    }
 
-    /* Read the first 2048 bytes from the secondary high speed endpoint. */
-    /* This may throw a BusTransferException. */
-    flag = this->usb->read(this->secondaryHighSpeedEP, &(this->secondaryReadBuffer[0]), SECONDARY_READ_LENGTH);
-    if(flag >= 0) {
-        bytesRead = flag;
-    }
-    /* Read the remainder from the primary high speed endpoint. */
-    /* This may throw a BusTransferException. */
-    flag = this->usb->read(this->receiveEndpoint, &(primaryReadBuffer[0]), primaryReadLength);
-    if(flag >= 0) {
-        bytesRead += flag;
+    /* Both endpoints read straight into the caller's buffer at the offset
+     * where their data belongs, so the buffer must be able to hold at least
+     * the full secondary read.
+     */
+    if(buffer.size() < SECONDARY_READ_LENGTH + (size_t)primaryReadLength) {
+        buffer.resize(SECONDARY_READ_LENGTH + primaryReadLength);
     }
 
-    /* Compute the number of bytes to copy as the minimum
-     * of the bytes read, the specified read length, and the
-     * size of the destination buffer.  This will let us keep
-     * track of how much data has been copied from each buffer
-     * and hopefully prevent overruns.
+    /* Queue the first 2048 bytes from the secondary high speed endpoint and
+     * the remainder from the primary high speed endpoint so that both are
+     * in flight at once.  If the USB backend cannot queue reads, these are
+     * simply performed in order.
      */
-    bytesToCopy = (bytesRead < length) ? bytesRead : length;
-    bytesToCopy = (length < buffer.size()) ? length : buffer.size();
+    secondaryTicket = this->usb->submitRead(this->secondaryHighSpeedEP,
+            &(buffer[0]), SECONDARY_READ_LENGTH);
+    if(secondaryTicket < 0) {
+        string error("Failed to read any data from USB.");
+        throw BusTransferException(error);
+    }
 
-    retval = (int) bytesToCopy; /* Hold a copy for later */
+    if(primaryReadLength > 0) {
+        primaryTicket = this->usb->submitRead(this->receiveEndpoint,
+                &(buffer[SECONDARY_READ_LENGTH]), primaryReadLength);
+        if(primaryTicket < 0) {
+            this->usb->cancelRead(secondaryTicket);
+            string error("Failed to read any data from USB.");
+            throw BusTransferException(error);
+        }
+    }
 
-    /* Copy the data from the secondary endpoint into the
-     * caller's buffer.
-     */
-    memcpy(&(buffer[0]), &(this->secondaryReadBuffer[0]),
-            (this->secondaryReadBuffer.size() <= bytesToCopy) ? this->secondaryReadBuffer.size() : bytesToCopy);
-    bytesToCopy -= this->secondaryReadBuffer.size();
+    secondaryFlag = this->usb->completeRead(secondaryTicket);
+    if(primaryTicket >= 0) {
+        primaryFlag = this->usb->completeRead(primaryTicket);
+    }
 
-    // if(bytesToCopy < 0) { // size_t doesn't need this
-    //    bytesToCopy = 0;
-    // }
+    if(secondaryFlag < 0 || primaryFlag < 0) {
+        string error("Failed to read spectrum from USB.");
+        throw BusTransferException(error);
+    }
+
+    return (secondaryFlag + primaryFlag < (int)length) ? secondaryFlag + primaryFlag : (int)length;
+}
 
-    /* Copy the remaining data from the primary buffer */
-    memcpy(&(buffer[this->secondaryReadBuffer.size() * sizeof (byte)]),
-            &(this->primaryReadBuffer[0]),
-            (this->primaryReadBuffer.size() < bytesToCopy) ? this->primaryReadBuffer.size() : bytesToCopy);
+int OOIUSB4KSpectrumTransferHelper::receiveInto(vector<byte> &buffer,
+        unsigned int offset, unsigned int length) throw (BusTransferException) {
+    /* Spectra are split across two endpoints in receive(), so route partial
+     * reads through it rather than reading a single endpoint directly.
+     */
+    return TransferHelper::receiveInto(buffer, offset, length);
+}
 
-    return retval;
+int OOIUSB4KSpectrumTransferHelper::receiveSegments(
+        const TransferSegment *segments, unsigned int count)
+        throw (BusTransferException) {
+    /* As above, the message goes through one receive() so that it is
+     * split between the endpoints only where the device splits it.
+     */
+    return TransferHelper::receiveSegments(segments, count);
 }
@@ -49,22 +49,8 @@ EEPROMSlotFeature::~EEPROMSlotFeature() {
 vector< vector<byte> * > *EEPROMSlotFeature::readAllEEPROMSlots(
         const Protocol &protocol, const Bus &bus) throw (FeatureException) {
 
-    unsigned int i;
-    vector< vector<byte> * > *retval = new vector< vector<byte> * >();
-
-    for(i = 0; i < this->numberOfSlots; i++) {
-        try {
-            /* This may throw a FeatureException */
-            retval[i].push_back(readEEPROMSlot(protocol, bus, i));
-        } catch (IllegalArgumentException &iae) {
-            /* This shouldn't be possible since the loop is enumerating
-             * the known range of slots, but recover anyway
-             */
-            continue;
-        }
-    }
-
-    return retval;
+    /* This may throw a FeatureException */
+    return readEEPROMSlots(protocol, bus, 0, this->numberOfSlots);
 }
 
 vector<byte> *EEPROMSlotFeature::readEEPROMSlot(const Protocol &protocol,
@@ -47,6 +47,24 @@ using namespace std;
 #pragma warning (disable: 4101) // unreferenced local variable
 #endif
 
+/* Copies the text at the start of a slot into a 20-byte buffer, stopping at
+ * the end of the slot.  Returns false if the slot is empty.
+ */
+static bool copySlotText(const vector<byte> &slot, char *buffer) {
+    size_t length = slot.size();
+
+    if(0 == length) {
+        buffer[0] = '\0';
+        return false;
+    }
+    if(length > 19) {
+        length = 19;
+    }
+    memset(buffer, 0, 20);
+    memcpy(buffer, &(slot[0]), length);
+    return true;
+}
+
 EEPROMSlotFeatureBase::EEPROMSlotFeatureBase() {
     /* TODO: in the future, the protocol(s) should be passed in */
     this->protocols.push_back(new OOIEEPROMProtocol());
@@ -97,6 +115,40 @@ vector<byte> *EEPROMSlotFeatureBase::readEEPROMSlot(const Protocol &protocol,
     return info;
 }
 
+vector<vector<byte> *> *EEPROMSlotFeatureBase::readEEPROMSlots(
+        const Protocol &protocol, const Bus &bus, unsigned int firstSlot,
+        unsigned int count) throw (FeatureException) {
+
+    EEPROMProtocolInterface *eeprom = NULL;
+    ProtocolHelper *proto;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        eeprom = static_cast<EEPROMProtocolInterface *>(proto);
+    } catch (FeatureProtocolNotFoundException &fpnfe) {
+        string error(
+                "Could not find matching protocol implementation to get read EEPROM.");
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    vector<vector<byte> *> *slots = NULL;
+
+    try {
+        slots = eeprom->readEEPROMSlots(bus, firstSlot, count);
+    } catch (ProtocolException &pe) {
+        string error("Caught protocol exception: ");
+        error += pe.what();
+        throw FeatureControlException(error);
+    }
+
+    if(NULL == slots) {
+        string error("Could not read EEPROM slots.");
+        throw FeatureControlException(error);
+    }
+
+    return slots;
+}
+
 int EEPROMSlotFeatureBase::writeEEPROMSlot(const Protocol &protocol,
         const Bus &bus, unsigned int slot, const vector<byte> &data)
         throw (FeatureException, IllegalArgumentException) {
@@ -127,7 +179,6 @@ double EEPROMSlotFeatureBase::readDouble(const Protocol &protocol, const Bus &bu
         unsigned int slotNumber) throw (FeatureException, NumberFormatException) {
     LOG(__FUNCTION__);
 
-    char buffer[20];
     double retval = 0.0;
     vector<byte> *slot;
 
@@ -138,9 +189,66 @@ double EEPROMSlotFeatureBase::readDouble(const Protocol &protocol, const Bus &bu
         throw FeatureException("Trying to read and parse invalid slot.");
     }
 
+    try {
+        retval = parseDouble(*slot);
+    } catch (NumberFormatException &nfe) {
+        delete slot;
+        throw;
+    }
+
+    delete slot;
+
+    return retval;
+}
+
+vector<double> *EEPROMSlotFeatureBase::readDoubles(const Protocol &protocol,
+        const Bus &bus, unsigned int firstSlot, unsigned int count)
+        throw (FeatureException, NumberFormatException) {
+    LOG(__FUNCTION__);
+
+    vector<vector<byte> *> *slots;
+    vector<double> *retval;
+    unsigned int i;
+
+    /* This may throw a FeatureException, but cannot return NULL. */
+    slots = readEEPROMSlots(protocol, bus, firstSlot, count);
+
+    retval = new vector<double>(slots->size());
+    try {
+        for(i = 0; i < slots->size(); i++) {
+            (*retval)[i] = parseDouble(*(*slots)[i]);
+        }
+    } catch (NumberFormatException &nfe) {
+        delete retval;
+        retval = NULL;
+    }
+
+    for(i = 0; i < slots->size(); i++) {
+        delete (*slots)[i];
+    }
+    delete slots;
+
+    if(NULL == retval) {
+        /* parseDouble() has already logged the failure */
+        throw NumberFormatException("Could not parse double out of EEPROM slot.");
+    }
+
+    return retval;
+}
+
+double EEPROMSlotFeatureBase::parseDouble(const vector<byte> &slot)
+        throw (NumberFormatException) {
+    LOG(__FUNCTION__);
+
+    char buffer[20];
+    double retval = 0.0;
+
     /* First, guarantee that the string we parse is null-terminated. 20 bytes is overkill. */
-    strncpy(buffer, ((char *)&((*slot)[0])), 19);
-    buffer[19] = '\0';
+    if(false == copySlotText(slot, buffer)) {
+        string error("EEPROM slot is empty; no double to parse.");
+        logger.error(error.c_str());
+        throw NumberFormatException(error);
+    }
     try
     {
         std::istringstream istr(buffer);
@@ -154,12 +262,9 @@ double EEPROMSlotFeatureBase::readDouble(const Protocol &protocol, const Bus &bu
          */
         string error("Could not parse double out of EEPROM slot.");
         logger.error(error.c_str());
-        delete slot;
         throw NumberFormatException(error);
     }
 
-    delete slot;
-
     return retval;
 }
 
@@ -184,8 +289,12 @@ long EEPROMSlotFeatureBase::readLong(const Protocol &protocol, const Bus &bus,
      */
 
     /* First, guarantee that the string we parse is null-terminated. 20 bytes is overkill. */
-    strncpy(buffer, ((char *)&((*slot)[0])), 19);
-    buffer[19] = '\0';
+    if(false == copySlotText(*slot, buffer)) {
+        string error("EEPROM slot is empty; no int to parse.");
+        logger.error(error.c_str());
+        delete slot;
+        throw NumberFormatException(error);
+    }
     try
     {
         std::istringstream istr(buffer);
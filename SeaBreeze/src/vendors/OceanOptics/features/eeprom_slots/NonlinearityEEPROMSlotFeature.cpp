@@ -40,18 +40,19 @@ using namespace seabreeze::api;
 using namespace std;
 
 NonlinearityEEPROMSlotFeature::NonlinearityEEPROMSlotFeature() {
-
+    this->cachedCoefficients = NULL;
 }
 
 NonlinearityEEPROMSlotFeature::~NonlinearityEEPROMSlotFeature() {
-
+    invalidateCalibration();
 }
 
 #ifdef _WINDOWS
 #pragma warning (disable: 4101) // unreferenced local variable
 #endif
-vector<double> *NonlinearityEEPROMSlotFeature::readNonlinearityCoefficients(
-        const Protocol &protocol, const Bus &bus) throw (FeatureException) {
+vector<double> *NonlinearityEEPROMSlotFeature::readCoefficientsFromDevice(
+        const Protocol &protocol, const Bus &bus, bool &usedDefaults)
+        throw (FeatureException) {
     LOG(__FUNCTION__)
 
     int i;
@@ -59,6 +60,8 @@ vector<double> *NonlinearityEEPROMSlotFeature::readNonlinearityCoefficients(
     int numberCoeffs;
     vector<double> *retval;
 
+    usedDefaults = false;
+
     try {
         /* Order of the polynomial is stored in slot 14 */
         order = (int)readLong(protocol, bus, __NONLINEARITY_ORDER_SLOT);
@@ -69,34 +72,117 @@ vector<double> *NonlinearityEEPROMSlotFeature::readNonlinearityCoefficients(
 
     /* Must add one to the order to include the 0th order coefficient */
     numberCoeffs = order + 1;
-    retval = new vector<double>(numberCoeffs);
-
-    for(i = 0; i < numberCoeffs; i++) {
-        /* Nonlinearity coefficients are stored starting with intercept at slot 6 */
-        try {
-            /* This may throw a FeatureException or NumberFormatException */
-            (*retval)[i] = readDouble(protocol, bus, i + __NONLINEARITY_SLOT_ORDER_ZERO);
-        } catch (NumberFormatException &nfe) {
-            logger.error("Could not parse NLC coeff");
-            for(i = 0; i < numberCoeffs; i++) {
-                /* Set the polynomial such that the correction is negated.
-                 */
-                if(0 == i) {
-                    (*retval)[i] = 1.0;
-                } else {
-                    (*retval)[i] = 0.0;
-                }
+
+    /* Nonlinearity coefficients are stored starting with intercept at slot 6.
+     * A FeatureException means the bus failed, so it goes to the caller.
+     */
+    try {
+        retval = readDoubles(protocol, bus, __NONLINEARITY_SLOT_ORDER_ZERO,
+                numberCoeffs);
+    } catch (NumberFormatException &nfe) {
+        logger.error("Could not parse NLC coeff");
+        retval = new vector<double>(numberCoeffs);
+        for(i = 0; i < numberCoeffs; i++) {
+            /* Set the polynomial such that the correction is negated.
+             */
+            if(0 == i) {
+                (*retval)[i] = 1.0;
+            } else {
+                (*retval)[i] = 0.0;
             }
-            break;
-        } catch (const exception &ex) {
-            logger.error("Caught unknown exception reading NLC coeff");
-            (*retval)[i] = 0;
         }
+        usedDefaults = true;
     }
 
     return retval;
 }
 
+vector<double> *NonlinearityEEPROMSlotFeature::readCoefficients(
+        const Protocol &protocol, const Bus &bus, bool &usedDefaults)
+        throw (FeatureException) {
+
+    usedDefaults = false;
+    if(NULL != this->cachedCoefficients) {
+        return new vector<double>(*(this->cachedCoefficients));
+    }
+
+    vector<double> *coeffs = readCoefficientsFromDevice(protocol, bus,
+            usedDefaults);
+    /* Defaults stand in for a damaged calibration and are not kept, so the
+     * device is asked again next time.
+     */
+    if(NULL != coeffs && false == usedDefaults) {
+        this->cachedCoefficients = new vector<double>(*coeffs);
+    }
+
+    return coeffs;
+}
+
+vector<double> *NonlinearityEEPROMSlotFeature::readNonlinearityCoefficients(
+        const Protocol &protocol, const Bus &bus) throw (FeatureException) {
+    bool usedDefaults;
+
+    return readCoefficients(protocol, bus, usedDefaults);
+}
+
+void NonlinearityEEPROMSlotFeature::invalidateCalibration() {
+    if(NULL != this->cachedCoefficients) {
+        delete this->cachedCoefficients;
+        this->cachedCoefficients = NULL;
+    }
+}
+
+void NonlinearityEEPROMSlotFeature::saveCalibration(const Protocol &protocol,
+        const Bus &bus, DeviceDescriptor &descriptor) throw (FeatureException) {
+
+    bool usedDefaults;
+    vector<double> *coeffs = readCoefficients(protocol, bus, usedDefaults);
+
+    if(NULL == coeffs) {
+        /* The device has none; an empty entry records that */
+        descriptor.setValues("nonlinearity", vector<double>());
+        return;
+    }
+
+    if(true == usedDefaults) {
+        /* Left out, so loading the descriptor rereads the device */
+        delete coeffs;
+        return;
+    }
+
+    descriptor.setValues("nonlinearity", *coeffs);
+    delete coeffs;
+}
+
+bool NonlinearityEEPROMSlotFeature::loadCalibration(const DeviceDescriptor &descriptor) {
+
+    const vector<double> *coeffs = descriptor.getValues("nonlinearity");
+
+    invalidateCalibration();
+    if(NULL != coeffs && !coeffs->empty()) {
+        this->cachedCoefficients = new vector<double>(*coeffs);
+    }
+    return true;
+}
+
+void NonlinearityEEPROMSlotFeature::fingerprintCalibration(const Protocol &protocol,
+        const Bus &bus, vector<double> &fingerprint) throw (FeatureException) {
+
+    /* Only a handful of EEPROM slots, so they are simply reread */
+    bool usedDefaults;
+    vector<double> *coeffs = readCoefficientsFromDevice(protocol, bus,
+            usedDefaults);
+
+    if(NULL == coeffs) {
+        fingerprint.push_back(-1);
+        return;
+    }
+
+    fingerprint.push_back((double)coeffs->size());
+    fingerprint.insert(fingerprint.end(), coeffs->begin(), coeffs->end());
+    delete coeffs;
+}
+
 FeatureFamily NonlinearityEEPROMSlotFeature::getFeatureFamily() {
     FeatureFamilies families;
 
@@ -43,18 +43,19 @@ using namespace seabreeze::api;
 using namespace std;
 
 StrayLightEEPROMSlotFeature::StrayLightEEPROMSlotFeature() {
-
+    this->cachedCoefficients = NULL;
 }
 
 StrayLightEEPROMSlotFeature::~StrayLightEEPROMSlotFeature() {
-
+    invalidateCalibration();
 }
 
 #ifdef _WINDOWS
 #pragma warning (disable: 4101) // unreferenced local variable
 #endif
-vector<double> *StrayLightEEPROMSlotFeature::readStrayLightCoefficients(
-        const Protocol &protocol, const Bus &bus) throw (FeatureException) {
+vector<double> *StrayLightEEPROMSlotFeature::readCoefficientsFromDevice(
+        const Protocol &protocol, const Bus &bus, bool &usedDefaults)
+        throw (FeatureException) {
     LOG(__FUNCTION__);
 
     unsigned int i, j, k;
@@ -64,6 +65,8 @@ vector<double> *StrayLightEEPROMSlotFeature::readStrayLightCoefficients(
     char buffer[20] = { 0 };
     double temp;
 
+    usedDefaults = false;
+
     try {
         /* This may throw an exception -- if it does, don't catch it here. */
         rawSlot = readEEPROMSlot(protocol, bus, __STRAY_LIGHT_EEPROM_SLOT);
@@ -82,7 +85,7 @@ vector<double> *StrayLightEEPROMSlotFeature::readStrayLightCoefficients(
      * slot by separating them with a NULL terminator.  This will try to
      * identify when a second term is available.
      */
-    for(i = 0; i < rawSlot->size() - 1; i++) {
+    for(i = 0; i + 1 < rawSlot->size(); i++) {
         if('\0' == (*rawSlot)[i] &&
                 ('\0' != (*rawSlot)[i+1] && 0xFF != (*rawSlot)[i+1])) {
             /* There appears to be a second constant after the null terminator
@@ -106,6 +109,7 @@ vector<double> *StrayLightEEPROMSlotFeature::readStrayLightCoefficients(
         (*retval)[0] = readDouble(protocol, bus, __STRAY_LIGHT_EEPROM_SLOT);
     } catch (NumberFormatException &nfe) {
         (*retval)[0] = 0;
+        usedDefaults = true;
     }
 
     if(numberCoeffs > 1) {
@@ -129,6 +133,90 @@ vector<double> *StrayLightEEPROMSlotFeature::readStrayLightCoefficients(
     return retval;
 }
 
+vector<double> *StrayLightEEPROMSlotFeature::readCoefficients(
+        const Protocol &protocol, const Bus &bus, bool &usedDefaults)
+        throw (FeatureException) {
+
+    usedDefaults = false;
+    if(NULL != this->cachedCoefficients) {
+        return new vector<double>(*(this->cachedCoefficients));
+    }
+
+    vector<double> *coeffs = readCoefficientsFromDevice(protocol, bus,
+            usedDefaults);
+    /* A zero put in for an unreadable slot is not worth remembering */
+    if(NULL != coeffs && false == usedDefaults) {
+        this->cachedCoefficients = new vector<double>(*coeffs);
+    }
+
+    return coeffs;
+}
+
+vector<double> *StrayLightEEPROMSlotFeature::readStrayLightCoefficients(
+        const Protocol &protocol, const Bus &bus) throw (FeatureException) {
+    bool usedDefaults;
+
+    return readCoefficients(protocol, bus, usedDefaults);
+}
+
+void StrayLightEEPROMSlotFeature::invalidateCalibration() {
+    if(NULL != this->cachedCoefficients) {
+        delete this->cachedCoefficients;
+        this->cachedCoefficients = NULL;
+    }
+}
+
+void StrayLightEEPROMSlotFeature::saveCalibration(const Protocol &protocol,
+        const Bus &bus, DeviceDescriptor &descriptor) throw (FeatureException) {
+
+    bool usedDefaults;
+    vector<double> *coeffs = readCoefficients(protocol, bus, usedDefaults);
+
+    if(NULL == coeffs) {
+        /* The device has none; an empty entry records that */
+        descriptor.setValues("stray_light", vector<double>());
+        return;
+    }
+
+    if(true == usedDefaults) {
+        /* Not saved; the device is read again after a reload */
+        delete coeffs;
+        return;
+    }
+
+    descriptor.setValues("stray_light", *coeffs);
+    delete coeffs;
+}
+
+bool StrayLightEEPROMSlotFeature::loadCalibration(const DeviceDescriptor &descriptor) {
+
+    const vector<double> *coeffs = descriptor.getValues("stray_light");
+
+    invalidateCalibration();
+    if(NULL != coeffs && !coeffs->empty()) {
+        this->cachedCoefficients = new vector<double>(*coeffs);
+    }
+    return true;
+}
+
+void StrayLightEEPROMSlotFeature::fingerprintCalibration(const Protocol &protocol,
+        const Bus &bus, vector<double> &fingerprint) throw (FeatureException) {
+
+    /* A single EEPROM slot holds these */
+    bool usedDefaults;
+    vector<double> *coeffs = readCoefficientsFromDevice(protocol, bus,
+            usedDefaults);
+
+    if(NULL == coeffs) {
+        fingerprint.push_back(-1);
+        return;
+    }
+
+    fingerprint.push_back((double)coeffs->size());
+    fingerprint.insert(fingerprint.end(), coeffs->begin(), coeffs->end());
+    delete coeffs;
+}
+
 FeatureFamily StrayLightEEPROMSlotFeature::getFeatureFamily() {
     FeatureFamilies families;
 
@@ -42,6 +42,7 @@ using namespace std;
 
 WavelengthEEPROMSlotFeature::WavelengthEEPROMSlotFeature(unsigned int numPixels) {
     this->numberOfPixels = numPixels;
+    this->usedDefaults = false;
 }
 
 WavelengthEEPROMSlotFeature::~WavelengthEEPROMSlotFeature() {
@@ -52,34 +53,43 @@ vector<double> *WavelengthEEPROMSlotFeature::readWavelengths(const Protocol &pro
         const Bus &bus) throw (FeatureException) {
 
     double polynomial[4]; /* order of term equals index of term */
+    vector<double> *coeffs;
     int i;
 
-    for(i = 0; i < 4; i++) {
-        /* Wavelength coefficients are stored starting with intercept at slot 1 */
-        try {
-            /* This may throw a FeatureException or NumberFormatException */
-            polynomial[i] = readDouble(protocol, bus, i + 1);
-        } catch (NumberFormatException &nfe) {
-            /* FIXME: If there were some sort of logging mechanism, this would
-             * be a good thing to warn about.
+    this->usedDefaults = false;
+
+    /* Wavelength coefficients are stored starting with intercept at slot 1 */
+    try {
+        /* This may throw a FeatureException or NumberFormatException */
+        coeffs = readDoubles(protocol, bus, 1, 4);
+        for(i = 0; i < 4; i++) {
+            polynomial[i] = (*coeffs)[i];
+        }
+        delete coeffs;
+    } catch (NumberFormatException &nfe) {
+        /* FIXME: If there were some sort of logging mechanism, this would
+         * be a good thing to warn about.
+         */
+        for(i = 0; i < 4; i++) {
+            /* Set the polynomial such that the reported wavelength equals
+             * the pixel number.
              */
-            for(i = 0; i < 4; i++) {
-                /* Set the polynomial such that the reported wavelength equals
-                 * the pixel number.
-                 */
-                if(1 == i) {
-                    polynomial[i] = 1.0;
-                } else {
-                    polynomial[i] = 0.0;
-                }
+            if(1 == i) {
+                polynomial[i] = 1.0;
+            } else {
+                polynomial[i] = 0.0;
             }
-            break;
         }
+        this->usedDefaults = true;
     }
 
     return computeWavelengths(polynomial, 4);
 }
 
+bool WavelengthEEPROMSlotFeature::usedDefaultCalibration() {
+    return this->usedDefaults;
+}
+
 /* Note: this should probably be broken out or delegated to a more generic
  * polynomial evaluation function that can be reused.
  */
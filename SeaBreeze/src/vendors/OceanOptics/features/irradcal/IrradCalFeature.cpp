@@ -50,10 +50,11 @@ IrradCalFeature::IrradCalFeature(vector<ProtocolHelper *> helpers, int numPixels
     }
 
     this->numberOfPixels = numPixels;
+    this->cachedCalibration = NULL;
 }
 
 IrradCalFeature::~IrradCalFeature() {
-
+    invalidateCalibration();
 }
 
 int IrradCalFeature::getNumberOfPixels() {
@@ -67,6 +68,10 @@ vector<float> *IrradCalFeature::readIrradCalibration(const Protocol &protocol,
     IrradCalProtocolInterface *cpi = NULL;
     ProtocolHelper *proto;
 
+    if(NULL != this->cachedCalibration) {
+        return new vector<float>(*(this->cachedCalibration));
+    }
+
     try {
         proto = lookupProtocolImpl(protocol);
         cpi = static_cast<IrradCalProtocolInterface *>(proto);
@@ -86,6 +91,10 @@ vector<float> *IrradCalFeature::readIrradCalibration(const Protocol &protocol,
         throw FeatureControlException(error);
     }
 
+    if(NULL != data) {
+        this->cachedCalibration = new vector<float>(*data);
+    }
+
     return data;
 }
 
@@ -106,6 +115,9 @@ int IrradCalFeature::writeIrradCalibration(const Protocol &protocol,
         throw FeatureProtocolNotFoundException(error);
     }
 
+    /* Even a failed write may have changed part of the stored calibration */
+    invalidateCalibration();
+
     try {
         written = cpi->writeIrradCal(bus, calibration);
     } catch (ProtocolException &pe) {
@@ -190,6 +202,55 @@ void IrradCalFeature::writeCollectionArea(const Protocol &protocol,
 }
 
 
+void IrradCalFeature::invalidateCalibration() {
+    if(NULL != this->cachedCalibration) {
+        delete this->cachedCalibration;
+        this->cachedCalibration = NULL;
+    }
+}
+
+void IrradCalFeature::saveCalibration(const Protocol &protocol,
+        const Bus &bus, DeviceDescriptor &descriptor) throw (FeatureException) {
+
+    vector<float> *calibration = readIrradCalibration(protocol, bus);
+
+    if(NULL == calibration) {
+        descriptor.setValues("irradiance", vector<double>());
+        return;
+    }
+
+    /* Every float is exactly representable as a double */
+    descriptor.setValues("irradiance",
+            vector<double>(calibration->begin(), calibration->end()));
+    delete calibration;
+}
+
+bool IrradCalFeature::loadCalibration(const DeviceDescriptor &descriptor) {
+
+    const vector<double> *calibration = descriptor.getValues("irradiance");
+
+    invalidateCalibration();
+    if(NULL != calibration && !calibration->empty()) {
+        this->cachedCalibration = new vector<float>(calibration->begin(),
+                calibration->end());
+    }
+    return true;
+}
+
+void IrradCalFeature::fingerprintCalibration(const Protocol &protocol,
+        const Bus &bus, vector<double> &fingerprint) throw (FeatureException) {
+
+    /* Rereading the table would cost as much as not caching it, so only the
+     * collection area is checked.  Tables written through SeaBreeze drop the
+     * cached copy anyway.
+     */
+    if(0 == hasCollectionArea(protocol, bus)) {
+        fingerprint.push_back(-1);
+        return;
+    }
+    fingerprint.push_back(readCollectionArea(protocol, bus));
+}
+
 FeatureFamily IrradCalFeature::getFeatureFamily() {
     FeatureFamilies families;
 
@@ -46,16 +46,18 @@ NonlinearityCoeffsFeature::NonlinearityCoeffsFeature(vector<ProtocolHelper *> he
     for(iter = helpers.begin(); iter != helpers.end(); iter++) {
         this->protocols.push_back(*iter);
     }
+
+    this->cachedCoefficients = NULL;
 }
 
 NonlinearityCoeffsFeature::~NonlinearityCoeffsFeature() {
-
+    invalidateCalibration();
 }
 
 #ifdef _WINDOWS
 #pragma warning (disable: 4101) // unreferenced local variable
 #endif
-vector<double> *NonlinearityCoeffsFeature::readNonlinearityCoefficients(
+vector<double> *NonlinearityCoeffsFeature::readCoefficientsFromDevice(
         const Protocol &protocol, const Bus &bus) throw (FeatureException) {
 
     NonlinearityCoeffsProtocolInterface *nonlinearity = NULL;
@@ -74,7 +76,6 @@ vector<double> *NonlinearityCoeffsFeature::readNonlinearityCoefficients(
 
     try {
         coeffs = nonlinearity->readNonlinearityCoeffs(bus);
-        return coeffs;
     } catch (ProtocolException &pe) {
         string error("Caught protocol exception: ");
         error += pe.what();
@@ -82,10 +83,75 @@ vector<double> *NonlinearityCoeffsFeature::readNonlinearityCoefficients(
         throw FeatureControlException(error);
     }
 
-    /* Unreachable */
-    return NULL;
+    return coeffs;
+}
+
+vector<double> *NonlinearityCoeffsFeature::readNonlinearityCoefficients(
+        const Protocol &protocol, const Bus &bus) throw (FeatureException) {
+
+    if(NULL != this->cachedCoefficients) {
+        return new vector<double>(*(this->cachedCoefficients));
+    }
+
+    vector<double> *coeffs = readCoefficientsFromDevice(protocol, bus);
+    if(NULL != coeffs) {
+        this->cachedCoefficients = new vector<double>(*coeffs);
+    }
+
+    return coeffs;
 }
 
+void NonlinearityCoeffsFeature::invalidateCalibration() {
+    if(NULL != this->cachedCoefficients) {
+        delete this->cachedCoefficients;
+        this->cachedCoefficients = NULL;
+    }
+}
+
+void NonlinearityCoeffsFeature::saveCalibration(const Protocol &protocol,
+        const Bus &bus, DeviceDescriptor &descriptor) throw (FeatureException) {
+
+    vector<double> *coeffs = readNonlinearityCoefficients(protocol, bus);
+
+    if(NULL == coeffs) {
+        /* The device has none; an empty entry records that */
+        descriptor.setValues("nonlinearity", vector<double>());
+        return;
+    }
+
+    descriptor.setValues("nonlinearity", *coeffs);
+    delete coeffs;
+}
+
+bool NonlinearityCoeffsFeature::loadCalibration(const DeviceDescriptor &descriptor) {
+
+    const vector<double> *coeffs = descriptor.getValues("nonlinearity");
+
+    invalidateCalibration();
+    if(NULL != coeffs && !coeffs->empty()) {
+        this->cachedCoefficients = new vector<double>(*coeffs);
+    }
+    return true;
+}
+
+void NonlinearityCoeffsFeature::fingerprintCalibration(const Protocol &protocol,
+        const Bus &bus, vector<double> &fingerprint) throw (FeatureException) {
+
+    /* The coefficients are few enough that they serve as their own
+     * fingerprint.  The count goes first so that a missing set differs
+     * from an empty one.
+     */
+    vector<double> *coeffs = readCoefficientsFromDevice(protocol, bus);
+
+    if(NULL == coeffs) {
+        fingerprint.push_back(-1);
+        return;
+    }
+
+    fingerprint.push_back((double)coeffs->size());
+    fingerprint.insert(fingerprint.end(), coeffs->begin(), coeffs->end());
+    delete coeffs;
+}
 
 FeatureFamily NonlinearityCoeffsFeature::getFeatureFamily() {
     FeatureFamilies families;
@@ -0,0 +1,192 @@
+/***************************************************//**
+ * @file    FastBufferSpectrumStream.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Implementation of the fast buffer streaming thread.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "vendors/OceanOptics/features/spectrometer/FastBufferSpectrumStream.h"
+
+using namespace seabreeze;
+using namespace std;
+
+/* The FlameX returns at most this many spectra for one request */
+#define SPECTRA_PER_REQUEST     15
+
+/* Queuing a second request means the device can start on it while the
+ * thread is still receiving the previous batch.
+ */
+#define REQUESTS_PER_ROUND      2
+
+FastBufferSpectrumStream::FastBufferSpectrumStream(
+        OOISpectrometerFeatureInterface *f, const Protocol *p, const Bus *b,
+        Mutex *l, unsigned int recordLength, unsigned int capacity)
+            : spectra(recordLength, capacity) {
+    this->feature = f;
+    this->protocol = p;
+    this->bus = b;
+    this->busLock = l;
+    this->stopRequested = false;
+    this->failed = false;
+}
+
+FastBufferSpectrumStream::~FastBufferSpectrumStream() {
+    stopStreaming();
+}
+
+bool FastBufferSpectrumStream::startStreaming() {
+    if(true == isStarted()) {
+        return true;
+    }
+
+    this->lock.lock();
+    this->stopRequested = false;
+    this->failed = false;
+    this->lock.unlock();
+
+    return start();
+}
+
+void FastBufferSpectrumStream::stopStreaming() {
+    if(false == isStarted()) {
+        return;
+    }
+
+    this->lock.lock();
+    this->stopRequested = true;
+    this->lock.unlock();
+
+    join();
+}
+
+unsigned int FastBufferSpectrumStream::readSpectra(byte *buffer,
+        unsigned int maxSpectra) {
+    unsigned int count = 0;
+
+    while(count < maxSpectra && true == this->spectra.pop(
+            buffer + (count * this->spectra.getRecordLength()))) {
+        count++;
+    }
+    return count;
+}
+
+unsigned int FastBufferSpectrumStream::getRecordLength() const {
+    return this->spectra.getRecordLength();
+}
+
+unsigned int FastBufferSpectrumStream::getOverrunCount() {
+    return this->spectra.getOverrunCount();
+}
+
+bool FastBufferSpectrumStream::hasFailed() {
+    MutexLock guard(this->lock);
+    return this->failed;
+}
+
+bool FastBufferSpectrumStream::isStopRequested() {
+    MutexLock guard(this->lock);
+    return this->stopRequested;
+}
+
+void FastBufferSpectrumStream::run() {
+    vector<vector<byte> *> batches;
+    bool roundFailed;
+    unsigned int i;
+
+    while(false == isStopRequested()) {
+        roundFailed = false;
+        try {
+            exchangeRound(batches);
+        } catch (FeatureException &fe) {
+            roundFailed = true;
+        }
+
+        /* The bus is free again, so other commands can go ahead while the
+         * spectra are split up.  Batches that arrived before a failure are
+         * still good.
+         */
+        for(i = 0; i < batches.size(); i++) {
+            if(NULL != batches[i]) {
+                publish(*batches[i]);
+                delete batches[i];
+            }
+        }
+        batches.clear();
+
+        if(true == roundFailed) {
+            MutexLock guard(this->lock);
+            this->failed = true;
+            break;
+        }
+    }
+}
+
+void FastBufferSpectrumStream::exchangeRound(vector<vector<byte> *> &batches)
+        throw (FeatureException) {
+    unsigned int outstanding;
+
+    if(NULL != this->busLock) {
+        this->busLock->lock();
+    }
+
+    /* Every request must be matched by a response before the bus is let go,
+     * or the next command's reply would arrive behind a spectrum.
+     */
+    try {
+        for(outstanding = 0; outstanding < REQUESTS_PER_ROUND; outstanding++) {
+            this->feature->fastBufferSpectrumRequest(*this->protocol,
+                    *this->bus, SPECTRA_PER_REQUEST);
+        }
+        for(; outstanding > 0; outstanding--) {
+            batches.push_back(this->feature->fastBufferSpectrumResponse(
+                    *this->protocol, *this->bus, SPECTRA_PER_REQUEST));
+        }
+    } catch (FeatureException &fe) {
+        if(NULL != this->busLock) {
+            this->busLock->unlock();
+        }
+        throw;
+    }
+
+    if(NULL != this->busLock) {
+        this->busLock->unlock();
+    }
+}
+
+void FastBufferSpectrumStream::publish(const vector<byte> &batch) {
+    unsigned int length = this->spectra.getRecordLength();
+
+    if(0 == length) {
+        return;
+    }
+
+    /* Any partial record at the end cannot be a valid spectrum */
+    for(unsigned int offset = 0; offset + length <= batch.size(); offset += length) {
+        this->spectra.push(&batch[offset]);
+    }
+}
@@ -41,6 +41,7 @@
 #include "vendors/OceanOptics/protocols/obp/impls/OBPWaveCalProtocol.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadSpectrumExchange.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadNumberOfRawSpectraWithMetadataExchange.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
 
 using namespace seabreeze;
 using namespace seabreeze::oceanBinaryProtocol;
@@ -59,6 +60,7 @@ FlameXSpectrometerFeature::FlameXSpectrometerFeature(IntrospectionFeature *intro
     
 	myIntrospection = introspection;
 	myFastBuffer = fastBuffer;
+	this->introspectionLoaded = false;
 
     this->numberOfPixels = 2136;
 	this->numberOfBytesPerPixel = sizeof(unsigned short);
@@ -107,7 +109,7 @@ FlameXSpectrometerFeature::~FlameXSpectrometerFeature() {
 
 }
 
-vector<double> *FlameXSpectrometerFeature::getWavelengths(const Protocol &protocol,
+vector<double> *FlameXSpectrometerFeature::readWavelengths(const Protocol &protocol,
             const Bus &bus) throw (FeatureException) {
 
     /* FIXME: this probably ought to attempt to create an instance based on
@@ -127,10 +129,13 @@ bool FlameXSpectrometerFeature::initialize(const Protocol &protocol, const Bus &
 	bool result = false;
 	if (myIntrospection != NULL)
 	{
-		this->numberOfPixels = myIntrospection->getNumberOfPixels(protocol, bus);
-		this->activePixelIndices = *(myIntrospection->getActivePixelRanges(protocol, bus));
-		this->electricDarkPixelIndices = *(myIntrospection->getElectricDarkPixelRanges(protocol, bus));
-		this->opticalDarkPixelIndices = *(myIntrospection->getOpticalDarkPixelRanges(protocol, bus));
+		if (!this->introspectionLoaded)
+		{
+			this->numberOfPixels = myIntrospection->getNumberOfPixels(protocol, bus);
+			this->activePixelIndices = *(myIntrospection->getActivePixelRanges(protocol, bus));
+			this->electricDarkPixelIndices = *(myIntrospection->getElectricDarkPixelRanges(protocol, bus));
+			this->opticalDarkPixelIndices = *(myIntrospection->getOpticalDarkPixelRanges(protocol, bus));
+		}
 		
 		for(unsigned int i=0; i<this->protocols.size();i++) 
 		{
@@ -165,4 +170,101 @@ bool FlameXSpectrometerFeature::initialize(const Protocol &protocol, const Bus &
 	return result;
 }
 
+void FlameXSpectrometerFeature::invalidateCalibration() {
+    this->introspectionLoaded = false;
+    OOISpectrometerFeature::invalidateCalibration();
+}
+
+void FlameXSpectrometerFeature::saveCalibration(const Protocol &protocol,
+        const Bus &bus, DeviceDescriptor &descriptor) throw (FeatureException) {
+
+    descriptor.setValues("pixels", vector<double>(1, this->numberOfPixels));
+    descriptor.setValues("active_pixels", vector<double>(
+            this->activePixelIndices.begin(), this->activePixelIndices.end()));
+    descriptor.setValues("electric_dark_pixels", vector<double>(
+            this->electricDarkPixelIndices.begin(), this->electricDarkPixelIndices.end()));
+    descriptor.setValues("optical_dark_pixels", vector<double>(
+            this->opticalDarkPixelIndices.begin(), this->opticalDarkPixelIndices.end()));
+
+    OOISpectrometerFeature::saveCalibration(protocol, bus, descriptor);
+}
+
+bool FlameXSpectrometerFeature::loadCalibration(const DeviceDescriptor &descriptor) {
+
+    const vector<double> *pixels = descriptor.getValues("pixels");
+
+    invalidateCalibration();
+    if(NULL == pixels) {
+        /* The layout will be probed during initialize() as usual */
+        return OOISpectrometerFeature::loadCalibration(descriptor);
+    }
+    if(pixels->size() != 1 || (*pixels)[0] < 1 || (*pixels)[0] > 65535) {
+        return false;
+    }
+
+    vector<unsigned int> active;
+    vector<unsigned int> electricDark;
+    vector<unsigned int> opticalDark;
+    if(!loadIndices(descriptor, "active_pixels", active)
+            || !loadIndices(descriptor, "electric_dark_pixels", electricDark)
+            || !loadIndices(descriptor, "optical_dark_pixels", opticalDark)) {
+        return false;
+    }
+
+    unsigned short savedPixels = this->numberOfPixels;
+    this->numberOfPixels = (unsigned short)(*pixels)[0];
+
+    /* The wavelengths are checked against the pixel count loaded above */
+    if(false == OOISpectrometerFeature::loadCalibration(descriptor)) {
+        this->numberOfPixels = savedPixels;
+        return false;
+    }
+
+    this->activePixelIndices = active;
+    this->electricDarkPixelIndices = electricDark;
+    this->opticalDarkPixelIndices = opticalDark;
+    this->introspectionLoaded = true;
+    return true;
+}
+
+unsigned int FlameXSpectrometerFeature::getFastBufferSpectrumLength() const {
+    return OBPSpectrumBatchView::RECORD_METADATA_LENGTH
+            + (this->numberOfPixels * this->numberOfBytesPerPixel)
+            + OBPSpectrumBatchView::RECORD_CHECKSUM_LENGTH;
+}
+
+unsigned int FlameXSpectrometerFeature::decodeFastBufferSpectra(
+        const byte *buffer, unsigned int length, SpectrumMetadata *metadata,
+        byte *valid, unsigned int maxSpectra) const {
+    OBPSpectrumBatchView batch(buffer, length, getFastBufferSpectrumLength());
+    unsigned int count = batch.getRecordCount();
+
+    if(count > maxSpectra) {
+        count = maxSpectra;
+    }
+    for(unsigned int i = 0; i < count; i++) {
+        batch.getMetadata(i, metadata[i]);
+        valid[i] = (true == batch.isRecordValid(i)) ? 1 : 0;
+    }
+    return count;
+}
+
+bool FlameXSpectrometerFeature::loadIndices(const DeviceDescriptor &descriptor,
+        const string &name, vector<unsigned int> &indices) {
+
+    const vector<double> *values = descriptor.getValues(name);
+    if(NULL == values) {
+        return false;
+    }
+
+    indices.clear();
+    for(unsigned int i = 0; i < values->size(); i++) {
+        if((*values)[i] < 0) {
+            return false;
+        }
+        indices.push_back((unsigned int)(*values)[i]);
+    }
+    return true;
+}
+
 
@@ -54,7 +54,8 @@ using namespace std;
 #endif
 
 OOISpectrometerFeature::OOISpectrometerFeature() {
-
+    this->cachedWavelengths = NULL;
+    this->wavelengthsAreDefaults = false;
 }
 
 OOISpectrometerFeature::~OOISpectrometerFeature() {
@@ -63,6 +64,8 @@ OOISpectrometerFeature::~OOISpectrometerFeature() {
     for(iter = this->triggerModes.begin(); iter != this->triggerModes.end(); iter++) {
         delete *iter;
     }
+
+    invalidateCalibration();
 }
 
 vector<double> *OOISpectrometerFeature::getFormattedSpectrum(const Protocol &protocol, const Bus &bus) throw (FeatureException) {
@@ -100,6 +103,81 @@ vector<double> *OOISpectrometerFeature::getFormattedSpectrum(const Protocol &pro
     return retval;
 }
 
+unsigned int OOISpectrometerFeature::getFormattedSpectrum(const Protocol &protocol,
+        const Bus &bus, double *buffer, unsigned int bufferLength)
+        throw (FeatureException) {
+    return getFormattedSpectrumInto(protocol, bus, buffer, bufferLength);
+}
+
+unsigned int OOISpectrometerFeature::getFormattedSpectrum(const Protocol &protocol,
+        const Bus &bus, float *buffer, unsigned int bufferLength)
+        throw (FeatureException) {
+    return getFormattedSpectrumInto(protocol, bus, buffer, bufferLength);
+}
+
+unsigned int OOISpectrometerFeature::getFormattedSpectrum(const Protocol &protocol,
+        const Bus &bus, unsigned short *buffer, unsigned int bufferLength)
+        throw (FeatureException) {
+    return getFormattedSpectrumInto(protocol, bus, buffer, bufferLength);
+}
+
+unsigned int OOISpectrometerFeature::getFormattedSpectrum(const Protocol &protocol,
+        const Bus &bus, unsigned int *buffer, unsigned int bufferLength)
+        throw (FeatureException) {
+    return getFormattedSpectrumInto(protocol, bus, buffer, bufferLength);
+}
+
+template <class T> unsigned int OOISpectrometerFeature::getFormattedSpectrumInto(
+        const Protocol &protocol, const Bus &bus, T *buffer,
+        unsigned int bufferLength) throw (FeatureException) {
+
+    LOG(__FUNCTION__);
+
+    ProtocolHelper *proto;
+    SpectrometerProtocolInterface *spec;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        spec = static_cast<SpectrometerProtocolInterface *>(proto);
+    } catch (FeatureProtocolNotFoundException &e) {
+        string error("Could not find matching protocol implementation to get a formatted spectrum.");
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    writeRequestFormattedSpectrum(protocol, bus);
+
+    try {
+        return spec->readFormattedSpectrum(bus, buffer, bufferLength);
+    } catch (ProtocolException &pe) {
+        string error("Caught protocol exception: ");
+        error += pe.what();
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throw FeatureControlException(error);
+    }
+}
+
+bool OOISpectrometerFeature::getFormattedSpectrumMetadata(
+        const Protocol &protocol, SpectrumMetadata &metadata)
+        throw (FeatureException) {
+
+    LOG(__FUNCTION__);
+
+    ProtocolHelper *proto;
+    SpectrometerProtocolInterface *spec;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        spec = static_cast<SpectrometerProtocolInterface *>(proto);
+    } catch (FeatureProtocolNotFoundException &e) {
+        string error("Could not find matching protocol implementation to get spectrum metadata.");
+        /* FIXME: previous exception should probably be bundled up into the new exception */
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    return spec->getFormattedSpectrumMetadata(metadata);
+}
+
 vector<byte> *OOISpectrometerFeature::getUnformattedSpectrum(
         const Protocol &protocol, const Bus &bus) throw (FeatureException) {
     LOG(__FUNCTION__);
@@ -135,6 +213,33 @@ vector<byte> *OOISpectrometerFeature::fastBufferSpectrumResponse(
 
 
 
+SpectrometerProtocolBinding *OOISpectrometerFeature::bindSpectrumAcquisition(
+        const Protocol &protocol, const Bus &bus) throw (FeatureException) {
+
+    LOG(__FUNCTION__);
+
+    ProtocolHelper *proto;
+    SpectrometerProtocolInterface *spec;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        spec = static_cast<SpectrometerProtocolInterface *>(proto);
+    } catch (FeatureProtocolNotFoundException &e) {
+        string error("Could not find matching protocol implementation to bind spectrum acquisition.");
+        logger.error(error.c_str());
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    try {
+        return spec->bindSpectrumAcquisition(bus);
+    } catch (ProtocolException &pe) {
+        string error("Caught protocol exception: ");
+        error += pe.what();
+        logger.error(error.c_str());
+        throw FeatureControlException(error);
+    }
+}
+
 void OOISpectrometerFeature::writeRequestFormattedSpectrum(const Protocol &protocol,
         const Bus &bus) throw (FeatureException) {
 
@@ -300,9 +405,92 @@ vector<byte> *OOISpectrometerFeature::readFastBufferSpectrum(const Protocol &pro
 vector<double> *OOISpectrometerFeature::getWavelengths(const Protocol &protocol,
         const Bus &bus) throw (FeatureException) {
 
+    vector<double> *wavelengths;
+
+    if(NULL != this->cachedWavelengths) {
+        return new vector<double>(*(this->cachedWavelengths));
+    }
+
+    /* This may throw a FeatureException, in which case nothing is cached */
+    this->wavelengthsAreDefaults = false;
+    wavelengths = readWavelengths(protocol, bus);
+    if(false == this->wavelengthsAreDefaults) {
+        this->cachedWavelengths = new vector<double>(*wavelengths);
+    }
+
+    return wavelengths;
+}
+
+vector<double> *OOISpectrometerFeature::readWavelengths(const Protocol &protocol,
+        const Bus &bus) throw (FeatureException) {
+
     WavelengthEEPROMSlotFeature wlFeature(this->numberOfPixels);
+    vector<double> *wavelengths = wlFeature.readWavelengths(protocol, bus);
+
+    this->wavelengthsAreDefaults = wlFeature.usedDefaultCalibration();
+    return wavelengths;
+}
 
-    return wlFeature.readWavelengths(protocol, bus);
+void OOISpectrometerFeature::invalidateCalibration() {
+    if(NULL != this->cachedWavelengths) {
+        delete this->cachedWavelengths;
+        this->cachedWavelengths = NULL;
+    }
+}
+
+void OOISpectrometerFeature::saveCalibration(const Protocol &protocol,
+        const Bus &bus, DeviceDescriptor &descriptor) throw (FeatureException) {
+
+    vector<double> *wavelengths = getWavelengths(protocol, bus);
+
+    /* A stand-in calibration stays out of the descriptor so that it does
+     * not outlive the fault that produced it.
+     */
+    if(false == this->wavelengthsAreDefaults) {
+        descriptor.setValues("wavelengths", *wavelengths);
+    }
+    delete wavelengths;
+}
+
+bool OOISpectrometerFeature::loadCalibration(const DeviceDescriptor &descriptor) {
+
+    const vector<double> *wavelengths = descriptor.getValues("wavelengths");
+
+    invalidateCalibration();
+    this->wavelengthsAreDefaults = false;
+    if(NULL == wavelengths) {
+        /* Not saved, so it will be read from the device when needed */
+        return true;
+    }
+    if(wavelengths->size() != this->numberOfPixels) {
+        return false;
+    }
+
+    this->cachedWavelengths = new vector<double>(*wavelengths);
+    return true;
+}
+
+void OOISpectrometerFeature::fingerprintCalibration(const Protocol &protocol,
+        const Bus &bus, vector<double> &fingerprint) throw (FeatureException) {
+
+    vector<double> *wavelengths = readWavelengths(protocol, bus);
+    unsigned int last;
+
+    if(NULL == wavelengths) {
+        fingerprint.push_back(-1);
+        return;
+    }
+
+    /* The calibration is at most a cubic, which four points pin down */
+    fingerprint.push_back((double)wavelengths->size());
+    if(false == wavelengths->empty()) {
+        last = (unsigned int)wavelengths->size() - 1;
+        fingerprint.push_back((*wavelengths)[0]);
+        fingerprint.push_back((*wavelengths)[last / 3]);
+        fingerprint.push_back((*wavelengths)[2 * last / 3]);
+        fingerprint.push_back((*wavelengths)[last]);
+    }
+    delete wavelengths;
 }
 
 void OOISpectrometerFeature::setIntegrationTimeMicros(const Protocol &protocol,
@@ -418,6 +606,17 @@ unsigned short OOISpectrometerFeature::getNumberOfPixels() const {
     return this->numberOfPixels;
 }
 
+unsigned int OOISpectrometerFeature::getFastBufferSpectrumLength() const {
+    /* Only devices with a fast buffer override this */
+    return 0;
+}
+
+unsigned int OOISpectrometerFeature::decodeFastBufferSpectra(const byte *buffer,
+        unsigned int length, SpectrumMetadata *metadata, byte *valid,
+        unsigned int maxSpectra) const {
+    return 0;
+}
+
 int OOISpectrometerFeature::getMaximumIntensity() const {
     return this->maxIntensity;
 }
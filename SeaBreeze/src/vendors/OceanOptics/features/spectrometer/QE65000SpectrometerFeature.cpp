@@ -94,10 +94,12 @@ QE65000SpectrometerFeature::~QE65000SpectrometerFeature() {
 
 }
 
-vector<double> *QE65000SpectrometerFeature::getWavelengths(
+vector<double> *QE65000SpectrometerFeature::readWavelengths(
             const Protocol &protocol, const Bus &bus) throw (FeatureException) {
 
     WavelengthEEPROMSlotFeature_QE65000 wlFeature(this->numberOfPixels);
+    vector<double> *wavelengths = wlFeature.readWavelengths(protocol, bus);
 
-    return wlFeature.readWavelengths(protocol, bus);
+    this->wavelengthsAreDefaults = wlFeature.usedDefaultCalibration();
+    return wavelengths;
 }
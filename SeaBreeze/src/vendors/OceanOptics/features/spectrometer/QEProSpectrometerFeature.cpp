@@ -97,7 +97,7 @@ QEProSpectrometerFeature::~QEProSpectrometerFeature() {
 
 }
 
-vector<double> *QEProSpectrometerFeature::getWavelengths(const Protocol &protocol,
+vector<double> *QEProSpectrometerFeature::readWavelengths(const Protocol &protocol,
             const Bus &bus) throw (FeatureException) {
 
     /* FIXME: this probably ought to attempt to create an instance based on
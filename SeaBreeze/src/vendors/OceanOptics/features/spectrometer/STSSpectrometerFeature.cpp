@@ -95,9 +95,12 @@ void STSSpectrometerFeature::setPixelBinningFactor(unsigned char factor) {
     readUnformattedSpectrum->setNumberOfPixels(numberOfPixels * 2 + 64, numberOfPixels);
 	readFastBufferSpectrum->setNumberOfPixels(numberOfPixels * 2 + 64, numberOfPixels);
     readFormattedSpectrum->setNumberOfPixels(numberOfPixels * 2 + 64, numberOfPixels);
+
+    /* The cached wavelengths were averaged down for the old binning factor */
+    invalidateCalibration();
 }
 
-vector<double> *STSSpectrometerFeature::getWavelengths(const Protocol &protocol,
+vector<double> *STSSpectrometerFeature::readWavelengths(const Protocol &protocol,
             const Bus &bus) throw (FeatureException) {
 
     /* FIXME: this probably ought to attempt to create an instance based on
@@ -84,7 +84,7 @@ VentanaSpectrometerFeature::~VentanaSpectrometerFeature() {
 
 }
 
-vector<double> *VentanaSpectrometerFeature::getWavelengths(const Protocol &protocol,
+vector<double> *VentanaSpectrometerFeature::readWavelengths(const Protocol &protocol,
             const Bus &bus) throw (FeatureException) {
 
     /* FIXME: this probably ought to attempt to create an instance based on
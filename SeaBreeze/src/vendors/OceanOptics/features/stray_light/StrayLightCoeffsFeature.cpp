@@ -46,16 +46,18 @@ StrayLightCoeffsFeature::StrayLightCoeffsFeature(vector<ProtocolHelper *> helper
     for(iter = helpers.begin(); iter != helpers.end(); iter++) {
         this->protocols.push_back(*iter);
     }
+
+    this->cachedCoefficients = NULL;
 }
 
 StrayLightCoeffsFeature::~StrayLightCoeffsFeature() {
-
+    invalidateCalibration();
 }
 
 #ifdef _WINDOWS
 #pragma warning (disable: 4101) // unreferenced local variable
 #endif
-vector<double> *StrayLightCoeffsFeature::readStrayLightCoefficients(
+vector<double> *StrayLightCoeffsFeature::readCoefficientsFromDevice(
         const Protocol &protocol, const Bus &bus) throw (FeatureException) {
 
     StrayLightCoeffsProtocolInterface *stray = NULL;
@@ -74,7 +76,6 @@ vector<double> *StrayLightCoeffsFeature::readStrayLightCoefficients(
 
     try {
         coeffs = stray->readStrayLightCoeffs(bus);
-        return coeffs;
     } catch (ProtocolException &pe) {
         string error("Caught protocol exception: ");
         error += pe.what();
@@ -82,10 +83,72 @@ vector<double> *StrayLightCoeffsFeature::readStrayLightCoefficients(
         throw FeatureControlException(error);
     }
 
-    /* Unreachable */
-    return NULL;
+    return coeffs;
+}
+
+vector<double> *StrayLightCoeffsFeature::readStrayLightCoefficients(
+        const Protocol &protocol, const Bus &bus) throw (FeatureException) {
+
+    if(NULL != this->cachedCoefficients) {
+        return new vector<double>(*(this->cachedCoefficients));
+    }
+
+    vector<double> *coeffs = readCoefficientsFromDevice(protocol, bus);
+    if(NULL != coeffs) {
+        this->cachedCoefficients = new vector<double>(*coeffs);
+    }
+
+    return coeffs;
 }
 
+void StrayLightCoeffsFeature::invalidateCalibration() {
+    if(NULL != this->cachedCoefficients) {
+        delete this->cachedCoefficients;
+        this->cachedCoefficients = NULL;
+    }
+}
+
+void StrayLightCoeffsFeature::saveCalibration(const Protocol &protocol,
+        const Bus &bus, DeviceDescriptor &descriptor) throw (FeatureException) {
+
+    vector<double> *coeffs = readStrayLightCoefficients(protocol, bus);
+
+    if(NULL == coeffs) {
+        /* The device has none; an empty entry records that */
+        descriptor.setValues("stray_light", vector<double>());
+        return;
+    }
+
+    descriptor.setValues("stray_light", *coeffs);
+    delete coeffs;
+}
+
+bool StrayLightCoeffsFeature::loadCalibration(const DeviceDescriptor &descriptor) {
+
+    const vector<double> *coeffs = descriptor.getValues("stray_light");
+
+    invalidateCalibration();
+    if(NULL != coeffs && !coeffs->empty()) {
+        this->cachedCoefficients = new vector<double>(*coeffs);
+    }
+    return true;
+}
+
+void StrayLightCoeffsFeature::fingerprintCalibration(const Protocol &protocol,
+        const Bus &bus, vector<double> &fingerprint) throw (FeatureException) {
+
+    /* One or two values; the count keeps "none" distinct from empty */
+    vector<double> *coeffs = readCoefficientsFromDevice(protocol, bus);
+
+    if(NULL == coeffs) {
+        fingerprint.push_back(-1);
+        return;
+    }
+
+    fingerprint.push_back((double)coeffs->size());
+    fingerprint.insert(fingerprint.end(), coeffs->begin(), coeffs->end());
+    delete coeffs;
+}
 
 FeatureFamily StrayLightCoeffsFeature::getFeatureFamily() {
     FeatureFamilies families;
@@ -143,6 +143,34 @@ vector<double> *TemperatureFeature::readAllTemperatures(
     return NULL;
 }
 
+vector<double> *TemperatureFeature::readAllTemperaturesWithTEC(
+        const Protocol &protocol, const Bus &bus, double *tecTemperature,
+        bool *tecRead) throw (FeatureException) {
+
+    TemperatureProtocolInterface *temperaturePI = NULL;
+    ProtocolHelper *proto = NULL;
+
+    *tecRead = false;
+
+    try {
+        proto = lookupProtocolImpl(protocol);
+        temperaturePI = static_cast<TemperatureProtocolInterface *>(proto);
+    } catch (FeatureProtocolNotFoundException &e) {
+        string error(
+                "Could not find matching protocol implementation to get temperature.");
+        throw FeatureProtocolNotFoundException(error);
+    }
+
+    try {
+        return temperaturePI->readAllTemperaturesWithTEC(bus, tecTemperature,
+                tecRead);
+    } catch (ProtocolException &pe) {
+        string error("Caught protocol exception: ");
+        error += pe.what();
+        throw FeatureControlException(error);
+    }
+}
+
 FeatureFamily TemperatureFeature::getFeatureFamily() {
     FeatureFamilies families;
 
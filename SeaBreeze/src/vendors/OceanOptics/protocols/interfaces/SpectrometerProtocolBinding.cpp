@@ -0,0 +1,155 @@
+/***************************************************//**
+ * @file    SpectrometerProtocolBinding.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include "vendors/OceanOptics/protocols/interfaces/SpectrometerProtocolBinding.h"
+#include "vendors/OceanOptics/protocols/interfaces/SpectrometerProtocolInterface.h"
+#include "common/ByteVector.h"
+#include "common/exceptions/ProtocolBusMismatchException.h"
+#include <string.h>
+
+using namespace seabreeze;
+using namespace std;
+
+SpectrometerProtocolBinding::SpectrometerProtocolBinding(
+        SpectrometerProtocolInterface *protocol, const Bus &bus,
+        Transfer *requestFormattedSpectrum, Transfer *readFormattedSpectrum,
+        Transfer *requestUnformattedSpectrum, Transfer *readUnformattedSpectrum)
+        throw (ProtocolException) {
+    this->protocol = protocol;
+    this->bus = &bus;
+
+    this->requestFormattedSpectrumExchange = requestFormattedSpectrum;
+    this->readFormattedSpectrumExchange = readFormattedSpectrum;
+    this->requestUnformattedSpectrumExchange = requestUnformattedSpectrum;
+    this->readUnformattedSpectrumExchange = readUnformattedSpectrum;
+
+    this->requestFormattedSpectrumHelper = findHelper(bus, requestFormattedSpectrum);
+    this->readFormattedSpectrumHelper = findHelper(bus, readFormattedSpectrum);
+    this->requestUnformattedSpectrumHelper = findHelper(bus, requestUnformattedSpectrum);
+    this->readUnformattedSpectrumHelper = findHelper(bus, readUnformattedSpectrum);
+
+    this->receiver = dynamic_cast<SpectrumReceiverInterface *>(readFormattedSpectrum);
+}
+
+SpectrometerProtocolBinding::~SpectrometerProtocolBinding() {
+    /* The exchanges and helpers belong to the protocol and the bus */
+}
+
+TransferHelper *SpectrometerProtocolBinding::findHelper(const Bus &bus,
+        Transfer *exchange) throw (ProtocolException) {
+    TransferHelper *helper;
+
+    if(NULL == exchange) {
+        string error("The protocol has no exchange for this spectrum type.");
+        throw ProtocolException(error);
+    }
+
+    helper = bus.getHelper(exchange->getHints());
+    if(NULL == helper) {
+        string error("Failed to find a helper to bridge given protocol and bus.");
+        throw ProtocolBusMismatchException(error);
+    }
+    return helper;
+}
+
+void SpectrometerProtocolBinding::requestFormattedSpectrum()
+        throw (ProtocolException) {
+    /* This transfer() may cause a ProtocolException to be thrown. */
+    this->requestFormattedSpectrumExchange->transfer(
+            this->requestFormattedSpectrumHelper);
+}
+
+unsigned int SpectrometerProtocolBinding::readFormattedSpectrum(double *buffer,
+        unsigned int bufferLength) throw (ProtocolException) {
+    return readFormattedSpectrumInto(buffer, bufferLength);
+}
+
+unsigned int SpectrometerProtocolBinding::readFormattedSpectrum(float *buffer,
+        unsigned int bufferLength) throw (ProtocolException) {
+    return readFormattedSpectrumInto(buffer, bufferLength);
+}
+
+unsigned int SpectrometerProtocolBinding::readFormattedSpectrum(
+        unsigned short *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return readFormattedSpectrumInto(buffer, bufferLength);
+}
+
+unsigned int SpectrometerProtocolBinding::readFormattedSpectrum(
+        unsigned int *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return readFormattedSpectrumInto(buffer, bufferLength);
+}
+
+template <class T> unsigned int SpectrometerProtocolBinding::readFormattedSpectrumInto(
+        T *buffer, unsigned int bufferLength) throw (ProtocolException) {
+
+    if(NULL == this->receiver) {
+        /* The protocol knows how to convert whatever this exchange makes */
+        return this->protocol->readFormattedSpectrum(*this->bus, buffer,
+                bufferLength);
+    }
+
+    /* This may cause a ProtocolException to be thrown. */
+    return this->receiver->receiveFormattedSpectrum(
+            this->readFormattedSpectrumHelper, buffer, bufferLength);
+}
+
+void SpectrometerProtocolBinding::requestUnformattedSpectrum()
+        throw (ProtocolException) {
+    /* This transfer() may cause a ProtocolException to be thrown. */
+    this->requestUnformattedSpectrumExchange->transfer(
+            this->requestUnformattedSpectrumHelper);
+}
+
+unsigned int SpectrometerProtocolBinding::readUnformattedSpectrum(byte *buffer,
+        unsigned int bufferLength) throw (ProtocolException) {
+    Data *result;
+    unsigned int length;
+
+    /* This transfer() may cause a ProtocolException to be thrown. */
+    result = this->readUnformattedSpectrumExchange->transfer(
+            this->readUnformattedSpectrumHelper);
+    if(NULL == result) {
+        string error("Got NULL when expecting spectral data which was unexpected.");
+        throw ProtocolException(error);
+    }
+
+    /* Copy straight out of the exchange's result rather than through
+     * another vector.
+     */
+    vector<byte> &bytes = static_cast<ByteVector *>(result)->getByteVector();
+    length = (bytes.size() < bufferLength) ? (unsigned int) bytes.size() : bufferLength;
+    if(length > 0) {
+        memcpy(buffer, &bytes[0], length);
+    }
+    delete result;
+
+    return length;
+}
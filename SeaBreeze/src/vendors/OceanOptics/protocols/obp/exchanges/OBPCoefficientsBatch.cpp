@@ -0,0 +1,108 @@
+/***************************************************//**
+ * @file    OBPCoefficientsBatch.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * This reads a whole family of calibration coefficients
+ * (e.g. wavelength or nonlinearity) from an OBP device
+ * as a single pipelined batch rather than one query
+ * per coefficient.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPCoefficientsBatch.h"
+
+using namespace seabreeze;
+using namespace seabreeze::oceanBinaryProtocol;
+using namespace std;
+
+OBPCoefficientsBatch::OBPCoefficientsBatch(unsigned int coefficientMessageType,
+        unsigned int countMessageType) {
+    this->coefficientMessageType = coefficientMessageType;
+    this->countMessageType = countMessageType;
+}
+
+OBPCoefficientsBatch::~OBPCoefficientsBatch() {
+
+}
+
+vector<double> *OBPCoefficientsBatch::readCoefficients(TransferHelper *helper)
+        throw (ProtocolException) {
+    const vector<byte> *countResult;
+    unsigned int count;
+
+    clear();
+    addQuery(this->countMessageType);
+    queryDevice(helper);
+
+    countResult = getResult(0);
+    if(NULL == countResult || countResult->empty()
+            || (*countResult)[0] > MAXIMUM_COEFFICIENTS) {
+        /* Device is incapable of providing these coefficients */
+        return NULL;
+    }
+    count = (*countResult)[0];
+
+    return readCoefficients(helper, count);
+}
+
+vector<double> *OBPCoefficientsBatch::readCoefficients(TransferHelper *helper,
+        unsigned int count) throw (ProtocolException) {
+    const vector<byte> *result;
+    vector<double> *retval;
+    vector<byte> index(1);
+    float coeff;
+    byte *bptr;
+    unsigned int i;
+
+    clear();
+    for(i = 0; i < count; i++) {
+        index[0] = (byte) i;
+        addQuery(this->coefficientMessageType, index);
+    }
+    queryDevice(helper);
+
+    retval = new vector<double>(count);
+    for(i = 0; i < count; i++) {
+        result = getResult(i);
+        if(NULL == result || result->size() < sizeof(float)) {
+            string error("Expected Transfer::transfer to produce a non-null result "
+                "containing a coefficient.  Without this data, it is not possible to "
+                "continue.");
+            delete retval;
+            throw ProtocolException(error);
+        }
+
+        bptr = (byte *)&coeff;
+        for(unsigned int j = 0; j < sizeof(float); j++) {
+            bptr[j] = (*result)[j];
+        }
+
+        (*retval)[i] = coeff;  /* Only one is returned per request */
+    }
+
+    return retval;
+}
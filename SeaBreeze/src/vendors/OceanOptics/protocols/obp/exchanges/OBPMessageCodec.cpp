@@ -0,0 +1,374 @@
+/***************************************************//**
+ * @file    OBPMessageCodec.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Allocation-free encoding and in-place decoding of OBP
+ * messages.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
+#include <string.h>
+
+/* x86-64 always has SSE2; 32-bit x86 only when the compiler is told so */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OBP_CHECKSUM_SSE2
+#include <emmintrin.h>
+#endif
+
+/* Fixed offsets within an OBP message */
+#define OBP_OFFSET_START_BYTES          0
+#define OBP_OFFSET_PROTOCOL_VERSION     2
+#define OBP_OFFSET_FLAGS                4
+#define OBP_OFFSET_ERRNO                6
+#define OBP_OFFSET_MESSAGE_TYPE         8
+#define OBP_OFFSET_REGARDING            12
+#define OBP_OFFSET_RESERVED             16
+#define OBP_OFFSET_CHECKSUM_TYPE        22
+#define OBP_OFFSET_IMMEDIATE_LENGTH     23
+#define OBP_OFFSET_IMMEDIATE_DATA       24
+#define OBP_OFFSET_BYTES_REMAINING      40
+
+#define OBP_PROTOCOL_VERSION            0x1100
+
+using namespace seabreeze;
+using namespace seabreeze::oceanBinaryProtocol;
+using namespace std;
+
+static const byte obpStartBytes[] = { 0xC1, 0xC0 };
+static const byte obpFooter[] = { 0xC5, 0xC4, 0xC3, 0xC2 };
+
+bool OBPMessageCodec::isFooter(const byte *buffer) {
+    return 0 == memcmp(buffer, obpFooter, sizeof(obpFooter));
+}
+
+unsigned short OBPMessageCodec::readUShort(const byte *buffer) {
+    return (unsigned short)((buffer[0] & 0x00FF)
+            | ((buffer[1] & 0x00FF) << 8));
+}
+
+unsigned int OBPMessageCodec::readUInt(const byte *buffer) {
+    return (buffer[0] & 0x00FF)
+            | ((buffer[1] & 0x00FF) << 8)
+            | ((buffer[2] & 0x00FF) << 16)
+            | ((unsigned int)(buffer[3] & 0x00FF) << 24);
+}
+
+void OBPMessageCodec::readSpectrumMetadata(const byte *buffer,
+        SpectrumMetadata &metadata) {
+    metadata.spectrumCount = readUInt(buffer);
+    metadata.tickCountMicros = readUInt(buffer + 4)
+            | ((unsigned long long)readUInt(buffer + 8) << 32);
+    metadata.integrationTimeMicros = readUInt(buffer + 12);
+    metadata.triggerMode = buffer[16];
+}
+
+void OBPMessageCodec::writeUShort(byte *buffer, unsigned short value) {
+    buffer[0] = value & 0x00FF;
+    buffer[1] = (value >> 8) & 0x00FF;
+}
+
+void OBPMessageCodec::writeUInt(byte *buffer, unsigned int value) {
+    buffer[0] = value & 0x00FF;
+    buffer[1] = (value >> 8) & 0x00FF;
+    buffer[2] = (value >> 16) & 0x00FF;
+    buffer[3] = (value >> 24) & 0x00FF;
+}
+
+unsigned int OBPMessageCodec::getEncodedLength(unsigned int dataLength) {
+    if(dataLength <= IMMEDIATE_DATA_LENGTH) {
+        return MINIMUM_MESSAGE_LENGTH;
+    }
+    return MINIMUM_MESSAGE_LENGTH + dataLength;
+}
+
+unsigned int OBPMessageCodec::encode(byte *buffer, unsigned int bufferLength,
+        unsigned int messageType, unsigned short flags,
+        const byte *data, unsigned int dataLength, unsigned int regarding)
+        throw (IllegalArgumentException) {
+    unsigned int messageLength = getEncodedLength(dataLength);
+    unsigned int payloadLength = 0;
+    byte *checksum;
+
+    if(NULL == buffer || bufferLength < messageLength) {
+        string error("Buffer is too small for OBP message");
+        throw IllegalArgumentException(error);
+    }
+
+    memcpy(buffer + OBP_OFFSET_START_BYTES, obpStartBytes, sizeof(obpStartBytes));
+    writeUShort(buffer + OBP_OFFSET_PROTOCOL_VERSION, OBP_PROTOCOL_VERSION);
+    writeUShort(buffer + OBP_OFFSET_FLAGS, flags);
+    writeUShort(buffer + OBP_OFFSET_ERRNO, 0);
+    writeUInt(buffer + OBP_OFFSET_MESSAGE_TYPE, messageType);
+    writeUInt(buffer + OBP_OFFSET_REGARDING, regarding);
+    memset(buffer + OBP_OFFSET_RESERVED, 0,
+            OBP_OFFSET_CHECKSUM_TYPE - OBP_OFFSET_RESERVED);
+    buffer[OBP_OFFSET_CHECKSUM_TYPE] = 0;
+
+    /* Immediate data and payload are mutually exclusive */
+    memset(buffer + OBP_OFFSET_IMMEDIATE_DATA, 0, IMMEDIATE_DATA_LENGTH);
+    if(dataLength <= IMMEDIATE_DATA_LENGTH) {
+        buffer[OBP_OFFSET_IMMEDIATE_LENGTH] = (byte)dataLength;
+        if(dataLength > 0) {
+            memcpy(buffer + OBP_OFFSET_IMMEDIATE_DATA, data, dataLength);
+        }
+    } else {
+        buffer[OBP_OFFSET_IMMEDIATE_LENGTH] = 0;
+        payloadLength = dataLength;
+        memcpy(buffer + HEADER_LENGTH, data, dataLength);
+    }
+
+    writeUInt(buffer + OBP_OFFSET_BYTES_REMAINING,
+            payloadLength + CHECKSUM_LENGTH + FOOTER_LENGTH);
+
+    /* Checksum (zero for now), then the footer */
+    checksum = buffer + HEADER_LENGTH + payloadLength;
+    memset(checksum, 0, CHECKSUM_LENGTH);
+    memcpy(checksum + CHECKSUM_LENGTH, obpFooter, sizeof(obpFooter));
+
+    return messageLength;
+}
+
+unsigned int OBPMessageCodec::encode(vector<byte> &buffer,
+        unsigned int messageType, unsigned short flags,
+        const byte *data, unsigned int dataLength, unsigned int regarding) {
+    unsigned int messageLength = getEncodedLength(dataLength);
+
+    buffer.resize(messageLength);
+    return encode(&buffer[0], messageLength, messageType, flags,
+            data, dataLength, regarding);
+}
+
+
+OBPMessageView::OBPMessageView(const byte *buf, unsigned int len) {
+    this->buffer = buf;
+    this->length = (NULL == buf) ? 0 : len;
+}
+
+OBPMessageView::OBPMessageView(const vector<byte> &buf) {
+    this->buffer = buf.empty() ? NULL : &buf[0];
+    this->length = (unsigned int) buf.size();
+}
+
+bool OBPMessageView::isValidHeader() const {
+    if(this->length < OBPMessageCodec::HEADER_LENGTH) {
+        return false;
+    }
+    if(0 != memcmp(this->buffer + OBP_OFFSET_START_BYTES, obpStartBytes,
+            sizeof(obpStartBytes))) {
+        return false;
+    }
+    if(getBytesRemaining() < OBPMessageCodec::CHECKSUM_LENGTH
+            + OBPMessageCodec::FOOTER_LENGTH) {
+        return false;
+    }
+    if(getImmediateDataLength() > OBPMessageCodec::IMMEDIATE_DATA_LENGTH) {
+        return false;
+    }
+    return true;
+}
+
+bool OBPMessageView::isComplete() const {
+    if(false == isValidHeader()) {
+        return false;
+    }
+    /* Compare in a way that cannot overflow on a corrupt length field */
+    if(getBytesRemaining() > this->length - OBPMessageCodec::HEADER_LENGTH) {
+        return false;
+    }
+    return OBPMessageCodec::isFooter(this->buffer + getMessageLength()
+            - OBPMessageCodec::FOOTER_LENGTH);
+}
+
+unsigned short OBPMessageView::getProtocolVersion() const {
+    return OBPMessageCodec::readUShort(this->buffer + OBP_OFFSET_PROTOCOL_VERSION);
+}
+
+unsigned short OBPMessageView::getFlags() const {
+    return OBPMessageCodec::readUShort(this->buffer + OBP_OFFSET_FLAGS);
+}
+
+unsigned short OBPMessageView::getErrno() const {
+    return OBPMessageCodec::readUShort(this->buffer + OBP_OFFSET_ERRNO);
+}
+
+unsigned int OBPMessageView::getMessageType() const {
+    return OBPMessageCodec::readUInt(this->buffer + OBP_OFFSET_MESSAGE_TYPE);
+}
+
+unsigned int OBPMessageView::getRegarding() const {
+    return OBPMessageCodec::readUInt(this->buffer + OBP_OFFSET_REGARDING);
+}
+
+byte OBPMessageView::getChecksumType() const {
+    return this->buffer[OBP_OFFSET_CHECKSUM_TYPE];
+}
+
+byte OBPMessageView::getImmediateDataLength() const {
+    return this->buffer[OBP_OFFSET_IMMEDIATE_LENGTH];
+}
+
+const byte *OBPMessageView::getImmediateData() const {
+    return this->buffer + OBP_OFFSET_IMMEDIATE_DATA;
+}
+
+unsigned int OBPMessageView::getBytesRemaining() const {
+    return OBPMessageCodec::readUInt(this->buffer + OBP_OFFSET_BYTES_REMAINING);
+}
+
+unsigned int OBPMessageView::getMessageLength() const {
+    return OBPMessageCodec::HEADER_LENGTH + getBytesRemaining();
+}
+
+const byte *OBPMessageView::getPayload() const {
+    return this->buffer + OBPMessageCodec::HEADER_LENGTH;
+}
+
+unsigned int OBPMessageView::getPayloadLength() const {
+    return getBytesRemaining() - OBPMessageCodec::CHECKSUM_LENGTH
+            - OBPMessageCodec::FOOTER_LENGTH;
+}
+
+const byte *OBPMessageView::getData() const {
+    if(getImmediateDataLength() > 0) {
+        return getImmediateData();
+    }
+    return getPayload();
+}
+
+unsigned int OBPMessageView::getDataLength() const {
+    if(getImmediateDataLength() > 0) {
+        return getImmediateDataLength();
+    }
+    return getPayloadLength();
+}
+
+bool OBPMessageView::isAckFlagSet() const {
+    return 0 != (getFlags() & OBPMessageCodec::FLAG_ACK);
+}
+
+bool OBPMessageView::isNackFlagSet() const {
+    return 0 != (getFlags() & OBPMessageCodec::FLAG_NACK);
+}
+
+OBPSpectrumBatchView::OBPSpectrumBatchView(const byte *buf, unsigned int len,
+        unsigned int recLength) {
+    this->buffer = buf;
+    this->length = (NULL == buf) ? 0 : len;
+    this->recordLength = recLength;
+}
+
+unsigned int OBPSpectrumBatchView::getRecordCount() const {
+    if(this->recordLength <= RECORD_METADATA_LENGTH + RECORD_CHECKSUM_LENGTH) {
+        return 0;
+    }
+    return this->length / this->recordLength;
+}
+
+unsigned int OBPSpectrumBatchView::getRecordLength() const {
+    return this->recordLength;
+}
+
+const byte *OBPSpectrumBatchView::getRecord(unsigned int index) const {
+    return this->buffer + (index * this->recordLength);
+}
+
+const byte *OBPSpectrumBatchView::getPixels(unsigned int index) const {
+    return getRecord(index) + RECORD_METADATA_LENGTH;
+}
+
+unsigned int OBPSpectrumBatchView::getPixelLength() const {
+    return this->recordLength - RECORD_METADATA_LENGTH - RECORD_CHECKSUM_LENGTH;
+}
+
+bool OBPSpectrumBatchView::isRecordValid(unsigned int index) const {
+    const byte *record = getRecord(index);
+    unsigned int checked = this->recordLength - RECORD_CHECKSUM_LENGTH;
+
+    return computeChecksum(record, checked)
+            == OBPMessageCodec::readUInt(record + checked);
+}
+
+void OBPSpectrumBatchView::getMetadata(unsigned int index,
+        SpectrumMetadata &metadata) const {
+    OBPMessageCodec::readSpectrumMetadata(getRecord(index), metadata);
+}
+
+unsigned int OBPSpectrumBatchView::computeChecksum(const byte *buf,
+        unsigned int len) {
+#ifdef OBP_CHECKSUM_SSE2
+    /* PSADBW against zero adds sixteen bytes into two 64-bit lanes at once.
+     * Only the low 32 bits of the total are kept, which is the same sum
+     * modulo 2^32 that the device stores.
+     */
+    const __m128i zero = _mm_setzero_si128();
+    __m128i sum0 = zero;
+    __m128i sum1 = zero;
+    unsigned int i = 0;
+
+    for(; i + 32 <= len; i += 32) {
+        __m128i block0 = _mm_loadu_si128((const __m128i *)(buf + i));
+        __m128i block1 = _mm_loadu_si128((const __m128i *)(buf + i + 16));
+        sum0 = _mm_add_epi64(sum0, _mm_sad_epu8(block0, zero));
+        sum1 = _mm_add_epi64(sum1, _mm_sad_epu8(block1, zero));
+    }
+    for(; i + 16 <= len; i += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(buf + i));
+        sum0 = _mm_add_epi64(sum0, _mm_sad_epu8(block, zero));
+    }
+    sum0 = _mm_add_epi64(sum0, sum1);
+    sum0 = _mm_add_epi64(sum0, _mm_srli_si128(sum0, 8));
+    return (unsigned int)_mm_cvtsi128_si32(sum0)
+            + computeChecksumPortable(buf + i, len - i);
+#else
+    return computeChecksumPortable(buf, len);
+#endif
+}
+
+unsigned int OBPSpectrumBatchView::computeChecksumPortable(const byte *buf,
+        unsigned int len) {
+    /* Four running sums, so that each addition does not have to wait for
+     * the one before it.  Addition modulo 2^32 does not depend on order, so
+     * their total is the same as the device's single sum.
+     */
+    unsigned int sum0 = 0;
+    unsigned int sum1 = 0;
+    unsigned int sum2 = 0;
+    unsigned int sum3 = 0;
+    unsigned int i = 0;
+
+    for(; i + 4 <= len; i += 4) {
+        sum0 += buf[i];
+        sum1 += buf[i + 1];
+        sum2 += buf[i + 2];
+        sum3 += buf[i + 3];
+    }
+    for(; i < len; i++) {
+        sum0 += buf[i];
+    }
+    return sum0 + sum1 + sum2 + sum3;
+}
@@ -0,0 +1,283 @@
+/***************************************************//**
+ * @file    OBPQueryBatch.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Pipelined execution of a batch of OBP queries.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPQueryBatch.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
+#include "vendors/OceanOptics/protocols/obp/hints/OBPControlHint.h"
+
+using namespace seabreeze;
+using namespace seabreeze::oceanBinaryProtocol;
+using namespace std;
+
+/* Queries are tagged with this plus their index.  It is nonzero so that a
+ * device that leaves the regarding field empty in its replies is noticed.
+ */
+#define OBP_BATCH_TAG_BASE  0x0BA70000
+
+/* Some firmware silently drops a query that arrives while another is still
+ * outstanding, so a pipelined reply that takes longer than this is given up
+ * on and its query is asked again on its own.
+ */
+#define OBP_BATCH_REPLY_TIMEOUT_MILLIS  1000
+
+namespace {
+    /* Gives the helper back the receive timeout it had before the batch,
+     * however the batch ends.
+     */
+    class ReceiveTimeoutRestorer {
+    public:
+        ReceiveTimeoutRestorer(TransferHelper *helper) {
+            this->helper = helper;
+            this->previous = helper->getReceiveTimeoutMillis();
+        }
+        ~ReceiveTimeoutRestorer() {
+            this->helper->setReceiveTimeoutMillis(this->previous);
+        }
+
+    private:
+        TransferHelper *helper;
+        unsigned int previous;
+    };
+}
+
+OBPQueryBatch::OBPQueryBatch() {
+    this->hints->push_back(new OBPControlHint());
+    this->pipelined = true;
+}
+
+OBPQueryBatch::~OBPQueryBatch() {
+    clear();
+}
+
+unsigned int OBPQueryBatch::addQuery(unsigned int messageType) {
+    vector<byte> empty;
+    return addQuery(messageType, empty);
+}
+
+unsigned int OBPQueryBatch::addQuery(unsigned int messageType,
+        const vector<byte> &data) {
+    this->messageTypes.push_back(messageType);
+    this->requestData.push_back(data);
+    this->results.push_back(NULL);
+    this->answered.push_back(false);
+    return (unsigned int) this->messageTypes.size() - 1;
+}
+
+unsigned int OBPQueryBatch::getNumberOfQueries() const {
+    return (unsigned int) this->messageTypes.size();
+}
+
+void OBPQueryBatch::clear() {
+    vector<vector<byte> *>::iterator iter;
+    for(iter = this->results.begin(); iter != this->results.end(); iter++) {
+        if(NULL != *iter) {
+            delete *iter;
+        }
+    }
+    this->messageTypes.clear();
+    this->requestData.clear();
+    this->results.clear();
+    this->answered.clear();
+}
+
+const vector<byte> *OBPQueryBatch::getResult(unsigned int index) const {
+    if(index >= this->results.size()) {
+        return NULL;
+    }
+    return this->results[index];
+}
+
+void OBPQueryBatch::setPipelined(bool enable) {
+    this->pipelined = enable;
+}
+
+bool OBPQueryBatch::isPipelined() const {
+    return this->pipelined;
+}
+
+void OBPQueryBatch::setResult(unsigned int index, vector<byte> *result) {
+    if(NULL != this->results[index]) {
+        delete this->results[index];
+    }
+    this->results[index] = result;
+    this->answered[index] = true;
+}
+
+void OBPQueryBatch::queryDevice(TransferHelper *helper)
+        throw (ProtocolException) {
+    unsigned int i;
+    unsigned int count = getNumberOfQueries();
+
+    for(i = 0; i < count; i++) {
+        if(NULL != this->results[i]) {
+            delete this->results[i];
+            this->results[i] = NULL;
+        }
+        this->answered[i] = false;
+    }
+
+    if(true == this->pipelined && count > 1) {
+        if(false == queryPipelined(helper)) {
+            this->pipelined = false;
+        }
+    }
+
+    /* Anything the pipeline could not get an answer for is asked again on
+     * its own.  If that succeeds, the device must have refused the query
+     * only because others were outstanding, so stop pipelining.  A batch
+     * of one query never went through the pipeline, so it says nothing.
+     */
+    for(i = 0; i < count; i++) {
+        if(false == this->answered[i]) {
+            querySerially(helper, i);
+            if(true == this->pipelined && count > 1 && NULL != this->results[i]) {
+                this->pipelined = false;
+            }
+        }
+    }
+}
+
+bool OBPQueryBatch::queryPipelined(TransferHelper *helper)
+        throw (ProtocolException) {
+    unsigned int i;
+    unsigned int count = getNumberOfQueries();
+    vector<byte> buffer;
+    vector<byte> *result;
+
+    /* A query that the device drops would leave an unbounded receive
+     * waiting forever, so only pipeline where the bound really holds.
+     */
+    if(false == helper->isReceiveTimeoutEnforced()) {
+        return false;
+    }
+
+    ReceiveTimeoutRestorer restorer(helper);
+    helper->setReceiveTimeoutMillis(OBP_BATCH_REPLY_TIMEOUT_MILLIS);
+
+    /* The first query goes out alone to find out whether the device echoes
+     * the regarding field.  Without that, replies cannot be matched up.
+     * Its reply is also the first read made with the timeout, after which
+     * a USB helper knows whether the platform can honor it.
+     */
+    sendMessage(helper, this->messageTypes[0], 0, OBP_BATCH_TAG_BASE,
+            this->requestData[0], buffer);
+    try {
+        result = receiveReply(helper, buffer);
+    } catch (ProtocolException &pe) {
+        /* Left unanswered, so it is asked again on its own */
+        return false;
+    }
+    OBPMessageView probe(buffer);
+    if(NULL != result && (true == probe.isNackFlagSet()
+            || probe.getMessageType() != this->messageTypes[0])) {
+        delete result;
+        result = NULL;
+    }
+    setResult(0, result);
+    if(false == probe.isValidHeader()
+            || probe.getRegarding() != OBP_BATCH_TAG_BASE
+            || false == helper->isReceiveTimeoutEnforced()) {
+        return false;
+    }
+
+    for(i = 1; i < count; i++) {
+        sendMessage(helper, this->messageTypes[i], 0, OBP_BATCH_TAG_BASE + i,
+                this->requestData[i], buffer);
+    }
+
+    for(i = 1; i < count; i++) {
+        try {
+            result = receiveReply(helper, buffer);
+        } catch (ProtocolException &pe) {
+            /* Whatever is still unanswered was most likely dropped */
+            return false;
+        }
+        OBPMessageView reply(buffer);
+        unsigned int index = reply.getRegarding() - OBP_BATCH_TAG_BASE;
+        if(false == reply.isValidHeader() || index < 1 || index >= count
+                || true == this->answered[index]
+                || reply.getMessageType() != this->messageTypes[index]) {
+            /* Once a reply cannot be accounted for there is no telling which
+             * of the ones still in flight belong to which query.
+             */
+            if(NULL != result) {
+                delete result;
+            }
+            string error("Could not match a reply to any query in the OBP batch");
+            throw ProtocolException(error);
+        }
+
+        if(true == reply.isNackFlagSet()) {
+            /* Leave this unanswered so that it is retried on its own */
+            if(NULL != result) {
+                delete result;
+            }
+            continue;
+        }
+        setResult(index, result);
+    }
+
+    return true;
+}
+
+void OBPQueryBatch::querySerially(TransferHelper *helper, unsigned int index)
+        throw (ProtocolException) {
+    vector<byte> buffer;
+    vector<byte> *result;
+
+    sendMessage(helper, this->messageTypes[index], 0, 0,
+            this->requestData[index], buffer);
+
+    /* A pipelined query that timed out may still be answered late.  Such a
+     * reply carries its batch tag, which a query sent here never does.
+     */
+    for(;;) {
+        result = receiveReply(helper, buffer);
+        OBPMessageView late(buffer);
+        if(false == late.isValidHeader()
+                || late.getRegarding() < OBP_BATCH_TAG_BASE
+                || late.getRegarding() >= OBP_BATCH_TAG_BASE + getNumberOfQueries()) {
+            break;
+        }
+        if(NULL != result) {
+            delete result;
+        }
+    }
+
+    OBPMessageView reply(buffer);
+    if(NULL != result && (true == reply.isNackFlagSet()
+            || reply.getMessageType() != this->messageTypes[index])) {
+        delete result;
+        result = NULL;
+    }
+    setResult(index, result);
+}
@@ -32,7 +32,7 @@
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadNumberOfRawSpectraWithMetadataExchange.h"
 #include "vendors/OceanOptics/protocols/obp/hints/OBPSpectrumHint.h"
 #include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessage.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
 #include "common/ByteVector.h"
 
 using namespace seabreeze;
@@ -98,81 +98,64 @@ unsigned int OBPReadNumberOfRawSpectraWithMetadataExchange::isLegalMessageType(u
 Data *OBPReadNumberOfRawSpectraWithMetadataExchange::transfer(TransferHelper *helper)
         throw (ProtocolException) 
 {
-    Data *xfer;
-    OBPMessage *message = NULL;
-    vector<byte> *bytes;
-    vector<byte> obpHeader(OBP_PAYLOAD_START, 0);
     int flag = 0;
 
     // this particular call can return less than the number of bytes requested and still be valid.
-    //  read the OBP header first, then request the remaining bytes.
+    //  read the OBP header first, then request the remaining bytes.  Both land in this->buffer
+    //  where the message view expects them, so nothing has to be shifted afterwards.
     try {
-        flag = helper->receive(obpHeader, OBP_PAYLOAD_START);
+        if(this->buffer->size() < OBP_PAYLOAD_START) {
+            this->buffer->resize(OBP_PAYLOAD_START);
+        }
+        flag = helper->receiveInto(*(this->buffer), 0, OBP_PAYLOAD_START);
         if(((unsigned int)flag) != OBP_PAYLOAD_START) {
             /* FIXME: retry, throw exception, something here */
         }
+
+        this->length = OBPMessageView(*(this->buffer)).getBytesRemaining();
+
+        // the buffer was sized for the maximum number of spectra that could be returned, so
+        //  this normally does not reallocate.
+        if(this->buffer->size() < OBP_PAYLOAD_START + this->length) {
+            this->buffer->resize(OBP_PAYLOAD_START + this->length);
+        }
+        flag = helper->receiveInto(*(this->buffer), OBP_PAYLOAD_START, this->length);
+        if(((unsigned int)flag) != this->length) {
+            /* FIXME: retry, throw exception, something here */
+        }
     } catch (BusException &be) {
-        string error("Failed to write to bus.");
+        string error("Failed to read from bus.");
         /* FIXME: previous exception should probably be bundled up into the new exception */
         /* FIXME: there is probably a more descriptive type for this than ProtocolException */
         throw ProtocolException(error);
     }
 
-    this->length = *reinterpret_cast<const uint32_t*>(&obpHeader[OBP_PAYLOAD_START-sizeof(uint32_t)]);
-
-    // the original vector does not need to be resized because it will be the same size, or larger than the
-    //  data sent back by the spectrometer, since this->length was the maximum number of spectra to be returned
-    // the next transfer will retrieve the number of remaining bytes.
-
-    /* This will use the superclass to transfer data from the device
+    /* Decode the message in place; nothing is copied until the data is
+     * handed back below.
      */
-    xfer = Transfer::transfer(helper);
-    if(NULL == xfer) 
-	{
-        string error("Expected Transfer::transfer to produce a non-null result "
-                        "containing raw spectral data.  Without this data, it is not "
-                        "possible to generate a valid formatted spectrum.");
-        throw ProtocolException(error);
-    }
-    /* xfer is a copy of what is already stored in this->buffer so delete it.
-     */
-    delete xfer;
-
-    /* Try to parse the buffer into an OBPMessage.  This may throw an exception
-     * if the message is badly formed.
-     */
-    try 
-	{
-
-        // the current buffer does not include the header. For the parse to work, those
-        //  44 bytes must be inserted at the front of this->buffer
-        this->buffer->insert(this->buffer->begin(), obpHeader.begin(), obpHeader.end());
-
-        message = OBPMessage::parseByteStream(this->buffer);
-    } 
-	catch (IllegalArgumentException &iae) 
+    OBPMessageView message(*(this->buffer));
+    if(false == message.isComplete())
 	{
         string error("Failed to parse message transferred from device");
         throw ProtocolException(error);
     }
 
-    if(0 == isLegalMessageType(message->getMessageType())) 
+    if(0 == isLegalMessageType(message.getMessageType())) 
 	{
         string error("Did not get expected message type, got ");
-        error += (char)(message->getMessageType());
+        error += (char)(message.getMessageType());
         throw ProtocolException(error);
     }
 
-    bytes = message->getData();
-    if((bytes->size() % ((numberOfPixels * numberOfBytesPerPixel)+metadataLength+checkSumLength)) != 0) // the number of bytes should be an integral of the spectrum size
+    if((message.getDataLength() % ((numberOfPixels * numberOfBytesPerPixel)+metadataLength+checkSumLength)) != 0) // the number of bytes should be an integral of the spectrum size
 	{
         string error("Spectrum response does not have enough data.");
-        delete message;
         throw ProtocolException(error);
     }
-    /* This incurs a copy of the buffer so it is safe to delete the message. */
-    ByteVector *retval = new ByteVector(*bytes);
-    delete message;
+    /* This incurs a copy of the data, so the view can be discarded. */
+    ByteVector *retval = new ByteVector();
+    retval->getByteVector().assign(message.getData(),
+            message.getData() + message.getDataLength());
 
     return retval;
 }
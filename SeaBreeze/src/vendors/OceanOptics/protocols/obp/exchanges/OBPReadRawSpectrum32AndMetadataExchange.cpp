@@ -31,7 +31,7 @@
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadRawSpectrum32AndMetadataExchange.h"
 #include "vendors/OceanOptics/protocols/obp/hints/OBPSpectrumHint.h"
 #include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessage.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
 #include "common/ByteVector.h"
 
 using namespace seabreeze;
@@ -52,6 +52,7 @@ OBPReadRawSpectrum32AndMetadataExchange::OBPReadRawSpectrum32AndMetadataExchange
     this->direction = Transfer::FROM_DEVICE;
 
     this->metadataLength = METADATA_LENGTH;
+    this->metadataReceived = false;
     setNumberOfPixels(pixels);
 }
 
@@ -85,52 +86,46 @@ unsigned int OBPReadRawSpectrum32AndMetadataExchange::isLegalMessageType(unsigne
 
 Data *OBPReadRawSpectrum32AndMetadataExchange::transfer(TransferHelper *helper)
         throw (ProtocolException) {
-    Data *xfer;
-    OBPMessage *message = NULL;
-    vector<byte> *bytes;
 
-    /* This will use the superclass to transfer data from the device
-     */
-    xfer = Transfer::transfer(helper);
-    if(NULL == xfer) {
-        string error("Expected Transfer::transfer to produce a non-null result "
-                        "containing raw spectral data.  Without this data, it is not "
-                        "possible to generate a valid formatted spectrum.");
-        throw ProtocolException(error);
-    }
-    /* xfer is a copy of what is already stored in this->buffer so delete it.
-     */
-    delete xfer;
+    OBPMessageView message = receiveSpectrumMessage(helper);
 
-    /* Try to parse the buffer into an OBPMessage.  This may throw an exception
-     * if the message is badly formed.
-     */
-    try {
-        message = OBPMessage::parseByteStream(this->buffer);
-    } catch (IllegalArgumentException &iae) {
+    /* This incurs a copy of the data, so the view can be discarded. */
+    ByteVector *retval = new ByteVector();
+    retval->getByteVector().assign(message.getData(),
+            message.getData() + message.getDataLength());
+
+    return retval;
+}
+
+OBPMessageView OBPReadRawSpectrum32AndMetadataExchange::receiveSpectrumMessage(
+        TransferHelper *helper) throw (ProtocolException) {
+
+    /* Anything decoded from an earlier message no longer applies */
+    this->metadataReceived = false;
+
+    /* This only fills in this->buffer; the message is decoded in place. */
+    transferBuffer(helper);
+
+    OBPMessageView message(*(this->buffer));
+    if(false == message.isComplete()) {
         string error("Failed to parse message transferred from device");
         throw ProtocolException(error);
     }
 
-    if(0 == isLegalMessageType(message->getMessageType())) {
+    if(0 == isLegalMessageType(message.getMessageType())) {
         string error("Did not get expected message type, got ");
-        error += (char)(message->getMessageType());
+        error += (char)(message.getMessageType());
         throw ProtocolException(error);
     }
 
-    /* Extract the pixel data from the message.  Note that this is stripping
-     * off the metadata.  It might be desirable to stuff the metadata into the
-     * resulting Data instance for later use.
-     */
-    bytes = message->getData();
-    if(bytes->size() < (this->numberOfPixels * 4) + METADATA_LENGTH) {
+    /* The pixel data follows the metadata in the message. */
+    if(message.getDataLength() < (this->numberOfPixels * 4) + METADATA_LENGTH) {
         string error("Spectrum response does not have enough data.");
-        delete message;
         throw ProtocolException(error);
     }
-    /* This incurs a copy of the buffer so it is safe to delete the message. */
-    ByteVector *retval = new ByteVector(*bytes);
-    delete message;
 
-    return retval;
+    OBPMessageCodec::readSpectrumMetadata(message.getData(), this->lastMetadata);
+    this->metadataReceived = true;
+
+    return message;
 }
@@ -31,7 +31,7 @@
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadRawSpectrumExchange.h"
 #include "vendors/OceanOptics/protocols/obp/hints/OBPSpectrumHint.h"
 #include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessage.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
 #include "common/ByteVector.h"
 
 using namespace seabreeze;
@@ -78,49 +78,40 @@ unsigned int OBPReadRawSpectrumExchange::isLegalMessageType(unsigned int t) {
 
 Data *OBPReadRawSpectrumExchange::transfer(TransferHelper *helper)
         throw (ProtocolException) {
-    Data *xfer;
-    OBPMessage *message = NULL;
-    vector<byte> *bytes;
 
-    /* This will use the superclass to transfer data from the device
-     */
-    xfer = Transfer::transfer(helper);
-    if(NULL == xfer) {
-        string error("Expected Transfer::transfer to produce a non-null result "
-                        "containing raw spectral data.  Without this data, it is not "
-                        "possible to generate a valid formatted spectrum.");
-        throw ProtocolException(error);
-    }
-    /* xfer is a copy of what is already stored in this->buffer so delete it.
-     */
-    delete xfer;
+    OBPMessageView message = receiveSpectrumMessage(helper);
 
-    /* Try to parse the buffer into an OBPMessage.  This may throw an exception
-     * if the message is badly formed.
-     */
-    try {
-        message = OBPMessage::parseByteStream(this->buffer);
-    } catch (IllegalArgumentException &iae) {
+    /* This incurs a copy of the data, so the view can be discarded. */
+    ByteVector *retval = new ByteVector();
+    retval->getByteVector().assign(message.getData(),
+            message.getData() + message.getDataLength());
+
+    return retval;
+}
+
+OBPMessageView OBPReadRawSpectrumExchange::receiveSpectrumMessage(
+        TransferHelper *helper) throw (ProtocolException) {
+
+    /* This only fills in this->buffer; the message is decoded in place. */
+    transferBuffer(helper);
+
+    OBPMessageView message(*(this->buffer));
+    if(false == message.isComplete()) {
         string error("Failed to parse message transferred from device");
         throw ProtocolException(error);
     }
 
-    if(0 == isLegalMessageType(message->getMessageType())) {
+    if(0 == isLegalMessageType(message.getMessageType())) {
         string error("Did not get expected message type, got ");
-        error += (char)(message->getMessageType());
+        error += (char)(message.getMessageType());
         throw ProtocolException(error);
     }
 
     /* Extract the pixel data from the message */
-    bytes = message->getData();
-    if(bytes->size() < 2*this->numberOfPixels) {
+    if(message.getDataLength() < 2*this->numberOfPixels) {
         string error("Spectrum response does not have enough data.");
-        delete message;
         throw ProtocolException(error);
     }
-    /* This incurs a copy of the buffer so it is safe to delete the message. */
-    ByteVector *retval = new ByteVector(*bytes);
-    delete message;
 
-    return retval;
+    return message;
 }
@@ -31,9 +31,9 @@
  * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  *******************************************************/
 
+#include "common/globals.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadSpectrum32AndMetadataExchange.h"
 #include "common/U32Vector.h"
-#include "common/ByteVector.h"
 
 using namespace seabreeze;
 using namespace seabreeze::oceanBinaryProtocol;
@@ -50,43 +50,70 @@ OBPReadSpectrum32AndMetadataExchange::~OBPReadSpectrum32AndMetadataExchange() {
 
 Data *OBPReadSpectrum32AndMetadataExchange::transfer(TransferHelper *helper)
         throw (ProtocolException) {
-    Data *xfer;
-    byte lswlsb;
-    byte lswmsb;
-    byte mswlsb;
-    byte mswmsb;
-
-    /* This will use the superclass to transfer data from the device, and will
-     * then strip off the message header and footer so that only the
-     * pixel data remains.
-     */
-    xfer = OBPReadRawSpectrum32AndMetadataExchange::transfer(helper);
-    if(NULL == xfer) {
-        string error("Expected Transfer::transfer to produce a non-null result "
-                        "containing raw spectral data.  Without this data, it is not "
-                        "possible to generate a valid formatted spectrum.");
-        throw ProtocolException(error);
-    }
-    /* xfer should contain a ByteVector */
 
-    /* Extract the pixel data from the byte vector */
-    ByteVector *bv = static_cast<ByteVector *>(xfer);
-    vector<byte> bytes = bv->getByteVector();
+    /* This will use the superclass to receive and check the message.  The
+     * pixels follow the metadata and are taken straight out of the receive
+     * buffer.
+     */
+    OBPMessageView message = receiveSpectrumMessage(helper);
+    const byte *pixels = message.getData() + this->metadataLength;
 
     vector<unsigned int> formatted(this->numberOfPixels);
     for(unsigned int i = 0; i < this->numberOfPixels; i++) {
-        lswlsb = bytes[i * 4 + this->metadataLength];
-        lswmsb = bytes[(i * 4) + 1 + this->metadataLength];
-        mswlsb = bytes[(i * 4) + 2 + this->metadataLength];
-        mswmsb = bytes[(i * 4) + 3 + this->metadataLength];
-        formatted[i] =    ((mswmsb & 0x00FF) << 24)
-                        | ((mswlsb & 0x00FF) << 16)
-                        | ((lswmsb & 0x00FF) << 8)
-                        |  (lswlsb & 0x00FF);
+        formatted[i] = OBPMessageCodec::readUInt(pixels + (i * 4));
     }
-    delete xfer;  /* Equivalent to deleting bv and bytes */
 
     U32Vector *retval = new U32Vector(formatted);
 
     return retval;
 }
+
+unsigned int OBPReadSpectrum32AndMetadataExchange::receiveFormattedSpectrum(
+        TransferHelper *helper, double *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return receivePixels(helper, buffer, bufferLength);
+}
+
+unsigned int OBPReadSpectrum32AndMetadataExchange::receiveFormattedSpectrum(
+        TransferHelper *helper, float *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return receivePixels(helper, buffer, bufferLength);
+}
+
+unsigned int OBPReadSpectrum32AndMetadataExchange::receiveFormattedSpectrum(
+        TransferHelper *helper, unsigned short *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return receivePixels(helper, buffer, bufferLength);
+}
+
+unsigned int OBPReadSpectrum32AndMetadataExchange::receiveFormattedSpectrum(
+        TransferHelper *helper, unsigned int *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return receivePixels(helper, buffer, bufferLength);
+}
+
+bool OBPReadSpectrum32AndMetadataExchange::getSpectrumMetadata(
+        SpectrumMetadata &metadata) {
+    if(false == this->metadataReceived) {
+        return false;
+    }
+
+    metadata = this->lastMetadata;
+    return true;
+}
+
+template <class T> unsigned int OBPReadSpectrum32AndMetadataExchange::receivePixels(
+        TransferHelper *helper, T *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+
+    OBPMessageView message = receiveSpectrumMessage(helper);
+    const byte *pixels = message.getData() + this->metadataLength;
+
+    unsigned int count = (bufferLength < this->numberOfPixels)
+            ? bufferLength : this->numberOfPixels;
+    for(unsigned int i = 0; i < count; i++) {
+        storePixel(buffer + i, OBPMessageCodec::readUInt(pixels + (i * 4)));
+    }
+
+    return count;
+}
@@ -31,9 +31,7 @@
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadSpectrumExchange.h"
 #include "vendors/OceanOptics/protocols/obp/hints/OBPSpectrumHint.h"
 #include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessage.h"
 #include "common/UShortVector.h"
-#include "common/ByteVector.h"
 
 using namespace seabreeze;
 using namespace seabreeze::oceanBinaryProtocol;
@@ -51,36 +49,64 @@ OBPReadSpectrumExchange::~OBPReadSpectrumExchange() {
 
 Data *OBPReadSpectrumExchange::transfer(TransferHelper *helper)
         throw (ProtocolException) {
-    Data *xfer;
-    byte lsb;
-    byte msb;
 
-    /* This will use the superclass to transfer data from the device, and will
-     * then strip off the message header and footer so that only the
-     * pixel data remains.
+    /* This will use the superclass to receive and check the message.  The
+     * pixels are then taken straight out of the receive buffer.
      */
-    xfer = OBPReadRawSpectrumExchange::transfer(helper);
-    if(NULL == xfer) {
-        string error("Expected Transfer::transfer to produce a non-null result "
-                        "containing raw spectral data.  Without this data, it is not "
-                        "possible to generate a valid formatted spectrum.");
-        throw ProtocolException(error);
-    }
-    /* xfer should contain a ByteVector */
-
-    /* Extract the pixel data from the byte vector */
-    ByteVector *bv = static_cast<ByteVector *>(xfer);
-    vector<byte> bytes = bv->getByteVector();
+    OBPMessageView message = receiveSpectrumMessage(helper);
+    const byte *pixels = message.getData();
 
     vector<unsigned short> formatted(this->numberOfPixels);
     for(unsigned int i = 0; i < this->numberOfPixels; i++) {
-        lsb = bytes[i * 2];
-        msb = bytes[(i * 2) + 1];
-        formatted[i] = ((msb & 0x00FF) << 8) | (lsb & 0x00FF);
+        formatted[i] = OBPMessageCodec::readUShort(pixels + (i * 2));
     }
-    delete xfer;  /* Equivalent to deleting bv and bytes */
 
     UShortVector *retval = new UShortVector(formatted);
 
     return retval;
 }
+
+unsigned int OBPReadSpectrumExchange::receiveFormattedSpectrum(
+        TransferHelper *helper, double *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return receivePixels(helper, buffer, bufferLength);
+}
+
+unsigned int OBPReadSpectrumExchange::receiveFormattedSpectrum(
+        TransferHelper *helper, float *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return receivePixels(helper, buffer, bufferLength);
+}
+
+unsigned int OBPReadSpectrumExchange::receiveFormattedSpectrum(
+        TransferHelper *helper, unsigned short *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return receivePixels(helper, buffer, bufferLength);
+}
+
+unsigned int OBPReadSpectrumExchange::receiveFormattedSpectrum(
+        TransferHelper *helper, unsigned int *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return receivePixels(helper, buffer, bufferLength);
+}
+
+bool OBPReadSpectrumExchange::getSpectrumMetadata(SpectrumMetadata &metadata) {
+    /* These spectra are sent without any metadata */
+    return false;
+}
+
+template <class T> unsigned int OBPReadSpectrumExchange::receivePixels(
+        TransferHelper *helper, T *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+
+    OBPMessageView message = receiveSpectrumMessage(helper);
+    const byte *pixels = message.getData();
+
+    unsigned int count = (bufferLength < this->numberOfPixels)
+            ? bufferLength : this->numberOfPixels;
+    for(unsigned int i = 0; i < count; i++) {
+        storePixel(buffer + i, OBPMessageCodec::readUShort(pixels + (i * 2)));
+    }
+
+    return count;
+}
@@ -31,7 +31,6 @@
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadSpectrumWithGainExchange.h"
 #include "vendors/OceanOptics/protocols/obp/hints/OBPSpectrumHint.h"
 #include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessage.h"
 #include "common/UShortVector.h"
 #include "common/DoubleVector.h"
 
@@ -102,3 +101,55 @@ Data *OBPReadSpectrumWithGainExchange::transfer(TransferHelper *helper)
 
     return retval;
 }
+
+unsigned int OBPReadSpectrumWithGainExchange::receiveFormattedSpectrum(
+        TransferHelper *helper, double *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return receiveAdjustedPixels(helper, buffer, bufferLength);
+}
+
+unsigned int OBPReadSpectrumWithGainExchange::receiveFormattedSpectrum(
+        TransferHelper *helper, float *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return receiveAdjustedPixels(helper, buffer, bufferLength);
+}
+
+unsigned int OBPReadSpectrumWithGainExchange::receiveFormattedSpectrum(
+        TransferHelper *helper, unsigned short *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return receiveAdjustedPixels(helper, buffer, bufferLength);
+}
+
+unsigned int OBPReadSpectrumWithGainExchange::receiveFormattedSpectrum(
+        TransferHelper *helper, unsigned int *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+    return receiveAdjustedPixels(helper, buffer, bufferLength);
+}
+
+template <class T> unsigned int OBPReadSpectrumWithGainExchange::receiveAdjustedPixels(
+        TransferHelper *helper, T *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+
+    if(NULL == this->spectrometerFeature) {
+        return OBPReadSpectrumExchange::receiveFormattedSpectrum(
+                helper, buffer, bufferLength);
+    }
+
+    OBPMessageView message = receiveSpectrumMessage(helper);
+    const byte *pixels = message.getData();
+
+    /* The gain is applied as each pixel is decoded, the same way transfer()
+     * applies it, so that narrow outputs are only rounded once.
+     */
+    double maxIntensity = this->spectrometerFeature->getMaximumIntensity();
+    double saturationLevel = this->spectrometerFeature->getSaturationLevel();
+    unsigned int count = (bufferLength < this->numberOfPixels)
+            ? bufferLength : this->numberOfPixels;
+    for(unsigned int i = 0; i < count; i++) {
+        double temp = OBPMessageCodec::readUShort(pixels + (i * 2))
+                * maxIntensity / saturationLevel;
+        storePixel(buffer + i, (temp > maxIntensity) ? maxIntensity : temp);
+    }
+
+    return count;
+}
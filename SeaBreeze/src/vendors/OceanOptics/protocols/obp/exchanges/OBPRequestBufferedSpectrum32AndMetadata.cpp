@@ -30,7 +30,7 @@
 #include "common/globals.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPRequestBufferedSpectrum32AndMetadataExchange.h"
 #include "vendors/OceanOptics/protocols/obp/hints/OBPSpectrumHint.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessage.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
 #include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
 
 using namespace seabreeze;
@@ -38,24 +38,12 @@ using namespace seabreeze::oceanBinaryProtocol;
 using namespace std;
 
 OBPRequestBufferedSpectrum32AndMetadataExchange::OBPRequestBufferedSpectrum32AndMetadataExchange() {
-    OBPMessage message;
-    vector<byte> *stream;
-    unsigned int i;
-
     this->hints->push_back(new OBPSpectrumHint());
 
     this->direction = Transfer::TO_DEVICE;
 
-    message.setMessageType(OBPMessageTypes::OBP_GET_BUF_SPEC32_META);
-    stream = message.toByteStream();
-
-    this->length = (unsigned) stream->size();
-    this->buffer->resize(stream->size());
-
-    for(i = 0; i < stream->size(); i++) {
-        (*(this->buffer))[i] = (*stream)[i];
-    }
-    delete stream;
+    this->length = OBPMessageCodec::encode(*(this->buffer),
+            OBPMessageTypes::OBP_GET_BUF_SPEC32_META, 0, NULL, 0);
 
     checkBufferSize();
 }
@@ -30,7 +30,7 @@
 #include "common/globals.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPRequestNumberOfBufferedSpectraWithMetadataExchange.h"
 #include "vendors/OceanOptics/protocols/obp/hints/OBPSpectrumHint.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessage.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
 #include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
 
 using namespace seabreeze;
@@ -55,10 +55,8 @@ OBPRequestNumberOfBufferedSpectraWithMetadataExchange::~OBPRequestNumberOfBuffer
 
 void OBPRequestNumberOfBufferedSpectraWithMetadataExchange::setNumberOfSamplesToRequest(void *myClass, unsigned int numberOfSamples)
 {
-	OBPMessage message;
-	vector<byte> *stream;
-	unsigned int i;
 	unsigned int adjustedNumberOfSamples = numberOfSamples;
+	byte numberOfSamplesToRetrieve[sizeof(unsigned int)];
 
 	OBPRequestNumberOfBufferedSpectraWithMetadataExchange *parentClass = (OBPRequestNumberOfBufferedSpectraWithMetadataExchange *)myClass;
 
@@ -67,24 +65,12 @@ void OBPRequestNumberOfBufferedSpectraWithMetadataExchange::setNumberOfSamplesTo
 	if(adjustedNumberOfSamples < 1)
 		adjustedNumberOfSamples = 1;
 
-	std::vector<unsigned char> *numberOfSamplesToRetrieve = new vector<unsigned char>(sizeof(unsigned int));
-	// no c++11 yet
-	//memcpy(numberOfSamplesToRetrieve.data(), &numberOfSamples, sizeof(unsigned int)); 
-	memcpy(&((*numberOfSamplesToRetrieve)[0]), &adjustedNumberOfSamples, sizeof(unsigned int));
+	memcpy(numberOfSamplesToRetrieve, &adjustedNumberOfSamples, sizeof(unsigned int));
 
-
-
-	message.setMessageType(OBPMessageTypes::OBP_GET_N_BUF_RAW_SPECTRA_META);
-	message.setImmediateData(numberOfSamplesToRetrieve); // sets length automatically ~obpMessage destroys the vector
-	stream = message.toByteStream();
-
-	parentClass->length = (unsigned)stream->size();
-	parentClass->buffer->resize(stream->size());
-
-	for (i = 0; i < stream->size(); i++) {
-		(*(parentClass->buffer))[i] = (*stream)[i];
-	}
-	delete stream;
+	// the count travels as immediate data, so the request is encoded straight into the transfer buffer
+	parentClass->length = OBPMessageCodec::encode(*(parentClass->buffer),
+		OBPMessageTypes::OBP_GET_N_BUF_RAW_SPECTRA_META, 0,
+		numberOfSamplesToRetrieve, sizeof(numberOfSamplesToRetrieve));
 
 	parentClass->checkBufferSize();
 }
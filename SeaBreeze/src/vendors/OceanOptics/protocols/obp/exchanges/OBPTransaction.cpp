@@ -68,140 +68,111 @@ const vector<ProtocolHint *> &OBPTransaction::getHints() {
     return *(this->hints);
 }
 
-vector<byte> *OBPTransaction::queryDevice(TransferHelper *helper,
-                    unsigned int messageType,
-                    vector<byte> &data) throw (ProtocolException) 
+void OBPTransaction::sendMessage(TransferHelper *helper,
+                    unsigned int messageType, unsigned short flags,
+                    unsigned int regarding, const vector<byte> &data,
+                    vector<byte> &buffer) throw (ProtocolException)
 {
     int flag = 0;
-    vector<byte> *bytes = NULL;
-    vector<byte> *fullVector = NULL;
-    OBPMessage *message = new OBPMessage();
-    OBPMessage *response = NULL;
-
-    message->setMessageType(messageType);
 
-    /* Need a copy of the input data that can be given to the message. */
-    /* Note: copy will be deleted by message when appropriate. */
-    message->setData(new vector<byte>(data));
+    OBPMessageCodec::encode(buffer, messageType, flags,
+            data.empty() ? NULL : &data[0], (unsigned) data.size(), regarding);
 
     try 
 	{
-        bytes = message->toByteStream();
-        flag = helper->send(*bytes, (unsigned) bytes->size());
-        if(((unsigned int)flag) != bytes->size()) 
+        flag = helper->send(buffer, (unsigned) buffer.size());
+        if(((unsigned int)flag) != buffer.size()) 
 		{
             /* FIXME: retry, throw exception, something here */
         }
     } 
 	catch (BusException &be) 
 	{
-        if(NULL != bytes) 
-		{
-            delete bytes;
-        }
-        delete message;
         string error("Failed to write to bus.");
         /* FIXME: previous exception should probably be bundled up into the new exception */
         /* FIXME: there is probably a more descriptive type for this than ProtocolException */
         throw ProtocolException(error);
     }
+}
 
-    delete message;
-    delete bytes;
-    bytes = NULL;
+vector<byte> *OBPTransaction::receiveReply(TransferHelper *helper,
+                    vector<byte> &header) throw (ProtocolException)
+{
+    int flag = 0;
+    bool complete = true;
+    vector<byte> *retval = NULL;
 
     try {
         /* Read the 64-byte OBP header.  This may indicate that more data
-         * must be absorbed afterwards.
+         * must be absorbed afterwards.  A buffer that was used to send the
+         * request is at least this large, so it can be reused without
+         * reallocating.
          */
-        bytes = new vector<byte>(64);
-        flag = helper->receive(*bytes, (unsigned) bytes->size());
-        if(((unsigned int)flag) != bytes->size()) 
+        header.resize(OBPMessageCodec::MINIMUM_MESSAGE_LENGTH);
+        flag = helper->receive(header, (unsigned) header.size());
+        if(((unsigned int)flag) != header.size()) 
 		{
             /* FIXME: retry, throw exception, something here */
         }
 
-        /* Parse out the header and see if there is an extended payload. */
-        try 
-		{
-            response = OBPMessage::parseHeaderFromByteStream(bytes);
-        } 
-		catch (IllegalArgumentException &iae) 
-		{
-            response = NULL;
-        }
-        if(NULL == response || true == response->isNackFlagSet() || response->getMessageType() != messageType) 
-		{
-            if(NULL != bytes) 
-			{
-                delete bytes;
-            }
-
-            if(NULL != response) 
-			{
-				char message[64];
-				if (response->getMessageType() == messageType)
-				{
-					unsigned short flags = (*response).getFlags();
-					snprintf(message, sizeof(message), "OBP Flags indicated an error: %x", flags);
-				}
-				else
-				{
-					snprintf(message, sizeof(message), "Expected message type 0x%x, but got %x", messageType, response->getMessageType());
-				}
-				throw(ProtocolException(message));
-                delete response;
-            }
-            /* There may be a legitimate reason to not return a message
-             * (e.g. tried to read an unprogrammed value).  Just return
-             * NULL here instead of throwing an exception and let the
-             * caller figure it out.
-             */
+        /* Inspect the header in place and see if there is an extended payload. */
+        OBPMessageView view(header);
+        if(false == view.isValidHeader()) {
             return NULL;
         }
-        unsigned int bytesToRead = response->getBytesRemaining() - 20; /* omit footer and checksum */
-        if(bytesToRead > 0) {
-            fullVector = new vector<byte>(bytesToRead + bytes->size());
-            /* Safely stl::copy() the header into a full-sized block and
-             * delete the existing buffer
+        unsigned int bytesRemaining = view.getBytesRemaining();
+        if(bytesRemaining <= OBPMessageCodec::MINIMUM_MESSAGE_LENGTH
+                - OBPMessageCodec::HEADER_LENGTH) {
+            /* The whole message arrived with the header */
+            if(false == view.isComplete()) {
+                complete = false;
+            } else {
+                retval = new vector<byte>(view.getData(),
+                        view.getData() + view.getDataLength());
+            }
+        } else {
+            /* Everything after the fixed header (payload, checksum and
+             * footer) goes into one buffer that becomes the result.  The
+             * first few bytes of it came in with the header read; the rest
+             * is received straight in behind them.
              */
-            vector<byte>::iterator iter = copy(bytes->begin(), bytes->end(), fullVector->begin());
-            delete bytes;
-            bytes = NULL;
-            /* TransferHelper expects a vector, so create a new one for it */
-            vector<byte> *remainder = new vector<byte>(bytesToRead);
-            flag = helper->receive(*remainder, (unsigned) remainder->size());
-            if(((unsigned int)flag) != bytesToRead) {
+            unsigned int headerTail = OBPMessageCodec::MINIMUM_MESSAGE_LENGTH
+                    - OBPMessageCodec::HEADER_LENGTH;
+            retval = new vector<byte>(bytesRemaining);
+            copy(header.begin() + OBPMessageCodec::HEADER_LENGTH,
+                    header.end(), retval->begin());
+            flag = helper->receiveInto(*retval, headerTail,
+                    bytesRemaining - headerTail);
+            if(((unsigned int)flag) != bytesRemaining - headerTail) {
                 /* FIXME: retry, throw exception, something here */
             }
-            copy(remainder->begin(), remainder->end(), iter);
-            delete remainder;
-        } else {
-            fullVector = bytes;
-            bytes = NULL;  /* To prevent double deletion */
-        }
-        /* Delete and recreate response using the full message */
-        delete response;
-        try {
-            response = OBPMessage::parseByteStream(fullVector);
-        } catch (IllegalArgumentException &iae) {
-            response = NULL;
+
+            if(false == OBPMessageCodec::isFooter(&(*retval)[bytesRemaining
+                    - OBPMessageCodec::FOOTER_LENGTH])) {
+                complete = false;
+            } else if(view.getImmediateDataLength() > 0) {
+                /* Immediate data takes precedence over any payload */
+                retval->assign(view.getImmediateData(),
+                        view.getImmediateData() + view.getImmediateDataLength());
+            } else {
+                /* Trim off the checksum and footer; this never reallocates */
+                retval->resize(view.getPayloadLength());
+            }
         }
-        delete fullVector;
-        fullVector = NULL;
     } catch (BusException &be) {
-        if(NULL != bytes) {
-            delete bytes;
-        }
-        if(NULL != fullVector) {
-            delete fullVector;
+        if(NULL != retval) {
+            delete retval;
         }
         string error("Failed to read from bus.");
         /* FIXME: previous exception should probably be bundled up into the new exception */
         /* FIXME: there is probably a more descriptive type for this than ProtocolException */
         throw ProtocolException(error);
     }
-    if(NULL == response) {
+
+    if(false == complete) {
+        if(NULL != retval) {
+            delete retval;
+        }
         /* This could happen if the footer or checksum failed for
          * some reason, but that would be very unusual.  This can only happen
          * if the header was already verified, but there was some error in the
@@ -211,88 +182,82 @@ vector<byte> *OBPTransaction::queryDevice(TransferHelper *helper,
         throw ProtocolException(error);
     }
 
-    /* Make a copy of the response buffer so response can be deleted */
-    bytes = new vector<byte>(*response->getData());
-    
-    delete response;
-    return bytes;
+    return retval;
 }
 
-
-bool OBPTransaction::sendCommandToDevice(TransferHelper *helper,
+vector<byte> *OBPTransaction::queryDevice(TransferHelper *helper,
                     unsigned int messageType,
-                    vector<byte> &data) throw (ProtocolException) {
-
-    bool retval = false;
-    int flag = 0;
-    vector<byte> *bytes = NULL;
-    OBPMessage *message = new OBPMessage();
-    OBPMessage *response = NULL;
+                    vector<byte> &data) throw (ProtocolException) 
+{
+    vector<byte> message;
+    vector<byte> *retval = NULL;
 
-    message->setMessageType(messageType);
-    message->setAckRequestedFlag();
+    sendMessage(helper, messageType, 0, 0, data, message);
 
-    /* Need a copy of the input data that can be given to the message. */
-    /* Note: copy will be deleted by message when appropriate. */
-    message->setData(new vector<byte>(data));
+    retval = receiveReply(helper, message);
+    if(NULL == retval) {
+        /* There may be a legitimate reason to not return a message
+         * (e.g. tried to read an unprogrammed value).  Just return
+         * NULL here instead of throwing an exception and let the
+         * caller figure it out.
+         */
+        return NULL;
+    }
 
-    try {
-        bytes = message->toByteStream();
-        flag = helper->send(*bytes, (unsigned) bytes->size());
-        if(((unsigned int)flag) != bytes->size()) {
-            /* FIXME: retry, throw exception, something here */
+    OBPMessageView header(message);
+    if(true == header.isNackFlagSet() || header.getMessageType() != messageType) 
+	{
+        char errorMessage[64];
+        if (header.getMessageType() == messageType)
+        {
+            snprintf(errorMessage, sizeof(errorMessage), "OBP Flags indicated an error: %x", header.getFlags());
         }
-    } catch (BusException &be) {
-        if(NULL != bytes) {
-            delete bytes;
+        else
+        {
+            snprintf(errorMessage, sizeof(errorMessage), "Expected message type 0x%x, but got %x", messageType, header.getMessageType());
         }
-        delete message;
-        string error("Failed to write to bus.");
-        /* FIXME: previous exception should probably be bundled up into the new exception */
-        /* FIXME: there is probably a more descriptive type for this than ProtocolException */
-        throw ProtocolException(error);
+        delete retval;
+        throw(ProtocolException(errorMessage));
     }
 
-    delete message;
-    delete bytes;
-    bytes = NULL;
+    return retval;
+}
+
+
+bool OBPTransaction::sendCommandToDevice(TransferHelper *helper,
+                    unsigned int messageType,
+                    vector<byte> &data) throw (ProtocolException) {
+
+    bool retval = false;
+    int flag = 0;
+    vector<byte> message;
+
+    sendMessage(helper, messageType, OBPMessageCodec::FLAG_ACK_REQUESTED, 0,
+            data, message);
 
     try {
-        /* Read the 64-byte OBP header. */
-        bytes = new vector<byte>(64);
-        flag = helper->receive(*bytes, (unsigned) bytes->size());
-        if(((unsigned int)flag) != bytes->size()) {
+        /* Read the 64-byte OBP header into the request buffer. */
+        message.resize(OBPMessageCodec::MINIMUM_MESSAGE_LENGTH);
+        flag = helper->receive(message, (unsigned) message.size());
+        if(((unsigned int)flag) != message.size()) {
             /* FIXME: retry, throw exception, something here */
         }
-
-        /* Parse out the header. */
-        try {
-            response = OBPMessage::parseHeaderFromByteStream(bytes);
-        } catch (IllegalArgumentException &iae) {
-            response = NULL;
-        }
     } catch (BusException &be) {
-        if(NULL != bytes) {
-            delete bytes;
-        }
         string error("Failed to read from bus.");
         /* FIXME: previous exception should probably be bundled up into the new exception */
         /* FIXME: there is probably a more descriptive type for this than ProtocolException */
         throw ProtocolException(error);
     }
 
-    delete bytes;
-
-    if(NULL == response || true == response->isNackFlagSet()
-            || response->getMessageType() != messageType) {
+    OBPMessageView response(message);
+    if(false == response.isValidHeader() || true == response.isNackFlagSet()
+            || response.getMessageType() != messageType) {
         retval = false;
-    } else if(true == response->isAckFlagSet()) {
+    } else if(true == response.isAckFlagSet()) {
         retval = true;
     } else {
-        delete response;
         string error("Illegal device response");
         throw ProtocolException(error);
     }
-    delete response;
     return retval;
 }
@@ -36,6 +36,7 @@
 #include "common/U32Vector.h"
 #include "common/DoubleVector.h"
 #include "common/exceptions/ProtocolBusMismatchException.h"
+#include "common/protocols/SpectrumReceiverInterface.h"
 
 using namespace seabreeze;
 using namespace seabreeze::oceanBinaryProtocol;
@@ -274,6 +275,73 @@ vector<double> *OBPSpectrometerProtocol::readFormattedSpectrum(const Bus &bus)
     return retval;
 }
 
+unsigned int OBPSpectrometerProtocol::readFormattedSpectrum(const Bus &bus,
+        double *buffer, unsigned int bufferLength) throw (ProtocolException) {
+    return readFormattedSpectrumInto(bus, buffer, bufferLength);
+}
+
+unsigned int OBPSpectrometerProtocol::readFormattedSpectrum(const Bus &bus,
+        float *buffer, unsigned int bufferLength) throw (ProtocolException) {
+    return readFormattedSpectrumInto(bus, buffer, bufferLength);
+}
+
+unsigned int OBPSpectrometerProtocol::readFormattedSpectrum(const Bus &bus,
+        unsigned short *buffer, unsigned int bufferLength) throw (ProtocolException) {
+    return readFormattedSpectrumInto(bus, buffer, bufferLength);
+}
+
+unsigned int OBPSpectrometerProtocol::readFormattedSpectrum(const Bus &bus,
+        unsigned int *buffer, unsigned int bufferLength) throw (ProtocolException) {
+    return readFormattedSpectrumInto(bus, buffer, bufferLength);
+}
+
+bool OBPSpectrometerProtocol::getFormattedSpectrumMetadata(SpectrumMetadata &metadata) {
+    SpectrumReceiverInterface *receiver = dynamic_cast<SpectrumReceiverInterface *>(
+            this->readFormattedSpectrumExchange);
+    if(NULL == receiver) {
+        return false;
+    }
+
+    /* The exchange holds on to whatever arrived with its last spectrum */
+    return receiver->getSpectrumMetadata(metadata);
+}
+
+template <class T> unsigned int OBPSpectrometerProtocol::readFormattedSpectrumInto(
+        const Bus &bus, T *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+
+    TransferHelper *helper;
+    unsigned int count;
+
+    SpectrumReceiverInterface *receiver = dynamic_cast<SpectrumReceiverInterface *>(
+            this->readFormattedSpectrumExchange);
+    if(NULL == receiver) {
+        /* This exchange can only produce a new vector, so copy out of that */
+        vector<double> *spectrum = readFormattedSpectrum(bus);
+        if(NULL == spectrum) {
+            string error("Spectral data was not in a recognized format.");
+            throw ProtocolException(error);
+        }
+        count = (bufferLength < spectrum->size()) ? bufferLength : (unsigned int)spectrum->size();
+        for(unsigned int i = 0; i < count; i++) {
+            SpectrumReceiverInterface::storePixel(buffer + i, (*spectrum)[i]);
+        }
+        delete spectrum;
+        return count;
+    }
+
+    helper = bus.getHelper(this->readFormattedSpectrumExchange->getHints());
+    if (NULL == helper) {
+        string error("Failed to find a helper to bridge given protocol and bus.");
+        throw ProtocolBusMismatchException(error);
+    }
+
+    /* The pixels are decoded straight out of the exchange's receive buffer.
+     * This may cause a ProtocolException to be thrown.
+     */
+    return receiver->receiveFormattedSpectrum(helper, buffer, bufferLength);
+}
+
 void OBPSpectrometerProtocol::requestFormattedSpectrum(const Bus &bus)
         throw (ProtocolException) {
     TransferHelper *helper;
@@ -323,6 +391,16 @@ throw (ProtocolException) {
 }
 
 
+SpectrometerProtocolBinding *OBPSpectrometerProtocol::bindSpectrumAcquisition(
+        const Bus &bus) throw (ProtocolException) {
+    /* This throws if the bus has no helper for any of the exchanges */
+    return new SpectrometerProtocolBinding(this, bus,
+            this->requestFormattedSpectrumExchange,
+            this->readFormattedSpectrumExchange,
+            this->requestUnformattedSpectrumExchange,
+            this->readUnformattedSpectrumExchange);
+}
+
 void OBPSpectrometerProtocol::setIntegrationTimeMicros(const Bus &bus,
         unsigned long integrationTime_usec) throw (ProtocolException) {
     TransferHelper *helper;
@@ -336,7 +414,12 @@ void OBPSpectrometerProtocol::setIntegrationTimeMicros(const Bus &bus,
 
     this->integrationTimeExchange->setIntegrationTimeMicros(integrationTime_usec);
     /* This may cause a ProtocolException to be thrown. */
-    this->integrationTimeExchange->sendCommandToDevice(helper);
+    bool retval = this->integrationTimeExchange->sendCommandToDevice(helper);
+
+    if(false == retval) {
+        string error("Device rejected the integration time.");
+        throw ProtocolException(error);
+    }
 }
 
 void OBPSpectrometerProtocol::setTriggerMode(const Bus &bus,
@@ -352,5 +435,10 @@ void OBPSpectrometerProtocol::setTriggerMode(const Bus &bus,
 
     this->triggerModeExchange->setTriggerMode(mode);
     /* This may cause a ProtocolException to be thrown. */
-    this->triggerModeExchange->sendCommandToDevice(helper);
+    bool retval = this->triggerModeExchange->sendCommandToDevice(helper);
+
+    if(false == retval) {
+        string error("Device rejected the trigger mode.");
+        throw ProtocolException(error);
+    }
 }
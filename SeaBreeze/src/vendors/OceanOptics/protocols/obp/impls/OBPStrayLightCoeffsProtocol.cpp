@@ -29,8 +29,8 @@
 
 #include "common/globals.h"
 #include "vendors/OceanOptics/protocols/obp/impls/OBPStrayLightCoeffsProtocol.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPGetStrayLightCoeffExchange.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPGetStrayLightCoeffsCountExchange.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPCoefficientsBatch.h"
+#include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
 #include "vendors/OceanOptics/protocols/obp/impls/OceanBinaryProtocol.h"
 #include "common/exceptions/ProtocolBusMismatchException.h"
 
@@ -40,7 +40,7 @@ using namespace std;
 
 OBPStrayLightCoeffsProtocol::OBPStrayLightCoeffsProtocol()
         : StrayLightCoeffsProtocolInterface(new OceanBinaryProtocol()) {
-
+    this->pipelined = true;
 }
 
 OBPStrayLightCoeffsProtocol::~OBPStrayLightCoeffsProtocol() {
@@ -49,53 +49,18 @@ OBPStrayLightCoeffsProtocol::~OBPStrayLightCoeffsProtocol() {
 
 vector<double> *OBPStrayLightCoeffsProtocol::readStrayLightCoeffs(const Bus &bus)
                 throw (ProtocolException) {
-    vector<byte> *result = NULL;
-    unsigned int i;
     vector<double> *retval;
-    float coeff;
-    byte *bptr;
-    int count = 0;
-    vector<byte> *countResult;
-
-    OBPGetStrayLightCoeffExchange xchange;
-    OBPGetStrayLightCoeffsCountExchange countExchange;
+    OBPCoefficientsBatch batch(OBPMessageTypes::OBP_GET_STRAY_COEFF,
+            OBPMessageTypes::OBP_GET_STRAY_COEFF_COUNT);
 
-    TransferHelper *helper = bus.getHelper(xchange.getHints());
+    TransferHelper *helper = bus.getHelper(batch.getHints());
     if(NULL == helper) {
         string error("Failed to find a helper to bridge given protocol and bus.");
         throw ProtocolBusMismatchException(error);
     }
 
-    countResult = countExchange.queryDevice(helper);
-    if(NULL == countResult || (*countResult)[0] > 16) {
-        /* Device is incapable of providing these coefficients */
-        return NULL;
-    }
-
-    count = (*countResult)[0];
-    delete countResult;
-
-    retval = new vector<double>(count);
-    for(i = 0; i < retval->size(); i++) {
-        xchange.setCoefficientIndex(i);
-        result = xchange.queryDevice(helper);
-        if(NULL == result) {
-            string error("Expected Transfer::transfer to produce a non-null result "
-                "containing stray light coefficient.  Without this data, it is not possible to "
-                "continue.");
-            delete retval;
-            throw ProtocolException(error);
-        }
-
-        bptr = (byte *)&coeff;
-        for(unsigned int j = 0; j < sizeof(float); j++) {
-            bptr[j] = (*result)[j];
-        }
-
-        (*retval)[i] = coeff;  /* Only one is returned per request */
-
-        delete result;
-    }
-
+    batch.setPipelined(this->pipelined);
+    retval = batch.readCoefficients(helper);
+    this->pipelined = batch.isPipelined();
     return retval;
 }
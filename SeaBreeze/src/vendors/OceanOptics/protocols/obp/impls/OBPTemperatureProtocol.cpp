@@ -29,9 +29,9 @@
 
 #include "common/globals.h"
 #include "vendors/OceanOptics/protocols/obp/impls/OBPTemperatureProtocol.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPGetTemperatureExchange.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPGetAllTemperaturesExchange.h"
 #include "vendors/OceanOptics/protocols/obp/exchanges/OBPGetTemperatureCountExchange.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPQueryBatch.h"
+#include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
 #include "vendors/OceanOptics/protocols/obp/impls/OceanBinaryProtocol.h"
 #include "common/exceptions/ProtocolBusMismatchException.h"
 
@@ -41,7 +41,7 @@ using namespace std;
 
 OBPTemperatureProtocol::OBPTemperatureProtocol()
         : TemperatureProtocolInterface(new OceanBinaryProtocol()) {
-
+    this->pipelined = true;
 }
 
 OBPTemperatureProtocol::~OBPTemperatureProtocol() {
@@ -75,116 +75,171 @@ unsigned char OBPTemperatureProtocol::readTemperatureCount(const Bus &bus)
 double OBPTemperatureProtocol::readTemperature(const Bus &bus, int index)
                 throw (ProtocolException) 
 {
-    vector<byte> *result = NULL;
+    vector<int> indices(1, index);
+    vector<double> *temperatures;
+    double retval;
+
+    temperatures = readTemperatures(bus, indices);
+    if(NULL == temperatures) {
+        /* Device is incapable of providing temperature */
+        return 0;
+    }
+
+    retval = (*temperatures)[0];
+    delete temperatures;
+
+    return retval;
+}
+
+vector<double> *OBPTemperatureProtocol::readTemperatures(const Bus &bus,
+        const vector<int> &indices) throw (ProtocolException)
+{
+    const vector<byte> *result = NULL;
+    const vector<byte> *countResult;
+    vector<double> *retval;
+    vector<byte> index(1);
     float temperature;
     byte *bptr;
     int count = 0;
-    vector<byte> *countResult;
-    
-    OBPGetTemperatureExchange xchange;
-    OBPGetTemperatureCountExchange countExchange;
-    
-    TransferHelper *helper = bus.getHelper(xchange.getHints());
+    unsigned int i;
+
+    OBPQueryBatch batch;
+
+    TransferHelper *helper = bus.getHelper(batch.getHints());
     if(NULL == helper) 
     {
         string error("Failed to find a helper to bridge given protocol and bus.");
         throw ProtocolBusMismatchException(error);
     }
-    
+
     // although the number of temperatures is not needed for the query, it is nice to
-    //  confirm that the index is in bounds
-    countResult = countExchange.queryDevice(helper);
-    if(NULL == countResult || (*countResult)[0] > 16) 
+    //  confirm that the indices are in bounds.  The count goes out in the same
+    //  burst as the temperatures themselves.
+    batch.addQuery(OBPMessageTypes::OBP_GET_TEMPERATURE_COUNT);
+    for(i = 0; i < indices.size(); i++) {
+        index[0] = indices[i] & 0x00FF;
+        batch.addQuery(OBPMessageTypes::OBP_GET_TEMPERATURE, index);
+    }
+    batch.setPipelined(this->pipelined);
+    batch.queryDevice(helper);
+    this->pipelined = batch.isPipelined();
+
+    countResult = batch.getResult(0);
+    if(NULL == countResult || countResult->empty() || (*countResult)[0] > 16) 
     {
         /* Device is incapable of providing temperature */
-        return 0;
+        return NULL;
     }
-
     count = (*countResult)[0];
-    delete countResult;
 
-    if ((index>=0) && (index<count)) {
-        xchange.setTemperatureIndex(index);
-        result = xchange.queryDevice(helper);
-        if(NULL == result) {
+    retval = new vector<double>(indices.size());
+    for(i = 0; i < indices.size(); i++) {
+        if((indices[i] < 0) || (indices[i] >= count)) {
+            string error("Bad Argument::The temperature index was out of bounds.");
+            delete retval;
+            throw ProtocolException(error);
+        }
+
+        result = batch.getResult(i + 1);
+        if(NULL == result || result->size() < sizeof(float)) {
             string error("Expected Transfer::transfer to produce a non-null result "
                 "containing temperature.  Without this data, it is not possible to "
                 "continue.");
+            delete retval;
             throw ProtocolException(error);
         }
-        
+
         // queryDevice returns a byte stream, turn that into a float... mind our endians.
         bptr = (byte *)&temperature;
         for(unsigned int j = 0; j < sizeof(float); j++) { // four bytes returned
-            //printf("byte %d=%x\n", j, (*result)[j]);
             bptr[j] = (*result)[j];  // get a little endian float
         }
-        delete result;
-    }
-    else {
-        string error("Bad Argument::The temperature index was out of bounds.");
-        throw ProtocolException(error);
+        (*retval)[i] = temperature;
     }
-        
-    return temperature;
+
+    return retval;
 }
 
 
 vector<double> *OBPTemperatureProtocol::readAllTemperatures(const Bus &bus) 
         throw (ProtocolException) {
+    return readAllTemperaturesWithTEC(bus, NULL, NULL);
+}
+
+vector<double> *OBPTemperatureProtocol::readAllTemperaturesWithTEC(const Bus &bus,
+        double *tecTemperature, bool *tecRead) throw (ProtocolException) {
     
-    vector<byte> *result = NULL;
+    const vector<byte> *result = NULL;
     unsigned int i;
     vector<double> *retval; // temperatures
     byte *bptr;
     float temperatureBuffer;
     int count = 0;
-    vector<byte> *countResult;
+    const vector<byte> *countResult;
 
-    OBPGetAllTemperaturesExchange xchange;
-    OBPGetTemperatureCountExchange countExchange;
+    OBPQueryBatch batch;
 
-    TransferHelper *helper = bus.getHelper(xchange.getHints());
+    TransferHelper *helper = bus.getHelper(batch.getHints());
     if(NULL == helper) {
         string error("Failed to find a helper to bridge given protocol and bus.");
         throw ProtocolBusMismatchException(error);
     }
 
-    countResult = countExchange.queryDevice(helper);
-    if(NULL == countResult || (*countResult)[0] > 16) {
+    batch.addQuery(OBPMessageTypes::OBP_GET_TEMPERATURE_COUNT);
+    batch.addQuery(OBPMessageTypes::OBP_GET_TEMPERATURE_ALL);
+    if(NULL != tecRead) {
+        /* This belongs to the TEC feature, but it is a plain query, so it
+         * can go out in the same burst instead of after the others.
+         */
+        *tecRead = false;
+        batch.addQuery(OBPMessageTypes::OBP_GET_TE_TEMPERATURE);
+    }
+    batch.setPipelined(this->pipelined);
+    batch.queryDevice(helper);
+    this->pipelined = batch.isPipelined();
+
+    if(NULL != tecRead) {
+        result = batch.getResult(2);
+        if(NULL != result && result->size() >= sizeof(float)) {
+            bptr = (byte *)&temperatureBuffer;
+            for(unsigned int j = 0; j < sizeof(float); j++) {
+                bptr[j] = (*result)[j];
+            }
+            *tecTemperature = temperatureBuffer;
+            *tecRead = true;
+        }
+    }
+
+    countResult = batch.getResult(0);
+    if(NULL == countResult || countResult->empty() || (*countResult)[0] > 16) {
         /* Device is incapable of providing temperature */
         return NULL;
     }
 
     count = (*countResult)[0];
-    delete countResult;
 
-    retval = new vector<double>(count); // temperature array to be returned
     // query device returns a generic byte array, 
     // not temperature floats as defined by the actual command 
-    result = xchange.queryDevice(helper); 
-    if(NULL == result) {
+    result = batch.getResult(1);
+    if(NULL == result || result->size() < count * sizeof(float)) {
         string error("Expected Transfer::transfer to produce a non-null result "
             "containing temperature.  Without this data, it is not possible to "
             "continue.");
-        delete retval;
         throw ProtocolException(error);
     }
-    else {
-        
-        // the bytes must be transferred to floats for the return temperatures
-        for(i = 0; i < retval->size(); i++) {
-            
-            bptr = (byte *)&temperatureBuffer;
-            for(unsigned int j = 0; j < sizeof(float); j++) {
-                bptr[j] = (*result)[j+(i*sizeof(float))];
-            }
 
-            // fill the return array with the temperatures
-            (*retval)[i] = (double)temperatureBuffer;  
+    retval = new vector<double>(count); // temperature array to be returned
+        
+    // the bytes must be transferred to floats for the return temperatures
+    for(i = 0; i < retval->size(); i++) {
+        
+        bptr = (byte *)&temperatureBuffer;
+        for(unsigned int j = 0; j < sizeof(float); j++) {
+            bptr[j] = (*result)[j+(i*sizeof(float))];
         }
+
+        // fill the return array with the temperatures
+        (*retval)[i] = (double)temperatureBuffer;  
     }
-    delete result;
     return retval;
 }
-
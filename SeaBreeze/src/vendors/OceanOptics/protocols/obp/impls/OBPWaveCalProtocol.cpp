@@ -29,7 +29,8 @@
 
 #include "common/globals.h"
 #include "vendors/OceanOptics/protocols/obp/impls/OBPWaveCalProtocol.h"
-#include "vendors/OceanOptics/protocols/obp/exchanges/OBPGetWaveCalExchange.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPCoefficientsBatch.h"
+#include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
 #include "vendors/OceanOptics/protocols/obp/impls/OceanBinaryProtocol.h"
 #include "common/exceptions/ProtocolBusMismatchException.h"
 
@@ -38,7 +39,7 @@ using namespace seabreeze::oceanBinaryProtocol;
 using namespace std;
 
 OBPWaveCalProtocol::OBPWaveCalProtocol() : WaveCalProtocolInterface(new OceanBinaryProtocol()) {
-
+    this->pipelined = true;
 }
 
 OBPWaveCalProtocol::~OBPWaveCalProtocol() {
@@ -47,42 +48,20 @@ OBPWaveCalProtocol::~OBPWaveCalProtocol() {
 
 vector<double> *OBPWaveCalProtocol::readWavelengthCoeffs(const Bus &bus)
                 throw (ProtocolException) {
-    vector<byte> *result = NULL;
-    unsigned int i;
     vector<double> *retval;
-    float coeff;
-    byte *bptr;
-
-    OBPGetWaveCalExchange xchange;
+    OBPCoefficientsBatch batch(OBPMessageTypes::OBP_GET_WL_COEFF,
+            OBPMessageTypes::OBP_GET_WL_COEFF_COUNT);
 
-    TransferHelper *helper = bus.getHelper(xchange.getHints());
+    TransferHelper *helper = bus.getHelper(batch.getHints());
     if(NULL == helper) {
         string error("Failed to find a helper to bridge given protocol and bus.");
         throw ProtocolBusMismatchException(error);
     }
 
-    retval = new vector<double>(4);
-    for(i = 0; i < retval->size(); i++) {
-        xchange.setCoefficientIndex(i);
-        result = xchange.queryDevice(helper);
-        if(NULL == result) {
-            string error("Expected Transfer::transfer to produce a non-null result "
-                "containing wavelength coefficient.  Without this data, it is not possible to "
-                "continue.");
-            delete retval;
-            throw ProtocolException(error);
-        }
-
-        bptr = (byte *)&coeff;
-        for(unsigned int j = 0; j < sizeof(float); j++) {
-            bptr[j] = (*result)[j];
-        }
-
-        (*retval)[i] = coeff;  /* Only one is returned per request */
-
-        delete result;
-    }
-
+    /* The wavelength calibration is always a third-order polynomial */
+    batch.setPipelined(this->pipelined);
+    retval = batch.readCoefficients(helper, 4);
+    this->pipelined = batch.isPipelined();
     return retval;
 }
 
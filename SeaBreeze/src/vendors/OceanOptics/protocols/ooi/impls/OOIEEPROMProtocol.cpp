@@ -53,9 +53,6 @@ OOIEEPROMProtocol::~OOIEEPROMProtocol() {
 vector<byte> *OOIEEPROMProtocol::readEEPROMSlot(const Bus &bus, int slot)
         throw (ProtocolException) {
 
-    ByteVector *bv = NULL;
-    Data *result = NULL;
-
     ReadEEPROMSlotExchange xchange(slot);
 
     TransferHelper *helper = bus.getHelper(xchange.getHints());
@@ -64,6 +61,52 @@ vector<byte> *OOIEEPROMProtocol::readEEPROMSlot(const Bus &bus, int slot)
         throw ProtocolBusMismatchException(error);
     }
 
+    return readEEPROMSlot(helper, slot);
+}
+
+vector<vector<byte> *> *OOIEEPROMProtocol::readEEPROMSlots(const Bus &bus,
+        int firstSlot, int count) throw (ProtocolException) {
+
+    vector<vector<byte> *> *retval;
+    int i;
+
+    ReadEEPROMSlotExchange xchange(firstSlot);
+
+    TransferHelper *helper = bus.getHelper(xchange.getHints());
+    if(NULL == helper) {
+        string error("Failed to find a helper to bridge given protocol and bus.");
+        throw ProtocolBusMismatchException(error);
+    }
+
+    /* The device only has one command outstanding at a time and does not
+     * tag its replies, so the slots are still read one after another.  The
+     * helper is only looked up once for the whole range though.
+     */
+    retval = new vector<vector<byte> *>();
+    retval->reserve(count);
+    try {
+        for(i = 0; i < count; i++) {
+            retval->push_back(readEEPROMSlot(helper, firstSlot + i));
+        }
+    } catch (ProtocolException &pe) {
+        for(i = 0; i < (int) retval->size(); i++) {
+            delete (*retval)[i];
+        }
+        delete retval;
+        throw;
+    }
+
+    return retval;
+}
+
+vector<byte> *OOIEEPROMProtocol::readEEPROMSlot(TransferHelper *helper, int slot)
+        throw (ProtocolException) {
+
+    ByteVector *bv = NULL;
+    Data *result = NULL;
+
+    ReadEEPROMSlotExchange xchange(slot);
+
     result = xchange.transfer(helper);
     if(NULL == result) {
         string error("Expected Transfer::transfer to produce a non-null result "
@@ -75,9 +118,8 @@ vector<byte> *OOIEEPROMProtocol::readEEPROMSlot(const Bus &bus, int slot)
     bv = static_cast<ByteVector *>(result);
 
     // strip off leading two bytes (echoed request)
-    vector<byte> raw = bv->getByteVector();
-    vector<byte> *retval = new vector<byte>(raw.size() - 2);
-    memcpy(&((*retval)[0]), &(raw[2]), retval->size());
+    vector<byte> &raw = bv->getByteVector();
+    vector<byte> *retval = new vector<byte>(raw.begin() + 2, raw.end());
 
     delete result; /* a.k.a. bv */
 
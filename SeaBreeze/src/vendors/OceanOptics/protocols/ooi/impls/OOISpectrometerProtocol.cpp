@@ -36,6 +36,7 @@
 #include "common/UShortVector.h"
 #include "common/DoubleVector.h"
 #include "common/exceptions/ProtocolBusMismatchException.h"
+#include "common/protocols/SpectrumReceiverInterface.h"
 #include "common/Log.h"
 
 using namespace seabreeze;
@@ -208,6 +209,77 @@ vector<double> *OOISpectrometerProtocol::readFormattedSpectrum(const Bus &bus)
     return retval;
 }
 
+unsigned int OOISpectrometerProtocol::readFormattedSpectrum(const Bus &bus,
+        double *buffer, unsigned int bufferLength) throw (ProtocolException) {
+    return readFormattedSpectrumInto(bus, buffer, bufferLength);
+}
+
+unsigned int OOISpectrometerProtocol::readFormattedSpectrum(const Bus &bus,
+        float *buffer, unsigned int bufferLength) throw (ProtocolException) {
+    return readFormattedSpectrumInto(bus, buffer, bufferLength);
+}
+
+unsigned int OOISpectrometerProtocol::readFormattedSpectrum(const Bus &bus,
+        unsigned short *buffer, unsigned int bufferLength) throw (ProtocolException) {
+    return readFormattedSpectrumInto(bus, buffer, bufferLength);
+}
+
+unsigned int OOISpectrometerProtocol::readFormattedSpectrum(const Bus &bus,
+        unsigned int *buffer, unsigned int bufferLength) throw (ProtocolException) {
+    return readFormattedSpectrumInto(bus, buffer, bufferLength);
+}
+
+bool OOISpectrometerProtocol::getFormattedSpectrumMetadata(SpectrumMetadata &metadata) {
+    SpectrumReceiverInterface *receiver = dynamic_cast<SpectrumReceiverInterface *>(
+            this->readFormattedSpectrumExchange);
+    if(NULL == receiver) {
+        return false;
+    }
+
+    /* The exchange holds on to whatever arrived with its last spectrum */
+    return receiver->getSpectrumMetadata(metadata);
+}
+
+template <class T> unsigned int OOISpectrometerProtocol::readFormattedSpectrumInto(
+        const Bus &bus, T *buffer, unsigned int bufferLength)
+        throw (ProtocolException) {
+
+    LOG(__FUNCTION__);
+
+    TransferHelper *helper;
+    unsigned int count;
+
+    SpectrumReceiverInterface *receiver = dynamic_cast<SpectrumReceiverInterface *>(
+            this->readFormattedSpectrumExchange);
+    if(NULL == receiver) {
+        /* This exchange can only produce a new vector, so copy out of that */
+        vector<double> *spectrum = readFormattedSpectrum(bus);
+        if(NULL == spectrum) {
+            string error("Spectral data was not in a recognized format.");
+            logger.error(error.c_str());
+            throw ProtocolException(error);
+        }
+        count = (bufferLength < spectrum->size()) ? bufferLength : (unsigned int)spectrum->size();
+        for(unsigned int i = 0; i < count; i++) {
+            SpectrumReceiverInterface::storePixel(buffer + i, (*spectrum)[i]);
+        }
+        delete spectrum;
+        return count;
+    }
+
+    helper = bus.getHelper(this->readFormattedSpectrumExchange->getHints());
+    if (NULL == helper) {
+        string error("Failed to find a helper to bridge given protocol and bus.");
+        logger.error(error.c_str());
+        throw ProtocolBusMismatchException(error);
+    }
+
+    /* The pixels are decoded straight out of the exchange's receive buffer.
+     * This may cause a ProtocolException to be thrown.
+     */
+    return receiver->receiveFormattedSpectrum(helper, buffer, bufferLength);
+}
+
 void OOISpectrometerProtocol::requestFormattedSpectrum(const Bus &bus)
         throw (ProtocolException) {
     LOG(__FUNCTION__);
@@ -263,6 +335,16 @@ throw (ProtocolException) {
 }
 
 
+SpectrometerProtocolBinding *OOISpectrometerProtocol::bindSpectrumAcquisition(
+        const Bus &bus) throw (ProtocolException) {
+    /* This throws if the bus has no helper for any of the exchanges */
+    return new SpectrometerProtocolBinding(this, bus,
+            this->requestFormattedSpectrumExchange,
+            this->readFormattedSpectrumExchange,
+            this->requestUnformattedSpectrumExchange,
+            this->readUnformattedSpectrumExchange);
+}
+
 void OOISpectrometerProtocol::setIntegrationTimeMicros(const Bus &bus,
         unsigned long integrationTime_usec) throw (ProtocolException) {
     TransferHelper *helper;
@@ -0,0 +1,224 @@
+/***************************************************//**
+ * @file    EmulatorTestSupport.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Helpers shared by the tests that run the public API against
+ * an OBP device emulator in the same process.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <stdio.h>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "EmulatorTestSupport.h"
+
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+#define MAX_TEST_DEVICES 16
+/* Only a safety net for a broken build; a working one never gets near it */
+#define HANDSHAKE_TIMEOUT_MILLIS 10000
+
+static int failures = 0;
+
+EmulatorThread::EmulatorThread(const OBPEmulatorOptions &options) {
+    OBPEmulatorOptions ephemeral(options);
+
+    ephemeral.port = 0;
+    this->server = new OBPEmulatorServer(ephemeral);
+}
+
+EmulatorThread::~EmulatorThread() {
+    end();
+    delete this->server;
+}
+
+bool EmulatorThread::begin() {
+    if(false == this->server->open()) {
+        return false;
+    }
+    return start();
+}
+
+unsigned short EmulatorThread::getPort() {
+    return this->server->getPort();
+}
+
+void EmulatorThread::end() {
+    this->server->stop();
+    join();
+}
+
+void EmulatorThread::run() {
+    this->server->run();
+}
+
+AcquisitionGate::AcquisitionGate() : holding(false), held(0) {
+
+}
+
+void AcquisitionGate::spectrumRequested() {
+    MutexLock guard(this->lock);
+
+    if(false == this->holding) {
+        return;
+    }
+    this->held++;
+    this->changed.broadcast();
+    while(true == this->holding) {
+        this->changed.wait(this->lock);
+    }
+}
+
+void AcquisitionGate::hold() {
+    MutexLock guard(this->lock);
+    this->holding = true;
+    this->held = 0;
+}
+
+void AcquisitionGate::release() {
+    MutexLock guard(this->lock);
+    this->holding = false;
+    this->changed.broadcast();
+}
+
+bool AcquisitionGate::waitUntilHeld(int timeoutMillis) {
+    MutexLock guard(this->lock);
+
+    while(0 == this->held) {
+        if(false == this->changed.wait(this->lock, timeoutMillis)) {
+            return 0 != this->held;
+        }
+    }
+    return true;
+}
+
+/* Makes one call and signals when it has returned */
+class CallThread : public Thread {
+public:
+    CallThread(TestCall call, long argument)
+        : call(call), argument(argument), errorCode(0), returned(false) { }
+
+    bool waitUntilReturned(int timeoutMillis) {
+        MutexLock guard(this->lock);
+        while(false == this->returned) {
+            if(false == this->done.wait(this->lock, timeoutMillis)) {
+                return this->returned;
+            }
+        }
+        return true;
+    }
+
+    TestCall call;
+    long argument;
+    int errorCode;
+
+protected:
+    virtual void run() {
+        int error = 0;
+
+        this->call(this->argument, &error);
+
+        MutexLock guard(this->lock);
+        this->errorCode = error;
+        this->returned = true;
+        this->done.broadcast();
+    }
+
+private:
+    Mutex lock;
+    ConditionVariable done;
+    bool returned;
+};
+
+bool testReturnsWhileAcquiring(AcquisitionGate &gate, Thread &acquirer,
+        TestCall call, long argument, int *errorCode) {
+    CallThread caller(call, argument);
+    bool returned = false;
+
+    gate.hold();
+    if(false == acquirer.start()) {
+        gate.release();
+        return false;
+    }
+    if(true == gate.waitUntilHeld(HANDSHAKE_TIMEOUT_MILLIS)
+            && true == caller.start()) {
+        /* A call that waits for the acquisition cannot return until the
+         * gate opens, so returning at all is the proof.
+         */
+        returned = caller.waitUntilReturned(HANDSHAKE_TIMEOUT_MILLIS);
+        gate.release();
+        caller.join();
+        *errorCode = caller.errorCode;
+    }
+    gate.release();
+    return returned;
+}
+
+long testAttachEmulator(EmulatorThread &emulator) {
+    long before[MAX_TEST_DEVICES];
+    long after[MAX_TEST_DEVICES];
+    int beforeCount;
+    int afterCount;
+    int error = 0;
+    int i;
+    int j;
+
+    sbapi_initialize();
+    beforeCount = sbapi_get_device_ids(before, MAX_TEST_DEVICES);
+
+    if(0 != sbapi_add_TCPIPv4_device_location((char *)"FlameX",
+            (char *)"127.0.0.1", emulator.getPort())) {
+        return -1;
+    }
+    sbapi_probe_devices();
+
+    /* The new ID is the one that was not there before */
+    afterCount = sbapi_get_device_ids(after, MAX_TEST_DEVICES);
+    for(i = 0; i < afterCount; i++) {
+        for(j = 0; j < beforeCount && before[j] != after[i]; j++);
+        if(j == beforeCount) {
+            if(0 != sbapi_open_device(after[i], &error)) {
+                return -1;
+            }
+            return after[i];
+        }
+    }
+    return -1;
+}
+
+void testCheck(bool condition, const char *text, const char *file, int line) {
+    if(false == condition) {
+        fprintf(stderr, "%s:%d: check failed: %s\n", file, line, text);
+        failures++;
+    }
+}
+
+int testFinish(const char *name) {
+    printf("%s: %s (%d failures)\n", name, (0 == failures) ? "PASS" : "FAIL",
+            failures);
+    return (0 == failures) ? 0 : 1;
+}
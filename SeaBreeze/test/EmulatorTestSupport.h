@@ -0,0 +1,117 @@
+/***************************************************//**
+ * @file    EmulatorTestSupport.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Helpers shared by the tests that run the public API against
+ * an OBP device emulator in the same process.  Each test is
+ * its own program and reports failures through its exit code.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef EMULATORTESTSUPPORT_H
+#define EMULATORTESTSUPPORT_H
+
+#include "native/system/ConditionVariable.h"
+#include "native/system/Mutex.h"
+#include "native/system/Thread.h"
+#include "OBPEmulatorServer.h"
+
+/* Records a failure, with its location, if the condition does not hold */
+#define TEST_CHECK(condition) \
+    testCheck((condition), #condition, __FILE__, __LINE__)
+
+/* Serves one emulated spectrometer on a thread of its own */
+class EmulatorThread : public seabreeze::Thread {
+public:
+    EmulatorThread(const seabreeze::emulator::OBPEmulatorOptions &options);
+    virtual ~EmulatorThread();
+
+    /* Listens on a port picked by the system and starts serving.
+     * Returns false on failure.
+     */
+    bool begin();
+
+    unsigned short getPort();
+
+    /* Stops serving and waits for the thread to finish */
+    void end();
+
+protected:
+    virtual void run();
+
+private:
+    seabreeze::emulator::OBPEmulatorServer *server;
+};
+
+/* Set as the emulator's listener, this lets a test hold immediate spectrum
+ * requests inside the emulator and know when one has arrived.  It starts
+ * open, so requests pass straight through until hold() is called.
+ */
+class AcquisitionGate : public seabreeze::emulator::OBPEmulatorListener {
+public:
+    AcquisitionGate();
+
+    virtual void spectrumRequested();
+
+    /* Requests that arrive from now on wait until release() */
+    void hold();
+    void release();
+
+    /* Waits until a request is held.  Returns false if none arrived within
+     * the timeout.
+     */
+    bool waitUntilHeld(int timeoutMillis);
+
+private:
+    seabreeze::Mutex lock;
+    seabreeze::ConditionVariable changed;
+    bool holding;
+    unsigned int held;
+};
+
+/* The call that testReturnsWhileAcquiring() makes, with its argument */
+typedef void (*TestCall)(long argument, int *errorCode);
+
+/* Starts acquirer, holds the first immediate spectrum request that it
+ * makes in the emulator, and makes the call while that request is held.
+ * Returns true only if the call came back without waiting for the held
+ * acquisition.  The request is let go afterwards either way; the caller
+ * joins acquirer.
+ */
+bool testReturnsWhileAcquiring(AcquisitionGate &gate, seabreeze::Thread &acquirer,
+        TestCall call, long argument, int *errorCode);
+
+/* Registers the emulator as a FlameX at its TCP address, probes, and
+ * opens it.  Returns the device ID, or -1 if any step failed.
+ */
+long testAttachEmulator(EmulatorThread &emulator);
+
+void testCheck(bool condition, const char *text, const char *file, int line);
+
+/* Prints a summary and returns the exit status for main() */
+int testFinish(const char *name);
+
+#endif /* EMULATORTESTSUPPORT_H */
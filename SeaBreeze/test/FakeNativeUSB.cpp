@@ -0,0 +1,458 @@
+/***************************************************//**
+ * @file    FakeNativeUSB.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Implements the native USB interface over an in-memory bus
+ * for tests.  See FakeNativeUSB.h.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <string.h>
+#include <deque>
+#include <map>
+#include <vector>
+#include "native/system/ConditionVariable.h"
+#include "native/system/Mutex.h"
+#include "native/usb/NativeUSB.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBInterface.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBProductID.h"
+#include "OBPEmulatedDevice.h"
+#include "FakeNativeUSB.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+/* The endpoints of OOIUSBSimpleDualEndpointMap, which the FlameX uses */
+#define EMULATED_OUT_EP     0x01
+#define EMULATED_IN_EP      0x81
+
+typedef vector<unsigned char> Chunk;
+typedef pair<unsigned long, int> EndpointKey;
+
+struct FakeDevice {
+    unsigned short vendorID;
+    unsigned short productID;
+    int maxPacketSize;
+    bool present;
+};
+
+struct EmulatedDevice {
+    OBPEmulatedDevice *model;
+    Mutex lock;
+    vector<byte> pending;       /* Written bytes that are not a whole message */
+};
+
+struct FakeHandle {
+    unsigned long deviceID;
+};
+
+struct FakeTicket {
+    EndpointKey endpoint;
+    char *data;
+    int length;
+};
+
+static Mutex busLock;
+static ConditionVariable dataArrived;
+static map<unsigned long, FakeDevice> devices;
+static map<EndpointKey, deque<Chunk> > readData;
+static map<int, FakeTicket> tickets;
+static unsigned long nextDeviceID = 1;
+static int nextTicket = 0;
+static bool queuedReads = true;
+static FakeUSBCounts counts;
+/* These are never deleted, since a write may still be using one after the
+ * device has been removed.
+ */
+static map<unsigned long, EmulatedDevice *> emulatedDevices;
+
+/* The caller must hold busLock.  Returns the length copied, or -1 if
+ * there was nothing to read.
+ */
+static int takeChunk(const EndpointKey &key, char *data, int length) {
+    map<EndpointKey, deque<Chunk> >::iterator iter = readData.find(key);
+    if(readData.end() == iter || true == iter->second.empty()) {
+        return -1;
+    }
+
+    Chunk &chunk = iter->second.front();
+    int copied = ((int)chunk.size() < length) ? (int)chunk.size() : length;
+    if(copied > 0) {
+        memcpy(data, &chunk[0], copied);
+    }
+    if(copied == (int)chunk.size()) {
+        iter->second.pop_front();
+    } else {
+        chunk.erase(chunk.begin(), chunk.begin() + copied);
+    }
+    return copied;
+}
+
+/* Feeds written bytes to the device model and queues each reply as one
+ * transfer.  Writes may split or pad a message, so bytes are gathered
+ * until a whole message is there, and padding after one is dropped.
+ */
+static void emulatedWrite(EmulatedDevice *device, unsigned long deviceID,
+        const unsigned char *data, int length) {
+    MutexLock guard(device->lock);
+    unsigned int total;
+
+    device->pending.insert(device->pending.end(), data, data + length);
+    while(device->pending.size() >= OBPEmulatedDevice::HEADER_PREFIX_LENGTH) {
+        total = OBPEmulatedDevice::HEADER_PREFIX_LENGTH
+                + OBPEmulatedDevice::getBytesRemaining(&device->pending[0]);
+        if(OBPEmulatedDevice::HEADER_PREFIX_LENGTH == total) {
+            /* Not the start of a message, so this must be padding */
+            device->pending.clear();
+            return;
+        }
+        if(device->pending.size() < total) {
+            return;
+        }
+
+        vector<byte> reply;
+        device->model->handleMessage(&device->pending[0], total, reply);
+        device->pending.erase(device->pending.begin(),
+                device->pending.begin() + total);
+        if(false == reply.empty()) {
+            fakeUSBAddReadData(deviceID, EMULATED_IN_EP, &reply[0],
+                    (int)reply.size());
+        }
+    }
+}
+
+unsigned long fakeUSBAddDevice(unsigned short vendorID,
+        unsigned short productID, int maxPacketSize) {
+    MutexLock guard(busLock);
+    FakeDevice device;
+
+    device.vendorID = vendorID;
+    device.productID = productID;
+    device.maxPacketSize = maxPacketSize;
+    device.present = true;
+    devices[nextDeviceID] = device;
+    return nextDeviceID++;
+}
+
+unsigned long fakeUSBAddEmulatedDevice(const OBPEmulatorOptions &options) {
+    unsigned long deviceID;
+    EmulatedDevice *device = new EmulatedDevice;
+
+    device->model = new OBPEmulatedDevice(options);
+    deviceID = fakeUSBAddDevice(OCEAN_OPTICS_USB_VID, FLAMEX_USB_PID);
+
+    MutexLock guard(busLock);
+    emulatedDevices[deviceID] = device;
+    return deviceID;
+}
+
+void fakeUSBRemoveDevice(unsigned long deviceID) {
+    MutexLock guard(busLock);
+    devices.erase(deviceID);
+}
+
+void fakeUSBSetQueuedReads(bool supported) {
+    MutexLock guard(busLock);
+    queuedReads = supported;
+}
+
+void fakeUSBAddReadData(unsigned long deviceID, int endpoint,
+        const void *data, int length) {
+    MutexLock guard(busLock);
+    const unsigned char *bytes = (const unsigned char *)data;
+
+    readData[EndpointKey(deviceID, endpoint)].push_back(
+            Chunk(bytes, bytes + length));
+    dataArrived.broadcast();
+}
+
+FakeUSBCounts fakeUSBGetCounts() {
+    MutexLock guard(busLock);
+    return counts;
+}
+
+void fakeUSBResetCounts() {
+    MutexLock guard(busLock);
+    memset(&counts, 0, sizeof(counts));
+}
+
+/* The USB trace recorder links against a library built with the trace
+ * shim, which forwards to the real backend under these names.  Taking
+ * them instead of the public ones puts the fake bus underneath the shim
+ * so that the shim's recording sees the emulator's traffic.
+ */
+#ifdef FAKE_USB_UNDER_TRACE
+#define USBProbeDevices             __native_USBProbeDevices
+#define USBProbeAllDevices          __native_USBProbeAllDevices
+#define USBOpen                     __native_USBOpen
+#define USBClose                    __native_USBClose
+#define USBWrite                    __native_USBWrite
+#define USBRead                     __native_USBRead
+#define USBSubmitRead               __native_USBSubmitRead
+#define USBCompleteRead             __native_USBCompleteRead
+#define USBCancelRead               __native_USBCancelRead
+#define USBClearStall               __native_USBClearStall
+#define USBGetDeviceDescriptor      __native_USBGetDeviceDescriptor
+#define USBGetInterfaceDescriptor   __native_USBGetInterfaceDescriptor
+#define USBGetEndpointDescriptor    __native_USBGetEndpointDescriptor
+#define USBGetStringDescriptor      __native_USBGetStringDescriptor
+#endif
+
+extern "C" {
+
+int
+USBProbeAllDevices(const struct USBDeviceFilter *filters, int numberOfFilters,
+        struct USBProbedDevice *output, int max_devices) {
+    MutexLock guard(busLock);
+    map<unsigned long, FakeDevice>::iterator iter;
+    int count = 0;
+    int f;
+
+    counts.probes++;
+    for(iter = devices.begin(); iter != devices.end() && count < max_devices; iter++) {
+        for(f = 0; f < numberOfFilters; f++) {
+            if(filters[f].vendorID == iter->second.vendorID
+                    && filters[f].productID == iter->second.productID) {
+                output[count].deviceID = iter->first;
+                output[count].vendorID = iter->second.vendorID;
+                output[count].productID = iter->second.productID;
+                count++;
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+int
+USBProbeDevices(int vendorID, int productID, unsigned long *output,
+        int max_devices) {
+    struct USBDeviceFilter filter;
+    vector<struct USBProbedDevice> found(max_devices + 1);
+    int count;
+    int i;
+
+    filter.vendorID = (unsigned short)vendorID;
+    filter.productID = (unsigned short)productID;
+    count = USBProbeAllDevices(&filter, 1, &found[0], max_devices);
+    for(i = 0; i < count; i++) {
+        output[i] = found[i].deviceID;
+    }
+    return count;
+}
+
+void *
+USBOpen(unsigned long deviceID, int *errorCode) {
+    MutexLock guard(busLock);
+    FakeHandle *handle;
+
+    counts.opens++;
+    if(devices.end() == devices.find(deviceID)) {
+        SET_ERROR_CODE(NO_DEVICE_FOUND);
+        return NULL;
+    }
+
+    handle = new FakeHandle;
+    handle->deviceID = deviceID;
+    SET_ERROR_CODE(OPEN_OK);
+    return handle;
+}
+
+int
+USBClose(void *handle) {
+    delete (FakeHandle *)handle;
+    return CLOSE_OK;
+}
+
+int
+USBWrite(void *handle, unsigned char endpoint, char *data, int numberOfBytes) {
+    unsigned long deviceID = ((FakeHandle *)handle)->deviceID;
+    EmulatedDevice *emulated = NULL;
+    map<unsigned long, EmulatedDevice *>::iterator iter;
+
+    {
+        MutexLock guard(busLock);
+        counts.writes++;
+        if(devices.end() == devices.find(deviceID)) {
+            return WRITE_FAILED;
+        }
+        iter = emulatedDevices.find(deviceID);
+        if(emulatedDevices.end() != iter) {
+            emulated = iter->second;
+        }
+    }
+
+    /* Replies are queued through fakeUSBAddReadData(), which needs the lock */
+    if(NULL != emulated && EMULATED_OUT_EP == endpoint) {
+        emulatedWrite(emulated, deviceID, (const unsigned char *)data,
+                numberOfBytes);
+    }
+    return numberOfBytes;
+}
+
+int
+USBRead(void *handle, unsigned char endpoint, char *data, int numberOfBytes) {
+    MutexLock guard(busLock);
+    unsigned long deviceID = ((FakeHandle *)handle)->deviceID;
+
+    counts.reads++;
+    if(devices.end() == devices.find(deviceID)) {
+        return READ_FAILED;
+    }
+    return takeChunk(EndpointKey(deviceID, endpoint), data, numberOfBytes);
+}
+
+int
+USBSubmitRead(void *handle, unsigned char endpoint, char *data, int numberOfBytes) {
+    MutexLock guard(busLock);
+    FakeTicket ticket;
+
+    counts.submits++;
+    if(false == queuedReads) {
+        return SUBMIT_UNSUPPORTED;
+    }
+
+    ticket.endpoint = EndpointKey(((FakeHandle *)handle)->deviceID, endpoint);
+    ticket.data = data;
+    ticket.length = numberOfBytes;
+    tickets[nextTicket] = ticket;
+    return nextTicket++;
+}
+
+int
+USBCompleteRead(void *handle, int ticket, int timeoutMillis) {
+    MutexLock guard(busLock);
+    map<int, FakeTicket>::iterator iter;
+    int result;
+
+    counts.completes++;
+    iter = tickets.find(ticket);
+    if(tickets.end() == iter) {
+        return READ_FAILED;
+    }
+
+    while(true) {
+        if(devices.end() == devices.find(iter->second.endpoint.first)) {
+            tickets.erase(iter);
+            return READ_FAILED;
+        }
+        result = takeChunk(iter->second.endpoint, iter->second.data,
+                iter->second.length);
+        if(result >= 0) {
+            tickets.erase(iter);
+            return result;
+        }
+        if(0 == timeoutMillis || false == dataArrived.wait(busLock, timeoutMillis)) {
+            return READ_PENDING;
+        }
+        /* The map may have changed while the lock was released */
+        iter = tickets.find(ticket);
+        if(tickets.end() == iter) {
+            return READ_FAILED;
+        }
+    }
+}
+
+int
+USBCancelRead(void *handle, int ticket) {
+    MutexLock guard(busLock);
+    map<int, FakeTicket>::iterator iter;
+
+    counts.cancels++;
+    iter = tickets.find(ticket);
+    if(tickets.end() == iter) {
+        return ABORT_FAILED;
+    }
+    tickets.erase(iter);
+    dataArrived.broadcast();
+    return ABORT_OK;
+}
+
+void
+USBClearStall(void *handle, unsigned char endpoint) {
+
+}
+
+int
+USBGetDeviceDescriptor(void *handle, struct USBDeviceDescriptor *desc) {
+    MutexLock guard(busLock);
+    map<unsigned long, FakeDevice>::iterator iter
+            = devices.find(((FakeHandle *)handle)->deviceID);
+
+    if(devices.end() == iter) {
+        return -1;
+    }
+    memset(desc, 0, sizeof(*desc));
+    desc->bLength = 18;
+    desc->bDescriptorType = 1;
+    desc->bcdUSB = 0x0200;
+    desc->bMaxPacketSize0 = 64;
+    desc->idVendor = iter->second.vendorID;
+    desc->idProduct = iter->second.productID;
+    desc->bNumConfigurations = 1;
+    return 0;
+}
+
+int
+USBGetInterfaceDescriptor(void *handle, struct USBInterfaceDescriptor *desc) {
+    memset(desc, 0, sizeof(*desc));
+    desc->bLength = 9;
+    desc->bDescriptorType = 4;
+    desc->bNumEndpoints = 4;
+    desc->bInterfaceClass = 0xFF;
+    return 0;
+}
+
+int
+USBGetEndpointDescriptor(void *handle, int endpoint_index,
+        struct USBEndpointDescriptor *desc) {
+    MutexLock guard(busLock);
+    map<unsigned long, FakeDevice>::iterator iter
+            = devices.find(((FakeHandle *)handle)->deviceID);
+
+    if(devices.end() == iter) {
+        return -1;
+    }
+    memset(desc, 0, sizeof(*desc));
+    desc->bLength = 7;
+    desc->bDescriptorType = 5;
+    desc->bEndpointAddress = (unsigned char)((0 == endpoint_index % 2)
+            ? endpoint_index + 1 : 0x80 | endpoint_index);
+    desc->bmAttributes = 2;
+    desc->wMaxPacketSize = (unsigned short)iter->second.maxPacketSize;
+    return 0;
+}
+
+int
+USBGetStringDescriptor(void *handle, unsigned int string_index, char *buffer,
+        int maxLength) {
+    return 0;
+}
+
+}
@@ -0,0 +1,85 @@
+/***************************************************//**
+ * @file    FakeNativeUSB.h
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * A scriptable stand-in for the native USB layer (NativeUSB.h).
+ * A test program that links FakeNativeUSB.cpp defines the native
+ * USB functions itself.  The dynamic linker resolves the library's
+ * own calls to those definitions, so USB, USBDiscovery and the
+ * transfer helpers above them run against this fake bus instead
+ * of hardware.  This relies on ELF symbol interposition and so
+ * only works on platforms that have it.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#ifndef FAKENATIVEUSB_H
+#define FAKENATIVEUSB_H
+
+#include "OBPEmulatorOptions.h"
+
+/* How often each native call has been made since the last reset */
+struct FakeUSBCounts {
+    int probes;
+    int opens;
+    int writes;
+    int reads;
+    int submits;
+    int completes;
+    int cancels;
+};
+
+/* Adds a device to the bus and returns its native ID.  IDs are never
+ * reused, even after a device is removed.  The maximum packet size is
+ * what the endpoint descriptors report; USB 2.0 devices use 512.
+ */
+unsigned long fakeUSBAddDevice(unsigned short vendorID,
+        unsigned short productID, int maxPacketSize = 512);
+void fakeUSBRemoveDevice(unsigned long deviceID);
+
+/* Adds a FlameX whose OBP traffic is answered by the emulator's device
+ * model, as the TCP emulator would answer it.  Returns its native ID.
+ */
+unsigned long fakeUSBAddEmulatedDevice(
+        const seabreeze::emulator::OBPEmulatorOptions &options);
+
+/* With false, USBSubmitRead() reports SUBMIT_UNSUPPORTED like the
+ * backends that only have blocking reads.
+ */
+void fakeUSBSetQueuedReads(bool supported);
+
+/* Queues one transfer's worth of data on an IN endpoint.  A read takes
+ * as much of the oldest transfer as it asked for, and never more than
+ * that one transfer.  A blocking read with nothing queued fails at once
+ * rather than hanging the test, while a queued read stays pending until
+ * data arrives or it is cancelled.
+ */
+void fakeUSBAddReadData(unsigned long deviceID, int endpoint,
+        const void *data, int length);
+
+FakeUSBCounts fakeUSBGetCounts();
+void fakeUSBResetCounts();
+
+#endif /* FAKENATIVEUSB_H */
@@ -0,0 +1,214 @@
+/***************************************************//**
+ * @file    emulator_acquisition_group_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks acquisition groups on two emulated devices, including groups
+ * that share devices in opposite orders on different threads, and a group
+ * destroyed while it is acquiring.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "native/system/NativeSystem.h"
+#include "native/system/Thread.h"
+#include "EmulatorTestSupport.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+#define GROUP_CYCLES            50
+#define ACQUISITIONS_PER_THREAD 20
+#define INTEGRATION_MICROS      2000
+
+/* Acquires from one group count times, or until it is destroyed */
+class GroupReader : public Thread {
+public:
+    GroupReader(long groupID, int pixels, int count)
+        : groupID(groupID), pixels(pixels), count(count),
+          completed(0), failures(0), lastError(0) { }
+
+    long groupID;
+    int pixels;
+    int count;
+    /* Read by the main thread while this one runs */
+    volatile unsigned int completed;
+    int failures;
+    int lastError;
+
+protected:
+    virtual void run() {
+        vector<double> buffer(2 * this->pixels);
+        sbapi_group_spectrum_t results[2];
+        int error = 0;
+
+        for(int i = 0; i < this->count; i++) {
+            int members = sbapi_acquisition_group_get_formatted_spectra(
+                    this->groupID, &error, &buffer[0], this->pixels,
+                    results, 2);
+            this->lastError = error;
+            if(ERROR_INPUT_OUT_OF_BOUNDS == error) {
+                return;
+            }
+            if(0 != error || 2 != members
+                    || this->pixels != results[0].pixels
+                    || this->pixels != results[1].pixels) {
+                this->failures++;
+            }
+            atomicStore(&this->completed, atomicLoad(&this->completed) + 1);
+        }
+    }
+};
+
+static void setIntegrationTime(const long *deviceIDs, const long *featureIDs,
+        unsigned long micros) {
+    int error = 0;
+
+    for(int i = 0; i < 2; i++) {
+        sbapi_spectrometer_set_integration_time_micros(deviceIDs[i],
+                featureIDs[i], &error, micros);
+        TEST_CHECK(0 == error);
+    }
+}
+
+static void destroyGroup(long groupID, int *errorCode) {
+    sbapi_destroy_acquisition_group(groupID, errorCode);
+}
+
+int main() {
+    AcquisitionGate gate;
+    OBPEmulatorOptions options;
+    long deviceIDs[2];
+    long featureIDs[2];
+    long reversedDevices[2];
+    long reversedFeatures[2];
+    long groupID;
+    long previousID = 0;
+    int error = 0;
+    int i;
+
+    options.listener = &gate;
+    options.serialNumber = "OFXGRPA";
+    EmulatorThread emulatorA(options);
+    TEST_CHECK(true == emulatorA.begin());
+    options.serialNumber = "OFXGRPB";
+    EmulatorThread emulatorB(options);
+    TEST_CHECK(true == emulatorB.begin());
+
+    deviceIDs[0] = testAttachEmulator(emulatorA);
+    deviceIDs[1] = testAttachEmulator(emulatorB);
+    TEST_CHECK(deviceIDs[0] >= 0 && deviceIDs[1] >= 0);
+    if(deviceIDs[0] < 0 || deviceIDs[1] < 0) {
+        return testFinish("emulator_acquisition_group_test");
+    }
+    for(i = 0; i < 2; i++) {
+        TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceIDs[i], &error,
+                &featureIDs[i], 1));
+        reversedDevices[1 - i] = deviceIDs[i];
+        reversedFeatures[1 - i] = featureIDs[i];
+    }
+    setIntegrationTime(deviceIDs, featureIDs, INTEGRATION_MICROS);
+
+    int pixels = (int)options.numberOfPixels;
+    vector<double> buffer(2 * pixels);
+    sbapi_group_spectrum_t results[2];
+
+    /* Destroyed groups are gone for good, and their IDs are not reused */
+    for(i = 0; i < GROUP_CYCLES; i++) {
+        groupID = sbapi_create_acquisition_group(deviceIDs, featureIDs, 2,
+                &error);
+        TEST_CHECK(groupID > previousID);
+        previousID = groupID;
+        sbapi_destroy_acquisition_group(groupID, &error);
+        TEST_CHECK(0 == error);
+    }
+    sbapi_acquisition_group_get_formatted_spectra(previousID, &error,
+            &buffer[0], pixels, results, 2);
+    TEST_CHECK(ERROR_INPUT_OUT_OF_BOUNDS == error);
+    sbapi_destroy_acquisition_group(previousID, &error);
+    TEST_CHECK(ERROR_INPUT_OUT_OF_BOUNDS == error);
+
+    /* A device may not be in a group twice */
+    long twice[2] = { deviceIDs[0], deviceIDs[0] };
+    TEST_CHECK(0 == sbapi_create_acquisition_group(twice, featureIDs, 2,
+            &error));
+    TEST_CHECK(0 != error);
+
+    /* Groups that list the same devices in opposite orders must not
+     * deadlock when they acquire at the same time.
+     */
+    long forward = sbapi_create_acquisition_group(deviceIDs, featureIDs, 2,
+            &error);
+    long backward = sbapi_create_acquisition_group(reversedDevices,
+            reversedFeatures, 2, &error);
+    TEST_CHECK(forward > 0 && backward > 0);
+    GroupReader forwardReader(forward, pixels, ACQUISITIONS_PER_THREAD);
+    GroupReader backwardReader(backward, pixels, ACQUISITIONS_PER_THREAD);
+    TEST_CHECK(true == forwardReader.start());
+    TEST_CHECK(true == backwardReader.start());
+    forwardReader.join();
+    backwardReader.join();
+    TEST_CHECK(0 == forwardReader.failures);
+    TEST_CHECK(ACQUISITIONS_PER_THREAD == atomicLoad(&forwardReader.completed));
+    TEST_CHECK(0 == backwardReader.failures);
+    TEST_CHECK(ACQUISITIONS_PER_THREAD == atomicLoad(&backwardReader.completed));
+    sbapi_destroy_acquisition_group(backward, &error);
+    TEST_CHECK(0 == error);
+
+    /* Results come back in the order the members were given */
+    TEST_CHECK(2 == sbapi_acquisition_group_get_formatted_spectra(forward,
+            &error, &buffer[0], pixels, results, 2));
+    TEST_CHECK(0 == error);
+    TEST_CHECK(deviceIDs[0] == results[0].device_id);
+    TEST_CHECK(deviceIDs[1] == results[1].device_id);
+
+    /* Destroying a group while one of its acquisitions is held in the
+     * emulator returns without waiting for it.  That acquisition still
+     * completes, and the next call is refused.
+     */
+    GroupReader slow(forward, pixels, 2);
+    TEST_CHECK(true == testReturnsWhileAcquiring(gate, slow, destroyGroup,
+            forward, &error));
+    TEST_CHECK(0 == error);
+    slow.join();
+    TEST_CHECK(1 == atomicLoad(&slow.completed));
+    TEST_CHECK(0 == slow.failures);
+    TEST_CHECK(ERROR_INPUT_OUT_OF_BOUNDS == slow.lastError);
+
+    /* The devices are still usable once the groups are gone */
+    setIntegrationTime(deviceIDs, featureIDs, INTEGRATION_MICROS);
+    for(i = 0; i < 2; i++) {
+        sbapi_close_device(deviceIDs[i], &error);
+        TEST_CHECK(0 == error);
+    }
+
+    sbapi_shutdown();
+    emulatorA.end();
+    emulatorB.end();
+    return testFinish("emulator_acquisition_group_test");
+}
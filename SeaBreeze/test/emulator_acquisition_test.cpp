@@ -0,0 +1,113 @@
+/***************************************************//**
+ * @file    emulator_acquisition_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Opens an emulated FlameX through the public API and checks
+ * that the serial number, wavelengths, and spectra that come
+ * back are the ones the emulator was configured to produce.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <string.h>
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "EmulatorTestSupport.h"
+
+using namespace std;
+using namespace seabreeze::emulator;
+
+int main() {
+    OBPEmulatorOptions options;
+    long deviceID;
+    long serialFeature;
+    long spectrometerFeature;
+    char serial[32];
+    int error = 0;
+    int length;
+    int i;
+
+    options.serialNumber = "OFXTEST1";
+    EmulatorThread emulator(options);
+    TEST_CHECK(true == emulator.begin());
+
+    deviceID = testAttachEmulator(emulator);
+    TEST_CHECK(deviceID >= 0);
+    if(deviceID < 0) {
+        return testFinish("emulator_acquisition_test");
+    }
+
+    TEST_CHECK(1 == sbapi_get_serial_number_features(deviceID, &error, &serialFeature, 1));
+    memset(serial, 0, sizeof(serial));
+    sbapi_get_serial_number(deviceID, serialFeature, &error, serial, sizeof(serial) - 1);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(0 == strcmp(serial, "OFXTEST1"));
+
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceID, &error, &spectrometerFeature, 1));
+    length = sbapi_spectrometer_get_formatted_spectrum_length(deviceID,
+            spectrometerFeature, &error);
+    TEST_CHECK(0 == error);
+    TEST_CHECK((int)options.numberOfPixels == length);
+
+    vector<double> wavelengths(options.numberOfPixels);
+    length = sbapi_spectrometer_get_wavelengths(deviceID, spectrometerFeature,
+            &error, &wavelengths[0], (int)wavelengths.size());
+    TEST_CHECK(0 == error);
+    TEST_CHECK((int)options.numberOfPixels == length);
+    TEST_CHECK(200.0 == wavelengths[0]);
+
+    sbapi_spectrometer_set_integration_time_micros(deviceID, spectrometerFeature,
+            &error, 2000);
+    TEST_CHECK(0 == error);
+
+    vector<double> spectrum(options.numberOfPixels);
+    for(int attempt = 0; attempt < 3; attempt++) {
+        length = sbapi_spectrometer_get_formatted_spectrum(deviceID,
+                spectrometerFeature, &error, &spectrum[0], (int)spectrum.size());
+        TEST_CHECK(0 == error);
+        TEST_CHECK((int)options.numberOfPixels == length);
+        for(i = 0; i < length; i++) {
+            if(spectrum[i] < 0 || spectrum[i] > options.maxIntensity) {
+                break;
+            }
+        }
+        TEST_CHECK(i == length);
+    }
+
+    /* A buffer that is too small gets a truncated spectrum, not an overrun */
+    spectrum[10] = -1.0;
+    length = sbapi_spectrometer_get_formatted_spectrum(deviceID,
+            spectrometerFeature, &error, &spectrum[0], 10);
+    TEST_CHECK(10 == length);
+    TEST_CHECK(-1.0 == spectrum[10]);
+
+    sbapi_close_device(deviceID, &error);
+    TEST_CHECK(0 == error);
+
+    sbapi_shutdown();
+    emulator.end();
+    return testFinish("emulator_acquisition_test");
+}
@@ -0,0 +1,185 @@
+/***************************************************//**
+ * @file    emulator_async_acquisition_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks queued acquisitions, including a request that one thread
+ * waits on while another collects its result.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "native/system/ConditionVariable.h"
+#include "native/system/Mutex.h"
+#include "native/system/System.h"
+#include "native/system/Thread.h"
+#include "EmulatorTestSupport.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+#define RACE_ROUNDS             30
+#define WAITERS_PER_ROUND       8
+#define CALLBACK_REQUESTS       10
+#define CALLBACK_TIMEOUT_MILLIS 10000
+#define SLOW_INTEGRATION_MICROS 300000
+#define RACE_INTEGRATION_MICROS 20000
+#define FAST_INTEGRATION_MICROS 2000
+
+static Mutex callbackLock;
+static ConditionVariable callbackArrived;
+static int callbacks = 0;
+static int callbackFailures = 0;
+
+static void acquisitionCallback(long requestID, int errorCode, int length,
+        void *userData) {
+    MutexLock guard(callbackLock);
+
+    if(0 != errorCode || *((int *)userData) != length) {
+        callbackFailures++;
+    }
+    callbacks++;
+    callbackArrived.broadcast();
+}
+
+/* Waits on a request that some other thread collects */
+class Waiter : public Thread {
+public:
+    Waiter() : requestID(0), result(-1), error(-1) { }
+
+    long requestID;
+    int result;
+    int error;
+
+protected:
+    virtual void run() {
+        this->result = sbapi_spectrometer_wait_acquisition(this->requestID,
+                &this->error, -1);
+    }
+};
+
+int main() {
+    OBPEmulatorOptions options;
+    long spectrometerFeature;
+    long requestID;
+    int error = 0;
+    int i;
+
+    EmulatorThread emulator(options);
+    TEST_CHECK(true == emulator.begin());
+
+    long deviceID = testAttachEmulator(emulator);
+    TEST_CHECK(deviceID >= 0);
+    if(deviceID < 0) {
+        return testFinish("emulator_async_acquisition_test");
+    }
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceID, &error,
+            &spectrometerFeature, 1));
+    int pixels = (int)options.numberOfPixels;
+    vector<double> spectrum(pixels);
+
+    /* Polling does not wait, and a collected request is gone */
+    sbapi_spectrometer_set_integration_time_micros(deviceID,
+            spectrometerFeature, &error, SLOW_INTEGRATION_MICROS);
+    sbapi_spectrometer_get_formatted_spectrum(deviceID, spectrometerFeature,
+            &error, &spectrum[0], pixels);
+    requestID = sbapi_spectrometer_submit_formatted_spectrum(deviceID,
+            spectrometerFeature, &error, &spectrum[0], pixels, NULL, NULL);
+    TEST_CHECK(requestID > 0);
+    TEST_CHECK(0 == sbapi_spectrometer_wait_acquisition(requestID, &error, 0));
+    TEST_CHECK(0 == error);
+    TEST_CHECK(pixels == sbapi_spectrometer_get_acquisition_result(requestID,
+            &error));
+    TEST_CHECK(0 == error);
+    sbapi_spectrometer_wait_acquisition(requestID, &error, 0);
+    TEST_CHECK(ERROR_INPUT_OUT_OF_BOUNDS == error);
+    sbapi_spectrometer_get_acquisition_result(requestID, &error);
+    TEST_CHECK(ERROR_INPUT_OUT_OF_BOUNDS == error);
+
+    /* Several threads are already waiting on each request when this one
+     * collects it.  Collecting must not free the request out from under
+     * them as they wake up.
+     */
+    sbapi_spectrometer_set_integration_time_micros(deviceID,
+            spectrometerFeature, &error, RACE_INTEGRATION_MICROS);
+    int raceFailures = 0;
+    for(int round = 0; round < RACE_ROUNDS; round++) {
+        Waiter waiters[WAITERS_PER_ROUND];
+
+        requestID = sbapi_spectrometer_submit_formatted_spectrum(deviceID,
+                spectrometerFeature, &error, &spectrum[0], pixels, NULL, NULL);
+        for(i = 0; i < WAITERS_PER_ROUND; i++) {
+            waiters[i].requestID = requestID;
+            waiters[i].start();
+        }
+        System::sleepMilliseconds(RACE_INTEGRATION_MICROS / 4000);
+        if(pixels != sbapi_spectrometer_get_acquisition_result(requestID,
+                &error) || 0 != error) {
+            raceFailures++;
+        }
+        for(i = 0; i < WAITERS_PER_ROUND; i++) {
+            waiters[i].join();
+            /* A waiter that looked the request up too late is refused */
+            if(!(1 == waiters[i].result && 0 == waiters[i].error)
+                    && !(0 == waiters[i].result
+                        && ERROR_INPUT_OUT_OF_BOUNDS == waiters[i].error)) {
+                raceFailures++;
+            }
+        }
+    }
+    TEST_CHECK(0 == raceFailures);
+
+    /* Requests with callbacks run in order and need no collecting */
+    sbapi_spectrometer_set_integration_time_micros(deviceID,
+            spectrometerFeature, &error, FAST_INTEGRATION_MICROS);
+    vector<vector<double> > buffers(CALLBACK_REQUESTS, vector<double>(pixels));
+    for(i = 0; i < CALLBACK_REQUESTS; i++) {
+        requestID = sbapi_spectrometer_submit_formatted_spectrum(deviceID,
+                spectrometerFeature, &error, &buffers[i][0], pixels,
+                acquisitionCallback, &pixels);
+        TEST_CHECK(requestID > 0);
+    }
+    {
+        MutexLock guard(callbackLock);
+        while(callbacks < CALLBACK_REQUESTS) {
+            if(false == callbackArrived.wait(callbackLock,
+                    CALLBACK_TIMEOUT_MILLIS)) {
+                break;
+            }
+        }
+        TEST_CHECK(CALLBACK_REQUESTS == callbacks);
+        TEST_CHECK(0 == callbackFailures);
+    }
+
+    sbapi_close_device(deviceID, &error);
+    TEST_CHECK(0 == error);
+
+    sbapi_shutdown();
+    emulator.end();
+    return testFinish("emulator_async_acquisition_test");
+}
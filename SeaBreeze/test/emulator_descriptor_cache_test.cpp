@@ -0,0 +1,164 @@
+/***************************************************//**
+ * @file    emulator_descriptor_cache_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks that descriptor cache files are shared safely and that a
+ * cached calibration is not used once the device holds a different one.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <stdio.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "common/devices/DeviceDescriptorCache.h"
+#include "EmulatorTestSupport.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+#define CACHE_PATH "emulator_descriptor_cache_test.cache"
+
+static void removeCacheFiles() {
+    remove(CACHE_PATH);
+    remove(CACHE_PATH ".lock");
+    remove(CACHE_PATH ".tmp");
+}
+
+static DeviceDescriptor makeDescriptor(double value) {
+    DeviceDescriptor descriptor;
+    descriptor.setValues("value", vector<double>(1, value));
+    return descriptor;
+}
+
+static bool hasEntry(const string &key) {
+    DeviceDescriptorCache cache(CACHE_PATH);
+    DeviceDescriptor descriptor;
+    return true == cache.load() && true == cache.find(key, descriptor);
+}
+
+/* Two caches on one file stand in for two processes sharing it */
+static void testSharedFile() {
+    DeviceDescriptorCache first(CACHE_PATH);
+    DeviceDescriptorCache second(CACHE_PATH);
+
+    TEST_CHECK(true == first.load());
+    TEST_CHECK(true == second.load());
+
+    first.store("one", makeDescriptor(1));
+    TEST_CHECK(true == first.save());
+    second.store("two", makeDescriptor(2));
+    TEST_CHECK(true == second.save());
+
+    /* The second save must not have dropped what the first one wrote */
+    TEST_CHECK(true == hasEntry("one"));
+    TEST_CHECK(true == hasEntry("two"));
+
+    first.remove("one");
+    TEST_CHECK(true == first.save());
+    TEST_CHECK(false == hasEntry("one"));
+    TEST_CHECK(true == hasEntry("two"));
+
+    /* Neither cache may put "two" back after this */
+    DeviceDescriptorCache::forgetEverywhere("two");
+    TEST_CHECK(true == first.save());
+    TEST_CHECK(true == second.save());
+    TEST_CHECK(false == hasEntry("two"));
+}
+
+static double readFirstWavelength(EmulatorThread &emulator) {
+    long deviceID;
+    long spectrometerFeature;
+    int error = 0;
+    double retval = -1;
+
+    deviceID = testAttachEmulator(emulator);
+    TEST_CHECK(deviceID >= 0);
+    if(deviceID < 0) {
+        return retval;
+    }
+
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceID, &error, &spectrometerFeature, 1));
+    vector<double> wavelengths(sbapi_spectrometer_get_formatted_spectrum_length(
+            deviceID, spectrometerFeature, &error));
+    TEST_CHECK(false == wavelengths.empty());
+    if(false == wavelengths.empty()
+            && (int)wavelengths.size() == sbapi_spectrometer_get_wavelengths(deviceID,
+                spectrometerFeature, &error, &wavelengths[0], (int)wavelengths.size())) {
+        retval = wavelengths[0];
+    }
+    TEST_CHECK(0 == error);
+
+    sbapi_close_device(deviceID, &error);
+    return retval;
+}
+
+static bool cacheFileHas(const char *word) {
+    ifstream file(CACHE_PATH);
+    string line;
+
+    while(getline(file, line)) {
+        if(0 == line.compare(0, string(word).length(), word)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main() {
+    int error = 0;
+
+    removeCacheFiles();
+    testSharedFile();
+    removeCacheFiles();
+
+    sbapi_initialize();
+    TEST_CHECK(0 == sbapi_set_descriptor_cache_file(CACHE_PATH, &error));
+    TEST_CHECK(0 == error);
+
+    /* First open fills the cache; the second is served from it */
+    OBPEmulatorOptions options;
+    EmulatorThread original(options);
+    TEST_CHECK(true == original.begin());
+    TEST_CHECK(200.0 == readFirstWavelength(original));
+    TEST_CHECK(true == cacheFileHas("fingerprint"));
+    TEST_CHECK(200.0 == readFirstWavelength(original));
+    original.end();
+
+    /* The same unit after a recalibration by some other program */
+    options.firstWavelength = 300.0;
+    EmulatorThread recalibrated(options);
+    TEST_CHECK(true == recalibrated.begin());
+    TEST_CHECK(300.0 == readFirstWavelength(recalibrated));
+    recalibrated.end();
+
+    sbapi_set_descriptor_cache_file(NULL, &error);
+    sbapi_shutdown();
+    removeCacheFiles();
+    return testFinish("emulator_descriptor_cache_test");
+}
@@ -0,0 +1,164 @@
+/***************************************************//**
+ * @file    emulator_fast_buffer_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks that fast buffer records are verified one by one: a batch read
+ *  * from the emulated FlameX is damaged in two records, and only those two
+ *  * may be reported as corrupt.  Also checks that the vector checksum
+ *  * agrees with the portable one for every length and alignment.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <string.h>
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
+#include "EmulatorTestSupport.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::oceanBinaryProtocol;
+using namespace seabreeze::emulator;
+
+#define RECORDS_TO_READ         4
+#define INTEGRATION_MICROS      1000
+/* 64 bytes of metadata, 2136 16-bit pixels and the checksum */
+#define FLAMEX_RECORD_LENGTH    4340
+
+static void testChecksumKernels() {
+    vector<byte> data(FLAMEX_RECORD_LENGTH + 16);
+    unsigned int seed = 12345;
+
+    /* All ones first, which carries the most in every lane */
+    for(unsigned int i = 0; i < data.size(); i++) {
+        data[i] = 0xFF;
+    }
+    TEST_CHECK(0xFF * (unsigned int)(data.size())
+            == OBPSpectrumBatchView::computeChecksum(&data[0],
+                    (unsigned int)data.size()));
+
+    for(unsigned int i = 0; i < data.size(); i++) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (byte)(seed >> 16);
+    }
+    for(unsigned int offset = 0; offset < 16; offset++) {
+        for(unsigned int length = 0; length <= 80; length++) {
+            TEST_CHECK(OBPSpectrumBatchView::computeChecksumPortable(
+                    &data[offset], length)
+                    == OBPSpectrumBatchView::computeChecksum(
+                    &data[offset], length));
+        }
+        TEST_CHECK(OBPSpectrumBatchView::computeChecksumPortable(
+                &data[offset], FLAMEX_RECORD_LENGTH - 4)
+                == OBPSpectrumBatchView::computeChecksum(
+                &data[offset], FLAMEX_RECORD_LENGTH - 4));
+    }
+}
+
+int main() {
+    OBPEmulatorOptions options;
+    long spectrometerFeature;
+    int recordLength;
+    int error = 0;
+
+    testChecksumKernels();
+
+    options.integrationTimeMicros = INTEGRATION_MICROS;
+    EmulatorThread emulator(options);
+    TEST_CHECK(true == emulator.begin());
+
+    long deviceID = testAttachEmulator(emulator);
+    TEST_CHECK(deviceID >= 0);
+    if(deviceID < 0) {
+        return testFinish("emulator_fast_buffer_test");
+    }
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceID, &error,
+            &spectrometerFeature, 1));
+    sbapi_spectrometer_set_integration_time_micros(deviceID,
+            spectrometerFeature, &error, INTEGRATION_MICROS);
+
+    recordLength = sbapi_spectrometer_get_fast_buffer_spectrum_length(
+            deviceID, spectrometerFeature, &error);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(FLAMEX_RECORD_LENGTH == recordLength);
+    if(recordLength <= 0) {
+        return testFinish("emulator_fast_buffer_test");
+    }
+
+    /* The device may hand back fewer records than asked for */
+    vector<unsigned char> batch(RECORDS_TO_READ * recordLength);
+    int filled = 0;
+    int attempts = 0;
+    while(filled < (int)batch.size() && attempts++ < 100) {
+        int remaining = ((int)batch.size() - filled) / recordLength;
+        int length = sbapi_spectrometer_get_fast_buffer_spectrum(deviceID,
+                spectrometerFeature, &error, &batch[filled],
+                (int)batch.size() - filled, remaining);
+        TEST_CHECK(0 == error);
+        if(0 != error || length <= 0) {
+            break;
+        }
+        TEST_CHECK(0 == length % recordLength);
+        filled += length;
+    }
+    TEST_CHECK((int)batch.size() == filled);
+
+    sbapi_spectrum_metadata_t metadata[RECORDS_TO_READ];
+    unsigned char valid[RECORDS_TO_READ];
+
+    /* As sent, every record is intact */
+    TEST_CHECK(RECORDS_TO_READ == sbapi_spectrometer_decode_fast_buffer_spectra(
+            deviceID, spectrometerFeature, &error, &batch[0], filled,
+            metadata, valid, RECORDS_TO_READ));
+    for(int i = 0; i < RECORDS_TO_READ; i++) {
+        TEST_CHECK(1 == valid[i]);
+    }
+
+    /* A flipped bit in one pixel of record 1, and a wrong stored sum in
+     * record 3.  Records 0 and 2 are left alone.
+     */
+    batch[1 * recordLength + 64 + 2 * 1000] ^= 0x04;
+    batch[3 * recordLength + recordLength - 4] ^= 0x01;
+    memset(valid, 0xAA, sizeof(valid));
+    TEST_CHECK(RECORDS_TO_READ == sbapi_spectrometer_decode_fast_buffer_spectra(
+            deviceID, spectrometerFeature, &error, &batch[0], filled,
+            metadata, valid, RECORDS_TO_READ));
+    TEST_CHECK(0 == error);
+    TEST_CHECK(1 == valid[0]);
+    TEST_CHECK(0 == valid[1]);
+    TEST_CHECK(1 == valid[2]);
+    TEST_CHECK(0 == valid[3]);
+
+    /* The metadata is still decoded, so the caller knows which were lost */
+    for(int i = 1; i < RECORDS_TO_READ; i++) {
+        TEST_CHECK(metadata[i].spectrum_count > metadata[i - 1].spectrum_count);
+    }
+
+    sbapi_close_device(deviceID, &error);
+    sbapi_shutdown();
+    emulator.end();
+    return testFinish("emulator_fast_buffer_test");
+}
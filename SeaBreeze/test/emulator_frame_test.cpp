@@ -0,0 +1,130 @@
+/***************************************************//**
+ * @file    emulator_frame_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks that a whole frame is gathered in one call, including on
+ * firmware that will not take overlapped queries.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <string.h>
+#include <time.h>
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "EmulatorTestSupport.h"
+
+using namespace std;
+using namespace seabreeze::emulator;
+
+/* Well short of what waiting out every dropped query would take */
+#define MAXIMUM_SECONDS 30
+
+static void checkFrame(long deviceID, long spectrometerFeature,
+        const OBPEmulatorOptions &options) {
+    vector<double> spectrum(options.numberOfPixels);
+    vector<double> wavelengths(options.numberOfPixels);
+    double temperatures[8];
+    sbapi_frame_t frame;
+    int error = 0;
+    int itemsRead;
+
+    memset(&frame, 0, sizeof(frame));
+    /* FlameX spectra carry no metadata, so the integration time is the
+     * one that was last set.
+     */
+    frame.items = SBAPI_FRAME_SPECTRUM | SBAPI_FRAME_WAVELENGTHS
+            | SBAPI_FRAME_INTEGRATION_TIME | SBAPI_FRAME_TEMPERATURES;
+    frame.spectrum = &spectrum[0];
+    frame.spectrum_length = (int)spectrum.size();
+    frame.wavelengths = &wavelengths[0];
+    frame.wavelengths_length = (int)wavelengths.size();
+    frame.temperatures = temperatures;
+    frame.temperatures_length = 8;
+
+    itemsRead = sbapi_spectrometer_acquire_frame(deviceID, spectrometerFeature,
+            &error, &frame);
+    TEST_CHECK(ERROR_SUCCESS == error);
+    TEST_CHECK((int)frame.items_read == itemsRead);
+    TEST_CHECK(frame.items == frame.items_read);
+    TEST_CHECK((int)options.numberOfPixels == frame.pixels);
+    TEST_CHECK((int)options.numberOfPixels == frame.wavelength_count);
+    TEST_CHECK(200.0 == wavelengths[0]);
+    TEST_CHECK(2000 == frame.integration_time_micros);
+
+    /* The emulator reports 25, 26 and 27 degrees */
+    TEST_CHECK(3 == frame.temperature_count);
+    TEST_CHECK(25.0 == temperatures[0]);
+    TEST_CHECK(27.0 == temperatures[2]);
+
+    /* A FlameX has no TEC.  That is reported, but the rest still arrives. */
+    memset(temperatures, 0, sizeof(temperatures));
+    frame.items = SBAPI_FRAME_TEMPERATURES | SBAPI_FRAME_TEC_TEMPERATURE;
+    itemsRead = sbapi_spectrometer_acquire_frame(deviceID, spectrometerFeature,
+            &error, &frame);
+    TEST_CHECK(ERROR_FEATURE_NOT_FOUND == error);
+    TEST_CHECK(SBAPI_FRAME_TEMPERATURES == itemsRead);
+    TEST_CHECK(3 == frame.temperature_count);
+    TEST_CHECK(26.0 == temperatures[1]);
+}
+
+int main() {
+    OBPEmulatorOptions options;
+    long deviceID;
+    long spectrometerFeature;
+    int error = 0;
+    time_t started;
+
+    /* Queries that overlap go unanswered, so the frame must still come
+     * back if the batch has to fall back to one query at a time.
+     */
+    options.dropOverlappedMillis = 20;
+    EmulatorThread emulator(options);
+    TEST_CHECK(true == emulator.begin());
+
+    started = time(NULL);
+    deviceID = testAttachEmulator(emulator);
+    TEST_CHECK(deviceID >= 0);
+    if(deviceID < 0) {
+        return testFinish("emulator_frame_test");
+    }
+
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceID, &error,
+            &spectrometerFeature, 1));
+    sbapi_spectrometer_set_integration_time_micros(deviceID,
+            spectrometerFeature, &error, 2000);
+    TEST_CHECK(0 == error);
+
+    checkFrame(deviceID, spectrometerFeature, options);
+    TEST_CHECK(time(NULL) - started < MAXIMUM_SECONDS);
+
+    sbapi_close_device(deviceID, &error);
+    TEST_CHECK(0 == error);
+
+    sbapi_shutdown();
+    emulator.end();
+    return testFinish("emulator_frame_test");
+}
@@ -0,0 +1,172 @@
+/***************************************************//**
+ * @file    emulator_hot_plug_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Plugs an emulated FlameX into the fake USB bus and unplugs it
+ * again, reporting each change through a synthetic hot-plug
+ * source, and checks that the device list and the callbacks
+ * follow.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "native/system/ConditionVariable.h"
+#include "native/system/Mutex.h"
+#include "native/usb/SyntheticUSBHotPlugEventSource.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBInterface.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBProductID.h"
+#include "EmulatorTestSupport.h"
+#include "FakeNativeUSB.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+#define EVENT_TIMEOUT_MILLIS    5000
+#define QUIET_PERIOD_MILLIS     300
+#define MAX_DEVICES             16
+
+struct HotPlugRecord {
+    long deviceID;
+    int event;
+};
+
+static Mutex recordLock;
+static ConditionVariable recordArrived;
+static vector<HotPlugRecord> records;
+
+static void hotPlugCallback(long deviceID, int event, void *userData) {
+    MutexLock guard(recordLock);
+    HotPlugRecord record;
+
+    record.deviceID = deviceID;
+    record.event = event;
+    records.push_back(record);
+    recordArrived.broadcast();
+}
+
+/* Waits for the next callback.  Returns false if none came in time. */
+static bool nextRecord(HotPlugRecord &record, int timeoutMillis) {
+    MutexLock guard(recordLock);
+
+    if(records.empty()) {
+        recordArrived.wait(recordLock, timeoutMillis);
+    }
+    if(records.empty()) {
+        return false;
+    }
+    record = records.front();
+    records.erase(records.begin());
+    return true;
+}
+
+static bool isListed(long deviceID) {
+    long ids[MAX_DEVICES];
+    int count = sbapi_get_device_ids(ids, MAX_DEVICES);
+
+    for(int i = 0; i < count; i++) {
+        if(ids[i] == deviceID) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void injectEvent(SyntheticUSBHotPlugEventSource *source,
+        USBHotPlugEvent::Action action, unsigned short productID) {
+    USBHotPlugEvent event;
+
+    event.action = action;
+    event.vendorID = OCEAN_OPTICS_USB_VID;
+    event.productID = productID;
+    source->inject(event);
+}
+
+int main() {
+    OBPEmulatorOptions options;
+    SyntheticUSBHotPlugEventSource *source = new SyntheticUSBHotPlugEventSource();
+    SeaBreezeAPI *api;
+    HotPlugRecord record;
+    unsigned long nativeID;
+    long spectrometerFeature;
+    int probes;
+    int error = 0;
+
+    api = SeaBreezeAPI::getInstance();
+    TEST_CHECK(0 == api->enableHotPlug(source, hotPlugCallback, NULL, &error));
+
+    /* Plugging in calls back with the new ID, which is then usable */
+    nativeID = fakeUSBAddEmulatedDevice(options);
+    injectEvent(source, USBHotPlugEvent::DEVICE_ADDED, FLAMEX_USB_PID);
+    TEST_CHECK(true == nextRecord(record, EVENT_TIMEOUT_MILLIS));
+    TEST_CHECK(SBAPI_DEVICE_ADDED == record.event);
+    long deviceID = record.deviceID;
+    TEST_CHECK(true == isListed(deviceID));
+
+    TEST_CHECK(0 == sbapi_open_device(deviceID, &error));
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceID, &error,
+            &spectrometerFeature, 1));
+    vector<double> spectrum(options.numberOfPixels);
+    TEST_CHECK((int)options.numberOfPixels == sbapi_spectrometer_get_formatted_spectrum(
+            deviceID, spectrometerFeature, &error, &spectrum[0], (int)spectrum.size()));
+    TEST_CHECK(0 == error);
+
+    /* An event that changes nothing makes no callback */
+    injectEvent(source, USBHotPlugEvent::DEVICE_ADDED, FLAMEX_USB_PID);
+    TEST_CHECK(false == nextRecord(record, QUIET_PERIOD_MILLIS));
+    sbapi_probe_devices();
+    TEST_CHECK(true == isListed(deviceID));
+
+    /* Events for devices that SeaBreeze does not support do not rescan */
+    probes = fakeUSBGetCounts().probes;
+    injectEvent(source, USBHotPlugEvent::DEVICE_ADDED, 0x7fff);
+    TEST_CHECK(false == nextRecord(record, QUIET_PERIOD_MILLIS));
+    TEST_CHECK(probes == fakeUSBGetCounts().probes);
+
+    /* Unplugging an open device calls back and makes its ID stale */
+    fakeUSBRemoveDevice(nativeID);
+    injectEvent(source, USBHotPlugEvent::DEVICE_REMOVED, FLAMEX_USB_PID);
+    TEST_CHECK(true == nextRecord(record, EVENT_TIMEOUT_MILLIS));
+    TEST_CHECK(SBAPI_DEVICE_REMOVED == record.event);
+    TEST_CHECK(deviceID == record.deviceID);
+    TEST_CHECK(false == isListed(deviceID));
+
+    sbapi_spectrometer_get_formatted_spectrum(deviceID, spectrometerFeature,
+            &error, &spectrum[0], (int)spectrum.size());
+    TEST_CHECK(ERROR_NO_DEVICE == error);
+
+    /* Nothing is left to remove */
+    injectEvent(source, USBHotPlugEvent::DEVICE_REMOVED, FLAMEX_USB_PID);
+    TEST_CHECK(false == nextRecord(record, QUIET_PERIOD_MILLIS));
+
+    /* The monitor owns the source and deletes it */
+    api->disableHotPlug(&error);
+    sbapi_shutdown();
+    return testFinish("emulator_hot_plug_test");
+}
@@ -0,0 +1,210 @@
+/***************************************************//**
+ * @file    emulator_prefetch_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks that prefetched spectra survive several threads sharing a
+ * spectrometer, and that a spectrum started before a settings change is
+ * never returned after it.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "native/system/Thread.h"
+#include "EmulatorTestSupport.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+#define READER_THREADS          3
+#define SPECTRA_PER_THREAD      40
+#define MEDDLER_ROUNDS          40
+#define SETTING_CHANGES         20
+#define SHORT_INTEGRATION       1000
+#define LONG_INTEGRATION        20000
+
+/* The emulator's strongest line sits at 52% of the detector and gains 45
+ * counts per millisecond over a dark level near 1530, so this separates
+ * the two integration times by hundreds of counts either way.
+ */
+#define LONG_PEAK_THRESHOLD     2000
+
+static double peakNear(const vector<double> &spectrum) {
+    unsigned int center = (unsigned int)(0.52 * spectrum.size());
+    double peak = 0;
+
+    for(unsigned int i = center - 8; i <= center + 8; i++) {
+        if(spectrum[i] > peak) {
+            peak = spectrum[i];
+        }
+    }
+    return peak;
+}
+
+/* Reads spectra while others are using the same spectrometer */
+class SpectrumReader : public Thread {
+public:
+    SpectrumReader(long deviceID, long featureID, int pixels)
+        : deviceID(deviceID), featureID(featureID), pixels(pixels),
+          completed(0), failures(0) { }
+
+    long deviceID;
+    long featureID;
+    int pixels;
+    int completed;
+    int failures;
+
+protected:
+    virtual void run() {
+        vector<double> spectrum(this->pixels);
+        int error = 0;
+
+        for(int i = 0; i < SPECTRA_PER_THREAD; i++) {
+            int length = sbapi_spectrometer_get_formatted_spectrum(
+                    this->deviceID, this->featureID, &error,
+                    &spectrum[0], (int)spectrum.size());
+            if(0 != error || length != this->pixels) {
+                this->failures++;
+            }
+            this->completed++;
+        }
+    }
+};
+
+/* Uses the rest of the device, and turns prefetching off and on, in
+ * between the readers' spectra
+ */
+class Meddler : public Thread {
+public:
+    Meddler(long deviceID, long spectrometerFeature, long serialFeature)
+        : deviceID(deviceID), spectrometerFeature(spectrometerFeature),
+          serialFeature(serialFeature), failures(0) { }
+
+    long deviceID;
+    long spectrometerFeature;
+    long serialFeature;
+    int failures;
+
+protected:
+    virtual void run() {
+        char serial[32];
+        int error = 0;
+
+        for(int i = 0; i < MEDDLER_ROUNDS; i++) {
+            sbapi_get_serial_number(this->deviceID, this->serialFeature,
+                    &error, serial, sizeof(serial) - 1);
+            if(0 != error) {
+                this->failures++;
+            }
+            sbapi_spectrometer_set_prefetch_enable(this->deviceID,
+                    this->spectrometerFeature, &error, (0 == i % 4) ? 0 : 1);
+            if(0 != error) {
+                this->failures++;
+            }
+        }
+        sbapi_spectrometer_set_prefetch_enable(this->deviceID,
+                this->spectrometerFeature, &error, 1);
+    }
+};
+
+int main() {
+    OBPEmulatorOptions options;
+    long spectrometerFeature;
+    long serialFeature;
+    int error = 0;
+    int i;
+
+    EmulatorThread emulator(options);
+    TEST_CHECK(true == emulator.begin());
+
+    long deviceID = testAttachEmulator(emulator);
+    TEST_CHECK(deviceID >= 0);
+    if(deviceID < 0) {
+        return testFinish("emulator_prefetch_test");
+    }
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceID, &error,
+            &spectrometerFeature, 1));
+    TEST_CHECK(1 == sbapi_get_serial_number_features(deviceID, &error,
+            &serialFeature, 1));
+    sbapi_spectrometer_set_integration_time_micros(deviceID,
+            spectrometerFeature, &error, SHORT_INTEGRATION);
+    sbapi_spectrometer_set_prefetch_enable(deviceID, spectrometerFeature,
+            &error, 1);
+    TEST_CHECK(0 == error);
+
+    /* Readers share the spectrum in flight with each other and with calls
+     * that have to throw it away first.
+     */
+    vector<SpectrumReader *> readers;
+    for(i = 0; i < READER_THREADS; i++) {
+        readers.push_back(new SpectrumReader(deviceID, spectrometerFeature,
+                options.numberOfPixels));
+    }
+    Meddler meddler(deviceID, spectrometerFeature, serialFeature);
+    for(i = 0; i < READER_THREADS; i++) {
+        TEST_CHECK(true == readers[i]->start());
+    }
+    TEST_CHECK(true == meddler.start());
+    for(i = 0; i < READER_THREADS; i++) {
+        readers[i]->join();
+        TEST_CHECK(0 == readers[i]->failures);
+        TEST_CHECK(SPECTRA_PER_THREAD == readers[i]->completed);
+        delete readers[i];
+    }
+    meddler.join();
+    TEST_CHECK(0 == meddler.failures);
+
+    /* Each spectrum after a change of integration time must have been
+     * taken with the new one, not be the one that was already prefetched.
+     */
+    vector<double> spectrum(options.numberOfPixels);
+    for(i = 0; i < SETTING_CHANGES; i++) {
+        bool longer = (0 == i % 2);
+        sbapi_spectrometer_get_formatted_spectrum(deviceID, spectrometerFeature,
+                &error, &spectrum[0], (int)spectrum.size());
+        TEST_CHECK(0 == error);
+        sbapi_spectrometer_set_integration_time_micros(deviceID,
+                spectrometerFeature, &error,
+                (true == longer) ? LONG_INTEGRATION : SHORT_INTEGRATION);
+        TEST_CHECK(0 == error);
+        sbapi_spectrometer_get_formatted_spectrum(deviceID, spectrometerFeature,
+                &error, &spectrum[0], (int)spectrum.size());
+        TEST_CHECK(0 == error);
+        TEST_CHECK(longer == (peakNear(spectrum) > LONG_PEAK_THRESHOLD));
+    }
+
+    /* Closing the device with a spectrum in flight */
+    sbapi_spectrometer_get_formatted_spectrum(deviceID, spectrometerFeature,
+            &error, &spectrum[0], (int)spectrum.size());
+    sbapi_close_device(deviceID, &error);
+    TEST_CHECK(0 == error);
+
+    sbapi_shutdown();
+    emulator.end();
+    return testFinish("emulator_prefetch_test");
+}
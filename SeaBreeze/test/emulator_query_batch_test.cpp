@@ -0,0 +1,119 @@
+/***************************************************//**
+ * @file    emulator_query_batch_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks that a batch of OBP queries still completes, and
+ * gets the right answers, when the device drops every query that
+ * arrives while another is outstanding.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <math.h>
+#include <time.h>
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "native/system/System.h"
+#include "EmulatorTestSupport.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+/* Generous, but far short of what an unbounded wait would take */
+#define MAXIMUM_SECONDS 30
+/* Less than the time a batch waits for a dropped pipelined reply */
+#define SERIAL_BATCH_MICROS 900000
+
+int main() {
+    OBPEmulatorOptions options;
+    long deviceID;
+    long spectrometerFeature;
+    long nonlinearityFeature;
+    int error = 0;
+    int length;
+    time_t started;
+    unsigned long long before;
+    double expected;
+
+    options.dropOverlappedMillis = 20;
+    EmulatorThread emulator(options);
+    TEST_CHECK(true == emulator.begin());
+
+    started = time(NULL);
+    deviceID = testAttachEmulator(emulator);
+    TEST_CHECK(deviceID >= 0);
+    if(deviceID < 0) {
+        return testFinish("emulator_query_batch_test");
+    }
+
+    /* The wavelength coefficients are read as one batch.  The emulator
+     * spreads 200-1000 nm over the detector with a small curvature.
+     */
+    expected = 200.0 + 1000.0 * 800.0 / options.numberOfPixels - 1.0e-6 * 1000.0 * 1000.0;
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceID, &error, &spectrometerFeature, 1));
+    vector<double> wavelengths(options.numberOfPixels);
+    length = sbapi_spectrometer_get_wavelengths(deviceID, spectrometerFeature,
+            &error, &wavelengths[0], (int)wavelengths.size());
+    TEST_CHECK(0 == error);
+    TEST_CHECK((int)options.numberOfPixels == length);
+    TEST_CHECK(200.0 == wavelengths[0]);
+    TEST_CHECK(fabs(wavelengths[1000] - expected) < 1e-3);
+
+    /* A second batch must not trip over late replies from the first */
+    TEST_CHECK(1 == sbapi_get_nonlinearity_coeffs_features(deviceID, &error,
+            &nonlinearityFeature, 1));
+    double coeffs[8];
+    length = sbapi_nonlinearity_coeffs_get(deviceID, nonlinearityFeature,
+            &error, coeffs, 8);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(8 == length);
+    TEST_CHECK(1.0 == coeffs[0]);
+    TEST_CHECK(0.0 == coeffs[7]);
+
+    TEST_CHECK(time(NULL) - started < MAXIMUM_SECONDS);
+
+    /* Closing drops the cached coefficients but not the knowledge that
+     * this device cannot take pipelined queries, so reading them again
+     * goes straight to one query at a time without waiting out a
+     * dropped reply first.
+     */
+    sbapi_close_device(deviceID, &error);
+    TEST_CHECK(0 == sbapi_open_device(deviceID, &error));
+    before = System::getMonotonicMicros();
+    length = sbapi_nonlinearity_coeffs_get(deviceID, nonlinearityFeature,
+            &error, coeffs, 8);
+    TEST_CHECK(System::getMonotonicMicros() - before < SERIAL_BATCH_MICROS);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(8 == length);
+    TEST_CHECK(1.0 == coeffs[0]);
+
+    sbapi_close_device(deviceID, &error);
+    TEST_CHECK(0 == error);
+
+    sbapi_shutdown();
+    emulator.end();
+    return testFinish("emulator_query_batch_test");
+}
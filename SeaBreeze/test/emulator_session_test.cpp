@@ -0,0 +1,163 @@
+/***************************************************//**
+ * @file    emulator_session_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks that spectrometer sessions can be used from several threads,
+ * and that closing one neither waits for a call in progress nor leaves
+ * the session behind.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "native/system/NativeSystem.h"
+#include "native/system/Thread.h"
+#include "EmulatorTestSupport.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+#define SESSION_CYCLES          200
+#define SPECTRA_PER_THREAD      20
+#define INTEGRATION_MICROS      2000
+
+/* Acquires through one session count times, or until it is closed */
+class SessionReader : public Thread {
+public:
+    SessionReader(long sessionID, int pixels, int count)
+        : sessionID(sessionID), pixels(pixels), count(count),
+          completed(0), failures(0), lastError(0) { }
+
+    long sessionID;
+    int pixels;
+    int count;
+    /* Read by the main thread while this one runs */
+    volatile unsigned int completed;
+    int failures;
+    int lastError;
+
+protected:
+    virtual void run() {
+        vector<double> spectrum(this->pixels);
+        int error = 0;
+
+        for(int i = 0; i < this->count; i++) {
+            int length = sbapi_spectrometer_session_get_formatted_spectrum(
+                    this->sessionID, &error, &spectrum[0], (int)spectrum.size());
+            this->lastError = error;
+            if(ERROR_INPUT_OUT_OF_BOUNDS == error) {
+                return;
+            }
+            if(0 != error || length != this->pixels) {
+                this->failures++;
+            }
+            atomicStore(&this->completed, atomicLoad(&this->completed) + 1);
+        }
+    }
+};
+
+static void closeSession(long sessionID, int *errorCode) {
+    sbapi_spectrometer_close_session(sessionID, errorCode);
+}
+
+int main() {
+    AcquisitionGate gate;
+    OBPEmulatorOptions options;
+    long spectrometerFeature;
+    long sessionID;
+    long previousID = 0;
+    int error = 0;
+    int i;
+
+    options.listener = &gate;
+    EmulatorThread emulator(options);
+    TEST_CHECK(true == emulator.begin());
+
+    long deviceID = testAttachEmulator(emulator);
+    TEST_CHECK(deviceID >= 0);
+    if(deviceID < 0) {
+        return testFinish("emulator_session_test");
+    }
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceID, &error,
+            &spectrometerFeature, 1));
+    sbapi_spectrometer_set_integration_time_micros(deviceID,
+            spectrometerFeature, &error, INTEGRATION_MICROS);
+    vector<double> spectrum(options.numberOfPixels);
+
+    /* Closed sessions are gone for good, and their IDs are not reused */
+    for(i = 0; i < SESSION_CYCLES; i++) {
+        sessionID = sbapi_spectrometer_open_session(deviceID,
+                spectrometerFeature, &error);
+        TEST_CHECK(sessionID > previousID);
+        previousID = sessionID;
+        sbapi_spectrometer_close_session(sessionID, &error);
+        TEST_CHECK(0 == error);
+    }
+    sbapi_spectrometer_session_get_formatted_spectrum(previousID, &error,
+            &spectrum[0], (int)spectrum.size());
+    TEST_CHECK(ERROR_INPUT_OUT_OF_BOUNDS == error);
+    sbapi_spectrometer_close_session(previousID, &error);
+    TEST_CHECK(ERROR_INPUT_OUT_OF_BOUNDS == error);
+
+    /* Two threads sharing one session take turns on the device */
+    sessionID = sbapi_spectrometer_open_session(deviceID, spectrometerFeature,
+            &error);
+    TEST_CHECK(sessionID > previousID);
+    SessionReader first(sessionID, options.numberOfPixels, SPECTRA_PER_THREAD);
+    SessionReader second(sessionID, options.numberOfPixels, SPECTRA_PER_THREAD);
+    TEST_CHECK(true == first.start());
+    TEST_CHECK(true == second.start());
+    first.join();
+    second.join();
+    TEST_CHECK(0 == first.failures && SPECTRA_PER_THREAD == atomicLoad(&first.completed));
+    TEST_CHECK(0 == second.failures && SPECTRA_PER_THREAD == atomicLoad(&second.completed));
+
+    /* Closing a session while an acquisition through it is held in the
+     * emulator returns without waiting for it.  That acquisition still
+     * completes, and the next call is refused.
+     */
+    SessionReader slow(sessionID, options.numberOfPixels, 2);
+    TEST_CHECK(true == testReturnsWhileAcquiring(gate, slow, closeSession,
+            sessionID, &error));
+    TEST_CHECK(0 == error);
+    slow.join();
+    TEST_CHECK(1 == atomicLoad(&slow.completed));
+    TEST_CHECK(0 == slow.failures);
+    TEST_CHECK(ERROR_INPUT_OUT_OF_BOUNDS == slow.lastError);
+
+    /* The device is still usable once its last session is gone */
+    sbapi_spectrometer_set_integration_time_micros(deviceID,
+            spectrometerFeature, &error, INTEGRATION_MICROS);
+    TEST_CHECK(0 == error);
+    sbapi_close_device(deviceID, &error);
+    TEST_CHECK(0 == error);
+
+    sbapi_shutdown();
+    emulator.end();
+    return testFinish("emulator_session_test");
+}
@@ -0,0 +1,209 @@
+/***************************************************//**
+ * @file    emulator_settings_shadow_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Counts the configuration messages that reach the emulator to check that
+ *  * remembered settings skip the bus only when the device is known to hold
+ *  * the value: after a failed write, and after a resync, the next write
+ *  * must go out again.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <map>
+#include <set>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "native/system/Mutex.h"
+#include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
+#include "EmulatorTestSupport.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+using namespace seabreeze::oceanBinaryProtocol;
+
+#define TRIGGER_MODE_NORMAL         0
+#define TRIGGER_MODE_LEVEL          1
+/* No spectrometer has this many trigger modes */
+#define TRIGGER_MODE_UNSUPPORTED    99
+
+/* Counts each message type that arrives, and refuses the chosen ones */
+class MessageCounter : public OBPEmulatorListener {
+public:
+    virtual bool messageReceived(unsigned int messageType) {
+        MutexLock guard(this->lock);
+        this->counts[messageType]++;
+        return this->refused.end() == this->refused.find(messageType);
+    }
+
+    unsigned int getCount(unsigned int messageType) {
+        MutexLock guard(this->lock);
+        return this->counts[messageType];
+    }
+
+    void setRefused(unsigned int messageType, bool refuse) {
+        MutexLock guard(this->lock);
+        if(true == refuse) {
+            this->refused.insert(messageType);
+        } else {
+            this->refused.erase(messageType);
+        }
+    }
+
+private:
+    Mutex lock;
+    map<unsigned int, unsigned int> counts;
+    set<unsigned int> refused;
+};
+
+static void testIntegrationTime(MessageCounter &counter, long deviceID,
+        long featureID) {
+    const unsigned int message = OBPMessageTypes::OBP_SET_ITIME_USEC;
+    unsigned int sent = counter.getCount(message);
+    int error = 0;
+
+    /* An unchanged write skips the bus */
+    sbapi_spectrometer_set_integration_time_micros(deviceID, featureID,
+            &error, 5000);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(++sent == counter.getCount(message));
+    sbapi_spectrometer_set_integration_time_micros(deviceID, featureID,
+            &error, 5000);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(sent == counter.getCount(message));
+
+    /* A refused write reaches the device and fails, so the old value is
+     * no longer trusted and writing it again goes out.
+     */
+    counter.setRefused(message, true);
+    sbapi_spectrometer_set_integration_time_micros(deviceID, featureID,
+            &error, 7000);
+    TEST_CHECK(0 != error);
+    TEST_CHECK(++sent == counter.getCount(message));
+    counter.setRefused(message, false);
+    sbapi_spectrometer_set_integration_time_micros(deviceID, featureID,
+            &error, 5000);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(++sent == counter.getCount(message));
+    sbapi_spectrometer_set_integration_time_micros(deviceID, featureID,
+            &error, 5000);
+    TEST_CHECK(sent == counter.getCount(message));
+}
+
+static void testTriggerMode(MessageCounter &counter, long deviceID,
+        long featureID) {
+    const unsigned int message = OBPMessageTypes::OBP_SET_TRIG_MODE;
+    unsigned int sent = counter.getCount(message);
+    int error = 0;
+
+    sbapi_spectrometer_set_trigger_mode(deviceID, featureID, &error,
+            TRIGGER_MODE_NORMAL);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(++sent == counter.getCount(message));
+    sbapi_spectrometer_set_trigger_mode(deviceID, featureID, &error,
+            TRIGGER_MODE_NORMAL);
+    TEST_CHECK(sent == counter.getCount(message));
+
+    /* A mode the spectrometer does not have is refused without a
+     * transfer, so the remembered mode still stands.
+     */
+    sbapi_spectrometer_set_trigger_mode(deviceID, featureID, &error,
+            TRIGGER_MODE_UNSUPPORTED);
+    TEST_CHECK(ERROR_INVALID_TRIGGER_MODE == error);
+    TEST_CHECK(sent == counter.getCount(message));
+    sbapi_spectrometer_set_trigger_mode(deviceID, featureID, &error,
+            TRIGGER_MODE_NORMAL);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(sent == counter.getCount(message));
+
+    /* A supported mode that the device fails to take is forgotten */
+    counter.setRefused(message, true);
+    sbapi_spectrometer_set_trigger_mode(deviceID, featureID, &error,
+            TRIGGER_MODE_LEVEL);
+    TEST_CHECK(0 != error);
+    TEST_CHECK(++sent == counter.getCount(message));
+    counter.setRefused(message, false);
+    sbapi_spectrometer_set_trigger_mode(deviceID, featureID, &error,
+            TRIGGER_MODE_NORMAL);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(++sent == counter.getCount(message));
+}
+
+static void testResync(MessageCounter &counter, long deviceID,
+        long featureID) {
+    unsigned int times = counter.getCount(OBPMessageTypes::OBP_SET_ITIME_USEC);
+    unsigned int modes = counter.getCount(OBPMessageTypes::OBP_SET_TRIG_MODE);
+    int error = 0;
+
+    /* Both values are already known, so only a resync sends them again */
+    sbapi_spectrometer_set_integration_time_micros(deviceID, featureID,
+            &error, 5000);
+    sbapi_spectrometer_set_trigger_mode(deviceID, featureID, &error,
+            TRIGGER_MODE_NORMAL);
+    TEST_CHECK(times == counter.getCount(OBPMessageTypes::OBP_SET_ITIME_USEC));
+    TEST_CHECK(modes == counter.getCount(OBPMessageTypes::OBP_SET_TRIG_MODE));
+
+    sbapi_resync_device_settings(deviceID, &error);
+    TEST_CHECK(0 == error);
+    sbapi_spectrometer_set_integration_time_micros(deviceID, featureID,
+            &error, 5000);
+    TEST_CHECK(0 == error);
+    sbapi_spectrometer_set_trigger_mode(deviceID, featureID, &error,
+            TRIGGER_MODE_NORMAL);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(times + 1 == counter.getCount(OBPMessageTypes::OBP_SET_ITIME_USEC));
+    TEST_CHECK(modes + 1 == counter.getCount(OBPMessageTypes::OBP_SET_TRIG_MODE));
+}
+
+int main() {
+    MessageCounter counter;
+    OBPEmulatorOptions options;
+    long spectrometerFeature;
+    int error = 0;
+
+    options.listener = &counter;
+    EmulatorThread emulator(options);
+    TEST_CHECK(true == emulator.begin());
+
+    long deviceID = testAttachEmulator(emulator);
+    TEST_CHECK(deviceID >= 0);
+    if(deviceID < 0) {
+        return testFinish("emulator_settings_shadow_test");
+    }
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceID, &error,
+            &spectrometerFeature, 1));
+
+    testIntegrationTime(counter, deviceID, spectrometerFeature);
+    testTriggerMode(counter, deviceID, spectrometerFeature);
+    testResync(counter, deviceID, spectrometerFeature);
+
+    sbapi_close_device(deviceID, &error);
+    TEST_CHECK(0 == error);
+
+    sbapi_shutdown();
+    emulator.end();
+    return testFinish("emulator_settings_shadow_test");
+}
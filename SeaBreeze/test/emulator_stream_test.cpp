@@ -0,0 +1,232 @@
+/***************************************************//**
+ * @file    emulator_stream_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks that a fast buffer stream can be drained by one thread while
+ * others query it, and that calls that need the device wait for the
+ * stream to stop rather than interleaving with it.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <string.h>
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "native/system/NativeSystem.h"
+#include "native/system/System.h"
+#include "native/system/Thread.h"
+#include "EmulatorTestSupport.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+#define STREAM_CAPACITY         64
+#define SPECTRA_TO_READ         300
+#define INTEGRATION_MICROS      1000
+#define MAXIMUM_MILLIS          20000
+
+/* The only consumer of the stream, as the API requires */
+class StreamReader : public Thread {
+public:
+    StreamReader(long deviceID, long featureID, int recordLength)
+        : deviceID(deviceID), featureID(featureID),
+          recordLength(recordLength), spectra(0), corrupt(0),
+          outOfOrder(0), failures(0) { }
+
+    long deviceID;
+    long featureID;
+    int recordLength;
+    int spectra;
+    int corrupt;
+    int outOfOrder;
+    int failures;
+
+protected:
+    virtual void run() {
+        vector<unsigned char> buffer(8 * this->recordLength);
+        sbapi_spectrum_metadata_t metadata[8];
+        unsigned char valid[8];
+        unsigned long long deadline = System::getMonotonicMicros()
+                + MAXIMUM_MILLIS * 1000ULL;
+        long long lastCount = -1;
+        int error = 0;
+
+        while(this->spectra < SPECTRA_TO_READ
+                && System::getMonotonicMicros() < deadline) {
+            int length = sbapi_spectrometer_read_fast_buffer_stream(
+                    this->deviceID, this->featureID, &error,
+                    &buffer[0], (int)buffer.size());
+            if(0 != error) {
+                this->failures++;
+                return;
+            }
+            if(0 == length) {
+                System::sleepMilliseconds(1);
+                continue;
+            }
+            if(0 != length % this->recordLength) {
+                this->failures++;
+            }
+            int count = sbapi_spectrometer_decode_fast_buffer_spectra(
+                    this->deviceID, this->featureID, &error, &buffer[0],
+                    length, metadata, valid, 8);
+            for(int i = 0; i < count; i++) {
+                if(0 == valid[i]) {
+                    this->corrupt++;
+                }
+                /* Spectra may be dropped, but never repeated or reordered */
+                if((long long)metadata[i].spectrum_count <= lastCount) {
+                    this->outOfOrder++;
+                }
+                lastCount = metadata[i].spectrum_count;
+            }
+            this->spectra += count;
+        }
+    }
+};
+
+/* Polls the overrun count, which may be read while the stream runs */
+class OverrunPoller : public Thread {
+public:
+    OverrunPoller(long deviceID, long featureID)
+        : deviceID(deviceID), featureID(featureID), stopping(0),
+          polls(0), failures(0) { }
+
+    long deviceID;
+    long featureID;
+    volatile unsigned int stopping;
+    int polls;
+    int failures;
+
+protected:
+    virtual void run() {
+        int error = 0;
+
+        while(0 == atomicLoad(&this->stopping)) {
+            sbapi_spectrometer_get_fast_buffer_stream_overruns(this->deviceID,
+                    this->featureID, &error);
+            if(0 != error) {
+                this->failures++;
+            }
+            this->polls++;
+            System::sleepMilliseconds(1);
+        }
+    }
+};
+
+/* Makes an ordinary call, which gets the device between the stream's rounds */
+class SerialNumberReader : public Thread {
+public:
+    SerialNumberReader(long deviceID, long featureID)
+        : deviceID(deviceID), featureID(featureID), error(-1) { }
+
+    long deviceID;
+    long featureID;
+    int error;
+    char serial[32];
+
+protected:
+    virtual void run() {
+        memset(this->serial, 0, sizeof(this->serial));
+        sbapi_get_serial_number(this->deviceID, this->featureID, &this->error,
+                this->serial, sizeof(this->serial) - 1);
+    }
+};
+
+int main() {
+    OBPEmulatorOptions options;
+    long spectrometerFeature;
+    long serialFeature;
+    int recordLength;
+    int error = 0;
+
+    options.integrationTimeMicros = INTEGRATION_MICROS;
+    EmulatorThread emulator(options);
+    TEST_CHECK(true == emulator.begin());
+
+    long deviceID = testAttachEmulator(emulator);
+    TEST_CHECK(deviceID >= 0);
+    if(deviceID < 0) {
+        return testFinish("emulator_stream_test");
+    }
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceID, &error,
+            &spectrometerFeature, 1));
+    TEST_CHECK(1 == sbapi_get_serial_number_features(deviceID, &error,
+            &serialFeature, 1));
+    sbapi_spectrometer_set_integration_time_micros(deviceID,
+            spectrometerFeature, &error, INTEGRATION_MICROS);
+
+    recordLength = sbapi_spectrometer_start_fast_buffer_stream(deviceID,
+            spectrometerFeature, &error, STREAM_CAPACITY);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(recordLength == sbapi_spectrometer_get_fast_buffer_spectrum_length(
+            deviceID, spectrometerFeature, &error));
+    if(recordLength <= 0) {
+        return testFinish("emulator_stream_test");
+    }
+
+    StreamReader reader(deviceID, spectrometerFeature, recordLength);
+    OverrunPoller poller(deviceID, spectrometerFeature);
+    SerialNumberReader interleaved(deviceID, serialFeature);
+    TEST_CHECK(true == reader.start());
+    TEST_CHECK(true == poller.start());
+
+    /* The serial number is read without stopping the stream, and the
+     * spectra after it must still arrive intact and in order.
+     */
+    TEST_CHECK(true == interleaved.start());
+    interleaved.join();
+    TEST_CHECK(0 == interleaved.error);
+    TEST_CHECK(0 == strcmp(interleaved.serial, options.serialNumber.c_str()));
+
+    reader.join();
+    TEST_CHECK(0 == reader.failures);
+    TEST_CHECK(SPECTRA_TO_READ <= reader.spectra);
+    TEST_CHECK(0 == reader.corrupt);
+    TEST_CHECK(0 == reader.outOfOrder);
+
+    sbapi_spectrometer_stop_fast_buffer_stream(deviceID, spectrometerFeature,
+            &error);
+    TEST_CHECK(0 == error);
+
+    atomicStore(&poller.stopping, 1);
+    poller.join();
+    TEST_CHECK(0 == poller.failures);
+    TEST_CHECK(poller.polls > 0);
+
+    /* Closing the device stops a stream that is still running */
+    sbapi_spectrometer_start_fast_buffer_stream(deviceID, spectrometerFeature,
+            &error, STREAM_CAPACITY);
+    TEST_CHECK(0 == error);
+    System::sleepMilliseconds(20);
+    sbapi_close_device(deviceID, &error);
+    TEST_CHECK(0 == error);
+
+    sbapi_shutdown();
+    emulator.end();
+    return testFinish("emulator_stream_test");
+}
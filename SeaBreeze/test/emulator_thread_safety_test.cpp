@@ -0,0 +1,274 @@
+/***************************************************//**
+ * @file    emulator_thread_safety_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Calls the API on two emulated devices on the fake USB bus from
+ * several threads at once, while probes run and one device is
+ * unplugged mid-use.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "api/seabreezeapi/SeaBreezeAPIConstants.h"
+#include "native/system/ConditionVariable.h"
+#include "native/system/Mutex.h"
+#include "native/system/NativeSystem.h"
+#include "native/system/System.h"
+#include "native/system/Thread.h"
+#include "native/usb/SyntheticUSBHotPlugEventSource.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBInterface.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBProductID.h"
+#include "EmulatorTestSupport.h"
+#include "FakeNativeUSB.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::emulator;
+
+#define EVENT_TIMEOUT_MILLIS    5000
+#define MAX_DEVICES             16
+#define SPECTRA_PER_THREAD      40
+#define SERIALS_PER_THREAD      100
+#define PROBES_PER_THREAD       20
+
+static Mutex addedLock;
+static ConditionVariable addedArrived;
+static long addedID = -1;
+
+static void hotPlugCallback(long deviceID, int event, void *userData) {
+    MutexLock guard(addedLock);
+
+    if(SBAPI_DEVICE_ADDED == event) {
+        addedID = deviceID;
+        addedArrived.broadcast();
+    }
+}
+
+static void injectEvent(SyntheticUSBHotPlugEventSource *source,
+        USBHotPlugEvent::Action action) {
+    USBHotPlugEvent event;
+
+    event.action = action;
+    event.vendorID = OCEAN_OPTICS_USB_VID;
+    event.productID = FLAMEX_USB_PID;
+    source->inject(event);
+}
+
+static long waitForAdded() {
+    MutexLock guard(addedLock);
+
+    if(addedID < 0) {
+        addedArrived.wait(addedLock, EVENT_TIMEOUT_MILLIS);
+    }
+    return addedID;
+}
+
+static bool isListed(long deviceID) {
+    long ids[MAX_DEVICES];
+    int count = sbapi_get_device_ids(ids, MAX_DEVICES);
+
+    for(int i = 0; i < count; i++) {
+        if(ids[i] == deviceID) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Reads spectra until it has enough or the device goes away */
+class SpectrumReader : public Thread {
+public:
+    SpectrumReader(long deviceID, long featureID, int pixels, int count)
+        : deviceID(deviceID), featureID(featureID), pixels(pixels),
+          count(count), completed(0), failures(0), lastError(0) { }
+
+    long deviceID;
+    long featureID;
+    int pixels;
+    int count;
+    /* Read by the main thread while this one runs */
+    volatile unsigned int completed;
+    int failures;
+    int lastError;
+
+protected:
+    virtual void run() {
+        vector<double> spectrum(this->pixels);
+        int error = 0;
+
+        for(int i = 0; i < this->count; i++) {
+            int length = sbapi_spectrometer_get_formatted_spectrum(
+                    this->deviceID, this->featureID, &error,
+                    &spectrum[0], (int)spectrum.size());
+            this->lastError = error;
+            if(ERROR_NO_DEVICE == error) {
+                return;
+            }
+            if(0 != error || length != this->pixels) {
+                this->failures++;
+            }
+            atomicStore(&this->completed, atomicLoad(&this->completed) + 1);
+        }
+    }
+};
+
+/* Reads the serial number, which shares the device with a SpectrumReader */
+class SerialReader : public Thread {
+public:
+    SerialReader(long deviceID, long featureID)
+        : deviceID(deviceID), featureID(featureID), failures(0) { }
+
+    long deviceID;
+    long featureID;
+    int failures;
+
+protected:
+    virtual void run() {
+        char serial[32];
+        int error = 0;
+
+        for(int i = 0; i < SERIALS_PER_THREAD; i++) {
+            int length = sbapi_get_serial_number(this->deviceID,
+                    this->featureID, &error, serial, sizeof(serial) - 1);
+            if(0 != error || length <= 0) {
+                this->failures++;
+            }
+        }
+    }
+};
+
+/* Rewrites the device lists underneath the other threads */
+class Prober : public Thread {
+public:
+    Prober(long deviceID) : deviceID(deviceID), failures(0) { }
+
+    long deviceID;
+    int failures;
+
+protected:
+    virtual void run() {
+        for(int i = 0; i < PROBES_PER_THREAD; i++) {
+            sbapi_probe_devices();
+            if(false == isListed(this->deviceID)) {
+                this->failures++;
+            }
+        }
+    }
+};
+
+int main() {
+    OBPEmulatorOptions options;
+    SyntheticUSBHotPlugEventSource *source = new SyntheticUSBHotPlugEventSource();
+    unsigned long nativeB;
+    long deviceA = -1;
+    long spectrometerA;
+    long spectrometerB;
+    long serialA;
+    int error = 0;
+
+    /* A is found by probing; B arrives through hot-plug so that it can be
+     * unplugged again while it is in use.
+     */
+    options.serialNumber = "OFXTHRDA";
+    fakeUSBAddEmulatedDevice(options);
+    sbapi_initialize();
+    sbapi_probe_devices();
+    TEST_CHECK(1 == sbapi_get_device_ids(&deviceA, 1));
+    TEST_CHECK(0 == sbapi_open_device(deviceA, &error));
+
+    TEST_CHECK(0 == SeaBreezeAPI::getInstance()->enableHotPlug(source,
+            hotPlugCallback, NULL, &error));
+    options.serialNumber = "OFXTHRDB";
+    nativeB = fakeUSBAddEmulatedDevice(options);
+    injectEvent(source, USBHotPlugEvent::DEVICE_ADDED);
+    long deviceB = waitForAdded();
+    TEST_CHECK(deviceB >= 0);
+    if(deviceA < 0 || deviceB < 0) {
+        return testFinish("emulator_thread_safety_test");
+    }
+    TEST_CHECK(0 == sbapi_open_device(deviceB, &error));
+
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceA, &error, &spectrometerA, 1));
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceB, &error, &spectrometerB, 1));
+    TEST_CHECK(1 == sbapi_get_serial_number_features(deviceA, &error, &serialA, 1));
+    sbapi_spectrometer_set_integration_time_micros(deviceA, spectrometerA, &error, 2000);
+    sbapi_spectrometer_set_integration_time_micros(deviceB, spectrometerB, &error, 2000);
+
+    /* Both devices at once, a second caller on A, and probes throughout */
+    SpectrumReader readerA(deviceA, spectrometerA, options.numberOfPixels,
+            SPECTRA_PER_THREAD);
+    SpectrumReader readerB(deviceB, spectrometerB, options.numberOfPixels,
+            SPECTRA_PER_THREAD);
+    SerialReader serialReader(deviceA, serialA);
+    Prober prober(deviceA);
+
+    TEST_CHECK(true == readerA.start());
+    TEST_CHECK(true == readerB.start());
+    TEST_CHECK(true == serialReader.start());
+    TEST_CHECK(true == prober.start());
+    readerA.join();
+    readerB.join();
+    serialReader.join();
+    prober.join();
+
+    TEST_CHECK(0 == readerA.failures);
+    TEST_CHECK(SPECTRA_PER_THREAD == atomicLoad(&readerA.completed));
+    TEST_CHECK(0 == readerB.failures);
+    TEST_CHECK(SPECTRA_PER_THREAD == atomicLoad(&readerB.completed));
+    TEST_CHECK(0 == serialReader.failures);
+    TEST_CHECK(0 == prober.failures);
+
+    /* Unplug B while a thread is reading from it.  Until the hot-plug
+     * event has been handled, calls fail with transfer errors as they
+     * would on real hardware.  They must still return, and once the event
+     * is through they report that the device is gone.
+     */
+    SpectrumReader detached(deviceB, spectrometerB, options.numberOfPixels,
+            1000000);
+    TEST_CHECK(true == detached.start());
+    while(0 == atomicLoad(&detached.completed)) {
+        System::sleepMilliseconds(1);
+    }
+    fakeUSBRemoveDevice(nativeB);
+    injectEvent(source, USBHotPlugEvent::DEVICE_REMOVED);
+    detached.join();
+    TEST_CHECK(ERROR_NO_DEVICE == detached.lastError);
+    TEST_CHECK(false == isListed(deviceB));
+
+    /* A is unaffected */
+    vector<double> spectrum(options.numberOfPixels);
+    TEST_CHECK((int)options.numberOfPixels == sbapi_spectrometer_get_formatted_spectrum(
+            deviceA, spectrometerA, &error, &spectrum[0], (int)spectrum.size()));
+    TEST_CHECK(0 == error);
+
+    sbapi_close_device(deviceA, &error);
+    TEST_CHECK(0 == error);
+
+    SeaBreezeAPI::getInstance()->disableHotPlug(&error);
+    sbapi_shutdown();
+    return testFinish("emulator_thread_safety_test");
+}
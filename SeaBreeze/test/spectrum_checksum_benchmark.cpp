@@ -0,0 +1,100 @@
+/***************************************************//**
+ * @file    spectrum_checksum_benchmark.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Times the fast buffer record checksum at the FlameX record size, with
+ *  * the kernel the library uses and with the portable sum, over a batch
+ *  * as large as one fast buffer reply.  Run it by hand; it reports timings
+ *  * rather than passing or failing.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include "native/system/System.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::oceanBinaryProtocol;
+
+/* 64 bytes of metadata, 2136 16-bit pixels and the checksum */
+#define FLAMEX_RECORD_LENGTH    4340
+/* The most records one fast buffer reply carries */
+#define RECORDS_PER_BATCH       15
+#define DEFAULT_ROUNDS          20000
+
+typedef unsigned int (*ChecksumFunction)(const byte *, unsigned int);
+
+static void timeChecksum(const char *name, ChecksumFunction checksum,
+        const vector<byte> &batch, unsigned int rounds) {
+    unsigned int checked = FLAMEX_RECORD_LENGTH
+            - OBPSpectrumBatchView::RECORD_CHECKSUM_LENGTH;
+    unsigned int total = 0;
+    unsigned long long start;
+    unsigned long long elapsed;
+    double records;
+
+    start = System::getMonotonicMicros();
+    for(unsigned int round = 0; round < rounds; round++) {
+        for(unsigned int i = 0; i < RECORDS_PER_BATCH; i++) {
+            total += checksum(&batch[i * FLAMEX_RECORD_LENGTH], checked);
+        }
+    }
+    elapsed = System::getMonotonicMicros() - start;
+    if(0 == elapsed) {
+        elapsed = 1;
+    }
+
+    /* The total is printed so that the loop cannot be optimized away */
+    records = (double)rounds * RECORDS_PER_BATCH;
+    printf("%-10s %8.1f ns/record %8.1f MB/s (sum %08X)\n", name,
+            elapsed * 1000.0 / records,
+            records * checked / elapsed, total);
+}
+
+int main(int argc, char *argv[]) {
+    vector<byte> batch(FLAMEX_RECORD_LENGTH * RECORDS_PER_BATCH);
+    unsigned int rounds = DEFAULT_ROUNDS;
+    unsigned int seed = 1;
+
+    if(argc > 1) {
+        rounds = (unsigned int)atoi(argv[1]);
+    }
+    for(unsigned int i = 0; i < batch.size(); i++) {
+        seed = seed * 1103515245 + 12345;
+        batch[i] = (byte)(seed >> 16);
+    }
+
+    printf("%u rounds of %u records of %u bytes\n", rounds,
+            RECORDS_PER_BATCH, FLAMEX_RECORD_LENGTH);
+    timeChecksum("portable", OBPSpectrumBatchView::computeChecksumPortable,
+            batch, rounds);
+    timeChecksum("library", OBPSpectrumBatchView::computeChecksum,
+            batch, rounds);
+    return 0;
+}
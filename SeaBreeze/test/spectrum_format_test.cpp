@@ -0,0 +1,284 @@
+/***************************************************//**
+ * @file    spectrum_format_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks that the float, uint16 and uint32 formatted spectrum reads
+ *  * return the same counts as the double read for each kind of decoder:
+ *  * the QE65000 with its bit 15 flip, the FPGA's low byte first order,
+ *  * the OBP 16 bit spectrum, and the QE Pro's 32 bit spectrum, whose
+ *  * metadata must also come back intact.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <string.h>
+#include <vector>
+#include "common/buses/Bus.h"
+#include "common/buses/BusFamilies.h"
+#include "common/buses/TransferHelper.h"
+#include "common/SpectrumMetadata.h"
+#include "vendors/OceanOptics/protocols/interfaces/SpectrometerProtocolInterface.h"
+#include "vendors/OceanOptics/protocols/ooi/impls/OOISpectrometerProtocol.h"
+#include "vendors/OceanOptics/protocols/ooi/exchanges/QESpectrumExchange.h"
+#include "vendors/OceanOptics/protocols/ooi/exchanges/FPGASpectrumExchange.h"
+#include "vendors/OceanOptics/protocols/obp/impls/OBPSpectrometerProtocol.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadSpectrumExchange.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPReadSpectrum32AndMetadataExchange.h"
+#include "vendors/OceanOptics/protocols/obp/exchanges/OBPMessageCodec.h"
+#include "vendors/OceanOptics/protocols/obp/constants/OBPMessageTypes.h"
+#include "EmulatorTestSupport.h"
+
+using namespace std;
+using namespace seabreeze;
+using namespace seabreeze::ooiProtocol;
+using namespace seabreeze::oceanBinaryProtocol;
+
+#define PIXELS          16
+#define QE_PRO_METADATA 32
+
+/* Hands out the same reply to every receive and accepts every send */
+class CannedTransferHelper : public TransferHelper {
+public:
+    vector<byte> reply;
+
+    virtual int receive(vector<byte> &buffer, unsigned int length)
+            throw (BusTransferException) {
+        unsigned int count = (length < this->reply.size())
+                ? length : (unsigned int)this->reply.size();
+        if(buffer.size() < length) {
+            buffer.resize(length);
+        }
+        memcpy(&buffer[0], &this->reply[0], count);
+        return (int)count;
+    }
+
+    virtual int send(const vector<byte> &buffer, unsigned int length) const
+            throw (BusTransferException) {
+        return (int)length;
+    }
+};
+
+class CannedBus : public Bus {
+public:
+    CannedTransferHelper helper;
+
+    virtual TransferHelper *getHelper(const vector<ProtocolHint *> &hints) const {
+        return const_cast<CannedTransferHelper *>(&this->helper);
+    }
+    virtual BusFamily getBusFamily() const {
+        BusFamilies families;
+        return families.USB;
+    }
+    virtual void setLocation(const DeviceLocatorInterface &location)
+            throw (IllegalArgumentException) { }
+    virtual bool open() { return true; }
+    virtual void close() { }
+    virtual DeviceLocatorInterface *getLocation() { return NULL; }
+};
+
+static unsigned short clampToUShort(double value) {
+    return (value >= 65535) ? 65535 : (unsigned short)value;
+}
+
+/* Reads the canned spectrum into each output type, with one spare element
+ * at the end that must be left alone, and compares it with the counts
+ * that the double read gave.
+ */
+static void checkTypedReads(SpectrometerProtocolInterface &protocol,
+        const Bus &bus, const vector<double> &expected) {
+    unsigned int n = (unsigned int)expected.size();
+    unsigned int i;
+
+    vector<double> *asVector = protocol.readFormattedSpectrum(bus);
+    TEST_CHECK(NULL != asVector);
+    if(NULL == asVector) {
+        return;
+    }
+    TEST_CHECK(*asVector == expected);
+    delete asVector;
+
+    vector<double> asDouble(n + 1, -1.0);
+    TEST_CHECK(n == protocol.readFormattedSpectrum(bus, &asDouble[0], n));
+    vector<float> asFloat(n + 1, -1.0f);
+    TEST_CHECK(n == protocol.readFormattedSpectrum(bus, &asFloat[0], n));
+    vector<unsigned short> asUShort(n + 1, 0xBEEF);
+    TEST_CHECK(n == protocol.readFormattedSpectrum(bus, &asUShort[0], n));
+    vector<unsigned int> asUInt(n + 1, 0xDEADBEEF);
+    TEST_CHECK(n == protocol.readFormattedSpectrum(bus, &asUInt[0], n));
+
+    for(i = 0; i < n; i++) {
+        TEST_CHECK(expected[i] == asDouble[i]);
+        TEST_CHECK((float)expected[i] == asFloat[i]);
+        TEST_CHECK(clampToUShort(expected[i]) == asUShort[i]);
+        TEST_CHECK((unsigned int)expected[i] == asUInt[i]);
+    }
+    TEST_CHECK(-1.0 == asDouble[n]);
+    TEST_CHECK(-1.0f == asFloat[n]);
+    TEST_CHECK(0xBEEF == asUShort[n]);
+    TEST_CHECK(0xDEADBEEF == asUInt[n]);
+
+    /* A short buffer gets a prefix of the same spectrum */
+    vector<unsigned short> prefix(n, 0);
+    TEST_CHECK(3 == protocol.readFormattedSpectrum(bus, &prefix[0], 3));
+    TEST_CHECK(clampToUShort(expected[2]) == prefix[2]);
+    TEST_CHECK(0 == prefix[3]);
+}
+
+/* Counts that exercise both bytes and bit 15 of a 16 bit pixel */
+static const unsigned short counts16[PIXELS] = {
+    0x0000, 0x0001, 0x00FF, 0x0100, 0x1234, 0x7FFF, 0x8000, 0x8001,
+    0xABCD, 0xFF00, 0xFFFE, 0xFFFF, 0x4000, 0x0080, 0x8080, 0x5A5A
+};
+
+static void testQE65000() {
+    CannedBus bus;
+    vector<double> expected(PIXELS);
+    unsigned int readoutLength = (PIXELS * 2) + 1;
+    unsigned int i;
+
+    /* The detector sends bit 15 inverted, low byte first, then a sync byte */
+    bus.helper.reply.resize(readoutLength);
+    for(i = 0; i < PIXELS; i++) {
+        bus.helper.reply[i * 2] = counts16[i] & 0x00FF;
+        bus.helper.reply[(i * 2) + 1] = ((counts16[i] >> 8) & 0x00FF) ^ 0x80;
+        expected[i] = counts16[i];
+    }
+    bus.helper.reply[readoutLength - 1] = 0x69;
+
+    OOISpectrometerProtocol protocol(NULL, NULL,
+            new QESpectrumExchange(readoutLength, PIXELS),
+            NULL, NULL, NULL, NULL, NULL);
+    checkTypedReads(protocol, bus, expected);
+
+    SpectrumMetadata metadata;
+    TEST_CHECK(false == protocol.getFormattedSpectrumMetadata(metadata));
+}
+
+static void testFPGA() {
+    CannedBus bus;
+    vector<double> expected(PIXELS);
+    unsigned int readoutLength = (PIXELS * 2) + 1;
+    unsigned int i;
+
+    /* Low byte first, and no bits changed on the way */
+    bus.helper.reply.resize(readoutLength);
+    for(i = 0; i < PIXELS; i++) {
+        bus.helper.reply[i * 2] = counts16[i] & 0x00FF;
+        bus.helper.reply[(i * 2) + 1] = (counts16[i] >> 8) & 0x00FF;
+        expected[i] = counts16[i];
+    }
+    bus.helper.reply[readoutLength - 1] = 0x69;
+
+    OOISpectrometerProtocol protocol(NULL, NULL,
+            new FPGASpectrumExchange(readoutLength, PIXELS),
+            NULL, NULL, NULL, NULL, NULL);
+    checkTypedReads(protocol, bus, expected);
+}
+
+static void testOBP16() {
+    CannedBus bus;
+    vector<double> expected(PIXELS);
+    byte pixels[PIXELS * 2];
+    unsigned int i;
+
+    for(i = 0; i < PIXELS; i++) {
+        OBPMessageCodec::writeUShort(pixels + (i * 2), counts16[i]);
+        expected[i] = counts16[i];
+    }
+    OBPMessageCodec::encode(bus.helper.reply,
+            OBPMessageTypes::OBP_GET_CORRECTED_SPECTRUM_NOW,
+            OBPMessageCodec::FLAG_RESPONSE, pixels, sizeof(pixels));
+
+    OBPSpectrometerProtocol protocol(NULL, NULL,
+            new OBPReadSpectrumExchange((PIXELS * 2) + 64, PIXELS),
+            NULL, NULL, NULL, NULL, NULL);
+    checkTypedReads(protocol, bus, expected);
+
+    /* Nothing but pixels in this message */
+    SpectrumMetadata metadata;
+    TEST_CHECK(false == protocol.getFormattedSpectrumMetadata(metadata));
+}
+
+static void testQEPro() {
+    CannedBus bus;
+    vector<double> expected(PIXELS);
+    byte data[QE_PRO_METADATA + (PIXELS * 4)];
+    unsigned int i;
+
+    /* Spectrum count, tick count in two halves, integration time and
+     * trigger mode, then padding up to the full block.
+     */
+    memset(data, 0, sizeof(data));
+    OBPMessageCodec::writeUInt(data, 41);
+    OBPMessageCodec::writeUInt(data + 4, 0x89ABCDEF);
+    OBPMessageCodec::writeUInt(data + 8, 0x00000123);
+    OBPMessageCodec::writeUInt(data + 12, 8000);
+    data[16] = 3;
+    for(i = 0; i < PIXELS; i++) {
+        /* Some of these do not fit in 16 bits and must clamp there */
+        unsigned int value = (i < 4) ? (65534 + (i * 1000)) : (counts16[i] * 3);
+        OBPMessageCodec::writeUInt(data + QE_PRO_METADATA + (i * 4), value);
+        expected[i] = value;
+    }
+    OBPMessageCodec::encode(bus.helper.reply,
+            OBPMessageTypes::OBP_GET_BUF_SPEC32_META,
+            OBPMessageCodec::FLAG_RESPONSE, data, sizeof(data));
+
+    OBPSpectrometerProtocol protocol(NULL, NULL,
+            new OBPReadSpectrum32AndMetadataExchange(PIXELS),
+            NULL, NULL, NULL, NULL, NULL);
+
+    SpectrumMetadata metadata;
+    TEST_CHECK(false == protocol.getFormattedSpectrumMetadata(metadata));
+
+    checkTypedReads(protocol, bus, expected);
+
+    TEST_CHECK(true == protocol.getFormattedSpectrumMetadata(metadata));
+    TEST_CHECK(41 == metadata.spectrumCount);
+    TEST_CHECK(0x12389ABCDEFULL == metadata.tickCountMicros);
+    TEST_CHECK(8000 == metadata.integrationTimeMicros);
+    TEST_CHECK(3 == metadata.triggerMode);
+
+    /* A read that fails leaves no stale metadata behind */
+    bus.helper.reply[0] ^= 0xFF;
+    vector<unsigned short> spectrum(PIXELS);
+    bool threw = false;
+    try {
+        protocol.readFormattedSpectrum(bus, &spectrum[0], PIXELS);
+    } catch (ProtocolException &pe) {
+        threw = true;
+    }
+    TEST_CHECK(true == threw);
+    TEST_CHECK(false == protocol.getFormattedSpectrumMetadata(metadata));
+}
+
+int main() {
+    testQE65000();
+    testFPGA();
+    testOBP16();
+    testQEPro();
+
+    return testFinish("spectrum_format_test");
+}
@@ -0,0 +1,402 @@
+/***************************************************//**
+ * @file    transfer_segments_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks receiveSegments() on every transfer helper with a scatter list
+ *  * that has empty segments at both ends and in the middle and segments
+ *  * that are not word aligned.  USB helpers run over the fake native
+ *  * USB backend, TCP over a loopback connection, RS232 over a
+ *  * pseudo-terminal, and the base class fallback over canned data.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+#include "common/globals.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <deque>
+#include <vector>
+#include "common/buses/TransferHelper.h"
+#include "common/buses/usb/USBTransferHelper.h"
+#include "common/buses/network/TCPIPv4SocketTransferHelper.h"
+#include "common/buses/rs232/RS232TransferHelper.h"
+#include "native/network/Socket.h"
+#include "native/rs232/RS232.h"
+#include "native/usb/USB.h"
+#include "native/usb/USBDiscovery.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBEndpointMaps.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBInterface.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBProductID.h"
+#include "vendors/OceanOptics/buses/usb/FlameXUSBTransferHelper.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSB4KSpectrumTransferHelper.h"
+#include "EmulatorTestSupport.h"
+#include "FakeNativeUSB.h"
+
+using namespace std;
+using namespace seabreeze;
+
+#define GUARD_BYTE          0xEE
+#define SECONDARY_LENGTH    2048
+
+/* Empty at both ends and in the middle, with odd lengths in between */
+static const unsigned int mixedLengths[] = { 0, 5, 0, 7, 3, 0 };
+#define MIXED_COUNT         6
+#define MIXED_TOTAL         15
+
+/* Letters only, so that a terminal never treats a byte as a control */
+static byte streamByte(unsigned int index) {
+    return (byte)('A' + (index % 26));
+}
+
+static vector<byte> makeStream(unsigned int length) {
+    vector<byte> data(length);
+    for(unsigned int i = 0; i < length; i++) {
+        data[i] = streamByte(i);
+    }
+    return data;
+}
+
+/* Destinations spread through one arena at odd offsets, with guard bytes
+ * around each one so that a write out of place shows up.
+ */
+class SegmentLayout {
+public:
+    SegmentLayout(const unsigned int *lengths, unsigned int count) {
+        unsigned int offset = 1;
+        unsigned int i;
+
+        for(i = 0; i < count; i++) {
+            offset += lengths[i] + 3;
+        }
+        this->arena.assign(offset, GUARD_BYTE);
+
+        offset = 1;
+        for(i = 0; i < count; i++) {
+            TransferSegment segment;
+            segment.data = &this->arena[offset];
+            segment.length = lengths[i];
+            this->segments.push_back(segment);
+            offset += lengths[i] + 3;
+        }
+    }
+
+    /* True if the first received bytes of the stream landed in order and
+     * nothing else in the arena changed.
+     */
+    bool holds(unsigned int received) {
+        vector<bool> covered(this->arena.size(), false);
+        unsigned int index = 0;
+
+        for(unsigned int i = 0; i < this->segments.size(); i++) {
+            for(unsigned int j = 0; j < this->segments[i].length; j++) {
+                unsigned int position = (unsigned int)(this->segments[i].data
+                        - &this->arena[0]) + j;
+                byte expected = (index < received) ? streamByte(index) : GUARD_BYTE;
+                if(expected != this->arena[position]) {
+                    return false;
+                }
+                covered[position] = true;
+                index++;
+            }
+        }
+        for(unsigned int k = 0; k < this->arena.size(); k++) {
+            if(false == covered[k] && GUARD_BYTE != this->arena[k]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    vector<byte> arena;
+    vector<TransferSegment> segments;
+};
+
+/* Hands out queued chunks, one per receive(), to exercise the fallback */
+class CannedTransferHelper : public TransferHelper {
+public:
+    CannedTransferHelper() : receives(0) { }
+
+    deque<vector<byte> > chunks;
+    int receives;
+
+    virtual int receive(vector<byte> &buffer, unsigned int length)
+            throw (BusTransferException) {
+        this->receives++;
+        if(true == this->chunks.empty()) {
+            return 0;
+        }
+        vector<byte> chunk = this->chunks.front();
+        this->chunks.pop_front();
+        unsigned int count = (length < chunk.size()) ? length : (unsigned int)chunk.size();
+        memcpy(&buffer[0], &chunk[0], count);
+        return (int)count;
+    }
+
+    virtual int send(const vector<byte> &buffer, unsigned int length) const
+            throw (BusTransferException) {
+        return (int)length;
+    }
+};
+
+static void testFallback() {
+    CannedTransferHelper helper;
+
+    /* The whole message is one receive, whatever the segments look like */
+    SegmentLayout full(mixedLengths, MIXED_COUNT);
+    helper.chunks.push_back(makeStream(MIXED_TOTAL));
+    TEST_CHECK(MIXED_TOTAL == helper.receiveSegments(&full.segments[0], MIXED_COUNT));
+    TEST_CHECK(1 == helper.receives);
+    TEST_CHECK(true == full.holds(MIXED_TOTAL));
+
+    /* A short receive fills the segments in order and stops */
+    SegmentLayout partial(mixedLengths, MIXED_COUNT);
+    helper.chunks.push_back(makeStream(9));
+    TEST_CHECK(9 == helper.receiveSegments(&partial.segments[0], MIXED_COUNT));
+    TEST_CHECK(true == partial.holds(9));
+
+    /* Nothing to fill means nothing to receive */
+    unsigned int none[] = { 0, 0, 0 };
+    SegmentLayout empty(none, 3);
+    helper.receives = 0;
+    TEST_CHECK(0 == helper.receiveSegments(&empty.segments[0], 3));
+    TEST_CHECK(0 == helper.receiveSegments(NULL, 0));
+    TEST_CHECK(0 == helper.receives);
+}
+
+static void testUSB(USB *usb, unsigned long deviceID) {
+    OOIUSBSimpleDualEndpointMap map;
+    USBTransferHelper helper(usb, map.getPrimaryOutEndpoint(),
+            map.getPrimaryInEndpoint());
+    vector<byte> data = makeStream(MIXED_TOTAL);
+
+    /* One bulk read for the whole list, spread over the segments */
+    SegmentLayout full(mixedLengths, MIXED_COUNT);
+    fakeUSBResetCounts();
+    fakeUSBAddReadData(deviceID, map.getPrimaryInEndpoint(), &data[0], MIXED_TOTAL);
+    TEST_CHECK(MIXED_TOTAL == helper.receiveSegments(&full.segments[0], MIXED_COUNT));
+    TEST_CHECK(1 == fakeUSBGetCounts().reads);
+    TEST_CHECK(true == full.holds(MIXED_TOTAL));
+
+    /* A short packet ends the transfer part way through the second segment */
+    SegmentLayout partial(mixedLengths, MIXED_COUNT);
+    fakeUSBAddReadData(deviceID, map.getPrimaryInEndpoint(), &data[0], 9);
+    TEST_CHECK(9 == helper.receiveSegments(&partial.segments[0], MIXED_COUNT));
+    TEST_CHECK(true == partial.holds(9));
+
+    /* One real segment among empty ones is read in place */
+    unsigned int lone[] = { 0, 11, 0 };
+    SegmentLayout single(lone, 3);
+    fakeUSBAddReadData(deviceID, map.getPrimaryInEndpoint(), &data[0], 11);
+    TEST_CHECK(11 == helper.receiveSegments(&single.segments[0], 3));
+    TEST_CHECK(true == single.holds(11));
+
+    unsigned int none[] = { 0, 0 };
+    SegmentLayout empty(none, 2);
+    fakeUSBResetCounts();
+    TEST_CHECK(0 == helper.receiveSegments(&empty.segments[0], 2));
+    TEST_CHECK(0 == fakeUSBGetCounts().reads);
+}
+
+static void testFlameX(USB *usb, unsigned long deviceID) {
+    OOIUSBSimpleDualEndpointMap map;
+    FlameXUSBTransferHelper helper(usb, map);
+    vector<byte> data = makeStream(16);
+
+    /* 15 bytes are read as 16, and the padding lands nowhere */
+    SegmentLayout full(mixedLengths, MIXED_COUNT);
+    fakeUSBResetCounts();
+    fakeUSBAddReadData(deviceID, map.getPrimaryInEndpoint(), &data[0], 16);
+    TEST_CHECK(MIXED_TOTAL == helper.receiveSegments(&full.segments[0], MIXED_COUNT));
+    TEST_CHECK(1 == fakeUSBGetCounts().reads);
+    TEST_CHECK(true == full.holds(MIXED_TOTAL));
+
+    /* An odd length into a buffer with no room for the padding */
+    vector<byte> exact(7, GUARD_BYTE);
+    fakeUSBAddReadData(deviceID, map.getPrimaryInEndpoint(), &data[0], 8);
+    TEST_CHECK(7 == helper.receiveInto(exact, 0, 7));
+    TEST_CHECK(7 == exact.size());
+    TEST_CHECK(0 == memcmp(&exact[0], &data[0], 7));
+
+    /* With room after it, at an odd offset */
+    vector<byte> roomy(12, GUARD_BYTE);
+    fakeUSBAddReadData(deviceID, map.getPrimaryInEndpoint(), &data[0], 8);
+    TEST_CHECK(7 == helper.receiveInto(roomy, 1, 7));
+    TEST_CHECK(GUARD_BYTE == roomy[0]);
+    TEST_CHECK(0 == memcmp(&roomy[1], &data[0], 7));
+}
+
+static void test4K(USB *usb, unsigned long deviceID) {
+    OOIUSBFPGAEndpointMap map;
+    OOIUSB4KSpectrumTransferHelper helper(usb, map);
+    vector<byte> data = makeStream(SECONDARY_LENGTH + 100);
+
+    /* A short message is one transfer from the second endpoint */
+    SegmentLayout small(mixedLengths, MIXED_COUNT);
+    fakeUSBResetCounts();
+    fakeUSBAddReadData(deviceID, map.getHighSpeedIn2EP(), &data[0], MIXED_TOTAL);
+    TEST_CHECK(MIXED_TOTAL == helper.receiveSegments(&small.segments[0], MIXED_COUNT));
+    TEST_CHECK(1 == fakeUSBGetCounts().reads);
+    TEST_CHECK(true == small.holds(MIXED_TOTAL));
+
+    /* A long one is split between the endpoints where the device splits
+     * it, not where the segments are.
+     */
+    unsigned int spanning[] = { 0, 44, 0, SECONDARY_LENGTH + 100 - 44, 0 };
+    SegmentLayout large(spanning, 5);
+    fakeUSBResetCounts();
+    fakeUSBAddReadData(deviceID, map.getHighSpeedIn2EP(), &data[0], SECONDARY_LENGTH);
+    fakeUSBAddReadData(deviceID, map.getHighSpeedInEP(),
+            &data[SECONDARY_LENGTH], 100);
+    TEST_CHECK(SECONDARY_LENGTH + 100 == helper.receiveSegments(&large.segments[0], 5));
+    TEST_CHECK(2 == fakeUSBGetCounts().reads);
+    TEST_CHECK(true == large.holds(SECONDARY_LENGTH + 100));
+}
+
+static USB *openTestDevice(USBDiscovery &discovery, unsigned short productID) {
+    vector<unsigned long> *ids = discovery.probeDevices(OCEAN_OPTICS_USB_VID,
+            productID);
+    USB *usb = NULL;
+
+    if(1 == ids->size()) {
+        usb = discovery.createUSBInterface((*ids)[0]);
+    }
+    delete ids;
+    if(NULL != usb && false == usb->open()) {
+        delete usb;
+        usb = NULL;
+    }
+    return usb;
+}
+
+static void testTCP() {
+    struct sockaddr_in address;
+    socklen_t addressLength = sizeof(address);
+    vector<byte> data = makeStream(MIXED_TOTAL);
+    int listener;
+    int peer;
+
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    TEST_CHECK(0 == bind(listener, (struct sockaddr *)&address, sizeof(address)));
+    TEST_CHECK(0 == listen(listener, 1));
+    TEST_CHECK(0 == getsockname(listener, (struct sockaddr *)&address, &addressLength));
+
+    Socket *sock = Socket::create();
+    sock->connect("127.0.0.1", ntohs(address.sin_port));
+    peer = accept(listener, NULL, NULL);
+    TEST_CHECK(peer >= 0);
+
+    TCPIPv4SocketTransferHelper helper(sock);
+
+    /* Sent in pieces that do not line up with the segments */
+    SegmentLayout full(mixedLengths, MIXED_COUNT);
+    TEST_CHECK(4 == write(peer, &data[0], 4));
+    TEST_CHECK(MIXED_TOTAL - 4 == write(peer, &data[4], MIXED_TOTAL - 4));
+    TEST_CHECK(MIXED_TOTAL == helper.receiveSegments(&full.segments[0], MIXED_COUNT));
+    TEST_CHECK(true == full.holds(MIXED_TOTAL));
+
+    /* The peer hangs up part way through */
+    SegmentLayout partial(mixedLengths, MIXED_COUNT);
+    TEST_CHECK(9 == write(peer, &data[0], 9));
+    shutdown(peer, SHUT_WR);
+    TEST_CHECK(9 == helper.receiveSegments(&partial.segments[0], MIXED_COUNT));
+    TEST_CHECK(true == partial.holds(9));
+
+    sock->close();
+    delete sock;
+    close(peer);
+    close(listener);
+}
+
+static void testRS232() {
+    vector<byte> data = makeStream(MIXED_TOTAL);
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+
+    if(master < 0 || 0 != grantpt(master) || 0 != unlockpt(master)) {
+        /* Nothing to test against without a pseudo-terminal */
+        if(master >= 0) {
+            close(master);
+        }
+        return;
+    }
+
+    RS232 port(ptsname(master), 9600);
+    TEST_CHECK(true == port.open());
+    RS232TransferHelper helper(&port);
+
+    SegmentLayout full(mixedLengths, MIXED_COUNT);
+    TEST_CHECK(6 == write(master, &data[0], 6));
+    TEST_CHECK(MIXED_TOTAL - 6 == write(master, &data[6], MIXED_TOTAL - 6));
+    TEST_CHECK(MIXED_TOTAL == helper.receiveSegments(&full.segments[0], MIXED_COUNT));
+    TEST_CHECK(true == full.holds(MIXED_TOTAL));
+
+    port.close();
+    close(master);
+}
+
+int main() {
+    USBDiscovery discovery;
+    unsigned long flameXID;
+    unsigned long usb4000ID;
+    USB *usb;
+
+    testFallback();
+
+    flameXID = fakeUSBAddDevice(OCEAN_OPTICS_USB_VID, FLAMEX_USB_PID);
+    usb = openTestDevice(discovery, FLAMEX_USB_PID);
+    TEST_CHECK(NULL != usb);
+    if(NULL != usb) {
+        testUSB(usb, flameXID);
+        testFlameX(usb, flameXID);
+        usb->close();
+        delete usb;
+    }
+
+    /* Blocking reads, so that a read the device never answers fails at
+     * once instead of waiting forever.
+     */
+    fakeUSBSetQueuedReads(false);
+    usb4000ID = fakeUSBAddDevice(OCEAN_OPTICS_USB_VID, USB4000_USB_PID);
+    usb = openTestDevice(discovery, USB4000_USB_PID);
+    TEST_CHECK(NULL != usb);
+    if(NULL != usb) {
+        test4K(usb, usb4000ID);
+        usb->close();
+        delete usb;
+    }
+    fakeUSBSetQueuedReads(true);
+
+    testTCP();
+    testRS232();
+
+    return testFinish("transfer_segments_test");
+}
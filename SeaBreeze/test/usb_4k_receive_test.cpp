@@ -0,0 +1,182 @@
+/***************************************************//**
+ * @file    usb_4k_receive_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks that the USB4000/HR4000 high speed spectrum helper reads
+ * the first 2048 bytes from the second endpoint and the rest from
+ * the first, straight into their places in a caller's buffer that
+ * starts out too small, with and without queued reads.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <vector>
+#include "native/usb/USB.h"
+#include "native/usb/USBDiscovery.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBEndpointMaps.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBInterface.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBProductID.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSB4KSpectrumTransferHelper.h"
+#include "EmulatorTestSupport.h"
+#include "FakeNativeUSB.h"
+
+using namespace std;
+using namespace seabreeze;
+
+#define SECONDARY_LENGTH    2048
+/* A USB4000 spectrum plus its sync byte */
+#define SPECTRUM_LENGTH     7681
+
+/* Every byte says where it belongs so misplaced data is easy to spot */
+static byte expectedByte(int index) {
+    return (byte)((index * 7 + index / 256) & 0xFF);
+}
+
+static void queueSpectrum(unsigned long deviceID,
+        const OOIUSBCypressEndpointMap &map, int length) {
+    vector<byte> spectrum(length);
+
+    for(int i = 0; i < length; i++) {
+        spectrum[i] = expectedByte(i);
+    }
+    if(length <= SECONDARY_LENGTH) {
+        fakeUSBAddReadData(deviceID, map.getHighSpeedIn2EP(), &spectrum[0],
+                length);
+        return;
+    }
+    fakeUSBAddReadData(deviceID, map.getHighSpeedIn2EP(), &spectrum[0],
+            SECONDARY_LENGTH);
+    fakeUSBAddReadData(deviceID, map.getHighSpeedInEP(),
+            &spectrum[SECONDARY_LENGTH], length - SECONDARY_LENGTH);
+}
+
+static bool matches(const vector<byte> &buffer, int length) {
+    for(int i = 0; i < length; i++) {
+        if(expectedByte(i) != buffer[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void testReceive(USB *usb, unsigned long deviceID, bool queued) {
+    OOIUSBFPGAEndpointMap map;
+    OOIUSB4KSpectrumTransferHelper helper(usb, map);
+    FakeUSBCounts counts;
+    vector<byte> buffer;
+    int length;
+
+    fakeUSBResetCounts();
+
+    /* The buffer starts far too small and has to grow to take both reads */
+    buffer.resize(16);
+    queueSpectrum(deviceID, map, SPECTRUM_LENGTH);
+    length = helper.receive(buffer, SPECTRUM_LENGTH);
+    TEST_CHECK(SPECTRUM_LENGTH == length);
+    TEST_CHECK(buffer.size() >= SPECTRUM_LENGTH);
+    TEST_CHECK(true == matches(buffer, SPECTRUM_LENGTH));
+
+    counts = fakeUSBGetCounts();
+    if(true == queued) {
+        /* Both reads were in flight together */
+        TEST_CHECK(2 == counts.submits);
+        TEST_CHECK(2 == counts.completes);
+        TEST_CHECK(0 == counts.reads);
+    } else {
+        TEST_CHECK(2 == counts.reads);
+    }
+
+    /* A short request still has to make room for the whole second
+     * endpoint's read, but only reports what was asked for.
+     */
+    buffer.clear();
+    queueSpectrum(deviceID, map, SECONDARY_LENGTH);
+    length = helper.receive(buffer, 100);
+    TEST_CHECK(100 == length);
+    TEST_CHECK(buffer.size() >= SECONDARY_LENGTH);
+    TEST_CHECK(true == matches(buffer, SECONDARY_LENGTH));
+
+    if(true == queued) {
+        /* A queued read would wait for data that never comes */
+        return;
+    }
+
+    /* A missing half is an error, not a short spectrum */
+    bool thrown = false;
+    buffer.resize(16);
+    fakeUSBAddReadData(deviceID, map.getHighSpeedIn2EP(), &buffer[0], 16);
+    try {
+        helper.receive(buffer, SPECTRUM_LENGTH);
+    } catch (BusTransferException &bte) {
+        thrown = true;
+    }
+    TEST_CHECK(true == thrown);
+}
+
+static USB *openTestDevice(USBDiscovery &discovery) {
+    vector<unsigned long> *ids = discovery.probeDevices(OCEAN_OPTICS_USB_VID,
+            USB4000_USB_PID);
+    USB *usb = NULL;
+
+    if(1 == ids->size()) {
+        usb = discovery.createUSBInterface((*ids)[0]);
+    }
+    delete ids;
+    if(NULL != usb && false == usb->open()) {
+        delete usb;
+        usb = NULL;
+    }
+    return usb;
+}
+
+int main() {
+    USBDiscovery discovery;
+    unsigned long deviceID;
+    USB *usb;
+
+    deviceID = fakeUSBAddDevice(OCEAN_OPTICS_USB_VID, USB4000_USB_PID);
+
+    usb = openTestDevice(discovery);
+    TEST_CHECK(NULL != usb);
+    if(NULL != usb) {
+        testReceive(usb, deviceID, true);
+        usb->close();
+        delete usb;
+    }
+
+    /* USB remembers that queued reads are unsupported, so start afresh */
+    fakeUSBSetQueuedReads(false);
+    usb = openTestDevice(discovery);
+    TEST_CHECK(NULL != usb);
+    if(NULL != usb) {
+        testReceive(usb, deviceID, false);
+        usb->close();
+        delete usb;
+    }
+    fakeUSBSetQueuedReads(true);
+
+    return testFinish("usb_4k_receive_test");
+}
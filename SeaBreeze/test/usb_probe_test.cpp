@@ -0,0 +1,126 @@
+/***************************************************//**
+ * @file    usb_probe_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks that probing finds every supported device type in one
+ * scan of the fake USB bus, ignores devices it does not support,
+ * and keeps the API's device IDs stable as devices come and go.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <string.h>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBInterface.h"
+#include "vendors/OceanOptics/buses/usb/OOIUSBProductID.h"
+#include "EmulatorTestSupport.h"
+#include "FakeNativeUSB.h"
+
+#define MAX_TEST_DEVICES 16
+
+/* Returns the API ID of the device with the given type name, or -1 */
+static long findDevice(const char *type) {
+    long ids[MAX_TEST_DEVICES];
+    char name[32];
+    int count;
+    int error;
+    int i;
+
+    count = sbapi_get_device_ids(ids, MAX_TEST_DEVICES);
+    for(i = 0; i < count; i++) {
+        memset(name, 0, sizeof(name));
+        sbapi_get_device_type(ids[i], &error, name, sizeof(name) - 1);
+        if(0 == strcmp(name, type)) {
+            return ids[i];
+        }
+    }
+    return -1;
+}
+
+int main() {
+    unsigned long usb4000;
+    unsigned long qepro;
+    long usb4000ID;
+    long flamexID;
+    long qeproID;
+    long stsID;
+
+    usb4000 = fakeUSBAddDevice(OCEAN_OPTICS_USB_VID, USB4000_USB_PID);
+    fakeUSBAddDevice(OCEAN_OPTICS_USB_VID, FLAMEX_USB_PID);
+    qepro = fakeUSBAddDevice(OCEAN_OPTICS_USB_VID, QEPRO_USB_PID);
+    /* Neither of these is something SeaBreeze can drive */
+    fakeUSBAddDevice(OCEAN_OPTICS_USB_VID, 0x7fff);
+    fakeUSBAddDevice(0x1234, USB4000_USB_PID);
+
+    sbapi_initialize();
+    fakeUSBResetCounts();
+
+    /* One pass over the bus covers every device type */
+    sbapi_probe_devices();
+    TEST_CHECK(1 == fakeUSBGetCounts().probes);
+    TEST_CHECK(3 == sbapi_get_number_of_device_ids());
+
+    usb4000ID = findDevice("USB4000");
+    flamexID = findDevice("FLAMEX");
+    qeproID = findDevice("QE-PRO");
+    TEST_CHECK(usb4000ID >= 0);
+    TEST_CHECK(flamexID >= 0);
+    TEST_CHECK(qeproID >= 0);
+
+    /* Probing an unchanged bus keeps every ID */
+    sbapi_probe_devices();
+    TEST_CHECK(2 == fakeUSBGetCounts().probes);
+    TEST_CHECK(3 == sbapi_get_number_of_device_ids());
+    TEST_CHECK(usb4000ID == findDevice("USB4000"));
+    TEST_CHECK(flamexID == findDevice("FLAMEX"));
+    TEST_CHECK(qeproID == findDevice("QE-PRO"));
+
+    /* Only what changed is added or dropped */
+    fakeUSBRemoveDevice(usb4000);
+    fakeUSBAddDevice(OCEAN_OPTICS_USB_VID, STS_USB_PID);
+    sbapi_probe_devices();
+    TEST_CHECK(3 == fakeUSBGetCounts().probes);
+    TEST_CHECK(3 == sbapi_get_number_of_device_ids());
+    TEST_CHECK(-1 == findDevice("USB4000"));
+    TEST_CHECK(flamexID == findDevice("FLAMEX"));
+    TEST_CHECK(qeproID == findDevice("QE-PRO"));
+    stsID = findDevice("STS");
+    TEST_CHECK(stsID >= 0);
+    TEST_CHECK(stsID != usb4000ID);
+
+    /* A device that comes back is a new device with a new ID */
+    fakeUSBRemoveDevice(qepro);
+    sbapi_probe_devices();
+    TEST_CHECK(-1 == findDevice("QE-PRO"));
+    fakeUSBAddDevice(OCEAN_OPTICS_USB_VID, QEPRO_USB_PID);
+    sbapi_probe_devices();
+    TEST_CHECK(findDevice("QE-PRO") >= 0);
+    TEST_CHECK(qeproID != findDevice("QE-PRO"));
+    TEST_CHECK(5 == fakeUSBGetCounts().probes);
+
+    sbapi_shutdown();
+    return testFinish("usb_probe_test");
+}
@@ -0,0 +1,194 @@
+/***************************************************//**
+ * @file    usb_queued_read_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Checks the queued read interface of the USB class against
+ * the fake native layer: reads stay pending until data arrives,
+ * complete independently of each other, and can be cancelled.
+ * When the native layer cannot queue reads, USB must fall back
+ * to reading at submit time and stop asking the native layer.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <string.h>
+#include <vector>
+#include "native/usb/USB.h"
+#include "native/usb/USBDiscovery.h"
+#include "EmulatorTestSupport.h"
+#include "FakeNativeUSB.h"
+
+using namespace std;
+using namespace seabreeze;
+
+#define TEST_VID        0x2457
+#define TEST_PID        0x1022
+#define DATA_IN_EP      0x82
+#define SPECTRUM_IN_EP  0x86
+
+static USB *openTestDevice(USBDiscovery &discovery) {
+    vector<unsigned long> *ids = discovery.probeDevices(TEST_VID, TEST_PID);
+    USB *usb = NULL;
+
+    if(1 == ids->size()) {
+        usb = discovery.createUSBInterface((*ids)[0]);
+    }
+    delete ids;
+    if(NULL != usb && false == usb->open()) {
+        delete usb;
+        usb = NULL;
+    }
+    return usb;
+}
+
+static void testQueuedReads(USBDiscovery &discovery, unsigned long deviceID) {
+    const char first[] = "first";
+    const char second[] = "second reply";
+    char firstBuffer[16];
+    char secondBuffer[16];
+    char cancelledBuffer[16];
+    int firstTicket;
+    int secondTicket;
+    int cancelledTicket;
+    FakeUSBCounts counts;
+
+    USB *usb = openTestDevice(discovery);
+    TEST_CHECK(NULL != usb);
+    if(NULL == usb) {
+        return;
+    }
+    fakeUSBResetCounts();
+
+    memset(firstBuffer, 0, sizeof(firstBuffer));
+    memset(secondBuffer, 0, sizeof(secondBuffer));
+    firstTicket = usb->submitRead(DATA_IN_EP, firstBuffer, sizeof(firstBuffer));
+    secondTicket = usb->submitRead(SPECTRUM_IN_EP, secondBuffer, sizeof(secondBuffer));
+    TEST_CHECK(firstTicket >= 0);
+    TEST_CHECK(secondTicket >= 0);
+    TEST_CHECK(firstTicket != secondTicket);
+
+    /* Nothing has arrived, so neither read can finish yet */
+    TEST_CHECK(READ_PENDING == usb->completeRead(firstTicket, 0));
+    TEST_CHECK(READ_PENDING == usb->completeRead(secondTicket, 10));
+
+    /* The second endpoint answers first and completes on its own */
+    fakeUSBAddReadData(deviceID, SPECTRUM_IN_EP, second, sizeof(second));
+    TEST_CHECK((int)sizeof(second) == usb->completeRead(secondTicket, 0));
+    TEST_CHECK(0 == strcmp(secondBuffer, second));
+    TEST_CHECK(READ_PENDING == usb->completeRead(firstTicket, 0));
+
+    fakeUSBAddReadData(deviceID, DATA_IN_EP, first, sizeof(first));
+    TEST_CHECK((int)sizeof(first) == usb->completeRead(firstTicket));
+    TEST_CHECK(0 == strcmp(firstBuffer, first));
+
+    /* A finished ticket is forgotten */
+    TEST_CHECK(-1 == usb->completeRead(firstTicket, 0));
+
+    /* A cancelled read is withdrawn from the native layer and is never
+     * completed, even if data turns up for its endpoint afterwards.
+     */
+    cancelledTicket = usb->submitRead(DATA_IN_EP, cancelledBuffer,
+            sizeof(cancelledBuffer));
+    TEST_CHECK(cancelledTicket >= 0);
+    usb->cancelRead(cancelledTicket);
+    fakeUSBAddReadData(deviceID, DATA_IN_EP, first, sizeof(first));
+    TEST_CHECK(-1 == usb->completeRead(cancelledTicket, 0));
+
+    counts = fakeUSBGetCounts();
+    TEST_CHECK(3 == counts.submits);
+    TEST_CHECK(1 == counts.cancels);
+    TEST_CHECK(0 == counts.reads);
+
+    /* The data meant for the cancelled read is still there for the next */
+    TEST_CHECK((int)sizeof(first) == usb->read(DATA_IN_EP, firstBuffer,
+            sizeof(firstBuffer)));
+
+    usb->close();
+    delete usb;
+}
+
+static void testBlockingFallback(USBDiscovery &discovery, unsigned long deviceID) {
+    const char reply[] = "blocking";
+    char buffer[16];
+    char missingBuffer[16];
+    int ticket;
+    int missingTicket;
+    int cancelledTicket;
+    FakeUSBCounts counts;
+
+    fakeUSBSetQueuedReads(false);
+    USB *usb = openTestDevice(discovery);
+    TEST_CHECK(NULL != usb);
+    if(NULL == usb) {
+        return;
+    }
+    fakeUSBResetCounts();
+
+    /* The read happens inside submitRead(), and completeRead() hands back
+     * what it got.
+     */
+    memset(buffer, 0, sizeof(buffer));
+    fakeUSBAddReadData(deviceID, DATA_IN_EP, reply, sizeof(reply));
+    ticket = usb->submitRead(DATA_IN_EP, buffer, sizeof(buffer));
+    TEST_CHECK(ticket >= 0);
+    TEST_CHECK(0 == strcmp(buffer, reply));
+    TEST_CHECK((int)sizeof(reply) == usb->completeRead(ticket, 0));
+
+    /* A read that failed at submit time reports it on completion */
+    missingTicket = usb->submitRead(DATA_IN_EP, missingBuffer, sizeof(missingBuffer));
+    TEST_CHECK(missingTicket >= 0);
+    TEST_CHECK(-1 == usb->completeRead(missingTicket));
+
+    /* Cancelling a read that already happened does not reach the native
+     * layer, which has nothing to cancel.
+     */
+    fakeUSBAddReadData(deviceID, DATA_IN_EP, reply, sizeof(reply));
+    cancelledTicket = usb->submitRead(DATA_IN_EP, buffer, sizeof(buffer));
+    usb->cancelRead(cancelledTicket);
+
+    /* The native layer is asked to queue only once per device */
+    counts = fakeUSBGetCounts();
+    TEST_CHECK(1 == counts.submits);
+    TEST_CHECK(3 == counts.reads);
+    TEST_CHECK(0 == counts.completes);
+    TEST_CHECK(0 == counts.cancels);
+
+    usb->close();
+    delete usb;
+    fakeUSBSetQueuedReads(true);
+}
+
+int main() {
+    USBDiscovery discovery;
+    unsigned long deviceID;
+
+    deviceID = fakeUSBAddDevice(TEST_VID, TEST_PID);
+
+    testQueuedReads(discovery, deviceID);
+    testBlockingFallback(discovery, deviceID);
+
+    return testFinish("usb_queued_read_test");
+}
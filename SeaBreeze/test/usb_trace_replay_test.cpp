@@ -0,0 +1,152 @@
+/***************************************************//**
+ * @file    usb_trace_replay_test.cpp
+ * @date    October 2026
+ * @author  Ocean Optics, Inc.
+ *
+ * Replays a recorded USB session with an emulated FlameX through
+ * the trace shim and checks that the API gets the recorded
+ * device back.  This only builds when the shim is enabled.
+ *
+ * traces/flamex_acquisition.trace is recorded by usb_trace_record,
+ * which is this program built with USB_TRACE_RECORD: it runs the
+ * same calls against the emulator's FlameX model on the fake USB
+ * bus while the shim records.  Re-record the trace with
+ *
+ *   test/usb_trace_record test/traces/flamex_acquisition.trace
+ *
+ * from a -DSEABREEZE_USB_TRACE=ON build if the traffic for these
+ * calls changes on purpose.
+ *
+ * LICENSE:
+ *
+ * SeaBreeze Copyright (C) 2014, Ocean Optics Inc
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the
+ * "Software"), to deal in the Software without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to
+ * permit persons to whom the Software is furnished to do so, subject
+ * to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *******************************************************/
+
+#include "common/globals.h"
+#include <string.h>
+#include <vector>
+#include "api/seabreezeapi/SeaBreezeAPI.h"
+#include "EmulatorTestSupport.h"
+#ifdef USB_TRACE_RECORD
+#include <stdlib.h>
+#include "FakeNativeUSB.h"
+#endif
+
+using namespace std;
+#ifdef USB_TRACE_RECORD
+using namespace seabreeze::emulator;
+#endif
+
+/* What the emulator was configured with when the trace was recorded */
+#define TRACE_SERIAL_NUMBER     "OFXTRACE"
+#define TRACE_PIXELS            2136
+#define TRACE_MAX_INTENSITY     65535
+
+#ifdef USB_TRACE_RECORD
+/* Puts the device the trace was recorded from on the fake bus and
+ * switches the shim to recording, optionally into the named file.
+ */
+static void recordFromEmulator(int argc, char *argv[]) {
+    OBPEmulatorOptions options;
+
+    options.setModel(OBPEmulatorOptions::FLAME_X);
+    options.serialNumber = TRACE_SERIAL_NUMBER;
+    options.numberOfPixels = TRACE_PIXELS;
+    options.maxIntensity = TRACE_MAX_INTENSITY;
+    fakeUSBAddEmulatedDevice(options);
+
+    /* The shim reads these on the first USB call */
+    setenv("SEABREEZE_USB_TRACE", "record", 1);
+    if(argc > 1) {
+        setenv("SEABREEZE_USB_TRACE_FILE", argv[1], 1);
+    }
+}
+#endif
+
+int main(int argc, char *argv[]) {
+    long deviceID;
+    long serialFeature;
+    long spectrometerFeature;
+    char name[32];
+    char serial[32];
+    int error = 0;
+    int length;
+    int i;
+
+#ifdef USB_TRACE_RECORD
+    recordFromEmulator(argc, argv);
+#endif
+
+    sbapi_initialize();
+    sbapi_probe_devices();
+
+    /* The trace has exactly one device in it */
+    TEST_CHECK(1 == sbapi_get_number_of_device_ids());
+    if(1 != sbapi_get_device_ids(&deviceID, 1)) {
+        return testFinish("usb_trace_replay_test");
+    }
+
+    memset(name, 0, sizeof(name));
+    sbapi_get_device_type(deviceID, &error, name, sizeof(name) - 1);
+    TEST_CHECK(0 == strcmp(name, "FLAMEX"));
+
+    TEST_CHECK(0 == sbapi_open_device(deviceID, &error));
+
+    TEST_CHECK(1 == sbapi_get_serial_number_features(deviceID, &error, &serialFeature, 1));
+    memset(serial, 0, sizeof(serial));
+    sbapi_get_serial_number(deviceID, serialFeature, &error, serial, sizeof(serial) - 1);
+    TEST_CHECK(0 == error);
+    TEST_CHECK(0 == strcmp(serial, TRACE_SERIAL_NUMBER));
+
+    TEST_CHECK(1 == sbapi_get_spectrometer_features(deviceID, &error, &spectrometerFeature, 1));
+
+    vector<double> wavelengths(TRACE_PIXELS);
+    length = sbapi_spectrometer_get_wavelengths(deviceID, spectrometerFeature,
+            &error, &wavelengths[0], (int)wavelengths.size());
+    TEST_CHECK(0 == error);
+    TEST_CHECK(TRACE_PIXELS == length);
+    TEST_CHECK(200.0 == wavelengths[0]);
+
+    sbapi_spectrometer_set_integration_time_micros(deviceID, spectrometerFeature,
+            &error, 5000);
+    TEST_CHECK(0 == error);
+
+    vector<double> spectrum(TRACE_PIXELS);
+    for(int attempt = 0; attempt < 2; attempt++) {
+        length = sbapi_spectrometer_get_formatted_spectrum(deviceID,
+                spectrometerFeature, &error, &spectrum[0], (int)spectrum.size());
+        TEST_CHECK(0 == error);
+        TEST_CHECK(TRACE_PIXELS == length);
+        for(i = 0; i < length; i++) {
+            if(spectrum[i] < 0 || spectrum[i] > TRACE_MAX_INTENSITY) {
+                break;
+            }
+        }
+        TEST_CHECK(i == length);
+    }
+
+    sbapi_close_device(deviceID, &error);
+    TEST_CHECK(0 == error);
+
+    sbapi_shutdown();
+    return testFinish("usb_trace_replay_test");
+}